@@ -23,7 +23,8 @@ namespace PathFinder
             mRenderEngine->ResourceProducer(),
             mRenderEngine->ResourceStorage(),
             &mRenderEngine->RenderSurface(),
-            mSettingsController->GetAppliedSettings());
+            mSettingsController->GetAppliedSettings(),
+            mRenderEngine->WorkerThreadPool());
 
         mInput = std::make_unique<Input>();
         mWindowsInputHandler = std::make_unique<InputHandlerWindows>(mInput.get(), mWindowHandle);
@@ -226,6 +227,8 @@ namespace PathFinder
     void Application::PerformPreRenderActions()
     {
         static bool IsInitialSceneUploaded = false; // Dirty hack until dynamic mesh and material buffers are implemented
+        static uint64_t UploadedMaterialsDescriptorRelocationCount = 0;
+        static uint64_t UploadedMaterialsTextureResidencyChangeCount = 0;
 
         const Geometry::Dimensions& viewportSize = mRenderEngine->RenderSurface().Dimensions();
 
@@ -244,6 +247,8 @@ namespace PathFinder
 
         mSettingsController->SetEnabled(!interactingWithUI);
 
+        mScene->UpdateTextureStreaming(mRenderEngine->FrameNumber(), viewportSize.Height);
+
         if (!IsInitialSceneUploaded)
         {
             mScene->GetGPUStorage().UploadMeshes();
@@ -255,11 +260,26 @@ namespace PathFinder
             IsInitialSceneUploaded = true;
         }
 
+        // Material table stores bindless indices, which change when descriptor heaps are defragmented
+        // and when streamed textures are recreated with a different set of mips
+        uint64_t descriptorRelocationCount = mRenderEngine->DescriptorAllocator()->RelocationCount();
+        uint64_t textureResidencyChangeCount = mScene->GetTextureStreamer().ResidencyChangeCount();
+
+        if (descriptorRelocationCount != UploadedMaterialsDescriptorRelocationCount ||
+            textureResidencyChangeCount != UploadedMaterialsTextureResidencyChangeCount)
+        {
+            mScene->GetGPUStorage().UploadMaterials();
+            UploadedMaterialsDescriptorRelocationCount = descriptorRelocationCount;
+            UploadedMaterialsTextureResidencyChangeCount = textureResidencyChangeCount;
+        }
+
         mScene->GetGIManager().Update();
         mScene->GetSky().UpdateSkyState();
         mScene->GetGPUStorage().UploadInstances();
 
-        mRenderEngine->AddTopRayTracingAccelerationStructure(&mScene->GetGPUStorage().TopAccelerationStructure());
+        // Nothing to build when no instances changed since last frame
+        if (mScene->GetGPUStorage().IsTopAccelerationStructureChanged())
+            mRenderEngine->AddTopRayTracingAccelerationStructure(&mScene->GetGPUStorage().TopAccelerationStructure());
 
         mGlobalConstants.PipelineRTResolution = {
             mRenderEngine->RenderSurface().Dimensions().Width,
@@ -332,6 +352,7 @@ namespace PathFinder
     {
         ThirdPartySceneLoader::Settings loadSettings{};
         loadSettings.InitialScale = 0.02;
+        loadSettings.StreamTextures = true;
         mScene->LoadThirdPartyScene(mCmdLineParser->ExecutableFolderPath() / "MediaResources" / "sponza" / "sponza.obj", loadSettings);
 
         // For GI to work correctly we need to set double-sided flags for curtains and such
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Foundation
+{
+
+    template <class Signature, size_t InlineSize = 48>
+    class Delegate;
+
+    // Move-only replacement for std::function.
+    // Callables that fit into InlineSize bytes are stored inside the delegate itself,
+    // larger ones fall back to a heap allocation.
+    template <class RetT, class... ArgTs, size_t InlineSize>
+    class Delegate<RetT(ArgTs...), InlineSize>
+    {
+    public:
+        Delegate() = default;
+        Delegate(std::nullptr_t) {}
+
+        template <class FuncT, class = std::enable_if_t<!std::is_same_v<std::decay_t<FuncT>, Delegate> && std::is_invocable_r_v<RetT, std::decay_t<FuncT>&, ArgTs...>>>
+        Delegate(FuncT&& func);
+
+        Delegate(Delegate&& that) noexcept;
+        Delegate& operator=(Delegate&& that) noexcept;
+        Delegate& operator=(std::nullptr_t);
+
+        Delegate(const Delegate& that) = delete;
+        Delegate& operator=(const Delegate& that) = delete;
+
+        ~Delegate();
+
+        RetT operator()(ArgTs... args) const;
+
+        template <class FuncT>
+        static constexpr bool IsStoredInline = 
+            sizeof(FuncT) <= InlineSize && 
+            alignof(FuncT) <= alignof(std::max_align_t) && 
+            std::is_nothrow_move_constructible_v<FuncT>;
+
+    private:
+        struct Operations
+        {
+            RetT(*Invoke)(void* storage, ArgTs&&... args);
+            void(*Relocate)(void* source, void* destination);
+            void(*Destroy)(void* storage);
+        };
+
+        template <class FuncT>
+        static const Operations* InlineOperations();
+
+        template <class FuncT>
+        static const Operations* HeapOperations();
+
+        void Reset();
+
+        alignas(std::max_align_t) mutable unsigned char mStorage[InlineSize < sizeof(void*) ? sizeof(void*) : InlineSize];
+        const Operations* mOperations = nullptr;
+
+    public:
+        inline explicit operator bool() const { return mOperations != nullptr; }
+    };
+
+}
+
+#include "Delegate.inl"
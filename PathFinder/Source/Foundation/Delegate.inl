@@ -0,0 +1,134 @@
+#pragma once
+
+#include <new>
+
+namespace Foundation
+{
+
+    template <class RetT, class... ArgTs, size_t InlineSize>
+    template <class FuncT, class>
+    Delegate<RetT(ArgTs...), InlineSize>::Delegate(FuncT&& func)
+    {
+        using StoredT = std::decay_t<FuncT>;
+
+        if constexpr (IsStoredInline<StoredT>)
+        {
+            new (mStorage) StoredT(std::forward<FuncT>(func));
+            mOperations = InlineOperations<StoredT>();
+        }
+        else
+        {
+            new (mStorage) StoredT*(new StoredT(std::forward<FuncT>(func)));
+            mOperations = HeapOperations<StoredT>();
+        }
+    }
+
+    template <class RetT, class... ArgTs, size_t InlineSize>
+    Delegate<RetT(ArgTs...), InlineSize>::Delegate(Delegate&& that) noexcept
+    {
+        if (that.mOperations)
+        {
+            that.mOperations->Relocate(that.mStorage, mStorage);
+            mOperations = that.mOperations;
+            that.mOperations = nullptr;
+        }
+    }
+
+    template <class RetT, class... ArgTs, size_t InlineSize>
+    Delegate<RetT(ArgTs...), InlineSize>& Delegate<RetT(ArgTs...), InlineSize>::operator=(Delegate&& that) noexcept
+    {
+        if (this != &that)
+        {
+            Reset();
+
+            if (that.mOperations)
+            {
+                that.mOperations->Relocate(that.mStorage, mStorage);
+                mOperations = that.mOperations;
+                that.mOperations = nullptr;
+            }
+        }
+
+        return *this;
+    }
+
+    template <class RetT, class... ArgTs, size_t InlineSize>
+    Delegate<RetT(ArgTs...), InlineSize>& Delegate<RetT(ArgTs...), InlineSize>::operator=(std::nullptr_t)
+    {
+        Reset();
+        return *this;
+    }
+
+    template <class RetT, class... ArgTs, size_t InlineSize>
+    Delegate<RetT(ArgTs...), InlineSize>::~Delegate()
+    {
+        Reset();
+    }
+
+    template <class RetT, class... ArgTs, size_t InlineSize>
+    RetT Delegate<RetT(ArgTs...), InlineSize>::operator()(ArgTs... args) const
+    {
+        assert_format(mOperations, "Invoking an empty delegate");
+        return mOperations->Invoke(mStorage, std::forward<ArgTs>(args)...);
+    }
+
+    template <class RetT, class... ArgTs, size_t InlineSize>
+    template <class FuncT>
+    const typename Delegate<RetT(ArgTs...), InlineSize>::Operations* Delegate<RetT(ArgTs...), InlineSize>::InlineOperations()
+    {
+        static const Operations operations
+        {
+            [](void* storage, ArgTs&&... args) -> RetT
+            {
+                return (*std::launder(reinterpret_cast<FuncT*>(storage)))(std::forward<ArgTs>(args)...);
+            },
+            [](void* source, void* destination)
+            {
+                FuncT* func = std::launder(reinterpret_cast<FuncT*>(source));
+                new (destination) FuncT(std::move(*func));
+                func->~FuncT();
+            },
+            [](void* storage)
+            {
+                std::launder(reinterpret_cast<FuncT*>(storage))->~FuncT();
+            }
+        };
+
+        return &operations;
+    }
+
+    template <class RetT, class... ArgTs, size_t InlineSize>
+    template <class FuncT>
+    const typename Delegate<RetT(ArgTs...), InlineSize>::Operations* Delegate<RetT(ArgTs...), InlineSize>::HeapOperations()
+    {
+        // Storage keeps a pointer to a heap allocated callable, so relocation is just a pointer copy
+        static const Operations operations
+        {
+            [](void* storage, ArgTs&&... args) -> RetT
+            {
+                return (**std::launder(reinterpret_cast<FuncT**>(storage)))(std::forward<ArgTs>(args)...);
+            },
+            [](void* source, void* destination)
+            {
+                new (destination) FuncT*(*std::launder(reinterpret_cast<FuncT**>(source)));
+            },
+            [](void* storage)
+            {
+                delete *std::launder(reinterpret_cast<FuncT**>(storage));
+            }
+        };
+
+        return &operations;
+    }
+
+    template <class RetT, class... ArgTs, size_t InlineSize>
+    void Delegate<RetT(ArgTs...), InlineSize>::Reset()
+    {
+        if (mOperations)
+        {
+            mOperations->Destroy(mStorage);
+            mOperations = nullptr;
+        }
+    }
+
+}
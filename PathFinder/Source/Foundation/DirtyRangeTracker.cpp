@@ -0,0 +1,79 @@
+#include "DirtyRangeTracker.hpp"
+
+#include <algorithm>
+
+namespace Foundation
+{
+
+    DirtyRangeTracker::DirtyRangeTracker(uint64_t historyFrameCount)
+        : mHistoryFrameCount{ std::max<uint64_t>(historyFrameCount, 1) } {}
+
+    void DirtyRangeTracker::Reset(uint64_t elementCount, uint64_t frameNumber)
+    {
+        mHistory.clear();
+        mElementCount = elementCount;
+        mOldestTrackedFrameNumber = frameNumber;
+    }
+
+    void DirtyRangeTracker::MarkDirty(uint64_t elementIndex, uint64_t frameNumber)
+    {
+        assert_format(elementIndex < mElementCount, "Element index is out of tracked range");
+
+        if (mHistory.empty() || mHistory.back().FrameNumber != frameNumber)
+        {
+            mHistory.emplace_back().FrameNumber = frameNumber;
+        }
+
+        mHistory.back().ElementIndices.push_back(elementIndex);
+
+        while (mHistory.size() > mHistoryFrameCount)
+        {
+            mOldestTrackedFrameNumber = std::max(mOldestTrackedFrameNumber, mHistory.front().FrameNumber);
+            mHistory.pop_front();
+        }
+    }
+
+    std::vector<DirtyRangeTracker::Range> DirtyRangeTracker::DirtyRangesSince(std::optional<uint64_t> frameNumber) const
+    {
+        if (mElementCount == 0)
+        {
+            return {};
+        }
+
+        if (!frameNumber || *frameNumber < mOldestTrackedFrameNumber)
+        {
+            return { Range{ 0, mElementCount } };
+        }
+
+        std::vector<uint64_t> dirtyIndices;
+
+        for (const FrameModifications& modifications : mHistory)
+        {
+            if (modifications.FrameNumber > *frameNumber)
+            {
+                dirtyIndices.insert(dirtyIndices.end(), modifications.ElementIndices.begin(), modifications.ElementIndices.end());
+            }
+        }
+
+        std::sort(dirtyIndices.begin(), dirtyIndices.end());
+        dirtyIndices.erase(std::unique(dirtyIndices.begin(), dirtyIndices.end()), dirtyIndices.end());
+
+        std::vector<Range> ranges;
+
+        // Coalesce consecutive indices
+        for (uint64_t index : dirtyIndices)
+        {
+            if (!ranges.empty() && ranges.back().Start + ranges.back().Count == index)
+            {
+                ++ranges.back().Count;
+            }
+            else
+            {
+                ranges.push_back(Range{ index, 1 });
+            }
+        }
+
+        return ranges;
+    }
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <optional>
+
+namespace Foundation
+{
+
+    /// Remembers which elements of an array were modified in recent frames
+    /// so that a copy of the array that is known to be up to date as of some frame
+    /// can be brought up to date by rewriting only the modified ranges.
+    class DirtyRangeTracker
+    {
+    public:
+        struct Range
+        {
+            uint64_t Start = 0;
+            uint64_t Count = 0;
+        };
+
+        DirtyRangeTracker(uint64_t historyFrameCount = 8);
+
+        // Resizes tracked array and marks all of its elements as modified in a specified frame
+        void Reset(uint64_t elementCount, uint64_t frameNumber);
+        void MarkDirty(uint64_t elementIndex, uint64_t frameNumber);
+
+        // Returns sorted, non-overlapping ranges of elements modified after a specified frame.
+        // Whole array is returned when copy state is unknown or older than the tracked history.
+        std::vector<Range> DirtyRangesSince(std::optional<uint64_t> frameNumber) const;
+
+    private:
+        struct FrameModifications
+        {
+            uint64_t FrameNumber = 0;
+            std::vector<uint64_t> ElementIndices;
+        };
+
+        std::deque<FrameModifications> mHistory;
+        uint64_t mHistoryFrameCount = 0;
+        uint64_t mElementCount = 0;
+
+        // Modifications made in this frame or earlier are no longer tracked
+        uint64_t mOldestTrackedFrameNumber = 0;
+
+    public:
+        inline auto ElementCount() const { return mElementCount; }
+    };
+
+}
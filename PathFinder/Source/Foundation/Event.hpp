@@ -1,10 +1,12 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 #include <string>
-#include <functional>
+#include <algorithm>
 
 #include "BitwiseEnum.hpp"
+#include "Delegate.hpp"
 
 namespace Foundation 
 {
@@ -19,29 +21,39 @@ namespace Foundation
 
     public:
 
-        using Delegate = std::function<RetT(ArgTs...)>;
+        using Delegate = Foundation::Delegate<RetT(ArgTs...)>;
 
         struct Binding {
             KeyT key;
             Delegate delegate;
 
-            Binding(KeyT key, Delegate delegate) : key(key), delegate(delegate) {}
+            Binding(KeyT key, Delegate&& delegate) : key(std::move(key)), delegate(std::move(delegate)) {}
 
             template<class T>
             Binding(KeyT key, T *target, RetT(T::*funcPtr)(ArgTs...))
                 :
-                key(key),
+                key(std::move(key)),
                 delegate([target, funcPtr](ArgTs... args) {
                 return (target->*funcPtr)(args...);
             }) {}
         };
 
-        void Subscribe(const Binding &binding) {
-            mContainer.bindings[binding.key] = binding.delegate;
+        void Subscribe(Binding &&binding) {
+            auto bindingIt = Find(binding.key);
+
+            if (bindingIt != mContainer.bindings.end()) {
+                bindingIt->delegate = std::move(binding.delegate);
+            } else {
+                mContainer.bindings.emplace_back(std::move(binding));
+            }
         }
 
-        void Unsubscribe(KeyT key) {
-            mContainer.bindings.erase(key);
+        void Unsubscribe(const KeyT &key) {
+            auto bindingIt = Find(key);
+
+            if (bindingIt != mContainer.bindings.end()) {
+                mContainer.bindings.erase(bindingIt);
+            }
         }
 
         void Clear() {
@@ -52,14 +64,8 @@ namespace Foundation
             return mContainer.bindings.size();
         }
 
-        template<typename T>
-        Event &operator+=(T &&binding) {
-            Subscribe(std::forward<T>(binding));
-            return *this;
-        }
-
-        Event &operator+=(const Binding &binding) {
-            Subscribe(binding);
+        Event &operator+=(Binding &&binding) {
+            Subscribe(std::move(binding));
             return *this;
         }
 
@@ -70,18 +76,26 @@ namespace Foundation
         }
 
     private:
-        // Hide bindings map from publisher (PublisherT)
+        // Hide bindings from publisher (PublisherT).
+        // Events have a handful of subscribers, so a linear search over a flat table
+        // beats hashing and keeps invocation a plain walk over contiguous memory.
         struct BindingContainer {
         private:
             friend Event;
-            std::unordered_map<KeyT, Delegate> bindings;
+            std::vector<Binding> bindings;
         };
 
         BindingContainer mContainer;
 
+        auto Find(const KeyT &key) {
+            return std::find_if(mContainer.bindings.begin(), mContainer.bindings.end(), [&key](const Binding &binding) {
+                return binding.key == key;
+            });
+        }
+
         void Raise(ArgTs... args) {
             for (auto &binding : mContainer.bindings) {
-                binding.second(args...);
+                binding.delegate(args...);
             }
         }
 
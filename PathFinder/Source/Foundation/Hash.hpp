@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <string_view>
+
+namespace Foundation
+{
+
+    static constexpr uint64_t HashSeed = 14695981039346656037ull;
+
+    // FNV-1a. Stable across runs and platforms, so it's suitable for keys of persistent caches.
+    inline uint64_t HashBytes(const void* data, uint64_t size, uint64_t hash = HashSeed)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+        for (uint64_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    // Only for types without padding, padding bytes are not guaranteed to be initialized
+    template <class T>
+    inline uint64_t HashValue(const T& value, uint64_t hash = HashSeed)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be hashed as raw bytes");
+        return HashBytes(&value, sizeof(T), hash);
+    }
+
+    // Same FNV-1a, but usable in constant expressions
+    constexpr uint64_t HashString(std::string_view string, uint64_t hash = HashSeed)
+    {
+        for (char character : string)
+        {
+            hash ^= static_cast<uint8_t>(character);
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+}
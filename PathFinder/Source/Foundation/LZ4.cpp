@@ -0,0 +1,222 @@
+#include "LZ4.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+namespace Foundation
+{
+
+    namespace LZ4
+    {
+        namespace
+        {
+            constexpr uint64_t MinMatchLength = 4;
+            constexpr uint64_t LastLiteralsLength = 5; // Block must end with at least 5 literals
+            constexpr uint64_t MatchSearchLimit = 12; // Last match must start at least 12 bytes before the end
+            constexpr uint64_t MaxOffset = 65535;
+            constexpr uint32_t HashLog = 16;
+
+            inline uint32_t Read32(const uint8_t* memory)
+            {
+                uint32_t value;
+                std::memcpy(&value, memory, sizeof(value));
+                return value;
+            }
+
+            inline uint32_t Hash(uint32_t sequence)
+            {
+                return (sequence * 2654435761u) >> (32 - HashLog);
+            }
+
+            // Lengths that don't fit into a token nibble continue as a run of bytes terminated by a byte below 255
+            inline void WriteLengthTail(uint64_t length, std::vector<uint8_t>& output)
+            {
+                for (; length >= 255; length -= 255)
+                {
+                    output.push_back(255);
+                }
+
+                output.push_back(uint8_t(length));
+            }
+
+            void WriteSequence(const uint8_t* literals, uint64_t literalCount, uint64_t offset, uint64_t matchLength, std::vector<uint8_t>& output)
+            {
+                uint8_t token = uint8_t(std::min<uint64_t>(literalCount, 15) << 4);
+
+                if (matchLength > 0)
+                {
+                    token |= uint8_t(std::min<uint64_t>(matchLength - MinMatchLength, 15));
+                }
+
+                output.push_back(token);
+
+                if (literalCount >= 15)
+                {
+                    WriteLengthTail(literalCount - 15, output);
+                }
+
+                output.insert(output.end(), literals, literals + literalCount);
+
+                // Final sequence consists of literals only
+                if (matchLength == 0)
+                {
+                    return;
+                }
+
+                output.push_back(uint8_t(offset & 0xFF));
+                output.push_back(uint8_t(offset >> 8));
+
+                if (matchLength - MinMatchLength >= 15)
+                {
+                    WriteLengthTail(matchLength - MinMatchLength - 15, output);
+                }
+            }
+
+            inline bool ReadLengthTail(const uint8_t*& input, const uint8_t* inputEnd, uint64_t& length)
+            {
+                uint8_t byte = 0;
+
+                do
+                {
+                    if (input >= inputEnd)
+                    {
+                        return false;
+                    }
+
+                    byte = *input++;
+                    length += byte;
+
+                } while (byte == 255);
+
+                return true;
+            }
+        }
+
+        uint64_t CompressBound(uint64_t sourceSize)
+        {
+            return sourceSize + sourceSize / 255 + 16;
+        }
+
+        std::vector<uint8_t> Compress(const uint8_t* source, uint64_t sourceSize)
+        {
+            std::vector<uint8_t> output;
+            output.reserve(CompressBound(sourceSize));
+
+            // Positions are stored with a +1 bias so that zero means an empty slot
+            std::vector<uint32_t> hashTable(1ull << HashLog, 0);
+
+            uint64_t anchor = 0;
+            uint64_t position = 0;
+
+            if (sourceSize >= MatchSearchLimit + 1)
+            {
+                uint64_t lastMatchStart = sourceSize - MatchSearchLimit;
+                uint64_t matchEndLimit = sourceSize - LastLiteralsLength;
+
+                while (position <= lastMatchStart)
+                {
+                    uint32_t sequence = Read32(source + position);
+                    uint32_t& slot = hashTable[Hash(sequence)];
+                    uint64_t candidate = slot;
+                    slot = uint32_t(position + 1);
+
+                    if (candidate == 0 || position - (candidate - 1) > MaxOffset || Read32(source + candidate - 1) != sequence)
+                    {
+                        ++position;
+                        continue;
+                    }
+
+                    uint64_t reference = candidate - 1;
+                    uint64_t matchLength = MinMatchLength;
+
+                    while (position + matchLength < matchEndLimit && source[reference + matchLength] == source[position + matchLength])
+                    {
+                        ++matchLength;
+                    }
+
+                    WriteSequence(source + anchor, position - anchor, position - reference, matchLength, output);
+
+                    position += matchLength;
+                    anchor = position;
+                }
+            }
+
+            WriteSequence(source + anchor, sourceSize - anchor, 0, 0, output);
+
+            return output;
+        }
+
+        bool Decompress(const uint8_t* source, uint64_t sourceSize, uint8_t* destination, uint64_t destinationSize)
+        {
+            const uint8_t* input = source;
+            const uint8_t* inputEnd = source + sourceSize;
+            uint8_t* output = destination;
+            uint8_t* outputEnd = destination + destinationSize;
+
+            while (input < inputEnd)
+            {
+                uint8_t token = *input++;
+                uint64_t literalCount = token >> 4;
+
+                if (literalCount == 15 && !ReadLengthTail(input, inputEnd, literalCount))
+                {
+                    return false;
+                }
+
+                if (uint64_t(inputEnd - input) < literalCount || uint64_t(outputEnd - output) < literalCount)
+                {
+                    return false;
+                }
+
+                if (literalCount > 0)
+                {
+                    std::memcpy(output, input, literalCount);
+                }
+
+                input += literalCount;
+                output += literalCount;
+
+                // Block ends after the literals of the last sequence
+                if (input == inputEnd)
+                {
+                    break;
+                }
+
+                if (inputEnd - input < 2)
+                {
+                    return false;
+                }
+
+                uint64_t offset = uint64_t(input[0]) | (uint64_t(input[1]) << 8);
+                input += 2;
+
+                uint64_t matchLength = token & 0xF;
+
+                if (matchLength == 15 && !ReadLengthTail(input, inputEnd, matchLength))
+                {
+                    return false;
+                }
+
+                matchLength += MinMatchLength;
+
+                if (offset == 0 || uint64_t(output - destination) < offset || uint64_t(outputEnd - output) < matchLength)
+                {
+                    return false;
+                }
+
+                // Matches closer than their length overlap the bytes they produce.
+                // Such a match repeats a pattern of offset bytes, which is copied a period at a time.
+                while (matchLength > 0)
+                {
+                    uint64_t chunkSize = std::min(offset, matchLength);
+                    std::memcpy(output, output - offset, chunkSize);
+                    output += chunkSize;
+                    matchLength -= chunkSize;
+                }
+            }
+
+            return output == outputEnd;
+        }
+    }
+
+}
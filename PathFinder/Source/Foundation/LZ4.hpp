@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Foundation
+{
+
+    // Encoder and decoder for the LZ4 block format.
+    // Output of the encoder is readable by any conforming LZ4 block decoder and vice versa.
+    namespace LZ4
+    {
+        // Upper bound of the compressed size for a given input size
+        uint64_t CompressBound(uint64_t sourceSize);
+
+        // Greedy single pass encoder. Returns the compressed block.
+        std::vector<uint8_t> Compress(const uint8_t* source, uint64_t sourceSize);
+
+        // Returns false if the block is malformed or does not decode to exactly destinationSize bytes
+        bool Decompress(const uint8_t* source, uint64_t sourceSize, uint8_t* destination, uint64_t destinationSize);
+    }
+
+}
@@ -0,0 +1,128 @@
+#include "MemoryMappedFile.hpp"
+
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Foundation
+{
+
+    MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& path)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return;
+        }
+
+        mFileHandle = file;
+
+        LARGE_INTEGER fileSize{};
+
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            Unmap();
+            return;
+        }
+
+        mMappingHandle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (!mMappingHandle)
+        {
+            Unmap();
+            return;
+        }
+
+        mData = static_cast<const uint8_t*>(MapViewOfFile(mMappingHandle, FILE_MAP_READ, 0, 0, 0));
+        mSize = mData ? uint64_t(fileSize.QuadPart) : 0;
+#else
+        mFileDescriptor = open(path.c_str(), O_RDONLY);
+
+        if (mFileDescriptor < 0)
+        {
+            return;
+        }
+
+        struct stat fileStatus{};
+
+        if (fstat(mFileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0)
+        {
+            Unmap();
+            return;
+        }
+
+        void* mapping = mmap(nullptr, size_t(fileStatus.st_size), PROT_READ, MAP_PRIVATE, mFileDescriptor, 0);
+
+        if (mapping == MAP_FAILED)
+        {
+            Unmap();
+            return;
+        }
+
+        mData = static_cast<const uint8_t*>(mapping);
+        mSize = uint64_t(fileStatus.st_size);
+#endif
+    }
+
+    MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& that)
+    {
+        *this = std::move(that);
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        Unmap();
+    }
+
+    MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& that)
+    {
+        if (this == &that)
+        {
+            return *this;
+        }
+
+        Unmap();
+
+        mData = std::exchange(that.mData, nullptr);
+        mSize = std::exchange(that.mSize, 0);
+
+#ifdef _WIN32
+        mFileHandle = std::exchange(that.mFileHandle, nullptr);
+        mMappingHandle = std::exchange(that.mMappingHandle, nullptr);
+#else
+        mFileDescriptor = std::exchange(that.mFileDescriptor, -1);
+#endif
+
+        return *this;
+    }
+
+    void MemoryMappedFile::Unmap()
+    {
+#ifdef _WIN32
+        if (mData) UnmapViewOfFile(mData);
+        if (mMappingHandle) CloseHandle(mMappingHandle);
+        if (mFileHandle) CloseHandle(mFileHandle);
+
+        mMappingHandle = nullptr;
+        mFileHandle = nullptr;
+#else
+        if (mData) munmap(const_cast<uint8_t*>(mData), size_t(mSize));
+        if (mFileDescriptor >= 0) close(mFileDescriptor);
+
+        mFileDescriptor = -1;
+#endif
+
+        mData = nullptr;
+        mSize = 0;
+    }
+
+}
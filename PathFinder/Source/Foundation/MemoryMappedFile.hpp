@@ -0,0 +1,42 @@
+#pragma once
+
+#include <filesystem>
+#include <cstdint>
+
+namespace Foundation
+{
+
+    // Read-only view of a whole file mapped into the address space.
+    // Pages are brought in by the OS on first access, so untouched parts of the file are never read.
+    class MemoryMappedFile
+    {
+    public:
+        MemoryMappedFile() = default;
+        MemoryMappedFile(const std::filesystem::path& path);
+        MemoryMappedFile(MemoryMappedFile&& that);
+        MemoryMappedFile(const MemoryMappedFile& that) = delete;
+        ~MemoryMappedFile();
+
+        MemoryMappedFile& operator=(MemoryMappedFile&& that);
+        MemoryMappedFile& operator=(const MemoryMappedFile& that) = delete;
+
+    private:
+        void Unmap();
+
+        const uint8_t* mData = nullptr;
+        uint64_t mSize = 0;
+
+#ifdef _WIN32
+        void* mFileHandle = nullptr;
+        void* mMappingHandle = nullptr;
+#else
+        int mFileDescriptor = -1;
+#endif
+
+    public:
+        inline const uint8_t* Data() const { return mData; }
+        inline auto Size() const { return mSize; }
+        inline bool IsMapped() const { return mData != nullptr; }
+    };
+
+}
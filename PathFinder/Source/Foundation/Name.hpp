@@ -1,26 +1,37 @@
 #pragma once
 
+#include "Hash.hpp"
+
 #include <string>
+#include <string_view>
 #include <cstdint>
+#include <limits>
+#include <cassert>
 
 namespace Foundation
 {
+    // Name identifier is a hash of its string. Hash() is constexpr, so identifiers of string literals can be
+    // computed at compile time, but constructing a name always hashes at run time and registers the string
+    // to be able to convert names back. Registration only allocates the first time a string is seen.
     class Name
     {
     public:
         using ID = uint32_t;
 
-        Name();
-        Name(const std::string& string);
-        Name(const char* cString);
-        explicit Name(ID id);
-        ~Name();
+        static constexpr ID INVALID_ID = std::numeric_limits<ID>::max();
+
+        constexpr Name() : m_Id{ INVALID_ID } {}
+        constexpr explicit Name(ID id) : m_Id{ id } {}
 
-        Name(const Name& other);
-        Name(Name&& other);
+        inline Name(const char* cString) : Name(std::string_view{ cString }) {}
+        inline Name(const std::string& string) : Name(std::string_view{ string }) {}
+        inline Name(std::string_view string) : m_Id{ Hash(string) } { Register(m_Id, string); }
 
-        Name& operator=(const Name& other);
-        Name& operator=(Name&& other);
+        Name(const Name& other) = default;
+        Name(Name&& other) = default;
+
+        Name& operator=(const Name& other) = default;
+        Name& operator=(Name&& other) = default;
 
         bool operator==(const Name& other) const;
         bool operator<(const Name& other) const;
@@ -30,11 +41,25 @@ namespace Foundation
 
         bool IsValid() const;
 
+        static constexpr ID Hash(std::string_view string);
+
     private:
+        // Interns the string, hash collisions are detected in debug builds
+        static void Register(ID id, std::string_view string);
+
         ID m_Id;
     };
 }
 
+constexpr Foundation::Name::ID Foundation::Name::Hash(std::string_view string)
+{
+    uint64_t hash = HashString(string);
+    ID id = static_cast<ID>(hash ^ (hash >> 32));
+
+    // Keep invalid identifier reserved
+    return id != INVALID_ID ? id : INVALID_ID - 1;
+}
+
 inline bool Foundation::Name::operator==(const Name& other) const
 {
     return m_Id == other.m_Id;
@@ -45,6 +70,17 @@ inline bool Foundation::Name::operator<(const Name& other) const
     return m_Id < other.m_Id;
 }
 
+inline Foundation::Name::ID Foundation::Name::ToId() const
+{
+    assert(m_Id != INVALID_ID);
+    return m_Id;
+}
+
+inline bool Foundation::Name::IsValid() const
+{
+    return m_Id != INVALID_ID;
+}
+
 namespace std
 {
     template<>
@@ -10,8 +10,7 @@ Foundation::Name Foundation::NameHolder::GetName()
 {
     if (!m_Name.IsValid())
     {
-        std::string nameString{ m_String };
-        m_Name = Name(nameString);
+        m_Name = Name(m_String);
     }
 
     return m_Name;
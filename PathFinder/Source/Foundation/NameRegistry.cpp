@@ -1,4 +1,8 @@
 #include "NameRegistry.hpp"
+#include "Name.hpp"
+
+#include <mutex>
+#include <cassert>
 
 namespace Foundation
 {
@@ -18,24 +22,75 @@ namespace Foundation
 
     }
 
-    uint32_t NameRegistry::ToId(const std::string& string)
+    void NameRegistry::Register(uint32_t id, std::string_view string)
     {
-        auto found = m_NameToId.find(string);
+#if !defined(DEBUG) && !defined(_DEBUG) 
+        // Names are constructed over and over from the same strings, so threads remember identifiers they've seen
+        // registered and skip locking altogether. Debug builds always go to shards to validate strings.
+        thread_local std::array<uint32_t, THREAD_CACHE_SIZE> registeredIdsCache = MakeEmptyThreadCache();
+
+        uint32_t& cachedId = registeredIdsCache[id % THREAD_CACHE_SIZE];
 
-        if (found != m_NameToId.end())
+        if (cachedId == id)
         {
-            return found->second;
+            return;
         }
 
-        m_IdToName.push_back(string);
-        m_NameToId.insert({ string, m_IdToName.size() - 1 });
+        cachedId = id;
+#endif
+
+        Shard& shard = GetShard(id);
+
+        {
+            std::shared_lock lock{ shard.m_Mutex };
+
+            auto found = shard.m_IdToName.find(id);
 
-        return (uint32_t)m_IdToName.size() - 1;
+            if (found != shard.m_IdToName.end())
+            {
+#if defined(DEBUG) || defined(_DEBUG) 
+                assert_format(found->second == string, "Name hash collision: '", found->second, "' and '", string, "'");
+#endif
+                return;
+            }
+        }
+
+        std::unique_lock lock{ shard.m_Mutex };
+
+        // Another thread might have registered the name in between
+        auto [it, inserted] = shard.m_IdToName.try_emplace(id, string);
+
+#if defined(DEBUG) || defined(_DEBUG) 
+        assert_format(inserted || it->second == string, "Name hash collision: '", it->second, "' and '", string, "'");
+#endif
+    }
+
+    std::array<uint32_t, NameRegistry::THREAD_CACHE_SIZE> NameRegistry::MakeEmptyThreadCache()
+    {
+        std::array<uint32_t, THREAD_CACHE_SIZE> cache;
+        cache.fill(Name::INVALID_ID);
+        return cache;
+    }
+
+    const std::string& NameRegistry::ToString(uint32_t id) const
+    {
+        const Shard& shard = GetShard(id);
+        std::shared_lock lock{ shard.m_Mutex };
+
+        auto found = shard.m_IdToName.find(id);
+        assert(found != shard.m_IdToName.end());
+
+        return found->second;
+    }
+
+    NameRegistry::Shard& NameRegistry::GetShard(uint32_t id)
+    {
+        return m_Shards[id % SHARD_COUNT];
     }
 
-    const std::string& NameRegistry::ToString(uint32_t id)
+    const NameRegistry::Shard& NameRegistry::GetShard(uint32_t id) const
     {
-        return m_IdToName.at(id);
+        return m_Shards[id % SHARD_COUNT];
     }
 }
 
@@ -1,26 +1,43 @@
 #pragma once
 
 #include <string>
-#include <unordered_map>
-#include <vector>
+#include <string_view>
+#include <array>
+#include <shared_mutex>
+
+#include <robinhood/robin_hood.h>
 
 namespace Foundation
 {
+    // Thread safe storage of name strings. Identifiers are spread over shards with their own locks,
+    // so threads only contend when registering names that land in the same shard.
     class NameRegistry
     {
     public:
-        static const uint32_t INVALID_ID = UINT32_MAX;
-
         static NameRegistry& SharedInstance();
 
         NameRegistry();
         ~NameRegistry();
 
-        uint32_t ToId(const std::string& string);
-        const std::string& ToString(uint32_t id);
+        void Register(uint32_t id, std::string_view string);
+        const std::string& ToString(uint32_t id) const;
 
     private:
-        std::unordered_map<std::string, uint32_t> m_NameToId;
-        std::vector<std::string> m_IdToName;
+        static const uint32_t SHARD_COUNT = 64;
+        static const uint32_t THREAD_CACHE_SIZE = 1024;
+
+        struct Shard
+        {
+            // Node map keeps string references valid while other names are inserted
+            robin_hood::unordered_node_map<uint32_t, std::string> m_IdToName;
+            mutable std::shared_mutex m_Mutex;
+        };
+
+        static std::array<uint32_t, THREAD_CACHE_SIZE> MakeEmptyThreadCache();
+
+        Shard& GetShard(uint32_t id);
+        const Shard& GetShard(uint32_t id) const;
+
+        std::array<Shard, SHARD_COUNT> m_Shards;
     };
 }
@@ -0,0 +1,90 @@
+#include "ThreadPool.hpp"
+
+namespace Foundation
+{
+
+    ThreadPool::ThreadPool(uint64_t workerCount)
+    {
+        for (auto i = 0u; i < workerCount; ++i)
+        {
+            mWorkers.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock{ mTasksMutex };
+            mIsStopRequested = true;
+        }
+
+        mTaskAvailableCondition.notify_all();
+
+        for (std::thread& worker : mWorkers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::Execute(const Task& task)
+    {
+        {
+            std::lock_guard lock{ mTasksMutex };
+            mTasks.push(task);
+            ++mUnfinishedTaskCount;
+        }
+
+        mTaskAvailableCondition.notify_one();
+    }
+
+    void ThreadPool::WaitForAllTasks()
+    {
+        std::unique_lock lock{ mTasksMutex };
+        mAllTasksCompletedCondition.wait(lock, [this] { return mUnfinishedTaskCount == 0; });
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        while (true)
+        {
+            Task task;
+
+            {
+                std::unique_lock lock{ mTasksMutex };
+                mTaskAvailableCondition.wait(lock, [this] { return mIsStopRequested || !mTasks.empty(); });
+
+                if (mIsStopRequested && mTasks.empty())
+                    return;
+
+                task = std::move(mTasks.front());
+                mTasks.pop();
+            }
+
+            task();
+            FinishTask();
+        }
+    }
+
+    void ThreadPool::FinishTask()
+    {
+        {
+            std::lock_guard lock{ mTasksMutex };
+
+            if (--mUnfinishedTaskCount == 0)
+                mAllTasksCompletedCondition.notify_all();
+        }
+
+        mTaskCompletedCondition.notify_all();
+    }
+
+    void ThreadPool::WaitForParallelFor(const ParallelForState& state)
+    {
+        // Completion counter is incremented before the task finishes and locks the mutex to notify, so no wake up is lost
+        std::unique_lock lock{ mTasksMutex };
+        mTaskCompletedCondition.wait(lock, [&state]
+        {
+            return state.CompletedTaskCount.load(std::memory_order_acquire) == state.TaskCount;
+        });
+    }
+
+}
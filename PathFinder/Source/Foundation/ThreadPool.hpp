@@ -0,0 +1,64 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <vector>
+#include <queue>
+#include <algorithm>
+
+namespace Foundation
+{
+
+    class ThreadPool
+    {
+    public:
+        using Task = std::function<void()>;
+
+        ThreadPool(uint64_t workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1);
+        ~ThreadPool();
+
+        void Execute(const Task& task);
+        void WaitForAllTasks();
+
+        // Invokes func(taskIndex) for every index in [0, taskCount) and blocks until all invocations complete.
+        // Calling thread picks up work as well. Only invocations of this call are waited on,
+        // so it is safe to call from worker threads and alongside unrelated tasks.
+        template <class Func>
+        void ParallelFor(uint64_t taskCount, const Func& func);
+
+    private:
+        // Shared with queued tasks, which may run after ParallelFor returned if every index was already claimed
+        struct ParallelForState
+        {
+            ParallelForState(uint64_t taskCount) : TaskCount{ taskCount } {}
+
+            const uint64_t TaskCount;
+            std::atomic<uint64_t> NextTaskIndex = 0;
+            std::atomic<uint64_t> CompletedTaskCount = 0;
+        };
+
+        void WorkerLoop();
+        void FinishTask();
+        void WaitForParallelFor(const ParallelForState& state);
+
+        std::vector<std::thread> mWorkers;
+        std::queue<Task> mTasks;
+        std::mutex mTasksMutex;
+        std::condition_variable mTaskAvailableCondition;
+        std::condition_variable mAllTasksCompletedCondition;
+        std::condition_variable mTaskCompletedCondition;
+        uint64_t mUnfinishedTaskCount = 0;
+        bool mIsStopRequested = false;
+
+    public:
+        // Worker threads plus the calling thread
+        inline uint64_t ThreadCount() const { return mWorkers.size() + 1; }
+    };
+
+}
+
+#include "ThreadPool.inl"
@@ -0,0 +1,35 @@
+#pragma once
+
+namespace Foundation
+{
+
+    template <class Func>
+    void ThreadPool::ParallelFor(uint64_t taskCount, const Func& func)
+    {
+        if (taskCount == 0)
+            return;
+
+        auto state = std::make_shared<ParallelForState>(taskCount);
+
+        auto executeClaimedTasks = [state, &func]
+        {
+            for (uint64_t taskIndex = state->NextTaskIndex++; taskIndex < state->TaskCount; taskIndex = state->NextTaskIndex++)
+            {
+                func(taskIndex);
+                state->CompletedTaskCount.fetch_add(1, std::memory_order_release);
+            }
+        };
+
+        uint64_t helperCount = std::min(taskCount - 1, mWorkers.size());
+
+        for (uint64_t helperIndex = 0; helperIndex < helperCount; ++helperIndex)
+        {
+            Execute(executeClaimedTasks);
+        }
+
+        executeClaimedTasks();
+
+        WaitForParallelFor(*state);
+    }
+
+}
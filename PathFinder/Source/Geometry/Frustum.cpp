@@ -0,0 +1,60 @@
+#include "Frustum.hpp"
+
+#include <glm/geometric.hpp>
+
+namespace Geometry
+{
+
+    Frustum::Frustum(const std::array<glm::vec3, 8>& corners)
+    {
+        glm::vec3 center{ 0.0f };
+
+        for (const glm::vec3& corner : corners)
+        {
+            center += corner / 8.0f;
+        }
+
+        // Near, far, left, right, bottom, top
+        constexpr std::array<std::array<uint8_t, 3>, 6> PlaneCornerIndices = { {
+            { 0, 1, 2 }, { 4, 5, 6 }, { 0, 1, 5 }, { 2, 3, 7 }, { 0, 3, 7 }, { 1, 2, 6 }
+        } };
+
+        for (auto planeIdx = 0; planeIdx < 6; ++planeIdx)
+        {
+            const glm::vec3& a = corners[PlaneCornerIndices[planeIdx][0]];
+            const glm::vec3& b = corners[PlaneCornerIndices[planeIdx][1]];
+            const glm::vec3& c = corners[PlaneCornerIndices[planeIdx][2]];
+
+            glm::vec3 normal = glm::normalize(glm::cross(b - a, c - a));
+            float distance = glm::dot(normal, a);
+
+            // Orient towards frustum center to be independent of corner winding and handedness
+            if (glm::dot(normal, center) - distance < 0.0f)
+            {
+                normal = -normal;
+                distance = -distance;
+            }
+
+            mPlanes[planeIdx] = Plane{ distance, normal };
+        }
+    }
+
+    bool Frustum::Intersects(const AABB& box) const
+    {
+        glm::vec3 center = (box.GetMin() + box.GetMax()) * 0.5f;
+        glm::vec3 extent = (box.GetMax() - box.GetMin()) * 0.5f;
+
+        for (const Plane& plane : mPlanes)
+        {
+            float radius = glm::dot(glm::abs(plane.normal), extent);
+
+            if (glm::dot(plane.normal, center) - plane.distance + radius < 0.0f)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "AABB.hpp"
+#include "Plane.hpp"
+
+#include <glm/vec3.hpp>
+
+#include <array>
+
+namespace Geometry
+{
+
+    class Frustum
+    {
+    public:
+        /**
+         Builds frustum from its world space corner points
+         in the order produced by Camera::GetFrustumCorners:
+          Near: Bottom-Left, Top-Left, Top-Right, Bottom-Right
+          Far: Bottom-Left, Top-Left, Top-Right, Bottom-Right
+         */
+        Frustum(const std::array<glm::vec3, 8>& corners);
+
+        // Conservative test: boxes near frustum edges may be reported as intersecting
+        bool Intersects(const AABB& box) const;
+
+    private:
+        // Normals point inside the frustum
+        std::array<Plane, 6> mPlanes;
+
+    public:
+        inline const auto& Planes() const { return mPlanes; }
+    };
+
+}
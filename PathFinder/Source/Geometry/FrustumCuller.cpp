@@ -0,0 +1,143 @@
+#include "FrustumCuller.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#define FRUSTUM_CULLER_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Geometry
+{
+
+    void FrustumCuller::Resize(uint64_t boxCount)
+    {
+        mBoxCount = boxCount;
+
+        // Pad to whole batches so that the last batch can be loaded without bounds checks
+        uint64_t paddedCount = ((boxCount + BatchSize - 1) / BatchSize) * BatchSize;
+
+        for (std::vector<float>* component : { &mCentersX, &mCentersY, &mCentersZ, &mExtentsX, &mExtentsY, &mExtentsZ })
+        {
+            component->resize(paddedCount, 0.0f);
+        }
+    }
+
+    void FrustumCuller::SetBox(uint64_t index, const AABB& box)
+    {
+        assert_format(index < mBoxCount, "Box index is out of bounds");
+
+        glm::vec3 center = (box.GetMin() + box.GetMax()) * 0.5f;
+        glm::vec3 extent = (box.GetMax() - box.GetMin()) * 0.5f;
+
+        mCentersX[index] = center.x;
+        mCentersY[index] = center.y;
+        mCentersZ[index] = center.z;
+        mExtentsX[index] = extent.x;
+        mExtentsY[index] = extent.y;
+        mExtentsZ[index] = extent.z;
+    }
+
+    void FrustumCuller::Cull(const Frustum& frustum, std::vector<uint32_t>& visibleIndices) const
+    {
+        visibleIndices.clear();
+
+#ifdef FRUSTUM_CULLER_SSE
+        struct WidePlane
+        {
+            __m128 NormalX, NormalY, NormalZ;
+            __m128 AbsNormalX, AbsNormalY, AbsNormalZ;
+            __m128 NegatedDistance;
+        };
+
+        std::array<WidePlane, 6> planes;
+
+        for (auto planeIdx = 0; planeIdx < 6; ++planeIdx)
+        {
+            const Plane& plane = frustum.Planes()[planeIdx];
+
+            planes[planeIdx] = {
+                _mm_set1_ps(plane.normal.x), _mm_set1_ps(plane.normal.y), _mm_set1_ps(plane.normal.z),
+                _mm_set1_ps(std::abs(plane.normal.x)), _mm_set1_ps(std::abs(plane.normal.y)), _mm_set1_ps(std::abs(plane.normal.z)),
+                _mm_set1_ps(-plane.distance)
+            };
+        }
+
+        const __m128 zero = _mm_setzero_ps();
+
+        for (uint64_t batchStart = 0; batchStart < mBoxCount; batchStart += BatchSize)
+        {
+            __m128 centerX = _mm_loadu_ps(&mCentersX[batchStart]);
+            __m128 centerY = _mm_loadu_ps(&mCentersY[batchStart]);
+            __m128 centerZ = _mm_loadu_ps(&mCentersZ[batchStart]);
+            __m128 extentX = _mm_loadu_ps(&mExtentsX[batchStart]);
+            __m128 extentY = _mm_loadu_ps(&mExtentsY[batchStart]);
+            __m128 extentZ = _mm_loadu_ps(&mExtentsZ[batchStart]);
+
+            __m128 inside = _mm_cmpeq_ps(zero, zero);
+
+            for (const WidePlane& plane : planes)
+            {
+                // dot(n, center) - d + dot(abs(n), extent) >= 0 for boxes not fully behind the plane
+                __m128 distance = _mm_add_ps(_mm_mul_ps(plane.NormalX, centerX), plane.NegatedDistance);
+                distance = _mm_add_ps(_mm_mul_ps(plane.NormalY, centerY), distance);
+                distance = _mm_add_ps(_mm_mul_ps(plane.NormalZ, centerZ), distance);
+                distance = _mm_add_ps(_mm_mul_ps(plane.AbsNormalX, extentX), distance);
+                distance = _mm_add_ps(_mm_mul_ps(plane.AbsNormalY, extentY), distance);
+                distance = _mm_add_ps(_mm_mul_ps(plane.AbsNormalZ, extentZ), distance);
+
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, zero));
+            }
+
+            int mask = _mm_movemask_ps(inside);
+
+            if (mask == 0)
+            {
+                continue;
+            }
+
+            // Skip padding lanes of the last batch
+            uint64_t laneCount = std::min(BatchSize, mBoxCount - batchStart);
+
+            for (uint64_t lane = 0; lane < laneCount; ++lane)
+            {
+                if (mask & (1 << lane))
+                {
+                    visibleIndices.push_back(uint32_t(batchStart + lane));
+                }
+            }
+        }
+#else
+        CullScalar(frustum, visibleIndices);
+#endif
+    }
+
+    void FrustumCuller::CullScalar(const Frustum& frustum, std::vector<uint32_t>& visibleIndices) const
+    {
+        for (uint64_t boxIdx = 0; boxIdx < mBoxCount; ++boxIdx)
+        {
+            glm::vec3 center{ mCentersX[boxIdx], mCentersY[boxIdx], mCentersZ[boxIdx] };
+            glm::vec3 extent{ mExtentsX[boxIdx], mExtentsY[boxIdx], mExtentsZ[boxIdx] };
+
+            bool isInside = true;
+
+            for (const Plane& plane : frustum.Planes())
+            {
+                if (glm::dot(plane.normal, center) - plane.distance + glm::dot(glm::abs(plane.normal), extent) < 0.0f)
+                {
+                    isInside = false;
+                    break;
+                }
+            }
+
+            if (isInside)
+            {
+                visibleIndices.push_back(uint32_t(boxIdx));
+            }
+        }
+    }
+
+}
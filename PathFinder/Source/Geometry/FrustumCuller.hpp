@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Frustum.hpp"
+#include "AABB.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace Geometry
+{
+
+    // Tests large sets of boxes against a frustum several boxes at a time.
+    // Boxes are stored as structure of arrays of centers and half extents
+    // so that each plane test is a handful of wide multiply-adds.
+    class FrustumCuller
+    {
+    public:
+        void Resize(uint64_t boxCount);
+        void SetBox(uint64_t index, const AABB& box);
+
+        // Fills visible box indices in increasing order
+        void Cull(const Frustum& frustum, std::vector<uint32_t>& visibleIndices) const;
+
+    private:
+        static constexpr uint64_t BatchSize = 4;
+
+        void CullScalar(const Frustum& frustum, std::vector<uint32_t>& visibleIndices) const;
+
+        std::vector<float> mCentersX;
+        std::vector<float> mCentersY;
+        std::vector<float> mCentersZ;
+        std::vector<float> mExtentsX;
+        std::vector<float> mExtentsY;
+        std::vector<float> mExtentsZ;
+
+        uint64_t mBoxCount = 0;
+
+    public:
+        inline auto BoxCount() const { return mBoxCount; }
+    };
+
+}
@@ -106,7 +106,7 @@ namespace HAL
         mList->CopyBufferRegion(destination.D3DResource(), destinationOffset, source.D3DResource(), sourceOffset, copyRegionSize);
     }
 
-    void CopyCommandListBase::CopyBufferToTexture(const Buffer& buffer, const Texture& texture, const SubresourceFootprint& footprint)
+    void CopyCommandListBase::CopyBufferToTexture(const Buffer& buffer, const Texture& texture, const SubresourceFootprint& footprint, uint64_t bufferOffset)
     {
         D3D12_TEXTURE_COPY_LOCATION srcLocation{};
         D3D12_TEXTURE_COPY_LOCATION dstLocation{};
@@ -114,6 +114,7 @@ namespace HAL
         srcLocation.pResource = buffer.D3DResource();
         srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
         srcLocation.PlacedFootprint = footprint.D3DFootprint();
+        srcLocation.PlacedFootprint.Offset += bufferOffset;
 
         dstLocation.pResource = texture.D3DResource();
         dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
@@ -328,4 +329,9 @@ namespace HAL
         mList->DrawIndexedInstanced(indexCount, instanceCount, indexStart, vertexStart, 1);
     }
 
+    void GraphicsCommandList::ExecuteIndirect(const CommandSignature& signature, const Buffer& argumentBuffer, uint64_t argumentBufferOffset, uint32_t commandCount)
+    {
+        mList->ExecuteIndirect(signature.D3DSignature(), commandCount, argumentBuffer.D3DResource(), argumentBufferOffset, nullptr, 0);
+    }
+
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
 #include "Fence.hpp"
 #include "Buffer.hpp"
 #include "QueryHeap.hpp"
+#include "CommandSignature.hpp"
 #include "RayTracingAccelerationStructure.hpp"
 #include "ResourceFootprint.hpp"
 #include "ShaderRegister.hpp"
@@ -81,7 +82,8 @@ namespace HAL
             const Geometry::Dimensions& regionDimensions
         );
 
-        void CopyBufferToTexture(const Buffer& buffer, const Texture& texture, const SubresourceFootprint& footprint);
+        // Footprint offset is relative to bufferOffset, so a texture can be sourced from any suitably aligned part of a larger buffer
+        void CopyBufferToTexture(const Buffer& buffer, const Texture& texture, const SubresourceFootprint& footprint, uint64_t bufferOffset = 0);
         void CopyTextureToBuffer(const Texture& texture, const Buffer& buffer, const SubresourceFootprint& footprint);
     };
 
@@ -169,6 +171,7 @@ namespace HAL
         void DrawInstanced(uint32_t vertexCount, uint32_t vertexStart, uint32_t instanceCount);
         void DrawIndexed(uint32_t vertexStart, uint32_t indexCount, uint32_t indexStart);
         void DrawIndexedInstanced(uint32_t vertexStart, uint32_t indexCount, uint32_t indexStart, uint32_t instanceCount);
+        void ExecuteIndirect(const CommandSignature& signature, const Buffer& argumentBuffer, uint64_t argumentBufferOffset, uint32_t commandCount);
     };
 }
 
@@ -0,0 +1,59 @@
+#include "CommandSignature.hpp"
+#include "Utils.h"
+
+#include <Foundation/StringUtils.hpp>
+
+namespace HAL
+{
+
+    CommandSignature::CommandSignature(const Device* device)
+        : mDevice{ device } {}
+
+    void CommandSignature::AddDrawArgument()
+    {
+        D3D12_INDIRECT_ARGUMENT_DESC argument{};
+        argument.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW;
+
+        mArguments.push_back(argument);
+        mByteStride += sizeof(D3D12_DRAW_ARGUMENTS);
+    }
+
+    void CommandSignature::AddRootConstantsArgument(uint32_t rootParameterIndex, uint32_t constantCount)
+    {
+        D3D12_INDIRECT_ARGUMENT_DESC argument{};
+        argument.Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+        argument.Constant.RootParameterIndex = rootParameterIndex;
+        argument.Constant.DestOffsetIn32BitValues = 0;
+        argument.Constant.Num32BitValuesToSet = constantCount;
+
+        mArguments.push_back(argument);
+        mByteStride += constantCount * sizeof(uint32_t);
+    }
+
+    void CommandSignature::Compile(const RootSignature* rootSignature)
+    {
+        assert_format(!mArguments.empty(), "Command signature has no arguments");
+
+        D3D12_COMMAND_SIGNATURE_DESC desc{};
+        desc.ByteStride = mByteStride;
+        desc.NumArgumentDescs = (UINT)mArguments.size();
+        desc.pArgumentDescs = mArguments.data();
+        desc.NodeMask = mDevice->NodeMask();
+
+        ID3D12RootSignature* d3dRootSignature = rootSignature ? rootSignature->D3DSignature() : nullptr;
+        ThrowIfFailed(mDevice->D3DDevice()->CreateCommandSignature(&desc, d3dRootSignature, IID_PPV_ARGS(&mSignature)));
+
+        mSignature->SetName(StringToWString(mDebugName).c_str());
+    }
+
+    void CommandSignature::SetDebugName(const std::string& name)
+    {
+        if (mSignature)
+        {
+            mSignature->SetName(StringToWString(name).c_str());
+        }
+
+        mDebugName = name;
+    }
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <cstdint>
+#include <vector>
+
+#include "GraphicAPIObject.hpp"
+#include "Device.hpp"
+#include "RootSignature.hpp"
+
+namespace HAL
+{
+
+    // Layout matches D3D12_DRAW_ARGUMENTS
+    struct DrawArguments
+    {
+        uint32_t VertexCount = 0;
+        uint32_t InstanceCount = 1;
+        uint32_t VertexStart = 0;
+        uint32_t InstanceStart = 0;
+    };
+
+    // Argument layout of a command signature made of a single root constant followed by a draw
+    struct RootConstantDrawArguments
+    {
+        uint32_t RootConstant = 0;
+        DrawArguments Draw;
+    };
+
+    class CommandSignature : public GraphicAPIObject
+    {
+    public:
+        CommandSignature(const Device* device);
+
+        void AddDrawArgument();
+        void AddRootConstantsArgument(uint32_t rootParameterIndex, uint32_t constantCount);
+
+        // Root signature is required when any argument changes root parameters
+        void Compile(const RootSignature* rootSignature = nullptr);
+
+        virtual void SetDebugName(const std::string& name) override;
+
+    private:
+        std::vector<D3D12_INDIRECT_ARGUMENT_DESC> mArguments;
+        Microsoft::WRL::ComPtr<ID3D12CommandSignature> mSignature;
+        const Device* mDevice;
+        uint32_t mByteStride = 0;
+        std::string mDebugName;
+
+    public:
+        inline ID3D12CommandSignature* D3DSignature() const { return mSignature.Get(); }
+        inline auto ByteStride() const { return mByteStride; }
+    };
+
+}
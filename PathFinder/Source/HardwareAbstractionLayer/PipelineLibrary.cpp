@@ -0,0 +1,89 @@
+#include "PipelineLibrary.hpp"
+#include "Utils.h"
+
+#include <Foundation/StringUtils.hpp>
+
+namespace HAL
+{
+
+    PipelineLibrary::PipelineLibrary(const Device* device, std::vector<uint8_t>&& serializedData)
+        : mDevice{ device }, mSerializedData{ std::move(serializedData) }
+    {
+        if (mSerializedData.empty())
+        {
+            CreateEmptyLibrary();
+            return;
+        }
+
+        HRESULT result = mDevice->D3DDevice()->CreatePipelineLibrary(mSerializedData.data(), mSerializedData.size(), IID_PPV_ARGS(&mLibrary));
+
+        // Driver or adapter change, or simply a corrupted file. All states will be recompiled.
+        if (FAILED(result))
+        {
+            mSerializedData.clear();
+            CreateEmptyLibrary();
+        }
+    }
+
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> PipelineLibrary::LoadGraphicsState(const std::wstring& name, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc)
+    {
+        std::lock_guard lock{ mAccessMutex };
+
+        Microsoft::WRL::ComPtr<ID3D12PipelineState> state;
+
+        // E_INVALIDARG for missing names and for descriptions that don't match stored state
+        if (FAILED(mLibrary->LoadGraphicsPipeline(name.c_str(), &desc, IID_PPV_ARGS(&state))))
+        {
+            return nullptr;
+        }
+
+        return state;
+    }
+
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> PipelineLibrary::LoadComputeState(const std::wstring& name, const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc)
+    {
+        std::lock_guard lock{ mAccessMutex };
+
+        Microsoft::WRL::ComPtr<ID3D12PipelineState> state;
+
+        if (FAILED(mLibrary->LoadComputePipeline(name.c_str(), &desc, IID_PPV_ARGS(&state))))
+        {
+            return nullptr;
+        }
+
+        return state;
+    }
+
+    void PipelineLibrary::StoreState(const std::wstring& name, ID3D12PipelineState* state)
+    {
+        std::lock_guard lock{ mAccessMutex };
+
+        // Fails if name is already taken, which is fine since names are derived from state contents
+        if (SUCCEEDED(mLibrary->StorePipeline(name.c_str(), state)))
+        {
+            mIsModified = true;
+        }
+    }
+
+    std::vector<uint8_t> PipelineLibrary::Serialize()
+    {
+        std::lock_guard lock{ mAccessMutex };
+
+        std::vector<uint8_t> data(mLibrary->GetSerializedSize());
+        ThrowIfFailed(mLibrary->Serialize(data.data(), data.size()));
+        mIsModified = false;
+
+        return data;
+    }
+
+    void PipelineLibrary::SetDebugName(const std::string& name)
+    {
+        mLibrary->SetName(StringToWString(name).c_str());
+    }
+
+    void PipelineLibrary::CreateEmptyLibrary()
+    {
+        ThrowIfFailed(mDevice->D3DDevice()->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&mLibrary)));
+    }
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <mutex>
+
+#include "GraphicAPIObject.hpp"
+#include "Device.hpp"
+
+namespace HAL
+{
+
+    // Driver-compiled pipeline states that can be saved to disk and loaded back on next run,
+    // skipping driver compilation of states that haven't changed.
+    // Safe to use from multiple threads.
+    class PipelineLibrary : public GraphicAPIObject
+    {
+    public:
+        // Serialized data produced by a different driver or adapter is discarded and library starts empty
+        PipelineLibrary(const Device* device, std::vector<uint8_t>&& serializedData);
+
+        // Returns null if library has no state with such name
+        Microsoft::WRL::ComPtr<ID3D12PipelineState> LoadGraphicsState(const std::wstring& name, const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc);
+        Microsoft::WRL::ComPtr<ID3D12PipelineState> LoadComputeState(const std::wstring& name, const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc);
+
+        void StoreState(const std::wstring& name, ID3D12PipelineState* state);
+
+        std::vector<uint8_t> Serialize();
+
+        virtual void SetDebugName(const std::string& name) override;
+
+    private:
+        void CreateEmptyLibrary();
+
+        const Device* mDevice;
+
+        // Library references serialized data and requires it to stay alive
+        std::vector<uint8_t> mSerializedData;
+
+        Microsoft::WRL::ComPtr<ID3D12PipelineLibrary> mLibrary;
+        std::mutex mAccessMutex;
+        bool mIsModified = false;
+
+    public:
+        inline bool IsModified() const { return mIsModified; }
+    };
+
+}
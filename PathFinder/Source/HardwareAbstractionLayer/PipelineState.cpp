@@ -1,4 +1,5 @@
 #include "PipelineState.hpp"
+#include "PipelineStateCacheKey.hpp"
 #include "Utils.h"
 
 #include <Foundation/STDHelpers.hpp>
@@ -14,6 +15,17 @@ namespace HAL
 
     PipelineState::~PipelineState() {}
 
+    void PipelineState::Compile(PipelineLibrary* library)
+    {
+        SetCompiledState(CreateD3DState(library));
+    }
+
+    void PipelineState::SetCompiledState(const Microsoft::WRL::ComPtr<ID3D12PipelineState>& state)
+    {
+        mState = state;
+        mState->SetName(StringToWString(mDebugName).c_str());
+    }
+
     void PipelineState::SetDebugName(const std::string& name)
     {
         if (mState)
@@ -24,9 +36,46 @@ namespace HAL
         mDebugName = name;
     }
 
+    std::wstring PipelineState::LibraryStateName() const
+    {
+        return StringToWString(StringFormat("%016llx", (unsigned long long)CacheKey()));
+    }
+
+
+
+    uint64_t GraphicsPipelineState::CacheKey() const
+    {
+        return PipelineStateCacheKey(D3DDesc(), mRootSignature->SerializedHash());
+    }
+
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> GraphicsPipelineState::CreateD3DState(PipelineLibrary* library) const
+    {
+        D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = D3DDesc();
+        Microsoft::WRL::ComPtr<ID3D12PipelineState> state;
+        std::wstring libraryStateName;
+
+        if (library)
+        {
+            libraryStateName = LibraryStateName();
+            state = library->LoadGraphicsState(libraryStateName, desc);
+
+            if (state)
+            {
+                return state;
+            }
+        }
+
+        ThrowIfFailed(mDevice->D3DDevice()->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&state)));
+
+        if (library)
+        {
+            library->StoreState(libraryStateName, state.Get());
+        }
 
+        return state;
+    }
 
-    void GraphicsPipelineState::Compile()
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC GraphicsPipelineState::D3DDesc() const
     {
         D3D12_GRAPHICS_PIPELINE_STATE_DESC desc{};
 
@@ -66,9 +115,7 @@ namespace HAL
 #if defined(DEBUG) || defined(_DEBUG) 
         //desc.Flags = D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG;
 #endif
-        ThrowIfFailed(mDevice->D3DDevice()->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&mState)));
-
-        mState->SetName(StringToWString(mDebugName).c_str());
+        return desc;
     }
 
     GraphicsPipelineState GraphicsPipelineState::Clone() const
@@ -90,7 +137,39 @@ namespace HAL
 
 
 
-    void ComputePipelineState::Compile()
+    uint64_t ComputePipelineState::CacheKey() const
+    {
+        return PipelineStateCacheKey(D3DDesc(), mRootSignature->SerializedHash());
+    }
+
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> ComputePipelineState::CreateD3DState(PipelineLibrary* library) const
+    {
+        D3D12_COMPUTE_PIPELINE_STATE_DESC desc = D3DDesc();
+        Microsoft::WRL::ComPtr<ID3D12PipelineState> state;
+        std::wstring libraryStateName;
+
+        if (library)
+        {
+            libraryStateName = LibraryStateName();
+            state = library->LoadComputeState(libraryStateName, desc);
+
+            if (state)
+            {
+                return state;
+            }
+        }
+
+        ThrowIfFailed(mDevice->D3DDevice()->CreateComputePipelineState(&desc, IID_PPV_ARGS(&state)));
+
+        if (library)
+        {
+            library->StoreState(libraryStateName, state.Get());
+        }
+
+        return state;
+    }
+
+    D3D12_COMPUTE_PIPELINE_STATE_DESC ComputePipelineState::D3DDesc() const
     {
         D3D12_COMPUTE_PIPELINE_STATE_DESC desc{};
 
@@ -101,9 +180,7 @@ namespace HAL
 #if defined(DEBUG) || defined(_DEBUG) 
         //desc.Flags = D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG;
 #endif
-        ThrowIfFailed(mDevice->D3DDevice()->CreateComputePipelineState(&desc, IID_PPV_ARGS(&mState)));
-
-        mState->SetName(StringToWString(mDebugName).c_str());
+        return desc;
     }
 
     ComputePipelineState ComputePipelineState::Clone() const
@@ -113,7 +190,7 @@ namespace HAL
         return newState;
     }
 
-    void ComputePipelineState::ReplaceShader(const Shader* oldShader, const Shader* newShader)
+    void ComputePipelineState::ReplaceShader(const HAL::Shader* oldShader, const HAL::Shader* newShader)
     {
         assert_format(
             mComputeShader == oldShader && 
@@ -16,6 +16,7 @@
 #include "RayTracingPipelineConfig.hpp"
 #include "RayTracingShaderConfig.hpp"
 #include "ShaderTable.hpp"
+#include "PipelineLibrary.hpp"
 
 #include <variant>
 #include <unordered_map>
@@ -30,10 +31,24 @@ namespace HAL
         virtual ~PipelineState() = 0;
 
         virtual void ReplaceShader(const Shader* oldShader, const Shader* newShader) = 0;
-        virtual void Compile() = 0;
+
+        // Identifies state across runs. Derived from serialized root signature,
+        // shader bytecode and fixed function state, so it changes whenever any of them do.
+        virtual uint64_t CacheKey() const = 0;
+
+        // Creates D3D state without modifying this object, so it's safe to call from
+        // a worker thread while the current compiled state is in use.
+        // Library, if provided, is searched first and receives newly created states.
+        virtual Microsoft::WRL::ComPtr<ID3D12PipelineState> CreateD3DState(PipelineLibrary* library) const = 0;
+
+        void Compile(PipelineLibrary* library = nullptr);
+        void SetCompiledState(const Microsoft::WRL::ComPtr<ID3D12PipelineState>& state);
+
         virtual void SetDebugName(const std::string& name) override;
 
     protected:
+        std::wstring LibraryStateName() const;
+
         Microsoft::WRL::ComPtr<ID3D12PipelineState> mState;
         const RootSignature* mRootSignature = nullptr;
         const Device* mDevice;
@@ -56,8 +71,9 @@ namespace HAL
 
         ~GraphicsPipelineState() = default;
 
-        void Compile() override;
         void ReplaceShader(const Shader* oldShader, const Shader* newShader) override;
+        uint64_t CacheKey() const override;
+        Microsoft::WRL::ComPtr<ID3D12PipelineState> CreateD3DState(PipelineLibrary* library) const override;
 
         GraphicsPipelineState Clone() const;
 
@@ -103,11 +119,13 @@ namespace HAL
         inline const PrimitiveTopology& GetPrimitiveTopology() const { return mPrimitiveTopology; }
 
     private:
-        const Shader* mVertexShader;
-        const Shader* mPixelShader;
-        const Shader* mDomainShader;
-        const Shader* mHullShader;
-        const Shader* mGeometryShader;
+        D3D12_GRAPHICS_PIPELINE_STATE_DESC D3DDesc() const;
+
+        const Shader* mVertexShader = nullptr;
+        const Shader* mPixelShader = nullptr;
+        const Shader* mDomainShader = nullptr;
+        const Shader* mHullShader = nullptr;
+        const Shader* mGeometryShader = nullptr;
         BlendState mBlendState;
         RasterizerState mRasterizerState;
         DepthStencilState mDepthStencilState;
@@ -123,15 +141,18 @@ namespace HAL
     public:
         using PipelineState::PipelineState;
 
-        virtual void Compile() override;
         void ReplaceShader(const HAL::Shader* oldShader, const HAL::Shader* newShader) override;
+        uint64_t CacheKey() const override;
+        Microsoft::WRL::ComPtr<ID3D12PipelineState> CreateD3DState(PipelineLibrary* library) const override;
 
         inline void SetComputeShader(const Shader* computeShader) { mComputeShader = computeShader; }
 
         ComputePipelineState Clone() const;
 
     private:
-        const Shader* mComputeShader;
+        D3D12_COMPUTE_PIPELINE_STATE_DESC D3DDesc() const;
+
+        const Shader* mComputeShader = nullptr;
     };
 
 
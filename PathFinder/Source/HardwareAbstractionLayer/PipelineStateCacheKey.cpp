@@ -0,0 +1,111 @@
+#include "PipelineStateCacheKey.hpp"
+
+#include <Foundation/Hash.hpp>
+
+#include <cstring>
+
+namespace HAL
+{
+
+    namespace
+    {
+        uint64_t HashBytecode(const D3D12_SHADER_BYTECODE& bytecode, uint64_t hash)
+        {
+            hash = Foundation::HashValue(bytecode.BytecodeLength, hash);
+            return Foundation::HashBytes(bytecode.pShaderBytecode, bytecode.BytecodeLength, hash);
+        }
+
+        // D3D descriptions are hashed field by field: they contain pointers and padding bytes
+        uint64_t HashBlendDesc(const D3D12_BLEND_DESC& desc, uint64_t hash)
+        {
+            hash = Foundation::HashValue(desc.AlphaToCoverageEnable, hash);
+            hash = Foundation::HashValue(desc.IndependentBlendEnable, hash);
+
+            for (const D3D12_RENDER_TARGET_BLEND_DESC& rt : desc.RenderTarget)
+            {
+                hash = Foundation::HashValue(rt.BlendEnable, hash);
+                hash = Foundation::HashValue(rt.LogicOpEnable, hash);
+                hash = Foundation::HashValue(rt.SrcBlend, hash);
+                hash = Foundation::HashValue(rt.DestBlend, hash);
+                hash = Foundation::HashValue(rt.BlendOp, hash);
+                hash = Foundation::HashValue(rt.SrcBlendAlpha, hash);
+                hash = Foundation::HashValue(rt.DestBlendAlpha, hash);
+                hash = Foundation::HashValue(rt.BlendOpAlpha, hash);
+                hash = Foundation::HashValue(rt.LogicOp, hash);
+                hash = Foundation::HashValue(rt.RenderTargetWriteMask, hash);
+            }
+
+            return hash;
+        }
+
+        uint64_t HashDepthStencilDesc(const D3D12_DEPTH_STENCIL_DESC& desc, uint64_t hash)
+        {
+            hash = Foundation::HashValue(desc.DepthEnable, hash);
+            hash = Foundation::HashValue(desc.DepthWriteMask, hash);
+            hash = Foundation::HashValue(desc.DepthFunc, hash);
+            hash = Foundation::HashValue(desc.StencilEnable, hash);
+            hash = Foundation::HashValue(desc.StencilReadMask, hash);
+            hash = Foundation::HashValue(desc.StencilWriteMask, hash);
+            hash = Foundation::HashValue(desc.FrontFace, hash);
+            hash = Foundation::HashValue(desc.BackFace, hash);
+            return hash;
+        }
+
+        uint64_t HashInputLayout(const D3D12_INPUT_LAYOUT_DESC& desc, uint64_t hash)
+        {
+            hash = Foundation::HashValue(desc.NumElements, hash);
+
+            for (auto elementIdx = 0u; elementIdx < desc.NumElements; ++elementIdx)
+            {
+                const D3D12_INPUT_ELEMENT_DESC& element = desc.pInputElementDescs[elementIdx];
+                hash = Foundation::HashBytes(element.SemanticName, std::strlen(element.SemanticName), hash);
+                hash = Foundation::HashValue(element.SemanticIndex, hash);
+                hash = Foundation::HashValue(element.Format, hash);
+                hash = Foundation::HashValue(element.InputSlot, hash);
+                hash = Foundation::HashValue(element.AlignedByteOffset, hash);
+                hash = Foundation::HashValue(element.InputSlotClass, hash);
+                hash = Foundation::HashValue(element.InstanceDataStepRate, hash);
+            }
+
+            return hash;
+        }
+    }
+
+    uint64_t PipelineStateCacheKey(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash)
+    {
+        uint64_t hash = Foundation::HashValue(rootSignatureHash);
+
+        hash = HashBytecode(desc.VS, hash);
+        hash = HashBytecode(desc.PS, hash);
+        hash = HashBytecode(desc.DS, hash);
+        hash = HashBytecode(desc.HS, hash);
+        hash = HashBytecode(desc.GS, hash);
+        hash = HashBlendDesc(desc.BlendState, hash);
+        hash = Foundation::HashValue(desc.SampleMask, hash);
+        hash = Foundation::HashValue(desc.RasterizerState, hash);
+        hash = HashDepthStencilDesc(desc.DepthStencilState, hash);
+        hash = HashInputLayout(desc.InputLayout, hash);
+        hash = Foundation::HashValue(desc.IBStripCutValue, hash);
+        hash = Foundation::HashValue(desc.PrimitiveTopologyType, hash);
+        hash = Foundation::HashValue(desc.NumRenderTargets, hash);
+        hash = Foundation::HashValue(desc.RTVFormats, hash);
+        hash = Foundation::HashValue(desc.DSVFormat, hash);
+        hash = Foundation::HashValue(desc.SampleDesc, hash);
+        hash = Foundation::HashValue(desc.NodeMask, hash);
+        hash = Foundation::HashValue(desc.Flags, hash);
+
+        return hash;
+    }
+
+    uint64_t PipelineStateCacheKey(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash)
+    {
+        uint64_t hash = Foundation::HashValue(rootSignatureHash);
+
+        hash = HashBytecode(desc.CS, hash);
+        hash = Foundation::HashValue(desc.NodeMask, hash);
+        hash = Foundation::HashValue(desc.Flags, hash);
+
+        return hash;
+    }
+
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <d3d12.h>
+#include <cstdint>
+
+namespace HAL
+{
+
+    // Keys that identify pipeline states across runs, e.g. to name them in a pipeline library.
+    // Root signature pointer of a description differs between runs, so signature is identified 
+    // by a hash of its serialized form instead. Shader bytecode is hashed by contents.
+    uint64_t PipelineStateCacheKey(const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash);
+    uint64_t PipelineStateCacheKey(const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc, uint64_t rootSignatureHash);
+
+}
@@ -29,9 +29,24 @@ namespace HAL
 
         if (mBuildScratchBuffer) mD3DAccelerationStructure.ScratchAccelerationStructureData = mBuildScratchBuffer->GPUVirtualAddress();
         if (mFinalBuffer) mD3DAccelerationStructure.DestAccelerationStructureData = mFinalBuffer->GPUVirtualAddress();
-        if (mUpdateBuffer) mD3DAccelerationStructure.SourceAccelerationStructureData = mUpdateBuffer->GPUVirtualAddress();
+        mD3DAccelerationStructure.SourceAccelerationStructureData = mUpdateBuffer ? mUpdateBuffer->GPUVirtualAddress() : 0;
 
         mD3DAccelerationStructure.Inputs = mD3DInputs;
+
+        // Presence of a source structure means an update (refit) is requested instead of a full build
+        if (mUpdateBuffer) mD3DAccelerationStructure.Inputs.Flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PERFORM_UPDATE;
+    }
+
+    void RayTracingAccelerationStructure::SetAllowsUpdates(bool allowsUpdates)
+    {
+        if (allowsUpdates)
+        {
+            mD3DInputs.Flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE;
+        }
+        else
+        {
+            mD3DInputs.Flags &= ~D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE;
+        }
     }
 
     void RayTracingAccelerationStructure::Clear()
@@ -99,12 +114,7 @@ namespace HAL
 
         instance.AccelerationStructure = blas.FinalBuffer()->GPUVirtualAddress();
 
-        // A 3x4 transform matrix in row - major layout representing the instance-to-world transformation
-        for (auto row = 0u; row < 3; row++) {
-            for (auto column = 0u; column < 4; column++) {
-                instance.Transform[row][column] = transform[column][row];
-            }
-        }
+        WriteInstanceTransform(instance, transform);
 
         mD3DInstances.push_back(instance);
 
@@ -112,6 +122,12 @@ namespace HAL
         mD3DInputs.NumDescs = (UINT)mD3DInstances.size();
     }
 
+    void RayTracingTopAccelerationStructure::UpdateInstanceTransform(uint64_t instanceIndex, const glm::mat4& transform)
+    {
+        assert_format(instanceIndex < mD3DInstances.size(), "Instance index is out of bounds");
+        WriteInstanceTransform(mD3DInstances[instanceIndex], transform);
+    }
+
     RayTracingTopAccelerationStructure::MemoryRequirements RayTracingTopAccelerationStructure::QueryMemoryRequirements() const
     {
         CommonMemoryRequirements commonRequirements = QueryCommonMemoryRequirements();
@@ -144,4 +160,14 @@ namespace HAL
         mD3DInstances.clear();
     }
 
+    void RayTracingTopAccelerationStructure::WriteInstanceTransform(D3D12_RAYTRACING_INSTANCE_DESC& instance, const glm::mat4& transform)
+    {
+        // A 3x4 transform matrix in row - major layout representing the instance-to-world transformation
+        for (auto row = 0u; row < 3; row++) {
+            for (auto column = 0u; column < 4; column++) {
+                instance.Transform[row][column] = transform[column][row];
+            }
+        }
+    }
+
 }
@@ -50,6 +50,9 @@ namespace HAL
         virtual void Clear() = 0;
         virtual void SetBuffers(const Buffer* destinationBuffer, const Buffer* scratchBuffer, const Buffer* updateBuffer = nullptr);
 
+        // Structure must be built with updates allowed to be later updated (refitted) instead of rebuilt
+        void SetAllowsUpdates(bool allowsUpdates);
+
     protected:
         struct CommonMemoryRequirements
         {
@@ -131,6 +134,7 @@ namespace HAL
         using RayTracingAccelerationStructure::RayTracingAccelerationStructure;
 
         void AddInstance(const RayTracingBottomAccelerationStructure& blas, const InstanceInfo& instanceInfo, const glm::mat4& transform);
+        void UpdateInstanceTransform(uint64_t instanceIndex, const glm::mat4& transform);
         MemoryRequirements QueryMemoryRequirements() const;
 
         void SetBuffers(
@@ -144,8 +148,13 @@ namespace HAL
         virtual void Clear() override;
 
     private:
+        void WriteInstanceTransform(D3D12_RAYTRACING_INSTANCE_DESC& instance, const glm::mat4& transform);
+
         const Buffer* mInstanceBuffer = nullptr;
         std::vector<D3D12_RAYTRACING_INSTANCE_DESC> mD3DInstances;
+
+    public:
+        inline auto InstanceCount() const { return mD3DInstances.size(); }
     };
 
 }
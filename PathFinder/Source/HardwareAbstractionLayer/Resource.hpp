@@ -4,6 +4,7 @@
 #include <dxgi.h>
 #include <cstdint>
 #include <optional>
+#include <limits>
 #include <array>
 #include <functional>
 #include <d3d12.h>
@@ -28,6 +29,8 @@ namespace HAL
     public:
         using DeallocationCallback = std::function<void()>;
 
+        static constexpr uint32_t InvalidStateTrackingIndex = std::numeric_limits<uint32_t>::max();
+
         Resource(const Microsoft::WRL::ComPtr<ID3D12Resource>& existingResourcePtr);
         Resource(const Resource& other) = delete;
         Resource(Resource&& other) = default;
@@ -60,6 +63,9 @@ namespace HAL
         uint64_t mHeapOffset = 0;
         D3D12_RESOURCE_DESC mDescription{};
 
+        // Dense index given out by a state tracker, so that tracked states can be kept in flat arrays
+        uint32_t mStateTrackingIndex = InvalidStateTrackingIndex;
+
     public:
         inline ID3D12Resource* D3DResource() const { return mResource.Get(); }
         inline const D3D12_RESOURCE_DESC& D3DDescription() const { return mDescription; };
@@ -68,6 +74,9 @@ namespace HAL
         inline auto TotalMemory() const { return mTotalMemory; }
         inline auto ResourceAlignment() const { return mResourceAlignment; }
         inline auto HeapOffset() const { return mHeapOffset; }
+        inline auto StateTrackingIndex() const { return mStateTrackingIndex; }
+
+        inline void SetStateTrackingIndex(uint32_t index) { mStateTrackingIndex = index; }
     };
 
 }
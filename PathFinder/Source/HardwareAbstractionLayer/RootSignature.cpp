@@ -2,6 +2,7 @@
 #include "Utils.h"
 
 #include <Foundation/StringUtils.hpp>
+#include <Foundation/Hash.hpp>
 
 
 namespace HAL
@@ -80,6 +81,8 @@ namespace HAL
         D3D12SerializeVersionedRootSignature(&mDesc, &signatureBlob, &errors);
         assert_format(!errors, (char*)errors->GetBufferPointer());
         ThrowIfFailed(mDevice->D3DDevice()->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(), IID_PPV_ARGS(&mSignature)));
+
+        mSerializedHash = Foundation::HashBytes(signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize());
     
         mSignature->SetName(StringToWString(mDebugName).c_str());
     }
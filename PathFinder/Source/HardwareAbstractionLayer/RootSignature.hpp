@@ -58,9 +58,13 @@ namespace HAL
         Microsoft::WRL::ComPtr<ID3D12RootSignature> mSignature;
         const Device* mDevice;
         std::string mDebugName;
+        uint64_t mSerializedHash = 0;
 
     public:
         inline ID3D12RootSignature* D3DSignature() const { return mSignature.Get(); }
+
+        // Hash of serialized signature, identifies signature contents across runs
+        inline auto SerializedHash() const { return mSerializedHash; }
     };
 
 }
@@ -81,7 +81,7 @@ namespace HAL
 
     ShaderCompiler::ShaderCompilationResult ShaderCompiler::CompileShader(const std::filesystem::path& path, Shader::Stage stage, const std::string& entryPoint, bool debugBuild, bool separatePDB)
     {
-        BlobCompilationResult blobCompilationResult = CompileBlob(path, ProfileString(stage, Profile::P6_6), entryPoint, debugBuild, separatePDB);
+        BlobCompilationResult blobCompilationResult = CompileBlob(path, ProfileString(stage, TargetProfile), entryPoint, debugBuild, separatePDB);
         ShaderCompilationResult shaderCompilationResult{ Shader{ blobCompilationResult.Blob, blobCompilationResult.PDBBlob, entryPoint, stage }, blobCompilationResult.CompiledFileRelativePaths };
         shaderCompilationResult.CompiledShader.SetDebugName(blobCompilationResult.DebugName);
         return shaderCompilationResult;
@@ -89,13 +89,70 @@ namespace HAL
 
     ShaderCompiler::LibraryCompilationResult ShaderCompiler::CompileLibrary(const std::filesystem::path& path, bool debugBuild, bool separatePDB)
     {
-        BlobCompilationResult blobCompilationResult = CompileBlob(path, LibProfileString(Profile::P6_6), "", debugBuild, separatePDB);
+        BlobCompilationResult blobCompilationResult = CompileBlob(path, LibProfileString(TargetProfile), "", debugBuild, separatePDB);
         LibraryCompilationResult libraryCompilationResult{ Library{ blobCompilationResult.Blob, blobCompilationResult.PDBBlob }, blobCompilationResult.CompiledFileRelativePaths };
         libraryCompilationResult.CompiledLibrary.SetDebugName(blobCompilationResult.DebugName);
         return libraryCompilationResult;
     }
 
-    std::string ShaderCompiler::ProfileString(Shader::Stage stage, Profile profile)
+    Microsoft::WRL::ComPtr<IDxcBlob> ShaderCompiler::CreateBlob(const std::vector<uint8_t>& bytes) const
+    {
+        Microsoft::WRL::ComPtr<IDxcBlobEncoding> blob;
+        ThrowIfFailed(mLibrary->CreateBlobWithEncodingOnHeapCopy(bytes.data(), (UINT32)bytes.size(), 0, blob.GetAddressOf()));
+        return blob;
+    }
+
+    std::vector<std::wstring> ShaderCompiler::CompilationArguments(bool debugBuild, bool separatePDB) const
+    {
+        std::vector<std::wstring> arguments;
+        arguments.push_back(L"/all_resources_bound");
+
+        if (debugBuild)
+        {
+            arguments.push_back(L"/Zi");
+            arguments.push_back(L"/Od");
+
+            if (separatePDB)
+            {
+                arguments.push_back(L"/Qstrip_debug");
+            }
+        }
+
+        return arguments;
+    }
+
+    std::string ShaderCompiler::VersionString() const
+    {
+        std::string version = "Unknown";
+
+        Microsoft::WRL::ComPtr<IDxcVersionInfo> versionInfo;
+
+        if (SUCCEEDED(mCompiler.As(&versionInfo)))
+        {
+            UINT32 major = 0;
+            UINT32 minor = 0;
+            versionInfo->GetVersion(&major, &minor);
+            version = std::to_string(major) + "." + std::to_string(minor);
+        }
+
+        Microsoft::WRL::ComPtr<IDxcVersionInfo2> versionInfo2;
+
+        if (SUCCEEDED(mCompiler.As(&versionInfo2)))
+        {
+            UINT32 commitCount = 0;
+            char* commitHash = nullptr;
+
+            if (SUCCEEDED(versionInfo2->GetCommitInfo(&commitCount, &commitHash)) && commitHash)
+            {
+                version += std::string{ "." } + std::to_string(commitCount) + "." + commitHash;
+                CoTaskMemFree(commitHash);
+            }
+        }
+
+        return version;
+    }
+
+    std::string ShaderCompiler::ProfileString(Shader::Stage stage, Profile profile) const
     {
         std::string profileString;
 
@@ -122,7 +179,7 @@ namespace HAL
         return profileString;
     }
 
-    std::string ShaderCompiler::LibProfileString(Profile profile)
+    std::string ShaderCompiler::LibProfileString(Profile profile) const
     {
         switch (profile)
         {
@@ -142,20 +199,7 @@ namespace HAL
         std::wstring wProfile = StringToWString(profileString);
         LPWSTR suggestedDebugName = nullptr;
 
-        std::vector<std::wstring> arguments;
-        arguments.push_back(L"/all_resources_bound");
-
-        if (debugBuild)
-        {
-            arguments.push_back(L"/Zi");
-            arguments.push_back(L"/Od");
-
-            if (separatePDB)
-            {
-                arguments.push_back(L"/Qstrip_debug");
-            }
-        }
-
+        std::vector<std::wstring> arguments = CompilationArguments(debugBuild, separatePDB);
         std::vector<LPCWSTR> argumentPtrs;
 
         for (auto& argument : arguments)
@@ -56,12 +56,6 @@ namespace HAL
             std::vector<std::string> CompiledFileRelativePaths;
         };
 
-        ShaderCompiler();
-
-        ShaderCompilationResult CompileShader(const std::filesystem::path& path, Shader::Stage stage, const std::string& entryPoint, bool debugBuild, bool separatePDB);
-        LibraryCompilationResult CompileLibrary(const std::filesystem::path& path, bool debugBuild, bool separatePDB);
-
-    private:
         struct BlobCompilationResult
         {
             Microsoft::WRL::ComPtr<IDxcBlob> Blob;
@@ -70,10 +64,27 @@ namespace HAL
             std::string DebugName;
         };
 
-        std::string ProfileString(Shader::Stage stage, Profile profile);
-        std::string LibProfileString(Profile profile);
+        static constexpr Profile TargetProfile = Profile::P6_6;
+
+        ShaderCompiler();
+
+        ShaderCompilationResult CompileShader(const std::filesystem::path& path, Shader::Stage stage, const std::string& entryPoint, bool debugBuild, bool separatePDB);
+        LibraryCompilationResult CompileLibrary(const std::filesystem::path& path, bool debugBuild, bool separatePDB);
+
+        // Compiles bytecode only, for callers that keep binaries without constructing shader objects. Empty entry point compiles a library.
         BlobCompilationResult CompileBlob(const std::filesystem::path& path, const std::string& profileString, const std::string& entryPoint, bool debugBuild, bool separatePDB);
 
+        // Wraps previously compiled bytes, for example ones loaded from disk, so that they can be used to construct shaders and libraries
+        Microsoft::WRL::ComPtr<IDxcBlob> CreateBlob(const std::vector<uint8_t>& bytes) const;
+
+        std::string ProfileString(Shader::Stage stage, Profile profile) const;
+        std::string LibProfileString(Profile profile) const;
+        std::vector<std::wstring> CompilationArguments(bool debugBuild, bool separatePDB) const;
+
+        // Compiler and commit version. Binaries produced by different compiler builds are not interchangeable.
+        std::string VersionString() const;
+
+    private:
         Microsoft::WRL::ComPtr<IDxcLibrary> mLibrary;
         Microsoft::WRL::ComPtr<IDxcCompiler2> mCompiler;
     };
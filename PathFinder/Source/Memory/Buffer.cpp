@@ -8,7 +8,7 @@ namespace Memory
         const HAL::BufferProperties& properties, 
         GPUResource::AccessStrategy accessStrategy, 
         ResourceStateTracker* stateTracker,
-        SegregatedPoolsResourceAllocator* resourceAllocator, 
+        PlacedResourceAllocator* resourceAllocator, 
         PoolDescriptorAllocator* descriptorAllocator, 
         CopyRequestManager* copyRequestManager)
         :
@@ -29,7 +29,7 @@ namespace Memory
     Buffer::Buffer(
         const HAL::BufferProperties& properties, 
         ResourceStateTracker* stateTracker, 
-        SegregatedPoolsResourceAllocator* resourceAllocator, 
+        PlacedResourceAllocator* resourceAllocator, 
         PoolDescriptorAllocator* descriptorAllocator, 
         CopyRequestManager* copyRequestManager,
         const HAL::Device& device, 
@@ -40,7 +40,7 @@ namespace Memory
         mRequstedStride{ properties.Stride },
         mProperties{ properties }
     {
-        mBufferPtr = SegregatedPoolsResourceAllocator::BufferPtr{
+        mBufferPtr = PlacedResourceAllocator::BufferPtr{
             new HAL::Buffer{ device, properties, mainResourceExplicitHeap, explicitHeapOffset },
             [](HAL::Buffer* buffer) { delete buffer; }
         };
@@ -146,7 +146,7 @@ namespace Memory
         {
             if (mAccessStrategy != GPUResource::AccessStrategy::DirectUpload)
             {
-                cmdList.CopyBufferRegion(*CurrentFrameUploadBuffer(), *HALBuffer(), 0, HALBuffer()->ElementCapacity(), 0);
+                cmdList.CopyBufferRegion(*CurrentFrameUploadBuffer(), *HALBuffer(), CurrentFrameUploadBufferOffset(), HALBuffer()->ElementCapacity(), 0);
             }
         };
     }
@@ -14,7 +14,7 @@ namespace Memory
             const HAL::BufferProperties& properties,
             GPUResource::AccessStrategy accessStrategy,
             ResourceStateTracker* stateTracker,
-            SegregatedPoolsResourceAllocator* resourceAllocator, 
+            PlacedResourceAllocator* resourceAllocator, 
             PoolDescriptorAllocator* descriptorAllocator,
             CopyRequestManager* copyRequestManager
         );
@@ -22,7 +22,7 @@ namespace Memory
         Buffer(
             const HAL::BufferProperties& properties,
             ResourceStateTracker* stateTracker,
-            SegregatedPoolsResourceAllocator* resourceAllocator,
+            PlacedResourceAllocator* resourceAllocator,
             PoolDescriptorAllocator* descriptorAllocator,
             CopyRequestManager* copyRequestManager,
             const HAL::Device& device,
@@ -54,7 +54,7 @@ namespace Memory
         uint64_t mRequstedStride = 1;
         HAL::BufferProperties mProperties;
 
-        SegregatedPoolsResourceAllocator::BufferPtr mBufferPtr;
+        PlacedResourceAllocator::BufferPtr mBufferPtr;
         HAL::Buffer* mGetterBufferPtr = nullptr;
 
         // Cached values, to be mutated from getters
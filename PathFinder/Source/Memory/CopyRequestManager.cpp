@@ -5,14 +5,19 @@
 namespace Memory
 {
 
-    void CopyRequestManager::RequestUpload(const HAL::Resource* resource, const CopyCommand& copyCommand)
+    CopyRequestManager::CopyRequestManager(Memory::StagingRing* stagingRing)
+        : mStagingRing{ stagingRing } {}
+
+    void CopyRequestManager::RequestUpload(const HAL::Resource* resource, CopyCommand&& copyCommand)
     {
-        mUploadRequests.emplace_back(CopyRequest{ resource, copyCommand });
+        std::lock_guard lock{ mAccessMutex };
+        mUploadRequests.emplace_back(CopyRequest{ resource, std::move(copyCommand) });
     }
 
-    void CopyRequestManager::RequestReadback(const HAL::Resource* resource, const CopyCommand& copyCommand)
+    void CopyRequestManager::RequestReadback(const HAL::Resource* resource, CopyCommand&& copyCommand)
     {
-        mReadbackRequests.emplace_back(CopyRequest{ resource, copyCommand });
+        std::lock_guard lock{ mAccessMutex };
+        mReadbackRequests.emplace_back(CopyRequest{ resource, std::move(copyCommand) });
     }
 
     void CopyRequestManager::FlushUploadRequests()
@@ -1,17 +1,22 @@
 #pragma once
 
-#include <functional>
+#include <mutex>
+#include <vector>
 
 #include <HardwareAbstractionLayer/CommandList.hpp>
 #include <HardwareAbstractionLayer/Resource.hpp>
 
+#include <Foundation/Delegate.hpp>
+
+#include "StagingRing.hpp"
+
 namespace Memory
 {
 
     class CopyRequestManager
     {
     public:
-        using CopyCommand = std::function<void(HAL::CopyCommandListBase&)>;
+        using CopyCommand = Foundation::Delegate<void(HAL::CopyCommandListBase&)>;
 
         struct CopyRequest
         {
@@ -19,8 +24,10 @@ namespace Memory
             CopyCommand Command;
         };
 
-        void RequestUpload(const HAL::Resource* resource, const CopyCommand& copyCommand);
-        void RequestReadback(const HAL::Resource* resource, const CopyCommand& copyCommand);
+        CopyRequestManager(Memory::StagingRing* stagingRing);
+
+        void RequestUpload(const HAL::Resource* resource, CopyCommand&& copyCommand);
+        void RequestReadback(const HAL::Resource* resource, CopyCommand&& copyCommand);
 
         void FlushUploadRequests();
         void FlushReadbackRequests();
@@ -29,10 +36,15 @@ namespace Memory
     private:
         std::vector<CopyRequest> mUploadRequests;
         std::vector<CopyRequest> mReadbackRequests;
+        std::mutex mAccessMutex;
+        Memory::StagingRing* mStagingRing;
 
     public:
         inline const auto& UploadRequests() const { return mUploadRequests; }
+        inline auto& UploadRequests() { return mUploadRequests; }
         inline const auto& ReadbackRequests() const { return mReadbackRequests; }
+        inline auto& ReadbackRequests() { return mReadbackRequests; }
+        inline Memory::StagingRing* StagingRing() const { return mStagingRing; }
     };
 
 }
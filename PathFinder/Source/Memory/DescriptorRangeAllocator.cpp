@@ -0,0 +1,259 @@
+#include "DescriptorRangeAllocator.hpp"
+
+#include <algorithm>
+
+namespace Memory
+{
+
+    DescriptorRangeAllocator::DescriptorRangeAllocator(uint64_t capacity, uint8_t simultaneousFramesInFlight)
+        : mCapacity{ capacity }, mBlockSizes(capacity, 0), mRingFrameTracker{ simultaneousFramesInFlight }
+    {
+        mRingFrameTracker.SetDeallocationCallback([this](const Ring::FrameTailAttributes& frameAttributes)
+        {
+            auto frameIndex = frameAttributes.Tail - frameAttributes.Size;
+            ExecutePendingDeallocations(frameIndex);
+        });
+
+        mPendingDeallocations.resize(simultaneousFramesInFlight);
+
+        if (capacity > 0)
+        {
+            InsertFreeBlock(0, capacity);
+        }
+    }
+
+    std::optional<uint64_t> DescriptorRangeAllocator::Allocate(uint64_t count)
+    {
+        assert_format(count > 0 && count < PendingReleaseFlag, "Descriptor block size is out of range");
+
+        std::optional<uint64_t> index;
+
+        if (count == 1 && !mFreeSingleIndices.empty())
+        {
+            index = mFreeSingleIndices.back();
+            mFreeSingleIndices.pop_back();
+        }
+        else
+        {
+            index = AllocateFromFreeBlocks(count);
+
+            // Freed single indices may form a block large enough when coalesced
+            if (!index && !mFreeSingleIndices.empty())
+            {
+                MergeFreeSingleIndices();
+                index = AllocateFromFreeBlocks(count);
+            }
+        }
+
+        if (index)
+        {
+            mBlockSizes[*index] = (uint32_t)count;
+            mAllocatedCount += count;
+        }
+
+        return index;
+    }
+
+    void DescriptorRangeAllocator::Deallocate(uint64_t index)
+    {
+        assert_format(index < mCapacity && mBlockSizes[index] != 0 && (mBlockSizes[index] & PendingReleaseFlag) == 0,
+            "Index is not a start of an allocated descriptor block");
+
+        mBlockSizes[index] |= PendingReleaseFlag;
+        mPendingDeallocations[mCurrentFrameIndex].push_back(index);
+    }
+
+    uint64_t DescriptorRangeAllocator::Defragment(uint64_t maxRelocationCount, const RelocationCallback& callback)
+    {
+        MergeFreeSingleIndices();
+
+        if (!IsFragmented())
+        {
+            return 0;
+        }
+
+        // Gather blocks that are located above the first hole
+        mLiveBlocksScratch.clear();
+
+        auto freeBlockIt = mFreeBlocksByIndex.begin();
+        uint64_t index = freeBlockIt->first;
+
+        while (index < mCapacity)
+        {
+            if (freeBlockIt != mFreeBlocksByIndex.end() && freeBlockIt->first == index)
+            {
+                index += freeBlockIt->second.Size;
+                ++freeBlockIt;
+                continue;
+            }
+
+            uint32_t blockSize = mBlockSizes[index] & ~PendingReleaseFlag;
+
+            assert_format(blockSize > 0, "Descriptor range is corrupted");
+
+            if ((mBlockSizes[index] & PendingReleaseFlag) == 0)
+            {
+                mLiveBlocksScratch.push_back({ index, blockSize });
+            }
+
+            index += blockSize;
+        }
+
+        uint64_t relocationCount = 0;
+
+        // Move blocks closest to the range end into the lowest holes that fit them
+        for (auto blockIt = mLiveBlocksScratch.rbegin(); blockIt != mLiveBlocksScratch.rend() && relocationCount < maxRelocationCount; ++blockIt)
+        {
+            auto holeIt = mFreeBlocksByIndex.begin();
+
+            while (holeIt != mFreeBlocksByIndex.end() && holeIt->first < blockIt->Index && holeIt->second.Size < blockIt->Size)
+            {
+                ++holeIt;
+            }
+
+            if (holeIt == mFreeBlocksByIndex.end() || holeIt->first >= blockIt->Index)
+            {
+                continue;
+            }
+
+            uint64_t newIndex = holeIt->first;
+            uint64_t holeSize = holeIt->second.Size;
+
+            RemoveFreeBlock(holeIt);
+
+            if (holeSize > blockIt->Size)
+            {
+                InsertFreeBlock(newIndex + blockIt->Size, holeSize - blockIt->Size);
+            }
+
+            mBlockSizes[newIndex] = (uint32_t)blockIt->Size;
+            mAllocatedCount += blockIt->Size;
+
+            callback(blockIt->Index, newIndex, blockIt->Size);
+
+            // GPU may still access descriptors at old indices
+            Deallocate(blockIt->Index);
+
+            ++relocationCount;
+        }
+
+        return relocationCount;
+    }
+
+    bool DescriptorRangeAllocator::IsFragmented() const
+    {
+        uint64_t freeCount = mCapacity - mAllocatedCount;
+        return freeCount >= MinFreeCountToDefragment && LargestFreeBlockSize() * 2 < freeCount;
+    }
+
+    void DescriptorRangeAllocator::BeginFrame(uint64_t frameNumber)
+    {
+        mCurrentFrameIndex = mRingFrameTracker.Allocate(1);
+        mRingFrameTracker.FinishCurrentFrame(frameNumber);
+    }
+
+    void DescriptorRangeAllocator::EndFrame(uint64_t frameNumber)
+    {
+        mRingFrameTracker.ReleaseCompletedFrames(frameNumber);
+    }
+
+    std::optional<uint64_t> DescriptorRangeAllocator::AllocateFromFreeBlocks(uint64_t count)
+    {
+        auto sizeIt = mFreeBlocksBySize.lower_bound(count);
+
+        if (sizeIt == mFreeBlocksBySize.end())
+        {
+            return std::nullopt;
+        }
+
+        uint64_t blockSize = sizeIt->first;
+        uint64_t index = sizeIt->second;
+
+        RemoveFreeBlock(mFreeBlocksByIndex.find(index));
+
+        if (blockSize > count)
+        {
+            InsertFreeBlock(index + count, blockSize - count);
+        }
+
+        return index;
+    }
+
+    void DescriptorRangeAllocator::InsertFreeBlock(uint64_t index, uint64_t size)
+    {
+        auto sizeIt = mFreeBlocksBySize.emplace(size, index);
+        mFreeBlocksByIndex.emplace(index, FreeBlock{ size, sizeIt });
+    }
+
+    void DescriptorRangeAllocator::AddFreeBlock(uint64_t index, uint64_t size)
+    {
+        auto nextIt = mFreeBlocksByIndex.lower_bound(index);
+
+        // Coalesce with the following block
+        if (nextIt != mFreeBlocksByIndex.end() && nextIt->first == index + size)
+        {
+            size += nextIt->second.Size;
+            nextIt = std::next(nextIt);
+            RemoveFreeBlock(std::prev(nextIt));
+        }
+
+        // And with the preceding one
+        if (nextIt != mFreeBlocksByIndex.begin())
+        {
+            auto prevIt = std::prev(nextIt);
+
+            if (prevIt->first + prevIt->second.Size == index)
+            {
+                index = prevIt->first;
+                size += prevIt->second.Size;
+                RemoveFreeBlock(prevIt);
+            }
+        }
+
+        InsertFreeBlock(index, size);
+    }
+
+    void DescriptorRangeAllocator::RemoveFreeBlock(FreeBlockIt blockIt)
+    {
+        mFreeBlocksBySize.erase(blockIt->second.SizeIt);
+        mFreeBlocksByIndex.erase(blockIt);
+    }
+
+    void DescriptorRangeAllocator::MergeFreeSingleIndices()
+    {
+        for (uint64_t index : mFreeSingleIndices)
+        {
+            AddFreeBlock(index, 1);
+        }
+
+        mFreeSingleIndices.clear();
+    }
+
+    void DescriptorRangeAllocator::Release(uint64_t index)
+    {
+        uint64_t blockSize = mBlockSizes[index] & ~PendingReleaseFlag;
+
+        mBlockSizes[index] = 0;
+        mAllocatedCount -= blockSize;
+
+        if (blockSize == 1)
+        {
+            mFreeSingleIndices.push_back(index);
+        }
+        else
+        {
+            AddFreeBlock(index, blockSize);
+        }
+    }
+
+    void DescriptorRangeAllocator::ExecutePendingDeallocations(uint64_t frameIndex)
+    {
+        for (uint64_t index : mPendingDeallocations[frameIndex])
+        {
+            Release(index);
+        }
+
+        mPendingDeallocations[frameIndex].clear();
+    }
+
+}
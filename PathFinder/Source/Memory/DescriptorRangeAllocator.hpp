@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Ring.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <map>
+#include <optional>
+#include <functional>
+
+namespace Memory
+{
+
+    // Manages indices of a single descriptor heap range without touching the heap itself.
+    //
+    // Single freed indices are recycled through a LIFO list in O(1), blocks of several contiguous
+    // descriptors are placed best-fit into coalesced free blocks. Freed indices are reused only after
+    // the frame they were freed in is completed by GPU. Defragmentation moves live blocks into holes
+    // closer to the range start, so that free space stays contiguous for large block requests.
+    class DescriptorRangeAllocator
+    {
+    public:
+        // Old indices stay valid until frames in flight are completed, so users
+        // only need to recreate descriptors at new indices and update cached indices
+        using RelocationCallback = std::function<void(uint64_t oldIndex, uint64_t newIndex, uint64_t count)>;
+
+        DescriptorRangeAllocator(uint64_t capacity, uint8_t simultaneousFramesInFlight);
+
+        std::optional<uint64_t> Allocate(uint64_t count = 1);
+        void Deallocate(uint64_t index);
+
+        // Moves at most maxRelocationCount blocks, returns the number of moved blocks
+        uint64_t Defragment(uint64_t maxRelocationCount, const RelocationCallback& callback);
+
+        // Free space is considered fragmented when a block of a half of its size can't be allocated
+        bool IsFragmented() const;
+
+        void BeginFrame(uint64_t frameNumber);
+        void EndFrame(uint64_t frameNumber);
+
+    private:
+        struct FreeBlock
+        {
+            uint64_t Size = 0;
+            std::multimap<uint64_t, uint64_t>::iterator SizeIt;
+        };
+
+        using FreeBlockIt = std::map<uint64_t, FreeBlock>::iterator;
+
+        struct LiveBlock
+        {
+            uint64_t Index = 0;
+            uint64_t Size = 0;
+        };
+
+        static constexpr uint32_t PendingReleaseFlag = 1u << 31;
+        static constexpr uint64_t MinFreeCountToDefragment = 64;
+
+        std::optional<uint64_t> AllocateFromFreeBlocks(uint64_t count);
+        void InsertFreeBlock(uint64_t index, uint64_t size);
+        void AddFreeBlock(uint64_t index, uint64_t size);
+        void RemoveFreeBlock(FreeBlockIt blockIt);
+        void MergeFreeSingleIndices();
+        void Release(uint64_t index);
+        void ExecutePendingDeallocations(uint64_t frameIndex);
+
+        uint64_t mCapacity = 0;
+        uint64_t mAllocatedCount = 0;
+        uint64_t mCurrentFrameIndex = 0;
+
+        // Size of an allocated block at its first index, zero for any other index.
+        // Blocks waiting for their frame to complete are flagged and never relocated.
+        std::vector<uint32_t> mBlockSizes;
+
+        std::vector<uint64_t> mFreeSingleIndices;
+        std::map<uint64_t, FreeBlock> mFreeBlocksByIndex;
+        std::multimap<uint64_t, uint64_t> mFreeBlocksBySize;
+
+        Ring mRingFrameTracker;
+        std::vector<std::vector<uint64_t>> mPendingDeallocations;
+        std::vector<LiveBlock> mLiveBlocksScratch;
+
+    public:
+        inline uint64_t Capacity() const { return mCapacity; }
+
+        // Includes blocks that wait for their frames to complete
+        inline uint64_t AllocatedCount() const { return mAllocatedCount; }
+
+        inline uint64_t LargestFreeBlockSize() const
+        {
+            return !mFreeBlocksBySize.empty() ? mFreeBlocksBySize.rbegin()->first : (mFreeSingleIndices.empty() ? 0 : 1);
+        }
+    };
+
+}
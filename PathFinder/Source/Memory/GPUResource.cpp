@@ -6,7 +6,7 @@ namespace Memory
     GPUResource::GPUResource(
         AccessStrategy accessStrategy,
         ResourceStateTracker* stateTracker,
-        SegregatedPoolsResourceAllocator* resourceAllocator,
+        PlacedResourceAllocator* resourceAllocator,
         PoolDescriptorAllocator* descriptorAllocator,
         CopyRequestManager* copyRequestManager)
         :
@@ -23,12 +23,19 @@ namespace Memory
         assert_format(mAccessStrategy != AccessStrategy::DirectReadback, "DirectReadback resource does not support CPU writes");
 
         // Upload is already requested in current frame
-        if (!mUploadBuffers.empty() && mUploadBuffers.back().second == mFrameNumber)
+        if (CurrentFrameUploadBuffer())
         {
             return;
         }
 
-        AllocateNewUploadBuffer();
+        // Automatic resources are uploaded from the shared staging ring,
+        // a dedicated upload buffer is only needed when the ring is out of space
+        bool isStaged = mAccessStrategy == AccessStrategy::Automatic && AllocateStagingMemory();
+
+        if (!isStaged)
+        {
+            AllocateNewUploadBuffer();
+        }
 
         if (mAccessStrategy != AccessStrategy::DirectUpload)
         {
@@ -78,6 +85,7 @@ namespace Memory
                 // Either reuse a completed upload buffers
                 mCompletedUploadBuffer->SetDebugName(StringFormat("%s Upload Buffer [Frame %d]", mDebugName.c_str(), mFrameNumber));
                 mUploadBuffers.emplace(std::move(mCompletedUploadBuffer), mFrameNumber);
+                mCurrentUploadBufferContentFrameNumber = mCompletedUploadBufferFrameNumber;
             }
             else
             {
@@ -106,6 +114,7 @@ namespace Memory
             // A window to read back the data is after frame end but before new frame start.
             mCompletedUploadBuffer = nullptr;
             mCompletedReadbackBuffer = nullptr;
+            mStagingAllocation = std::nullopt;
         }
     }
 
@@ -115,6 +124,7 @@ namespace Memory
         while (!mUploadBuffers.empty() && mUploadBuffers.front().second <= frameNumber)
         {
             mCompletedUploadBuffer = std::move(mUploadBuffers.front().first);
+            mCompletedUploadBufferFrameNumber = mUploadBuffers.front().second;
             mUploadBuffers.pop();
         }
 
@@ -139,16 +149,31 @@ namespace Memory
 
     HAL::Buffer* GPUResource::CurrentFrameUploadBuffer()
     {
+        if (mStagingAllocation && mStagingAllocationFrameNumber == mFrameNumber)
+        {
+            return mStagingAllocation->Buffer;
+        }
+
         return !mUploadBuffers.empty() && mUploadBuffers.back().second == mFrameNumber ? 
             mUploadBuffers.back().first.get() : nullptr;
     }
 
     const HAL::Buffer* GPUResource::CurrentFrameUploadBuffer() const
     {
+        if (mStagingAllocation && mStagingAllocationFrameNumber == mFrameNumber)
+        {
+            return mStagingAllocation->Buffer;
+        }
+
         return !mUploadBuffers.empty() && mUploadBuffers.back().second == mFrameNumber ?
             mUploadBuffers.back().first.get() : nullptr;
     }
 
+    uint64_t GPUResource::CurrentFrameUploadBufferOffset() const
+    {
+        return mStagingAllocation && mStagingAllocationFrameNumber == mFrameNumber ? mStagingAllocation->Offset : 0;
+    }
+
     HAL::Buffer* GPUResource::CurrentFrameReadbackBuffer()
     {
         return !mReadbackBuffers.empty() && mReadbackBuffers.back().second == mFrameNumber ?
@@ -165,10 +190,27 @@ namespace Memory
     {
     }
 
+    bool GPUResource::AllocateStagingMemory()
+    {
+        StagingRing* stagingRing = mCopyRequestManager->StagingRing();
+
+        if (!stagingRing)
+        {
+            return false;
+        }
+
+        mStagingAllocation = stagingRing->Allocate(UploadAndReadbackResourceSize());
+        mStagingAllocationFrameNumber = mFrameNumber;
+        mCurrentUploadBufferContentFrameNumber = std::nullopt;
+
+        return mStagingAllocation.has_value();
+    }
+
     void GPUResource::AllocateNewUploadBuffer()
     {
         auto properties = HAL::BufferProperties::Create<uint8_t>(UploadAndReadbackResourceSize());
         mUploadBuffers.emplace(mResourceAllocator->AllocateBuffer(properties, HAL::CPUAccessibleHeapType::Upload), mFrameNumber);
+        mCurrentUploadBufferContentFrameNumber = std::nullopt;
         mUploadBuffers.back().first->SetDebugName(StringFormat("%s Upload Buffer [Frame %d]", mDebugName.c_str(), mFrameNumber));
     }
 
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "SegregatedPoolsResourceAllocator.hpp"
+#include "PlacedResourceAllocator.hpp"
 #include "ResourceStateTracker.hpp"
 #include "PoolDescriptorAllocator.hpp"
 #include "CopyRequestManager.hpp"
@@ -26,7 +26,7 @@ namespace Memory
         GPUResource(
             AccessStrategy accessStrategy,
             ResourceStateTracker* stateTracker,
-            SegregatedPoolsResourceAllocator* resourceAllocator,
+            PlacedResourceAllocator* resourceAllocator,
             PoolDescriptorAllocator* descriptorAllocator,
             CopyRequestManager* copyRequestManager);
 
@@ -60,13 +60,16 @@ namespace Memory
         virtual const HAL::Resource* HALResource() const;
 
     protected:
-        using BufferFrameNumberPair = std::pair<SegregatedPoolsResourceAllocator::BufferPtr, uint64_t>;
+        using BufferFrameNumberPair = std::pair<PlacedResourceAllocator::BufferPtr, uint64_t>;
 
         HAL::Buffer* CurrentFrameUploadBuffer();
         HAL::Buffer* CurrentFrameReadbackBuffer();
         const HAL::Buffer* CurrentFrameUploadBuffer() const;
         const HAL::Buffer* CurrentFrameReadbackBuffer() const;
 
+        // Byte offset of resource data inside current frame's upload buffer
+        uint64_t CurrentFrameUploadBufferOffset() const;
+
         virtual void ApplyDebugName();
         virtual uint64_t UploadAndReadbackResourceSize() const = 0;
         virtual CopyRequestManager::CopyCommand GetUploadCommands() = 0;
@@ -74,7 +77,7 @@ namespace Memory
 
         AccessStrategy mAccessStrategy = AccessStrategy::Automatic;
         ResourceStateTracker* mStateTracker;
-        SegregatedPoolsResourceAllocator* mResourceAllocator;
+        PlacedResourceAllocator* mResourceAllocator;
         PoolDescriptorAllocator* mDescriptorAllocator;
         CopyRequestManager* mCopyRequestManager;
 
@@ -85,11 +88,21 @@ namespace Memory
         uint64_t mFrameNumber = 0; 
 
     private:
+        bool AllocateStagingMemory();
         void AllocateNewUploadBuffer();
         void AllocateNewReadbackBuffer();
 
-        SegregatedPoolsResourceAllocator::BufferPtr mCompletedReadbackBuffer;
-        SegregatedPoolsResourceAllocator::BufferPtr mCompletedUploadBuffer;
+        PlacedResourceAllocator::BufferPtr mCompletedReadbackBuffer;
+        PlacedResourceAllocator::BufferPtr mCompletedUploadBuffer;
+        uint64_t mCompletedUploadBufferFrameNumber = 0;
+        std::optional<uint64_t> mCurrentUploadBufferContentFrameNumber;
+        std::optional<StagingRing::Allocation> mStagingAllocation;
+        uint64_t mStagingAllocationFrameNumber = 0;
+
+    public:
+        // Frame in which current frame's upload buffer was previously in use, so its content is as of that frame.
+        // Empty if upload buffer was freshly allocated and its content is undefined.
+        inline auto CurrentUploadBufferContentFrameNumber() const { return mCurrentUploadBufferContentFrameNumber; }
     };
 
 }
@@ -13,7 +13,7 @@ namespace Memory
         }
 
         // No need to unmap as upload buffers can be mapped persistently
-        return reinterpret_cast<T*>(CurrentFrameUploadBuffer()->Map());
+        return reinterpret_cast<T*>(CurrentFrameUploadBuffer()->Map() + CurrentFrameUploadBufferOffset());
     }
 
     template <class T>
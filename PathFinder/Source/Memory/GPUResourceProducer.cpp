@@ -5,7 +5,7 @@ namespace Memory
 
     GPUResourceProducer::GPUResourceProducer(
         const HAL::Device* device,
-        SegregatedPoolsResourceAllocator* resourceAllocator, 
+        PlacedResourceAllocator* resourceAllocator, 
         ResourceStateTracker* stateTracker, 
         PoolDescriptorAllocator* descriptorAllocator,
         CopyRequestManager* copyRequestManager)
@@ -21,12 +21,22 @@ namespace Memory
         CheckFrameValidity();
 
         Texture* texture = new Texture{ properties, mStateTracker, mResourceAllocator, mDescriptorAllocator, mCopyRequestManager };
-        auto [iter, success] = mAllocatedResources.insert(texture);
+        ResourceSetIterator iter;
+
+        {
+            std::lock_guard lock{ mAccessMutex };
+            iter = mAllocatedResources.insert(texture).first;
+        }
+
         texture->BeginFrame(mFrameNumber);
 
         auto deallocationCallback = [this, iter](Texture* texture)
         {
-            mAllocatedResources.erase(iter);
+            {
+                std::lock_guard lock{ mAccessMutex };
+                mAllocatedResources.erase(iter);
+            }
+
             delete texture;
         };
 
@@ -42,12 +52,22 @@ namespace Memory
             mCopyRequestManager, *mDevice, explicitHeap, heapOffset
         };
 
-        auto [iter, success] = mAllocatedResources.insert(texture);
+        ResourceSetIterator iter;
+
+        {
+            std::lock_guard lock{ mAccessMutex };
+            iter = mAllocatedResources.insert(texture).first;
+        }
+
         texture->BeginFrame(mFrameNumber);
 
         auto deallocationCallback = [this, iter](Texture* texture)
         {
-            mAllocatedResources.erase(iter);
+            {
+                std::lock_guard lock{ mAccessMutex };
+                mAllocatedResources.erase(iter);
+            }
+
             delete texture;
         };
 
@@ -59,12 +79,22 @@ namespace Memory
         CheckFrameValidity();
 
         Texture* texture = new Texture{ mStateTracker, mResourceAllocator, mDescriptorAllocator, mCopyRequestManager, existingTexture };
-        auto [iter, success] = mAllocatedResources.insert(texture);
+        ResourceSetIterator iter;
+
+        {
+            std::lock_guard lock{ mAccessMutex };
+            iter = mAllocatedResources.insert(texture).first;
+        }
+
         texture->BeginFrame(mFrameNumber);
 
         auto deallocationCallback = [this, iter](Texture* texture)
         {
-            mAllocatedResources.erase(iter);
+            {
+                std::lock_guard lock{ mAccessMutex };
+                mAllocatedResources.erase(iter);
+            }
+
             delete texture;
         };
 
@@ -76,12 +106,22 @@ namespace Memory
         CheckFrameValidity();
 
         Buffer* buffer = new Buffer{ properties, accessStrategy, mStateTracker, mResourceAllocator, mDescriptorAllocator, mCopyRequestManager };
-        auto [iter, success] = mAllocatedResources.insert(buffer);
+        ResourceSetIterator iter;
+
+        {
+            std::lock_guard lock{ mAccessMutex };
+            iter = mAllocatedResources.insert(buffer).first;
+        }
+
         buffer->BeginFrame(mFrameNumber);
 
         auto deallocationCallback = [this, iter](Buffer* buffer)
         {
-            mAllocatedResources.erase(iter);
+            {
+                std::lock_guard lock{ mAccessMutex };
+                mAllocatedResources.erase(iter);
+            }
+
             delete buffer;
         };
 
@@ -97,12 +137,22 @@ namespace Memory
             mDescriptorAllocator, mCopyRequestManager, *mDevice, explicitHeap, heapOffset
         };
 
-        auto [iter, success] = mAllocatedResources.insert(buffer);
+        ResourceSetIterator iter;
+
+        {
+            std::lock_guard lock{ mAccessMutex };
+            iter = mAllocatedResources.insert(buffer).first;
+        }
+
         buffer->BeginFrame(mFrameNumber);
 
         auto deallocationCallback = [this, iter](Buffer* buffer)
         {
-            mAllocatedResources.erase(iter);
+            {
+                std::lock_guard lock{ mAccessMutex };
+                mAllocatedResources.erase(iter);
+            }
+
             delete buffer;
         };
 
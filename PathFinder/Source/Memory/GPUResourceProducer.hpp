@@ -1,6 +1,6 @@
 #pragma once
 
-#include "SegregatedPoolsResourceAllocator.hpp"
+#include "PlacedResourceAllocator.hpp"
 #include "ResourceStateTracker.hpp"
 #include "PoolDescriptorAllocator.hpp"
 #include "CopyRequestManager.hpp"
@@ -8,6 +8,7 @@
 #include "Texture.hpp"
 
 #include <unordered_set>
+#include <mutex>
 
 namespace Memory
 {
@@ -20,7 +21,7 @@ namespace Memory
 
         GPUResourceProducer(
             const HAL::Device* device, 
-            SegregatedPoolsResourceAllocator* resourceAllocator,
+            PlacedResourceAllocator* resourceAllocator,
             ResourceStateTracker* stateTracker,
             PoolDescriptorAllocator* descriptorAllocator,
             CopyRequestManager* copyRequestManager
@@ -44,11 +45,15 @@ namespace Memory
 
         uint64_t mFrameNumber = 0;
         const HAL::Device* mDevice = nullptr;
-        SegregatedPoolsResourceAllocator* mResourceAllocator = nullptr;
+        PlacedResourceAllocator* mResourceAllocator = nullptr;
         ResourceStateTracker* mStateTracker = nullptr;
         PoolDescriptorAllocator* mDescriptorAllocator = nullptr;
         CopyRequestManager* mCopyRequestManager = nullptr;
         std::unordered_set<GPUResource*> mAllocatedResources;
+        std::mutex mAccessMutex;
+
+    public:
+        inline auto FrameNumber() const { return mFrameNumber; }
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,258 @@
+#include "PlacedResourceAllocator.hpp"
+
+#include <algorithm>
+
+namespace Memory
+{
+
+    PlacedResourceAllocator::HeapChunk::HeapChunk(
+        const HAL::Device& device, uint64_t size, uint64_t granularity, HAL::HeapAliasingGroup aliasingGroup, std::optional<HAL::CPUAccessibleHeapType> cpuHeapType)
+        : Heap{ device, size, aliasingGroup, cpuHeapType }, Allocator{ size, granularity } {}
+
+    PlacedResourceAllocator::PlacedResourceAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight)
+        : mDevice{ device },
+        mRingFrameTracker{ simultaneousFramesInFlight },
+        mSimultaneousFramesInFlight{ simultaneousFramesInFlight }
+    {
+        mPendingDeallocations.resize(simultaneousFramesInFlight);
+
+        mRingFrameTracker.SetDeallocationCallback([this](const Ring::FrameTailAttributes& frameAttributes)
+        {
+            auto frameIndex = frameAttributes.Tail - frameAttributes.Size;
+            ExecutePendingDeallocations(frameIndex);
+        });
+    }
+
+    PlacedResourceAllocator::BufferPtr PlacedResourceAllocator::AllocateBuffer(const HAL::BufferProperties& properties, std::optional<HAL::CPUAccessibleHeapType> heapType)
+    {
+        std::lock_guard lock{ mAccessMutex };
+
+        HAL::ResourceFormat format{ mDevice, properties };
+        HeapPool& pool = SelectPool(format, heapType);
+
+        // If CPU accessible buffer is requested
+        if (heapType)
+        {
+            // Allocations are rounded to granularity, so buffers of equal rounded size are interchangeable
+            uint64_t cachedBufferSize = ((format.ResourceSizeInBytes() + mAllocationGranularity - 1) / mAllocationGranularity) * mAllocationGranularity;
+            std::vector<CachedBuffer>& cachedBuffers = pool.CachedBuffers[cachedBufferSize];
+            CachedBuffer cachedBuffer{};
+
+            // We can search for existing one
+            if (!cachedBuffers.empty())
+            {
+                cachedBuffer = cachedBuffers.back();
+                cachedBuffers.pop_back();
+            }
+            else
+            {
+                cachedBuffer.BufferAllocation = Allocate(pool, format, heapType);
+
+                // We need CPU accessible buffers to match allocation size so that they can be reused properly
+                HAL::BufferProperties cpuAccessibleBufferProperties{ cachedBuffer.BufferAllocation.HeapAllocation.Size };
+
+                // Allocate buffer with allocation size, not requested size, to make it more generic and suitable for later reuse in other allocations
+                cachedBuffer.Buffer = new HAL::Buffer{
+                    *mDevice, cpuAccessibleBufferProperties, cachedBuffer.BufferAllocation.Chunk->Heap, cachedBuffer.BufferAllocation.HeapAllocation.Offset };
+            }
+
+            auto deallocationCallback = [this, allocation = cachedBuffer.BufferAllocation](HAL::Buffer* buffer)
+            {
+                std::lock_guard lock{ mAccessMutex };
+                // Do not pass cpu accessible resource for deallocation. We can reuse it later.
+                mPendingDeallocations[mCurrentFrameIndex].emplace_back(Deallocation{ buffer, allocation, true });
+            };
+
+            // Create unique_ptr with already existing buffer ptr that's being reused
+            return BufferPtr{ cachedBuffer.Buffer, deallocationCallback };
+        }
+        else
+        {
+            Allocation allocation = Allocate(pool, format, heapType);
+
+            auto deallocationCallback = [this, allocation](HAL::Buffer* buffer)
+            {
+                std::lock_guard lock{ mAccessMutex };
+                mPendingDeallocations[mCurrentFrameIndex].emplace_back(Deallocation{ buffer, allocation, false });
+            };
+
+            HAL::Buffer* buffer = new HAL::Buffer{ *mDevice, properties, allocation.Chunk->Heap, allocation.HeapAllocation.Offset };
+
+            // The design decision is to recreate buffers in default memory due to different state requirements unlike upload/readback
+            return BufferPtr{ buffer, deallocationCallback };
+        }
+    }
+
+    PlacedResourceAllocator::TexturePtr PlacedResourceAllocator::AllocateTexture(const HAL::TextureProperties& properties)
+    {
+        std::lock_guard lock{ mAccessMutex };
+
+        HAL::ResourceFormat format{ mDevice, properties };
+        Allocation allocation = Allocate(SelectPool(format, std::nullopt), format, std::nullopt);
+
+        auto deallocationCallback = [this, allocation](HAL::Texture* texture)
+        {
+            std::lock_guard lock{ mAccessMutex };
+            mPendingDeallocations[mCurrentFrameIndex].emplace_back(Deallocation{ texture, allocation, false });
+        };
+
+        HAL::Texture* texture = new HAL::Texture{ *mDevice, allocation.Chunk->Heap, allocation.HeapAllocation.Offset, properties };
+
+        return TexturePtr{ texture, deallocationCallback };
+    }
+
+    void PlacedResourceAllocator::BeginFrame(uint64_t frameNumber)
+    {
+        std::lock_guard lock{ mAccessMutex };
+
+        mCurrentFrameNumber = frameNumber;
+        mCurrentFrameIndex = mRingFrameTracker.Allocate(1);
+        mRingFrameTracker.FinishCurrentFrame(frameNumber);
+
+        ReleaseUnusedCachedBuffers(frameNumber);
+    }
+
+    void PlacedResourceAllocator::EndFrame(uint64_t frameNumber)
+    {
+        std::lock_guard lock{ mAccessMutex };
+        mRingFrameTracker.ReleaseCompletedFrames(frameNumber);
+    }
+
+    PlacedResourceAllocator::HeapPool& PlacedResourceAllocator::SelectPool(
+        const HAL::ResourceFormat& resourceFormat, std::optional<HAL::CPUAccessibleHeapType> cpuHeapType)
+    {
+        if (cpuHeapType)
+        {
+            switch (*cpuHeapType)
+            {
+            case HAL::CPUAccessibleHeapType::Upload: return mUploadPool;
+            case HAL::CPUAccessibleHeapType::Readback: return mReadbackPool;
+            }
+        }
+
+        switch (resourceFormat.ResourceAliasingGroup())
+        {
+        case HAL::HeapAliasingGroup::RTDSTextures: return mDefaultRTDSPool;
+        case HAL::HeapAliasingGroup::NonRTDSTextures: return mDefaultNonRTDSPool;
+        default: return mDefaultUniversalOrBufferPool;
+        }
+    }
+
+    PlacedResourceAllocator::Allocation PlacedResourceAllocator::Allocate(
+        HeapPool& pool, const HAL::ResourceFormat& resourceFormat, std::optional<HAL::CPUAccessibleHeapType> cpuHeapType)
+    {
+        uint64_t allocationSizeInBytes = resourceFormat.ResourceSizeInBytes();
+        uint64_t alignment = resourceFormat.ResourceAlighnment();
+
+        assert_format(allocationSizeInBytes > 0, "0 bytes allocations are forbidden");
+        assert_format(allocationSizeInBytes < std::numeric_limits<uint32_t>::max(), "Ridiculous allocation size");
+
+        for (std::unique_ptr<HeapChunk>& chunk : pool.Chunks)
+        {
+            if (chunk->IsDedicated)
+            {
+                continue;
+            }
+
+            if (std::optional<TLSFAllocator::Allocation> heapAllocation = chunk->Allocator.Allocate(allocationSizeInBytes, alignment))
+            {
+                return { *heapAllocation, chunk.get(), &pool };
+            }
+        }
+
+        // Out of allocated memory. Add another heap.
+        bool needsDedicatedHeap = allocationSizeInBytes + alignment > mHeapSize;
+        uint64_t heapAlignment = mDevice->MandatoryHeapAlignment();
+        uint64_t newHeapSize = needsDedicatedHeap ?
+            ((allocationSizeInBytes + heapAlignment - 1) / heapAlignment) * heapAlignment :
+            mHeapSize;
+
+        pool.Chunks.emplace_back(std::make_unique<HeapChunk>(*mDevice, newHeapSize, mAllocationGranularity, resourceFormat.ResourceAliasingGroup(), cpuHeapType));
+
+        HeapChunk* chunk = pool.Chunks.back().get();
+        chunk->IsDedicated = needsDedicatedHeap;
+        chunk->Heap.SetDebugName(needsDedicatedHeap ? "Resource Allocator Dedicated Heap" : "Resource Allocator Heap");
+
+        std::optional<TLSFAllocator::Allocation> heapAllocation = chunk->Allocator.Allocate(allocationSizeInBytes, alignment);
+        assert_format(heapAllocation, "Implementation error. Newly created heap cannot fit the allocation.");
+
+        return { *heapAllocation, chunk, &pool };
+    }
+
+    void PlacedResourceAllocator::Deallocate(const Allocation& allocation)
+    {
+        HeapChunk* chunk = allocation.Chunk;
+        chunk->Allocator.Deallocate(allocation.HeapAllocation);
+
+        if (!chunk->Allocator.IsEmpty())
+        {
+            return;
+        }
+
+        std::vector<std::unique_ptr<HeapChunk>>& chunks = allocation.Pool->Chunks;
+
+        // One empty default size heap is kept alive for future allocations
+        if (!chunk->IsDedicated)
+        {
+            bool hasAnotherEmptyHeap = std::any_of(chunks.begin(), chunks.end(), [chunk](const std::unique_ptr<HeapChunk>& c)
+            {
+                return c.get() != chunk && !c->IsDedicated && c->Allocator.IsEmpty();
+            });
+
+            if (!hasAnotherEmptyHeap)
+            {
+                return;
+            }
+        }
+
+        auto chunkIt = std::find_if(chunks.begin(), chunks.end(), [chunk](const std::unique_ptr<HeapChunk>& c) { return c.get() == chunk; });
+        assert_format(chunkIt != chunks.end(), "Heap doesn't belong to the pool that produced allocation");
+
+        chunks.erase(chunkIt);
+    }
+
+    void PlacedResourceAllocator::ReleaseUnusedCachedBuffers(uint64_t frameNumber)
+    {
+        for (HeapPool* pool : { &mUploadPool, &mReadbackPool })
+        {
+            for (auto& [size, cachedBuffers] : pool->CachedBuffers)
+            {
+                // Buffers are cached in order, so unused ones are always at the front
+                auto firstUsedIt = std::find_if(cachedBuffers.begin(), cachedBuffers.end(), [&](const CachedBuffer& cachedBuffer)
+                {
+                    return frameNumber - cachedBuffer.CachedFrameNumber <= mCachedBufferLifetimeInFrames;
+                });
+
+                for (auto it = cachedBuffers.begin(); it != firstUsedIt; ++it)
+                {
+                    delete it->Buffer;
+                    Deallocate(it->BufferAllocation);
+                }
+
+                cachedBuffers.erase(cachedBuffers.begin(), firstUsedIt);
+            }
+        }
+    }
+
+    void PlacedResourceAllocator::ExecutePendingDeallocations(uint64_t frameIndex)
+    {
+        for (Deallocation& deallocation : mPendingDeallocations[frameIndex])
+        {
+            if (!deallocation.ResourceWillBeReused)
+            {
+                delete deallocation.Resource;
+                Deallocate(deallocation.ResourceAllocation);
+            }
+            else
+            {
+                deallocation.Resource->SetDebugName("Resource Allocator Free Memory");
+
+                HeapPool* pool = deallocation.ResourceAllocation.Pool;
+                CachedBuffer cachedBuffer{ deallocation.ResourceAllocation, static_cast<HAL::Buffer*>(deallocation.Resource), mCurrentFrameNumber };
+                pool->CachedBuffers[deallocation.ResourceAllocation.HeapAllocation.Size].push_back(cachedBuffer);
+            }
+        }
+        mPendingDeallocations[frameIndex].clear();
+    }
+
+}
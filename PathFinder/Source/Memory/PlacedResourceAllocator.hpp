@@ -0,0 +1,138 @@
+#pragma once
+
+#include "TLSFAllocator.hpp"
+#include "Ring.hpp"
+
+#include <HardwareAbstractionLayer/Device.hpp>
+#include <HardwareAbstractionLayer/Heap.hpp>
+#include <HardwareAbstractionLayer/Buffer.hpp>
+#include <HardwareAbstractionLayer/Texture.hpp>
+
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <robinhood/robin_hood.h>
+
+namespace Memory
+{
+
+    /// Suballocates placed resources from GPU heaps.
+    /// Each heap category is a list of fixed size heaps managed by TLSF allocators
+    /// which keeps internal fragmentation bounded and allocation/deallocation at O(1).
+    /// Resources larger than a heap get dedicated heaps of their own.
+    /// Heaps that become empty are released, except for one heap per category kept to avoid
+    /// creating and destroying heaps when usage oscillates around a heap boundary.
+    class PlacedResourceAllocator
+    {
+    public:
+        using BufferPtr = std::unique_ptr<HAL::Buffer, std::function<void(HAL::Buffer*)>>;
+        using TexturePtr = std::unique_ptr<HAL::Texture, std::function<void(HAL::Texture*)>>;
+
+        PlacedResourceAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight);
+
+        BufferPtr AllocateBuffer(const HAL::BufferProperties& properties, std::optional<HAL::CPUAccessibleHeapType> heapType = std::nullopt);
+        TexturePtr AllocateTexture(const HAL::TextureProperties& properties);
+
+        void BeginFrame(uint64_t frameNumber);
+        void EndFrame(uint64_t frameNumber);
+
+    private:
+        struct HeapChunk
+        {
+            HeapChunk(const HAL::Device& device, uint64_t size, uint64_t granularity, HAL::HeapAliasingGroup aliasingGroup, std::optional<HAL::CPUAccessibleHeapType> cpuHeapType);
+
+            HAL::Heap Heap;
+            TLSFAllocator Allocator;
+
+            // Heap created for a single allocation that didn't fit into default heap size.
+            // Released as soon as that allocation is freed.
+            bool IsDedicated = false;
+        };
+
+        struct HeapPool;
+
+        struct Allocation
+        {
+            TLSFAllocator::Allocation HeapAllocation;
+            HeapChunk* Chunk = nullptr;
+            HeapPool* Pool = nullptr;
+        };
+
+        struct CachedBuffer
+        {
+            Allocation BufferAllocation;
+
+            // Manually managed
+            HAL::Buffer* Buffer = nullptr;
+            uint64_t CachedFrameNumber = 0;
+        };
+
+        struct HeapPool
+        {
+            std::vector<std::unique_ptr<HeapChunk>> Chunks;
+
+            // We only cache upload and readback buffers
+            // to keep them alive and reuse on new buffer allocation requests of the same size.
+            // Default memory resources are recreated on each allocation request.
+            robin_hood::unordered_node_map<uint64_t, std::vector<CachedBuffer>> CachedBuffers;
+        };
+
+        struct Deallocation
+        {
+            HAL::Resource* Resource = nullptr;
+            Allocation ResourceAllocation;
+            bool ResourceWillBeReused = false;
+        };
+
+        HeapPool& SelectPool(const HAL::ResourceFormat& resourceFormat, std::optional<HAL::CPUAccessibleHeapType> cpuHeapType);
+
+        Allocation Allocate(
+            HeapPool& pool,
+            const HAL::ResourceFormat& resourceFormat,
+            std::optional<HAL::CPUAccessibleHeapType> cpuHeapType);
+
+        void Deallocate(const Allocation& allocation);
+        void ReleaseUnusedCachedBuffers(uint64_t frameNumber);
+        void ExecutePendingDeallocations(uint64_t frameIndex);
+
+        const HAL::Device* mDevice = nullptr;
+
+        Ring mRingFrameTracker;
+
+        uint8_t mSimultaneousFramesInFlight;
+        uint64_t mCurrentFrameIndex = 0;
+        uint64_t mCurrentFrameNumber = 0;
+
+        // Size of heaps that are suballocated by TLSF allocators.
+        // Allocations that do not fit get a dedicated heap.
+        uint64_t mHeapSize = 64 * 1024 * 1024;
+
+        // Smallest placement alignment supported by D3D12 (small textures).
+        // Every allocation size is a multiple of this value.
+        uint64_t mAllocationGranularity = 4096;
+
+        // Amount of frames a cached upload/readback buffer can stay unused before its memory is returned to the heap
+        uint64_t mCachedBufferLifetimeInFrames = 60;
+
+        // Buffer only upload heaps
+        HeapPool mUploadPool;
+
+        // Buffer only readback heaps
+        HeapPool mReadbackPool;
+
+        // Used for universal heaps when supported by hardware.
+        // Used only for default memory buffer heaps otherwise.
+        HeapPool mDefaultUniversalOrBufferPool;
+
+        // RT & DS texture only, default memory heaps. Unused when universal heaps are supported by HW.
+        HeapPool mDefaultRTDSPool;
+
+        // Other texture type, default memory heaps. Unused when universal heaps are supported by HW.
+        HeapPool mDefaultNonRTDSPool;
+        
+        std::vector<std::vector<Deallocation>> mPendingDeallocations;
+        std::mutex mAccessMutex;
+    };
+
+}
+
@@ -1,11 +1,17 @@
 #pragma once
 
 #include <cstdint>
-#include <list>
+#include <vector>
+#include <limits>
+#include <algorithm>
 
 namespace Memory
 {
 
+    // Pool of fixed size slots. Free slots are linked through the slot array itself
+    // and slots that were never allocated are taken from the end of the array,
+    // so neither allocation nor growth touch any memory but the slot being handed out.
+    // Not thread safe: users keep a pool per thread or guard it themselves.
     template <class SlotUserData = void>
     class Pool
     {
@@ -31,17 +37,23 @@ namespace Memory
         void Deallocate(const SlotType& slot);
 
     private:
+        static constexpr uint64_t InvalidSlotIndex = std::numeric_limits<uint64_t>::max();
+
         void Grow();
 
         uint64_t mGrowSlotCount = 0;
-        uint64_t mAllocatedSize = 0;
         uint64_t mSlotSize = 0;
-        std::list<SlotType> mFreeSlots;
+
+        // Free slots keep index of the next free slot in place of their memory offset
+        std::vector<SlotType> mSlots;
+        uint64_t mFirstFreeSlotIndex = InvalidSlotIndex;
+        uint64_t mAllocatedSlotCount = 0;
 
     public:
         inline auto SlotSize() const { return mSlotSize; }
+        inline auto AllocatedSlotCount() const { return mAllocatedSlotCount; }
     };
 
 }
 
-#include "Pool.inl"
\ No newline at end of file
+#include "Pool.inl"
@@ -3,35 +3,51 @@ namespace Memory
 
     template <class SlotUserData>
     Pool<SlotUserData>::Pool(uint64_t slotSize, uint64_t onGrowSlotCount)
-        : mSlotSize{ slotSize }, mGrowSlotCount{ onGrowSlotCount } {}
+        : mGrowSlotCount{ onGrowSlotCount }, mSlotSize{ slotSize } {}
 
     template <class SlotUserData>
     void Pool<SlotUserData>::Grow()
     {
-        for (auto i = 0u; i < mGrowSlotCount; ++i)
-        {
-            mFreeSlots.emplace_back(SlotType{ mAllocatedSize });
-            mAllocatedSize += mSlotSize;
-        }
+        // Reserve at least the requested amount of slots, but keep growth geometric
+        // so that pools with small grow counts don't reallocate on every new slot
+        mSlots.reserve(mSlots.size() + std::max(mGrowSlotCount, (uint64_t)mSlots.size()));
     }
 
     template <class SlotUserData>
     void Pool<SlotUserData>::Deallocate(const Pool<SlotUserData>::SlotType& slot)
     {
-        mFreeSlots.push_back(slot);
+        uint64_t slotIndex = slot.MemoryOffset / mSlotSize;
+        assert_format(slotIndex < mSlots.size(), "Slot doesn't belong to the pool");
+
+        SlotType& freeSlot = mSlots[slotIndex];
+        freeSlot = slot;
+        freeSlot.MemoryOffset = mFirstFreeSlotIndex;
+        mFirstFreeSlotIndex = slotIndex;
+
+        --mAllocatedSlotCount;
     }
 
     template <class SlotUserData>
     typename Pool<SlotUserData>::SlotType Pool<SlotUserData>::Allocate()
     {
-        if (mFreeSlots.empty())
+        ++mAllocatedSlotCount;
+
+        if (mFirstFreeSlotIndex != InvalidSlotIndex)
+        {
+            uint64_t slotIndex = mFirstFreeSlotIndex;
+            SlotType& slot = mSlots[slotIndex];
+            mFirstFreeSlotIndex = slot.MemoryOffset;
+            slot.MemoryOffset = slotIndex * mSlotSize;
+            return slot;
+        }
+
+        if (mSlots.size() == mSlots.capacity())
         {
             Grow();
         }
 
-        Slot<SlotUserData> slot = mFreeSlots.front();
-        mFreeSlots.pop_front();
-        return slot;
+        uint64_t memoryOffset = mSlots.size() * mSlotSize;
+        return mSlots.emplace_back(SlotType{ memoryOffset });
     }
 
 }
@@ -4,152 +4,134 @@ namespace Memory
 {
 
     PoolDescriptorAllocator::PoolDescriptorAllocator(const HAL::Device* device, uint8_t simultaneousFramesInFlight)
-        : mCBSRUADescriptorHeap{ device, mDescriptorRangeCapacity, mDescriptorRangeCapacity, mDescriptorRangeCapacity },
-        mRTDescriptorHeap{ device, mDescriptorRangeCapacity },
-        mDSDescriptorHeap{ device, mDescriptorRangeCapacity },
-        mSamplerDescriptorHeap{ device, mDescriptorRangeCapacity },
-        mRingFrameTracker{ simultaneousFramesInFlight },
-        mRTPool{ 1, mDescriptorRangeCapacity },
-        mDSPool{ 1, mDescriptorRangeCapacity },
-        mCBPool{ 1, mDescriptorRangeCapacity },
-        mSRPool{ 1, mDescriptorRangeCapacity },
-        mUAPool{ 1, mDescriptorRangeCapacity },
-        mSamplerPool{ 1, mDescriptorRangeCapacity }
-    {
-        // Just allocate pools and descriptor heaps with fixed size and hope nobody needs more than N descriptors of each type
-        // TODO: add grow logic similar to how stl vector grows if more descriptors is actually needed
-
-        mRingFrameTracker.SetDeallocationCallback([this](const Ring::FrameTailAttributes& frameAttributes)
-        {
-            auto frameIndex = frameAttributes.Tail - frameAttributes.Size;
-            ExecutePendingDeallocations(frameIndex);
-        });
-
-        mPendingDeallocations.resize(simultaneousFramesInFlight);
-    }
+        : mCBSRUADescriptorHeap{ device, ShaderResourceRangeCapacity, UnorderedAccessRangeCapacity, ConstantBufferRangeCapacity },
+        mRTDescriptorHeap{ device, RTRangeCapacity },
+        mDSDescriptorHeap{ device, DSRangeCapacity },
+        mSamplerDescriptorHeap{ device, SamplerRangeCapacity },
+        mRTRange{ RTRangeCapacity, simultaneousFramesInFlight },
+        mDSRange{ DSRangeCapacity, simultaneousFramesInFlight },
+        mSRRange{ ShaderResourceRangeCapacity, simultaneousFramesInFlight },
+        mUARange{ UnorderedAccessRangeCapacity, simultaneousFramesInFlight },
+        mCBRange{ ConstantBufferRangeCapacity, simultaneousFramesInFlight },
+        mSamplerRange{ SamplerRangeCapacity, simultaneousFramesInFlight } {}
 
     PoolDescriptorAllocator::RTDescriptorPtr PoolDescriptorAllocator::AllocateRTDescriptor(const HAL::Texture& texture, uint8_t mipLevel, std::optional<HAL::ColorFormat> shaderVisibleFormat)
     {
-        ValidateRTFormatsCompatibility(texture.Format(), shaderVisibleFormat);
+        std::lock_guard lock{ mAccessMutex };
 
-        auto slot = mRTPool.Allocate();
-        auto descriptor = mRTDescriptorHeap.EmplaceRTDescriptor(slot.MemoryOffset, texture, mipLevel, shaderVisibleFormat);
-        auto& allocation = mAllocatedRTDescriptors.emplace_back(descriptor, slot);
-        auto deallocationCallback = [this, &allocation](HAL::RTDescriptor* descriptor) {
-            mPendingDeallocations[mCurrentFrameIndex].emplace_back(allocation.Slot, &mRTPool);
-        };
+        ValidateRTFormatsCompatibility(texture.Format(), shaderVisibleFormat);
 
-        return RTDescriptorPtr(&allocation.Descriptor, deallocationCallback);
+        return AllocateDescriptor(mRTRange, [this, &texture, mipLevel, shaderVisibleFormat](uint64_t index)
+        {
+            return mRTDescriptorHeap.EmplaceRTDescriptor(index, texture, mipLevel, shaderVisibleFormat);
+        });
     }
 
     PoolDescriptorAllocator::DSDescriptorPtr PoolDescriptorAllocator::AllocateDSDescriptor(const HAL::Texture& texture)
     {
-        assert_format(std::holds_alternative<HAL::DepthStencilFormat>(texture.Format()), "Texture is not of depth-stencil format");
+        std::lock_guard lock{ mAccessMutex };
 
-        auto slot = mDSPool.Allocate();
-        auto descriptor = mDSDescriptorHeap.EmplaceDSDescriptor(slot.MemoryOffset, texture);
-        auto& allocation = mAllocatedDSDescriptors.emplace_back(descriptor, slot);
-        auto deallocationCallback = [this, &allocation](HAL::DSDescriptor* descriptor) {
-            mPendingDeallocations[mCurrentFrameIndex].emplace_back(allocation.Slot, &mDSPool);
-        };
+        assert_format(std::holds_alternative<HAL::DepthStencilFormat>(texture.Format()), "Texture is not of depth-stencil format");
 
-        return DSDescriptorPtr(&allocation.Descriptor, deallocationCallback);
+        return AllocateDescriptor(mDSRange, [this, &texture](uint64_t index)
+        {
+            return mDSDescriptorHeap.EmplaceDSDescriptor(index, texture);
+        });
     }
 
     PoolDescriptorAllocator::SRDescriptorPtr PoolDescriptorAllocator::AllocateSRDescriptor(const HAL::Texture& texture, std::optional<HAL::ColorFormat> shaderVisibleFormat)
     {
-        ValidateSRUAFormatsCompatibility(texture.Format(), shaderVisibleFormat);
+        std::lock_guard lock{ mAccessMutex };
 
-        auto slot = mSRPool.Allocate();
-        auto descriptor = mCBSRUADescriptorHeap.EmplaceSRDescriptor(slot.MemoryOffset, texture, shaderVisibleFormat);
-        auto& allocation = mAllocatedSRDescriptors.emplace_back(descriptor, slot);
-        auto deallocationCallback = [this, &allocation](HAL::SRDescriptor* descriptor) {
-            mPendingDeallocations[mCurrentFrameIndex].emplace_back(allocation.Slot, &mSRPool);
-        };
+        ValidateSRUAFormatsCompatibility(texture.Format(), shaderVisibleFormat);
 
-        return SRDescriptorPtr(&allocation.Descriptor, deallocationCallback);
+        return AllocateDescriptor(mSRRange, [this, &texture, shaderVisibleFormat](uint64_t index)
+        {
+            return mCBSRUADescriptorHeap.EmplaceSRDescriptor(index, texture, shaderVisibleFormat);
+        });
     }
 
     PoolDescriptorAllocator::UADescriptorPtr PoolDescriptorAllocator::AllocateUADescriptor(const HAL::Texture& texture, uint8_t mipLevel, std::optional<HAL::ColorFormat> shaderVisibleFormat)
     {
-        ValidateSRUAFormatsCompatibility(texture.Format(), shaderVisibleFormat);
+        std::lock_guard lock{ mAccessMutex };
 
-        auto slot = mUAPool.Allocate();
-        auto descriptor = mCBSRUADescriptorHeap.EmplaceUADescriptor(slot.MemoryOffset, texture, mipLevel, shaderVisibleFormat);
-        auto& allocation = mAllocatedUADescriptors.emplace_back(descriptor, slot);
-        auto deallocationCallback = [this, &allocation](HAL::UADescriptor* descriptor) {
-            mPendingDeallocations[mCurrentFrameIndex].emplace_back(allocation.Slot, &mUAPool);
-        };
+        ValidateSRUAFormatsCompatibility(texture.Format(), shaderVisibleFormat);
 
-        return UADescriptorPtr(&allocation.Descriptor, deallocationCallback);
+        return AllocateDescriptor(mUARange, [this, &texture, mipLevel, shaderVisibleFormat](uint64_t index)
+        {
+            return mCBSRUADescriptorHeap.EmplaceUADescriptor(index, texture, mipLevel, shaderVisibleFormat);
+        });
     }
 
     PoolDescriptorAllocator::SRDescriptorPtr PoolDescriptorAllocator::AllocateSRDescriptor(const HAL::Buffer& buffer, uint64_t stride)
     {
-        auto slot = mSRPool.Allocate();
-        auto descriptor = mCBSRUADescriptorHeap.EmplaceSRDescriptor(slot.MemoryOffset, buffer, stride);
-        auto& allocation = mAllocatedSRDescriptors.emplace_back(descriptor, slot);
-        auto deallocationCallback = [this, &allocation](HAL::SRDescriptor* descriptor) {
-            mPendingDeallocations[mCurrentFrameIndex].emplace_back(allocation.Slot, &mSRPool);
-        };
-
-        return SRDescriptorPtr(&allocation.Descriptor, deallocationCallback);
+        std::lock_guard lock{ mAccessMutex };
+
+        return AllocateDescriptor(mSRRange, [this, &buffer, stride](uint64_t index)
+        {
+            return mCBSRUADescriptorHeap.EmplaceSRDescriptor(index, buffer, stride);
+        });
     }
 
     PoolDescriptorAllocator::UADescriptorPtr PoolDescriptorAllocator::AllocateUADescriptor(const HAL::Buffer& buffer, uint64_t stride)
     {
-        auto slot = mUAPool.Allocate();
-        auto descriptor = mCBSRUADescriptorHeap.EmplaceUADescriptor(slot.MemoryOffset, buffer, stride);
-        auto& allocation = mAllocatedUADescriptors.emplace_back(descriptor, slot);
-        auto deallocationCallback = [this, &allocation](HAL::UADescriptor* descriptor) {
-            mPendingDeallocations[mCurrentFrameIndex].emplace_back(allocation.Slot, &mUAPool);
-        };
-
-        return UADescriptorPtr(&allocation.Descriptor, deallocationCallback);
+        std::lock_guard lock{ mAccessMutex };
+
+        return AllocateDescriptor(mUARange, [this, &buffer, stride](uint64_t index)
+        {
+            return mCBSRUADescriptorHeap.EmplaceUADescriptor(index, buffer, stride);
+        });
     }
 
     PoolDescriptorAllocator::CBDescriptorPtr PoolDescriptorAllocator::AllocateCBDescriptor(const HAL::Buffer& buffer, uint64_t stride)
     {
-        auto slot = mCBPool.Allocate();
-        auto descriptor = mCBSRUADescriptorHeap.EmplaceCBDescriptor(slot.MemoryOffset, buffer, stride);
-        auto& allocation = mAllocatedCBDescriptors.emplace_back(descriptor, slot);
-        auto deallocationCallback = [this, &allocation](HAL::CBDescriptor* descriptor) {
-            mPendingDeallocations[mCurrentFrameIndex].emplace_back(allocation.Slot, &mCBPool);
-        };
-
-        return CBDescriptorPtr(&allocation.Descriptor, deallocationCallback);
+        std::lock_guard lock{ mAccessMutex };
+
+        return AllocateDescriptor(mCBRange, [this, &buffer, stride](uint64_t index)
+        {
+            return mCBSRUADescriptorHeap.EmplaceCBDescriptor(index, buffer, stride);
+        });
     }
 
     PoolDescriptorAllocator::SamplerDescriptorPtr PoolDescriptorAllocator::AllocateSamplerDescriptor(const HAL::Sampler& sampler)
     {
-        auto slot = mSamplerPool.Allocate();
-        auto descriptor = mSamplerDescriptorHeap.EmplaceSamplerDescriptor(slot.MemoryOffset, sampler);
-        auto& allocation = mAllocatedSamplerDescriptors.emplace_back(descriptor, slot);
-        auto deallocationCallback = [this, &allocation](HAL::SamplerDescriptor* descriptor) {
-            mPendingDeallocations[mCurrentFrameIndex].emplace_back(allocation.Slot, &mSamplerPool);
-        };
-
-        return SamplerDescriptorPtr(&allocation.Descriptor, deallocationCallback);
+        std::lock_guard lock{ mAccessMutex };
+
+        // Sampler objects are usually temporary, so a copy is kept for descriptor relocation
+        return AllocateDescriptor(mSamplerRange, [this, sampler](uint64_t index)
+        {
+            return mSamplerDescriptorHeap.EmplaceSamplerDescriptor(index, sampler);
+        });
     }
 
     void PoolDescriptorAllocator::BeginFrame(uint64_t frameNumber)
     {
-        mCurrentFrameIndex = mRingFrameTracker.Allocate(1);
-        mRingFrameTracker.FinishCurrentFrame(frameNumber);
+        std::lock_guard lock{ mAccessMutex };
+
+        mRTRange.Allocator.BeginFrame(frameNumber);
+        mDSRange.Allocator.BeginFrame(frameNumber);
+        mSRRange.Allocator.BeginFrame(frameNumber);
+        mUARange.Allocator.BeginFrame(frameNumber);
+        mCBRange.Allocator.BeginFrame(frameNumber);
+        mSamplerRange.Allocator.BeginFrame(frameNumber);
+
+        // Only ranges indexed from shaders benefit from being compact.
+        // Done before any indices are read for the new frame.
+        DefragmentRange(mSRRange);
+        DefragmentRange(mUARange);
+        DefragmentRange(mSamplerRange);
     }
 
     void PoolDescriptorAllocator::EndFrame(uint64_t frameNumber)
     {
-        mRingFrameTracker.ReleaseCompletedFrames(frameNumber);
-    }
-
-    void PoolDescriptorAllocator::ExecutePendingDeallocations(uint64_t frameIndex)
-    {
-        for (Deallocation& deallocation : mPendingDeallocations[frameIndex])
-        {
-            deallocation.PoolPtr->Deallocate(deallocation.Slot);
-        }
-        mPendingDeallocations[frameIndex].clear();
+        std::lock_guard lock{ mAccessMutex };
+
+        mRTRange.Allocator.EndFrame(frameNumber);
+        mDSRange.Allocator.EndFrame(frameNumber);
+        mSRRange.Allocator.EndFrame(frameNumber);
+        mUARange.Allocator.EndFrame(frameNumber);
+        mCBRange.Allocator.EndFrame(frameNumber);
+        mSamplerRange.Allocator.EndFrame(frameNumber);
     }
 
     void PoolDescriptorAllocator::ValidateRTFormatsCompatibility(
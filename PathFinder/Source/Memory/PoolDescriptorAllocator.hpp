@@ -1,7 +1,6 @@
 #pragma once
 
-#include "Pool.hpp"
-#include "Ring.hpp"
+#include "DescriptorRangeAllocator.hpp"
 
 #include <HardwareAbstractionLayer/DescriptorHeap.hpp>
 #include <HardwareAbstractionLayer/Buffer.hpp>
@@ -9,7 +8,8 @@
 
 #include <memory>
 #include <functional>
-#include <list>
+#include <vector>
+#include <mutex>
 
 namespace Memory
 {
@@ -47,56 +47,76 @@ namespace Memory
         template <class DescriptorT>
         struct Allocation
         {
+            using Emplacer = std::function<DescriptorT(uint64_t indexInRange)>;
+
             DescriptorT Descriptor;
-            Pool<>::SlotType Slot;
+            uint64_t IndexInRange = 0;
+
+            // Recreates the descriptor at another index when its range is defragmented
+            Emplacer Emplace;
 
-            Allocation(const DescriptorT& descriptor, const Pool<>::SlotType& slot)
-                : Descriptor{ descriptor }, Slot{ slot } {}
+            Allocation(const DescriptorT& descriptor, uint64_t indexInRange, const Emplacer& emplacer)
+                : Descriptor{ descriptor }, IndexInRange{ indexInRange }, Emplace{ emplacer } {}
         };
 
-        struct Deallocation
+        template <class DescriptorT>
+        struct DescriptorRange
         {
-            Pool<>::SlotType Slot;
-            Pool<>* PoolPtr;
+            DescriptorRangeAllocator Allocator;
+
+            // Allocations are stored at indices they occupy. Allocation objects themselves never move,
+            // so descriptor pointers handed out to resources stay valid when descriptors are relocated.
+            std::vector<std::unique_ptr<Allocation<DescriptorT>>> Allocations;
 
-            Deallocation(const Pool<>::SlotType& slot, Pool<>* pool) 
-                : Slot{ slot }, PoolPtr{ pool } {}
+            DescriptorRange(uint64_t capacity, uint8_t simultaneousFramesInFlight)
+                : Allocator{ capacity, simultaneousFramesInFlight } {}
         };
 
-        void ExecutePendingDeallocations(uint64_t frameIndex);
+        // Shader visible CBV/SRV/UAV heaps can hold a million descriptors on every resource binding tier,
+        // shader visible sampler heaps are limited to 2048 descriptors
+        static constexpr uint64_t ShaderResourceRangeCapacity = 262144;
+        static constexpr uint64_t UnorderedAccessRangeCapacity = 65536;
+        static constexpr uint64_t ConstantBufferRangeCapacity = 65536;
+        static constexpr uint64_t SamplerRangeCapacity = 2048;
+        static constexpr uint64_t RTRangeCapacity = 1000;
+        static constexpr uint64_t DSRangeCapacity = 1000;
+
+        // Caps the number of descriptors recreated per frame by defragmentation
+        static constexpr uint64_t MaxRelocationsPerFrame = 256;
+
+        template <class DescriptorT, class EmplacerT>
+        DescriptorPtr<DescriptorT> AllocateDescriptor(DescriptorRange<DescriptorT>& range, const EmplacerT& emplacer);
+
+        template <class DescriptorT>
+        void DefragmentRange(DescriptorRange<DescriptorT>& range);
+
         void ValidateRTFormatsCompatibility(HAL::FormatVariant textureFormat, std::optional<HAL::ColorFormat> shaderVisibleFormat);
         void ValidateSRUAFormatsCompatibility(HAL::FormatVariant textureFormat, std::optional<HAL::ColorFormat> shaderVisibleFormat);
 
-        uint64_t mDescriptorRangeCapacity = 1000;
-        uint64_t mCurrentFrameIndex = 0;
-
         HAL::CBSRUADescriptorHeap mCBSRUADescriptorHeap;
         HAL::RTDescriptorHeap mRTDescriptorHeap;
         HAL::DSDescriptorHeap mDSDescriptorHeap;
         HAL::SamplerDescriptorHeap mSamplerDescriptorHeap;
 
-        Ring mRingFrameTracker;
+        DescriptorRange<HAL::RTDescriptor> mRTRange;
+        DescriptorRange<HAL::DSDescriptor> mDSRange;
+        DescriptorRange<HAL::SRDescriptor> mSRRange;
+        DescriptorRange<HAL::UADescriptor> mUARange;
+        DescriptorRange<HAL::CBDescriptor> mCBRange;
+        DescriptorRange<HAL::SamplerDescriptor> mSamplerRange;
 
-        Pool<> mRTPool;
-        Pool<> mDSPool;
-        Pool<> mSRPool;
-        Pool<> mUAPool;
-        Pool<> mCBPool;
-        Pool<> mSamplerPool;
-
-        std::list<Allocation<HAL::RTDescriptor>> mAllocatedRTDescriptors;
-        std::list<Allocation<HAL::DSDescriptor>> mAllocatedDSDescriptors;
-        std::list<Allocation<HAL::SRDescriptor>> mAllocatedSRDescriptors;
-        std::list<Allocation<HAL::UADescriptor>> mAllocatedUADescriptors;
-        std::list<Allocation<HAL::CBDescriptor>> mAllocatedCBDescriptors;
-        std::list<Allocation<HAL::SamplerDescriptor>> mAllocatedSamplerDescriptors;
-
-        std::vector<std::vector<Deallocation>> mPendingDeallocations;
+        uint64_t mRelocationCount = 0;
+        std::mutex mAccessMutex;
 
     public:
         inline const HAL::CBSRUADescriptorHeap& CBSRUADescriptorHeap() const { return mCBSRUADescriptorHeap; }
         inline const HAL::SamplerDescriptorHeap& SamplerDescriptorHeap() const { return mSamplerDescriptorHeap; }
+
+        // Grows every time defragmentation moves descriptors to new indices.
+        // Anything that stores descriptor indices in GPU memory must rewrite them when it changes.
+        inline uint64_t RelocationCount() const { return mRelocationCount; }
     };
 
 }
 
+#include "PoolDescriptorAllocator.inl"
@@ -0,0 +1,52 @@
+namespace Memory
+{
+
+    template <class DescriptorT, class EmplacerT>
+    PoolDescriptorAllocator::DescriptorPtr<DescriptorT> PoolDescriptorAllocator::AllocateDescriptor(DescriptorRange<DescriptorT>& range, const EmplacerT& emplacer)
+    {
+        std::optional<uint64_t> index = range.Allocator.Allocate();
+
+        assert_format(index, "Descriptor heap range is exhausted");
+
+        if (*index >= range.Allocations.size())
+        {
+            range.Allocations.resize(*index + 1);
+        }
+
+        range.Allocations[*index] = std::make_unique<Allocation<DescriptorT>>(emplacer(*index), *index, emplacer);
+        Allocation<DescriptorT>* allocation = range.Allocations[*index].get();
+
+        auto deallocationCallback = [this, &range, allocation](DescriptorT* descriptor)
+        {
+            std::lock_guard lock{ mAccessMutex };
+            // Index could have changed since allocation due to defragmentation
+            uint64_t indexInRange = allocation->IndexInRange;
+            range.Allocator.Deallocate(indexInRange);
+            range.Allocations[indexInRange] = nullptr;
+        };
+
+        return DescriptorPtr<DescriptorT>(&allocation->Descriptor, deallocationCallback);
+    }
+
+    template <class DescriptorT>
+    void PoolDescriptorAllocator::DefragmentRange(DescriptorRange<DescriptorT>& range)
+    {
+        if (!range.Allocator.IsFragmented())
+        {
+            return;
+        }
+
+        mRelocationCount += range.Allocator.Defragment(MaxRelocationsPerFrame, [&range](uint64_t oldIndex, uint64_t newIndex, uint64_t count)
+        {
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                // Blocks are only moved towards the range start, so the new index is always within the array
+                std::unique_ptr<Allocation<DescriptorT>>& allocation = range.Allocations[oldIndex + i];
+                allocation->Descriptor = allocation->Emplace(newIndex + i);
+                allocation->IndexInRange = newIndex + i;
+                range.Allocations[newIndex + i] = std::move(allocation);
+            }
+        });
+    }
+
+}
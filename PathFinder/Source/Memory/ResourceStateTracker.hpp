@@ -3,52 +3,52 @@
 #include <HardwareAbstractionLayer/Resource.hpp>
 #include <HardwareAbstractionLayer/ResourceBarrier.hpp>
 
-#include <unordered_map>
+#include "SubresourceStateTable.hpp"
+
+#include <vector>
+#include <mutex>
 
 namespace Memory
 {
 
+    // Thread safe tracker of GPU resource states that produces barriers for requested transitions
     class ResourceStateTracker
     {
     public:
-        struct SubresourceState
-        {
-            uint64_t SubresourceIndex = 0;
-            HAL::ResourceState State = HAL::ResourceState::Common;
-        };
-
-        using SubresourceStateList = std::vector<SubresourceState>;
+        using SubresourceState = SubresourceStateTable<HAL::Resource>::SubresourceState;
+        using SubresourceStateList = SubresourceStateTable<HAL::Resource>::SubresourceStateList;
 
-        void StartTrakingResource(const HAL::Resource* resource);
-        void StopTrakingResource(const HAL::Resource* resource);
+        void StartTrakingResource(HAL::Resource* resource);
+        void StopTrakingResource(HAL::Resource* resource);
 
         // Queue state update but wait until ApplyRequestedTransitions
         void RequestTransition(const HAL::Resource* resource, HAL::ResourceState newState);
         void RequestTransitions(const HAL::Resource* resource, const SubresourceStateList& newStates);
 
-        // Register new resource states that are currently pending and return a corresponding barrier collection
+        // Register new resource states that are currently pending and return a corresponding barrier collection.
+        // Requests for a resource are applied in the order they were made.
         HAL::ResourceBarrierCollection ApplyRequestedTransitions(bool tryApplyImplicitly = false);
 
-        // Immediately record new state for a resource 
+        // Immediately record new state for a resource
         HAL::ResourceBarrierCollection TransitionToStateImmediately(const HAL::Resource* resource, HAL::ResourceState newState, bool tryApplyImplicitly = false);
         HAL::ResourceBarrierCollection TransitionToStatesImmediately(const HAL::Resource* resource, const SubresourceStateList& newStates, bool tryApplyImplicitly = false);
         std::optional<HAL::ResourceTransitionBarrier> TransitionToStateImmediately(const HAL::Resource* resource, HAL::ResourceState newState, uint64_t subresourceIndex, bool tryApplyImplicitly = false);
 
-        const SubresourceStateList& ResourceCurrentStates(const HAL::Resource* resource) const;
+        SubresourceStateList ResourceCurrentStates(const HAL::Resource* resource) const;
 
         static bool CanResourceBeImplicitlyTransitioned(const HAL::Resource& resource, HAL::ResourceState fromState, HAL::ResourceState toState);
 
     private:
-        using ResourceStateMap = std::unordered_map<const HAL::Resource*, SubresourceStateList>;
-        using ResourceStateIterator = ResourceStateMap::iterator;
+        using StateTable = SubresourceStateTable<HAL::Resource>;
+
+        HAL::ResourceBarrierCollection MakeBarriers(const StateTable::TransitionList& transitions) const;
 
-        SubresourceStateList& GetResourceCurrentStatesInternal(const HAL::Resource* resource);
+        StateTable mStateTable;
 
-        bool IsNewStateRedundant(HAL::ResourceState currentState, HAL::ResourceState newState);
-        bool CanTransitionToStateImplicitly(const HAL::Resource* resource, HAL::ResourceState currentState, HAL::ResourceState newState, bool tryApplyImplicitly);
+        // Cleared on every use, but keeps its capacity
+        StateTable::TransitionList mTransitionsScratch;
 
-        ResourceStateMap mCurrentResourceStates;
-        ResourceStateMap mPendingResourceStates;
+        mutable std::mutex mAccessMutex;
     };
 
 }
@@ -9,12 +9,27 @@ namespace Memory
         : mMaxSize{ maxSize } {}
 
     Ring::OffsetType Ring::Allocate(OffsetType size)
+    {
+        return Allocate(size, 1);
+    }
+
+    Ring::OffsetType Ring::Allocate(OffsetType size, OffsetType alignment)
     {
         if (IsFull())
         {
             return InvalidOffset;
         }
 
+        // Nothing is in flight, so allocations can start from the beginning 
+        // instead of being limited by wherever the last frame ended
+        if (IsEmpty() && mCompletedFrameTails.empty() && mCurrentFrameSize == 0)
+        {
+            mHead = 0;
+            mTail = 0;
+        }
+
+        OffsetType padding = (alignment - mTail % alignment) % alignment;
+
         if (mTail >= mHead)
         {
             //                     Head             Tail     MaxSize
@@ -22,12 +37,12 @@ namespace Memory
             //  [                  xxxxxxxxxxxxxxxxx         ]
             //                                        
             //
-            if (mTail + size <= mMaxSize)
+            if (mTail + padding + size <= mMaxSize)
             {
-                auto offset = mTail;
-                mTail += size;
-                mUsedSize += size;
-                mCurrentFrameSize += size;
+                auto offset = mTail + padding;
+                mTail += padding + size;
+                mUsedSize += padding + size;
+                mCurrentFrameSize += padding + size;
                 return offset;
             }
             else if (size <= mHead)
@@ -40,17 +55,17 @@ namespace Memory
                 return 0;
             }
         }
-        else if (mTail + size <= mHead)
+        else if (mTail + padding + size <= mHead)
         {
             //
             //       Tail          Head            
             //       |             |            
             //  [xxxx              xxxxxxxxxxxxxxxxxxxxxxxxxx]
             //
-            auto offset = mTail;
-            mTail += size;
-            mUsedSize += size;
-            mCurrentFrameSize += size;
+            auto offset = mTail + padding;
+            mTail += padding + size;
+            mUsedSize += padding + size;
+            mCurrentFrameSize += padding + size;
             return offset;
         }
 
@@ -81,9 +96,9 @@ namespace Memory
         }
     }
 
-    void Ring::SetDeallocationCallback(const DeallocationCallback& callback)
+    void Ring::SetDeallocationCallback(DeallocationCallback&& callback)
     {
-        mDeallocationCallback = callback;
+        mDeallocationCallback = std::move(callback);
     }
 
 }
@@ -2,7 +2,8 @@
 
 #include <cstdint>
 #include <deque>
-#include <functional>
+
+#include <Foundation/Delegate.hpp>
 
 namespace Memory
 {
@@ -24,7 +25,7 @@ namespace Memory
             OffsetType Size;
         };
 
-        using DeallocationCallback = std::function<void(const FrameTailAttributes& frameAttributes)>;
+        using DeallocationCallback = Foundation::Delegate<void(const FrameTailAttributes& frameAttributes)>;
 
         static const OffsetType InvalidOffset = static_cast<OffsetType>(-1);
 
@@ -32,9 +33,12 @@ namespace Memory
 
         OffsetType Allocate(OffsetType Size);
 
+        // Returned offset is a multiple of alignment, padding is accounted as a part of the allocation
+        OffsetType Allocate(OffsetType size, OffsetType alignment);
+
         void FinishCurrentFrame(uint64_t fenceValue);
         void ReleaseCompletedFrames(uint64_t completedFenceValue);
-        void SetDeallocationCallback(const DeallocationCallback& callback);
+        void SetDeallocationCallback(DeallocationCallback&& callback);
 
         inline OffsetType MaxSize() const { return mMaxSize; }
         inline bool IsFull() const { return mUsedSize == mMaxSize; };
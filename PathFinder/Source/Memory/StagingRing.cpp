@@ -0,0 +1,35 @@
+#include "StagingRing.hpp"
+
+namespace Memory
+{
+
+    StagingRing::StagingRing(HAL::Buffer* buffer, uint8_t* mappedMemory, uint64_t capacity)
+        : mBuffer{ buffer }, mMappedMemory{ mappedMemory }, mRing{ capacity } {}
+
+    std::optional<StagingRing::Allocation> StagingRing::Allocate(uint64_t size)
+    {
+        std::lock_guard lock{ mAccessMutex };
+
+        Ring::OffsetType offset = mRing.Allocate(size, AllocationAlignment);
+
+        if (offset == Ring::InvalidOffset)
+        {
+            return std::nullopt;
+        }
+
+        return Allocation{ mBuffer, offset, mMappedMemory + offset };
+    }
+
+    void StagingRing::FinishCurrentFrame(uint64_t frameNumber)
+    {
+        std::lock_guard lock{ mAccessMutex };
+        mRing.FinishCurrentFrame(frameNumber);
+    }
+
+    void StagingRing::EndFrame(uint64_t completedFrameNumber)
+    {
+        std::lock_guard lock{ mAccessMutex };
+        mRing.ReleaseCompletedFrames(completedFrameNumber);
+    }
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Ring.hpp"
+
+#include <HardwareAbstractionLayer/Buffer.hpp>
+
+#include <optional>
+#include <mutex>
+
+namespace Memory
+{
+
+    // Suballocates per-frame upload data from a persistently mapped upload heap buffer.
+    // Memory of a frame is reclaimed once the frame fence passes the value the frame was finished with.
+    // Buffer is owned elsewhere and is only handed out with allocations, so the ring itself never touches the GPU.
+    class StagingRing
+    {
+    public:
+        struct Allocation
+        {
+            HAL::Buffer* Buffer = nullptr;
+            uint64_t Offset = 0;
+            uint8_t* CPUAddress = nullptr;
+        };
+
+        // Satisfies both buffer copies and placed texture footprints
+        static constexpr uint64_t AllocationAlignment = D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT;
+
+        StagingRing(HAL::Buffer* buffer, uint8_t* mappedMemory, uint64_t capacity);
+
+        // Empty if the ring is out of space until in-flight frames complete
+        std::optional<Allocation> Allocate(uint64_t size);
+
+        // Associate allocations made so far with a fence value they're going to be consumed by
+        void FinishCurrentFrame(uint64_t frameNumber);
+        void EndFrame(uint64_t completedFrameNumber);
+
+    private:
+        HAL::Buffer* mBuffer = nullptr;
+        uint8_t* mMappedMemory = nullptr;
+        Ring mRing;
+        std::mutex mAccessMutex;
+
+    public:
+        inline uint64_t Capacity() const { return mRing.MaxSize(); }
+    };
+
+}
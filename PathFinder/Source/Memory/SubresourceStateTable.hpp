@@ -0,0 +1,113 @@
+#pragma once
+
+#include <HardwareAbstractionLayer/ResourceState.hpp>
+
+#include <robinhood/robin_hood.h>
+
+#include <vector>
+#include <optional>
+#include <limits>
+
+namespace Memory
+{
+
+    // Tracked resources receive dense indices and their subresource states are kept in a single flat arena,
+    // so state lookups are plain array accesses instead of pointer hashing and per-resource allocations.
+    //
+    // Resource is expected to provide the state tracking index, subresource count, initial states
+    // and implicit promotion / decay queries of HAL::Resource. Not thread safe.
+    template <class Resource>
+    class SubresourceStateTable
+    {
+    public:
+        struct SubresourceState
+        {
+            uint64_t SubresourceIndex = 0;
+            HAL::ResourceState State = HAL::ResourceState::Common;
+        };
+
+        // Transition that requires a barrier. Missing subresource index means all subresources.
+        struct Transition
+        {
+            const Resource* TransitionedResource = nullptr;
+            HAL::ResourceState OldState = HAL::ResourceState::Common;
+            HAL::ResourceState NewState = HAL::ResourceState::Common;
+            std::optional<uint64_t> SubresourceIndex;
+        };
+
+        using SubresourceStateList = std::vector<SubresourceState>;
+        using TransitionList = std::vector<Transition>;
+
+        void StartTracking(Resource* resource);
+        void StopTracking(Resource* resource);
+
+        void RequestTransition(const Resource* resource, HAL::ResourceState newState);
+        void RequestTransitions(const Resource* resource, const SubresourceStateList& newStates);
+
+        // Requests for a resource are applied in the order they were made
+        void ApplyRequestedTransitions(bool tryApplyImplicitly, TransitionList& transitions);
+
+        void TransitionToState(const Resource* resource, HAL::ResourceState newState, bool tryApplyImplicitly, TransitionList& transitions);
+        void TransitionToStates(const Resource* resource, const SubresourceStateList& newStates, bool tryApplyImplicitly, TransitionList& transitions);
+        std::optional<Transition> TransitionToState(const Resource* resource, HAL::ResourceState newState, uint64_t subresourceIndex, bool tryApplyImplicitly);
+
+        SubresourceStateList CurrentStates(const Resource* resource) const;
+
+        static bool CanBeImplicitlyTransitioned(const Resource& resource, HAL::ResourceState fromState, HAL::ResourceState toState);
+
+    private:
+        struct TrackedResource
+        {
+            const Resource* Instance = nullptr;
+            uint64_t FirstStateIndex = 0;
+            uint32_t StateCount = 0;
+        };
+
+        struct PendingTransition
+        {
+            uint32_t TrackingIndex = 0;
+            uint32_t SubresourceIndex = 0;
+            HAL::ResourceState State = HAL::ResourceState::Common;
+        };
+
+        static constexpr uint32_t AllSubresources = std::numeric_limits<uint32_t>::max();
+
+        // Freed arena ranges are reused by resources with the same subresource count,
+        // arena is compacted once more than a half of it is unused
+        static constexpr uint64_t MinStateCountToCompact = 4096;
+
+        const TrackedResource& GetTrackedResource(const Resource* resource) const;
+        uint64_t AllocateStates(uint32_t stateCount);
+        void FreeStates(const TrackedResource& trackedResource);
+        void CompactStates();
+
+        void TransitionToState(const TrackedResource& trackedResource, HAL::ResourceState newState, bool tryApplyImplicitly, TransitionList& transitions);
+        void TransitionToStates(const TrackedResource& trackedResource, const SubresourceState* newStates, uint64_t newStateCount, bool tryApplyImplicitly, TransitionList& transitions);
+
+        // Replace per-subresource transitions added since firstTransitionIndex with a single one if they cover the whole resource identically
+        void CollapseTransitions(const TrackedResource& trackedResource, HAL::ResourceState oldState, HAL::ResourceState newState, bool statesMatch, size_t firstTransitionIndex, TransitionList& transitions);
+
+        static bool IsNewStateRedundant(HAL::ResourceState currentState, HAL::ResourceState newState);
+        static bool CanTransitionToStateImplicitly(const Resource* resource, HAL::ResourceState currentState, HAL::ResourceState newState, bool tryApplyImplicitly);
+
+        std::vector<TrackedResource> mTrackedResources;
+        std::vector<uint32_t> mFreeTrackingIndices;
+
+        std::vector<HAL::ResourceState> mSubresourceStates;
+        robin_hood::unordered_flat_map<uint32_t, std::vector<uint64_t>> mFreeStateRanges;
+        uint64_t mFreeStateCount = 0;
+
+        // Cleared every frame, but keeps its capacity
+        std::vector<PendingTransition> mPendingTransitions;
+        SubresourceStateList mPendingStatesScratch;
+
+    public:
+        inline auto ArenaSize() const { return mSubresourceStates.size(); }
+        inline auto FreeStateCount() const { return mFreeStateCount; }
+        inline auto TrackingIndexCount() const { return mTrackedResources.size(); }
+        inline auto PendingTransitionCount() const { return mPendingTransitions.size(); }
+    };
+
+}
+
+#include "SubresourceStateTable.inl"
@@ -0,0 +1,354 @@
+#pragma once
+
+#include <algorithm>
+
+namespace Memory
+{
+
+    template <class Resource>
+    void SubresourceStateTable<Resource>::StartTracking(Resource* resource)
+    {
+        assert_format(resource->StateTrackingIndex() == Resource::InvalidStateTrackingIndex, "Resource is already being tracked");
+
+        uint32_t trackingIndex = 0;
+
+        if (!mFreeTrackingIndices.empty())
+        {
+            trackingIndex = mFreeTrackingIndices.back();
+            mFreeTrackingIndices.pop_back();
+        }
+        else
+        {
+            trackingIndex = (uint32_t)mTrackedResources.size();
+            mTrackedResources.emplace_back();
+        }
+
+        TrackedResource& trackedResource = mTrackedResources[trackingIndex];
+        trackedResource.Instance = resource;
+        trackedResource.StateCount = resource->SubresourceCount();
+        trackedResource.FirstStateIndex = AllocateStates(trackedResource.StateCount);
+
+        std::fill_n(mSubresourceStates.begin() + trackedResource.FirstStateIndex, trackedResource.StateCount, resource->InitialStates());
+
+        resource->SetStateTrackingIndex(trackingIndex);
+    }
+
+    template <class Resource>
+    void SubresourceStateTable<Resource>::StopTracking(Resource* resource)
+    {
+        uint32_t trackingIndex = resource->StateTrackingIndex();
+        TrackedResource trackedResource = GetTrackedResource(resource);
+
+        // Requests for a resource that is gone must not be applied to a resource that will reuse the index
+        mPendingTransitions.erase(
+            std::remove_if(mPendingTransitions.begin(), mPendingTransitions.end(),
+                [trackingIndex](const PendingTransition& transition) { return transition.TrackingIndex == trackingIndex; }),
+            mPendingTransitions.end());
+
+        // Record is cleared first so that arena compaction triggered by freeing doesn't keep its states
+        mTrackedResources[trackingIndex] = TrackedResource{};
+        mFreeTrackingIndices.push_back(trackingIndex);
+
+        FreeStates(trackedResource);
+
+        resource->SetStateTrackingIndex(Resource::InvalidStateTrackingIndex);
+    }
+
+    template <class Resource>
+    void SubresourceStateTable<Resource>::RequestTransition(const Resource* resource, HAL::ResourceState newState)
+    {
+        GetTrackedResource(resource);
+        mPendingTransitions.push_back({ resource->StateTrackingIndex(), AllSubresources, newState });
+    }
+
+    template <class Resource>
+    void SubresourceStateTable<Resource>::RequestTransitions(const Resource* resource, const SubresourceStateList& newStates)
+    {
+        GetTrackedResource(resource);
+
+        for (const SubresourceState& subresourceState : newStates)
+        {
+            mPendingTransitions.push_back({ resource->StateTrackingIndex(), (uint32_t)subresourceState.SubresourceIndex, subresourceState.State });
+        }
+    }
+
+    template <class Resource>
+    void SubresourceStateTable<Resource>::ApplyRequestedTransitions(bool tryApplyImplicitly, TransitionList& transitions)
+    {
+        // Group requests by resource, stable sort keeps the order of requests made for the same resource
+        std::stable_sort(mPendingTransitions.begin(), mPendingTransitions.end(),
+            [](const PendingTransition& first, const PendingTransition& second) { return first.TrackingIndex < second.TrackingIndex; });
+
+        for (auto transitionIt = mPendingTransitions.begin(); transitionIt != mPendingTransitions.end();)
+        {
+            uint32_t trackingIndex = transitionIt->TrackingIndex;
+            const TrackedResource& trackedResource = mTrackedResources[trackingIndex];
+
+            // Whole resource requests are applied one by one, so that each of them can end up as a single barrier
+            if (transitionIt->SubresourceIndex == AllSubresources)
+            {
+                TransitionToState(trackedResource, transitionIt->State, tryApplyImplicitly, transitions);
+                ++transitionIt;
+                continue;
+            }
+
+            mPendingStatesScratch.clear();
+
+            for (; transitionIt != mPendingTransitions.end() && transitionIt->TrackingIndex == trackingIndex && transitionIt->SubresourceIndex != AllSubresources; ++transitionIt)
+            {
+                mPendingStatesScratch.push_back({ transitionIt->SubresourceIndex, transitionIt->State });
+            }
+
+            TransitionToStates(trackedResource, mPendingStatesScratch.data(), mPendingStatesScratch.size(), tryApplyImplicitly, transitions);
+        }
+
+        mPendingTransitions.clear();
+    }
+
+    template <class Resource>
+    void SubresourceStateTable<Resource>::TransitionToState(const Resource* resource, HAL::ResourceState newState, bool tryApplyImplicitly, TransitionList& transitions)
+    {
+        TransitionToState(GetTrackedResource(resource), newState, tryApplyImplicitly, transitions);
+    }
+
+    template <class Resource>
+    void SubresourceStateTable<Resource>::TransitionToStates(const Resource* resource, const SubresourceStateList& newStates, bool tryApplyImplicitly, TransitionList& transitions)
+    {
+        TransitionToStates(GetTrackedResource(resource), newStates.data(), newStates.size(), tryApplyImplicitly, transitions);
+    }
+
+    template <class Resource>
+    std::optional<typename SubresourceStateTable<Resource>::Transition> SubresourceStateTable<Resource>::TransitionToState(
+        const Resource* resource, HAL::ResourceState newState, uint64_t subresourceIndex, bool tryApplyImplicitly)
+    {
+        const TrackedResource& trackedResource = GetTrackedResource(resource);
+        assert_format(subresourceIndex < trackedResource.StateCount, "Requested a state change for subresource that doesn't exist");
+
+        HAL::ResourceState& currentState = mSubresourceStates[trackedResource.FirstStateIndex + subresourceIndex];
+        HAL::ResourceState oldState = currentState;
+
+        if (IsNewStateRedundant(oldState, newState))
+        {
+            return std::nullopt;
+        }
+
+        currentState = newState;
+
+        if (CanTransitionToStateImplicitly(resource, oldState, newState, tryApplyImplicitly))
+        {
+            return std::nullopt;
+        }
+
+        return Transition{ resource, oldState, newState, subresourceIndex };
+    }
+
+    template <class Resource>
+    typename SubresourceStateTable<Resource>::SubresourceStateList SubresourceStateTable<Resource>::CurrentStates(const Resource* resource) const
+    {
+        const TrackedResource& trackedResource = GetTrackedResource(resource);
+        SubresourceStateList states(trackedResource.StateCount);
+
+        for (auto subresourceIdx = 0u; subresourceIdx < trackedResource.StateCount; ++subresourceIdx)
+        {
+            states[subresourceIdx] = { subresourceIdx, mSubresourceStates[trackedResource.FirstStateIndex + subresourceIdx] };
+        }
+
+        return states;
+    }
+
+    template <class Resource>
+    bool SubresourceStateTable<Resource>::CanBeImplicitlyTransitioned(const Resource& resource, HAL::ResourceState fromState, HAL::ResourceState toState)
+    {
+        return resource.CanImplicitlyDecayToCommonStateFromState(fromState) && resource.CanImplicitlyPromoteFromCommonStateToState(toState);
+    }
+
+    template <class Resource>
+    const typename SubresourceStateTable<Resource>::TrackedResource& SubresourceStateTable<Resource>::GetTrackedResource(const Resource* resource) const
+    {
+        uint32_t trackingIndex = resource->StateTrackingIndex();
+
+        assert_format(trackingIndex < mTrackedResources.size() && mTrackedResources[trackingIndex].Instance == resource,
+            "Resource is not registered / not being tracked. It may have been deallocated before transitions were applied.");
+
+        return mTrackedResources[trackingIndex];
+    }
+
+    template <class Resource>
+    uint64_t SubresourceStateTable<Resource>::AllocateStates(uint32_t stateCount)
+    {
+        auto freeRangesIt = mFreeStateRanges.find(stateCount);
+
+        if (freeRangesIt != mFreeStateRanges.end() && !freeRangesIt->second.empty())
+        {
+            uint64_t firstStateIndex = freeRangesIt->second.back();
+            freeRangesIt->second.pop_back();
+            mFreeStateCount -= stateCount;
+            return firstStateIndex;
+        }
+
+        uint64_t firstStateIndex = mSubresourceStates.size();
+        mSubresourceStates.resize(firstStateIndex + stateCount);
+        return firstStateIndex;
+    }
+
+    template <class Resource>
+    void SubresourceStateTable<Resource>::FreeStates(const TrackedResource& trackedResource)
+    {
+        mFreeStateRanges[trackedResource.StateCount].push_back(trackedResource.FirstStateIndex);
+        mFreeStateCount += trackedResource.StateCount;
+
+        if (mFreeStateCount >= MinStateCountToCompact && mFreeStateCount * 2 > mSubresourceStates.size())
+        {
+            CompactStates();
+        }
+    }
+
+    template <class Resource>
+    void SubresourceStateTable<Resource>::CompactStates()
+    {
+        std::vector<HAL::ResourceState> compactedStates;
+        compactedStates.reserve(mSubresourceStates.size() - mFreeStateCount);
+
+        for (TrackedResource& trackedResource : mTrackedResources)
+        {
+            if (!trackedResource.Instance)
+            {
+                continue;
+            }
+
+            auto firstStateIt = mSubresourceStates.begin() + trackedResource.FirstStateIndex;
+            trackedResource.FirstStateIndex = compactedStates.size();
+            compactedStates.insert(compactedStates.end(), firstStateIt, firstStateIt + trackedResource.StateCount);
+        }
+
+        mSubresourceStates = std::move(compactedStates);
+        mFreeStateRanges.clear();
+        mFreeStateCount = 0;
+    }
+
+    template <class Resource>
+    void SubresourceStateTable<Resource>::TransitionToState(const TrackedResource& trackedResource, HAL::ResourceState newState, bool tryApplyImplicitly, TransitionList& transitions)
+    {
+        HAL::ResourceState* currentStates = mSubresourceStates.data() + trackedResource.FirstStateIndex;
+        size_t firstTransitionIndex = transitions.size();
+        std::optional<HAL::ResourceState> firstOldState;
+        bool statesMatch = true;
+
+        for (auto subresourceIdx = 0u; subresourceIdx < trackedResource.StateCount; ++subresourceIdx)
+        {
+            HAL::ResourceState oldState = currentStates[subresourceIdx];
+
+            if (IsNewStateRedundant(oldState, newState))
+            {
+                continue;
+            }
+
+            currentStates[subresourceIdx] = newState;
+
+            if (CanTransitionToStateImplicitly(trackedResource.Instance, oldState, newState, tryApplyImplicitly))
+            {
+                continue;
+            }
+
+            transitions.push_back({ trackedResource.Instance, oldState, newState, subresourceIdx });
+
+            if (!firstOldState)
+            {
+                firstOldState = oldState;
+            }
+            else if (oldState != *firstOldState)
+            {
+                statesMatch = false;
+            }
+        }
+
+        if (firstOldState)
+        {
+            CollapseTransitions(trackedResource, *firstOldState, newState, statesMatch, firstTransitionIndex, transitions);
+        }
+    }
+
+    template <class Resource>
+    void SubresourceStateTable<Resource>::TransitionToStates(const TrackedResource& trackedResource, const SubresourceState* newStates, uint64_t newStateCount, bool tryApplyImplicitly, TransitionList& transitions)
+    {
+        HAL::ResourceState* currentStates = mSubresourceStates.data() + trackedResource.FirstStateIndex;
+        size_t firstTransitionIndex = transitions.size();
+        std::optional<HAL::ResourceState> firstOldState;
+        std::optional<HAL::ResourceState> firstNewState;
+        bool statesMatch = true;
+
+        for (auto newStateIdx = 0u; newStateIdx < newStateCount; ++newStateIdx)
+        {
+            const SubresourceState& newSubresourceState = newStates[newStateIdx];
+            assert_format(newSubresourceState.SubresourceIndex < trackedResource.StateCount, "Requested a state change for subresource that doesn't exist");
+
+            HAL::ResourceState& currentState = currentStates[newSubresourceState.SubresourceIndex];
+            HAL::ResourceState oldState = currentState;
+            HAL::ResourceState newState = newSubresourceState.State;
+
+            if (IsNewStateRedundant(oldState, newState))
+            {
+                continue;
+            }
+
+            currentState = newState;
+
+            if (CanTransitionToStateImplicitly(trackedResource.Instance, oldState, newState, tryApplyImplicitly))
+            {
+                continue;
+            }
+
+            transitions.push_back({ trackedResource.Instance, oldState, newState, newSubresourceState.SubresourceIndex });
+
+            // If any old subresource states do not match or any of the new states do not match
+            // then performing single transition barrier for all subresources is not possible
+            if (!firstOldState)
+            {
+                firstOldState = oldState;
+                firstNewState = newState;
+            }
+            else if (oldState != *firstOldState || newState != *firstNewState)
+            {
+                statesMatch = false;
+            }
+        }
+
+        if (firstOldState)
+        {
+            CollapseTransitions(trackedResource, *firstOldState, *firstNewState, statesMatch, firstTransitionIndex, transitions);
+        }
+    }
+
+    template <class Resource>
+    void SubresourceStateTable<Resource>::CollapseTransitions(
+        const TrackedResource& trackedResource, HAL::ResourceState oldState, HAL::ResourceState newState, bool statesMatch, size_t firstTransitionIndex, TransitionList& transitions)
+    {
+        // Matching transitions can't repeat a subresource, so their count tells whether every subresource is transitioned.
+        // If some subresources are left in their states, a single all-subresource barrier would be incorrect.
+        size_t transitionCount = transitions.size() - firstTransitionIndex;
+
+        if (!statesMatch || transitionCount < 2 || transitionCount != trackedResource.StateCount)
+        {
+            return;
+        }
+
+        transitions.resize(firstTransitionIndex);
+        transitions.push_back({ trackedResource.Instance, oldState, newState, std::nullopt });
+    }
+
+    template <class Resource>
+    bool SubresourceStateTable<Resource>::IsNewStateRedundant(HAL::ResourceState currentState, HAL::ResourceState newState)
+    {
+        // Transition is redundant if either states completely match
+        // or current state is a read state and new state is a partial or complete subset of the current
+        // (which implies that it is also a read state)
+        return (currentState == newState) || (HAL::IsResourceStateReadOnly(currentState) && EnumMaskEquals(currentState, newState));
+    }
+
+    template <class Resource>
+    bool SubresourceStateTable<Resource>::CanTransitionToStateImplicitly(const Resource* resource, HAL::ResourceState currentState, HAL::ResourceState newState, bool tryApplyImplicitly)
+    {
+        return tryApplyImplicitly && CanBeImplicitlyTransitioned(*resource, currentState, newState);
+    }
+
+}
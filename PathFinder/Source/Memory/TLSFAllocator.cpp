@@ -0,0 +1,318 @@
+#include "TLSFAllocator.hpp"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Memory
+{
+
+    TLSFAllocator::TLSFAllocator(uint64_t capacity, uint64_t granularity)
+        : mCapacity{ capacity - capacity % granularity }, mGranularity{ granularity }
+    {
+        assert_format(granularity > 0 && (granularity & (granularity - 1)) == 0, "Granularity must be a power of 2");
+        assert_format(mCapacity > 0, "Allocator capacity must be at least one granule");
+
+        for (auto& secondLevelLists : mFreeLists)
+        {
+            secondLevelLists.fill(InvalidBlockIndex);
+        }
+
+        InsertFreeBlock(CreateBlock(0, mCapacity));
+    }
+
+    std::optional<TLSFAllocator::Allocation> TLSFAllocator::Allocate(uint64_t size, uint64_t alignment)
+    {
+        assert_format(size > 0, "0 bytes allocations are forbidden");
+        assert_format((alignment & (alignment - 1)) == 0, "Alignment must be a power of 2");
+
+        alignment = std::max(alignment, mGranularity);
+        size = ((size + mGranularity - 1) / mGranularity) * mGranularity;
+
+        if (size > mCapacity)
+        {
+            return std::nullopt;
+        }
+
+        // Every block offset is a multiple of granularity, so aligning
+        // any block start will consume at most (alignment - granularity) bytes
+        uint64_t searchSize = size + alignment - mGranularity;
+        std::optional<ListIndex> listIndex = FindSuitableList(MapSizeToSearchListIndex(searchSize));
+
+        if (!listIndex)
+        {
+            return std::nullopt;
+        }
+
+        uint32_t blockIndex = mFreeLists[listIndex->FirstLevel][listIndex->SecondLevel];
+        RemoveFreeBlock(blockIndex);
+
+        uint64_t blockOffset = mBlocks[blockIndex].Offset;
+        uint64_t padding = ((blockOffset + alignment - 1) / alignment) * alignment - blockOffset;
+
+        // Return leading padding back to free lists
+        if (padding > 0)
+        {
+            uint32_t alignedBlockIndex = SplitBlock(blockIndex, padding);
+            InsertFreeBlock(blockIndex);
+            blockIndex = alignedBlockIndex;
+        }
+
+        // Return trailing remainder back to free lists
+        if (mBlocks[blockIndex].Size > size)
+        {
+            uint32_t remainderBlockIndex = SplitBlock(blockIndex, size);
+            InsertFreeBlock(remainderBlockIndex);
+        }
+
+        mAllocatedSize += size;
+        ++mAllocationCount;
+
+        Allocation allocation{};
+        allocation.Offset = mBlocks[blockIndex].Offset;
+        allocation.Size = size;
+        allocation.BlockIndex = blockIndex;
+
+        return allocation;
+    }
+
+    void TLSFAllocator::Deallocate(const Allocation& allocation)
+    {
+        assert_format(allocation.BlockIndex < mBlocks.size() && !mBlocks[allocation.BlockIndex].IsFree,
+            "Deallocating allocation that doesn't belong to this allocator or was already deallocated");
+
+        uint32_t blockIndex = allocation.BlockIndex;
+
+        mAllocatedSize -= mBlocks[blockIndex].Size;
+        --mAllocationCount;
+
+        // Coalesce with free physical neighbours immediately,
+        // so that no two adjacent blocks are ever free at the same time
+        uint32_t previousBlockIndex = mBlocks[blockIndex].PreviousPhysicalBlock;
+
+        if (previousBlockIndex != InvalidBlockIndex && mBlocks[previousBlockIndex].IsFree)
+        {
+            RemoveFreeBlock(previousBlockIndex);
+            blockIndex = MergeBlocks(previousBlockIndex, blockIndex);
+        }
+
+        uint32_t nextBlockIndex = mBlocks[blockIndex].NextPhysicalBlock;
+
+        if (nextBlockIndex != InvalidBlockIndex && mBlocks[nextBlockIndex].IsFree)
+        {
+            RemoveFreeBlock(nextBlockIndex);
+            blockIndex = MergeBlocks(blockIndex, nextBlockIndex);
+        }
+
+        InsertFreeBlock(blockIndex);
+    }
+
+    TLSFAllocator::ListIndex TLSFAllocator::MapSizeToListIndex(uint64_t size) const
+    {
+        // Small sizes are all linearly mapped to the first list row
+        if (size < SecondLevelIndexCount)
+        {
+            return { 0, uint32_t(size) };
+        }
+
+        uint32_t highestBit = FindHighestSetBit(size);
+        uint32_t secondLevel = uint32_t(size >> (highestBit - SecondLevelIndexLog2)) ^ SecondLevelIndexCount;
+        uint32_t firstLevel = highestBit - SecondLevelIndexLog2 + 1;
+
+        return { firstLevel, secondLevel };
+    }
+
+    TLSFAllocator::ListIndex TLSFAllocator::MapSizeToSearchListIndex(uint64_t size) const
+    {
+        // Round size up to the next list boundary so that
+        // any block from the resulting list is guaranteed to fit
+        if (size >= SecondLevelIndexCount)
+        {
+            size += (1ull << (FindHighestSetBit(size) - SecondLevelIndexLog2)) - 1;
+        }
+
+        return MapSizeToListIndex(size);
+    }
+
+    std::optional<TLSFAllocator::ListIndex> TLSFAllocator::FindSuitableList(const ListIndex& startIndex) const
+    {
+        if (startIndex.FirstLevel >= FirstLevelIndexCount)
+        {
+            return std::nullopt;
+        }
+
+        // Search for a non-empty list in the same size class first
+        uint32_t secondLevelBitmap = mSecondLevelBitmaps[startIndex.FirstLevel] & (~0u << startIndex.SecondLevel);
+
+        if (secondLevelBitmap != 0)
+        {
+            return ListIndex{ startIndex.FirstLevel, FindLowestSetBit(secondLevelBitmap) };
+        }
+
+        // Then take the smallest block in the next non-empty size class
+        uint64_t firstLevelBitmap = startIndex.FirstLevel + 1 < 64 ? mFirstLevelBitmap & (~0ull << (startIndex.FirstLevel + 1)) : 0;
+
+        if (firstLevelBitmap == 0)
+        {
+            return std::nullopt;
+        }
+
+        uint32_t firstLevel = FindLowestSetBit(firstLevelBitmap);
+        return ListIndex{ firstLevel, FindLowestSetBit(mSecondLevelBitmaps[firstLevel]) };
+    }
+
+    uint32_t TLSFAllocator::CreateBlock(uint64_t offset, uint64_t size)
+    {
+        uint32_t blockIndex = 0;
+
+        if (!mUnusedBlockIndices.empty())
+        {
+            blockIndex = mUnusedBlockIndices.back();
+            mUnusedBlockIndices.pop_back();
+        }
+        else
+        {
+            blockIndex = uint32_t(mBlocks.size());
+            mBlocks.emplace_back();
+        }
+
+        Block& block = mBlocks[blockIndex];
+        block = Block{};
+        block.Offset = offset;
+        block.Size = size;
+
+        return blockIndex;
+    }
+
+    void TLSFAllocator::DestroyBlock(uint32_t blockIndex)
+    {
+        mBlocks[blockIndex] = Block{};
+        mUnusedBlockIndices.push_back(blockIndex);
+    }
+
+    void TLSFAllocator::InsertFreeBlock(uint32_t blockIndex)
+    {
+        ListIndex listIndex = MapSizeToListIndex(mBlocks[blockIndex].Size);
+        uint32_t& listHead = mFreeLists[listIndex.FirstLevel][listIndex.SecondLevel];
+
+        Block& block = mBlocks[blockIndex];
+        block.IsFree = true;
+        block.PreviousFreeBlock = InvalidBlockIndex;
+        block.NextFreeBlock = listHead;
+
+        if (listHead != InvalidBlockIndex)
+        {
+            mBlocks[listHead].PreviousFreeBlock = blockIndex;
+        }
+
+        listHead = blockIndex;
+
+        mFirstLevelBitmap |= 1ull << listIndex.FirstLevel;
+        mSecondLevelBitmaps[listIndex.FirstLevel] |= 1u << listIndex.SecondLevel;
+    }
+
+    void TLSFAllocator::RemoveFreeBlock(uint32_t blockIndex)
+    {
+        ListIndex listIndex = MapSizeToListIndex(mBlocks[blockIndex].Size);
+        uint32_t& listHead = mFreeLists[listIndex.FirstLevel][listIndex.SecondLevel];
+
+        Block& block = mBlocks[blockIndex];
+        block.IsFree = false;
+
+        if (block.PreviousFreeBlock != InvalidBlockIndex)
+        {
+            mBlocks[block.PreviousFreeBlock].NextFreeBlock = block.NextFreeBlock;
+        }
+
+        if (block.NextFreeBlock != InvalidBlockIndex)
+        {
+            mBlocks[block.NextFreeBlock].PreviousFreeBlock = block.PreviousFreeBlock;
+        }
+
+        if (listHead == blockIndex)
+        {
+            listHead = block.NextFreeBlock;
+
+            if (listHead == InvalidBlockIndex)
+            {
+                mSecondLevelBitmaps[listIndex.FirstLevel] &= ~(1u << listIndex.SecondLevel);
+
+                if (mSecondLevelBitmaps[listIndex.FirstLevel] == 0)
+                {
+                    mFirstLevelBitmap &= ~(1ull << listIndex.FirstLevel);
+                }
+            }
+        }
+
+        block.PreviousFreeBlock = InvalidBlockIndex;
+        block.NextFreeBlock = InvalidBlockIndex;
+    }
+
+    uint32_t TLSFAllocator::SplitBlock(uint32_t blockIndex, uint64_t firstPartSize)
+    {
+        uint64_t offset = mBlocks[blockIndex].Offset;
+        uint64_t size = mBlocks[blockIndex].Size;
+
+        assert_format(firstPartSize < size, "Split point is outside of the block");
+
+        // May reallocate block storage, so references are taken afterwards
+        uint32_t secondPartIndex = CreateBlock(offset + firstPartSize, size - firstPartSize);
+
+        Block& firstPart = mBlocks[blockIndex];
+        Block& secondPart = mBlocks[secondPartIndex];
+
+        secondPart.PreviousPhysicalBlock = blockIndex;
+        secondPart.NextPhysicalBlock = firstPart.NextPhysicalBlock;
+
+        if (firstPart.NextPhysicalBlock != InvalidBlockIndex)
+        {
+            mBlocks[firstPart.NextPhysicalBlock].PreviousPhysicalBlock = secondPartIndex;
+        }
+
+        firstPart.NextPhysicalBlock = secondPartIndex;
+        firstPart.Size = firstPartSize;
+
+        return secondPartIndex;
+    }
+
+    uint32_t TLSFAllocator::MergeBlocks(uint32_t leftBlockIndex, uint32_t rightBlockIndex)
+    {
+        Block& left = mBlocks[leftBlockIndex];
+        Block& right = mBlocks[rightBlockIndex];
+
+        left.Size += right.Size;
+        left.NextPhysicalBlock = right.NextPhysicalBlock;
+
+        if (right.NextPhysicalBlock != InvalidBlockIndex)
+        {
+            mBlocks[right.NextPhysicalBlock].PreviousPhysicalBlock = leftBlockIndex;
+        }
+
+        DestroyBlock(rightBlockIndex);
+
+        return leftBlockIndex;
+    }
+
+    uint32_t TLSFAllocator::FindLowestSetBit(uint64_t value)
+    {
+#ifdef _MSC_VER
+        unsigned long index = 0;
+        _BitScanForward64(&index, value);
+        return index;
+#else
+        return __builtin_ctzll(value);
+#endif
+    }
+
+    uint32_t TLSFAllocator::FindHighestSetBit(uint64_t value)
+    {
+#ifdef _MSC_VER
+        unsigned long index = 0;
+        _BitScanReverse64(&index, value);
+        return index;
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <optional>
+#include <limits>
+#include <algorithm>
+
+namespace Memory
+{
+
+    /// Two-Level Segregated Fit suballocator operating on an abstract [0, capacity) memory range.
+    /// Doesn't own any memory, only manages offsets, so it can be used to suballocate GPU heaps.
+    /// Allocation and deallocation are O(1): free blocks are kept in lists segregated by
+    /// power-of-two size classes (first level) each linearly split into sub-classes (second level).
+    class TLSFAllocator
+    {
+    public:
+        struct Allocation
+        {
+            uint64_t Offset = 0;
+            uint64_t Size = 0;
+
+        private:
+            friend class TLSFAllocator;
+            uint32_t BlockIndex = InvalidBlockIndex;
+        };
+
+        TLSFAllocator(uint64_t capacity, uint64_t granularity = 256);
+
+        std::optional<Allocation> Allocate(uint64_t size, uint64_t alignment = 1);
+        void Deallocate(const Allocation& allocation);
+
+    private:
+        static constexpr uint32_t InvalidBlockIndex = std::numeric_limits<uint32_t>::max();
+        static constexpr uint32_t SecondLevelIndexLog2 = 5;
+        static constexpr uint32_t SecondLevelIndexCount = 1 << SecondLevelIndexLog2;
+        static constexpr uint32_t FirstLevelIndexCount = 64 - SecondLevelIndexLog2 + 1;
+
+        struct Block
+        {
+            uint64_t Offset = 0;
+            uint64_t Size = 0;
+            uint32_t PreviousPhysicalBlock = InvalidBlockIndex;
+            uint32_t NextPhysicalBlock = InvalidBlockIndex;
+            uint32_t PreviousFreeBlock = InvalidBlockIndex;
+            uint32_t NextFreeBlock = InvalidBlockIndex;
+            bool IsFree = false;
+        };
+
+        struct ListIndex
+        {
+            uint32_t FirstLevel = 0;
+            uint32_t SecondLevel = 0;
+        };
+
+        ListIndex MapSizeToListIndex(uint64_t size) const;
+        ListIndex MapSizeToSearchListIndex(uint64_t size) const;
+        std::optional<ListIndex> FindSuitableList(const ListIndex& startIndex) const;
+
+        uint32_t CreateBlock(uint64_t offset, uint64_t size);
+        void DestroyBlock(uint32_t blockIndex);
+        void InsertFreeBlock(uint32_t blockIndex);
+        void RemoveFreeBlock(uint32_t blockIndex);
+        uint32_t SplitBlock(uint32_t blockIndex, uint64_t firstPartSize);
+        uint32_t MergeBlocks(uint32_t leftBlockIndex, uint32_t rightBlockIndex);
+
+        static uint32_t FindLowestSetBit(uint64_t value);
+        static uint32_t FindHighestSetBit(uint64_t value);
+
+        std::vector<Block> mBlocks;
+        std::vector<uint32_t> mUnusedBlockIndices;
+
+        uint64_t mFirstLevelBitmap = 0;
+        std::array<uint32_t, FirstLevelIndexCount> mSecondLevelBitmaps{};
+        std::array<std::array<uint32_t, SecondLevelIndexCount>, FirstLevelIndexCount> mFreeLists;
+
+        uint64_t mCapacity = 0;
+        uint64_t mGranularity = 1;
+        uint64_t mAllocatedSize = 0;
+        uint64_t mAllocationCount = 0;
+
+    public:
+        inline auto Capacity() const { return mCapacity; }
+        inline auto AllocatedSize() const { return mAllocatedSize; }
+        inline auto AllocationCount() const { return mAllocationCount; }
+        inline bool IsEmpty() const { return mAllocationCount == 0; }
+    };
+
+}
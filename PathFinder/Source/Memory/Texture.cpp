@@ -7,7 +7,7 @@ namespace Memory
     Texture::Texture(
         const HAL::TextureProperties& properties, 
         ResourceStateTracker* stateTracker,
-        SegregatedPoolsResourceAllocator* resourceAllocator, 
+        PlacedResourceAllocator* resourceAllocator, 
         PoolDescriptorAllocator* descriptorAllocator,
         CopyRequestManager* copyRequestManager)
         :
@@ -24,7 +24,7 @@ namespace Memory
     Texture::Texture(
         const HAL::TextureProperties& properties, 
         ResourceStateTracker* stateTracker, 
-        SegregatedPoolsResourceAllocator* resourceAllocator, 
+        PlacedResourceAllocator* resourceAllocator, 
         PoolDescriptorAllocator* descriptorAllocator, 
         CopyRequestManager* copyRequestManager,
         const HAL::Device& device, 
@@ -34,7 +34,7 @@ namespace Memory
         GPUResource(AccessStrategy::Automatic, stateTracker, resourceAllocator, descriptorAllocator, copyRequestManager),
         mProperties{ properties }
     {
-        mTexturePtr = SegregatedPoolsResourceAllocator::TexturePtr{
+        mTexturePtr = PlacedResourceAllocator::TexturePtr{
            new HAL::Texture{ device, mainResourceExplicitHeap, explicitHeapOffset, properties },
            [](HAL::Texture* texture) { delete texture; }
         };
@@ -47,7 +47,7 @@ namespace Memory
 
     Texture::Texture(
         ResourceStateTracker* stateTracker, 
-        SegregatedPoolsResourceAllocator* resourceAllocator, 
+        PlacedResourceAllocator* resourceAllocator, 
         PoolDescriptorAllocator* descriptorAllocator, 
         CopyRequestManager* copyRequestManager,
         HAL::Texture* existingTexture)
@@ -59,7 +59,7 @@ namespace Memory
             existingTexture->InitialStates(), existingTexture->ExpectedStates()
         }
     {
-        mTexturePtr = SegregatedPoolsResourceAllocator::TexturePtr{ existingTexture, [](HAL::Texture* texture) {} };
+        mTexturePtr = PlacedResourceAllocator::TexturePtr{ existingTexture, [](HAL::Texture* texture) {} };
 
         if (mStateTracker) 
             mStateTracker->StartTrakingResource(mTexturePtr.get());
@@ -150,7 +150,7 @@ namespace Memory
 
             for (const HAL::SubresourceFootprint& subresourceFootprint : footprint.SubresourceFootprints())
             {
-                cmdList.CopyBufferToTexture(*CurrentFrameUploadBuffer(), *HALTexture(), subresourceFootprint);
+                cmdList.CopyBufferToTexture(*CurrentFrameUploadBuffer(), *HALTexture(), subresourceFootprint, CurrentFrameUploadBufferOffset());
             }
         };
     }
@@ -15,14 +15,14 @@ namespace Memory
         Texture(
             const HAL::TextureProperties& properties, 
             ResourceStateTracker* stateTracker,
-            SegregatedPoolsResourceAllocator* resourceAllocator,
+            PlacedResourceAllocator* resourceAllocator,
             PoolDescriptorAllocator* descriptorAllocator,
             CopyRequestManager* copyRequestManager);
 
         Texture(
             const HAL::TextureProperties& properties,
             ResourceStateTracker* stateTracker,
-            SegregatedPoolsResourceAllocator* resourceAllocator,
+            PlacedResourceAllocator* resourceAllocator,
             PoolDescriptorAllocator* descriptorAllocator,
             CopyRequestManager* copyRequestManager,
             const HAL::Device& device,
@@ -31,7 +31,7 @@ namespace Memory
 
         Texture(
             ResourceStateTracker* stateTracker,
-            SegregatedPoolsResourceAllocator* resourceAllocator,
+            PlacedResourceAllocator* resourceAllocator,
             PoolDescriptorAllocator* descriptorAllocator,
             CopyRequestManager* copyRequestManager,
             HAL::Texture* existingTexture);
@@ -56,7 +56,7 @@ namespace Memory
         void ReserveDiscriptorArrays(uint8_t mipCount);
 
     private:
-        SegregatedPoolsResourceAllocator::TexturePtr mTexturePtr;
+        PlacedResourceAllocator::TexturePtr mTexturePtr;
         HAL::TextureProperties mProperties;
         
         mutable std::optional<HAL::ResourceFootprint> mFootprint;
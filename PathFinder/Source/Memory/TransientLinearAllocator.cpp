@@ -0,0 +1,72 @@
+#include "TransientLinearAllocator.hpp"
+
+#include <Foundation/MemoryUtils.hpp>
+
+#include <algorithm>
+
+namespace Memory
+{
+
+    TransientLinearAllocator::TransientLinearAllocator(uint8_t* mappedMemory, HAL::GPUAddress gpuAddress, uint64_t capacity, uint64_t pageSize)
+        : mMappedMemory{ mappedMemory },
+        mGPUAddress{ gpuAddress },
+        mRing{ capacity }, 
+        mPageSize{ Foundation::MemoryUtils::Align(pageSize, ConstantBufferAlignment) } {}
+
+    std::optional<TransientLinearAllocator::Allocation> TransientLinearAllocator::Allocate(Context& context, uint64_t size, uint64_t alignment)
+    {
+        assert_format((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+        uint64_t generation = mFrameGeneration.load(std::memory_order_acquire);
+        uint64_t offset = Foundation::MemoryUtils::Align(context.mCursor, alignment);
+
+        if (context.mFrameGeneration != generation || offset + size > context.mPageEnd)
+        {
+            // Extra alignment space guarantees that the allocation fits into a page at any alignment
+            if (!AllocatePage(context, size + alignment, generation))
+            {
+                return std::nullopt;
+            }
+
+            offset = Foundation::MemoryUtils::Align(context.mCursor, alignment);
+        }
+
+        context.mCursor = offset + size;
+
+        return Allocation{ mGPUAddress + offset, mMappedMemory + offset };
+    }
+
+    void TransientLinearAllocator::FinishCurrentFrame(uint64_t frameNumber)
+    {
+        std::lock_guard lock{ mAccessMutex };
+        mRing.FinishCurrentFrame(frameNumber);
+        mFrameGeneration.fetch_add(1, std::memory_order_release);
+    }
+
+    void TransientLinearAllocator::EndFrame(uint64_t completedFrameNumber)
+    {
+        std::lock_guard lock{ mAccessMutex };
+        mRing.ReleaseCompletedFrames(completedFrameNumber);
+    }
+
+    bool TransientLinearAllocator::AllocatePage(Context& context, uint64_t minSize, uint64_t generation)
+    {
+        uint64_t pageSize = std::max(mPageSize, Foundation::MemoryUtils::Align(minSize, ConstantBufferAlignment));
+
+        std::lock_guard lock{ mAccessMutex };
+
+        Ring::OffsetType offset = mRing.Allocate(pageSize, ConstantBufferAlignment);
+
+        if (offset == Ring::InvalidOffset)
+        {
+            return false;
+        }
+
+        context.mPageEnd = offset + pageSize;
+        context.mCursor = offset;
+        context.mFrameGeneration = generation;
+
+        return true;
+    }
+
+}
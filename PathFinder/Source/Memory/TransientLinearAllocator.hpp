@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Ring.hpp"
+
+#include <HardwareAbstractionLayer/Types.hpp>
+
+#include <optional>
+#include <mutex>
+#include <atomic>
+
+namespace Memory
+{
+
+    // Persistently mapped upload heap memory for data that lives for a single frame, like constant buffers.
+    // Every recording thread bump-allocates from a page it owns without locking. Pages are taken from a shared ring
+    // and memory of a frame is reclaimed all at once when the frame fence passes the value the frame was finished with.
+    // Buffer is owned elsewhere, the allocator only needs its mapped memory and GPU address.
+    class TransientLinearAllocator
+    {
+    public:
+        struct Allocation
+        {
+            HAL::GPUAddress GPUAddress = 0;
+            uint8_t* CPUAddress = nullptr;
+        };
+
+        // Allocation state of a single thread. Contexts must not be used by several threads simultaneously.
+        class Context
+        {
+        private:
+            friend TransientLinearAllocator;
+
+            uint64_t mPageEnd = 0;
+            uint64_t mCursor = 0;
+
+            // Pages of already finished frames are never reused
+            uint64_t mFrameGeneration = 0;
+        };
+
+        static constexpr uint64_t ConstantBufferAlignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+
+        TransientLinearAllocator(uint8_t* mappedMemory, HAL::GPUAddress gpuAddress, uint64_t capacity, uint64_t pageSize = 64 * 1024);
+
+        // Empty if memory is exhausted until in-flight frames complete
+        std::optional<Allocation> Allocate(Context& context, uint64_t size, uint64_t alignment = ConstantBufferAlignment);
+
+        // Associate allocations made so far with a fence value they're going to be consumed by
+        void FinishCurrentFrame(uint64_t frameNumber);
+        void EndFrame(uint64_t completedFrameNumber);
+
+    private:
+        bool AllocatePage(Context& context, uint64_t minSize, uint64_t generation);
+
+        uint8_t* mMappedMemory = nullptr;
+        HAL::GPUAddress mGPUAddress = 0;
+        Ring mRing;
+        uint64_t mPageSize = 0;
+        std::atomic<uint64_t> mFrameGeneration = 1;
+        std::mutex mAccessMutex;
+
+    public:
+        inline uint64_t Capacity() const { return mRing.MaxSize(); }
+        inline uint64_t PageSize() const { return mPageSize; }
+    };
+
+}
@@ -0,0 +1,278 @@
+#include "AsyncComputeScheduler.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <bitset>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        constexpr RenderPassGraph::Node::QueueIndex GraphicsQueueIndex = std::underlying_type_t<RenderPassExecutionQueue>(RenderPassExecutionQueue::Graphics);
+        constexpr RenderPassGraph::Node::QueueIndex AsyncComputeQueueIndex = std::underlying_type_t<RenderPassExecutionQueue>(RenderPassExecutionQueue::AsyncCompute);
+        constexpr uint64_t QueueCount = 2;
+    }
+
+    AsyncComputeScheduler::AsyncComputeScheduler(float fenceCostSeconds)
+        : mFenceCostSeconds{ fenceCostSeconds } {}
+
+    void AsyncComputeScheduler::AddPassTiming(Foundation::Name passName, float durationSeconds)
+    {
+        // Events that are not completed yet report zero duration
+        if (durationSeconds <= 0.0f)
+            return;
+
+        PassTiming& timing = mPassTimings[passName];
+
+        timing.SmoothedDurationSeconds = timing.SampleCount == 0 ?
+            durationSeconds :
+            timing.SmoothedDurationSeconds + (durationSeconds - timing.SmoothedDurationSeconds) * TimingSmoothingFactor;
+
+        ++timing.SampleCount;
+    }
+
+    void AsyncComputeScheduler::AssignQueues(RenderPassGraph& graph) const
+    {
+        for (RenderPassGraph::Node& node : graph.Nodes())
+        {
+            if (!node.IsAsyncComputeEligible)
+                continue;
+
+            auto decisionIt = mQueueDecisions.find(node.PassMetadata().Name);
+
+            if (decisionIt != mQueueDecisions.end())
+            {
+                node.ExecutionQueueIndex = decisionIt->second;
+            }
+        }
+    }
+
+    void AsyncComputeScheduler::EndFrame(const RenderPassGraph& graph)
+    {
+        if (++mFramesSinceEvaluation < EvaluationPeriodInFrames)
+            return;
+
+        mFramesSinceEvaluation = 0;
+        Evaluate(graph);
+    }
+
+    bool AsyncComputeScheduler::Evaluate(const RenderPassGraph& graph)
+    {
+        CostModelInput input;
+
+        if (!GatherCostModelInput(graph, input))
+            return false;
+
+        const RenderPassGraph::NodeList& nodes = graph.Nodes();
+        QueueAssignment currentAssignment(nodes.size());
+        QueueAssignment bestAssignment(nodes.size());
+
+        // Descend from a state where every eligible pass is on graphics queue,
+        // so that result doesn't depend on whatever was chosen previously
+        for (auto nodeIdx = 0; nodeIdx < nodes.size(); ++nodeIdx)
+        {
+            currentAssignment[nodeIdx] = nodes[nodeIdx].ExecutionQueueIndex;
+            bestAssignment[nodeIdx] = input.EligiblePasses[nodeIdx] ? GraphicsQueueIndex : nodes[nodeIdx].ExecutionQueueIndex;
+        }
+
+        std::vector<std::vector<uint64_t>> moveCandidates = BuildMoveCandidates(input);
+        QueueAssignment trialAssignment = bestAssignment;
+        float bestCost = EstimateFrameCost(input, bestAssignment);
+
+        for (;;)
+        {
+            const std::vector<uint64_t>* bestMove = nullptr;
+            RenderPassGraph::Node::QueueIndex bestMoveQueue = GraphicsQueueIndex;
+            float bestMoveCost = bestCost;
+
+            for (const std::vector<uint64_t>& move : moveCandidates)
+            {
+                RenderPassGraph::Node::QueueIndex targetQueue =
+                    bestAssignment[move.front()] == GraphicsQueueIndex ? AsyncComputeQueueIndex : GraphicsQueueIndex;
+
+                for (uint64_t nodeIdx : move) trialAssignment[nodeIdx] = targetQueue;
+
+                float cost = EstimateFrameCost(input, trialAssignment);
+
+                if (cost < bestMoveCost)
+                {
+                    bestMoveCost = cost;
+                    bestMove = &move;
+                    bestMoveQueue = targetQueue;
+                }
+
+                for (uint64_t nodeIdx : move) trialAssignment[nodeIdx] = bestAssignment[nodeIdx];
+            }
+
+            // Cost strictly decreases with every applied move, so the search always terminates
+            if (!bestMove)
+                break;
+
+            for (uint64_t nodeIdx : *bestMove)
+            {
+                bestAssignment[nodeIdx] = bestMoveQueue;
+                trialAssignment[nodeIdx] = bestMoveQueue;
+            }
+
+            bestCost = bestMoveCost;
+        }
+
+        if (bestAssignment == currentAssignment)
+            return false;
+
+        float currentCost = EstimateFrameCost(input, currentAssignment);
+
+        if (bestCost > currentCost * (1.0f - MinRelativeImprovement))
+            return false;
+
+        for (auto nodeIdx = 0; nodeIdx < nodes.size(); ++nodeIdx)
+        {
+            if (input.EligiblePasses[nodeIdx])
+            {
+                mQueueDecisions[nodes[nodeIdx].PassMetadata().Name] = bestAssignment[nodeIdx];
+            }
+        }
+
+        return true;
+    }
+
+    float AsyncComputeScheduler::EstimateFrameCost(const RenderPassGraph& graph, const QueueAssignment& assignment) const
+    {
+        CostModelInput input;
+        bool hasTimings = GatherCostModelInput(graph, input);
+        assert_format(hasTimings, "Cost can only be estimated when every pass has enough timing samples");
+        return EstimateFrameCost(input, assignment);
+    }
+
+    bool AsyncComputeScheduler::GatherCostModelInput(const RenderPassGraph& graph, CostModelInput& input) const
+    {
+        const RenderPassGraph::NodeList& nodes = graph.Nodes();
+        const auto& adjacencyLists = graph.NodeAdjacencyLists();
+
+        // Graph has to be compiled for dependency levels to be known
+        if (graph.DependencyLevels().empty() || adjacencyLists.size() != nodes.size())
+            return false;
+
+        input.PassCosts.resize(nodes.size(), 0.0f);
+        input.PassLevels.resize(nodes.size(), 0);
+        input.EligiblePasses.resize(nodes.size(), false);
+        input.LevelCount = graph.DependencyLevels().size();
+
+        for (auto nodeIdx = 0; nodeIdx < nodes.size(); ++nodeIdx)
+        {
+            const RenderPassGraph::Node& node = nodes[nodeIdx];
+
+            // Nodes without dependencies are culled from execution
+            if (!node.HasAnyDependencies())
+                continue;
+
+            auto timingIt = mPassTimings.find(node.PassMetadata().Name);
+
+            if (timingIt == mPassTimings.end() || timingIt->second.SampleCount < MinSampleCountToEvaluate)
+                return false;
+
+            input.PassCosts[nodeIdx] = timingIt->second.SmoothedDurationSeconds;
+            input.PassLevels[nodeIdx] = node.DependencyLevelIndex();
+            input.EligiblePasses[nodeIdx] = node.IsAsyncComputeEligible;
+
+            for (uint64_t dependentNodeIdx : adjacencyLists[nodeIdx])
+            {
+                input.Dependencies.emplace_back(nodeIdx, dependentNodeIdx);
+            }
+        }
+
+        return true;
+    }
+
+    float AsyncComputeScheduler::EstimateFrameCost(const CostModelInput& input, const QueueAssignment& assignment) const
+    {
+        mLevelQueueCosts.assign(input.LevelCount * QueueCount, 0.0f);
+        mWaitedQueueMasks.assign(assignment.size(), 0);
+
+        for (auto nodeIdx = 0; nodeIdx < assignment.size(); ++nodeIdx)
+        {
+            assert_format(assignment[nodeIdx] < QueueCount, "Cost model only supports graphics and async compute queues");
+            mLevelQueueCosts[input.PassLevels[nodeIdx] * QueueCount + assignment[nodeIdx]] += input.PassCosts[nodeIdx];
+        }
+
+        float cost = 0.0f;
+
+        // Passes of a dependency level are independent, so queues process them in parallel
+        for (auto levelIdx = 0; levelIdx < input.LevelCount; ++levelIdx)
+        {
+            const float* queueCosts = &mLevelQueueCosts[levelIdx * QueueCount];
+            cost += *std::max_element(queueCosts, queueCosts + QueueCount);
+        }
+
+        // A pass waits once for each other queue it depends on,
+        // which is what graph leaves after culling redundant synchronizations
+        for (auto [producerIdx, consumerIdx] : input.Dependencies)
+        {
+            if (assignment[producerIdx] != assignment[consumerIdx])
+            {
+                mWaitedQueueMasks[consumerIdx] |= 1 << assignment[producerIdx];
+            }
+        }
+
+        uint64_t fenceCount = 0;
+
+        for (uint8_t mask : mWaitedQueueMasks)
+        {
+            fenceCount += std::bitset<8>{ mask }.count();
+        }
+
+        return cost + fenceCount * mFenceCostSeconds;
+    }
+
+    std::vector<std::vector<uint64_t>> AsyncComputeScheduler::BuildMoveCandidates(const CostModelInput& input) const
+    {
+        std::vector<std::vector<uint64_t>> candidates;
+        std::vector<uint64_t> componentRoots(input.EligiblePasses.size());
+        std::iota(componentRoots.begin(), componentRoots.end(), 0);
+
+        auto findRoot = [&componentRoots](uint64_t nodeIdx)
+        {
+            while (componentRoots[nodeIdx] != nodeIdx)
+            {
+                componentRoots[nodeIdx] = componentRoots[componentRoots[nodeIdx]];
+                nodeIdx = componentRoots[nodeIdx];
+            }
+
+            return nodeIdx;
+        };
+
+        for (auto [producerIdx, consumerIdx] : input.Dependencies)
+        {
+            if (input.EligiblePasses[producerIdx] && input.EligiblePasses[consumerIdx])
+            {
+                componentRoots[findRoot(producerIdx)] = findRoot(consumerIdx);
+            }
+        }
+
+        robin_hood::unordered_flat_map<uint64_t, std::vector<uint64_t>> components;
+
+        for (auto nodeIdx = 0; nodeIdx < input.EligiblePasses.size(); ++nodeIdx)
+        {
+            if (input.EligiblePasses[nodeIdx])
+            {
+                candidates.push_back({ uint64_t(nodeIdx) });
+                components[findRoot(nodeIdx)].push_back(nodeIdx);
+            }
+        }
+
+        for (auto nodeIdx = 0; nodeIdx < input.EligiblePasses.size(); ++nodeIdx)
+        {
+            auto componentIt = components.find(nodeIdx);
+
+            // Visit components in node order to keep the search deterministic
+            if (componentIt != components.end() && componentIt->second.size() > 1)
+            {
+                candidates.push_back(std::move(componentIt->second));
+            }
+        }
+
+        return candidates;
+    }
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "RenderPassGraph.hpp"
+
+#include <Foundation/Name.hpp>
+
+#include <robinhood/robin_hood.h>
+
+#include <vector>
+
+namespace PathFinder
+{
+
+    // Decides which of the passes allowed to run on async compute queue actually go there.
+    //
+    // Frame cost is estimated as a sum of dependency level costs, where level costs as much as its busiest queue,
+    // plus a fixed cost for every cross-queue wait. Pass costs are smoothed GPU timings of previous frames.
+    // Dependency levels do not depend on queue assignment, so structure of an already compiled graph
+    // is used to choose queues for the frames that follow.
+    class AsyncComputeScheduler
+    {
+    public:
+        using QueueAssignment = std::vector<RenderPassGraph::Node::QueueIndex>;
+
+        AsyncComputeScheduler(float fenceCostSeconds = 50e-6f);
+
+        void AddPassTiming(Foundation::Name passName, float durationSeconds);
+
+        // Overrides queues of eligible nodes with decisions made so far.
+        // Must be called after resource scheduling and before graph is built.
+        void AssignQueues(RenderPassGraph& graph) const;
+
+        // Periodically re-evaluates assignment using a compiled graph
+        void EndFrame(const RenderPassGraph& graph);
+
+        // Chooses queues for eligible passes of a compiled graph.
+        // Returns false if assignment didn't change or timings are not available for every pass yet.
+        bool Evaluate(const RenderPassGraph& graph);
+
+        // Estimated GPU time of a compiled graph with passes (in Nodes() order) put on specified queues
+        float EstimateFrameCost(const RenderPassGraph& graph, const QueueAssignment& assignment) const;
+
+    private:
+        struct PassTiming
+        {
+            float SmoothedDurationSeconds = 0.0f;
+            uint64_t SampleCount = 0;
+        };
+
+        struct CostModelInput
+        {
+            std::vector<float> PassCosts;
+            std::vector<uint64_t> PassLevels;
+            std::vector<bool> EligiblePasses;
+            std::vector<std::pair<uint64_t, uint64_t>> Dependencies;
+            uint64_t LevelCount = 0;
+        };
+
+        static constexpr float TimingSmoothingFactor = 0.1f;
+        static constexpr uint64_t MinSampleCountToEvaluate = 30;
+        static constexpr uint64_t EvaluationPeriodInFrames = 60;
+
+        // New assignment has to be noticeably better to be applied,
+        // otherwise measurement noise would make passes jump between queues
+        static constexpr float MinRelativeImprovement = 0.01f;
+
+        bool GatherCostModelInput(const RenderPassGraph& graph, CostModelInput& input) const;
+        float EstimateFrameCost(const CostModelInput& input, const QueueAssignment& assignment) const;
+
+        // Eligible passes connected by dependencies are moved between queues together as well as alone,
+        // because moving only a part of a chain usually adds fences instead of removing them
+        std::vector<std::vector<uint64_t>> BuildMoveCandidates(const CostModelInput& input) const;
+
+        float mFenceCostSeconds;
+        uint64_t mFramesSinceEvaluation = 0;
+        robin_hood::unordered_flat_map<Foundation::Name, PassTiming> mPassTimings;
+        robin_hood::unordered_flat_map<Foundation::Name, RenderPassGraph::Node::QueueIndex> mQueueDecisions;
+
+        // Scratch memory reused between cost evaluations
+        mutable std::vector<float> mLevelQueueCosts;
+        mutable std::vector<uint8_t> mWaitedQueueMasks;
+
+    public:
+        inline const auto& QueueDecisions() const { return mQueueDecisions; }
+    };
+
+}
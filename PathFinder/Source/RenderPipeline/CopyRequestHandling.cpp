@@ -46,6 +46,40 @@ namespace PathFinder
         copyManager.FlushUploadRequests();
     }
 
+    void RecordUploadRequests(
+        HAL::CopyCommandListBase& copyQueueCmdList,
+        HAL::CopyCommandListBase& cmdList,
+        Memory::ResourceStateTracker& stateTracker,
+        Memory::CopyRequestManager& copyManager,
+        bool applyBackTransition)
+    {
+        std::vector<Memory::CopyRequestManager::CopyRequest> requests;
+
+        for (Memory::CopyRequestManager::CopyRequest& copyRequest : copyManager.UploadRequests())
+        {
+            bool canUseCopyQueue = copyRequest.Resource->CanImplicitlyPromoteFromCommonStateToState(HAL::ResourceState::CopyDestination);
+
+            for (const Memory::ResourceStateTracker::SubresourceState& subresourceState : stateTracker.ResourceCurrentStates(copyRequest.Resource))
+            {
+                canUseCopyQueue = canUseCopyQueue && subresourceState.State == HAL::ResourceState::Common;
+            }
+
+            // Resources in Common state are promoted to CopyDestination by the copy itself and decay back to Common
+            // when copy queue work completes, so neither barriers nor tracked state updates are required for them
+            if (canUseCopyQueue)
+            {
+                copyRequest.Command(copyQueueCmdList);
+            }
+            else
+            {
+                requests.push_back(std::move(copyRequest));
+            }
+        }
+
+        RecordCopyRequests(cmdList, stateTracker, requests, HAL::ResourceState::CopyDestination, applyBackTransition);
+        copyManager.FlushUploadRequests();
+    }
+
     void RecordReadbackRequests(HAL::CopyCommandListBase& cmdList, Memory::ResourceStateTracker& stateTracker, Memory::CopyRequestManager& copyManager, bool applyBackTransition)
     {
         RecordCopyRequests(cmdList, stateTracker, copyManager.ReadbackRequests(), HAL::ResourceState::CopySource, applyBackTransition);
@@ -7,6 +7,15 @@ namespace PathFinder
 {
 
     void RecordUploadRequests(HAL::CopyCommandListBase& cmdList, Memory::ResourceStateTracker& stateTracker, Memory::CopyRequestManager& copyManager, bool applyBackTransition);
+
+    // Uploads that don't require state transitions are recorded into copyQueueCmdList, the rest into cmdList
+    void RecordUploadRequests(
+        HAL::CopyCommandListBase& copyQueueCmdList,
+        HAL::CopyCommandListBase& cmdList,
+        Memory::ResourceStateTracker& stateTracker,
+        Memory::CopyRequestManager& copyManager,
+        bool applyBackTransition);
+
     void RecordReadbackRequests(HAL::CopyCommandListBase& cmdList, Memory::ResourceStateTracker& stateTracker, Memory::CopyRequestManager& copyManager, bool applyBackTransition);
 
 }
@@ -8,8 +8,13 @@ namespace PathFinder
         mSimultaneousFramesInFlight{ simultaneousFramesInFlight },
         mResourceProducer{ resourceProducer }
     {
-        mCompletedEvents.resize(maxEventsPerFrame);
-        mEventInfos.resize(maxEventsPerFrame);
+        mCompletedEvents.reserve(maxEventsPerFrame);
+        mPerFrameEvents.resize(simultaneousFramesInFlight);
+
+        for (FrameEvents& frameEvents : mPerFrameEvents)
+        {
+            frameEvents.EventInfos.resize(maxEventsPerFrame);
+        }
     }
 
     void GPUProfiler::SetPerQueueTimestampFrequencies(const std::vector<uint64_t>& frequencies)
@@ -17,21 +22,24 @@ namespace PathFinder
         mPerQueueTimestampFrequencies = frequencies;
     }
 
-    GPUProfiler::EventID GPUProfiler::RecordEventStart(HAL::CommandList& cmdList, uint64_t queueIndex)
+    GPUProfiler::EventID GPUProfiler::RecordEventStart(HAL::CommandList& cmdList, uint64_t queueIndex, Foundation::Name name)
     {
         std::lock_guard lock{ mAccessMutex };
 
-        GPUProfiler::EventID index = mCurrentFrameEventID;
+        FrameEvents& frameEvents = mPerFrameEvents[mCurrentFrameIndex];
+        GPUProfiler::EventID index = frameEvents.EventCount;
 
-        assert_format(index < mEventInfos.size(), "Exceeded maximum per-frame event count");
+        assert_format(index < frameEvents.EventInfos.size(), "Exceeded maximum per-frame event count");
 
-        mEventInfos[index].IsStarted = true;
-        mEventInfos[index].TickFrequency = mPerQueueTimestampFrequencies[queueIndex];
+        EventInfo& eventInfo = frameEvents.EventInfos[index];
+        eventInfo.Name = name;
+        eventInfo.IsStarted = true;
+        eventInfo.TickFrequency = mPerQueueTimestampFrequencies[queueIndex];
 
         auto [start, end] = GetEventIndicesInHeap(index);
         cmdList.EndQuery(mQueryHeap, start);
 
-        ++mCurrentFrameEventID;
+        ++frameEvents.EventCount;
 
         return index;
     }
@@ -40,9 +48,11 @@ namespace PathFinder
     {
         std::lock_guard lock{ mAccessMutex };
 
-        assert_format(eventId < mEventInfos.size(), "Invalid event ID");
-        assert_format(mEventInfos[eventId].IsStarted, "Event was not started");
-        mEventInfos[eventId].IsCompleted = true;
+        FrameEvents& frameEvents = mPerFrameEvents[mCurrentFrameIndex];
+
+        assert_format(eventId < frameEvents.EventCount, "Invalid event ID");
+        assert_format(frameEvents.EventInfos[eventId].IsStarted, "Event was not started");
+        frameEvents.EventInfos[eventId].IsCompleted = true;
 
         auto [start, end] = GetEventIndicesInHeap(eventId);
         cmdList.EndQuery(mQueryHeap, end);
@@ -51,7 +61,7 @@ namespace PathFinder
     void GPUProfiler::ReadbackEvents(HAL::CommandList& cmdList)
     {
         uint64_t rangeStartIdx = GetHeapStartIndexForFrameIndex(mCurrentFrameIndex);
-        uint64_t requestedQueryCount = mCurrentFrameEventID * 2;
+        uint64_t requestedQueryCount = mPerFrameEvents[mCurrentFrameIndex].EventCount * 2;
 
         cmdList.ExtractQueryData(mQueryHeap, rangeStartIdx, requestedQueryCount, *mReadbackBuffer->HALBuffer());
     }
@@ -66,35 +76,42 @@ namespace PathFinder
         }
         
         mCurrentFrameIndex = frameNumber % mSimultaneousFramesInFlight;
+
+        // Events of the frame that used this index before are completed and gathered by now
+        FrameEvents& frameEvents = mPerFrameEvents[mCurrentFrameIndex];
+        frameEvents.FrameNumber = frameNumber;
+        frameEvents.EventCount = 0;
     }
 
-    void GPUProfiler::EndFrame(uint64_t frameNumber)
+    void GPUProfiler::EndFrame(uint64_t completedFrameNumber)
     {
         mReadbackBuffer->Read<uint64_t>([&](const uint64_t* ticks)
         {
             std::lock_guard lock{ mAccessMutex };
 
-            auto requestedEventCount = mCurrentFrameEventID;
-            mCurrentFrameEventID = 0;
+            // Readback buffer holds timestamps of the last completed frame, 
+            // which is not the one that was just recorded when several frames are in flight
+            FrameEvents& frameEvents = mPerFrameEvents[completedFrameNumber % mSimultaneousFramesInFlight];
 
-            if (!ticks)
+            if (!ticks || frameEvents.FrameNumber != completedFrameNumber)
                 return;
 
-            for (uint64_t eventIdx = 0; eventIdx < requestedEventCount; ++eventIdx)
+            mCompletedEvents.clear();
+
+            for (uint64_t eventIdx = 0; eventIdx < frameEvents.EventCount; ++eventIdx)
             {
                 uint64_t eventStartIndexInHeap = eventIdx * 2;
                 uint64_t eventEndIndexInHeap = eventStartIndexInHeap + 1;
 
-                EventInfo& eventInfo = mEventInfos[eventIdx];
+                EventInfo& eventInfo = frameEvents.EventInfos[eventIdx];
                 assert_format(!eventInfo.IsStarted || (eventInfo.IsStarted && eventInfo.IsCompleted), "Started event was not completed");
 
-                Event& event = mCompletedEvents[eventIdx];
                 uint64_t endTick = ticks[eventEndIndexInHeap];
                 uint64_t startTick = ticks[eventStartIndexInHeap];
 
                 //assert_format(endTick >= startTick, "Profiler ticks are messed up");
 
-                event.DurationSeconds = float(endTick - startTick) / eventInfo.TickFrequency;
+                mCompletedEvents.push_back(Event{ eventInfo.Name, float(endTick - startTick) / eventInfo.TickFrequency });
 
                 eventInfo.IsStarted = false;
                 eventInfo.IsCompleted = false;
@@ -102,9 +119,9 @@ namespace PathFinder
         });
     }
 
-    const GPUProfiler::Event& GPUProfiler::GetCompletedEvent(const GPUProfiler::EventID& eventId) const
+    const std::vector<GPUProfiler::Event>& GPUProfiler::CompletedEvents() const
     {
-        return mCompletedEvents[eventId];
+        return mCompletedEvents;
     }
 
     std::pair<uint64_t, uint64_t> GPUProfiler::GetEventIndicesInHeap(EventID id) const
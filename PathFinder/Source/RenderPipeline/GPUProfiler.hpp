@@ -3,6 +3,7 @@
 #include <Memory/GPUResourceProducer.hpp>
 #include <HardwareAbstractionLayer/QueryHeap.hpp>
 #include <HardwareAbstractionLayer/CommandList.hpp>
+#include <Foundation/Name.hpp>
 
 #include <mutex>
 
@@ -16,27 +17,41 @@ namespace PathFinder
 
         struct Event
         {
+            // Event IDs are only meaningful within the frame that recorded them,
+            // so completed events are told apart by names they were recorded with
+            Foundation::Name Name;
             float DurationSeconds;
         };
 
         GPUProfiler(const HAL::Device& device, uint64_t maxEventsPerFrame, uint64_t simultaneousFramesInFlight, Memory::GPUResourceProducer* resourceProducer);
 
         void SetPerQueueTimestampFrequencies(const std::vector<uint64_t>& frequencies);
-        EventID RecordEventStart(HAL::CommandList& cmdList, uint64_t queueIndex);
+        EventID RecordEventStart(HAL::CommandList& cmdList, uint64_t queueIndex, Foundation::Name name);
         void RecordEventEnd(HAL::CommandList& cmdList, const GPUProfiler::EventID& eventId);
         void ReadbackEvents(HAL::CommandList& cmdList);
         void BeginFrame(uint64_t frameNumber);
-        void EndFrame(uint64_t frameNumber);
-        const Event& GetCompletedEvent(const GPUProfiler::EventID& eventId) const;
+        void EndFrame(uint64_t completedFrameNumber);
+
+        // Events of the last frame completed by GPU in the order they were recorded
+        const std::vector<Event>& CompletedEvents() const;
 
     private:
         struct EventInfo
         {
+            Foundation::Name Name;
             bool IsStarted = false;
             bool IsCompleted = false;
             uint64_t TickFrequency = 1;
         };
 
+        // Events recorded by a frame that may still be in flight
+        struct FrameEvents
+        {
+            std::vector<EventInfo> EventInfos;
+            uint64_t FrameNumber = 0;
+            EventID EventCount = 0;
+        };
+
         std::pair<uint64_t, uint64_t> GetEventIndicesInHeap(EventID id) const;
         uint64_t GetHeapStartIndexForFrameIndex(uint64_t frameIndex) const;
         uint64_t HeapEventsPerFrameCount() const;
@@ -46,10 +61,9 @@ namespace PathFinder
         Memory::GPUResourceProducer::BufferPtr mReadbackBuffer;
         std::vector<uint64_t> mPerQueueTimestampFrequencies;
         std::vector<Event> mCompletedEvents;
-        std::vector<EventInfo> mEventInfos;
+        std::vector<FrameEvents> mPerFrameEvents;
         uint64_t mSimultaneousFramesInFlight = 1;
         uint64_t mCurrentFrameIndex = 0;
-        EventID mCurrentFrameEventID = 0;
         std::mutex mAccessMutex;
     };
 
@@ -0,0 +1,270 @@
+#include "MemoryAliasingSolver.hpp"
+
+#include <limits>
+#include <algorithm>
+#include <numeric>
+#include <set>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        // Local search passes are cheap, but layouts rarely improve after a couple of them
+        constexpr uint64_t MaxImprovementPasses = 4;
+    }
+
+    uint64_t MemoryAliasingSolver::PlaceAllocations(std::vector<Allocation>& allocations, Statistics* statistics)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        NeighborList neighbors = FindLifetimeIntersections(allocations);
+        uint64_t lowerBound = PeakLiveMemory(allocations);
+
+        auto lifetimeLength = [&allocations](uint32_t index) { return allocations[index].LifetimeEnd - allocations[index].LifetimeStart + 1; };
+        auto size = [&allocations](uint32_t index) { return allocations[index].Size; };
+
+        std::vector<uint32_t> baseOrder(allocations.size());
+        std::iota(baseOrder.begin(), baseOrder.end(), 0);
+
+        // Greedy placement quality depends on ordering a lot and no single ordering wins on every schedule.
+        // Large resources first is usually the best, long living ones first helps schedules with a lot of short lived temporaries.
+        std::vector<std::vector<uint32_t>> orders(4, baseOrder);
+
+        std::stable_sort(orders[0].begin(), orders[0].end(), [&](uint32_t a, uint32_t b)
+        {
+            return size(a) != size(b) ? size(a) > size(b) : lifetimeLength(a) > lifetimeLength(b);
+        });
+
+        std::stable_sort(orders[1].begin(), orders[1].end(), [&](uint32_t a, uint32_t b)
+        {
+            return lifetimeLength(a) != lifetimeLength(b) ? lifetimeLength(a) > lifetimeLength(b) : size(a) > size(b);
+        });
+
+        std::stable_sort(orders[2].begin(), orders[2].end(), [&](uint32_t a, uint32_t b)
+        {
+            return size(a) * lifetimeLength(a) > size(b) * lifetimeLength(b);
+        });
+
+        std::stable_sort(orders[3].begin(), orders[3].end(), [&](uint32_t a, uint32_t b)
+        {
+            const Allocation& first = allocations[a];
+            const Allocation& second = allocations[b];
+            return first.LifetimeStart != second.LifetimeStart ? first.LifetimeStart < second.LifetimeStart : first.Size > second.Size;
+        });
+
+        std::vector<Allocation> bestLayout;
+        uint64_t bestHeapSize = std::numeric_limits<uint64_t>::max();
+
+        for (const std::vector<uint32_t>& order : orders)
+        {
+            std::vector<Allocation> layout = allocations;
+            PlaceGreedily(layout, neighbors, order);
+
+            for (auto pass = 0u; pass < MaxImprovementPasses && HeapSize(layout) > lowerBound && LowerAllocations(layout, neighbors); ++pass);
+
+            uint64_t heapSize = HeapSize(layout);
+
+            if (heapSize < bestHeapSize)
+            {
+                bestHeapSize = heapSize;
+                bestLayout = std::move(layout);
+            }
+
+            // Can't do better than that
+            if (bestHeapSize == lowerBound)
+            {
+                break;
+            }
+        }
+
+        if (!allocations.empty())
+        {
+            allocations = std::move(bestLayout);
+        }
+
+        uint64_t heapSize = HeapSize(allocations);
+
+        if (statistics)
+        {
+            statistics->HeapSize = heapSize;
+            statistics->LowerBound = lowerBound;
+            statistics->WastedBytes = heapSize - statistics->LowerBound;
+            statistics->SolveTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+        }
+
+        return heapSize;
+    }
+
+    MemoryAliasingSolver::NeighborList MemoryAliasingSolver::FindLifetimeIntersections(const std::vector<Allocation>& allocations)
+    {
+        NeighborList neighbors(allocations.size());
+
+        std::vector<uint32_t> startOrder(allocations.size());
+        std::iota(startOrder.begin(), startOrder.end(), 0);
+        std::sort(startOrder.begin(), startOrder.end(), [&allocations](uint32_t a, uint32_t b)
+        {
+            return allocations[a].LifetimeStart < allocations[b].LifetimeStart;
+        });
+
+        // Sweep over lifetime starts. Allocations that are still alive when the next one starts intersect with it,
+        // allocations that already ended can't intersect with any of the following ones.
+        std::set<std::pair<uint64_t, uint32_t>> aliveAllocations;
+
+        for (uint32_t index : startOrder)
+        {
+            const Allocation& allocation = allocations[index];
+
+            while (!aliveAllocations.empty() && aliveAllocations.begin()->first < allocation.LifetimeStart)
+            {
+                aliveAllocations.erase(aliveAllocations.begin());
+            }
+
+            for (const auto& [lifetimeEnd, aliveIndex] : aliveAllocations)
+            {
+                neighbors[index].push_back(aliveIndex);
+                neighbors[aliveIndex].push_back(index);
+            }
+
+            aliveAllocations.emplace(allocation.LifetimeEnd, index);
+        }
+
+        return neighbors;
+    }
+
+    uint64_t MemoryAliasingSolver::PeakLiveMemory(const std::vector<Allocation>& allocations)
+    {
+        // Pass index and memory delta. Frees go before allocations of the same pass.
+        std::vector<std::pair<uint64_t, int64_t>> events;
+        events.reserve(allocations.size() * 2);
+
+        for (const Allocation& allocation : allocations)
+        {
+            events.emplace_back(allocation.LifetimeStart, int64_t(allocation.Size));
+            events.emplace_back(allocation.LifetimeEnd + 1, -int64_t(allocation.Size));
+        }
+
+        std::sort(events.begin(), events.end());
+
+        int64_t liveMemory = 0;
+        int64_t peakMemory = 0;
+
+        for (const auto& [passIndex, delta] : events)
+        {
+            liveMemory += delta;
+            peakMemory = std::max(peakMemory, liveMemory);
+        }
+
+        return peakMemory;
+    }
+
+    uint64_t MemoryAliasingSolver::HeapSize(const std::vector<Allocation>& allocations)
+    {
+        uint64_t heapSize = 0;
+
+        for (const Allocation& allocation : allocations)
+        {
+            heapSize = std::max(heapSize, allocation.Offset + allocation.Size);
+        }
+
+        return heapSize;
+    }
+
+    void MemoryAliasingSolver::PlaceGreedily(std::vector<Allocation>& allocations, const NeighborList& neighbors, const std::vector<uint32_t>& order)
+    {
+        std::vector<bool> isPlaced(allocations.size(), false);
+        std::vector<std::pair<uint64_t, uint64_t>> occupiedRanges;
+
+        for (uint32_t index : order)
+        {
+            allocations[index].Offset = FindOffset(allocations, neighbors[index], isPlaced, index, false, occupiedRanges);
+            isPlaced[index] = true;
+        }
+    }
+
+    bool MemoryAliasingSolver::LowerAllocations(std::vector<Allocation>& allocations, const NeighborList& neighbors)
+    {
+        std::vector<uint32_t> order(allocations.size());
+        std::iota(order.begin(), order.end(), 0);
+
+        // Highest allocations first, they are the ones defining heap size
+        std::sort(order.begin(), order.end(), [&allocations](uint32_t a, uint32_t b)
+        {
+            return allocations[a].Offset + allocations[a].Size > allocations[b].Offset + allocations[b].Size;
+        });
+
+        std::vector<bool> isPlaced(allocations.size(), true);
+        std::vector<std::pair<uint64_t, uint64_t>> occupiedRanges;
+        bool isLowered = false;
+
+        for (uint32_t index : order)
+        {
+            // Current offset is always a valid candidate, so allocation can only go down
+            uint64_t lowestOffset = FindOffset(allocations, neighbors[index], isPlaced, index, true, occupiedRanges);
+
+            if (lowestOffset < allocations[index].Offset)
+            {
+                allocations[index].Offset = lowestOffset;
+                isLowered = true;
+            }
+        }
+
+        return isLowered;
+    }
+
+    uint64_t MemoryAliasingSolver::FindOffset(
+        const std::vector<Allocation>& allocations,
+        const std::vector<uint32_t>& neighbors,
+        const std::vector<bool>& isPlaced,
+        uint64_t allocationIndex,
+        bool lowest,
+        std::vector<std::pair<uint64_t, uint64_t>>& occupiedRanges)
+    {
+        // Memory occupied by allocations that are alive at the same time as this one
+        occupiedRanges.clear();
+
+        for (uint32_t neighborIndex : neighbors)
+        {
+            if (isPlaced[neighborIndex] && neighborIndex != allocationIndex)
+            {
+                const Allocation& neighbor = allocations[neighborIndex];
+                occupiedRanges.emplace_back(neighbor.Offset, neighbor.Offset + neighbor.Size);
+            }
+        }
+
+        std::sort(occupiedRanges.begin(), occupiedRanges.end());
+
+        uint64_t allocationSize = allocations[allocationIndex].Size;
+        uint64_t bestOffset = std::numeric_limits<uint64_t>::max();
+        uint64_t bestGapSize = std::numeric_limits<uint64_t>::max();
+        uint64_t freeMemoryStart = 0;
+
+        for (const auto& [rangeStart, rangeEnd] : occupiedRanges)
+        {
+            if (rangeStart > freeMemoryStart)
+            {
+                uint64_t gapSize = rangeStart - freeMemoryStart;
+
+                if (allocationSize <= gapSize)
+                {
+                    if (lowest)
+                    {
+                        return freeMemoryStart;
+                    }
+
+                    if (gapSize < bestGapSize)
+                    {
+                        bestGapSize = gapSize;
+                        bestOffset = freeMemoryStart;
+                    }
+                }
+            }
+
+            freeMemoryStart = std::max(freeMemoryStart, rangeEnd);
+        }
+
+        // Memory above all neighbors is always free
+        return bestOffset != std::numeric_limits<uint64_t>::max() ? bestOffset : freeMemoryStart;
+    }
+
+}
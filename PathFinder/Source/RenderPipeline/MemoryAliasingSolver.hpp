@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+namespace PathFinder
+{
+    // Placement of memory aliased resources.
+    //
+    // Placement is an offset assignment problem on the interval graph of resource lifetimes:
+    // resources with intersecting lifetimes must not intersect in memory.
+    // Best-fit greedy placement is run for several orderings, the tightest layout is then
+    // improved by a bounded number of passes that drop each resource to the lowest offset it fits at.
+    //
+    // Doesn't depend on render graph or GPU objects, so captured schedules can be replayed offline.
+
+    class MemoryAliasingSolver
+    {
+    public:
+        struct Allocation
+        {
+            uint64_t Size = 0;
+
+            // Inclusive range of pass indices in global execution order
+            uint64_t LifetimeStart = 0;
+            uint64_t LifetimeEnd = 0;
+
+            // Output
+            uint64_t Offset = 0;
+        };
+
+        struct Statistics
+        {
+            uint64_t HeapSize = 0;
+
+            // Peak amount of memory required by resources alive at the same time.
+            // No placement can produce a heap smaller than that.
+            uint64_t LowerBound = 0;
+
+            // Heap bytes above the lower bound
+            uint64_t WastedBytes = 0;
+
+            std::chrono::microseconds SolveTime{ 0 };
+        };
+
+        // Assigns offsets to allocations, returns required heap size
+        static uint64_t PlaceAllocations(std::vector<Allocation>& allocations, Statistics* statistics = nullptr);
+
+    private:
+        using NeighborList = std::vector<std::vector<uint32_t>>;
+
+        static NeighborList FindLifetimeIntersections(const std::vector<Allocation>& allocations);
+        static uint64_t PeakLiveMemory(const std::vector<Allocation>& allocations);
+        static uint64_t HeapSize(const std::vector<Allocation>& allocations);
+
+        static void PlaceGreedily(std::vector<Allocation>& allocations, const NeighborList& neighbors, const std::vector<uint32_t>& order);
+        static bool LowerAllocations(std::vector<Allocation>& allocations, const NeighborList& neighbors);
+
+        // Returns offset of the smallest gap between placed neighbors that fits the allocation,
+        // or the lowest fitting offset when lowest is requested
+        static uint64_t FindOffset(
+            const std::vector<Allocation>& allocations,
+            const std::vector<uint32_t>& neighbors,
+            const std::vector<bool>& isPlaced,
+            uint64_t allocationIndex,
+            bool lowest,
+            std::vector<std::pair<uint64_t, uint64_t>>& occupiedRanges);
+    };
+
+}
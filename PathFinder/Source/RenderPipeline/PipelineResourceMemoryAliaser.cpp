@@ -1,7 +1,7 @@
 #include "PipelineResourceMemoryAliaser.hpp"
 
-#include <limits>
 #include <algorithm>
+#include <numeric>
 
 #include <Foundation/StringUtils.hpp>
 
@@ -9,46 +9,40 @@ namespace PathFinder
 {
 
     PipelineResourceMemoryAliaser::PipelineResourceMemoryAliaser(const RenderPassGraph* renderPassGraph)
-        : mRenderPassGraph{ renderPassGraph },
-        mSchedulingInfos{ &AliasingMetadata::SortDescending } {}
+        : mRenderPassGraph{ renderPassGraph } {}
 
     void PipelineResourceMemoryAliaser::AddSchedulingInfo(PipelineResourceSchedulingInfo* scheudlingInfo)
     {
-        mSchedulingInfos.emplace(scheudlingInfo);
+        mSchedulingInfos.push_back(scheudlingInfo);
     }
 
     uint64_t PipelineResourceMemoryAliaser::Alias()
     {
-        uint64_t optimalHeapSize = 0;
-
-        if (mSchedulingInfos.size() == 0) 
+        if (mSchedulingInfos.empty())
         {
             return 1;
         }
 
-        if (mSchedulingInfos.size() == 1)
-        {
-            mSchedulingInfos.begin()->SchedulingInfo->HeapOffset = 0;
-            optimalHeapSize = mSchedulingInfos.begin()->SchedulingInfo->TotalRequiredMemory();
-            return optimalHeapSize;
-        }
+        mAllocations.clear();
 
-        while (!mSchedulingInfos.empty())
+        for (const PipelineResourceSchedulingInfo* schedulingInfo : mSchedulingInfos)
         {
-            auto largestAllocationIt = mSchedulingInfos.begin();
-            mAvailableMemory = largestAllocationIt->SchedulingInfo->TotalRequiredMemory();
-            optimalHeapSize += mAvailableMemory;
-
-            for (auto schedulingInfoIt = largestAllocationIt; schedulingInfoIt != mSchedulingInfos.end(); ++schedulingInfoIt)
-            {
-                AliasWithAlreadyAliasedAllocations(schedulingInfoIt);
-            }
+            Allocation allocation{};
+            allocation.Size = schedulingInfo->TotalRequiredMemory();
+            allocation.LifetimeStart = schedulingInfo->AliasingLifetime.first;
+            allocation.LifetimeEnd = schedulingInfo->AliasingLifetime.second;
+            mAllocations.push_back(allocation);
+        }
 
-            RemoveAliasedAllocationsFromOriginalList();
+        uint64_t optimalHeapSize = MemoryAliasingSolver::PlaceAllocations(mAllocations, &mStatistics);
 
-            mGlobalStartOffset += mAvailableMemory;
+        for (auto allocationIdx = 0u; allocationIdx < mAllocations.size(); ++allocationIdx)
+        {
+            mSchedulingInfos[allocationIdx]->HeapOffset = mAllocations[allocationIdx].Offset;
         }
 
+        MarkAliasingBarriers();
+
         return optimalHeapSize == 0 ? 1 : optimalHeapSize;
     }
 
@@ -57,150 +51,51 @@ namespace PathFinder
         return mSchedulingInfos.empty();
     }
 
-    bool PipelineResourceMemoryAliaser::TimelinesIntersect(const PipelineResourceSchedulingInfo& first, const PipelineResourceSchedulingInfo& second) const
-    {
-        return first.AliasingLifetime.first <= second.AliasingLifetime.second &&
-            second.AliasingLifetime.first <= first.AliasingLifetime.second;
-    }
-
-    void PipelineResourceMemoryAliaser::FitAliasableMemoryRegion(const MemoryRegion& nextAliasableRegion, uint64_t nextAllocationSize, MemoryRegion& optimalRegion) const
-    {
-        bool nextRegionValid = nextAliasableRegion.Size > 0;
-        bool optimalRegionValid = optimalRegion.Size > 0;
-        bool nextRegionIsMoreOptimal = nextAliasableRegion.Size <= optimalRegion.Size || !nextRegionValid || !optimalRegionValid;
-        bool allocationFits = nextAllocationSize <= nextAliasableRegion.Size;
-
-        if (allocationFits && nextRegionIsMoreOptimal)
-        {
-            optimalRegion.Offset = nextAliasableRegion.Offset;
-            optimalRegion.Size = nextAllocationSize;
-        }
-    }
-
-    void PipelineResourceMemoryAliaser::FindCurrentBucketNonAliasableMemoryRegions(AliasingMetadataIterator nextSchedulingInfoIt)
+    void PipelineResourceMemoryAliaser::MarkAliasingBarriers()
     {
-        mNonAliasableMemoryOffsets.clear();
-        mNonAliasableMemoryOffsets.push_back({ 0, MemoryOffsetType::End });
-
-        // Find memory regions in which we can't place the next allocation, because their allocations
-        // are used simultaneously with the next one by some render passed (timelines)
-        for (AliasingMetadataIterator alreadyAliasedAllocationIt : mAlreadyAliasedAllocations)
-        {
-            if (TimelinesIntersect(*alreadyAliasedAllocationIt->SchedulingInfo, *nextSchedulingInfoIt->SchedulingInfo))
-            {
-                // Heap offset stored in AliasingInfo.HeapOffset is relative to heap beginning, 
-                // but the algorithm requires non-aliasable memory region to be 
-                // relative to current global offset, which is an offset of the current memory bucket we're aliasing resources in,
-                // therefore we have to subtract current global offset
-                uint64_t startByteIndex = alreadyAliasedAllocationIt->SchedulingInfo->HeapOffset - mGlobalStartOffset;
-                uint64_t endByteIndex = startByteIndex + alreadyAliasedAllocationIt->SchedulingInfo->TotalRequiredMemory();
-
-                mNonAliasableMemoryOffsets.push_back({ startByteIndex, MemoryOffsetType::Start });
-                mNonAliasableMemoryOffsets.push_back({ endByteIndex, MemoryOffsetType::End });
-            }
-        }
-
-        mNonAliasableMemoryOffsets.push_back({ mAvailableMemory, MemoryOffsetType::Start });
-
-        std::sort(mNonAliasableMemoryOffsets.begin(), mNonAliasableMemoryOffsets.end(), [](auto& offset1, auto& offset2) -> bool
+        std::vector<uint32_t> offsetOrder(mAllocations.size());
+        std::iota(offsetOrder.begin(), offsetOrder.end(), 0);
+        std::sort(offsetOrder.begin(), offsetOrder.end(), [this](uint32_t a, uint32_t b)
         {
-            return offset1.first < offset2.first;
+            return mAllocations[a].Offset < mAllocations[b].Offset;
         });
-    }
 
-    bool PipelineResourceMemoryAliaser::AliasAsFirstAllocation(AliasingMetadataIterator nextSchedulingInfoIt)
-    {
-        if (mAlreadyAliasedAllocations.empty() && nextSchedulingInfoIt->SchedulingInfo->TotalRequiredMemory() <= mAvailableMemory)
-        {
-            nextSchedulingInfoIt->SchedulingInfo->HeapOffset = mGlobalStartOffset;
-            mAlreadyAliasedAllocations.push_back(nextSchedulingInfoIt);
-            return true;
-        }
-
-        return false;
-    }
-
-    void PipelineResourceMemoryAliaser::AliasWithAlreadyAliasedAllocations(AliasingMetadataIterator nextSchedulingInfoIt)
-    {
-        // Bail out if there is nothing to alias with
-        if (AliasAsFirstAllocation(nextSchedulingInfoIt)) return;
-
-        FindCurrentBucketNonAliasableMemoryRegions(nextSchedulingInfoIt);
-
-        // Find memory regions in which we can place the next allocation based on previously found unavailable regions.
-        // Pick the most fitting region. If next allocation cannot be fit in any free region, skip it.
-        uint64_t nextAllocationSize = nextSchedulingInfoIt->SchedulingInfo->TotalRequiredMemory();
-        MemoryRegion mostFittingMemoryRegion{ 0, 0 };
-        int64_t overlapCounter = 0;
+        // Resources that share memory with any other resource need an aliasing barrier before their first use.
+        // A resource that is a single occupant of its memory region avoids the barrier.
+        std::vector<bool> sharesMemory(mAllocations.size(), false);
+        uint64_t precedingMemoryEnd = 0;
 
-        for (auto i = 0u; i < mNonAliasableMemoryOffsets.size() - 1; ++i)
+        for (auto i = 0u; i < offsetOrder.size(); ++i)
         {
-            const auto& [currentOffset, currentType] = mNonAliasableMemoryOffsets[i];
-            const auto& [nextOffset, nextType] = mNonAliasableMemoryOffsets[i + 1];
+            const Allocation& allocation = mAllocations[offsetOrder[i]];
+            uint64_t allocationEnd = allocation.Offset + allocation.Size;
 
-            overlapCounter += currentType == MemoryOffsetType::Start ? 1 : -1;
-            overlapCounter = std::max(overlapCounter, 0ll);
-
-            bool reachedAliasableRegion = 
-                overlapCounter == 0 && 
-                currentType == MemoryOffsetType::End && 
-                nextType == MemoryOffsetType::Start;
-
-            if (reachedAliasableRegion)
+            if (i > 0 && allocation.Offset < precedingMemoryEnd)
             {
-                MemoryRegion nextAliasableMemoryRegion{ currentOffset, nextOffset - currentOffset };
-                FitAliasableMemoryRegion(nextAliasableMemoryRegion, nextAllocationSize, mostFittingMemoryRegion);
+                sharesMemory[offsetOrder[i]] = true;
             }
-        }
 
-        // If we found a fitting aliasable memory region update allocation with an offset
-        if (mostFittingMemoryRegion.Size > 0)
-        {
-            // Offset calculations were made in a frame relative to the current memory bucket.
-            // Now we need to adjust it to be relative to the heap start.
-            nextSchedulingInfoIt->SchedulingInfo->HeapOffset = mGlobalStartOffset + mostFittingMemoryRegion.Offset;
-
-            PipelineResourceSchedulingInfo::PassInfo* firstPassInfo = GetFirstPassInfo(nextSchedulingInfoIt);
-            firstPassInfo->NeedsAliasingBarrier = true;
-
-            // We aliased something with the first resource in the current memory bucket
-            // so it's no longer a single occupant of this memory region, therefore it now
-            // needs an aliasing barrier. If the first resource is a single resource on this
-            // memory region then this code branch will never be hit and we will avoid a barrier for it.
-            firstPassInfo = GetFirstPassInfo(mAlreadyAliasedAllocations.front());
-            firstPassInfo->NeedsAliasingBarrier = true;
+            if (i + 1 < offsetOrder.size() && mAllocations[offsetOrder[i + 1]].Offset < allocationEnd)
+            {
+                sharesMemory[offsetOrder[i]] = true;
+            }
 
-            mAlreadyAliasedAllocations.push_back(nextSchedulingInfoIt);
+            precedingMemoryEnd = std::max(precedingMemoryEnd, allocationEnd);
         }
-    }
 
-    PipelineResourceSchedulingInfo::PassInfo* PipelineResourceMemoryAliaser::GetFirstPassInfo(AliasingMetadataIterator schedulingInfoIt) const
-    {
-        const RenderPassGraph::Node* firstNode = mRenderPassGraph->NodesInGlobalExecutionOrder().at(schedulingInfoIt->SchedulingInfo->AliasingLifetime.first);
-        return schedulingInfoIt->SchedulingInfo->GetInfoForPass(firstNode->PassMetadata().Name);
-    }
-
-    void PipelineResourceMemoryAliaser::RemoveAliasedAllocationsFromOriginalList()
-    {
-        for (AliasingMetadataIterator it : mAlreadyAliasedAllocations)
+        for (auto allocationIdx = 0u; allocationIdx < mAllocations.size(); ++allocationIdx)
         {
-            mSchedulingInfos.erase(it);
+            if (sharesMemory[allocationIdx])
+            {
+                GetFirstPassInfo(*mSchedulingInfos[allocationIdx])->NeedsAliasingBarrier = true;
+            }
         }
-
-        mAlreadyAliasedAllocations.clear();
-    }
-
-    PipelineResourceMemoryAliaser::AliasingMetadata::AliasingMetadata(PipelineResourceSchedulingInfo* schedulingInfo)
-        : SchedulingInfo{ schedulingInfo } {}
-
-    bool PipelineResourceMemoryAliaser::AliasingMetadata::SortAscending(const AliasingMetadata& first, const AliasingMetadata& second)
-    {
-        return first.SchedulingInfo->TotalRequiredMemory() < second.SchedulingInfo->TotalRequiredMemory();
     }
 
-    bool PipelineResourceMemoryAliaser::AliasingMetadata::SortDescending(const AliasingMetadata& first, const AliasingMetadata& second)
+    PipelineResourceSchedulingInfo::PassInfo* PipelineResourceMemoryAliaser::GetFirstPassInfo(PipelineResourceSchedulingInfo& schedulingInfo) const
     {
-        return first.SchedulingInfo->TotalRequiredMemory() > second.SchedulingInfo->TotalRequiredMemory();
+        const RenderPassGraph::Node* firstNode = mRenderPassGraph->NodesInGlobalExecutionOrder().at(schedulingInfo.AliasingLifetime.first);
+        return schedulingInfo.GetInfoForPass(firstNode->PassMetadata().Name);
     }
 
 }
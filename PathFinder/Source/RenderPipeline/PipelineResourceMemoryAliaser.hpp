@@ -6,17 +6,24 @@
 
 #include "PipelineResourceSchedulingInfo.hpp"
 #include "RenderPassGraph.hpp"
+#include "MemoryAliasingSolver.hpp"
 
-#include <set>
+#include <vector>
 
 namespace PathFinder
 {
     // Helper class to determine memory aliasing properties
     // https://levelup.gitconnected.com/gpu-memory-aliasing-45933681a15e
+    //
+    // Offsets are assigned by MemoryAliasingSolver, this class feeds it resource
+    // schedules and marks resources that need aliasing barriers.
 
     class PipelineResourceMemoryAliaser
     {
     public:
+        using Allocation = MemoryAliasingSolver::Allocation;
+        using Statistics = MemoryAliasingSolver::Statistics;
+
         PipelineResourceMemoryAliaser(const RenderPassGraph* renderPassGraph);
 
         void AddSchedulingInfo(PipelineResourceSchedulingInfo* schedulingInfo);
@@ -24,50 +31,19 @@ namespace PathFinder
         bool IsEmpty() const;
 
     private:
-        struct MemoryRegion
-        {
-            uint64_t Offset;
-            uint64_t Size;
-        };
-
-        enum class MemoryOffsetType
-        {
-            Start, End
-        };
-
-        using MemoryOffset = std::pair<uint64_t, MemoryOffsetType>;
-
-        struct AliasingMetadata
-        {
-            PipelineResourceSchedulingInfo* SchedulingInfo;
-
-            AliasingMetadata(PipelineResourceSchedulingInfo* schedulingInfo);
-    
-            static bool SortAscending(const AliasingMetadata& first, const AliasingMetadata& second);
-            static bool SortDescending(const AliasingMetadata& first, const AliasingMetadata& second);
-        };
+        void MarkAliasingBarriers();
+        PipelineResourceSchedulingInfo::PassInfo* GetFirstPassInfo(PipelineResourceSchedulingInfo& schedulingInfo) const;
 
-        using AliasingMetadataSet = std::multiset<AliasingMetadata, decltype(&AliasingMetadata::SortDescending)>;
-        using AliasingMetadataIterator = AliasingMetadataSet::iterator;
+        std::vector<PipelineResourceSchedulingInfo*> mSchedulingInfos;
+        std::vector<Allocation> mAllocations;
+        Statistics mStatistics;
 
-        bool TimelinesIntersect(const PipelineResourceSchedulingInfo& first, const PipelineResourceSchedulingInfo& second) const;
-        void FitAliasableMemoryRegion(const MemoryRegion& nextAliasableRegion, uint64_t nextAllocationSize, MemoryRegion& optimalRegion) const;
-        void FindCurrentBucketNonAliasableMemoryRegions(AliasingMetadataIterator nextSchedulingInfoIt);
-        bool AliasAsFirstAllocation(AliasingMetadataIterator nextSchedulingInfoIt);
-        void AliasWithAlreadyAliasedAllocations(AliasingMetadataIterator nextSchedulingInfoIt);
-        PipelineResourceSchedulingInfo::PassInfo* GetFirstPassInfo(AliasingMetadataIterator nextSchedulingInfoIt) const;
-        void RemoveAliasedAllocationsFromOriginalList();
-
-        std::vector<MemoryOffset> mNonAliasableMemoryOffsets;
-        std::vector<AliasingMetadataIterator> mAlreadyAliasedAllocations;
-        
-        // Memory offset of the current bucket in which aliasing is performed
-        uint64_t mGlobalStartOffset = 0;
-        uint64_t mAvailableMemory = 0;
-
-        AliasingMetadataSet mSchedulingInfos;
-        
         const RenderPassGraph* mRenderPassGraph;
+
+    public:
+        // Schedule of the last Alias() call, with offsets
+        inline const auto& Allocations() const { return mAllocations; }
+        inline const auto& LastStatistics() const { return mStatistics; }
     };
 
 }
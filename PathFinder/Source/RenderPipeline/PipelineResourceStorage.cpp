@@ -16,11 +16,13 @@ namespace PathFinder
         Memory::GPUResourceProducer* resourceProducer,
         Memory::PoolDescriptorAllocator* descriptorAllocator,
         Memory::ResourceStateTracker* stateTracker,
+        Memory::TransientLinearAllocator* transientAllocator,
         const RenderSurfaceDescription& defaultRenderSurface,
         const RenderPassGraph* passExecutionGraph)
         :
         mDevice{ device },
         mResourceStateTracker{ stateTracker },
+        mTransientAllocator{ transientAllocator },
         mRTDSMemoryAliaser{ passExecutionGraph },
         mNonRTDSMemoryAliaser{ passExecutionGraph },
         mUniversalMemoryAliaser{ passExecutionGraph },
@@ -73,13 +75,9 @@ namespace PathFinder
             mGlobalRootConstantsBuffer = mResourceProducer->NewBuffer(
                 HAL::BufferProperties::Create<uint8_t>(1024, 1, HAL::ResourceState::ConstantBuffer));
         }
-        
-        if (!mPerFrameRootConstantsBuffer)
-        {
-            mPerFrameRootConstantsBuffer = mResourceProducer->NewBuffer(
-                HAL::BufferProperties::Create<uint8_t>(1024, 1, HAL::ResourceState::ConstantBuffer),
-                Memory::GPUResource::AccessStrategy::DirectUpload);
-        }
+
+        // Frame constants are expected to be updated every frame, bind defaults until they are
+        UpdateFrameRootConstants(PerFrameRootConstants{});
             
         mPreviousFrameResources->clear();
         mPreviousFrameResourceMap->clear();
@@ -197,8 +195,19 @@ namespace PathFinder
     void PipelineResourceStorage::OptimizeScheduledResourceStates(const RenderPassGraph& passGraph)
     {
         // Tracking subresource infos where read state streak started, so that we could 
-        // accumulate consecutive read states until a write state is encountered
-        robin_hood::unordered_flat_map<RenderPassGraph::SubresourceName, PipelineResourceSchedulingInfo::SubresourceInfo*> firstReadingSubresourceInfos;
+        // accumulate consecutive read states until a write state is encountered.
+        // Subresources are addressed by resource data index and subresource offset instead of hashing subresource names.
+        // Aliases share resource data with the original resource, so history is not dropped due to name aliasing.
+        mSubresourceInfoOffsets.resize(mCurrentFrameResources->size());
+        uint64_t totalSubresourceCount = 0;
+
+        for (auto resourceIdx = 0u; resourceIdx < mCurrentFrameResources->size(); ++resourceIdx)
+        {
+            mSubresourceInfoOffsets[resourceIdx] = totalSubresourceCount;
+            totalSubresourceCount += mCurrentFrameResources->at(resourceIdx).SchedulingInfo.SubresourceCount();
+        }
+
+        mFirstReadingSubresourceInfos.assign(totalSubresourceCount, nullptr);
 
         for (const RenderPassGraph::DependencyLevel& dl : passGraph.DependencyLevels())
         {
@@ -211,8 +220,7 @@ namespace PathFinder
                     PipelineResourceStorageResource* resourceData = GetPerResourceData(resourceName);
                     PipelineResourceSchedulingInfo::PassInfo* passInfo = resourceData->SchedulingInfo.GetInfoForPass(passNode->PassMetadata().Name);
                     PipelineResourceSchedulingInfo::SubresourceInfo& subresourceInfo = *passInfo->SubresourceInfos[subresourceIndex];
-                    // Track the original resource name so that history is not dropped due to name aliasing
-                    RenderPassGraph::SubresourceName originalSubresourceName = RenderPassGraph::ConstructSubresourceName(resourceData->ResourceName(), subresourceIndex);
+                    uint64_t resourceDataIndex = resourceData - mCurrentFrameResources->data();
                     
                     // Remove PixelShaderAccess if pass is not executed on graphics queue
                     if (EnumMaskContains(subresourceInfo.RequestedState, HAL::ResourceState::PixelShaderAccess) && passNode->ExecutionQueueIndex > 0)
@@ -221,7 +229,7 @@ namespace PathFinder
                     // Track and combine consecutive read states.
                     // Read state collapse works by traversing dependency levels,
                     // because that's the resource read/write granularity when multiple queues are involved.
-                    PipelineResourceSchedulingInfo::SubresourceInfo** firstReadingSubresourceInfo = &firstReadingSubresourceInfos[originalSubresourceName];
+                    PipelineResourceSchedulingInfo::SubresourceInfo** firstReadingSubresourceInfo = &mFirstReadingSubresourceInfos[mSubresourceInfoOffsets[resourceDataIndex] + subresourceIndex];
 
                     if (!(*firstReadingSubresourceInfo) && HAL::IsResourceStateReadOnly(subresourceInfo.RequestedState))
                     {
@@ -345,9 +353,9 @@ namespace PathFinder
         ResourceName resourceName,
         const HAL::ResourcePropertiesVariant& properties,
         std::optional<Foundation::Name> propertyCopySourceName,
-        const SchedulingInfoConfigurator& siConfigurator)
+        SchedulingInfoConfigurator&& siConfigurator)
     {
-        mSchedulingCreationRequests.emplace_back(SchedulingRequest{ siConfigurator, resourceName, passName });
+        mSchedulingCreationRequests.emplace_back(SchedulingRequest{ std::move(siConfigurator), resourceName, passName });
 
         if (propertyCopySourceName)
         {
@@ -358,21 +366,21 @@ namespace PathFinder
         }
     }
 
-    void PipelineResourceStorage::QueueResourceUsage(PassName passName, ResourceName resourceName, std::optional<ResourceName> aliasName, const SchedulingInfoConfigurator& siConfigurator)
+    void PipelineResourceStorage::QueueResourceUsage(PassName passName, ResourceName resourceName, std::optional<ResourceName> aliasName, SchedulingInfoConfigurator&& siConfigurator)
     {
         if (aliasName)
         {
-            mSchedulingUsageRequests.emplace_back(SchedulingRequest{ siConfigurator, *aliasName, passName });
+            mSchedulingUsageRequests.emplace_back(SchedulingRequest{ std::move(siConfigurator), *aliasName, passName });
             mAliasMap[*aliasName] = resourceName;
         }
         else {
-            mSchedulingUsageRequests.emplace_back(SchedulingRequest{ siConfigurator, resourceName, passName });
+            mSchedulingUsageRequests.emplace_back(SchedulingRequest{ std::move(siConfigurator), resourceName, passName });
         }
     }
 
-    void PipelineResourceStorage::QueueResourceReadback(PassName passName, ResourceName resourceName, const SchedulingInfoConfigurator& siConfigurator)
+    void PipelineResourceStorage::QueueResourceReadback(PassName passName, ResourceName resourceName, SchedulingInfoConfigurator&& siConfigurator)
     {
-        mSchedulingReadbackRequests.push_back(SchedulingRequest{ siConfigurator, resourceName, passName });
+        mSchedulingReadbackRequests.push_back(SchedulingRequest{ std::move(siConfigurator), resourceName, passName });
     }
 
     void PipelineResourceStorage::AddSampler(Foundation::Name samplerName, const HAL::Sampler& sampler)
@@ -406,6 +414,18 @@ namespace PathFinder
         }
     }
 
+    const PipelineResourceMemoryAliaser* PipelineResourceStorage::GetMemoryAliaser(HAL::HeapAliasingGroup group) const
+    {
+        switch (group)
+        {
+        case HAL::HeapAliasingGroup::RTDSTextures: return &mRTDSMemoryAliaser;
+        case HAL::HeapAliasingGroup::NonRTDSTextures: return &mNonRTDSMemoryAliaser;
+        case HAL::HeapAliasingGroup::Buffers: return &mBufferMemoryAliaser;
+        case HAL::HeapAliasingGroup::Universal: return &mUniversalMemoryAliaser;
+        default: return nullptr;
+        }
+    }
+
     bool PipelineResourceStorage::TransferPreviousFrameResources()
     {
         for (PipelineResourceStorageResource& resourceData : *mCurrentFrameResources)
@@ -462,9 +482,9 @@ namespace PathFinder
         return mGlobalRootConstantsBuffer.get();
     }
 
-    const Memory::Buffer* PipelineResourceStorage::PerFrameRootConstantsBuffer() const
+    HAL::GPUAddress PipelineResourceStorage::PerFrameRootConstantsAddress() const
     {
-        return mPerFrameRootConstantsBuffer.get();
+        return mPerFrameRootConstantsAddress;
     }
 
     PipelineResourceStoragePass* PipelineResourceStorage::GetPerPassData(PassName name)
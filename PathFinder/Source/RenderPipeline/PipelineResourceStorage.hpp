@@ -11,15 +11,18 @@
 #include <HardwareAbstractionLayer/DescriptorHeap.hpp>
 #include <HardwareAbstractionLayer/SwapChain.hpp>
 #include <Foundation/MemoryUtils.hpp>
+#include <Foundation/Delegate.hpp>
 #include <Memory/GPUResourceProducer.hpp>
 #include <Memory/PoolDescriptorAllocator.hpp>
 #include <Memory/ResourceStateTracker.hpp>
+#include <Memory/TransientLinearAllocator.hpp>
 
 #include <vector>
 #include <functional>
 #include <tuple>
 #include <memory>
 #include <optional>
+#include <cstring>
 
 #include <robinhood/robin_hood.h>
 #include <dtl/dtl.hpp>
@@ -40,12 +43,15 @@ namespace PathFinder
             Memory::GPUResourceProducer* resourceProducer,
             Memory::PoolDescriptorAllocator* descriptorAllocator,
             Memory::ResourceStateTracker* stateTracker,
+            Memory::TransientLinearAllocator* transientAllocator,
             const RenderSurfaceDescription& defaultRenderSurface,
             const RenderPassGraph* passExecutionGraph
         );
 
         using DebugBufferIteratorFunc = std::function<void(PassName passName, const float* debugData)>;
-        using SchedulingInfoConfigurator = std::function<void(PipelineResourceSchedulingInfo&)>;
+
+        // Sized to keep resource scheduler captures inline
+        using SchedulingInfoConfigurator = Foundation::Delegate<void(PipelineResourceSchedulingInfo&), 128>;
 
         const HAL::RTDescriptor* GetRenderTargetDescriptor(Foundation::Name resourceName, Foundation::Name passName, uint64_t mipIndex = 0) const;
         const HAL::DSDescriptor* GetDepthStencilDescriptor(Foundation::Name resourceName, Foundation::Name passName) const;
@@ -55,6 +61,10 @@ namespace PathFinder
         void EndFrame();
 
         bool HasMemoryLayoutChange() const;
+
+        // Schedule and statistics of the last memory aliasing. 
+        // Schedules can be captured here and replayed offline with MemoryAliasingSolver::PlaceAllocations().
+        const PipelineResourceMemoryAliaser* GetMemoryAliaser(HAL::HeapAliasingGroup group) const;
         
         PipelineResourceStoragePass& CreatePerPassData(PassName name);
 
@@ -73,7 +83,7 @@ namespace PathFinder
         void UpdatePassRootConstants(const Constants& constants, const RenderPassGraph::Node& passNode);
 
         const Memory::Buffer* GlobalRootConstantsBuffer() const;
-        const Memory::Buffer* PerFrameRootConstantsBuffer() const;
+        HAL::GPUAddress PerFrameRootConstantsAddress() const;
 
         PipelineResourceStoragePass* GetPerPassData(PassName name);
         PipelineResourceStorageResource* GetPerResourceData(ResourceName name);
@@ -90,10 +100,10 @@ namespace PathFinder
             ResourceName resourceName, 
             const HAL::ResourcePropertiesVariant& properties, 
             std::optional<Foundation::Name> propertyCopySourceName,
-            const SchedulingInfoConfigurator& siConfigurator);
+            SchedulingInfoConfigurator&& siConfigurator);
 
-        void QueueResourceUsage(PassName passName, ResourceName resourceName, std::optional<ResourceName> aliasName, const SchedulingInfoConfigurator& siConfigurator);
-        void QueueResourceReadback(PassName passName, ResourceName resourceName, const SchedulingInfoConfigurator& siConfigurator);
+        void QueueResourceUsage(PassName passName, ResourceName resourceName, std::optional<ResourceName> aliasName, SchedulingInfoConfigurator&& siConfigurator);
+        void QueueResourceReadback(PassName passName, ResourceName resourceName, SchedulingInfoConfigurator&& siConfigurator);
         void AddSampler(Foundation::Name samplerName, const HAL::Sampler& sampler);
 
     private:
@@ -122,12 +132,16 @@ namespace PathFinder
         PipelineResourceStorageResource& CreatePerResourceData(ResourceName name, const HAL::ResourceFormat& resourceFormat);
         HAL::Heap* GetHeapForAliasingGroup(HAL::HeapAliasingGroup group);
 
+        template <class Constants>
+        HAL::GPUAddress WriteTransientConstants(const Constants& constants, Memory::TransientLinearAllocator::Context& context);
+
         bool TransferPreviousFrameResources();
 
         HAL::Device* mDevice;
         Memory::GPUResourceProducer* mResourceProducer;
         Memory::PoolDescriptorAllocator* mDescriptorAllocator;
         Memory::ResourceStateTracker* mResourceStateTracker;
+        Memory::TransientLinearAllocator* mTransientAllocator;
         const RenderPassGraph* mPassExecutionGraph;
 
         std::unique_ptr<HAL::Heap> mRTDSHeap;
@@ -145,8 +159,9 @@ namespace PathFinder
         // Constant buffer for global data that changes rarely
         Memory::GPUResourceProducer::BufferPtr mGlobalRootConstantsBuffer;
 
-        // Constant buffer for data that changes every frame
-        Memory::GPUResourceProducer::BufferPtr mPerFrameRootConstantsBuffer;
+        // Data that changes every frame lives in transient frame memory
+        Memory::TransientLinearAllocator::Context mFrameConstantsAllocationContext;
+        HAL::GPUAddress mPerFrameRootConstantsAddress = 0;
 
         robin_hood::unordered_node_map<PassName, PipelineResourceStoragePass> mPerPassData;
 
@@ -166,6 +181,10 @@ namespace PathFinder
         ResourceAliasMap mAliasMap;
         SamplerMap mSamplers;
 
+        // Scratch buffers of scheduled state optimization, kept between frames to avoid reallocations
+        std::vector<uint64_t> mSubresourceInfoOffsets;
+        std::vector<PipelineResourceSchedulingInfo::SubresourceInfo*> mFirstReadingSubresourceInfos;
+
         // Resource diff entries to determine resource allocation needs
         std::pair<DiffEntryList, DiffEntryList> mDiffEntries;
         DiffEntryList* mPreviousFrameDiffEntries = &mDiffEntries.first;
@@ -6,17 +6,7 @@ namespace PathFinder
     template <class Constants>
     void PipelineResourceStorage::UpdateFrameRootConstants(const Constants& constants)
     {
-        constexpr uint64_t Alignment = 256;
-
-        if (!mPerFrameRootConstantsBuffer || mPerFrameRootConstantsBuffer->Capacity<Constants>(Alignment) < 1)
-        {
-            auto properties = HAL::BufferProperties::Create<Constants>(1, Alignment, HAL::ResourceState::ConstantBuffer);
-            mPerFrameRootConstantsBuffer = mResourceProducer->NewBuffer(properties);
-            mPerFrameRootConstantsBuffer->SetDebugName("Frame Constant Buffer");
-        }
-
-        mPerFrameRootConstantsBuffer->RequestWrite();
-        mPerFrameRootConstantsBuffer->Write(&constants, 0, 1, Alignment);
+        mPerFrameRootConstantsAddress = WriteTransientConstants(constants, mFrameConstantsAllocationContext);
     }
 
     template <class Constants>
@@ -38,38 +28,19 @@ namespace PathFinder
     template <class Constants>
     void PipelineResourceStorage::UpdatePassRootConstants(const Constants& constants, const RenderPassGraph::Node& passNode)
     {
-        constexpr uint64_t Alignment = 256;
-        constexpr uint64_t GrowAlignment = 4096;
-
         PipelineResourceStoragePass* passData = GetPerPassData(passNode.PassMetadata().Name);
+        passData->PassConstantBufferAddress = WriteTransientConstants(constants, passData->ConstantsAllocationContext);
+    }
 
-        uint64_t alignedBytesToWrite = Foundation::MemoryUtils::Align(sizeof(Constants), Alignment);
-        uint64_t alreadyWrittenBytes = passData->PassConstantBufferMemoryOffset;
-        uint64_t newBufferSize = alignedBytesToWrite + alreadyWrittenBytes;
-
-        // Advance offset once if allowed and transition to non-allowed state
-        if (passData->IsAllowedToAdvanceConstantBufferOffset)
-        {
-            passData->PassConstantBufferMemoryOffset += passData->LastSetConstantBufferDataSize;
-            passData->IsAllowedToAdvanceConstantBufferOffset = false;
-        }
-
-        passData->LastSetConstantBufferDataSize = alignedBytesToWrite;
-
-        // Allocate on demand
-        if (!passData->PassConstantBuffer || passData->PassConstantBuffer->Capacity() < newBufferSize)
-        {
-            uint64_t grownBufferSize = Foundation::MemoryUtils::Align(newBufferSize, GrowAlignment);
-            auto properties = HAL::BufferProperties::Create<uint8_t>(grownBufferSize, 1, HAL::ResourceState::ConstantBuffer);
-
-            passData->PassConstantBuffer = mResourceProducer->NewBuffer(properties);
-            passData->PassConstantBuffer->SetDebugName(passNode.PassMetadata().Name.ToString() + " Constant Buffer");
-        }
+    template <class Constants>
+    HAL::GPUAddress PipelineResourceStorage::WriteTransientConstants(const Constants& constants, Memory::TransientLinearAllocator::Context& context)
+    {
+        std::optional<Memory::TransientLinearAllocator::Allocation> allocation = mTransientAllocator->Allocate(context, sizeof(Constants));
+        assert_format(allocation, "Transient memory is exhausted");
 
-        const uint8_t* data = reinterpret_cast<const uint8_t*>(&constants);
+        std::memcpy(allocation->CPUAddress, &constants, sizeof(Constants));
 
-        passData->PassConstantBuffer->RequestWrite();
-        passData->PassConstantBuffer->Write(data, passData->PassConstantBufferMemoryOffset, sizeof(Constants));
+        return allocation->GPUAddress;
     }
 
     template <class Func>
@@ -2,6 +2,7 @@
 
 #include <Foundation/Name.hpp>
 #include <Memory/GPUResourceProducer.hpp>
+#include <Memory/TransientLinearAllocator.hpp>
 
 #include "PipelineResourceStorageResource.hpp"
 
@@ -12,20 +13,13 @@ namespace PathFinder
 
     struct PipelineResourceStoragePass
     {
-        // Constant buffers for each pass that require it.
-        Memory::GPUResourceProducer::BufferPtr PassConstantBuffer;
+        // Pass constants are written to transient frame memory. A pass is recorded by a single thread at a time,
+        // so each pass allocates from its own context without synchronization.
+        Memory::TransientLinearAllocator::Context ConstantsAllocationContext;
 
-        // Memory offset for pass constant buffer in current frame.
-        // Used to place pass data in different memory locations
-        // as a versioning mechanism for multiple draws/dispatches in one render pass.
-        uint64_t PassConstantBufferMemoryOffset = 0;
-
-        // Size of data last uploaded to pass constant buffer. Used to offset 
-        // the constant buffer after a draw/dispatch.
-        uint64_t LastSetConstantBufferDataSize = 0;
-
-        // 
-        bool IsAllowedToAdvanceConstantBufferOffset = false;
+        // Address of constants last written by the pass in current frame, zero if none were written.
+        // Every update is placed in new memory, which versions data between draws/dispatches of one render pass.
+        HAL::GPUAddress PassConstantBufferAddress = 0;
     };
 
 }
@@ -7,7 +7,9 @@ namespace PathFinder
     {
         bool IsMemoryAliasingEnabled = true;
         bool IsAsyncComputeEnabled = true;
+        bool IsAutomaticAsyncComputeAssignmentEnabled = true;
         bool IsSplitBarriersEnabled = true;
+        bool IsMultiThreadedRecordingEnabled = false;
     };
 
 }
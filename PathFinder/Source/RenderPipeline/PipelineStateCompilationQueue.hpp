@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Foundation/ThreadPool.hpp>
+
+#include <robinhood/robin_hood.h>
+
+#include <functional>
+#include <atomic>
+#include <list>
+
+namespace PathFinder
+{
+
+    // Compiles states on a thread pool and hands results back to the owning thread.
+    // A state keeps its current compiled version until the result of its latest requested
+    // compilation is applied. Results of compilations superseded by a newer request are dropped.
+    // Not thread safe itself: only compilers run on the pool.
+    template <class State, class CompiledState>
+    class PipelineStateCompilationQueue
+    {
+    public:
+        // Must not reference the state itself, which may be modified while compilation is in flight
+        using Compiler = std::function<CompiledState()>;
+
+        PipelineStateCompilationQueue(Foundation::ThreadPool* threadPool);
+
+        void Enqueue(State* state, Compiler&& compiler);
+
+        // Invokes applier(State*, CompiledState&) for every finished compilation that is the latest for its state
+        template <class Applier>
+        void ApplyFinished(const Applier& applier);
+
+    private:
+        struct Compilation
+        {
+            Compilation(State* state, Compiler&& compiler)
+                : TargetState{ state }, Compile{ std::move(compiler) } {}
+
+            State* TargetState = nullptr;
+            Compiler Compile;
+
+            // Written by a worker thread
+            CompiledState Result{};
+            std::atomic<bool> IsFinished = false;
+
+            // Newer compilation of the same state was requested, this one's result is outdated
+            bool IsSuperseded = false;
+        };
+
+        Foundation::ThreadPool* mThreadPool = nullptr;
+        std::list<Compilation> mCompilations;
+        robin_hood::unordered_map<State*, Compilation*> mLatestCompilations;
+
+    public:
+        inline bool IsEmpty() const { return mCompilations.empty(); }
+    };
+
+}
+
+#include "PipelineStateCompilationQueue.inl"
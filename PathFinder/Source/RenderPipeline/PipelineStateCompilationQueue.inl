@@ -0,0 +1,54 @@
+#pragma once
+
+namespace PathFinder
+{
+
+    template <class State, class CompiledState>
+    PipelineStateCompilationQueue<State, CompiledState>::PipelineStateCompilationQueue(Foundation::ThreadPool* threadPool)
+        : mThreadPool{ threadPool } {}
+
+    template <class State, class CompiledState>
+    void PipelineStateCompilationQueue<State, CompiledState>::Enqueue(State* state, Compiler&& compiler)
+    {
+        Compilation& compilation = mCompilations.emplace_back(state, std::move(compiler));
+
+        auto latestIt = mLatestCompilations.find(state);
+
+        if (latestIt != mLatestCompilations.end())
+        {
+            latestIt->second->IsSuperseded = true;
+        }
+
+        mLatestCompilations[state] = &compilation;
+
+        // Compilations live in a list, so the reference stays valid until they're applied
+        mThreadPool->Execute([&compilation]
+        {
+            compilation.Result = compilation.Compile();
+            compilation.IsFinished = true;
+        });
+    }
+
+    template <class State, class CompiledState>
+    template <class Applier>
+    void PipelineStateCompilationQueue<State, CompiledState>::ApplyFinished(const Applier& applier)
+    {
+        for (auto it = mCompilations.begin(); it != mCompilations.end();)
+        {
+            if (!it->IsFinished)
+            {
+                ++it;
+                continue;
+            }
+
+            if (!it->IsSuperseded)
+            {
+                applier(it->TargetState, it->Result);
+                mLatestCompilations.erase(it->TargetState);
+            }
+
+            it = mCompilations.erase(it);
+        }
+    }
+
+}
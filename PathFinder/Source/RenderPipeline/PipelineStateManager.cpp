@@ -1,6 +1,7 @@
 #include "PipelineStateManager.hpp"
 
-
+#include <fstream>
+#include <iterator>
 
 namespace PathFinder
 {
@@ -9,15 +10,18 @@ namespace PathFinder
         HAL::Device* device,
         ShaderManager* shaderManager, 
         Memory::GPUResourceProducer* resourceProducer,
-        const RenderSurfaceDescription& defaultRenderSurface)
+        const RenderSurfaceDescription& defaultRenderSurface,
+        const std::filesystem::path& executableFolder)
         : 
         mDevice{ device }, 
         mShaderManager{ shaderManager },
         mResourceProducer{ resourceProducer },
         mDefaultRenderSurfaceDesc{ defaultRenderSurface }, 
         mBaseRootSignature{ device },
-        mDefaultGraphicsState{ device }
+        mDefaultGraphicsState{ device },
+        mPipelineLibraryPath{ executableFolder / "ShaderCache" / "PipelineLibrary.bin" }
     {
+        LoadPipelineLibrary();
         ConfigureDefaultStates();
         AddCommonRootSignatureParameters(mBaseRootSignature);
 
@@ -27,6 +31,12 @@ namespace PathFinder
         mShaderManager->LibraryRecompilationEvent() += { "library.recompilation", this, &PipelineStateManager::RecompileStatesWithNewLibrary };
     }
 
+    PipelineStateManager::~PipelineStateManager()
+    {
+        WaitForStateCompilations();
+        SavePipelineLibraryIfModified();
+    }
+
     void PipelineStateManager::CreateRootSignature(RootSignatureName name, const RootSignatureConfigurator& configurator)
     {
         assert_format(GetRootSignature(name) == nullptr, "Redefinition of Root Signature. ", name.ToString(), " already exists.");
@@ -242,6 +252,30 @@ namespace PathFinder
         return &it->second;
     }
 
+    const HAL::CommandSignature* PipelineStateManager::GetRootConstantDrawSignature(const HAL::RootSignature* rootSignature, uint32_t rootConstantParameterIndex)
+    {
+        std::lock_guard lock{ mCommandSignatureMutex };
+
+        auto key = std::make_pair(rootSignature, rootConstantParameterIndex);
+        auto it = mRootConstantDrawSignatures.find(key);
+
+        if (it != mRootConstantDrawSignatures.end())
+        {
+            return &it->second;
+        }
+
+        HAL::CommandSignature signature{ mDevice };
+        signature.AddRootConstantsArgument(rootConstantParameterIndex, 1);
+        signature.AddDrawArgument();
+        signature.SetDebugName("Root Constant Draw Command Signature");
+        signature.Compile(rootSignature);
+
+        assert_format(signature.ByteStride() == sizeof(HAL::RootConstantDrawArguments), "Command signature doesn't match argument structure layout");
+
+        auto [iterator, success] = mRootConstantDrawSignatures.emplace(key, std::move(signature));
+        return &iterator->second;
+    }
+
     const HAL::RootSignature* PipelineStateManager::GetNamedRootSignatureOrDefault(std::optional<RootSignatureName> name) const
     {
         if (!name) return &mBaseRootSignature;
@@ -267,29 +301,46 @@ namespace PathFinder
 
     void PipelineStateManager::CompileUncompiledSignaturesAndStates()
     {
+        // Shaders requested by new states are compiled in the background until now
+        mShaderManager->FinishPendingCompilations();
+
         for (HAL::RootSignature* signature : mSignaturesToCompile)
         {
             signature->Compile();
         }
 
+        bool newStatesRequested = false;
+
         for (PipelineStateVariantInternal* state : mStatesToCompile)
         {
             if (auto pso = std::get_if<HAL::GraphicsPipelineState>(state))
             {
-                pso->Compile();
+                newStatesRequested |= pso->D3DCompiledState() == nullptr;
+                CompileInBackground(pso, pso->Clone());
             }
             else if (auto pso = std::get_if<HAL::ComputePipelineState>(state))
             {
-                pso->Compile();
+                newStatesRequested |= pso->D3DCompiledState() == nullptr;
+                CompileInBackground(pso, pso->Clone());
             }
             else if (auto psoWrapper = std::get_if<RayTracingStateWrapper>(state))
             {
+                // State objects can't be stored in a pipeline library 
+                // and their shader tables are uploaded right away, so they're compiled in place
                 CompileRayTracingState(*psoWrapper);
             }
         }
 
         mSignaturesToCompile.clear();
         mStatesToCompile.clear();
+
+        // There is nothing to render new states with until they are compiled
+        if (newStatesRequested)
+        {
+            WaitForStateCompilations();
+        }
+
+        ApplyFinishedStateCompilations();
     }
 
     void PipelineStateManager::AssociateStateWithShader(PipelineStateVariantInternal* state, const HAL::Shader* shader)
@@ -405,6 +456,9 @@ namespace PathFinder
 
     void PipelineStateManager::RecompileStatesWithNewShader(const HAL::Shader* oldShader, const HAL::Shader* newShader)
     {
+        // Background compilations may still read the old shader, which is about to be destroyed
+        WaitForStateCompilations();
+
         auto associationsIt = mShaderToPSOAssociations.find(oldShader);
         assert_format(associationsIt != mShaderToPSOAssociations.end(), "Cannot find PSOs after shader recompilation");
 
@@ -444,4 +498,76 @@ namespace PathFinder
         mLibraryToPSOAssociations.erase(oldLibrary);
     }
 
-}
\ No newline at end of file
+    void PipelineStateManager::CompileInBackground(HAL::PipelineState* state, const StateCopyVariant& stateCopy)
+    {
+        // Copy of the state at the time compilation was requested is compiled,
+        // so that the state itself can be modified while worker is busy
+        mStateCompilations.Enqueue(state, [this, stateCopy]
+        {
+            return std::visit([this](auto&& copy) { return copy.CreateD3DState(mPipelineLibrary.get()); }, stateCopy);
+        });
+    }
+
+    void PipelineStateManager::ApplyFinishedStateCompilations()
+    {
+        mStateCompilations.ApplyFinished([](HAL::PipelineState* state, const Microsoft::WRL::ComPtr<ID3D12PipelineState>& compiledState)
+        {
+            state->SetCompiledState(compiledState);
+        });
+
+        if (mStateCompilations.IsEmpty())
+        {
+            SavePipelineLibraryIfModified();
+        }
+    }
+
+    void PipelineStateManager::WaitForStateCompilations()
+    {
+        mCompilationThreadPool.WaitForAllTasks();
+    }
+
+    void PipelineStateManager::LoadPipelineLibrary()
+    {
+        std::vector<uint8_t> serializedData;
+        std::ifstream stream{ mPipelineLibraryPath, std::ios::binary | std::ios::in };
+
+        if (stream.is_open())
+        {
+            serializedData.assign(std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{});
+        }
+
+        mPipelineLibrary = std::make_unique<HAL::PipelineLibrary>(mDevice, std::move(serializedData));
+        mPipelineLibrary->SetDebugName("Pipeline Library");
+    }
+
+    void PipelineStateManager::SavePipelineLibraryIfModified()
+    {
+        if (!mPipelineLibrary->IsModified())
+        {
+            return;
+        }
+
+        std::vector<uint8_t> serializedData = mPipelineLibrary->Serialize();
+
+        // Write to a temporary file first so that a partially written library is never picked up
+        std::filesystem::path temporaryPath = mPipelineLibraryPath;
+        temporaryPath += ".tmp";
+
+        std::filesystem::create_directories(mPipelineLibraryPath.parent_path());
+
+        {
+            std::ofstream stream{ temporaryPath, std::ios::binary | std::ios::trunc | std::ios::out };
+
+            if (!stream.is_open())
+            {
+                return;
+            }
+
+            stream.write(reinterpret_cast<const char*>(serializedData.data()), serializedData.size());
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, mPipelineLibraryPath, error);
+    }
+
+}
@@ -2,7 +2,10 @@
 
 #include <Foundation/Name.hpp>
 #include <HardwareAbstractionLayer/PipelineState.hpp>
+#include <HardwareAbstractionLayer/CommandSignature.hpp>
+#include <HardwareAbstractionLayer/PipelineLibrary.hpp>
 #include <Memory/GPUResourceProducer.hpp>
+#include <Foundation/ThreadPool.hpp>
 
 #include <robinhood/robin_hood.h>
 
@@ -10,8 +13,13 @@
 #include "RenderSurfaceDescription.hpp"
 #include "PipelineStateProxy.hpp"
 #include "RootSignatureProxy.hpp"
+#include "PipelineStateCompilationQueue.hpp"
 
 #include <unordered_map>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <filesystem>
 
 namespace PathFinder
 {
@@ -43,9 +51,12 @@ namespace PathFinder
             HAL::Device* device,
             ShaderManager* shaderManager,
             Memory::GPUResourceProducer* resourceProducer, 
-            const RenderSurfaceDescription& defaultRenderSurface
+            const RenderSurfaceDescription& defaultRenderSurface,
+            const std::filesystem::path& executableFolder
         );
 
+        ~PipelineStateManager();
+
         void CreateRootSignature(RootSignatureName name, const RootSignatureConfigurator& configurator);
         void CreateGraphicsState(PSOName name, const GraphicsStateConfigurator& configurator);
         void CreateComputeState(PSOName name, const ComputeStateConfigurator& configurator);
@@ -55,6 +66,13 @@ namespace PathFinder
         const HAL::RootSignature* GetRootSignature(RootSignatureName name) const;
         const HAL::RootSignature& BaseRootSignature() const;
 
+        // Signature of indirect commands that set one 32 bit root constant and then draw.
+        // Created on first request. Safe to call from multiple render pass recording threads.
+        const HAL::CommandSignature* GetRootConstantDrawSignature(const HAL::RootSignature* rootSignature, uint32_t rootConstantParameterIndex);
+
+        // New states are compiled in parallel and are ready when this returns.
+        // States that already have a compiled version (recompilation after shader hot reload)
+        // are compiled in the background and keep using previous version until the new one is ready.
         void CompileUncompiledSignaturesAndStates();
 
     private:
@@ -73,6 +91,8 @@ namespace PathFinder
         // Store graphic and compute states directly, but store ray tracing one in a wrapper because we need to manage and associate additional memory with it
         using PipelineStateVariantInternal = std::variant<HAL::GraphicsPipelineState, HAL::ComputePipelineState, RayTracingStateWrapper>;
 
+        using StateCopyVariant = std::variant<HAL::GraphicsPipelineState, HAL::ComputePipelineState>;
+
         const HAL::RootSignature* GetNamedRootSignatureOrDefault(std::optional<RootSignatureName> name) const;
         const HAL::RootSignature* GetNamedRootSignatureOrNull(std::optional<RootSignatureName> name) const;
 
@@ -82,6 +102,12 @@ namespace PathFinder
         void ConfigureDefaultStates();
         void AddCommonRootSignatureParameters(HAL::RootSignature& signature) const;
         void CompileRayTracingState(RayTracingStateWrapper& stateWrapper);
+        void CompileInBackground(HAL::PipelineState* state, const StateCopyVariant& stateCopy);
+        void ApplyFinishedStateCompilations();
+        void WaitForStateCompilations();
+
+        void LoadPipelineLibrary();
+        void SavePipelineLibraryIfModified();
 
         void RecompileStatesWithNewShader(const HAL::Shader* oldShader, const HAL::Shader* newShader);
         void RecompileStatesWithNewLibrary(const HAL::Library* oldLibrary, const HAL::Library* newLibrary);
@@ -100,6 +126,12 @@ namespace PathFinder
         robin_hood::unordered_map<const HAL::Library*, robin_hood::unordered_flat_set<PipelineStateVariantInternal*>> mLibraryToPSOAssociations;
         robin_hood::unordered_set<PipelineStateVariantInternal*> mStatesToCompile;
         robin_hood::unordered_set<HAL::RootSignature*> mSignaturesToCompile;
+        std::map<std::pair<const HAL::RootSignature*, uint32_t>, HAL::CommandSignature> mRootConstantDrawSignatures;
+        std::mutex mCommandSignatureMutex;
+
+        std::filesystem::path mPipelineLibraryPath;
+        std::unique_ptr<HAL::PipelineLibrary> mPipelineLibrary;
+        PipelineStateCompilationQueue<HAL::PipelineState, Microsoft::WRL::ComPtr<ID3D12PipelineState>> mStateCompilations{ &mCompilationThreadPool };
 
         std::string mDefaultVertexEntryPointName = "VSMain";
         std::string mDefaultPixelEntryPointName = "PSMain";
@@ -111,6 +143,9 @@ namespace PathFinder
         std::string mDefaultRayClosestHitEntryPointName = "RayClosestHit";
         std::string mDefaultRayIntersectionEntryPointName = "RayIntersection";
 
+        // Declared last to be destroyed first, while objects used by its tasks are still alive
+        Foundation::ThreadPool mCompilationThreadPool;
+
     public:
         inline const auto CommonRootSignatureParameterCount() const { return mBaseRootSignature.ParameterCount(); }
     };
@@ -32,16 +32,18 @@ namespace PathFinder
     {
         assert_format(mDestinationBuffer, "Cannot update an acceleration structure that wasn't built at least once yet");
         
-        // Use last destination buffer as a source of update
-        mUpdateSourceBuffer = std::move(mDestinationBuffer);
+        // Use last destination buffer as a source of update.
+        // Buffers are ping-ponged between updates, so new memory is only allocated on first update.
+        std::swap(mUpdateSourceBuffer, mDestinationBuffer);
 
         if (!mDestinationBuffer || mDestinationBuffer->Capacity() < destinationBufferSize)
         {
             HAL::BufferProperties properties{ destinationBufferSize, 1, HAL::ResourceState::RaytracingAccelerationStructure, HAL::ResourceState::UnorderedAccess };
             mDestinationBuffer = mResourceProducer->NewBuffer(properties);
-            mUABarrier = HAL::UnorderedAccessResourceBarrier{ mDestinationBuffer->HALBuffer() };
         }
 
+        mUABarrier = HAL::UnorderedAccessResourceBarrier{ mDestinationBuffer->HALBuffer() };
+
         if (!mScratchBuffer || mScratchBuffer->Capacity() < scratchBufferSize)
         {
             HAL::BufferProperties properties{ scratchBufferSize, 1, HAL::ResourceState::UnorderedAccess };
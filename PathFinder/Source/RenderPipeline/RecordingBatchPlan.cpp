@@ -0,0 +1,41 @@
+#include "RecordingBatchPlan.hpp"
+
+#include <algorithm>
+
+namespace PathFinder
+{
+
+    void RecordingBatchPlan::Build(const RenderPassGraph& graph, uint64_t threadCount, bool isMultiThreadedRecordingEnabled)
+    {
+        mBatchesPerLevel.resize(graph.DependencyLevels().size());
+        mBatchIndices.resize(graph.NodesInGlobalExecutionOrder().size());
+
+        for (const RenderPassGraph::DependencyLevel& dependencyLevel : graph.DependencyLevels())
+        {
+            uint64_t nodeCount = dependencyLevel.Nodes().size();
+            uint64_t batchCount = isMultiThreadedRecordingEnabled ? std::max<uint64_t>(std::min(threadCount, nodeCount), 1) : 1;
+            std::vector<Batch>& batches = mBatchesPerLevel[dependencyLevel.LevelIndex()];
+
+            // Keep batch storage between frames
+            batches.resize(batchCount);
+
+            for (Batch& batch : batches)
+            {
+                batch.clear();
+            }
+
+            for (const RenderPassGraph::Node* node : dependencyLevel.Nodes())
+            {
+                uint64_t batchIndex = node->LocalToDependencyLevelExecutionIndex() * batchCount / nodeCount;
+                batches[batchIndex].push_back(node);
+                mBatchIndices[node->GlobalExecutionIndex()] = batchIndex;
+            }
+        }
+    }
+
+    uint64_t RecordingBatchPlan::BatchIndex(const RenderPassGraph::Node& node) const
+    {
+        return mBatchIndices[node.GlobalExecutionIndex()];
+    }
+
+}
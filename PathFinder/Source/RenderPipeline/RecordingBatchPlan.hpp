@@ -0,0 +1,39 @@
+#pragma once
+
+#include "RenderPassGraph.hpp"
+
+#include <Foundation/ThreadPool.hpp>
+
+#include <vector>
+
+namespace PathFinder
+{
+
+    // Nodes of a dependency level are split into contiguous batches that can be recorded in parallel.
+    // Worker command lists of each batch are allocated from a separate set of command allocators,
+    // so batching is decided once per frame and both allocation and recording use the same batches.
+    class RecordingBatchPlan
+    {
+    public:
+        using Batch = std::vector<const RenderPassGraph::Node*>;
+
+        void Build(const RenderPassGraph& graph, uint64_t threadCount, bool isMultiThreadedRecordingEnabled);
+
+        uint64_t BatchIndex(const RenderPassGraph::Node& node) const;
+
+        // Records dependency levels one after another, batches of a level in parallel.
+        // Nodes of a batch are recorded on a single thread in execution order.
+        template <class Func>
+        void Record(Foundation::ThreadPool& threadPool, const Func& recordNode) const;
+
+    private:
+        std::vector<std::vector<Batch>> mBatchesPerLevel;
+        std::vector<uint64_t> mBatchIndices;
+
+    public:
+        inline const auto& BatchesForLevel(uint64_t levelIndex) const { return mBatchesPerLevel[levelIndex]; }
+    };
+
+}
+
+#include "RecordingBatchPlan.inl"
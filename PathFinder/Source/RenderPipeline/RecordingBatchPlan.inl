@@ -0,0 +1,30 @@
+#pragma once
+
+namespace PathFinder
+{
+
+    template <class Func>
+    void RecordingBatchPlan::Record(Foundation::ThreadPool& threadPool, const Func& recordNode) const
+    {
+        for (const std::vector<Batch>& batches : mBatchesPerLevel)
+        {
+            auto recordBatch = [&batches, &recordNode](uint64_t batchIndex)
+            {
+                for (const RenderPassGraph::Node* node : batches[batchIndex])
+                {
+                    recordNode(node);
+                }
+            };
+
+            if (batches.size() == 1)
+            {
+                recordBatch(0);
+            }
+            else
+            {
+                threadPool.ParallelFor(batches.size(), recordBatch);
+            }
+        }
+    }
+
+}
@@ -17,10 +17,12 @@ namespace PathFinder
         GPUDataInspector* gpuDataInspector,
         const RenderPassGraph* renderPassGraph,
         const RenderSurfaceDescription& defaultRenderSurface,
-        const PipelineSettings* settings)
+        const PipelineSettings* settings,
+        uint64_t recordingThreadCount)
         :
         mGraphicsQueue{ device },
         mComputeQueue{ device },
+        mCopyQueue{ device },
         mDescriptorAllocator{ descriptorAllocator },
         mCommandListAllocator{ commandListAllocator },
         mResourceStateTracker{ resourceStateTracker },
@@ -33,13 +35,16 @@ namespace PathFinder
         mDefaultRenderSurface{ defaultRenderSurface },
         mGraphicsQueueFence{ device },
         mComputeQueueFence{ device },
+        mCopyQueueFence{ device },
         mBVHFence{ device },
         mFrameBlueprint{ renderPassGraph, mBVHBuildsQueueIndex, &mBVHFence, {&mGraphicsQueueFence, &mComputeQueueFence} },
-        mPipelinesSettings{ settings }
+        mPipelinesSettings{ settings },
+        mRecordingThreadCount{ recordingThreadCount }
     {
-        mFrameMeasurement.Name = "Total Frame Time";
+        mFrameMeasurement.Name = FrameMeasurementName;
         mGraphicsQueue.SetDebugName("Graphics Queue");
         mComputeQueue.SetDebugName("Async Compute Queue");
+        mCopyQueue.SetDebugName("Copy Queue");
     }
 
     RenderDevice::PassCommandLists& RenderDevice::CommandListsForPass(const RenderPassGraph::Node& node)
@@ -68,6 +73,10 @@ namespace PathFinder
         mPreRenderUploadsCommandList->Reset();
         mPreRenderUploadsCommandList->SetDebugName("Prerender Data Upload Cmd List");
         mEventTracker.StartGPUEvent("Prerender Data Upload", *mPreRenderUploadsCommandList);
+
+        mCopyQueueUploadsCommandList = mCommandListAllocator->AllocateCopyCommandList();
+        mCopyQueueUploadsCommandList->Reset();
+        mCopyQueueUploadsCommandList->SetDebugName("Copy Queue Data Upload Cmd List");
     }
 
     void RenderDevice::AllocateRTASBuildsCommandList()
@@ -82,6 +91,9 @@ namespace PathFinder
     {
         mFrameBlueprint.Build();
 
+        // Settings can be changed from UI at any moment, batching must stay the same until recording is done
+        mRecordingBatchPlan.Build(*mRenderPassGraph, mRecordingThreadCount, mPipelinesSettings->IsMultiThreadedRecordingEnabled);
+
         mPassHelpers.resize(mRenderPassGraph->NodesInGlobalExecutionOrder().size());
 
         for (const RenderPassGraph::Node* node : mRenderPassGraph->NodesInGlobalExecutionOrder())
@@ -90,16 +102,9 @@ namespace PathFinder
             mPassHelpers[node->GlobalExecutionIndex()] = PassHelpers{};
             PassHelpers& helpers = mPassHelpers[node->GlobalExecutionIndex()];
             helpers.ResourceStoragePassData = mResourceStorage->GetPerPassData(node->PassMetadata().Name);
-            helpers.ResourceStoragePassData->LastSetConstantBufferDataSize = 0;
-            helpers.ResourceStoragePassData->PassConstantBufferMemoryOffset = 0;
-            helpers.ResourceStoragePassData->IsAllowedToAdvanceConstantBufferOffset = false;
+            helpers.ResourceStoragePassData->PassConstantBufferAddress = 0;
         }
 
-        mPassWorkMeasurements.clear();
-        mPassWorkMeasurements.resize(mRenderPassGraph->NodesInGlobalExecutionOrder().size());
-
-        mPassBarrierMeasurements.clear();
-
         mGPUProfiler->SetPerQueueTimestampFrequencies(GetQueueTimestampFrequencies());
 
         // If memory layout did not change we reuse aliasing barriers from previous frame.
@@ -112,7 +117,8 @@ namespace PathFinder
 
         for (const RenderPassGraph::Node* node : mRenderPassGraph->NodesInGlobalExecutionOrder())
         {
-            CommandListPtrVariant cmdListVariant = AllocateCommandListForQueue(node->ExecutionQueueIndex);
+            // Command lists recorded on different threads must not share command allocators
+            CommandListPtrVariant cmdListVariant = AllocateCommandListForQueue(node->ExecutionQueueIndex, mRecordingBatchPlan.BatchIndex(*node));
             GetComputeCommandListBase(cmdListVariant)->SetDebugName(node->PassMetadata().Name.ToString() + " Worker Cmd List");
             mFrameBlueprint.GetRenderPassEvent(*node).CommandLists.WorkCommandList = std::move(cmdListVariant);
 
@@ -150,23 +156,48 @@ namespace PathFinder
 
         RecordNonWorkerCommandLists();
         TraverseAndExecuteFrameBlueprint();
+
+        // Marks the point where frame work on every queue is done.
+        // Copy queue uploads of the next frame wait for it before overwriting resources this frame reads.
+        mGraphicsQueueFence.IncrementExpectedValue();
+        mEventTracker.StartGPUEvent("Frame Work Done Signal", mGraphicsQueue);
+        mGraphicsQueue.SignalFence(mGraphicsQueueFence);
+        mEventTracker.EndGPUEvent(mGraphicsQueue);
     }
 
     void RenderDevice::GatherMeasurements()
     {
-        for (PipelineMeasurement& measurement : mPassWorkMeasurements)
+        // Completed events belong to the last frame finished by GPU, which could have been recorded with a different graph,
+        // so pass timings are matched to nodes of the current graph by pass names recorded with events
+        mPassWorkMeasurements.clear();
+        mPassBarrierMeasurements.clear();
+        mCompletedPassDurations.clear();
+
+        for (const GPUProfiler::Event& event : mGPUProfiler->CompletedEvents())
         {
-            const GPUProfiler::Event& event = mGPUProfiler->GetCompletedEvent(measurement.ProfilerEventID);
-            measurement.DurationSeconds = event.DurationSeconds;
+            if (event.Name == FrameMeasurementName)
+            {
+                mFrameMeasurement.DurationSeconds = event.DurationSeconds;
+            }
+            else if (event.Name == BarrierMeasurementName)
+            {
+                mPassBarrierMeasurements.push_back(PipelineMeasurement{ event.Name, event.DurationSeconds });
+            }
+            else
+            {
+                mCompletedPassDurations[event.Name] = event.DurationSeconds;
+            }
         }
 
-        for (PipelineMeasurement& measurement : mPassBarrierMeasurements)
+        for (const RenderPassGraph::Node* node : mRenderPassGraph->NodesInGlobalExecutionOrder())
         {
-            const GPUProfiler::Event& event = mGPUProfiler->GetCompletedEvent(measurement.ProfilerEventID);
-            measurement.DurationSeconds = event.DurationSeconds;
-        }
+            auto durationIt = mCompletedPassDurations.find(node->PassMetadata().Name);
 
-        mFrameMeasurement.DurationSeconds = mGPUProfiler->GetCompletedEvent(mFrameMeasurement.ProfilerEventID).DurationSeconds;
+            if (durationIt != mCompletedPassDurations.end())
+            {
+                mPassWorkMeasurements.push_back(PipelineMeasurement{ durationIt->first, durationIt->second });
+            }
+        }
     }
 
     void RenderDevice::RecordNonWorkerCommandLists()
@@ -319,10 +350,10 @@ namespace PathFinder
 
             ResourceReadbackInfo& readbackInfo = mPerNodeReadbackInfo[node->GlobalExecutionIndex()];
 
-            for (const Memory::CopyRequestManager::CopyRequest& request : mCopyRequestManager->ReadbackRequests())
+            for (Memory::CopyRequestManager::CopyRequest& request : mCopyRequestManager->ReadbackRequests())
             {
                 HAL::ResourceBarrierCollection toCopyBarriers = mResourceStateTracker->TransitionToStateImmediately(request.Resource, HAL::ResourceState::CopySource);
-                readbackInfo.CopyCommands.push_back(request.Command);
+                readbackInfo.CopyCommands.push_back(std::move(request.Command));
                 readbackInfo.ToCopyStateTransitions.AddBarriers(toCopyBarriers);
             }
 
@@ -343,8 +374,7 @@ namespace PathFinder
         transitionsCommandList->Reset();
         
         mEventTracker.StartGPUEvent(node.PassMetadata().Name.ToString() + " " + cmdListName, *transitionsCommandList);
-        GPUProfiler::EventID profilerEventID = mGPUProfiler->RecordEventStart(*transitionsCommandList, node.ExecutionQueueIndex);
-        mPassBarrierMeasurements.emplace_back(PipelineMeasurement{ "", profilerEventID, 0 });
+        GPUProfiler::EventID profilerEventID = mGPUProfiler->RecordEventStart(*transitionsCommandList, node.ExecutionQueueIndex, BarrierMeasurementName);
 
         transitionsCommandList->InsertBarriers(barriers);
 
@@ -377,8 +407,7 @@ namespace PathFinder
         transitionsCommandList->Reset();
         
         mEventTracker.StartGPUEvent(StringFormat("Rerouting Transitions for Dependency Level %d", currentDependencyLevelIndex), *transitionsCommandList);
-        GPUProfiler::EventID profilerEventID = mGPUProfiler->RecordEventStart(*transitionsCommandList, mostCompetentQueueIndex);
-        mPassBarrierMeasurements.emplace_back(PipelineMeasurement{ "", profilerEventID, 0 });
+        GPUProfiler::EventID profilerEventID = mGPUProfiler->RecordEventStart(*transitionsCommandList, mostCompetentQueueIndex, BarrierMeasurementName);
 
         transitionsCommandList->InsertBarriers(barriers);
 
@@ -579,8 +608,7 @@ namespace PathFinder
                 }
             }
 
-            GPUProfiler::EventID profilerEventID = mGPUProfiler->RecordEventStart(*cmdList, node->ExecutionQueueIndex);
-            mPassBarrierMeasurements.emplace_back(PipelineMeasurement{ "", profilerEventID, 0 });
+            GPUProfiler::EventID profilerEventID = mGPUProfiler->RecordEventStart(*cmdList, node->ExecutionQueueIndex, BarrierMeasurementName);
 
             // Then apply begin and back buffer barriers
             cmdList->InsertBarriers(barriers);
@@ -593,6 +621,21 @@ namespace PathFinder
 
     void RenderDevice::ExecuteUploadCommands()
     {
+        // Uploads may overwrite resources that the previous frame still reads on other queues,
+        // so copy queue waits for the end of all previously submitted frame work.
+        // Graphics queue in turn waits for uploads right before the frame starts consuming uploaded data.
+        mEventTracker.StartGPUEvent("Waiting Previous Frame on Copy Queue", mCopyQueue);
+        mCopyQueue.WaitFence(mGraphicsQueueFence);
+        mEventTracker.EndGPUEvent(mCopyQueue);
+
+        mCopyQueueFence.IncrementExpectedValue();
+        mCopyQueue.ExecuteCommandList(*mCopyQueueUploadsCommandList);
+        mCopyQueue.SignalFence(mCopyQueueFence);
+
+        mEventTracker.StartGPUEvent("Waiting Data Upload on Copy Queue", mGraphicsQueue);
+        mGraphicsQueue.WaitFence(mCopyQueueFence);
+        mEventTracker.EndGPUEvent(mGraphicsQueue);
+
         // Run initial upload commands
         mGraphicsQueueFence.IncrementExpectedValue();
         // Transition uploaded resources to readable states
@@ -677,7 +720,7 @@ namespace PathFinder
         Memory::PoolCommandListAllocator::GraphicsCommandListPtr frameMeasurementsStartCmdList = mCommandListAllocator->AllocateGraphicsCommandList();
         auto graphicQueueIndex = std::underlying_type_t<RenderPassExecutionQueue>(RenderPassExecutionQueue::Graphics);
         frameMeasurementsStartCmdList->Reset();
-        mFrameMeasurement.ProfilerEventID = mGPUProfiler->RecordEventStart(*frameMeasurementsStartCmdList, graphicQueueIndex);
+        mFrameProfilerEventID = mGPUProfiler->RecordEventStart(*frameMeasurementsStartCmdList, graphicQueueIndex, FrameMeasurementName);
         frameMeasurementsStartCmdList->Close();
         commandLists[graphicQueueIndex].push_back(std::move(frameMeasurementsStartCmdList));
 
@@ -768,7 +811,7 @@ namespace PathFinder
         // Measure frame end
         Memory::PoolCommandListAllocator::GraphicsCommandListPtr frameMeasurementsEndCmdList = mCommandListAllocator->AllocateGraphicsCommandList();
         frameMeasurementsEndCmdList->Reset();
-        mGPUProfiler->RecordEventEnd(*frameMeasurementsEndCmdList, mFrameMeasurement.ProfilerEventID);
+        mGPUProfiler->RecordEventEnd(*frameMeasurementsEndCmdList, mFrameProfilerEventID);
         mGPUProfiler->ReadbackEvents(*frameMeasurementsEndCmdList);
         frameMeasurementsEndCmdList->Close();
         commandLists[graphicQueueIndex].push_back(std::move(frameMeasurementsEndCmdList));
@@ -826,11 +869,11 @@ namespace PathFinder
         return 0;
     }
 
-    RenderDevice::CommandListPtrVariant RenderDevice::AllocateCommandListForQueue(uint64_t queueIndex) const
+    RenderDevice::CommandListPtrVariant RenderDevice::AllocateCommandListForQueue(uint64_t queueIndex, uint64_t threadIndex) const
     {
         return queueIndex == 0 ? 
-            CommandListPtrVariant{ mCommandListAllocator->AllocateGraphicsCommandList() } :
-            CommandListPtrVariant{ mCommandListAllocator->AllocateComputeCommandList() };
+            CommandListPtrVariant{ mCommandListAllocator->AllocateGraphicsCommandList(threadIndex) } :
+            CommandListPtrVariant{ mCommandListAllocator->AllocateComputeCommandList(threadIndex) };
     }
 
     HAL::ComputeCommandListBase* RenderDevice::GetComputeCommandListBase(CommandListPtrVariant& variant) const
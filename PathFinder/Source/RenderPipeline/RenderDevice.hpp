@@ -7,6 +7,7 @@
 #include "GPUProfiler.hpp"
 #include "GPUDataInspector.hpp"
 #include "PipelineSettings.hpp"
+#include "RecordingBatchPlan.hpp"
 
 #include <Foundation/Name.hpp>
 #include <Utility/EventTracker.hpp>
@@ -43,11 +44,13 @@ namespace PathFinder
         
         struct PipelineMeasurement
         {
-            std::string Name;
-            GPUProfiler::EventID ProfilerEventID;
-            float DurationSeconds;
+            Foundation::Name Name;
+            float DurationSeconds = 0.0f;
         };
 
+        inline static const Foundation::Name FrameMeasurementName = "Total Frame Time";
+        inline static const Foundation::Name BarrierMeasurementName = "Barriers";
+
         struct PassCommandLists
         {
             // A command list to execute transition barriers before render pass work.
@@ -93,7 +96,8 @@ namespace PathFinder
             GPUDataInspector* gpuDataInspector,
             const RenderPassGraph* renderPassGraph,
             const RenderSurfaceDescription& defaultRenderSurface,
-            const PipelineSettings* settings
+            const PipelineSettings* settings,
+            uint64_t recordingThreadCount
         );
 
         PassCommandLists& CommandListsForPass(const RenderPassGraph::Node& node);
@@ -226,7 +230,7 @@ namespace PathFinder
         HAL::CommandQueue& GetCommandQueue(uint64_t queueIndex);
         uint64_t FindMostCompetentQueueIndex(const robin_hood::unordered_flat_set<RenderPassGraph::Node::QueueIndex>& queueIndices) const;
         uint64_t FindQueueSupportingTransition(HAL::ResourceState beforeStates, HAL::ResourceState afterStates) const;
-        CommandListPtrVariant AllocateCommandListForQueue(uint64_t queueIndex) const;
+        CommandListPtrVariant AllocateCommandListForQueue(uint64_t queueIndex, uint64_t threadIndex = 0) const;
         bool IsNullCommandList(CommandListPtrVariant& variant) const;
         HAL::Fence& FenceForQueueIndex(uint64_t index);
         std::vector<uint64_t> GetQueueTimestampFrequencies();
@@ -256,17 +260,22 @@ namespace PathFinder
 
         Memory::Texture* mBackBuffer = nullptr;
         Memory::PoolCommandListAllocator::GraphicsCommandListPtr mPreRenderUploadsCommandList;
+        Memory::PoolCommandListAllocator::CopyCommandListPtr mCopyQueueUploadsCommandList;
         Memory::PoolCommandListAllocator::ComputeCommandListPtr mRTASBuildsCommandList;
         std::vector<PassHelpers> mPassHelpers;
         HAL::GraphicsCommandQueue mGraphicsQueue;
         HAL::ComputeCommandQueue mComputeQueue;
+        HAL::CopyCommandQueue mCopyQueue;
 
         HAL::Fence mGraphicsQueueFence;
         HAL::Fence mComputeQueueFence;
+        HAL::Fence mCopyQueueFence;
         HAL::Fence mBVHFence;
 
         uint64_t mQueueCount = 2;
         uint64_t mBVHBuildsQueueIndex = 1;
+        uint64_t mRecordingThreadCount = 1;
+        RecordingBatchPlan mRecordingBatchPlan;
 
         FrameBlueprint mFrameBlueprint;
 
@@ -294,20 +303,24 @@ namespace PathFinder
         // Collect readback requests to be executed after passes that require them
         std::vector<ResourceReadbackInfo> mPerNodeReadbackInfo;
 
-        // An hierarchy of various measured GPU events
+        // An hierarchy of various measured GPU events of the last completed frame
         std::vector<PipelineMeasurement> mPassWorkMeasurements;
         std::vector<PipelineMeasurement> mPassBarrierMeasurements;
         PipelineMeasurement mFrameMeasurement;
+        GPUProfiler::EventID mFrameProfilerEventID = 0;
+        robin_hood::unordered_flat_map<Foundation::Name, float> mCompletedPassDurations;
 
     public:
         inline HAL::GraphicsCommandQueue& GraphicsCommandQueue() { return mGraphicsQueue; }
         inline HAL::ComputeCommandQueue& ComputeCommandQueue() { return mComputeQueue; }
         inline HAL::GraphicsCommandList* PreRenderUploadsCommandList() { return mPreRenderUploadsCommandList.get(); }
+        inline HAL::CopyCommandList* CopyQueueUploadsCommandList() { return mCopyQueueUploadsCommandList.get(); }
         inline HAL::ComputeCommandList* RTASBuildsCommandList() { return mRTASBuildsCommandList.get(); }
         inline const RenderSurfaceDescription& DefaultRenderSurfaceDesc() { return mDefaultRenderSurface; }
         inline const auto& RenderPassWorkMeasurements() const { return mPassWorkMeasurements; }
         inline const auto& RenderPassBarrierMeasurements() const { return mPassBarrierMeasurements; }
         inline const PipelineMeasurement& FrameMeasurement() const { return mFrameMeasurement; }
+        inline const RecordingBatchPlan& RecordingBatches() const { return mRecordingBatchPlan; }
     };
 
 }
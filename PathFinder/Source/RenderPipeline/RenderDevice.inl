@@ -12,10 +12,7 @@ namespace PathFinder
         const std::string& passName = passNode.PassMetadata().Name.ToString();
         mEventTracker.StartGPUEvent(passName, *worker);
 
-        GPUProfiler::EventID profilerEventID = mGPUProfiler->RecordEventStart(*worker, passNode.ExecutionQueueIndex);
-        PipelineMeasurement& measurement = mPassWorkMeasurements[passNode.GlobalExecutionIndex()];
-        measurement.Name = passName;
-        measurement.ProfilerEventID = profilerEventID;
+        GPUProfiler::EventID profilerEventID = mGPUProfiler->RecordEventStart(*worker, passNode.ExecutionQueueIndex, passNode.PassMetadata().Name);
 
         if (worker->AftermathHandle())
         {
@@ -12,14 +12,17 @@
 
 #include <Scene/Scene.hpp>
 #include <Foundation/Event.hpp>
+#include <Foundation/ThreadPool.hpp>
 #include <IO/CommandLineParser.hpp>
 #include <Utility/AftermathCrashTracker.hpp>
 
-#include <Memory/SegregatedPoolsResourceAllocator.hpp>
+#include <Memory/PlacedResourceAllocator.hpp>
 #include <Memory/PoolDescriptorAllocator.hpp>
 #include <Memory/ResourceStateTracker.hpp>
 #include <Memory/GPUResourceProducer.hpp>
 #include <Memory/CopyRequestManager.hpp>
+#include <Memory/StagingRing.hpp>
+#include <Memory/TransientLinearAllocator.hpp>
 
 #include "RenderPassMediators/ResourceScheduler.hpp"
 #include "RenderPassMediators/RootConstantsUpdater.hpp"
@@ -36,6 +39,7 @@
 #include "PipelineStateManager.hpp"
 #include "RenderContext.hpp"
 #include "RenderPassGraph.hpp"
+#include "AsyncComputeScheduler.hpp"
 #include "BottomRTAS.hpp"
 #include "TopRTAS.hpp"
 #include "GPUProfiler.hpp"
@@ -81,8 +85,10 @@ namespace PathFinder
         void RecordCommandLists();
         void ScheduleFrame();
         void UpdateBackBuffers();
+        void UpdateAsyncComputeAssignment();
 
         RenderPassGraph mRenderPassGraph;
+        AsyncComputeScheduler mAsyncComputeScheduler;
 
         uint8_t mCurrentBackBufferIndex = 0;
         uint8_t mSimultaneousFramesInFlight = 2;
@@ -95,10 +101,14 @@ namespace PathFinder
 
         std::unique_ptr<HAL::Device> mDevice;
 
-        std::unique_ptr<Memory::SegregatedPoolsResourceAllocator> mResourceAllocator;
+        std::unique_ptr<Memory::PlacedResourceAllocator> mResourceAllocator;
         std::unique_ptr<Memory::PoolCommandListAllocator> mCommandListAllocator;
         std::unique_ptr<Memory::PoolDescriptorAllocator> mDescriptorAllocator;
         std::unique_ptr<Memory::ResourceStateTracker> mResourceStateTracker;
+        std::unique_ptr<HAL::Buffer> mStagingBuffer;
+        std::unique_ptr<Memory::StagingRing> mStagingRing;
+        std::unique_ptr<HAL::Buffer> mTransientBuffer;
+        std::unique_ptr<Memory::TransientLinearAllocator> mTransientAllocator;
         std::unique_ptr<Memory::CopyRequestManager> mCopyRequestManager;
         std::unique_ptr<Memory::GPUResourceProducer> mResourceProducer;
 
@@ -119,6 +129,7 @@ namespace PathFinder
 
         std::unique_ptr<HAL::SwapChain> mSwapChain;
         std::unique_ptr<FrameFence> mFrameFence;
+        std::unique_ptr<Foundation::ThreadPool> mWorkerThreadPool;
 
         HAL::DisplayAdapter* mSelectedAdapter = nullptr;
         ContentMediator* mContentMediator = nullptr;
@@ -135,12 +146,14 @@ namespace PathFinder
         inline PipelineResourceStorage* ResourceStorage() { return mPipelineResourceStorage.get(); }
         inline const RenderSurfaceDescription& RenderSurface() const { return mRenderSurfaceDescription; }
         inline Memory::GPUResourceProducer* ResourceProducer() { return mResourceProducer.get(); }
+        inline const Memory::PoolDescriptorAllocator* DescriptorAllocator() const { return mDescriptorAllocator.get(); }
         inline const RenderDevice* RendererDevice() const { return mRenderDevice.get(); }
         inline const GPUDataInspector* GPUInspector() const { return mGPUDataInspector.get(); }
         inline const RenderPassGraph* RenderGraph() const { return &mRenderPassGraph; }
         inline HAL::Device* Device() { return mDevice.get(); }
         inline HAL::SwapChain* SwapChain() { return mSwapChain.get(); }
         inline HAL::DisplayAdapter* SelectedAdapter() { return mSelectedAdapter; }
+        inline Foundation::ThreadPool* WorkerThreadPool() { return mWorkerThreadPool.get(); }
         inline Event& PreRenderEvent() { return mPreRenderEvent; }
         inline Event& PostRenderEvent() { return mPostRenderEvent; }
         inline uint64_t FrameDurationUS() const { return mFrameDuration.count(); }
@@ -35,10 +35,23 @@ namespace PathFinder
         
         mPassUtilityProvider = std::make_unique<RenderPassUtilityProvider>(RenderPassUtilityProvider{ 0, mRenderSurfaceDescription });
         mResourceStateTracker = std::make_unique<Memory::ResourceStateTracker>();
-        mResourceAllocator = std::make_unique<Memory::SegregatedPoolsResourceAllocator>(mDevice.get(), mSimultaneousFramesInFlight);
+        mResourceAllocator = std::make_unique<Memory::PlacedResourceAllocator>(mDevice.get(), mSimultaneousFramesInFlight);
         mCommandListAllocator = std::make_unique<Memory::PoolCommandListAllocator>(mDevice.get(), mSimultaneousFramesInFlight);
         mDescriptorAllocator = std::make_unique<Memory::PoolDescriptorAllocator>(mDevice.get(), mSimultaneousFramesInFlight);
-        mCopyRequestManager = std::make_unique<Memory::CopyRequestManager>();
+
+        uint64_t stagingRingSize = 64 * 1024 * 1024;
+        mStagingBuffer = std::make_unique<HAL::Buffer>(*mDevice, HAL::BufferProperties::Create<uint8_t>(stagingRingSize), HAL::CPUAccessibleHeapType::Upload);
+        mStagingBuffer->SetDebugName("Upload Staging Ring");
+        // No need to unmap as upload buffers can be mapped persistently
+        mStagingRing = std::make_unique<Memory::StagingRing>(mStagingBuffer.get(), mStagingBuffer->Map(), stagingRingSize);
+
+        mCopyRequestManager = std::make_unique<Memory::CopyRequestManager>(mStagingRing.get());
+
+        uint64_t transientMemorySize = 16 * 1024 * 1024;
+        mTransientBuffer = std::make_unique<HAL::Buffer>(*mDevice, HAL::BufferProperties::Create<uint8_t>(transientMemorySize), HAL::CPUAccessibleHeapType::Upload);
+        mTransientBuffer->SetDebugName("Transient Linear Allocator");
+        mTransientAllocator = std::make_unique<Memory::TransientLinearAllocator>(
+            mTransientBuffer->Map(), mTransientBuffer->GPUVirtualAddress(), transientMemorySize, 16 * 1024);
 
         mResourceProducer = std::make_unique<Memory::GPUResourceProducer>(
             mDevice.get(), 
@@ -52,6 +65,7 @@ namespace PathFinder
             mResourceProducer.get(), 
             mDescriptorAllocator.get(), 
             mResourceStateTracker.get(), 
+            mTransientAllocator.get(),
             mRenderSurfaceDescription, 
             &mRenderPassGraph);
 
@@ -72,13 +86,15 @@ namespace PathFinder
             mDevice.get(),
             mShaderManager.get(), 
             mResourceProducer.get(), 
-            mRenderSurfaceDescription);
+            mRenderSurfaceDescription,
+            commandLineParser.ExecutableFolderPath());
 
         mPipelineStateCreator = std::make_unique<PipelineStateCreator>(mPipelineStateManager.get());
         mRootSignatureCreator = std::make_unique<RootSignatureCreator>(mPipelineStateManager.get());
         mSamplerCreator = std::make_unique<SamplerCreator>(mPipelineResourceStorage.get());
         mGPUProfiler = std::make_unique<GPUProfiler>(*mDevice, 1024, mSimultaneousFramesInFlight, mResourceProducer.get());
         mGPUDataInspector = std::make_unique<GPUDataInspector>();
+        mWorkerThreadPool = std::make_unique<Foundation::ThreadPool>();
 
         mRenderDevice = std::make_unique<RenderDevice>(
             *mDevice,
@@ -92,7 +108,8 @@ namespace PathFinder
             mGPUDataInspector.get(),
             &mRenderPassGraph, 
             mRenderSurfaceDescription,
-            &mPipelineSettings);
+            &mPipelineSettings,
+            mWorkerThreadPool->ThreadCount());
 
         mSwapChain = std::make_unique<HAL::SwapChain>(
             &hwAdapter->Displays().front(),
@@ -204,6 +221,7 @@ namespace PathFinder
         // Gather extracted measurement
         mRenderDevice->GatherMeasurements();
         mGPUDataInspector->DecodeAvailableInspectionData();
+        UpdateAsyncComputeAssignment();
 
         // Notify external listeners
         mPostRenderEvent.Raise();
@@ -239,6 +257,8 @@ namespace PathFinder
         mResourceAllocator->EndFrame(completedFrameNumber);
         mDescriptorAllocator->EndFrame(completedFrameNumber);
         mCommandListAllocator->EndFrame(completedFrameNumber);
+        mStagingRing->EndFrame(completedFrameNumber);
+        mTransientAllocator->EndFrame(completedFrameNumber);
         mPipelineResourceStorage->EndFrame();
         mGPUProfiler->EndFrame(completedFrameNumber);
 
@@ -261,9 +281,22 @@ namespace PathFinder
     void RenderEngine<ContentMediator>::PerformPreRenderUploads()
     {
         mRenderDevice->AllocateUploadCommandList();
-        RecordUploadRequests(*mRenderDevice->PreRenderUploadsCommandList(), *mResourceStateTracker, *mCopyRequestManager, true);
+
+        RecordUploadRequests(
+            *mRenderDevice->CopyQueueUploadsCommandList(),
+            *mRenderDevice->PreRenderUploadsCommandList(),
+            *mResourceStateTracker,
+            *mCopyRequestManager,
+            true);
+
+        mRenderDevice->CopyQueueUploadsCommandList()->Close();
         mRenderDevice->PreRenderUploadsCommandList()->Close();
 
+        // Staging memory written this frame is in use until the frame fence passes current frame
+        mStagingRing->FinishCurrentFrame(mFrameFence->HALFence().ExpectedValue());
+        // Constants are written during recording, which is finished by now
+        mTransientAllocator->FinishCurrentFrame(mFrameFence->HALFence().ExpectedValue());
+
         assert_format(mCopyRequestManager->ReadbackRequests().empty(), "We shouldn't have any readback requests at this stage");
     }
 
@@ -310,7 +343,7 @@ namespace PathFinder
             });
         };
 
-        for (const RenderPassGraph::Node* passNode : mRenderPassGraph.NodesInGlobalExecutionOrder())
+        auto recordNode = [this, &recordCommandList](const RenderPassGraph::Node* passNode)
         {
             if (auto passHelpers = mRenderPassContainer->GetRenderPass(passNode->PassMetadata().Name))
             {
@@ -320,7 +353,11 @@ namespace PathFinder
             {
                 recordCommandList(passHelpers, *passNode);
             }
-        }
+        };
+
+        // Nodes inside a dependency level are independent, so each level is recorded in parallel by contiguous batches.
+        // Command lists are stored per node and executed in graph order, which keeps the submission order deterministic.
+        mRenderDevice->RecordingBatches().Record(*mWorkerThreadPool, recordNode);
     }
 
     template <class ContentMediator>
@@ -380,6 +417,9 @@ namespace PathFinder
 
         mPipelineResourceStorage->EndResourceScheduling();
 
+        // Move passes between graphics and async compute queues as cost model suggests
+        mAsyncComputeScheduler.AssignQueues(mRenderPassGraph);
+
         // Finish graph and allocate memory 
         mRenderPassGraph.Build();
         mPipelineResourceStorage->OptimizeScheduledResourceStates(mRenderPassGraph);
@@ -400,6 +440,18 @@ namespace PathFinder
         }
     }
 
+    template <class ContentMediator>
+    void RenderEngine<ContentMediator>::UpdateAsyncComputeAssignment()
+    {
+        // Measurements are keyed by pass names, passes that have no completed measurement yet are absent
+        for (const RenderDevice::PipelineMeasurement& measurement : mRenderDevice->RenderPassWorkMeasurements())
+        {
+            mAsyncComputeScheduler.AddPassTiming(measurement.Name, measurement.DurationSeconds);
+        }
+
+        mAsyncComputeScheduler.EndFrame(mRenderPassGraph);
+    }
+
     template <class ContentMediator> 
     template <class Constants>
     void RenderEngine<ContentMediator>::SetFrameRootConstants(const Constants& constants)
@@ -1,7 +1,9 @@
 #include "RenderPassGraph.hpp"
 
-#include "RenderPass.hpp"
-
+#include <unordered_set>
+#include <algorithm>
+#include <tuple>
+#include <iterator>
 
 
 namespace PathFinder
@@ -40,9 +42,20 @@ namespace PathFinder
         return it->second;
     }
 
+    const RenderPassGraph::SubresourceReaderList& RenderPassGraph::GetNodesThatReadSubresource(SubresourceName subresourceName) const
+    {
+        auto it = mSubresourceReaders.find(subresourceName);
+        assert_format(it != mSubresourceReaders.end(), "Subresource ", DecodeSubresourceName(subresourceName).first.ToString(), " is not registered for reading in the graph.");
+        return it->second;
+    }
+
     uint64_t RenderPassGraph::AddPass(const RenderPassMetadata& passMetadata)
     {
         EnsureRenderPassUniqueness(passMetadata.Name);
+
+        // Node storage may be reallocated, which invalidates node pointers in compilation results
+        mCompiledGraphHash = std::nullopt;
+
         mPassNodes.emplace_back(Node{ passMetadata, &mGlobalWriteDependencyRegistry });
         mPassNodes.back().mIndexInUnorderedList = mPassNodes.size() - 1;
         return mPassNodes.size() - 1;
@@ -50,21 +63,63 @@ namespace PathFinder
 
     void RenderPassGraph::Build()
     {
+        uint64_t graphHash = ComputeStructuralHash();
+
+        // Set of passes and their dependencies rarely changes between frames,
+        // so previous compilation results can be reused in most cases
+        mIsLastBuildCached = mCompiledGraphHash && *mCompiledGraphHash == graphHash;
+
+        if (mIsLastBuildCached)
+            return;
+
+        ClearCompiledState();
         BuildAdjacencyLists();
         TopologicalSort();
         BuildDependencyLevels();
         FinalizeDependencyLevels();
         CullRedundantSynchronizations();
+
+        mCompiledGraphHash = graphHash;
     }
 
     void RenderPassGraph::Clear()
     {
+        // Only clear data that is rescheduled every frame. 
+        // Compilation results are kept around for Build() to decide whether they can be reused.
         mGlobalWriteDependencyRegistry.clear();
+
+        for (Node& node : mPassNodes)
+        {
+            node.Clear();
+        }
+    }
+
+    uint64_t RenderPassGraph::ComputeStructuralHash() const
+    {
+        // Resource properties (formats, dimensions, memory requirements) are deliberately left out.
+        // Compilation results only depend on passes, their queues and subresource read/write sets,
+        // while property changes are detected by PipelineResourceStorage, which diffs scheduled
+        // resources against the previous frame and reruns memory aliasing and allocation on its own.
+        // A change in subresource count still changes the hash through subresource names.
+        uint64_t hash = robin_hood::hash_int(mPassNodes.size());
+
+        for (const Node& node : mPassNodes)
+        {
+            hash ^= node.ComputeStructuralHash() + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        }
+
+        return hash;
+    }
+
+    void RenderPassGraph::ClearCompiledState()
+    {
         mDependencyLevels.clear();
         mResourceUsageTimelines.clear();
         mQueueNodeCounters.clear();
         mTopologicallySortedNodes.clear();
         mNodesInGlobalExecutionOrder.clear();
+        mWrittenSubresourceToPassMap.clear();
+        mSubresourceReaders.clear();
         mAdjacencyLists.clear();
         mDetectedQueueCount = 1;
         mNodesPerQueue.clear();
@@ -72,7 +127,7 @@ namespace PathFinder
 
         for (Node& node : mPassNodes)
         {
-            node.Clear();
+            node.ClearCompiledState();
         }
     }
 
@@ -88,54 +143,66 @@ namespace PathFinder
     {
         mAdjacencyLists.resize(mPassNodes.size());
 
-        for (auto nodeIdx = 0; nodeIdx < mPassNodes.size(); ++nodeIdx)
+        // Index writers and readers first, so that each read can be resolved to its writer directly
+        // instead of testing every node against every other node
+        for (const Node& node : mPassNodes)
         {
-            Node& node = mPassNodes[nodeIdx];
+            for (SubresourceName writtenSubresource : node.WrittenSubresources())
+            {
+                mWrittenSubresourceToPassMap[writtenSubresource] = &node;
+            }
 
-            if (!node.HasAnyDependencies())
+            for (SubresourceName readSubresource : node.ReadSubresources())
             {
-                continue;
+                mSubresourceReaders[readSubresource].push_back(&node);
             }
+        }
 
-            std::vector<uint64_t>& adjacentNodeIndices = mAdjacencyLists[nodeIdx];
+        for (auto nodeIdx = 0; nodeIdx < mPassNodes.size(); ++nodeIdx)
+        {
+            const Node& node = mPassNodes[nodeIdx];
 
-            for (auto otherNodeIdx = 0; otherNodeIdx < mPassNodes.size(); ++otherNodeIdx)
+            // If node reads a subresource written by another node, then it depends on that node and is its adjacent dependency
+            auto establishAdjacency = [&](SubresourceName readSubresource)
             {
-                // Do not check dependencies on itself
-                if (nodeIdx == otherNodeIdx) continue;
+                auto writerIt = mWrittenSubresourceToPassMap.find(readSubresource);
 
-                Node& otherNode = mPassNodes[otherNodeIdx];
+                // Do not check dependencies on itself
+                if (writerIt == mWrittenSubresourceToPassMap.end() || writerIt->second == &node)
+                    return;
 
-                auto establishAdjacency = [&](SubresourceName otherNodeReadResource) -> bool
-                {
-                    // If other node reads a subresource written by the current node, then it depends on current node and is an adjacent dependency
-                    bool otherNodeDependsOnCurrentNode =
-                        node.WrittenSubresources().find(otherNodeReadResource) != node.WrittenSubresources().end();
+                mAdjacencyLists[writerIt->second->mIndexInUnorderedList].push_back(nodeIdx);
+            };
 
-                    if (otherNodeDependsOnCurrentNode)
-                    {
-                        adjacentNodeIndices.push_back(otherNodeIdx);
+            for (SubresourceName readSubresource : node.ReadSubresources())
+            {
+                establishAdjacency(readSubresource);
+            }
 
-                        if (node.ExecutionQueueIndex != otherNode.ExecutionQueueIndex)
-                        {
-                            node.mSyncSignalRequired = true;
-                            otherNode.mNodesToSyncWith.push_back(&node);
-                        }
+            for (SubresourceName aliasedSubresource : node.mAliasedSubresources)
+            {
+                establishAdjacency(aliasedSubresource);
+            }
+        }
 
-                        return true;
-                    }
+        for (auto nodeIdx = 0; nodeIdx < mPassNodes.size(); ++nodeIdx)
+        {
+            Node& node = mPassNodes[nodeIdx];
+            std::vector<uint64_t>& adjacentNodeIndices = mAdjacencyLists[nodeIdx];
 
-                    return false;
-                };
+            // Nodes reading multiple subresources of the same writer are registered once.
+            // Keep adjacent nodes ordered by their index to preserve deterministic topological sort.
+            std::sort(adjacentNodeIndices.begin(), adjacentNodeIndices.end());
+            adjacentNodeIndices.erase(std::unique(adjacentNodeIndices.begin(), adjacentNodeIndices.end()), adjacentNodeIndices.end());
 
-                for (SubresourceName otherNodeReadResource : otherNode.ReadSubresources())
-                {
-                    if (establishAdjacency(otherNodeReadResource)) break;
-                }
+            for (uint64_t adjacentNodeIdx : adjacentNodeIndices)
+            {
+                Node& adjacentNode = mPassNodes[adjacentNodeIdx];
 
-                for (SubresourceName otherNodeReadResource : otherNode.mAliasedSubresources)
+                if (node.ExecutionQueueIndex != adjacentNode.ExecutionQueueIndex)
                 {
-                    if (establishAdjacency(otherNodeReadResource)) break;
+                    node.mSyncSignalRequired = true;
+                    adjacentNode.mNodesToSyncWith.push_back(&node);
                 }
             }
         }
@@ -243,23 +310,10 @@ namespace PathFinder
         {
             uint64_t localExecutionIndex = 0;
 
-            std::unordered_map<SubresourceName, std::unordered_set<Node::QueueIndex>> resourceReadingQueueTracker;
             dependencyLevel.mNodesPerQueue.resize(mDetectedQueueCount);
 
             for (Node* node : dependencyLevel.mNodes)
             {
-                // Track which resource is read by which queue in this dependency level
-                for (SubresourceName subresourceName : node->ReadSubresources())
-                {
-                    resourceReadingQueueTracker[subresourceName].insert(node->ExecutionQueueIndex);
-                }
-
-                // Associate written subresource with render pass that writes to it for quick access when needed
-                for (SubresourceName subresourceName : node->WrittenSubresources())
-                {
-                    mWrittenSubresourceToPassMap[subresourceName] = node;
-                }
-
                 node->mGlobalExecutionIndex = globalExecutionIndex;
                 node->mLocalToDependencyLevelExecutionIndex = localExecutionIndex;
                 node->mLocalToQueueExecutionIndex = mQueueNodeCounters[node->ExecutionQueueIndex]++;
@@ -304,19 +358,38 @@ namespace PathFinder
                 localExecutionIndex++;
                 globalExecutionIndex++;
             }
+        }
+
+        auto readerOrder = [](const Node* first, const Node* second)
+        {
+            return std::tie(first->mDependencyLevelIndex, first->ExecutionQueueIndex, first->mGlobalExecutionIndex) <
+                std::tie(second->mDependencyLevelIndex, second->ExecutionQueueIndex, second->mGlobalExecutionIndex);
+        };
+
+        // Order readers by dependency level and queue, so that readers from the same level form
+        // a run sorted by queue and reads from multiple queues are found without per-level lookups
+        for (auto& [subresourceName, readers] : mSubresourceReaders)
+        {
+            std::sort(readers.begin(), readers.end(), readerOrder);
 
-            // Record queue indices that are detected to read common resources
-            for (auto& [subresourceName, queueIndices] : resourceReadingQueueTracker)
+            for (auto runBegin = readers.begin(); runBegin != readers.end();)
             {
-                // If resource is read by more than one queue
-                if (queueIndices.size() > 1)
+                uint64_t levelIndex = (*runBegin)->mDependencyLevelIndex;
+                auto runEnd = std::find_if(runBegin, readers.end(), [levelIndex](const Node* reader) { return reader->mDependencyLevelIndex != levelIndex; });
+
+                // If subresource is read by more than one queue in this dependency level
+                if ((*runBegin)->ExecutionQueueIndex != (*std::prev(runEnd))->ExecutionQueueIndex)
                 {
-                    for (Node::QueueIndex queueIndex : queueIndices)
+                    DependencyLevel& dependencyLevel = mDependencyLevels[levelIndex];
+                    dependencyLevel.mSubresourcesReadByMultipleQueues.insert(subresourceName);
+
+                    for (auto readerIt = runBegin; readerIt != runEnd; ++readerIt)
                     {
-                        dependencyLevel.mQueuesInvoledInCrossQueueResourceReads.insert(queueIndex);
-                        dependencyLevel.mSubresourcesReadByMultipleQueues.insert(subresourceName);
+                        dependencyLevel.mQueuesInvoledInCrossQueueResourceReads.insert((*readerIt)->ExecutionQueueIndex);
                     }
                 }
+
+                runBegin = runEnd;
             }
         }
     }
@@ -594,14 +667,45 @@ namespace PathFinder
         mReadAndWrittenSubresources.clear();
         mAllResources.clear();
         mAliasedSubresources.clear();
+        ExecutionQueueIndex = 0;
+        UsesRayTracing = false;
+        IsAsyncComputeEligible = false;
+    }
+
+    void RenderPassGraph::Node::ClearCompiledState()
+    {
         mNodesToSyncWith.clear();
         mSynchronizationIndexSet.clear();
         mDependencyLevelIndex = 0;
         mSyncSignalRequired = false;
-        ExecutionQueueIndex = 0;
-        UsesRayTracing = false;
         mGlobalExecutionIndex = 0;
         mLocalToDependencyLevelExecutionIndex = 0;
+        mLocalToQueueExecutionIndex = 0;
+    }
+
+    uint64_t RenderPassGraph::Node::ComputeStructuralHash() const
+    {
+        // Subresource sets are unordered, so their elements are combined in an order-independent way
+        auto hashSubresourceSet = [](const robin_hood::unordered_flat_set<SubresourceName>& set, uint64_t salt)
+        {
+            uint64_t setHash = robin_hood::hash_int(set.size() ^ salt);
+
+            for (SubresourceName name : set)
+            {
+                setHash += robin_hood::hash_int(name ^ salt);
+            }
+
+            return setHash;
+        };
+
+        uint64_t hash = robin_hood::hash_int(mPassMetadata.Name.ToId());
+        hash ^= robin_hood::hash_int(ExecutionQueueIndex) + (hash << 6) + (hash >> 2);
+        hash ^= robin_hood::hash_int(UsesRayTracing) + (hash << 6) + (hash >> 2);
+        hash ^= hashSubresourceSet(mReadSubresources, 0x1) + (hash << 6) + (hash >> 2);
+        hash ^= hashSubresourceSet(mWrittenSubresources, 0x2) + (hash << 6) + (hash >> 2);
+        hash ^= hashSubresourceSet(mAliasedSubresources, 0x3) + (hash << 6) + (hash >> 2);
+
+        return hash;
     }
 
     void RenderPassGraph::Node::EnsureSingleWriteDependency(SubresourceName name)
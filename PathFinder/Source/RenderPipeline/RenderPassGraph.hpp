@@ -24,6 +24,11 @@ namespace PathFinder
         using SubresourceName = uint64_t;
         using WriteDependencyRegistry = robin_hood::unordered_flat_map<SubresourceName, Foundation::Name>;
 
+        class Node;
+
+        // Readers of a subresource ordered by dependency level, then queue, then execution order
+        using SubresourceReaderList = std::vector<const Node*>;
+
         class Node
         {
         public:
@@ -52,6 +57,9 @@ namespace PathFinder
             uint64_t ExecutionQueueIndex = 0;
             bool UsesRayTracing = false;
 
+            // Pass only uses compute work and may be moved between graphics and async compute queues
+            bool IsAsyncComputeEligible = false;
+
         private:
             using SynchronizationIndexSet = std::vector<uint64_t>;
             inline static const uint64_t InvalidSynchronizationIndex = std::numeric_limits<uint64_t>::max();
@@ -60,6 +68,8 @@ namespace PathFinder
 
             void EnsureSingleWriteDependency(SubresourceName name);
             void Clear();
+            void ClearCompiledState();
+            uint64_t ComputeStructuralHash() const;
 
             uint64_t mGlobalExecutionIndex = 0;
             uint64_t mDependencyLevelIndex = 0;
@@ -137,9 +147,12 @@ namespace PathFinder
         uint64_t NodeCountForQueue(uint64_t queueIndex) const;
         const ResourceUsageTimeline& GetResourceUsageTimeline(Foundation::Name resourceName) const;
         const Node* GetNodeThatWritesToSubresource(SubresourceName subresourceName) const;
+        const SubresourceReaderList& GetNodesThatReadSubresource(SubresourceName subresourceName) const;
 
         uint64_t AddPass(const RenderPassMetadata& passMetadata);
 
+        // Compiles the graph, reusing results of the previous compilation
+        // if passes and their dependencies didn't change since then
         void Build();
         void Clear();
 
@@ -150,6 +163,7 @@ namespace PathFinder
         using QueueNodeCounters = robin_hood::unordered_flat_map<uint64_t, uint64_t>;
         using AdjacencyLists = std::vector<std::vector<uint64_t>>;
         using WrittenSubresourceToPassMap = robin_hood::unordered_flat_map<SubresourceName, const Node*>;
+        using SubresourceReaderMap = robin_hood::unordered_flat_map<SubresourceName, SubresourceReaderList>;
 
         struct SyncCoverage
         {
@@ -159,6 +173,8 @@ namespace PathFinder
         };
 
         void EnsureRenderPassUniqueness(Foundation::Name passName);
+        uint64_t ComputeStructuralHash() const;
+        void ClearCompiledState();
         void BuildAdjacencyLists();
         void DepthFirstSearch(uint64_t nodeIndex, std::vector<bool>& visited, std::vector<bool>& onStack, bool& isCyclic);
         void TopologicalSort();
@@ -181,18 +197,26 @@ namespace PathFinder
         OrderedNodeList mTopologicallySortedNodes;
         OrderedNodeList mNodesInGlobalExecutionOrder;
         WrittenSubresourceToPassMap mWrittenSubresourceToPassMap;
+        SubresourceReaderMap mSubresourceReaders;
         uint64_t mDetectedQueueCount = 1;
         std::vector<std::vector<const Node*>> mNodesPerQueue;
         std::vector<const Node*> mFirstNodesThatUseRayTracing;
 
+        // Structural hash of the graph state the current compilation results were built from
+        std::optional<uint64_t> mCompiledGraphHash;
+        bool mIsLastBuildCached = false;
+
     public:
         inline const auto& NodesInGlobalExecutionOrder() const { return mNodesInGlobalExecutionOrder; }
         inline const auto& Nodes() const { return mPassNodes; }
         inline auto& Nodes() { return mPassNodes; }
         inline const auto& DependencyLevels() const { return mDependencyLevels; }
+        // Indices of nodes depending on each node, both indexed in Nodes() order
+        inline const auto& NodeAdjacencyLists() const { return mAdjacencyLists; }
         inline auto DetectedQueueCount() const { return mDetectedQueueCount; }
         inline const auto& NodesForQueue(Node::QueueIndex queueIndex) const { return mNodesPerQueue[queueIndex]; }
         inline const Node* FirstNodeThatUsesRayTracingOnQueue(Node::QueueIndex queueIndex) const { return mFirstNodesThatUseRayTracing[queueIndex]; }
+        inline bool IsLastBuildCached() const { return mIsLastBuildCached; }
     };
 
 }
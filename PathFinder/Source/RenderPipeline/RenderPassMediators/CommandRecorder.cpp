@@ -107,46 +107,45 @@ namespace PathFinder
         HAL::GraphicsCommandList* cmdList = GetGraphicsCommandList();
         RenderDevice::PassHelpers& passHelpers = GetPassHelpers();
 
-        // Apply default viewport if none were provided by the render pass yet
-        if (!passHelpers.LastAppliedViewport)
-        {
-            passHelpers.LastAppliedViewport = HAL::Viewport(
-                mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Width,
-                mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Height 
-            );
+        PrepareForDraw(cmdList, passHelpers);
+        cmdList->Draw(vertexCount, 0);
 
-            cmdList->SetViewport(*passHelpers.LastAppliedViewport);
-        }
+        passHelpers.ExecutedRenderCommandsCount++;
+    }
 
-        // Apply default scissor if none were provided by the render pass yet
-        if (!passHelpers.LastAppliedScissor)
-        {
-            passHelpers.LastAppliedScissor = Geometry::Rect2D{
-                {0, 0},
-                Geometry::Size2D(
-                    mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Width,
-                    mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Height)
-            };
+    void CommandRecorder::Draw(const DrawablePrimitive& primitive)
+    {
+        Draw(primitive.VertexCount());
+    }
 
-            cmdList->SetScissor(*passHelpers.LastAppliedScissor);
-        }
+    void CommandRecorder::DrawIndirect(const Memory::Buffer& argumentBuffer, uint32_t drawCount, uint16_t rootConstantShaderRegister, uint16_t registerSpace)
+    {
+        assert_format(RenderPassExecutionQueue{ GetPassNode().ExecutionQueueIndex } != RenderPassExecutionQueue::AsyncCompute,
+            "Draw command is unsupported on asynchronous compute queue");
 
-        // Inset UAV barriers between draws
-        if (passHelpers.ExecutedRenderCommandsCount > 0)
+        RenderDevice::PassHelpers& passHelpers = GetPassHelpers();
+
+        assert_format(passHelpers.LastSetPipelineState && passHelpers.LastSetPipelineState->GraphicPSO,
+            "No graphics pipeline state applied before indirect draw in ", GetPassNode().PassMetadata().Name.ToString(), " render pass");
+
+        if (drawCount == 0)
         {
-            cmdList->InsertBarriers(passHelpers.UAVBarriers);
+            return;
         }
 
-        BindGraphicsPassRootConstantBuffer(cmdList);
-        cmdList->Draw(vertexCount, 0);
+        const HAL::RootSignature* signature = passHelpers.LastSetPipelineState->GraphicPSO->GetRootSignature();
+        auto index = signature->GetParameterIndex({ rootConstantShaderRegister, registerSpace, HAL::ShaderRegister::ConstantBuffer });
+        assert_format(index, "Root signature parameter doesn't exist");
 
-        passHelpers.ResourceStoragePassData->IsAllowedToAdvanceConstantBufferOffset = true;
-        passHelpers.ExecutedRenderCommandsCount++;
-    }
+        const HAL::CommandSignature* commandSignature = mPipelineStateManager->GetRootConstantDrawSignature(signature, index->IndexInSignature);
+        HAL::GraphicsCommandList* cmdList = GetGraphicsCommandList();
 
-    void CommandRecorder::Draw(const DrawablePrimitive& primitive)
-    {
-        Draw(primitive.VertexCount());
+        PrepareForDraw(cmdList, passHelpers);
+
+        // Argument buffers are expected to be upload buffers which are always in Generic Read state, that includes Indirect Argument state
+        cmdList->ExecuteIndirect(*commandSignature, *argumentBuffer.HALBuffer(), 0, drawCount);
+
+        passHelpers.ExecutedRenderCommandsCount++;
     }
 
     void CommandRecorder::Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
@@ -162,7 +161,6 @@ namespace PathFinder
         BindComputePassRootConstantBuffer(cmdList);
         cmdList->Dispatch(groupCountX, groupCountY, groupCountZ);
 
-        passHelpers.ResourceStoragePassData->IsAllowedToAdvanceConstantBufferOffset = true;
         passHelpers.ExecutedRenderCommandsCount++;
     }
 
@@ -192,7 +190,6 @@ namespace PathFinder
 
         BindComputePassRootConstantBuffer(cmdList);
         cmdList->DispatchRays(dispatchInfo);
-        passHelpers.ResourceStoragePassData->IsAllowedToAdvanceConstantBufferOffset = true;
         passHelpers.ExecutedRenderCommandsCount++;
     }
 
@@ -232,7 +229,7 @@ namespace PathFinder
         cmdList->SetGraphicsRootDescriptorTable(samplerRangeAddress, 14 + commonParametersIndexOffset);
 
         cmdList->SetGraphicsRootConstantBuffer(*mResourceStorage->GlobalRootConstantsBuffer()->HALBuffer(), 0 + commonParametersIndexOffset);
-        cmdList->SetGraphicsRootConstantBuffer(*mResourceStorage->PerFrameRootConstantsBuffer()->HALBuffer(), 1 + commonParametersIndexOffset);
+        cmdList->SetGraphicsRootConstantBuffer(mResourceStorage->PerFrameRootConstantsAddress(), 1 + commonParametersIndexOffset);
         cmdList->SetGraphicsRootUnorderedAccessResource(*GetGPUInspectorBuffer(), 15 + commonParametersIndexOffset);
     }
 
@@ -264,7 +261,7 @@ namespace PathFinder
         cmdList->SetComputeRootDescriptorTable(samplerRangeAddress, 14 + commonParametersIndexOffset);
 
         cmdList->SetComputeRootConstantBuffer(*mResourceStorage->GlobalRootConstantsBuffer()->HALBuffer(), 0 + commonParametersIndexOffset);
-        cmdList->SetComputeRootConstantBuffer(*mResourceStorage->PerFrameRootConstantsBuffer()->HALBuffer(), 1 + commonParametersIndexOffset);
+        cmdList->SetComputeRootConstantBuffer(mResourceStorage->PerFrameRootConstantsAddress(), 1 + commonParametersIndexOffset);
         cmdList->SetComputeRootUnorderedAccessResource(*GetGPUInspectorBuffer(), 15 + commonParametersIndexOffset);
     }
 
@@ -275,17 +272,10 @@ namespace PathFinder
 
         auto commonParametersIndexOffset = passHelpers.LastSetRootSignature->ParameterCount() - mPipelineStateManager->CommonRootSignatureParameterCount();
 
-        if (!passHelpers.ResourceStoragePassData->PassConstantBuffer)
-        {
-            return;
-        }
-
-        HAL::GPUAddress address =
-            passHelpers.ResourceStoragePassData->PassConstantBuffer->HALBuffer()->GPUVirtualAddress() +
-            passHelpers.ResourceStoragePassData->PassConstantBufferMemoryOffset;
+        HAL::GPUAddress address = passHelpers.ResourceStoragePassData->PassConstantBufferAddress;
 
-        // Already bound
-        if (passHelpers.LastBoundRootConstantBufferAddress == address)
+        // Nothing to bind or already bound
+        if (address == 0 || passHelpers.LastBoundRootConstantBufferAddress == address)
         {
             return;
         }
@@ -301,17 +291,10 @@ namespace PathFinder
 
         auto commonParametersIndexOffset = passHelpers.LastSetRootSignature->ParameterCount() - mPipelineStateManager->CommonRootSignatureParameterCount();
 
-        if (!passHelpers.ResourceStoragePassData->PassConstantBuffer)
-        {
-            return;
-        }
-
-        HAL::GPUAddress address =
-            passHelpers.ResourceStoragePassData->PassConstantBuffer->HALBuffer()->GPUVirtualAddress() +
-            passHelpers.ResourceStoragePassData->PassConstantBufferMemoryOffset;
+        HAL::GPUAddress address = passHelpers.ResourceStoragePassData->PassConstantBufferAddress;
 
-        // Already bound
-        if (passHelpers.LastBoundRootConstantBufferAddress == address)
+        // Nothing to bind or already bound
+        if (address == 0 || passHelpers.LastBoundRootConstantBufferAddress == address)
         {
             return;
         }
@@ -423,6 +406,41 @@ namespace PathFinder
         }
     }
 
+    void CommandRecorder::PrepareForDraw(HAL::GraphicsCommandList* cmdList, RenderDevice::PassHelpers& passHelpers)
+    {
+        // Apply default viewport if none were provided by the render pass yet
+        if (!passHelpers.LastAppliedViewport)
+        {
+            passHelpers.LastAppliedViewport = HAL::Viewport(
+                mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Width,
+                mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Height 
+            );
+
+            cmdList->SetViewport(*passHelpers.LastAppliedViewport);
+        }
+
+        // Apply default scissor if none were provided by the render pass yet
+        if (!passHelpers.LastAppliedScissor)
+        {
+            passHelpers.LastAppliedScissor = Geometry::Rect2D{
+                {0, 0},
+                Geometry::Size2D(
+                    mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Width,
+                    mRenderDevice->DefaultRenderSurfaceDesc().Dimensions().Height)
+            };
+
+            cmdList->SetScissor(*passHelpers.LastAppliedScissor);
+        }
+
+        // Inset UAV barriers between draws
+        if (passHelpers.ExecutedRenderCommandsCount > 0)
+        {
+            cmdList->InsertBarriers(passHelpers.UAVBarriers);
+        }
+
+        BindGraphicsPassRootConstantBuffer(cmdList);
+    }
+
     void CommandRecorder::CheckSignatureAndStatePresense(const RenderDevice::PassHelpers& passHelpers) const
     {
         assert_format(passHelpers.LastSetPipelineState != std::nullopt, "No pipeline state was set in this render pass");
@@ -40,6 +40,10 @@ namespace PathFinder
 
         void Draw(uint32_t vertexCount, uint32_t instanceCount = 1);
         void Draw(const DrawablePrimitive& primitive);
+
+        // Executes draws described by an array of HAL::RootConstantDrawArguments.
+        // Each draw sets its own 32 bit root constant at specified register before drawing.
+        void DrawIndirect(const Memory::Buffer& argumentBuffer, uint32_t drawCount, uint16_t rootConstantShaderRegister, uint16_t registerSpace);
         void Dispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1);
         void DispatchRays(const Geometry::Dimensions& dispatchDimensions);
         void Dispatch(const Geometry::Dimensions& viewportDimensions, const Geometry::Dimensions& groupSize);
@@ -60,6 +64,7 @@ namespace PathFinder
         void BindGraphicsPassRootConstantBuffer(HAL::GraphicsCommandListBase* cmdList);
         void BindComputePassRootConstantBuffer(HAL::ComputeCommandListBase* cmdList);
 
+        void PrepareForDraw(HAL::GraphicsCommandList* cmdList, RenderDevice::PassHelpers& passHelpers);
         void CheckSignatureAndStatePresense(const RenderDevice::PassHelpers& passHelpers) const;
 
         const RenderPassGraph::Node& GetPassNode() const;
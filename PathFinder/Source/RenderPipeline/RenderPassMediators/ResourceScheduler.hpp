@@ -211,7 +211,8 @@ namespace PathFinder
         // Indicate that pass will write to back buffer
         void WriteToBackBuffer();
 
-        // Explicitly set a queue to execute render pass on
+        // Set a queue to execute render pass on. Passes requesting async compute queue must only record compute work,
+        // with automatic async compute assignment enabled they are moved to graphics queue when that is estimated to be faster.
         void ExecuteOnQueue(RenderPassExecutionQueue queue);
 
         // Indicate that pass will use Ray Tracing Acceleration structures.
@@ -320,10 +320,13 @@ namespace PathFinder
     void ResourceScheduler<ContentMediator>::ExecuteOnQueue(RenderPassExecutionQueue queue)
     {
         // Ignore render pass queue preference if async is disabled
-        mCurrentlySchedulingPassNode->ExecutionQueueIndex =
-            mPipelineSettings->IsAsyncComputeEnabled ?
-            std::underlying_type_t<RenderPassExecutionQueue>(queue) :
-            std::underlying_type_t<RenderPassExecutionQueue>(RenderPassExecutionQueue::Graphics);
+        bool isAsyncCompute = mPipelineSettings->IsAsyncComputeEnabled && queue == RenderPassExecutionQueue::AsyncCompute;
+
+        mCurrentlySchedulingPassNode->ExecutionQueueIndex = std::underlying_type_t<RenderPassExecutionQueue>(
+            isAsyncCompute ? RenderPassExecutionQueue::AsyncCompute : RenderPassExecutionQueue::Graphics);
+
+        // Cost model may still move the pass back to graphics queue
+        mCurrentlySchedulingPassNode->IsAsyncComputeEligible = isAsyncCompute && mPipelineSettings->IsAutomaticAsyncComputeAssignmentEnabled;
     }
 
     template <class ContentMediator>
@@ -11,8 +11,8 @@ namespace PathFinder
     public:
         RootConstantsUpdater(PipelineResourceStorage* storage, const RenderPassGraph* passGraph, uint64_t graphNodeIndex);
 
-        /// Uploads data to current pass' constant buffer.
-        /// Data is versioned between each draw/dispatch call
+        /// Writes data to transient frame memory and makes it current pass' constant buffer.
+        /// Every update is placed in new memory, so data is versioned between draw/dispatch calls
         template <class RootCBufferContent>
         void UpdateRootConstantBuffer(const RootCBufferContent& data);
 
@@ -122,23 +122,20 @@ namespace PathFinder
     {
         context->GetCommandRecorder()->ApplyPipelineState(PSONames::GBufferMeshes);
 
-        auto& instances = context->GetContent()->GetScene()->GetMeshInstances();
+        auto meshStorage = context->GetContent()->GetSceneGPUStorage();
 
-        if (instances.empty()) 
+        if (meshStorage->VisibleMeshInstanceCount() == 0) 
             return;
 
         // Use vertex and index buffers as normal structured buffers
-        auto meshStorage = context->GetContent()->GetSceneGPUStorage();
         context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->UnifiedVertexBuffer(), 0, 0, HAL::ShaderRegister::ShaderResource);
         context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->UnifiedIndexBuffer(), 1, 0, HAL::ShaderRegister::ShaderResource);
         context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MeshInstanceTable(), 2, 0, HAL::ShaderRegister::ShaderResource);
         context->GetCommandRecorder()->BindExternalBuffer(*meshStorage->MaterialTable(), 3, 0, HAL::ShaderRegister::ShaderResource);
 
-        for (const MeshInstance& instance : instances)
-        {
-            context->GetCommandRecorder()->SetRootConstants(instance.GetIndexInGPUTable(), 0, 0);
-            context->GetCommandRecorder()->Draw(instance.GetAssociatedMesh()->GetLocationInVertexStorage().IndexCount);
-        }
+        // Instances outside of camera frustum are culled on CPU.
+        // Each draw sets instance table index root constant by itself.
+        context->GetCommandRecorder()->DrawIndirect(*meshStorage->VisibleMeshInstanceDrawArguments(), meshStorage->VisibleMeshInstanceCount(), 0, 0);
     }
 
     void GBufferRenderPass::RenderLights(RenderContext<RenderPassContentMediator>* context)
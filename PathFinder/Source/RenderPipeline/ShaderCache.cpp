@@ -0,0 +1,229 @@
+#include "ShaderCache.hpp"
+
+#include <Foundation/Hash.hpp>
+
+#include <bitsery/bitsery.h>
+#include <bitsery/adapter/stream.h>
+#include <bitsery/traits/vector.h>
+#include <bitsery/traits/string.h>
+
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+#include <limits>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        constexpr uint32_t CacheEntryFormatVersion = 1;
+
+        struct StoredSourceFile
+        {
+            std::string RelativePath;
+            uint64_t Hash = 0;
+
+            template <typename S>
+            void serialize(S& s)
+            {
+                s.container1b(RelativePath, 1000);
+                s.value8b(Hash);
+            }
+        };
+
+        struct StoredEntry
+        {
+            uint32_t FormatVersion = CacheEntryFormatVersion;
+            std::string Key;
+            std::vector<StoredSourceFile> SourceFiles;
+            std::string DebugName;
+            std::vector<uint8_t> Binary;
+            std::vector<uint8_t> PDBBinary;
+
+            template <typename S>
+            void serialize(S& s)
+            {
+                s.value4b(FormatVersion);
+                s.container1b(Key, std::numeric_limits<uint32_t>::max());
+                s.container(SourceFiles, std::numeric_limits<uint32_t>::max());
+                s.container1b(DebugName, 1000);
+                s.container1b(Binary, std::numeric_limits<uint64_t>::max());
+                s.container1b(PDBBinary, std::numeric_limits<uint64_t>::max());
+            }
+        };
+    }
+
+    std::string ShaderCache::Key::ToString() const
+    {
+        // Fields are separated by a character that can't appear in any of them
+        return SourceRelativePath + '\n' + EntryPoint + '\n' + Profile + '\n' + CompilerArguments + '\n' + CompilerVersion;
+    }
+
+    ShaderCache::ShaderCache(const std::filesystem::path& cacheFolderPath, const std::filesystem::path& sourceRootPath, CompilerBackend* compilerBackend)
+        : mCacheFolderPath{ cacheFolderPath }, mSourceRootPath{ sourceRootPath }, mCompilerBackend{ compilerBackend }
+    {
+        std::filesystem::create_directories(mCacheFolderPath);
+    }
+
+    std::optional<ShaderCache::Entry> ShaderCache::FindOrCompile(const Key& key)
+    {
+        if (std::optional<Entry> entry = Find(key))
+        {
+            ++mHitCount;
+            return entry;
+        }
+
+        ++mMissCount;
+
+        std::optional<Entry> entry = mCompilerBackend->Compile(key, mSourceRootPath / key.SourceRelativePath);
+
+        if (entry)
+        {
+            Store(key, *entry);
+        }
+
+        return entry;
+    }
+
+    std::optional<ShaderCache::Entry> ShaderCache::Find(const Key& key)
+    {
+        std::ifstream stream{ EntryPath(key), std::ios::binary | std::ios::in };
+
+        if (!stream.is_open())
+        {
+            return std::nullopt;
+        }
+
+        StoredEntry storedEntry{};
+        bitsery::Deserializer<bitsery::InputStreamAdapter> deserializer{ stream };
+        deserializer.object(storedEntry);
+
+        bool isReadSuccessfully = deserializer.adapter().error() == bitsery::ReaderError::NoError;
+
+        // Different format or a key that collided with another key's hash
+        if (!isReadSuccessfully || storedEntry.FormatVersion != CacheEntryFormatVersion || storedEntry.Key != key.ToString())
+        {
+            return std::nullopt;
+        }
+
+        Entry entry{};
+
+        for (const StoredSourceFile& sourceFile : storedEntry.SourceFiles)
+        {
+            std::optional<uint64_t> currentHash = HashSourceFile(SourceFilePath(key, sourceFile.RelativePath));
+
+            if (!currentHash || *currentHash != sourceFile.Hash)
+            {
+                return std::nullopt;
+            }
+
+            entry.CompiledFileRelativePaths.push_back(sourceFile.RelativePath);
+        }
+
+        entry.Binary = std::move(storedEntry.Binary);
+        entry.PDBBinary = std::move(storedEntry.PDBBinary);
+        entry.DebugName = std::move(storedEntry.DebugName);
+
+        return entry;
+    }
+
+    void ShaderCache::Store(const Key& key, const Entry& entry)
+    {
+        StoredEntry storedEntry{};
+        storedEntry.Key = key.ToString();
+        storedEntry.DebugName = entry.DebugName;
+        storedEntry.Binary = entry.Binary;
+        storedEntry.PDBBinary = entry.PDBBinary;
+
+        for (const std::string& relativePath : entry.CompiledFileRelativePaths)
+        {
+            std::optional<uint64_t> hash = HashSourceFile(SourceFilePath(key, relativePath));
+
+            // Entry that can't be validated later is not worth storing
+            if (!hash)
+            {
+                return;
+            }
+
+            storedEntry.SourceFiles.push_back({ relativePath, *hash });
+        }
+
+        // Write to a temporary file first so that a partially written entry is never picked up
+        std::filesystem::path entryPath = EntryPath(key);
+        std::filesystem::path temporaryPath = entryPath;
+        temporaryPath += ".tmp";
+
+        {
+            std::ofstream stream{ temporaryPath, std::ios::binary | std::ios::trunc | std::ios::out };
+
+            if (!stream.is_open())
+            {
+                return;
+            }
+
+            bitsery::Serializer<bitsery::OutputBufferedStreamAdapter> serializer{ stream };
+            serializer.object(storedEntry);
+            serializer.adapter().flush();
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, entryPath, error);
+    }
+
+    std::optional<uint64_t> ShaderCache::HashSourceFile(const std::filesystem::path& path)
+    {
+        std::error_code error;
+        std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, error);
+
+        if (error)
+        {
+            return std::nullopt;
+        }
+
+        std::string pathString = path.string();
+
+        {
+            std::lock_guard lock{ mSourceFileHashesMutex };
+            auto hashIt = mSourceFileHashes.find(pathString);
+
+            if (hashIt != mSourceFileHashes.end() && hashIt->second.WriteTime == writeTime)
+            {
+                return hashIt->second.Hash;
+            }
+        }
+
+        std::ifstream stream{ path, std::ios::binary | std::ios::in };
+
+        if (!stream.is_open())
+        {
+            return std::nullopt;
+        }
+
+        std::string contents{ std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+        uint64_t hash = Foundation::HashBytes(contents.data(), contents.size());
+
+        std::lock_guard lock{ mSourceFileHashesMutex };
+        mSourceFileHashes[pathString] = FileHash{ hash, writeTime };
+
+        return hash;
+    }
+
+    std::filesystem::path ShaderCache::EntryPath(const Key& key) const
+    {
+        std::string keyString = key.ToString();
+        uint64_t keyHash = Foundation::HashBytes(keyString.data(), keyString.size());
+
+        char fileName[32];
+        std::snprintf(fileName, sizeof(fileName), "%016llx.pfshader", (unsigned long long)keyHash);
+
+        return mCacheFolderPath / fileName;
+    }
+
+    std::filesystem::path ShaderCache::SourceFilePath(const Key& key, const std::string& compiledFileRelativePath) const
+    {
+        // Includes are resolved relative to the folder of the entry point file
+        return (mSourceRootPath / key.SourceRelativePath).parent_path() / compiledFileRelativePath;
+    }
+
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <robinhood/robin_hood.h>
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+namespace PathFinder
+{
+
+    // Persistent storage of compiled shader binaries.
+    // An entry is reused only while its key and the contents of every file
+    // that took part in its compilation (entry point file and its whole include graph) are unchanged.
+    class ShaderCache
+    {
+    public:
+        struct Key
+        {
+            std::string SourceRelativePath;
+            std::string EntryPoint;
+            std::string Profile;
+            std::string CompilerArguments;
+            std::string CompilerVersion;
+
+            std::string ToString() const;
+        };
+
+        struct Entry
+        {
+            std::vector<uint8_t> Binary;
+            std::vector<uint8_t> PDBBinary;
+            std::string DebugName;
+
+            // Entry point file and every file it included, relative to the folder of the entry point file
+            std::vector<std::string> CompiledFileRelativePaths;
+        };
+
+        // Produces entries on cache misses. Invoked from multiple threads concurrently.
+        class CompilerBackend
+        {
+        public:
+            virtual ~CompilerBackend() = default;
+
+            // Compiles entry point of the key with key's profile, or the whole file as a library if entry point is empty
+            virtual std::optional<Entry> Compile(const Key& key, const std::filesystem::path& sourcePath) = 0;
+        };
+
+        ShaderCache(const std::filesystem::path& cacheFolderPath, const std::filesystem::path& sourceRootPath, CompilerBackend* compilerBackend);
+
+        // Can be called from multiple threads concurrently for different keys.
+        // Compiler backend is invoked on a cache miss and its successful result is stored.
+        std::optional<Entry> FindOrCompile(const Key& key);
+
+        std::optional<Entry> Find(const Key& key);
+        void Store(const Key& key, const Entry& entry);
+
+    private:
+        struct FileHash
+        {
+            uint64_t Hash = 0;
+            std::filesystem::file_time_type WriteTime;
+        };
+
+        std::optional<uint64_t> HashSourceFile(const std::filesystem::path& path);
+        std::filesystem::path EntryPath(const Key& key) const;
+        std::filesystem::path SourceFilePath(const Key& key, const std::string& compiledFileRelativePath) const;
+
+        std::filesystem::path mCacheFolderPath;
+        std::filesystem::path mSourceRootPath;
+        CompilerBackend* mCompilerBackend = nullptr;
+
+        // Headers are shared by many shaders, so their hashes are memoized until files are modified
+        robin_hood::unordered_node_map<std::string, FileHash> mSourceFileHashes;
+        std::mutex mSourceFileHashesMutex;
+
+        std::atomic<uint64_t> mHitCount = 0;
+        std::atomic<uint64_t> mMissCount = 0;
+
+    public:
+        inline uint64_t HitCount() const { return mHitCount; }
+        inline uint64_t MissCount() const { return mMissCount; }
+    };
+
+}
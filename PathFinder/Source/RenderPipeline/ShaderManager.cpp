@@ -6,6 +6,35 @@
 namespace PathFinder
 {
 
+    namespace
+    {
+        std::vector<uint8_t> BlobBytes(IDxcBlob* blob)
+        {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(blob->GetBufferPointer());
+            return { bytes, bytes + blob->GetBufferSize() };
+        }
+
+        std::optional<ShaderCache::Entry> MakeCacheEntry(const HAL::ShaderCompiler::BlobCompilationResult& result)
+        {
+            if (!result.Blob)
+            {
+                return std::nullopt;
+            }
+
+            ShaderCache::Entry entry{};
+            entry.Binary = BlobBytes(result.Blob.Get());
+            entry.DebugName = result.DebugName;
+            entry.CompiledFileRelativePaths = result.CompiledFileRelativePaths;
+
+            if (result.PDBBlob)
+            {
+                entry.PDBBinary = BlobBytes(result.PDBBlob.Get());
+            }
+
+            return entry;
+        }
+    }
+
     ShaderManager::ShaderManager(const std::filesystem::path& executableFolder, bool useProjectDirShaders, bool buildDebugShaders, bool separatePDBFiles, AftermathShaderDatabase* aftermathShaderDatabase)
         : mUseProjectDirShaders{ useProjectDirShaders },
         mBuildDebugShaders{ buildDebugShaders },
@@ -20,6 +49,17 @@ namespace PathFinder
         mShaderBinariesPath = mExecutableFolderPath / "CompiledShaders";
         std::filesystem::create_directories(mShaderBinariesPath);
 
+        // Kept apart from CompiledShaders folder which is wiped on every build
+        mShaderCachePath = mExecutableFolderPath / "ShaderCache";
+        mShaderCache = std::make_unique<ShaderCache>(mShaderCachePath, mShaderSourceRootPath, this);
+
+        mCompilerVersion = mCompiler.VersionString();
+
+        for (const std::wstring& argument : mCompiler.CompilationArguments(mBuildDebugShaders, mOutputPDBInSeparateFiles))
+        {
+            mCompilerArguments += WStringToString(argument) + " ";
+        }
+
         mFileWatcher.addWatch(mShaderSourceRootPath.string(), this, true);
     }
 
@@ -74,8 +114,7 @@ namespace PathFinder
 
         if (!shader)
         {
-            shader = LoadAndCacheShader(pipelineStage, entryPoint, relativePath);
-            assert_format(shader, "Failed to compile shader: ", relativePath.string());
+            shader = &(*RequestShader(pipelineStage, entryPoint, relativePath, std::nullopt));
         }
 
         return shader;
@@ -103,35 +142,77 @@ namespace PathFinder
         return &(*shaderIt);
     }
 
-    HAL::Shader* ShaderManager::LoadAndCacheShader(HAL::Shader::Stage pipelineStage, const std::string& entryPoint, const std::filesystem::path& relativePath)
+    ShaderManager::ShaderListIterator ShaderManager::RequestShader(HAL::Shader::Stage pipelineStage, const std::string& entryPoint, const std::filesystem::path& relativePath, std::optional<ShaderListIterator> replacedShader)
     {
-        auto fullPath = mShaderSourceRootPath / relativePath;
+        // Placeholder receives bytecode once compilation is finished
+        mShaders.emplace_back(nullptr, nullptr, entryPoint, pipelineStage);
+        ShaderListIterator shaderIt = std::prev(mShaders.end());
 
-        HAL::ShaderCompiler::ShaderCompilationResult compilationResult = mCompiler.CompileShader(fullPath, pipelineStage, entryPoint, mBuildDebugShaders, mOutputPDBInSeparateFiles);
-        
-        if (!compilationResult.CompiledShader.Blob())
+        // Make placeholder discoverable so that repeated requests don't compile the same shader twice.
+        // Recompiled shaders replace old ones only when compilation succeeds.
+        if (!replacedShader)
         {
-            return nullptr;
+            CompiledObjectsInFile& compiledObjectsInFile = mEntryPointFilePathToCompiledObjectAssociations[relativePath.filename().string()];
+            compiledObjectsInFile.Shaders[shaderIt->EntryPointName()] = shaderIt;
         }
 
-        mAftermathShaderDatabase->AddShader(compilationResult.CompiledShader);
-        mShaders.emplace_back(std::move(compilationResult.CompiledShader));
-        
-        std::string relativePathString = relativePath.filename().string();
-        ShaderListIterator shaderIt = std::prev(mShaders.end());
-        SaveToFile(shaderIt->Binary(), shaderIt->PDBBinary(), shaderIt->EntryPoint(), shaderIt->DebugName(), relativePath);
-        
+        PendingCompilation& compilation = mPendingCompilations.emplace_back();
+        compilation.Shader = shaderIt;
+        compilation.ReplacedShader = replacedShader;
+        compilation.RelativePath = relativePath;
+
+        std::string profile = mCompiler.ProfileString(pipelineStage, HAL::ShaderCompiler::TargetProfile);
+        CompileInBackground(compilation, MakeCacheKey(relativePath, entryPoint, profile));
+
+        return shaderIt;
+    }
+
+    void ShaderManager::FinishShaderCompilation(PendingCompilation& compilation)
+    {
+        ShaderListIterator shaderIt = *compilation.Shader;
+
+        if (!compilation.Result)
+        {
+            // Failed recompilation is OK, old shader stays in use
+            assert_format(compilation.ReplacedShader, "Failed to compile shader: ", compilation.RelativePath.string());
+            mShaders.erase(shaderIt);
+            return;
+        }
+
+        const ShaderCache::Entry& entry = *compilation.Result;
+
+        Microsoft::WRL::ComPtr<IDxcBlob> pdbBlob;
+
+        if (!entry.PDBBinary.empty())
+        {
+            pdbBlob = mCompiler.CreateBlob(entry.PDBBinary);
+        }
+
+        *shaderIt = HAL::Shader{ mCompiler.CreateBlob(entry.Binary), pdbBlob, shaderIt->EntryPoint(), shaderIt->PipelineStage() };
+        shaderIt->SetDebugName(entry.DebugName);
+
+        mAftermathShaderDatabase->AddShader(*shaderIt);
+        SaveToFile(shaderIt->Binary(), shaderIt->PDBBinary(), shaderIt->EntryPoint(), shaderIt->DebugName(), compilation.RelativePath);
+
         // Associate shader with a file it was loaded from and its entry point name
+        std::string relativePathString = compilation.RelativePath.filename().string();
         CompiledObjectsInFile& compiledObjectsInFile = mEntryPointFilePathToCompiledObjectAssociations[relativePathString];
         compiledObjectsInFile.Shaders[shaderIt->EntryPointName()] = shaderIt;
 
-        for (auto& shaderFilePath : compilationResult.CompiledFileRelativePaths)
+        for (auto& shaderFilePath : entry.CompiledFileRelativePaths)
         {
             // Associate every file that took place in compilation with the root file that has shader's entry point
             mIncludedFilePathToEntryPointFilePathAssociations[shaderFilePath].insert(relativePathString);
         }
 
-        return &(*shaderIt);
+        if (compilation.ReplacedShader)
+        {
+            // Notify anyone interested about the old-to-new swap operation
+            mShaderRecompilationEvent(&(**compilation.ReplacedShader), &(*shaderIt));
+
+            // Get rid of the old shader
+            mShaders.erase(*compilation.ReplacedShader);
+        }
     }
 
     HAL::Library* ShaderManager::GetLibrary(const std::filesystem::path& relativePath)
@@ -140,8 +221,7 @@ namespace PathFinder
 
         if (!library)
         {
-            library = LoadAndCacheLibrary(relativePath);
-            assert_format(library, "Failed to compile library");
+            library = &(*RequestLibrary(relativePath, std::nullopt));
         }
 
         return library;
@@ -169,33 +249,135 @@ namespace PathFinder
         return library;
     }
 
-    HAL::Library* ShaderManager::LoadAndCacheLibrary(const std::filesystem::path& relativePath)
+    ShaderManager::LibraryListIterator ShaderManager::RequestLibrary(const std::filesystem::path& relativePath, std::optional<LibraryListIterator> replacedLibrary)
     {
-        auto fullPath = mShaderSourceRootPath / relativePath;
+        mLibraries.emplace_back(nullptr, nullptr);
+        LibraryListIterator libraryIt = std::prev(mLibraries.end());
+
+        if (!replacedLibrary)
+        {
+            CompiledObjectsInFile& compiledObjectsInFile = mEntryPointFilePathToCompiledObjectAssociations[relativePath.filename().string()];
+            compiledObjectsInFile.Library = libraryIt;
+        }
 
-        HAL::ShaderCompiler::LibraryCompilationResult compilationResult = mCompiler.CompileLibrary(fullPath, mBuildDebugShaders, mOutputPDBInSeparateFiles);
+        PendingCompilation& compilation = mPendingCompilations.emplace_back();
+        compilation.Library = libraryIt;
+        compilation.ReplacedLibrary = replacedLibrary;
+        compilation.RelativePath = relativePath;
 
-        if (!compilationResult.CompiledLibrary.Blob())
+        std::string profile = mCompiler.LibProfileString(HAL::ShaderCompiler::TargetProfile);
+        CompileInBackground(compilation, MakeCacheKey(relativePath, "", profile));
+
+        return libraryIt;
+    }
+
+    void ShaderManager::FinishLibraryCompilation(PendingCompilation& compilation)
+    {
+        LibraryListIterator libraryIt = *compilation.Library;
+
+        if (!compilation.Result)
         {
-            return nullptr;
+            assert_format(compilation.ReplacedLibrary, "Failed to compile library: ", compilation.RelativePath.string());
+            mLibraries.erase(libraryIt);
+            return;
         }
 
-        mAftermathShaderDatabase->AddLibrary(compilationResult.CompiledLibrary);
-        mLibraries.emplace_back(std::move(compilationResult.CompiledLibrary));
+        const ShaderCache::Entry& entry = *compilation.Result;
 
-        std::string relativePathString = relativePath.filename().string();
-        LibraryListIterator libraryIt = std::prev(mLibraries.end());
-        SaveToFile(libraryIt->Binary(), libraryIt->PDBBinary(), "", libraryIt->DebugName(), relativePath);
+        Microsoft::WRL::ComPtr<IDxcBlob> pdbBlob;
+
+        if (!entry.PDBBinary.empty())
+        {
+            pdbBlob = mCompiler.CreateBlob(entry.PDBBinary);
+        }
+
+        *libraryIt = HAL::Library{ mCompiler.CreateBlob(entry.Binary), pdbBlob };
+        libraryIt->SetDebugName(entry.DebugName);
+
+        mAftermathShaderDatabase->AddLibrary(*libraryIt);
+        SaveToFile(libraryIt->Binary(), libraryIt->PDBBinary(), "", libraryIt->DebugName(), compilation.RelativePath);
 
+        std::string relativePathString = compilation.RelativePath.filename().string();
         CompiledObjectsInFile& compiledObjectsInFile = mEntryPointFilePathToCompiledObjectAssociations[relativePathString];
         compiledObjectsInFile.Library = libraryIt;
 
-        for (auto& shaderFilePath : compilationResult.CompiledFileRelativePaths)
+        for (auto& shaderFilePath : entry.CompiledFileRelativePaths)
         {
             mIncludedFilePathToEntryPointFilePathAssociations[shaderFilePath].insert(relativePathString);
         }
 
-        return &(*libraryIt);
+        if (compilation.ReplacedLibrary)
+        {
+            mLibraryRecompilationEvent(&(**compilation.ReplacedLibrary), &(*libraryIt));
+            mLibraries.erase(*compilation.ReplacedLibrary);
+        }
+    }
+
+    void ShaderManager::FinishPendingCompilations()
+    {
+        if (mPendingCompilations.empty())
+        {
+            return;
+        }
+
+        mCompilationThreadPool.WaitForAllTasks();
+
+        for (PendingCompilation& compilation : mPendingCompilations)
+        {
+            if (compilation.Shader)
+            {
+                FinishShaderCompilation(compilation);
+            }
+            else
+            {
+                FinishLibraryCompilation(compilation);
+            }
+        }
+
+        mPendingCompilations.clear();
+    }
+
+    void ShaderManager::CompileInBackground(PendingCompilation& compilation, const ShaderCache::Key& cacheKey)
+    {
+        // Pending compilations live in a list, so the reference stays valid until they're finished
+        mCompilationThreadPool.Execute([this, &compilation, cacheKey]
+        {
+            compilation.Result = mShaderCache->FindOrCompile(cacheKey);
+        });
+    }
+
+    std::optional<ShaderCache::Entry> ShaderManager::Compile(const ShaderCache::Key& key, const std::filesystem::path& sourcePath)
+    {
+        HAL::ShaderCompiler* compiler = AcquireWorkerCompiler();
+        HAL::ShaderCompiler::BlobCompilationResult result = compiler->CompileBlob(sourcePath, key.Profile, key.EntryPoint, mBuildDebugShaders, mOutputPDBInSeparateFiles);
+        ReleaseWorkerCompiler(compiler);
+
+        return MakeCacheEntry(result);
+    }
+
+    ShaderCache::Key ShaderManager::MakeCacheKey(const std::filesystem::path& relativePath, const std::string& entryPoint, const std::string& profile) const
+    {
+        return { relativePath.string(), entryPoint, profile, mCompilerArguments, mCompilerVersion };
+    }
+
+    HAL::ShaderCompiler* ShaderManager::AcquireWorkerCompiler()
+    {
+        std::lock_guard lock{ mWorkerCompilersMutex };
+
+        if (mFreeWorkerCompilers.empty())
+        {
+            return mWorkerCompilers.emplace_back(std::make_unique<HAL::ShaderCompiler>()).get();
+        }
+
+        HAL::ShaderCompiler* compiler = mFreeWorkerCompilers.back();
+        mFreeWorkerCompilers.pop_back();
+        return compiler;
+    }
+
+    void ShaderManager::ReleaseWorkerCompiler(HAL::ShaderCompiler* compiler)
+    {
+        std::lock_guard lock{ mWorkerCompilersMutex };
+        mFreeWorkerCompilers.push_back(compiler);
     }
 
     void ShaderManager::SaveToFile(
@@ -249,38 +431,6 @@ namespace PathFinder
         }
     }
 
-    void ShaderManager::RecompileShader(ShaderListIterator oldShaderIt, const std::string& shaderFile)
-    {
-        HAL::Shader* oldShader = &(*oldShaderIt);
-        HAL::Shader* newShader = LoadAndCacheShader(oldShader->PipelineStage(), oldShader->EntryPointName().ToString(), shaderFile);
-
-        // Failed recompilation is OK
-        if (!newShader)
-        {
-            return;
-        }
-
-        // Notify anyone interested about the old-to-new swap operation
-        mShaderRecompilationEvent(oldShader, newShader);
-
-        // Get rid of the old shader
-        mShaders.erase(oldShaderIt);
-    }
-
-    void ShaderManager::RecompileLibrary(LibraryListIterator oldLibraryIt, const std::string& libraryFile)
-    {
-        HAL::Library* oldLibrary = &(*oldLibraryIt);
-        HAL::Library* newLibrary = LoadAndCacheLibrary(libraryFile);
-
-        if (!newLibrary)
-        {
-            return;
-        }
-
-        mLibraryRecompilationEvent(oldLibrary, newLibrary);
-        mLibraries.erase(oldLibraryIt);
-    }
-
     void ShaderManager::RecompileModifiedShaders()
     {
         for (auto& shaderFile : mEntryPointShaderFilesToRecompile)
@@ -289,16 +439,19 @@ namespace PathFinder
 
             for (auto& [entryPointName, shaderIterator] : compiledObjectsInFile.Shaders)
             {
-                RecompileShader(shaderIterator, shaderFile);
+                RequestShader(shaderIterator->PipelineStage(), shaderIterator->EntryPoint(), shaderFile, shaderIterator);
             }
 
             if (auto libIt = compiledObjectsInFile.Library)
             {
-                RecompileLibrary(*libIt, shaderFile);
+                RequestLibrary(shaderFile, *libIt);
             }
         }
 
         mEntryPointShaderFilesToRecompile.clear();
+
+        // All modified files are recompiled in parallel
+        FinishPendingCompilations();
     }
 
 }
\ No newline at end of file
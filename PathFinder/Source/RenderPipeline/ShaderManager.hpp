@@ -4,20 +4,25 @@
 #include <HardwareAbstractionLayer/ShaderCompiler.hpp>
 #include <IO/CommandLineParser.hpp>
 #include <Foundation/Event.hpp>
+#include <Foundation/ThreadPool.hpp>
 #include <Utility/AftermathShaderDatabase.hpp>
 
+#include "ShaderCache.hpp"
+
 #include <vector>
 #include <list>
 #include <unordered_map>
 #include <unordered_set>
 #include <filesystem>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <filewatch/FileWatcher.h>
 
 namespace PathFinder
 {
 
-    class ShaderManager : private FW::FileWatchListener
+    class ShaderManager : private FW::FileWatchListener, private ShaderCache::CompilerBackend
     {
     public:
         using ShaderEvent = Foundation::Event<ShaderManager, std::string, void(const HAL::Shader*, const HAL::Shader*)>;
@@ -28,6 +33,10 @@ namespace PathFinder
         HAL::Shader* LoadShader(HAL::Shader::Stage pipelineStage, const std::string& entryPoint, const std::filesystem::path& relativePath);
         HAL::Library* LoadLibrary(const std::filesystem::path& relativePath);
 
+        // Shaders and libraries are compiled or fetched from cache on a thread pool.
+        // Objects returned by LoadShader() and LoadLibrary() have no bytecode until this is called.
+        void FinishPendingCompilations();
+
         void BeginFrame();
         void EndFrame();
 
@@ -42,13 +51,38 @@ namespace PathFinder
             std::optional<LibraryListIterator> Library;
         };
 
+        struct PendingCompilation
+        {
+            std::optional<ShaderListIterator> Shader;
+            std::optional<LibraryListIterator> Library;
+
+            // Object to be swapped with the newly compiled one on successful recompilation
+            std::optional<ShaderListIterator> ReplacedShader;
+            std::optional<LibraryListIterator> ReplacedLibrary;
+
+            std::filesystem::path RelativePath;
+
+            // Written by a worker thread
+            std::optional<ShaderCache::Entry> Result;
+        };
+
         HAL::Shader* GetShader(HAL::Shader::Stage pipelineStage, const std::string& entryPoint, const std::filesystem::path& relativePath);
         HAL::Shader* FindCachedShader(Foundation::Name entryPointName, const std::filesystem::path& relativePath);
-        HAL::Shader* LoadAndCacheShader(HAL::Shader::Stage pipelineStage, const std::string& entryPoint, const std::filesystem::path& relativePath);
+        ShaderListIterator RequestShader(HAL::Shader::Stage pipelineStage, const std::string& entryPoint, const std::filesystem::path& relativePath, std::optional<ShaderListIterator> replacedShader);
+        void FinishShaderCompilation(PendingCompilation& compilation);
 
         HAL::Library* GetLibrary(const std::filesystem::path& relativePath);
         HAL::Library* FindCachedLibrary(const std::filesystem::path& relativePath);
-        HAL::Library* LoadAndCacheLibrary(const std::filesystem::path& relativePath);
+        LibraryListIterator RequestLibrary(const std::filesystem::path& relativePath, std::optional<LibraryListIterator> replacedLibrary);
+        void FinishLibraryCompilation(PendingCompilation& compilation);
+
+        void CompileInBackground(PendingCompilation& compilation, const ShaderCache::Key& cacheKey);
+        std::optional<ShaderCache::Entry> Compile(const ShaderCache::Key& key, const std::filesystem::path& sourcePath) override;
+        ShaderCache::Key MakeCacheKey(const std::filesystem::path& relativePath, const std::string& entryPoint, const std::string& profile) const;
+
+        // DXC compiler objects are not thread safe, each worker uses its own
+        HAL::ShaderCompiler* AcquireWorkerCompiler();
+        void ReleaseWorkerCompiler(HAL::ShaderCompiler* compiler);
 
         void SaveToFile(
             const HAL::CompiledBinary& binary, 
@@ -58,14 +92,14 @@ namespace PathFinder
             const std::filesystem::path& sourceRelativePath) const;
 
         void FindAndAddEntryPointShaderFileForRecompilation(const std::string& modifiedFile);
-        void RecompileShader(ShaderListIterator oldShaderIt, const std::string& shaderFile);
-        void RecompileLibrary(LibraryListIterator oldLibraryIt, const std::string& libraryFile);
         void RecompileModifiedShaders();
         void handleFileAction(FW::WatchID watchid, const FW::String& dir, const FW::String& filename, FW::Action action) override;
 
         AftermathShaderDatabase* mAftermathShaderDatabase = nullptr;
         FW::FileWatcher mFileWatcher;
         HAL::ShaderCompiler mCompiler;
+        std::string mCompilerVersion;
+        std::string mCompilerArguments;
 
         bool mUseProjectDirShaders = false;
         bool mBuildDebugShaders = false;
@@ -74,6 +108,7 @@ namespace PathFinder
         std::filesystem::path mExecutableFolderPath;
         std::filesystem::path mShaderSourceRootPath;
         std::filesystem::path mShaderBinariesPath;
+        std::filesystem::path mShaderCachePath;
 
         std::list<HAL::Shader> mShaders;
         std::list<HAL::Library> mLibraries;
@@ -85,6 +120,16 @@ namespace PathFinder
         ShaderEvent mShaderRecompilationEvent;
         LibraryEvent mLibraryRecompilationEvent;
 
+        std::unique_ptr<ShaderCache> mShaderCache;
+        std::list<PendingCompilation> mPendingCompilations;
+
+        std::vector<std::unique_ptr<HAL::ShaderCompiler>> mWorkerCompilers;
+        std::vector<HAL::ShaderCompiler*> mFreeWorkerCompilers;
+        std::mutex mWorkerCompilersMutex;
+
+        // Declared last to be destroyed first, while objects used by its tasks are still alive
+        Foundation::ThreadPool mCompilationThreadPool;
+
     public:
         inline ShaderEvent& ShaderRecompilationEvent() { return mShaderRecompilationEvent; }
         inline LibraryEvent& LibraryRecompilationEvent() { return mLibraryRecompilationEvent; }
@@ -15,7 +15,7 @@ struct RootConstants
 
 ConstantBuffer<RootConstants> RootConstantBuffer : register(b0);
 StructuredBuffer<Light> LightTable : register(t0);
-StructuredBuffer<Vertex1P1N1UV1T1BT> UnifiedVertexBuffer : register(t1);
+StructuredBuffer<Vertex1P1N1UV1T1BTCompressed> UnifiedVertexBuffer : register(t1);
 StructuredBuffer<uint> UnifiedIndexBuffer : register(t2);
 
 //------------------------  Vertex  ------------------------------//
@@ -34,7 +34,7 @@ VertexOut VSMain(uint vertexId : SV_VertexID)
 
     // Load index and vertex
     uint index = UnifiedIndexBuffer[light.UnifiedIndexBufferOffset + vertexId];
-    Vertex1P1N1UV1T1BT vertex = UnifiedVertexBuffer[light.UnifiedVertexBufferOffset + index];
+    Vertex1P1N1UV1T1BT vertex = DecompressVertex(UnifiedVertexBuffer[light.UnifiedVertexBufferOffset + index]);
 
     float2 localSpacePosition = vertex.Position.xy;
 
@@ -16,7 +16,7 @@ struct RootConstants
 #include "Utils.hlsl"
 
 ConstantBuffer<RootConstants> RootConstantBuffer : register(b0);
-StructuredBuffer<Vertex1P1N1UV1T1BT> UnifiedVertexBuffer : register(t0);
+StructuredBuffer<Vertex1P1N1UV1T1BTCompressed> UnifiedVertexBuffer : register(t0);
 StructuredBuffer<uint> UnifiedIndexBuffer : register(t1);
 StructuredBuffer<MeshInstance> InstanceTable : register(t2);
 StructuredBuffer<Material> MaterialTable : register(t3);
@@ -49,7 +49,7 @@ VertexOut VSMain(uint indexId : SV_VertexID)
 
     // Load index and vertex
     uint index = UnifiedIndexBuffer[instanceData.UnifiedIndexBufferOffset + indexId];
-    Vertex1P1N1UV1T1BT vertex = UnifiedVertexBuffer[instanceData.UnifiedVertexBufferOffset + index];
+    Vertex1P1N1UV1T1BT vertex = DecompressVertex(UnifiedVertexBuffer[instanceData.UnifiedVertexBufferOffset + index]);
 
     float3x3 TBN = BuildTBNMatrix(vertex, instanceData);
 
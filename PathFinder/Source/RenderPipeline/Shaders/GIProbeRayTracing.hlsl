@@ -51,9 +51,9 @@ void MeshRayClosestHit(inout ProbeRayPayload payload, BuiltInTriangleIntersectio
     uint index1 = UnifiedIndexBuffer[instanceData.UnifiedIndexBufferOffset + vertexIndex0 + 1];
     uint index2 = UnifiedIndexBuffer[instanceData.UnifiedIndexBufferOffset + vertexIndex0 + 2];
 
-    Vertex1P1N1UV1T1BT vertex0 = UnifiedVertexBuffer[instanceData.UnifiedVertexBufferOffset + index0];
-    Vertex1P1N1UV1T1BT vertex1 = UnifiedVertexBuffer[instanceData.UnifiedVertexBufferOffset + index1];
-    Vertex1P1N1UV1T1BT vertex2 = UnifiedVertexBuffer[instanceData.UnifiedVertexBufferOffset + index2];
+    Vertex1P1N1UV1T1BT vertex0 = DecompressVertex(UnifiedVertexBuffer[instanceData.UnifiedVertexBufferOffset + index0]);
+    Vertex1P1N1UV1T1BT vertex1 = DecompressVertex(UnifiedVertexBuffer[instanceData.UnifiedVertexBufferOffset + index1]);
+    Vertex1P1N1UV1T1BT vertex2 = DecompressVertex(UnifiedVertexBuffer[instanceData.UnifiedVertexBufferOffset + index2]);
 
     float3 debugPosition = ApplyBarycentrics(vertex0.Position.xyz, vertex1.Position.xyz, vertex2.Position.xyz, attributes.barycentrics);
     debugPosition = mul(instanceData.ModelMatrix, float4(debugPosition, 1.0)).xyz;
@@ -21,7 +21,7 @@ ConstantBuffer<RootConstants> RootConstantBuffer : register(b0);
 RaytracingAccelerationStructure SceneBVH : register(t0);
 StructuredBuffer<Light> LightTable : register(t1);
 StructuredBuffer<Material> MaterialTable : register(t2);
-StructuredBuffer<Vertex1P1N1UV1T1BT> UnifiedVertexBuffer : register(t3);
+StructuredBuffer<Vertex1P1N1UV1T1BTCompressed> UnifiedVertexBuffer : register(t3);
 StructuredBuffer<uint> UnifiedIndexBuffer : register(t4);
 StructuredBuffer<MeshInstance> MeshInstanceTable : register(t5);
 
@@ -1,6 +1,8 @@
 ﻿#ifndef _Vertices__
 #define _Vertices__
 
+#include "Packing.hlsl"
+
 struct Vertex1P1N1UV
 {
     float4 Position;
@@ -17,6 +19,26 @@ struct Vertex1P1N1UV1T1BT
     float3 Bitangent;
 };
 
+// Unified vertex buffer layout, see Vertex1P1N1UV1T1BTCompressed.hpp
+struct Vertex1P1N1UV1T1BTCompressed
+{
+    float3 Position;
+    uint Normal; // Octahedral, 2 x 16 bit snorm
+    uint Tangent; // Octahedral, 2 x 16 bit snorm, lowest bit is bitangent sign
+    uint UV; // 2 x half
+};
+
+Vertex1P1N1UV1T1BT DecompressVertex(Vertex1P1N1UV1T1BTCompressed compressed)
+{
+    Vertex1P1N1UV1T1BT vertex;
+    vertex.Position = float4(compressed.Position, 1.0);
+    vertex.Normal = OctUnpackDecode(compressed.Normal);
+    vertex.Tangent = OctUnpackDecode(compressed.Tangent & ~1u);
+    vertex.Bitangent = cross(vertex.Normal, vertex.Tangent) * ((compressed.Tangent & 1u) ? -1.0 : 1.0);
+    vertex.UV = float2(f16tof32(compressed.UV), f16tof32(compressed.UV >> 16));
+    return vertex;
+}
+
 static const float2 UnitQuadVertices[4] =
 {
     float2(-0.5, -0.5),
@@ -17,6 +17,7 @@ namespace PathFinder
         ~TopRTAS() = default;
 
         void AddInstance(const BottomRTAS& blas, const HAL::RayTracingTopAccelerationStructure::InstanceInfo& instanceInfo, const glm::mat4& transform);
+        void UpdateInstanceTransform(uint64_t instanceIndex, const glm::mat4& transform);
 
         void Build();
         void Update();
@@ -112,7 +112,7 @@ namespace PathFinder
         {
             glm::vec4 vertex = inverseProjection * glm::vec4{ NDCCorners[corner], 1.f };
             vertex /= vertex.w;
-            vertex = vertex * inverseView;
+            vertex = inverseView * vertex;
             worldCorners[corner] = vertex;
         }
 
@@ -17,6 +17,7 @@ namespace PathFinder
     void FlatLight::SetRotation(const glm::quat& rotation)
     {
         mRotation = rotation;
+        mIsGPUDataDirty = true;
     }
 
     void FlatLight::SetWidth(float width)
@@ -10,6 +10,7 @@ namespace PathFinder
     void Light::SetColor(const Foundation::Color& color)
     {
         mColor = color;
+        mIsGPUDataDirty = true;
     }
 
     void Light::SetColorTemperature(Kelvin temperature)
@@ -21,6 +22,7 @@ namespace PathFinder
     {
         mLuminousPower = luminousPower;
         mLuminance = mLuminousPower / mArea / M_PI;
+        mIsGPUDataDirty = true;
 
         // Luminance due to a point on a Lambertian emitter, emitted in any direction, 
         // is equal to its total luminous power Phi divided by the emitter area A and the projected solid angle (Pi)
@@ -29,6 +31,7 @@ namespace PathFinder
     void Light::SetPosition(const glm::vec3& position)
     {
         mPosition = position;
+        mIsGPUDataDirty = true;
         ConstructModelMatrix();
     }
 
@@ -49,6 +52,11 @@ namespace PathFinder
         mIndexInGPUTable = index;
     }
 
+    void Light::SetIsGPUDataDirty(bool dirty)
+    {
+        mIsGPUDataDirty = dirty;
+    }
+
     void Light::SetArea(float area)
     {
         mArea = area;
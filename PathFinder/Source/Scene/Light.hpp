@@ -34,6 +34,7 @@ namespace PathFinder
 
         void SetIndexInGPUTable(uint32_t index);
         void SetVertexStorageLocation(const VertexStorageLocation& location);
+        void SetIsGPUDataDirty(bool dirty);
 
         void UpdatePreviousFrameValues();
         virtual void ConstructModelMatrix() = 0;
@@ -46,6 +47,9 @@ namespace PathFinder
         glm::mat4 mModelMatrix;
         uint32_t mIndexInGPUTable = 0;
 
+        // GPU table entry and acceleration structure instance need to be rewritten
+        bool mIsGPUDataDirty = true;
+
     private:
         Lumen mLuminousPower = 0.0;
         Nit mLuminance = 0.0;
@@ -66,6 +70,7 @@ namespace PathFinder
         inline const Foundation::Color& GetColor() const { return mColor; }
         inline const glm::mat4& GetModelMatrix() const { return mModelMatrix; }
         inline auto GetIndexInGPUTable() const { return mIndexInGPUTable; }
+        inline bool IsGPUDataDirty() const { return mIsGPUDataDirty; }
         inline const VertexStorageLocation& GetLocationInVertexStorage() const { return mVertexStorageLocation; }
     };
 
@@ -15,14 +15,18 @@ namespace PathFinder
         assert_format(stream.is_open(), "File (", filePath.string(), ") couldn't be opened for writing");
 
         HAL::TextureProperties dummyProperties{ HAL::ColorFormat::R8_Unsigned_Norm, HAL::TextureKind::Texture2D, Geometry::Dimensions{1}, HAL::ResourceState::Common };
+        const std::vector<uint8_t> emptyBlob;
         bitsery::Serializer<bitsery::OutputBufferedStreamAdapter> ser{ stream };
 
-        auto serializeTextureBlob = [&ser, &dummyProperties](Material::TextureData& textureData)
+        auto serializeTextureBlob = [&ser, &dummyProperties, &emptyBlob](Material::TextureData& textureData)
         {
-            HAL::TextureProperties textureProperties = (textureData.RowMajorBlob.empty() || !textureData.Texture) ? dummyProperties : textureData.Texture->Properties();
+            const std::vector<uint8_t>& blob = textureData.RowMajorBlob ? *textureData.RowMajorBlob : emptyBlob;
+            HAL::TextureProperties textureProperties = (blob.empty() || !textureData.Texture) ? dummyProperties : textureData.Texture->Properties();
             ser.object(textureProperties);
-            ser.container1b(textureData.RowMajorBlob, std::numeric_limits<uint64_t>::max());
-            textureData.RowMajorBlob.clear();
+            ser.container1b(blob, std::numeric_limits<uint64_t>::max());
+
+            // Blob is freed once every material sharing it is serialized
+            textureData.RowMajorBlob.reset();
         };
 
         serializeTextureBlob(DiffuseAlbedoMap);
@@ -46,22 +50,23 @@ namespace PathFinder
 
         bitsery::Deserializer<bitsery::InputStreamAdapter> des{ stream };
 
-        auto deserializeTextureBlob = [&des, resourceProducer](Material::TextureData& textureData)
+        std::vector<uint8_t> blob;
+
+        auto deserializeTextureBlob = [&des, &blob, resourceProducer](Material::TextureData& textureData)
         {
             HAL::TextureProperties textureProperties{ HAL::ColorFormat::R8_Unsigned_Norm, HAL::TextureKind::Texture2D, Geometry::Dimensions{1}, HAL::ResourceState::Common };
             des.object(textureProperties);
-            des.container1b(textureData.RowMajorBlob, std::numeric_limits<uint64_t>::max());
+            des.container1b(blob, std::numeric_limits<uint64_t>::max());
 
-            if (textureData.RowMajorBlob.empty())
+            if (blob.empty())
                 return;
 
             textureData.Texture = resourceProducer->NewTexture(textureProperties);
 
-            assert_format(textureData.RowMajorBlob.size() == textureData.Texture->Footprint().TotalSizeInBytes(), "Serialized blob does not match resource size");
+            assert_format(blob.size() == textureData.Texture->Footprint().TotalSizeInBytes(), "Serialized blob does not match resource size");
 
             textureData.Texture->RequestWrite();
-            textureData.Texture->Write(textureData.RowMajorBlob.data(), 0, textureData.Texture->Footprint().TotalSizeInBytes());
-            textureData.RowMajorBlob.clear();
+            textureData.Texture->Write(blob.data(), 0, textureData.Texture->Footprint().TotalSizeInBytes());
         };
 
         deserializeTextureBlob(DiffuseAlbedoMap);
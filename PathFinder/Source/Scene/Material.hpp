@@ -20,7 +20,10 @@ namespace PathFinder
             std::filesystem::path FilePath;
             Memory::GPUResourceProducer::TexturePtr Texture;
             WrapMode Wrapping = WrapMode::Repeat;
-            std::vector<uint8_t> RowMajorBlob;
+
+            // CPU copy of texture data laid out as in texture footprint. Only kept when the scene is
+            // going to be serialized and shared by all materials that reference the same texture.
+            std::shared_ptr<const std::vector<uint8_t>> RowMajorBlob;
 
             template <typename S>
             void serialize(S& s)
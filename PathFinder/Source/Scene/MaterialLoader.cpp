@@ -6,21 +6,65 @@ namespace PathFinder
 {
 
     MaterialLoader::MaterialLoader(const std::filesystem::path& executableFolderPath, Memory::GPUResourceProducer* resourceProducer)
-        : mResourceLoader{ resourceProducer }, mResourceProducer{ resourceProducer }
+        : mResourceLoader{ resourceProducer }, mResourceProducer{ resourceProducer }, mTextureStreamer{ resourceProducer }
     {
         CreateDefaultTextures();
         LoadLTCLookupTables(executableFolderPath);
     }
 
-    void MaterialLoader::LoadMaterial(Material& material)
+    void MaterialLoader::PrefetchTextureFiles(const Material& material, Foundation::ThreadPool* threadPool)
     {
-        auto loadTexture = [this](Material::TextureData& textureData)
+        for (const Material::TextureData* textureData : { 
+            &material.DiffuseAlbedoMap, &material.SpecularAlbedoMap, &material.NormalMap, &material.RoughnessMap, 
+            &material.MetalnessMap, &material.TranslucencyMap, &material.DisplacementMap, &material.DistanceField })
         {
-            if (!std::filesystem::exists(textureData.FilePath))
+            if (textureData->FilePath.empty())
+                continue;
+
+            auto [iterator, isNewFile] = mPrefetchedTextureFiles.emplace(textureData->FilePath.string(), std::nullopt);
+
+            if (!isNewFile)
+                continue;
+
+            std::optional<ResourceLoader::TextureFile>* file = &iterator->second;
+            std::filesystem::path path = textureData->FilePath;
+
+            threadPool->Execute([file, path]
+            {
+                if (std::filesystem::exists(path))
+                {
+                    *file = ResourceLoader::ReadTextureFile(path, true);
+                }
+            });
+        }
+    }
+
+    void MaterialLoader::ClearPrefetchedTextureFiles()
+    {
+        mPrefetchedTextureFiles.clear();
+    }
+
+    void MaterialLoader::LoadMaterial(Material& material, bool keepTextureDataForSerialization, bool streamTextures)
+    {
+        std::vector<std::pair<Memory::Texture*, TextureStreamer::TextureId>> streamedTextures;
+
+        auto loadTexture = [&](Material::TextureData& textureData)
+        {
+            if (textureData.FilePath.empty())
                 return;
 
-            textureData.Texture = mResourceLoader.LoadTexture(textureData.FilePath, true);
-            textureData.RowMajorBlob = std::move(mResourceLoader.RowMajorBlob());
+            TextureReference reference = GetOrLoadTexture(textureData.FilePath, keepTextureDataForSerialization, streamTextures);
+
+            if (!reference.Texture)
+                return;
+
+            textureData.Texture = Memory::GPUResourceProducer::TexturePtr{ reference.Texture, [](Memory::Texture* texture) {} };
+            textureData.RowMajorBlob = std::move(reference.RowMajorBlob);
+
+            if (reference.StreamedTextureId)
+            {
+                streamedTextures.emplace_back(reference.Texture, *reference.StreamedTextureId);
+            }
         };
 
         loadTexture(material.DiffuseAlbedoMap);
@@ -33,6 +77,21 @@ namespace PathFinder
         loadTexture(material.DistanceField);
 
         SetCommonMaterialTextures(material);
+
+        // Slots that fell back to textures of other slots have to be repointed along with them
+        for (Material::TextureData* textureData : {
+            &material.DiffuseAlbedoMap, &material.SpecularAlbedoMap, &material.NormalMap, &material.RoughnessMap,
+            &material.MetalnessMap, &material.TranslucencyMap, &material.DisplacementMap, &material.DistanceField })
+        {
+            for (auto [texture, textureId] : streamedTextures)
+            {
+                if (textureData->Texture.get() == texture)
+                {
+                    mTextureStreamer.AddReference(textureId, textureData);
+                    break;
+                }
+            }
+        }
     }
 
     void MaterialLoader::SetCommonMaterialTextures(Material& material)
@@ -70,6 +129,67 @@ namespace PathFinder
         material.LTC_LUT_Terms_Diffuse = mLTC_LUT_Terms_DisneyDiffuseNormalized.get();
     }
 
+    Memory::Texture* MaterialLoader::GetOrCreateTexture(uint64_t contentHash, const HAL::TextureProperties& properties, const uint8_t* rowMajorData, uint64_t dataSize)
+    {
+        const MaterialTextureCache::Entry& cachedTexture = mTextureCache.GetOrCreate(contentHash, [&]
+        {
+            Memory::GPUResourceProducer::TexturePtr texture = mResourceProducer->NewTexture(properties);
+
+            assert_format(dataSize == texture->Footprint().TotalSizeInBytes(), "Texture data does not match resource size");
+
+            texture->RequestWrite();
+            texture->Write(rowMajorData, 0, dataSize);
+
+            return texture;
+        });
+
+        return cachedTexture.Texture.get();
+    }
+
+    MaterialLoader::TextureReference MaterialLoader::GetOrLoadTexture(const std::filesystem::path& texturePath, bool keepRowMajorBlob, bool streamTexture)
+    {
+        MaterialTextureCache::Reference cacheReference = mTextureCache.GetOrLoad(texturePath.lexically_normal().string(), keepRowMajorBlob,
+            [this, &texturePath] { return AcquireTextureFile(texturePath); },
+            [this, keepRowMajorBlob, streamTexture](ResourceLoader::TextureFile& file, MaterialTextureCache::Entry& cachedTexture) -> MaterialTextureCache::RowMajorBlob
+            {
+                if (streamTexture && !keepRowMajorBlob && TextureStreamer::CanStream(file))
+                {
+                    cachedTexture.StreamedTextureId = mTextureStreamer.AddTexture(std::move(file));
+                    return nullptr;
+                }
+
+                cachedTexture.Texture = mResourceLoader.LoadTexture(file, keepRowMajorBlob);
+
+                return keepRowMajorBlob ? std::make_shared<const std::vector<uint8_t>>(std::move(mResourceLoader.RowMajorBlob())) : nullptr;
+            });
+
+        if (!cacheReference.CachedTexture)
+            return {};
+
+        const MaterialTextureCache::Entry& cachedTexture = *cacheReference.CachedTexture;
+
+        Memory::Texture* texture = cachedTexture.StreamedTextureId ?
+            mTextureStreamer.CurrentTexture(*cachedTexture.StreamedTextureId) : cachedTexture.Texture.get();
+
+        return TextureReference{ texture, std::move(cacheReference.Blob), cachedTexture.StreamedTextureId };
+    }
+
+    std::optional<ResourceLoader::TextureFile> MaterialLoader::AcquireTextureFile(const std::filesystem::path& texturePath)
+    {
+        auto prefetchedFileIt = mPrefetchedTextureFiles.find(texturePath.string());
+
+        if (prefetchedFileIt == mPrefetchedTextureFiles.end())
+        {
+            return std::filesystem::exists(texturePath) ? ResourceLoader::ReadTextureFile(texturePath, true) : std::nullopt;
+        }
+
+        // File can be unmapped once texture data is in upload memory
+        std::optional<ResourceLoader::TextureFile> file = std::move(prefetchedFileIt->second);
+        mPrefetchedTextureFiles.erase(prefetchedFileIt);
+
+        return file;
+    }
+
     void MaterialLoader::CreateDefaultTextures()
     {
         HAL::TextureProperties dummy2DTextureProperties{
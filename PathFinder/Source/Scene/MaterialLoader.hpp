@@ -2,9 +2,12 @@
 
 #include "Material.hpp"
 #include "ResourceLoader.hpp"
+#include "TextureStreamer.hpp"
+#include "TextureCache.hpp"
 
 #include <HardwareAbstractionLayer/Buffer.hpp>
 #include <Memory/GPUResourceProducer.hpp>
+#include <Foundation/ThreadPool.hpp>
 #include <robinhood/robin_hood.h>
 
 #include <filesystem>
@@ -19,12 +22,34 @@ namespace PathFinder
     public:
         MaterialLoader(const std::filesystem::path& executableFolderPath, Memory::GPUResourceProducer* resourceProducer);
 
-        void LoadMaterial(Material& material);
+        // Schedules reading and parsing of material texture files on a thread pool.
+        // LoadMaterial will use prefetched files once the pool finishes all tasks.
+        void PrefetchTextureFiles(const Material& material, Foundation::ThreadPool* threadPool);
+        void ClearPrefetchedTextureFiles();
+
+        using MaterialTextureCache = TextureCache<Memory::GPUResourceProducer::TexturePtr>;
+
+        // Textures referenced by several materials, by the same path or by files with identical contents,
+        // are loaded once and shared. CPU copies of texture data are only kept when requested for serialization.
+        // Streamed textures start with their mip tails and are swapped in material as more mips are loaded,
+        // so material must stay at the same address afterwards. Textures kept for serialization are never streamed.
+        void LoadMaterial(Material& material, bool keepTextureDataForSerialization = false, bool streamTextures = false);
         void SetCommonMaterialTextures(Material& material);
 
+        // Textures that come from sources other than files, like scene containers, go into the same cache by hash of their row major data.
+        // Cache keeps ownership, so every material gets an equal reference.
+        Memory::Texture* GetOrCreateTexture(uint64_t contentHash, const HAL::TextureProperties& properties, const uint8_t* rowMajorData, uint64_t dataSize);
+
     private:
-        Memory::Texture* GetOrAllocateTexture(const std::string& materialName, const std::filesystem::path& texturePath);
-        Memory::Texture* AllocateAndStoreTexture(const HAL::TextureProperties& properties, const std::string& cacheKey);
+        struct TextureReference
+        {
+            Memory::Texture* Texture = nullptr;
+            std::shared_ptr<const std::vector<uint8_t>> RowMajorBlob;
+            std::optional<TextureStreamer::TextureId> StreamedTextureId;
+        };
+
+        TextureReference GetOrLoadTexture(const std::filesystem::path& texturePath, bool keepRowMajorBlob, bool streamTexture);
+        std::optional<ResourceLoader::TextureFile> AcquireTextureFile(const std::filesystem::path& texturePath);
 
         void CreateDefaultTextures();
         void LoadLTCLookupTables(const std::filesystem::path& executableFolderPath);
@@ -41,8 +66,21 @@ namespace PathFinder
         Memory::GPUResourceProducer::TexturePtr mLTC_LUT_Matrix_DisneyDiffuseNormalized;
         Memory::GPUResourceProducer::TexturePtr mLTC_LUT_Terms_DisneyDiffuseNormalized;
 
+        // Nodes are created on the scheduling thread only, tasks just fill them in
+        robin_hood::unordered_node_map<std::string, std::optional<ResourceLoader::TextureFile>> mPrefetchedTextureFiles;
+
+        // Cache owns textures, materials only reference them.
+        // Blobs live while materials hold them, so they are freed as soon as materials are serialized.
+        MaterialTextureCache mTextureCache;
+
         Memory::GPUResourceProducer* mResourceProducer;
         ResourceLoader mResourceLoader;
+        TextureStreamer mTextureStreamer;
+
+    public:
+        inline const MaterialTextureCache::Statistics& TextureCacheStats() const { return mTextureCache.Stats(); }
+        inline TextureStreamer& GetTextureStreamer() { return mTextureStreamer; }
+        inline const TextureStreamer& GetTextureStreamer() const { return mTextureStreamer; }
     };
 
 }
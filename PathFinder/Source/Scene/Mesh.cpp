@@ -48,6 +48,11 @@ namespace PathFinder
         return mHasTangentSpace;
     }
 
+    const std::optional<MeshOptimizer::Report>& Mesh::GetOptimizationReport() const
+    {
+        return mOptimizationReport;
+    }
+
     void Mesh::SetName(const std::string& name)
     {
         mName = name;
@@ -63,6 +68,11 @@ namespace PathFinder
         mVertexStorageLocation = location;
     }
 
+    void Mesh::SetOptimizationReport(const MeshOptimizer::Report& report)
+    {
+        mOptimizationReport = report;
+    }
+
     void Mesh::AddVertex(const Vertex1P1N1UV1T1BT& vertex)
     {
         mBoundingBox.SetMin(glm::min(glm::vec3(vertex.Position), mBoundingBox.GetMin()));
@@ -90,6 +100,49 @@ namespace PathFinder
         mIndices.push_back(index);
     }
 
+    void Mesh::AddVertices(const Vertex1P1N1UV1T1BT* vertices, uint64_t vertexCount)
+    {
+        uint64_t firstNewVertex = mVertices.size();
+        mVertices.insert(mVertices.end(), vertices, vertices + vertexCount);
+
+        glm::vec3 min = mBoundingBox.GetMin();
+        glm::vec3 max = mBoundingBox.GetMax();
+
+        for (uint64_t i = 0; i < vertexCount; ++i)
+        {
+            const Vertex1P1N1UV1T1BT& vertex = vertices[i];
+
+            min = glm::min(glm::vec3(vertex.Position), min);
+            max = glm::max(glm::vec3(vertex.Position), max);
+
+            if (glm::length2(vertex.Tangent) <= 0.0 || glm::length2(vertex.Bitangent) <= 0)
+            {
+                mHasTangentSpace = false;
+            }
+        }
+
+        mBoundingBox.SetMin(min);
+        mBoundingBox.SetMax(max);
+
+        // Same triangles AddVertex would have accounted for: every completed vertex triple
+        for (uint64_t count = ((firstNewVertex / 3) + 1) * 3; count <= mVertices.size(); count += 3)
+        {
+            Geometry::Triangle3D triangle(mVertices[count - 3].Position, mVertices[count - 2].Position, mVertices[count - 1].Position);
+            mArea += triangle.GetArea();
+        }
+    }
+
+    void Mesh::AddIndices(const uint32_t* indices, uint64_t indexCount)
+    {
+        mIndices.insert(mIndices.end(), indices, indices + indexCount);
+    }
+
+    void Mesh::SetVertexData(std::vector<Vertex1P1N1UV1T1BT>&& vertices, std::vector<uint32_t>&& indices)
+    {
+        mVertices = std::move(vertices);
+        mIndices = std::move(indices);
+    }
+
     void Mesh::SerializeVertexData(const std::filesystem::path& path)
     {
         std::fstream stream{ path, std::ios::binary | std::ios::trunc | std::ios::out };
@@ -6,6 +6,7 @@
 #include <optional>
 
 #include "VertexStorageLocation.hpp"
+#include "MeshOptimizer.hpp"
 #include "Vertices/Vertex1P1N1UV1T1BT.hpp"
 
 #include <bitsery/bitsery.h>
@@ -27,12 +28,24 @@ namespace PathFinder
         float GetSurfaceArea() const;
         bool HasTangentSpace() const;
 
+        // Vertex cache and fetch statistics of import time optimization, empty for meshes that were not optimized
+        const std::optional<MeshOptimizer::Report>& GetOptimizationReport() const;
+
         void SetName(const std::string& name);
         void SetHasTangentSpace(bool hts);
         void SetVertexStorageLocation(const VertexStorageLocation& location);
+        void SetOptimizationReport(const MeshOptimizer::Report& report);
         void AddVertex(const Vertex1P1N1UV1T1BT& vertex);
         void AddIndex(uint32_t index);
 
+        // Bulk counterparts of AddVertex and AddIndex.
+        // Bounds, area and tangent space presence are updated once for the whole range.
+        void AddVertices(const Vertex1P1N1UV1T1BT* vertices, uint64_t vertexCount);
+        void AddIndices(const uint32_t* indices, uint64_t indexCount);
+
+        // Replaces vertex data of a deserialized mesh. Bounds, area and tangent space presence are serialized separately and left intact.
+        void SetVertexData(std::vector<Vertex1P1N1UV1T1BT>&& vertices, std::vector<uint32_t>&& indices);
+
         void SerializeVertexData(const std::filesystem::path& path);
         void DeserializeVertexData(const std::filesystem::path& path);
 
@@ -55,6 +68,7 @@ namespace PathFinder
         Geometry::AABB mBoundingBox = Geometry::AABB::MaximumReversed();
         float mArea = 0.0;
         bool mHasTangentSpace = true;
+        std::optional<MeshOptimizer::Report> mOptimizationReport;
     };
 
 }
@@ -8,6 +8,14 @@ namespace PathFinder
 
     void MeshInstance::UpdatePreviousFrameValues()
     {
+        // Previous transformation is uploaded as well,
+        // so an instance moved last frame needs one more upload to catch up
+        if (mIsTransformationChanged)
+        {
+            mIsGPUDataDirty = true;
+            mIsTransformationChanged = false;
+        }
+
         mPreviousTransformation = mTransformation;
     }
 
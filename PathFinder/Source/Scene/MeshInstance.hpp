@@ -49,6 +49,10 @@ namespace PathFinder
         Geometry::Transformation mPreviousTransformation;
         uint32_t mIndexInGPUTable = 0;
 
+        // GPU table entry and acceleration structure instance need to be rewritten
+        bool mIsGPUDataDirty = true;
+        bool mIsTransformationChanged = false;
+
     public:
         inline bool IsDoubleSided() const { return mIsDoubleSided; }
         inline bool IsSelected() const { return mIsSelected; }
@@ -61,13 +65,15 @@ namespace PathFinder
         inline Mesh* GetAssociatedMesh() { return mMesh; }
         inline Material* GetAssociatedMaterial() { return mMaterial; }
         inline auto GetIndexInGPUTable () const { return mIndexInGPUTable; }
+        inline bool IsGPUDataDirty() const { return mIsGPUDataDirty; }
 
-        inline void SetIsDoubleSided(bool doubleSided) { mIsDoubleSided = doubleSided; }
+        inline void SetIsDoubleSided(bool doubleSided) { mIsDoubleSided = doubleSided; mIsGPUDataDirty = true; }
         inline void SetIsSelected(bool selected) { mIsSelected = selected; }
         inline void SetIsHighlighted(bool highlighted) { mIsHighlighted = highlighted; }
-        inline void SetTransformation(const Geometry::Transformation& transform) { mTransformation = transform; }
+        inline void SetTransformation(const Geometry::Transformation& transform) { mTransformation = transform; mIsTransformationChanged = true; mIsGPUDataDirty = true; }
         inline void SetIndexInGPUTable(uint32_t index) { mIndexInGPUTable = index; }
-        inline void SetMaterial(Material* material) { mMaterial = material; }
+        inline void SetMaterial(Material* material) { mMaterial = material; mIsGPUDataDirty = true; }
+        inline void SetIsGPUDataDirty(bool dirty) { mIsGPUDataDirty = dirty; }
     };
 
 }
@@ -0,0 +1,466 @@
+#include "MeshOptimizer.hpp"
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+        // Forsyth's tuning constants
+        constexpr float CacheDecayPower = 1.5f;
+        constexpr float LastTriangleScore = 0.75f;
+        constexpr float ValenceBoostScale = 2.0f;
+        constexpr float ValenceBoostPower = 0.5f;
+        constexpr uint32_t ValenceScoreTableSize = 64;
+
+        // FIFO cache that is cleared in constant time by moving current timestamp past every cached entry
+        class FIFOCache
+        {
+        public:
+            FIFOCache(uint64_t elementCount, uint64_t cacheSize)
+                : mTimestamps(elementCount, 0), mCacheSize{ cacheSize }, mTimestamp{ cacheSize + 1 } {}
+
+            // Returns true on a hit
+            bool Access(uint64_t element)
+            {
+                if (mTimestamp - mTimestamps[element] <= mCacheSize)
+                    return true;
+
+                mTimestamps[element] = mTimestamp++;
+                return false;
+            }
+
+            void Clear()
+            {
+                mTimestamp += mCacheSize + 1;
+            }
+
+        private:
+            std::vector<uint64_t> mTimestamps;
+            uint64_t mCacheSize;
+            uint64_t mTimestamp;
+        };
+    }
+
+    MeshOptimizer::Report MeshOptimizer::Optimize(std::vector<Vertex1P1N1UV1T1BT>& vertices, std::vector<uint32_t>& indices)
+    {
+        Report report;
+        report.Original = Analyze(indices, vertices.size(), sizeof(Vertex1P1N1UV1T1BT));
+
+        OptimizeVertexCache(indices, vertices.size());
+        OptimizeOverdraw(indices, vertices);
+        OptimizeVertexFetch(vertices, indices);
+
+        report.Optimized = Analyze(indices, vertices.size(), sizeof(Vertex1P1N1UV1T1BT));
+        return report;
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, uint64_t vertexCount)
+    {
+        assert_format(indices.size() % 3 == 0, "Only triangle lists can be optimized");
+
+        uint64_t triangleCount = indices.size() / 3;
+
+        if (triangleCount == 0)
+            return;
+
+        // Triangles adjacent to each vertex. Emitted triangles are swapped out of the live part of a vertex's range.
+        std::vector<uint32_t> liveTriangleCounts(vertexCount, 0);
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        std::vector<uint32_t> adjacentTriangles(indices.size());
+
+        for (uint32_t index : indices)
+        {
+            ++liveTriangleCounts[index];
+        }
+
+        for (auto vertexIdx = 0; vertexIdx < vertexCount; ++vertexIdx)
+        {
+            adjacencyOffsets[vertexIdx + 1] = adjacencyOffsets[vertexIdx] + liveTriangleCounts[vertexIdx];
+        }
+
+        std::fill(liveTriangleCounts.begin(), liveTriangleCounts.end(), 0);
+
+        for (auto triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+        {
+            for (auto corner = 0; corner < 3; ++corner)
+            {
+                uint32_t vertexIdx = indices[triangleIdx * 3 + corner];
+                adjacentTriangles[adjacencyOffsets[vertexIdx] + liveTriangleCounts[vertexIdx]++] = triangleIdx;
+            }
+        }
+
+        // Scores are tabulated, since every emitted triangle rescores the whole cache
+        float cachePositionScores[OptimizationCacheSize];
+        float valenceScores[ValenceScoreTableSize];
+
+        for (auto position = 0; position < OptimizationCacheSize; ++position)
+        {
+            // Vertices of the last triangle get a fixed score, so that it isn't simply repeated with a different winding
+            cachePositionScores[position] = position < 3 ?
+                LastTriangleScore :
+                std::pow(1.0f - float(position - 3) / (OptimizationCacheSize - 3), CacheDecayPower);
+        }
+
+        for (auto valence = 1; valence < ValenceScoreTableSize; ++valence)
+        {
+            valenceScores[valence] = ValenceBoostScale * std::pow(float(valence), -ValenceBoostPower);
+        }
+
+        // Vertices with few triangles left are preferred, so that they are finished off and not left as lone triangles
+        auto vertexScore = [&cachePositionScores, &valenceScores](int32_t cachePosition, uint32_t liveTriangleCount) -> float
+        {
+            if (liveTriangleCount == 0)
+                return -1.0f;
+
+            float score = cachePosition >= 0 ? cachePositionScores[cachePosition] : 0.0f;
+
+            return score + (liveTriangleCount < ValenceScoreTableSize ?
+                valenceScores[liveTriangleCount] :
+                ValenceBoostScale * std::pow(float(liveTriangleCount), -ValenceBoostPower));
+        };
+
+        std::vector<int32_t> cachePositions(vertexCount, -1);
+        std::vector<float> vertexScores(vertexCount);
+        std::vector<float> triangleScores(triangleCount);
+        std::vector<bool> emittedTriangles(triangleCount, false);
+
+        // Marks vertices already placed into the cache on the current step
+        std::vector<uint32_t> newCacheStamps(vertexCount, InvalidIndex);
+
+        for (auto vertexIdx = 0; vertexIdx < vertexCount; ++vertexIdx)
+        {
+            vertexScores[vertexIdx] = vertexScore(-1, liveTriangleCounts[vertexIdx]);
+        }
+
+        uint32_t bestTriangle = 0;
+
+        for (auto triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+        {
+            const uint32_t* triangle = &indices[triangleIdx * 3];
+            triangleScores[triangleIdx] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+
+            if (triangleScores[triangleIdx] > triangleScores[bestTriangle])
+            {
+                bestTriangle = triangleIdx;
+            }
+        }
+
+        std::vector<uint32_t> optimizedIndices;
+        optimizedIndices.reserve(indices.size());
+
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> newCache;
+        cache.reserve(OptimizationCacheSize);
+        newCache.reserve(OptimizationCacheSize + 3);
+
+        uint64_t deadEndCursor = 0;
+
+        for (uint32_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+        {
+            // No triangle is adjacent to cached vertices, take any that's left
+            if (bestTriangle == InvalidIndex)
+            {
+                while (emittedTriangles[deadEndCursor]) ++deadEndCursor;
+                bestTriangle = deadEndCursor;
+            }
+
+            const uint32_t* triangle = &indices[bestTriangle * 3];
+            optimizedIndices.insert(optimizedIndices.end(), triangle, triangle + 3);
+            emittedTriangles[bestTriangle] = true;
+            newCache.clear();
+
+            for (auto corner = 0; corner < 3; ++corner)
+            {
+                uint32_t vertexIdx = triangle[corner];
+                uint32_t* liveTriangles = &adjacentTriangles[adjacencyOffsets[vertexIdx]];
+                uint32_t& liveTriangleCount = liveTriangleCounts[vertexIdx];
+
+                // Removes a single entry, degenerate triangles are listed once per corner
+                uint32_t* entry = std::find(liveTriangles, liveTriangles + liveTriangleCount, bestTriangle);
+                std::swap(*entry, liveTriangles[liveTriangleCount - 1]);
+                --liveTriangleCount;
+
+                if (newCacheStamps[vertexIdx] != emittedCount)
+                {
+                    newCacheStamps[vertexIdx] = emittedCount;
+                    newCache.push_back(vertexIdx);
+                }
+            }
+
+            for (uint32_t vertexIdx : cache)
+            {
+                if (newCacheStamps[vertexIdx] != emittedCount)
+                {
+                    newCacheStamps[vertexIdx] = emittedCount;
+                    newCache.push_back(vertexIdx);
+                }
+            }
+
+            // Vertices pushed out of the cache are still rescored, they lose their cache bonus
+            for (auto position = 0; position < newCache.size(); ++position)
+            {
+                uint32_t vertexIdx = newCache[position];
+                cachePositions[vertexIdx] = position < OptimizationCacheSize ? position : -1;
+                vertexScores[vertexIdx] = vertexScore(cachePositions[vertexIdx], liveTriangleCounts[vertexIdx]);
+            }
+
+            cache.assign(newCache.begin(), newCache.begin() + std::min<uint64_t>(newCache.size(), OptimizationCacheSize));
+
+            // Only triangles of rescored vertices changed, so the next best one is among them
+            bestTriangle = InvalidIndex;
+            float bestScore = -std::numeric_limits<float>::max();
+
+            for (uint32_t vertexIdx : newCache)
+            {
+                const uint32_t* liveTriangles = &adjacentTriangles[adjacencyOffsets[vertexIdx]];
+
+                for (auto i = 0u; i < liveTriangleCounts[vertexIdx]; ++i)
+                {
+                    uint32_t triangleIdx = liveTriangles[i];
+                    const uint32_t* adjacentTriangle = &indices[triangleIdx * 3];
+
+                    triangleScores[triangleIdx] =
+                        vertexScores[adjacentTriangle[0]] + vertexScores[adjacentTriangle[1]] + vertexScores[adjacentTriangle[2]];
+
+                    if (triangleScores[triangleIdx] > bestScore)
+                    {
+                        bestScore = triangleScores[triangleIdx];
+                        bestTriangle = triangleIdx;
+                    }
+                }
+            }
+        }
+
+        indices = std::move(optimizedIndices);
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex1P1N1UV1T1BT>& vertices, float threshold)
+    {
+        assert_format(indices.size() % 3 == 0, "Only triangle lists can be optimized");
+
+        uint64_t triangleCount = indices.size() / 3;
+
+        if (triangleCount == 0)
+            return;
+
+        std::vector<uint64_t> clusters = FindClusters(indices, vertices.size(), threshold);
+        std::vector<float> clusterSortKeys(clusters.size(), 0.0f);
+        std::vector<glm::vec3> clusterCentroids(clusters.size(), glm::vec3{ 0.0f });
+        std::vector<glm::vec3> clusterNormals(clusters.size(), glm::vec3{ 0.0f });
+        std::vector<float> clusterAreas(clusters.size(), 0.0f);
+
+        glm::vec3 meshCentroid{ 0.0f };
+        float meshArea = 0.0f;
+
+        auto clusterEnd = [&](uint64_t clusterIdx) { return clusterIdx + 1 < clusters.size() ? clusters[clusterIdx + 1] : triangleCount; };
+
+        for (auto clusterIdx = 0; clusterIdx < clusters.size(); ++clusterIdx)
+        {
+            for (auto triangleIdx = clusters[clusterIdx]; triangleIdx < clusterEnd(clusterIdx); ++triangleIdx)
+            {
+                glm::vec3 p0 = vertices[indices[triangleIdx * 3 + 0]].Position;
+                glm::vec3 p1 = vertices[indices[triangleIdx * 3 + 1]].Position;
+                glm::vec3 p2 = vertices[indices[triangleIdx * 3 + 2]].Position;
+
+                // Unnormalized normal, so that larger triangles contribute more
+                glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+                float area = glm::length(normal) * 0.5f;
+
+                clusterCentroids[clusterIdx] += (p0 + p1 + p2) * (area / 3.0f);
+                clusterNormals[clusterIdx] += normal;
+                clusterAreas[clusterIdx] += area;
+            }
+
+            meshCentroid += clusterCentroids[clusterIdx];
+            meshArea += clusterAreas[clusterIdx];
+        }
+
+        // Nothing to orient clusters by
+        if (meshArea <= 0.0f)
+            return;
+
+        meshCentroid /= meshArea;
+
+        for (auto clusterIdx = 0; clusterIdx < clusters.size(); ++clusterIdx)
+        {
+            float normalLength = glm::length(clusterNormals[clusterIdx]);
+
+            if (clusterAreas[clusterIdx] <= 0.0f || normalLength <= 0.0f)
+                continue;
+
+            glm::vec3 centroid = clusterCentroids[clusterIdx] / clusterAreas[clusterIdx];
+            clusterSortKeys[clusterIdx] = glm::dot(centroid - meshCentroid, clusterNormals[clusterIdx] / normalLength);
+        }
+
+        // Clusters facing away from mesh center occlude the rest from most view directions and go first
+        std::vector<uint64_t> clusterOrder(clusters.size());
+        std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+        std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&clusterSortKeys](uint64_t first, uint64_t second)
+        {
+            return clusterSortKeys[first] > clusterSortKeys[second];
+        });
+
+        std::vector<uint32_t> optimizedIndices;
+        optimizedIndices.reserve(indices.size());
+
+        for (uint64_t clusterIdx : clusterOrder)
+        {
+            optimizedIndices.insert(optimizedIndices.end(), indices.begin() + clusters[clusterIdx] * 3, indices.begin() + clusterEnd(clusterIdx) * 3);
+        }
+
+        indices = std::move(optimizedIndices);
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex1P1N1UV1T1BT>& vertices, std::vector<uint32_t>& indices)
+    {
+        std::vector<uint32_t> remap(vertices.size(), InvalidIndex);
+        std::vector<Vertex1P1N1UV1T1BT> optimizedVertices;
+        optimizedVertices.reserve(vertices.size());
+
+        for (uint32_t& index : indices)
+        {
+            if (remap[index] == InvalidIndex)
+            {
+                remap[index] = optimizedVertices.size();
+                optimizedVertices.push_back(vertices[index]);
+            }
+
+            index = remap[index];
+        }
+
+        vertices = std::move(optimizedVertices);
+    }
+
+    MeshOptimizer::Statistics MeshOptimizer::Analyze(const std::vector<uint32_t>& indices, uint64_t vertexCount, uint64_t vertexStride)
+    {
+        Statistics statistics;
+        uint64_t triangleCount = indices.size() / 3;
+
+        if (triangleCount == 0)
+            return statistics;
+
+        FIFOCache vertexCache{ vertexCount, AnalysisCacheSize };
+        FIFOCache lineCache{ (vertexCount * vertexStride + FetchCacheLineSize - 1) / FetchCacheLineSize, FetchCacheLineCount };
+        std::vector<bool> referencedVertices(vertexCount, false);
+
+        uint64_t transformedVertexCount = 0;
+        uint64_t referencedVertexCount = 0;
+        uint64_t fetchedLineCount = 0;
+
+        for (auto i = 0; i < triangleCount * 3; ++i)
+        {
+            uint32_t index = indices[i];
+
+            if (!referencedVertices[index])
+            {
+                referencedVertices[index] = true;
+                ++referencedVertexCount;
+            }
+
+            if (vertexCache.Access(index))
+                continue;
+
+            ++transformedVertexCount;
+
+            // Only vertices that are transformed are fetched
+            uint64_t firstLine = index * vertexStride / FetchCacheLineSize;
+            uint64_t lastLine = ((index + 1) * vertexStride - 1) / FetchCacheLineSize;
+
+            for (auto line = firstLine; line <= lastLine; ++line)
+            {
+                if (!lineCache.Access(line))
+                {
+                    ++fetchedLineCount;
+                }
+            }
+        }
+
+        statistics.ACMR = float(transformedVertexCount) / triangleCount;
+        statistics.ATVR = float(transformedVertexCount) / referencedVertexCount;
+        statistics.Overfetch = float(fetchedLineCount * FetchCacheLineSize) / (referencedVertexCount * vertexStride);
+
+        return statistics;
+    }
+
+    std::vector<uint64_t> MeshOptimizer::FindClusters(const std::vector<uint32_t>& indices, uint64_t vertexCount, float threshold)
+    {
+        uint64_t triangleCount = indices.size() / 3;
+        FIFOCache cache{ vertexCount, AnalysisCacheSize };
+
+        auto triangleMissCount = [&](uint64_t triangleIdx)
+        {
+            return uint64_t(!cache.Access(indices[triangleIdx * 3 + 0])) +
+                uint64_t(!cache.Access(indices[triangleIdx * 3 + 1])) +
+                uint64_t(!cache.Access(indices[triangleIdx * 3 + 2]));
+        };
+
+        // Cache reuse doesn't cross triangles that miss on every vertex, so reordering around them is free
+        std::vector<uint64_t> hardBoundaries{ 0 };
+
+        for (auto triangleIdx = 0; triangleIdx < triangleCount; ++triangleIdx)
+        {
+            if (triangleMissCount(triangleIdx) == 3 && triangleIdx > 0)
+            {
+                hardBoundaries.push_back(triangleIdx);
+            }
+        }
+
+        std::vector<uint64_t> clusters;
+
+        for (auto boundaryIdx = 0; boundaryIdx < hardBoundaries.size(); ++boundaryIdx)
+        {
+            uint64_t start = hardBoundaries[boundaryIdx];
+            uint64_t end = boundaryIdx + 1 < hardBoundaries.size() ? hardBoundaries[boundaryIdx + 1] : triangleCount;
+
+            cache.Clear();
+            uint64_t missCount = 0;
+
+            for (auto triangleIdx = start; triangleIdx < end; ++triangleIdx)
+            {
+                missCount += triangleMissCount(triangleIdx);
+            }
+
+            float targetACMR = threshold * missCount / (end - start);
+
+            // A cluster is closed as soon as its ACMR is within the target, cache is then flushed
+            // to account for cluster being drawn after an arbitrary other one
+            clusters.push_back(start);
+            cache.Clear();
+
+            uint64_t runningMissCount = 0;
+            uint64_t runningTriangleCount = 0;
+
+            for (auto triangleIdx = start; triangleIdx < end; ++triangleIdx)
+            {
+                runningMissCount += triangleMissCount(triangleIdx);
+                ++runningTriangleCount;
+
+                if (float(runningMissCount) / runningTriangleCount <= targetACMR)
+                {
+                    clusters.push_back(triangleIdx + 1);
+                    cache.Clear();
+                    runningMissCount = 0;
+                    runningTriangleCount = 0;
+                }
+            }
+
+            // Cluster closed on the last triangle would otherwise be empty
+            if (clusters.back() == end)
+            {
+                clusters.pop_back();
+            }
+        }
+
+        return clusters;
+    }
+
+}
@@ -1,10 +1,9 @@
-#define DDSKTX_IMPLEMENT
-
 #include "ResourceLoader.hpp"
 
-#include <fstream>
-#include <iterator>
-#include <vector>
+#include <robinhood/robin_hood.h>
+
+#include <algorithm>
+#include <cstring>
 
 namespace PathFinder
 {
@@ -12,107 +11,118 @@ namespace PathFinder
     ResourceLoader::ResourceLoader(Memory::GPUResourceProducer* resourceProducer)
         : mResourceProducer{ resourceProducer } {}
 
-    Memory::GPUResourceProducer::TexturePtr ResourceLoader::LoadTexture(const std::filesystem::path& path, bool saveRowMajorBlob) 
+    std::optional<ResourceLoader::TextureFile> ResourceLoader::ReadTextureFile(const std::filesystem::path& path, bool computeContentHash)
     {
-        std::ifstream input{ path, std::ios::binary };
-        
-        if (!input.is_open())
+        TextureFile file{};
+        file.Path = path;
+        file.Mapping = Foundation::MemoryMappedFile{ path };
+
+        if (!file.Mapping.IsMapped())
         {
-            return nullptr;
+            return std::nullopt;
         }
-        
-        std::uintmax_t fileSize = std::filesystem::file_size(path);
-
-        std::vector<uint8_t> bytes;
-        bytes.resize(fileSize);
 
-        input.read((char *)bytes.data(), bytes.size());
-
-        ddsktx_texture_info textureInfo;
         ddsktx_error error;
 
-        if (!ddsktx_parse(&textureInfo, bytes.data(), (int)bytes.size(), &error))
+        if (!ddsktx_parse(&file.Info, file.Mapping.Data(), (int)file.Mapping.Size(), &error))
         {
-            return nullptr;
+            return std::nullopt;
         }
 
-        assert_format(textureInfo.num_layers == 1, "Texture arrays are not supported yet");
+        if (computeContentHash)
+        {
+            file.ContentHash = robin_hood::hash_bytes(file.Mapping.Data(), file.Mapping.Size());
+        }
 
-        bool isCompressedFormat = ddsktx_format_compressed(textureInfo.format);
-        auto texture = AllocateTexture(textureInfo);
+        return file;
+    }
+
+    Memory::GPUResourceProducer::TexturePtr ResourceLoader::LoadTexture(const std::filesystem::path& path, bool saveRowMajorBlob) 
+    {
+        std::optional<TextureFile> file = ReadTextureFile(path);
+        return file ? LoadTexture(*file, saveRowMajorBlob) : nullptr;
+    }
+
+    Memory::GPUResourceProducer::TexturePtr ResourceLoader::LoadTexture(const TextureFile& file, bool saveRowMajorBlob, uint16_t mostDetailedMip)
+    {
+        assert_format(mostDetailedMip < file.Info.num_mips, "Texture file doesn't have the requested mip");
+
+        auto texture = AllocateTexture(file.Info, mostDetailedMip);
+        const HAL::ResourceFootprint& footprint = texture->Footprint();
 
         texture->RequestWrite();
 
+        uint8_t* uploadMemory = texture->WriteOnlyPtr<uint8_t>();
+
+        assert_format(uploadMemory, "Texture upload memory was not allocated");
+
         if (saveRowMajorBlob)
         {
+            // Upload memory is write-combined and reading it back is slow,
+            // so the blob is filled first and then streamed to upload memory as a whole
             mRowMajorBlob.clear();
-            mRowMajorBlob.resize(texture->Footprint().TotalSizeInBytes());
+            mRowMajorBlob.resize(footprint.TotalSizeInBytes());
+
+            CopySubresources(file, mostDetailedMip, footprint, mRowMajorBlob.data());
+            memcpy(uploadMemory, mRowMajorBlob.data(), mRowMajorBlob.size());
+        }
+        else
+        {
+            CopySubresources(file, mostDetailedMip, footprint, uploadMemory);
+        }
+
+        texture->SetDebugName(file.Path.filename().string());
+        
+        return std::move(texture);
+    }
+
+    void ResourceLoader::CopySubresources(const TextureFile& file, uint16_t mostDetailedMip, const HAL::ResourceFootprint& footprint, uint8_t* destination)
+    {
+        std::vector<TextureFileLayout::Placement> placements;
+
+        for (const HAL::SubresourceFootprint& subresourceFootprint : footprint.SubresourceFootprints())
+        {
+            placements.push_back(TextureFileLayout::Placement{ 
+                subresourceFootprint.Offset(), subresourceFootprint.RowPitch(), subresourceFootprint.RowSizeInBytes(), subresourceFootprint.RowCount() });
         }
 
-        uint64_t uploadMemoryOffset = 0;
+        TextureFileLayout::CopySubresources(file.Info, file.Mapping.Data(), file.Mapping.Size(), mostDetailedMip, placements, destination);
+    }
+
+    std::vector<TextureFileLayout::Subresource> ResourceLoader::Subresources(const TextureFile& file)
+    {
+        return TextureFileLayout::Subresources(file.Info, file.Mapping.Data(), file.Mapping.Size());
+    }
+
+    std::vector<uint64_t> ResourceLoader::MipSizesInBytes(const TextureFile& file)
+    {
+        std::vector<uint64_t> mipSizes(file.Info.num_mips, 0);
 
-        for (int mip = 0; mip < textureInfo.num_mips; ++mip)
+        for (const TextureFileLayout::Subresource& subresource : Subresources(file))
         {
-            const HAL::SubresourceFootprint& mipFootprint = texture->Footprint().GetSubresourceFootprint(mip);
-            uploadMemoryOffset = mipFootprint.Offset();
+            mipSizes[subresource.Mip] += subresource.SizeInBytes;
+        }
+
+        return mipSizes;
+    }
 
-            for (int depthLayer = 0; depthLayer < textureInfo.depth; ++depthLayer)
+    void ResourceLoader::PrefetchMips(const TextureFile& file, uint16_t mostDetailedMip)
+    {
+        constexpr uint64_t PageSize = 4096;
+
+        // Reading a byte of every page is enough for the OS to map it
+        volatile uint8_t sink = 0;
+
+        for (const TextureFileLayout::Subresource& subresource : Subresources(file))
+        {
+            if (subresource.Mip < mostDetailedMip)
+                continue;
+
+            for (uint64_t offset = 0; offset < subresource.SizeInBytes; offset += PageSize)
             {
-                ddsktx_sub_data subData;
-                ddsktx_get_sub(&textureInfo, &subData, bytes.data(), (int)bytes.size(), 0, depthLayer, mip);
-
-                // row_pitch_bytes is number of bytes per row in the image file
-                // mipFootprint.RowPitch() is row size with possible wasted space in it due to HW alignment requirements
-                bool imageDataSatisfiesTextureRowAlignment =
-                    mipFootprint.RowPitch() == subData.row_pitch_bytes &&
-                    mipFootprint.RowSizeInBytes() == subData.row_pitch_bytes;
-
-                if (imageDataSatisfiesTextureRowAlignment)
-                {
-                    // Copy whole subresource
-                    texture->Write((uint8_t*)subData.buff, uploadMemoryOffset, subData.size_bytes);
-
-                    if (saveRowMajorBlob)
-                    {
-                        auto start = (uint8_t*)subData.buff;
-                        auto end = start + subData.size_bytes;
-                        std::copy(start, end, mRowMajorBlob.begin() + uploadMemoryOffset);
-                    }
-
-                    uploadMemoryOffset += subData.size_bytes;
-                }
-                else {
-                    // Have to copy row-by-row
-                    uint8_t* rowData = (uint8_t*)subData.buff;
-                    uint64_t rowReadCountAtOnce = mipFootprint.RowSizeInBytes() / subData.row_pitch_bytes;
-                    uint64_t readMemoryOffset = 0;
-
-                    // Loader library does not divide row cout by 4 for compressed formats (a bug?) so we do it manually
-                    uint64_t actualRowCount = isCompressedFormat ? subData.height / 4 : subData.height;
-
-                    for (auto row = 0; row < actualRowCount; row += rowReadCountAtOnce)
-                    {
-                        uint64_t bytesToRead = subData.row_pitch_bytes * rowReadCountAtOnce;
-                        texture->Write((uint8_t*)subData.buff + readMemoryOffset, uploadMemoryOffset, bytesToRead);
-
-                        if (saveRowMajorBlob)
-                        {
-                            auto start = (uint8_t*)subData.buff + readMemoryOffset;
-                            auto end = start + bytesToRead;
-                            std::copy(start, end, mRowMajorBlob.begin() + uploadMemoryOffset);
-                        }
-
-                        uploadMemoryOffset += mipFootprint.RowPitch();
-                        readMemoryOffset += bytesToRead;
-                    }
-                }
+                sink = sink + subresource.Data[offset];
             }
         }
-
-        texture->SetDebugName(path.filename().string());
-        input.close();
-        
-        return std::move(texture);
     }
 
     void ResourceLoader::StoreResource(const Memory::GPUResource& resource, const std::filesystem::path& path) const
@@ -120,11 +130,9 @@ namespace PathFinder
 
     }
 
-    HAL::TextureKind ResourceLoader::ToKind(const ddsktx_texture_info& textureInfo) const
+    HAL::TextureKind ResourceLoader::ToKind(const ddsktx_texture_info& textureInfo)
     {
-        bool isArray = textureInfo.num_layers > 1;
-
-        if (textureInfo.depth > 1 && !isArray) return HAL::TextureKind::Texture3D;
+        if (TextureFileLayout::IsVolume(textureInfo)) return HAL::TextureKind::Texture3D;
         if (textureInfo.depth > 1 || textureInfo.width > 1) return HAL::TextureKind::Texture2D;
 
         return HAL::TextureKind::Texture1D;
@@ -189,13 +197,24 @@ namespace PathFinder
         }
     }
 
-    Memory::GPUResourceProducer::TexturePtr ResourceLoader::AllocateTexture(const ddsktx_texture_info& textureInfo) const
+    Memory::GPUResourceProducer::TexturePtr ResourceLoader::AllocateTexture(const ddsktx_texture_info& textureInfo, uint16_t mostDetailedMip) const
     {
         HAL::FormatVariant format = ToResourceFormat(textureInfo.format);
-        Geometry::Dimensions dimensions(textureInfo.width, textureInfo.height, textureInfo.depth);
         HAL::TextureKind kind = ToKind(textureInfo);
 
-        HAL::TextureProperties properties{ format, kind, dimensions, HAL::ResourceState::AnyShaderAccess, HAL::ResourceState::CopyDestination, (uint16_t)textureInfo.num_mips };
+        uint32_t width = std::max(textureInfo.width >> mostDetailedMip, 1);
+        uint32_t height = std::max(textureInfo.height >> mostDetailedMip, 1);
+
+        // Array textures store array size in depth
+        uint32_t depth = kind == HAL::TextureKind::Texture3D ? std::max(textureInfo.depth >> mostDetailedMip, 1) : TextureFileLayout::ArraySize(textureInfo);
+
+        assert_format(!ddsktx_format_compressed(textureInfo.format) || (width % 4 == 0 && height % 4 == 0) || mostDetailedMip == 0,
+            "Most detailed mip of a block compressed texture must have dimensions aligned to block size");
+
+        Geometry::Dimensions dimensions(width, height, depth);
+        uint16_t mipCount = textureInfo.num_mips - mostDetailedMip;
+
+        HAL::TextureProperties properties{ format, kind, dimensions, HAL::ResourceState::AnyShaderAccess, HAL::ResourceState::CopyDestination, mipCount };
 
         return mResourceProducer->NewTexture(properties);
     }
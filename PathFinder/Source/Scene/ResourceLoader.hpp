@@ -1,11 +1,15 @@
 #pragma once
 
+#include "TextureFileLayout.hpp"
+
 #include <Memory/GPUResourceProducer.hpp>
 #include <HardwareAbstractionLayer/Texture.hpp>
-#include <ThirdParty/dds/dds-ktx.h>
+#include <HardwareAbstractionLayer/ResourceFootprint.hpp>
+#include <Foundation/MemoryMappedFile.hpp>
 
 #include <filesystem>
 #include <vector>
+#include <optional>
 
 namespace PathFinder 
 {
@@ -13,15 +17,49 @@ namespace PathFinder
     class ResourceLoader
     {
     public:
+        // Texture file mapped into memory and parsed, but not yet uploaded.
+        // Only the header is read at this point, pixel data pages are read when subresources are copied.
+        struct TextureFile
+        {
+            std::filesystem::path Path;
+            Foundation::MemoryMappedFile Mapping;
+            ddsktx_texture_info Info;
+
+            // Identifies files with identical contents under different paths.
+            // Zero unless requested, because hashing reads the whole file.
+            uint64_t ContentHash = 0;
+        };
+
         ResourceLoader(Memory::GPUResourceProducer* resourceProducer);
 
+        // Touches no GPU resources and no loader state, so can be called from any thread
+        static std::optional<TextureFile> ReadTextureFile(const std::filesystem::path& path, bool computeContentHash = false);
+
         Memory::GPUResourceProducer::TexturePtr LoadTexture(const std::filesystem::path& path, bool saveRowMajorBlob = false);
+
+        // Creates a texture with mips starting from mostDetailedMip and copies them straight into its upload memory.
+        // File ranges of skipped mips are never read.
+        Memory::GPUResourceProducer::TexturePtr LoadTexture(const TextureFile& file, bool saveRowMajorBlob = false, uint16_t mostDetailedMip = 0);
+
         void StoreResource(const Memory::GPUResource& resource, const std::filesystem::path& path) const;
 
+        // Size of pixel data of every mip level in all array slices, most detailed mip first
+        static std::vector<uint64_t> MipSizesInBytes(const TextureFile& file);
+
+        // Brings file pages of mips starting from mostDetailedMip into memory,
+        // so that loading them later doesn't wait for disk. Can be called from any thread.
+        static void PrefetchMips(const TextureFile& file, uint16_t mostDetailedMip);
+
     private:
-        HAL::TextureKind ToKind(const ddsktx_texture_info& textureInfo) const;
+        static std::vector<TextureFileLayout::Subresource> Subresources(const TextureFile& file);
+
+        // Writes subresources in a single pass over the file
+        static void CopySubresources(const TextureFile& file, uint16_t mostDetailedMip, const HAL::ResourceFootprint& footprint, uint8_t* destination);
+
+        static HAL::TextureKind ToKind(const ddsktx_texture_info& textureInfo);
+
         HAL::FormatVariant ToResourceFormat(const ddsktx_format& parserFormat) const;
-        Memory::GPUResourceProducer::TexturePtr AllocateTexture(const ddsktx_texture_info& textureInfo) const;
+        Memory::GPUResourceProducer::TexturePtr AllocateTexture(const ddsktx_texture_info& textureInfo, uint16_t mostDetailedMip) const;
 
         std::vector<uint8_t> mRowMajorBlob;
         Memory::GPUResourceProducer* mResourceProducer;
@@ -1,4 +1,5 @@
 #include "Scene.hpp"
+#include "SceneContainer.hpp"
 
 #include <bitsery/bitsery.h>
 #include <bitsery/adapter/buffer.h>
@@ -7,8 +8,12 @@
 #include <bitsery/adapter/buffer.h>
 #include <bitsery/adapter/stream.h>
 #include <bitsery/ext/pointer.h>
+#include <glm/geometric.hpp>
+#include <glm/trigonometric.hpp>
 
 #include <fstream>
+#include <array>
+#include <cmath>
 
 #include <Foundation/Filesystem.hpp>
 #include <Foundation/StringUtils.hpp>
@@ -16,15 +21,60 @@
 namespace PathFinder 
 {
 
+    namespace
+    {
+        struct ContainerMeshRecord
+        {
+            uint64_t VertexBlock = 0;
+            uint64_t IndexBlock = 0;
+
+            template <typename S>
+            void serialize(S& s)
+            {
+                s.value8b(VertexBlock);
+                s.value8b(IndexBlock);
+            }
+        };
+
+        struct ContainerTextureRecord
+        {
+            bool IsPresent = false;
+            HAL::TextureProperties Properties{ HAL::ColorFormat::R8_Unsigned_Norm, HAL::TextureKind::Texture2D, Geometry::Dimensions{1}, HAL::ResourceState::Common };
+            uint64_t Block = 0;
+
+            // Offsets of mip levels inside the block so that individual mips can be addressed without the texture
+            std::vector<uint64_t> MipOffsets;
+
+            template <typename S>
+            void serialize(S& s)
+            {
+                s.boolValue(IsPresent);
+                s.object(Properties);
+                s.value8b(Block);
+                s.container8b(MipOffsets, 64);
+            }
+        };
+
+        std::array<Material::TextureData*, 8> MaterialTextures(Material& material)
+        {
+            return {
+                &material.DiffuseAlbedoMap, &material.SpecularAlbedoMap, &material.NormalMap, &material.RoughnessMap,
+                &material.MetalnessMap, &material.TranslucencyMap, &material.DisplacementMap, &material.DistanceField
+            };
+        }
+    }
+
     Scene::Scene(
         const std::filesystem::path& executableFolder,
         const HAL::Device* device,
         Memory::GPUResourceProducer* resourceProducer,
         const PipelineResourceStorage* pipelineResourceStorage,
         const RenderSurfaceDescription* renderSurfaceDescription,
-        const RenderSettings* renderSettings)
+        const RenderSettings* renderSettings,
+        Foundation::ThreadPool* workerThreadPool)
         : 
         mResourceProducer{ resourceProducer },
+        mWorkerThreadPool{ workerThreadPool },
         mLuminanceMeter{ &mCamera },
         mGPUStorage{ this, device, resourceProducer, pipelineResourceStorage, renderSurfaceDescription, renderSettings },
         mMaterialLoader{ executableFolder, resourceProducer },
@@ -104,21 +154,77 @@ namespace PathFinder
         mSky.UpdatePreviousFrameValues();
     }
 
+    void Scene::UpdateTextureStreaming(uint64_t frameNumber, uint64_t viewportHeight)
+    {
+        TextureStreamer& textureStreamer = mMaterialLoader.GetTextureStreamer();
+
+        // Screen size in pixels of a unit length object at unit distance
+        float projectionScale = viewportHeight / (2.0f * std::tan(glm::radians(mCamera.GetFOVV()) * 0.5f));
+
+        for (MeshInstance& instance : mMeshInstances)
+        {
+            Material* material = instance.GetAssociatedMaterial();
+
+            if (!material)
+                continue;
+
+            Geometry::AABB boundingBox = instance.GetBoundingBox(*instance.GetAssociatedMesh());
+            glm::vec3 toCenter = (boundingBox.GetMin() + boundingBox.GetMax()) * 0.5f - mCamera.GetPosition();
+            float radius = boundingBox.Diagonal() * 0.5f;
+
+            // Instances entirely behind the camera are not seen
+            if (glm::dot(toCenter, mCamera.GetFront()) < -radius)
+                continue;
+
+            // Bounding sphere projected at its nearest point, camera inside of it sees the instance at full detail
+            float distance = std::max(glm::length(toCenter) - radius, mCamera.GetNearClipPlane());
+            float screenSize = 2.0f * radius * projectionScale / distance;
+
+            for (const Material::TextureData* textureData : MaterialTextures(*material))
+            {
+                textureStreamer.ReportUsage(textureData, screenSize);
+            }
+        }
+
+        textureStreamer.Update(frameNumber);
+    }
+
     void Scene::LoadThirdPartyScene(const std::filesystem::path& path, const ThirdPartySceneLoader::Settings& settings)
     {
-        std::vector<ThirdPartySceneLoader::LoadedMesh>& loadedMeshes = mThirdPartySceneLoader.Load(path, settings);
         std::vector<Material*> insertedMaterials;
 
+        mThirdPartySceneLoader.ReadSceneFile(path, settings);
+
         for (Material& material : mThirdPartySceneLoader.LoadedMaterials())
         {
             Material* insertedMaterial = &mMaterials.emplace_back(std::move(material));
             insertedMaterial->Name = EnsureMaterialNameUniqueness(insertedMaterial->Name);
             insertedMaterials.push_back(insertedMaterial);
 
-            mMaterialLoader.LoadMaterial(*insertedMaterial);
+            mMaterialLoader.PrefetchTextureFiles(*insertedMaterial, mWorkerThreadPool);
+        }
+
+        // Texture files are read and parsed while meshes are being converted
+        mThirdPartySceneLoader.ProcessMeshes(mWorkerThreadPool);
+
+        // Prefetches must land before materials consume the cache
+        mWorkerThreadPool->WaitForAllTasks();
+
+        // Texture creation and upload touch GPU resources and stay on this thread
+        for (Material* material : insertedMaterials)
+        {
+            mMaterialLoader.LoadMaterial(*material, settings.KeepTextureDataForSerialization, settings.StreamTextures);
         }
-            
-        for (ThirdPartySceneLoader::LoadedMesh& loadedMesh : loadedMeshes)
+
+        mMaterialLoader.ClearPrefetchedTextureFiles();
+
+        // Weighted by triangle and vertex counts, so that statistics reflect the whole scene rather than its smallest meshes.
+        // Optimized meshes only keep referenced vertices, which is what ATVR is relative to.
+        MeshOptimizer::Report optimizationReport;
+        uint64_t triangleCount = 0;
+        uint64_t vertexCount = 0;
+
+        for (ThirdPartySceneLoader::LoadedMesh& loadedMesh : mThirdPartySceneLoader.LoadedMeshes())
         {
             Mesh* insertedMesh = &mMeshes.emplace_back(std::move(loadedMesh.MeshObject));
             Material* material = insertedMaterials[loadedMesh.MaterialIndex];
@@ -127,6 +233,34 @@ namespace PathFinder
 
             mTotalVertexCount += insertedMesh->GetVertices().size();
             mTotalIndexCount += insertedMesh->GetIndices().size();
+
+            if (!insertedMesh->GetOptimizationReport())
+                continue;
+
+            const MeshOptimizer::Report& meshReport = *insertedMesh->GetOptimizationReport();
+            uint64_t meshTriangleCount = insertedMesh->GetIndices().size() / 3;
+            uint64_t meshVertexCount = insertedMesh->GetVertices().size();
+
+            OutputDebugString(("Scene Import: Mesh Optimization: " + insertedMesh->GetName() + ": ACMR " +
+                std::to_string(meshReport.Original.ACMR) + " -> " + std::to_string(meshReport.Optimized.ACMR) + ", ATVR " +
+                std::to_string(meshReport.Original.ATVR) + " -> " + std::to_string(meshReport.Optimized.ATVR) + "\n").c_str());
+
+            optimizationReport.Original.ACMR += meshReport.Original.ACMR * meshTriangleCount;
+            optimizationReport.Optimized.ACMR += meshReport.Optimized.ACMR * meshTriangleCount;
+            optimizationReport.Original.ATVR += meshReport.Original.ATVR * meshVertexCount;
+            optimizationReport.Optimized.ATVR += meshReport.Optimized.ATVR * meshVertexCount;
+
+            triangleCount += meshTriangleCount;
+            vertexCount += meshVertexCount;
+        }
+
+        if (triangleCount > 0)
+        {
+            OutputDebugString(("Scene Import: Mesh Optimization: Total: ACMR " +
+                std::to_string(optimizationReport.Original.ACMR / triangleCount) + " -> " +
+                std::to_string(optimizationReport.Optimized.ACMR / triangleCount) + ", ATVR " +
+                std::to_string(optimizationReport.Original.ATVR / vertexCount) + " -> " +
+                std::to_string(optimizationReport.Optimized.ATVR / vertexCount) + "\n").c_str());
         }
     }
 
@@ -195,6 +329,157 @@ namespace PathFinder
         }
     }
 
+    void Scene::SerializeContainer(const std::filesystem::path& destination, bool compressBlocks)
+    {
+        SceneContainerWriter writer{ destination };
+
+        std::vector<ContainerMeshRecord> meshRecords;
+        std::vector<ContainerTextureRecord> textureRecords;
+
+        for (Mesh& mesh : mMeshes)
+        {
+            ContainerMeshRecord& record = meshRecords.emplace_back();
+            record.VertexBlock = writer.AddBlock(mesh.GetVertices().data(), mesh.GetVertices().size() * sizeof(Vertex1P1N1UV1T1BT), compressBlocks);
+            record.IndexBlock = writer.AddBlock(mesh.GetIndices().data(), mesh.GetIndices().size() * sizeof(uint32_t), compressBlocks);
+        }
+
+        // Textures shared by several materials are stored once and their records point to the same block
+        robin_hood::unordered_flat_map<const Memory::Texture*, uint64_t> textureBlocks;
+
+        for (Material& material : mMaterials)
+        {
+            for (Material::TextureData* textureData : MaterialTextures(material))
+            {
+                ContainerTextureRecord& record = textureRecords.emplace_back();
+
+                if (!textureData->RowMajorBlob || textureData->RowMajorBlob->empty() || !textureData->Texture)
+                    continue;
+
+                record.IsPresent = true;
+                record.Properties = textureData->Texture->Properties();
+
+                auto [blockIt, isNewTexture] = textureBlocks.emplace(textureData->Texture.get(), 0);
+
+                if (isNewTexture)
+                {
+                    blockIt->second = writer.AddBlock(textureData->RowMajorBlob->data(), textureData->RowMajorBlob->size(), compressBlocks);
+                }
+
+                record.Block = blockIt->second;
+
+                for (const HAL::SubresourceFootprint& footprint : textureData->Texture->Footprint().SubresourceFootprints())
+                    record.MipOffsets.push_back(footprint.Offset());
+
+                textureData->RowMajorBlob.reset();
+            }
+        }
+
+        // Scene graph and block tables are small and go into the last block
+        using Buffer = std::vector<uint8_t>;
+        using Serializer = bitsery::Serializer<bitsery::OutputBufferAdapter<Buffer>, bitsery::ext::PointerLinkingContext>;
+
+        Buffer description;
+        bitsery::ext::PointerLinkingContext context{};
+        Serializer serializer{ context, description };
+
+        serializer.object(mCamera);
+        serializer.container(mMeshes, std::numeric_limits<uint64_t>::max(), [](Serializer& s, Mesh& m) { s.ext(m, bitsery::ext::ReferencedByPointer{}); });
+        serializer.container(mMaterials, std::numeric_limits<uint64_t>::max(), [](Serializer& s, Material& m) { s.ext(m, bitsery::ext::ReferencedByPointer{}); });
+        serializer.container(mMeshInstances, std::numeric_limits<uint64_t>::max());
+        serializer.container(meshRecords, std::numeric_limits<uint64_t>::max());
+        serializer.container(textureRecords, std::numeric_limits<uint64_t>::max());
+        serializer.adapter().flush();
+
+        assert_format(context.isValid(), "Scene serialization failed");
+
+        writer.AddBlock(description.data(), serializer.adapter().writtenBytesCount(), false);
+        writer.Finalize();
+    }
+
+    void Scene::DeserializeContainer(const std::filesystem::path& source)
+    {
+        SceneContainerReader reader{ source };
+
+        assert_format(reader.BlockCount() > 0, "Scene container is empty");
+
+        using Buffer = std::vector<uint8_t>;
+        using Deserializer = bitsery::Deserializer<bitsery::InputBufferAdapter<Buffer>, bitsery::ext::PointerLinkingContext>;
+
+        uint64_t descriptionBlock = reader.BlockCount() - 1;
+        Buffer description(reader.BlockSize(descriptionBlock));
+        reader.ReadBlock(descriptionBlock, description.data());
+
+        std::vector<ContainerMeshRecord> meshRecords;
+        std::vector<ContainerTextureRecord> textureRecords;
+
+        bitsery::ext::PointerLinkingContext context{};
+        Deserializer deserializer{ context, description.begin(), description.size() };
+
+        deserializer.object(mCamera);
+        deserializer.container(mMeshes, std::numeric_limits<uint64_t>::max(), [](Deserializer& s, Mesh& m) { s.ext(m, bitsery::ext::ReferencedByPointer{}); });
+        deserializer.container(mMaterials, std::numeric_limits<uint64_t>::max(), [](Deserializer& s, Material& m) { s.ext(m, bitsery::ext::ReferencedByPointer{}); });
+        deserializer.container(mMeshInstances, std::numeric_limits<uint64_t>::max());
+        deserializer.container(meshRecords, std::numeric_limits<uint64_t>::max());
+        deserializer.container(textureRecords, std::numeric_limits<uint64_t>::max());
+
+        assert_format(context.isValid() && deserializer.adapter().isCompletedSuccessfully(), "Scene deserialization failed");
+        assert_format(meshRecords.size() == mMeshes.size() && textureRecords.size() == mMaterials.size() * 8, "Scene container tables do not match scene contents");
+
+        auto meshRecordIt = meshRecords.begin();
+
+        for (Mesh& mesh : mMeshes)
+        {
+            // Blocks are decoded or copied straight into mesh storage, no intermediate buffers
+            std::vector<Vertex1P1N1UV1T1BT> vertices(reader.BlockSize(meshRecordIt->VertexBlock) / sizeof(Vertex1P1N1UV1T1BT));
+            std::vector<uint32_t> indices(reader.BlockSize(meshRecordIt->IndexBlock) / sizeof(uint32_t));
+
+            reader.ReadBlock(meshRecordIt->VertexBlock, vertices.data());
+            reader.ReadBlock(meshRecordIt->IndexBlock, indices.data());
+
+            mTotalVertexCount += vertices.size();
+            mTotalIndexCount += indices.size();
+
+            mesh.SetVertexData(std::move(vertices), std::move(indices));
+            mesh.SetName(EnsureMeshNameUniqueness(mesh.GetName()));
+            ++meshRecordIt;
+        }
+
+        auto textureRecordIt = textureRecords.begin();
+        std::vector<uint8_t> decompressionScratch;
+
+        // Material loader cache owns textures, blocks shared by several materials are only read and hashed once
+        robin_hood::unordered_flat_map<uint64_t, Memory::Texture*> blockTextures;
+
+        for (Material& material : mMaterials)
+        {
+            for (Material::TextureData* textureData : MaterialTextures(material))
+            {
+                const ContainerTextureRecord& record = *textureRecordIt;
+                ++textureRecordIt;
+
+                if (!record.IsPresent)
+                    continue;
+
+                auto [blockTextureIt, isNewBlock] = blockTextures.emplace(record.Block, nullptr);
+
+                if (isNewBlock)
+                {
+                    // Uncompressed payloads go from the mapped file into upload memory directly
+                    const uint8_t* payload = reader.AccessBlock(record.Block, decompressionScratch);
+                    uint64_t payloadSize = reader.BlockSize(record.Block);
+
+                    blockTextureIt->second = mMaterialLoader.GetOrCreateTexture(
+                        robin_hood::hash_bytes(payload, payloadSize), record.Properties, payload, payloadSize);
+                }
+
+                textureData->Texture = Memory::GPUResourceProducer::TexturePtr{ blockTextureIt->second, [](Memory::Texture* texture) {} };
+            }
+
+            material.Name = EnsureMaterialNameUniqueness(material.Name);
+            mMaterialLoader.SetCommonMaterialTextures(material);
+        }
+    }
+
     void Scene::LoadUtilityResources(const std::filesystem::path& executableFolder)
     {
         ResourceLoader resourceLoader{ mResourceProducer };
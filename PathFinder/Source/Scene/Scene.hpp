@@ -42,7 +42,8 @@ namespace PathFinder
             Memory::GPUResourceProducer* resourceProducer,
             const PipelineResourceStorage* pipelineResourceStorage,
             const RenderSurfaceDescription* renderSurfaceDescription,
-            const RenderSettings* renderSettings
+            const RenderSettings* renderSettings,
+            Foundation::ThreadPool* workerThreadPool
         );
 
         Mesh& AddMesh(Mesh&& mesh);
@@ -55,10 +56,18 @@ namespace PathFinder
         void MapEntitiesToGPUIndices();
         void UpdatePreviousFrameValues();
 
+        // Reports screen sizes of textured instances to the texture streamer and lets it apply residency changes
+        void UpdateTextureStreaming(uint64_t frameNumber, uint64_t viewportHeight);
+
         void LoadThirdPartyScene(const std::filesystem::path& path, const ThirdPartySceneLoader::Settings& settings = {});
         void Serialize(const std::filesystem::path& destination);
         void Deserialize(const std::filesystem::path& source);
 
+        // Whole scene in a single memory mapped file. Blocks can be LZ4 compressed for cold storage
+        // at the cost of decoding them on load instead of reading them straight from the mapping.
+        void SerializeContainer(const std::filesystem::path& destination, bool compressBlocks = false);
+        void DeserializeContainer(const std::filesystem::path& source);
+
     private:
         struct FileStructure
         {
@@ -105,6 +114,9 @@ namespace PathFinder
         MaterialLoader mMaterialLoader;
 
         Memory::GPUResourceProducer* mResourceProducer;
+
+        // Owned by the engine and shared with command list recording, which never overlaps scene import
+        Foundation::ThreadPool* mWorkerThreadPool;
         SceneGPUStorage mGPUStorage;
 
         std::vector<MeshInstance*> mMeshInstanceGPUIndexMappings;
@@ -130,6 +142,7 @@ namespace PathFinder
         inline const auto& GetSphericalLights() const { return mSphericalLights; }
         inline const auto& GetTonemappingParams() const { return mTonemappingParams; }
         inline const auto& GetBloomParams() const { return mBloomParameters; }
+        inline const TextureStreamer& GetTextureStreamer() const { return mMaterialLoader.GetTextureStreamer(); }
 
         inline auto& GetMeshes() { return mMeshes; }
         inline auto& GetMeshInstances() { return mMeshInstances; }
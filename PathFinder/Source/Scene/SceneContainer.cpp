@@ -0,0 +1,163 @@
+#include "SceneContainer.hpp"
+
+#include <Foundation/LZ4.hpp>
+#include <Foundation/MemoryUtils.hpp>
+
+#include <cstring>
+
+namespace PathFinder
+{
+
+    SceneContainerWriter::SceneContainerWriter(const std::filesystem::path& path)
+        : mStream{ path, std::ios::binary | std::ios::trunc | std::ios::out }
+    {
+        assert_format(mStream.is_open(), "File (", path.string(), ") couldn't be opened for writing");
+
+        // Header is rewritten with final values in Finalize()
+        SceneContainer::Header header{};
+        mStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        mWriteOffset = sizeof(header);
+    }
+
+    uint64_t SceneContainerWriter::AddBlock(const void* data, uint64_t size, bool compress)
+    {
+        assert_format(!mIsFinalized, "Container is already finalized");
+
+        WritePadding(SceneContainer::BlockAlignment);
+
+        SceneContainer::Block block{};
+        block.Offset = mWriteOffset;
+        block.Size = size;
+        block.StoredSize = size;
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        std::vector<uint8_t> compressedBytes;
+
+        if (compress && size > 0)
+        {
+            compressedBytes = Foundation::LZ4::Compress(bytes, size);
+
+            if (compressedBytes.size() < size)
+            {
+                block.Compression = SceneContainer::Codec::LZ4;
+                block.StoredSize = compressedBytes.size();
+                bytes = compressedBytes.data();
+            }
+        }
+
+        mStream.write(reinterpret_cast<const char*>(bytes), block.StoredSize);
+        mWriteOffset += block.StoredSize;
+        mBlocks.push_back(block);
+
+        return mBlocks.size() - 1;
+    }
+
+    void SceneContainerWriter::Finalize()
+    {
+        assert_format(!mIsFinalized, "Container is already finalized");
+
+        WritePadding(alignof(SceneContainer::Block));
+
+        SceneContainer::Header header{};
+        header.BlockCount = mBlocks.size();
+        header.BlockTableOffset = mWriteOffset;
+
+        mStream.write(reinterpret_cast<const char*>(mBlocks.data()), mBlocks.size() * sizeof(SceneContainer::Block));
+        mStream.seekp(0);
+        mStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        mStream.close();
+
+        assert_format(!mStream.fail(), "Scene container write failed");
+
+        mIsFinalized = true;
+    }
+
+    void SceneContainerWriter::WritePadding(uint64_t alignment)
+    {
+        uint64_t alignedOffset = Foundation::MemoryUtils::Align(mWriteOffset, alignment);
+        std::vector<char> padding(alignedOffset - mWriteOffset, 0);
+        mStream.write(padding.data(), padding.size());
+        mWriteOffset = alignedOffset;
+    }
+
+    SceneContainerReader::SceneContainerReader(const std::filesystem::path& path)
+        : mFile{ path }
+    {
+        assert_format(mFile.IsMapped(), "File (", path.string(), ") couldn't be mapped for reading");
+        assert_format(mFile.Size() >= sizeof(SceneContainer::Header), "File (", path.string(), ") is not a scene container");
+
+        SceneContainer::Header header{};
+        std::memcpy(&header, mFile.Data(), sizeof(header));
+
+        assert_format(header.Magic == SceneContainer::Magic, "File (", path.string(), ") is not a scene container");
+        assert_format(header.Version == SceneContainer::Version, "Scene container version ", header.Version, " is not supported, expected ", SceneContainer::Version);
+        assert_format(header.BlockTableOffset + header.BlockCount * sizeof(SceneContainer::Block) <= mFile.Size(), "Scene container block table is truncated");
+
+        mBlocks = reinterpret_cast<const SceneContainer::Block*>(mFile.Data() + header.BlockTableOffset);
+        mBlockCount = header.BlockCount;
+
+        for (auto blockIdx = 0u; blockIdx < mBlockCount; ++blockIdx)
+        {
+            assert_format(mBlocks[blockIdx].Offset + mBlocks[blockIdx].StoredSize <= mFile.Size(), "Scene container block ", blockIdx, " is truncated");
+        }
+    }
+
+    const uint8_t* SceneContainerReader::MappedBlock(uint64_t blockIndex) const
+    {
+        assert_format(blockIndex < mBlockCount, "Block index is out of bounds");
+        assert_format(mBlocks[blockIndex].Compression == SceneContainer::Codec::None, "Compressed blocks can't be accessed directly");
+
+        return mFile.Data() + mBlocks[blockIndex].Offset;
+    }
+
+    const uint8_t* SceneContainerReader::AccessBlock(uint64_t blockIndex, std::vector<uint8_t>& scratch) const
+    {
+        if (!IsBlockCompressed(blockIndex))
+        {
+            return MappedBlock(blockIndex);
+        }
+
+        scratch.resize(BlockSize(blockIndex));
+        ReadBlock(blockIndex, scratch.data());
+        return scratch.data();
+    }
+
+    void SceneContainerReader::ReadBlock(uint64_t blockIndex, void* destination) const
+    {
+        assert_format(blockIndex < mBlockCount, "Block index is out of bounds");
+
+        const SceneContainer::Block& block = mBlocks[blockIndex];
+        const uint8_t* storedBytes = mFile.Data() + block.Offset;
+
+        switch (block.Compression)
+        {
+        case SceneContainer::Codec::None:
+            std::memcpy(destination, storedBytes, block.Size);
+            break;
+
+        case SceneContainer::Codec::LZ4:
+        {
+            bool isDecoded = Foundation::LZ4::Decompress(storedBytes, block.StoredSize, static_cast<uint8_t*>(destination), block.Size);
+            assert_format(isDecoded, "Scene container block ", blockIndex, " is corrupted");
+            break;
+        }
+
+        default:
+            assert_format(false, "Unknown block compression");
+            break;
+        }
+    }
+
+    uint64_t SceneContainerReader::BlockSize(uint64_t blockIndex) const
+    {
+        assert_format(blockIndex < mBlockCount, "Block index is out of bounds");
+        return mBlocks[blockIndex].Size;
+    }
+
+    bool SceneContainerReader::IsBlockCompressed(uint64_t blockIndex) const
+    {
+        assert_format(blockIndex < mBlockCount, "Block index is out of bounds");
+        return mBlocks[blockIndex].Compression != SceneContainer::Codec::None;
+    }
+
+}
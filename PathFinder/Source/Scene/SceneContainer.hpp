@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Foundation/MemoryMappedFile.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    // Single file holding a number of raw data blocks.
+    // Blocks start at page boundaries, so an uncompressed block can be consumed
+    // directly from a memory mapping of the file without copying or decoding it first.
+    //
+    // Layout: header page | block 0 | block 1 | ... | block table
+    namespace SceneContainer
+    {
+        static constexpr uint32_t Magic = 0x43534650; // 'PFSC'
+        static constexpr uint32_t Version = 1;
+        static constexpr uint64_t BlockAlignment = 4096;
+
+        enum class Codec : uint32_t
+        {
+            None, LZ4
+        };
+
+        struct Header
+        {
+            uint32_t Magic = SceneContainer::Magic;
+            uint32_t Version = SceneContainer::Version;
+            uint64_t BlockCount = 0;
+            uint64_t BlockTableOffset = 0;
+        };
+
+        struct Block
+        {
+            uint64_t Offset = 0;
+            uint64_t StoredSize = 0;
+            uint64_t Size = 0;
+            Codec Compression = Codec::None;
+            uint32_t Reserved = 0;
+        };
+    }
+
+    // Streams blocks to disk as they are added, so whole scene never has to be held in memory
+    class SceneContainerWriter
+    {
+    public:
+        SceneContainerWriter(const std::filesystem::path& path);
+
+        // Returns index of the block. Compression is dropped for blocks that don't shrink.
+        uint64_t AddBlock(const void* data, uint64_t size, bool compress);
+
+        // Writes block table and header. No blocks can be added afterwards.
+        void Finalize();
+
+    private:
+        void WritePadding(uint64_t alignment);
+
+        std::ofstream mStream;
+        std::vector<SceneContainer::Block> mBlocks;
+        uint64_t mWriteOffset = 0;
+        bool mIsFinalized = false;
+    };
+
+    class SceneContainerReader
+    {
+    public:
+        SceneContainerReader(const std::filesystem::path& path);
+
+        // Pointer to block contents inside the mapping. Only valid for uncompressed blocks.
+        const uint8_t* MappedBlock(uint64_t blockIndex) const;
+
+        // Pointer into the mapping for uncompressed blocks, otherwise block is decompressed into scratch memory
+        const uint8_t* AccessBlock(uint64_t blockIndex, std::vector<uint8_t>& scratch) const;
+
+        // Copies or decompresses block contents into memory of at least BlockSize() bytes
+        void ReadBlock(uint64_t blockIndex, void* destination) const;
+
+        uint64_t BlockSize(uint64_t blockIndex) const;
+        bool IsBlockCompressed(uint64_t blockIndex) const;
+
+    private:
+        Foundation::MemoryMappedFile mFile;
+        const SceneContainer::Block* mBlocks = nullptr;
+        uint64_t mBlockCount = 0;
+
+    public:
+        inline auto BlockCount() const { return mBlockCount; }
+    };
+
+}
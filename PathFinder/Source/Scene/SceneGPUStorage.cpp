@@ -38,15 +38,18 @@ namespace PathFinder
 
         mBottomAccelerationStructures.clear();
 
-        auto& package1P1N1UV1T1BT = std::get<UploadBufferPackage<Vertex1P1N1UV1T1BT>>(mUploadBuffers);
-        package1P1N1UV1T1BT.Vertices.reserve(mScene->GetTotalVertexCount());
-        package1P1N1UV1T1BT.Indices.reserve(mScene->GetTotalIndexCount());
+        // Instances reference mesh locations and acceleration structures
+        mUploadedInstanceTopology = std::nullopt;
+
+        auto& meshPackage = std::get<UploadBufferPackage<Vertex1P1N1UV1T1BTCompressed>>(mUploadBuffers);
+        meshPackage.Vertices.reserve(mScene->GetTotalVertexCount());
+        meshPackage.Indices.reserve(mScene->GetTotalIndexCount());
 
         for (Mesh& mesh : meshes)
         {
             assert_format(!mesh.GetVertices().empty(), "Empty meshes are not allowed");
 
-            VertexStorageLocation locationInStorage = WriteToTemporaryBuffers<Vertex1P1N1UV1T1BT>(
+            VertexStorageLocation locationInStorage = WriteToTemporaryBuffers<Vertex1P1N1UV1T1BTCompressed>(
                 mesh.GetVertices().data(), mesh.GetVertices().size(), mesh.GetIndices().data(), mesh.GetIndices().size());
 
             mesh.SetVertexStorageLocation(locationInStorage);
@@ -54,19 +57,19 @@ namespace PathFinder
 
         auto quadVertices = fplus::transform([](const glm::vec3& p) { return Vertex1P1N1UV1T1BT{ glm::vec4{p, 1.0f} }; }, DrawablePrimitive::UnitQuadVertices);
 
-        mUnitQuadVertexLocation = WriteToTemporaryBuffers<Vertex1P1N1UV1T1BT>(
+        mUnitQuadVertexLocation = WriteToTemporaryBuffers<Vertex1P1N1UV1T1BTCompressed>(
             quadVertices.data(), quadVertices.size(),
             DrawablePrimitive::UnitQuadIndices.data(), DrawablePrimitive::UnitQuadIndices.size());
 
-        mUnitCubeVertexLocation = WriteToTemporaryBuffers<Vertex1P1N1UV1T1BT>(
+        mUnitCubeVertexLocation = WriteToTemporaryBuffers<Vertex1P1N1UV1T1BTCompressed>(
             mScene->GetUnitCube().GetVertices().data(), mScene->GetUnitCube().GetVertices().size(), 
             mScene->GetUnitCube().GetIndices().data(), mScene->GetUnitCube().GetIndices().size());
 
-        mUnitSphereVertexLocation = WriteToTemporaryBuffers<Vertex1P1N1UV1T1BT>(
+        mUnitSphereVertexLocation = WriteToTemporaryBuffers<Vertex1P1N1UV1T1BTCompressed>(
             mScene->GetUnitSphere().GetVertices().data(), mScene->GetUnitSphere().GetVertices().size(),
             mScene->GetUnitSphere().GetIndices().data(), mScene->GetUnitSphere().GetIndices().size());
 
-        SubmitTemporaryBuffersToGPU<Vertex1P1N1UV1T1BT>();
+        SubmitTemporaryBuffersToGPU<Vertex1P1N1UV1T1BTCompressed>();
     }
 
     void SceneGPUStorage::UploadMaterials()
@@ -75,6 +78,9 @@ namespace PathFinder
 
         if (materials.empty()) return;
 
+        // Instances reference material table indices
+        mUploadedInstanceTopology = std::nullopt;
+
         if (!mMaterialTable || mMaterialTable->Capacity<GPUMaterialTableEntry>() < materials.size())
         {
             auto properties = HAL::BufferProperties::Create<GPUMaterialTableEntry>(materials.size());
@@ -138,20 +144,62 @@ namespace PathFinder
 
     void SceneGPUStorage::UploadInstances()
     {
-        mTopAccelerationStructure.Clear();
-        UploadMeshInstances();
-        UploadLights();
-        UploadDebugGIProbes();
-        mTopAccelerationStructure.Build();
-        mScene->MapEntitiesToGPUIndices();
+        InstanceTopology topology = GetCurrentInstanceTopology();
+
+        // Debug probes are placed from scratch every frame, so a full rebuild is required while they're displayed
+        bool rebuildTopology = !mUploadedInstanceTopology || *mUploadedInstanceTopology != topology || topology.HasDebugGIProbes;
+
+        mIsTopAccelerationStructureChanged = false;
+
+        if (rebuildTopology)
+        {
+            mTopAccelerationStructure.Clear();
+        }
+
+        UploadMeshInstances(rebuildTopology);
+        UploadLights(rebuildTopology);
+
+        if (rebuildTopology)
+        {
+            UploadDebugGIProbes();
+            mTopAccelerationStructure.Build();
+            mScene->MapEntitiesToGPUIndices();
+            mUploadedInstanceTopology = topology;
+            mIsTopAccelerationStructureChanged = true;
+        }
+        else if (mIsTopAccelerationStructureChanged)
+        {
+            // Only transforms changed, refit is enough
+            mTopAccelerationStructure.Update();
+        }
+
+        UploadVisibleMeshInstanceDrawArguments();
+    }
+
+    SceneGPUStorage::InstanceTopology SceneGPUStorage::GetCurrentInstanceTopology() const
+    {
+        InstanceTopology topology{};
+        topology.MeshInstanceCount = mScene->GetMeshInstances().size();
+        topology.HasDebugGIProbes = mScene->GetGIManager().GIDebugEnabled;
+
+        auto appendLights = [&topology](auto&& lights)
+        {
+            for (const auto& light : lights)
+            {
+                topology.ActiveLightMask.push_back(light.GetLuminousPower() > 0.0);
+            }
+        };
+
+        appendLights(mScene->GetSphericalLights());
+        appendLights(mScene->GetRectangularLights());
+        appendLights(mScene->GetDiskLights());
+
+        return topology;
     }
 
-    void SceneGPUStorage::UploadMeshInstances()
+    void SceneGPUStorage::UploadMeshInstances(bool rebuildTopology)
     {
         auto& meshInstances = mScene->GetMeshInstances();
-        auto& sphericalLights = mScene->GetSphericalLights();
-        auto& rectangularLights = mScene->GetRectangularLights();
-        auto& diskLights = mScene->GetDiskLights();
 
         auto requiredBufferSize = meshInstances.size() + mScene->GetTotalLightCount();
 
@@ -165,50 +213,111 @@ namespace PathFinder
             mMeshInstanceTable->SetDebugName("Mesh Instance Table");
         }
 
-        mMeshInstanceTable->RequestWrite();
+        uint64_t frameNumber = mResourceProducer->FrameNumber();
+
+        if (rebuildTopology)
+        {
+            mMeshInstanceTableEntries.resize(meshInstances.size());
+            mMeshInstanceTableDirtyRanges.Reset(meshInstances.size(), frameNumber);
+            mMeshInstanceDrawArgumentEntries.resize(meshInstances.size());
+            mMeshInstanceCuller.Resize(meshInstances.size());
+        }
 
         uint32_t instanceIdx = 0;
 
-        auto uploadInstance = [&](const GPUMeshInstanceTableEntry& gpuInstance, const VertexStorageLocation& vertexLocations, auto&& sceneObject)
+        for (MeshInstance& instance : meshInstances)
         {
-            sceneObject.SetIndexInGPUTable(instanceIdx);
+            if (rebuildTopology || instance.IsGPUDataDirty())
+            {
+                GPUMeshInstanceTableEntry& instanceEntry = mMeshInstanceTableEntries[instanceIdx];
+
+                instanceEntry = {
+                    instance.GetTransformation().GetMatrix(),
+                    instance.GetPreviousTransformation().GetMatrix(),
+                    instance.GetTransformation().GetNormalMatrix(),
+                    instance.GetAssociatedMaterial()->GPUMaterialTableIndex,
+                    instance.GetAssociatedMesh()->GetLocationInVertexStorage().VertexBufferOffset,
+                    instance.GetAssociatedMesh()->GetLocationInVertexStorage().IndexBufferOffset,
+                    instance.GetAssociatedMesh()->GetLocationInVertexStorage().IndexCount,
+                    instance.GetAssociatedMesh()->HasTangentSpace(),
+                    instance.IsDoubleSided()
+                };
 
-            BottomRTAS& blas = mBottomAccelerationStructures[vertexLocations.BottomAccelerationStructureIndex];
+                HAL::RootConstantDrawArguments& drawArguments = mMeshInstanceDrawArgumentEntries[instanceIdx];
+                drawArguments.RootConstant = instanceIdx;
+                drawArguments.Draw.VertexCount = instance.GetAssociatedMesh()->GetLocationInVertexStorage().IndexCount;
 
-            HAL::RayTracingTopAccelerationStructure::InstanceInfo instanceInfo{
-                instanceIdx, std::underlying_type_t<GPUInstanceMask>(GPUInstanceMask::Mesh), std::underlying_type_t<GPUInstanceHitGroupContribution>(GPUInstanceHitGroupContribution::Mesh)
-            };
+                mMeshInstanceCuller.SetBox(instanceIdx, instance.GetBoundingBox(*instance.GetAssociatedMesh()));
+
+                if (rebuildTopology)
+                {
+                    instance.SetIndexInGPUTable(instanceIdx);
+
+                    BottomRTAS& blas = mBottomAccelerationStructures[instance.GetAssociatedMesh()->GetLocationInVertexStorage().BottomAccelerationStructureIndex];
+
+                    HAL::RayTracingTopAccelerationStructure::InstanceInfo instanceInfo{
+                        instanceIdx, std::underlying_type_t<GPUInstanceMask>(GPUInstanceMask::Mesh), std::underlying_type_t<GPUInstanceHitGroupContribution>(GPUInstanceHitGroupContribution::Mesh)
+                    };
 
-            mTopAccelerationStructure.AddInstance(blas, instanceInfo, gpuInstance.InstanceWorldMatrix);
-            mMeshInstanceTable->Write(&gpuInstance, instanceIdx, 1);
+                    mTopAccelerationStructure.AddInstance(blas, instanceInfo, instanceEntry.InstanceWorldMatrix);
+                }
+                else
+                {
+                    // Mesh instances go first in the top acceleration structure
+                    mTopAccelerationStructure.UpdateInstanceTransform(instanceIdx, instanceEntry.InstanceWorldMatrix);
+                    mMeshInstanceTableDirtyRanges.MarkDirty(instanceIdx, frameNumber);
+                    mIsTopAccelerationStructureChanged = true;
+                }
+
+                instance.SetIsGPUDataDirty(false);
+            }
 
             ++instanceIdx;
-        };
+        }
 
-        for (MeshInstance& instance : meshInstances)
-        {
-            GPUMeshInstanceTableEntry instanceEntry{
-                instance.GetTransformation().GetMatrix(),
-                instance.GetPreviousTransformation().GetMatrix(),
-                instance.GetTransformation().GetNormalMatrix(),
-                instance.GetAssociatedMaterial()->GPUMaterialTableIndex,
-                instance.GetAssociatedMesh()->GetLocationInVertexStorage().VertexBufferOffset,
-                instance.GetAssociatedMesh()->GetLocationInVertexStorage().IndexBufferOffset,
-                instance.GetAssociatedMesh()->GetLocationInVertexStorage().IndexCount,
-                instance.GetAssociatedMesh()->HasTangentSpace(),
-                instance.IsDoubleSided()
-            };
+        mMeshInstanceTable->RequestWrite();
 
-            uploadInstance(instanceEntry, instance.GetAssociatedMesh()->GetLocationInVertexStorage(), instance);
+        // Upload buffer may hold data of an older frame, so all ranges changed since then are rewritten
+        for (const Foundation::DirtyRangeTracker::Range& range : mMeshInstanceTableDirtyRanges.DirtyRangesSince(mMeshInstanceTable->CurrentUploadBufferContentFrameNumber()))
+        {
+            mMeshInstanceTable->Write(&mMeshInstanceTableEntries[range.Start], range.Start, range.Count);
         }
     }
 
-    void SceneGPUStorage::UploadLights()
+    void SceneGPUStorage::UploadVisibleMeshInstanceDrawArguments()
     {
-        auto& sphericalLights = mScene->GetSphericalLights();
-        auto& rectangularLights = mScene->GetRectangularLights();
-        auto& diskLights = mScene->GetDiskLights();
+        mVisibleMeshInstanceIndices.clear();
+
+        if (mScene->GetMeshInstances().empty())
+            return;
+
+        Geometry::Frustum frustum{ mScene->GetMainCamera().GetFrustumCorners() };
+        mMeshInstanceCuller.Cull(frustum, mVisibleMeshInstanceIndices);
+
+        if (mVisibleMeshInstanceIndices.empty())
+            return;
+
+        if (!mVisibleMeshInstanceDrawArguments || mVisibleMeshInstanceDrawArguments->Capacity<HAL::RootConstantDrawArguments>() < mMeshInstanceDrawArgumentEntries.size())
+        {
+            auto properties = HAL::BufferProperties::Create<HAL::RootConstantDrawArguments>(mMeshInstanceDrawArgumentEntries.size());
+            mVisibleMeshInstanceDrawArguments = mResourceProducer->NewBuffer(properties, Memory::GPUResource::AccessStrategy::DirectUpload);
+            mVisibleMeshInstanceDrawArguments->SetDebugName("Visible Mesh Instance Draw Arguments");
+        }
+
+        mVisibleMeshInstanceDrawArgumentEntries.resize(mVisibleMeshInstanceIndices.size());
+
+        for (auto visibleIdx = 0; visibleIdx < mVisibleMeshInstanceIndices.size(); ++visibleIdx)
+        {
+            mVisibleMeshInstanceDrawArgumentEntries[visibleIdx] = mMeshInstanceDrawArgumentEntries[mVisibleMeshInstanceIndices[visibleIdx]];
+        }
+
+        // Visible set changes with camera every frame, so the whole buffer is rewritten
+        mVisibleMeshInstanceDrawArguments->RequestWrite();
+        mVisibleMeshInstanceDrawArguments->Write(mVisibleMeshInstanceDrawArgumentEntries.data(), 0, mVisibleMeshInstanceDrawArgumentEntries.size());
+    }
 
+    void SceneGPUStorage::UploadLights(bool rebuildTopology)
+    {
         auto requiredBufferSize = mScene->GetTotalLightCount();
 
         if (!mLightTable || mLightTable->Capacity<GPULightTableEntry>() < requiredBufferSize)
@@ -218,50 +327,88 @@ namespace PathFinder
             mLightTable->SetDebugName("Lights Instance Table");
         }
 
-        mLightTable->RequestWrite();
+        uint64_t frameNumber = mResourceProducer->FrameNumber();
+
+        if (rebuildTopology)
+        {
+            mLightTableEntries.resize(requiredBufferSize);
+            mLightTableDirtyRanges.Reset(requiredBufferSize, frameNumber);
+
+            mLightTablePartitionInfo = {};
+            mLightTablePartitionInfo.TotalLightsCount = 1;
+        }
 
-        // Sun goes first
-        GPULightTableEntry sunEntry = CreateSunGPUTableEntry(mScene->GetSky());
-        mLightTable->Write(&sunEntry, 0, 1);
+        // Sun goes first. Sky is not tracked for changes and is cheap to write.
+        mLightTableEntries[0] = CreateSunGPUTableEntry(mScene->GetSky());
+        mLightTableDirtyRanges.MarkDirty(0, frameNumber);
 
         // Then local lights
         uint32_t index = 1;
-        mLightTablePartitionInfo = {};
-        mLightTablePartitionInfo.TotalLightsCount = 1;
-        mLightTablePartitionInfo.SphericalLightsOffset = index;
+        uint64_t meshInstanceCount = mScene->GetMeshInstances().size();
 
-        auto uploadLights = [this, &index](auto&& lights, uint32_t& tableOffset, uint32_t& lightCount, const VertexStorageLocation& vertexLocation)
+        auto uploadLights = [&](auto&& lights, uint32_t& tableOffset, uint32_t& lightCount, const VertexStorageLocation& vertexLocation)
         {
-            tableOffset = index;
+            if (rebuildTopology)
+            {
+                tableOffset = index;
+            }
 
             for (auto& light : lights)
             {
+                // Lights without power do not occupy table entries. 
+                // Switching them on or off changes topology, so they can be skipped here.
                 if (light.GetLuminousPower() <= 0.0)
+                {
+                    light.SetIsGPUDataDirty(false);
                     continue;
+                }
 
-                light.SetIndexInGPUTable(index);
-                light.SetVertexStorageLocation(vertexLocation);
-                light.ConstructModelMatrix();
-
-                GPULightTableEntry lightEntry = CreateLightGPUTableEntry(light);
-                mLightTable->Write(&lightEntry, index, 1);
-
-                HAL::RayTracingTopAccelerationStructure::InstanceInfo instanceInfo{
-                    index, std::underlying_type_t<GPUInstanceMask>(GPUInstanceMask::Light), std::underlying_type_t<GPUInstanceHitGroupContribution>(GPUInstanceHitGroupContribution::Light)
-                };
-
-                BottomRTAS& blas = mBottomAccelerationStructures[vertexLocation.BottomAccelerationStructureIndex];
-                mTopAccelerationStructure.AddInstance(blas, instanceInfo, light.GetModelMatrix());
+                if (rebuildTopology || light.IsGPUDataDirty())
+                {
+                    light.SetIndexInGPUTable(index);
+                    light.SetVertexStorageLocation(vertexLocation);
+                    light.ConstructModelMatrix();
+
+                    mLightTableEntries[index] = CreateLightGPUTableEntry(light);
+
+                    if (rebuildTopology)
+                    {
+                        HAL::RayTracingTopAccelerationStructure::InstanceInfo instanceInfo{
+                            index, std::underlying_type_t<GPUInstanceMask>(GPUInstanceMask::Light), std::underlying_type_t<GPUInstanceHitGroupContribution>(GPUInstanceHitGroupContribution::Light)
+                        };
+
+                        BottomRTAS& blas = mBottomAccelerationStructures[vertexLocation.BottomAccelerationStructureIndex];
+                        mTopAccelerationStructure.AddInstance(blas, instanceInfo, light.GetModelMatrix());
+
+                        ++lightCount;
+                        ++mLightTablePartitionInfo.TotalLightsCount;
+                    }
+                    else
+                    {
+                        // Lights follow mesh instances in the top acceleration structure, sun has no instance
+                        mTopAccelerationStructure.UpdateInstanceTransform(meshInstanceCount + index - 1, light.GetModelMatrix());
+                        mLightTableDirtyRanges.MarkDirty(index, frameNumber);
+                        mIsTopAccelerationStructureChanged = true;
+                    }
+
+                    light.SetIsGPUDataDirty(false);
+                }
 
                 ++index;
-                ++lightCount;
-                ++mLightTablePartitionInfo.TotalLightsCount;
             }
         };
 
         uploadLights(mScene->GetSphericalLights(), mLightTablePartitionInfo.SphericalLightsOffset, mLightTablePartitionInfo.SphericalLightsCount, mUnitSphereVertexLocation);
         uploadLights(mScene->GetRectangularLights(), mLightTablePartitionInfo.RectangularLightsOffset, mLightTablePartitionInfo.RectangularLightsCount, mUnitQuadVertexLocation);
         uploadLights(mScene->GetDiskLights(), mLightTablePartitionInfo.EllipticalLightsOffset, mLightTablePartitionInfo.EllipticalLightsCount, mUnitQuadVertexLocation);
+
+        mLightTable->RequestWrite();
+
+        // Upload buffer may hold data of an older frame, so all ranges changed since then are rewritten
+        for (const Foundation::DirtyRangeTracker::Range& range : mLightTableDirtyRanges.DirtyRangesSince(mLightTable->CurrentUploadBufferContentFrameNumber()))
+        {
+            mLightTable->Write(&mLightTableEntries[range.Start], range.Start, range.Count);
+        }
     }
 
     void SceneGPUStorage::UploadDebugGIProbes()
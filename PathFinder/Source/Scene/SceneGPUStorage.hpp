@@ -6,10 +6,14 @@
 #include <HardwareAbstractionLayer/ResourceBarrier.hpp>
 
 #include <Memory/GPUResourceProducer.hpp>
+#include <Foundation/DirtyRangeTracker.hpp>
+#include <Geometry/FrustumCuller.hpp>
+#include <HardwareAbstractionLayer/CommandSignature.hpp>
 
 #include "Mesh.hpp"
 #include "MeshInstance.hpp"
 #include "Vertices/Vertex1P1N1UV1T1BT.hpp"
+#include "Vertices/Vertex1P1N1UV1T1BTCompressed.hpp"
 #include "Vertices/Vertex1P1N1UV.hpp"
 #include "Vertices/Vertex1P3.hpp"
 #include "FlatLight.hpp"
@@ -25,6 +29,7 @@
 #include <vector>
 #include <memory>
 #include <tuple>
+#include <optional>
 
 namespace PathFinder
 {
@@ -67,22 +72,42 @@ namespace PathFinder
             Memory::GPUResourceProducer::BufferPtr IndexBuffer;
         };
 
+        // Everything that affects instance and light placement in GPU tables and top acceleration structure.
+        // When it doesn't change, tables are updated in place and acceleration structure is refitted.
+        struct InstanceTopology
+        {
+            uint64_t MeshInstanceCount = 0;
+            std::vector<bool> ActiveLightMask;
+            bool HasDebugGIProbes = false;
+
+            bool operator==(const InstanceTopology& that) const
+            {
+                return MeshInstanceCount == that.MeshInstanceCount && ActiveLightMask == that.ActiveLightMask && HasDebugGIProbes == that.HasDebugGIProbes;
+            }
+
+            bool operator!=(const InstanceTopology& that) const { return !(*this == that); }
+        };
+
         template <class Vertex>
         void SubmitTemporaryBuffersToGPU();
 
-        void UploadMeshInstances();
-        void UploadLights();
+        InstanceTopology GetCurrentInstanceTopology() const;
+        void UploadMeshInstances(bool rebuildTopology);
+        void UploadLights(bool rebuildTopology);
+        void UploadVisibleMeshInstanceDrawArguments();
         void UploadDebugGIProbes();
 
         GPULightTableEntry CreateLightGPUTableEntry(const FlatLight& light) const;
         GPULightTableEntry CreateLightGPUTableEntry(const SphericalLight& light) const;
         GPULightTableEntry CreateSunGPUTableEntry(const Sky& sky) const;
 
-        template <class Vertex>
-        VertexStorageLocation WriteToTemporaryBuffers(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices = nullptr, uint32_t indexCount = 0);
+        // Source vertices are converted to the storage vertex type as they are copied
+        template <class Vertex, class SourceVertex>
+        VertexStorageLocation WriteToTemporaryBuffers(const SourceVertex* vertices, uint32_t vertexCount, const uint32_t* indices = nullptr, uint32_t indexCount = 0);
 
-        std::tuple<UploadBufferPackage<Vertex1P1N1UV1T1BT>, UploadBufferPackage<Vertex1P1N1UV>, UploadBufferPackage<Vertex1P3>> mUploadBuffers;
-        std::tuple<FinalBufferPackage<Vertex1P1N1UV1T1BT>, FinalBufferPackage<Vertex1P1N1UV>, FinalBufferPackage<Vertex1P3>> mFinalBuffers;
+        // Meshes are stored compressed, full precision vertices stay with CPU side meshes
+        std::tuple<UploadBufferPackage<Vertex1P1N1UV1T1BTCompressed>, UploadBufferPackage<Vertex1P1N1UV>, UploadBufferPackage<Vertex1P3>> mUploadBuffers;
+        std::tuple<FinalBufferPackage<Vertex1P1N1UV1T1BTCompressed>, FinalBufferPackage<Vertex1P1N1UV>, FinalBufferPackage<Vertex1P3>> mFinalBuffers;
 
         std::vector<BottomRTAS> mBottomAccelerationStructures;
         TopRTAS mTopAccelerationStructure;
@@ -91,6 +116,22 @@ namespace PathFinder
         Memory::GPUResourceProducer::BufferPtr mLightTable;
         Memory::GPUResourceProducer::BufferPtr mMaterialTable;
 
+        // CPU copies of GPU tables used to patch upload buffers that hold older data
+        std::vector<GPUMeshInstanceTableEntry> mMeshInstanceTableEntries;
+        std::vector<GPULightTableEntry> mLightTableEntries;
+        Foundation::DirtyRangeTracker mMeshInstanceTableDirtyRanges;
+        Foundation::DirtyRangeTracker mLightTableDirtyRanges;
+        std::optional<InstanceTopology> mUploadedInstanceTopology;
+
+        // World space bounds of mesh instances in GPU table order and per instance draws built from them.
+        // Only draws of instances intersecting camera frustum are uploaded for indirect execution.
+        Geometry::FrustumCuller mMeshInstanceCuller;
+        std::vector<HAL::RootConstantDrawArguments> mMeshInstanceDrawArgumentEntries;
+        std::vector<HAL::RootConstantDrawArguments> mVisibleMeshInstanceDrawArgumentEntries;
+        std::vector<uint32_t> mVisibleMeshInstanceIndices;
+        Memory::GPUResourceProducer::BufferPtr mVisibleMeshInstanceDrawArguments;
+        bool mIsTopAccelerationStructureChanged = false;
+
         VertexStorageLocation mUnitQuadVertexLocation;
         VertexStorageLocation mUnitCubeVertexLocation;
         VertexStorageLocation mUnitSphereVertexLocation;
@@ -105,13 +146,16 @@ namespace PathFinder
         const RenderSettings* mRenderSettings;
 
     public:
-        inline const auto UnifiedVertexBuffer() const { return std::get<FinalBufferPackage<Vertex1P1N1UV1T1BT>>(mFinalBuffers).VertexBuffer.get(); }
-        inline const auto UnifiedIndexBuffer() const { return std::get<FinalBufferPackage<Vertex1P1N1UV1T1BT>>(mFinalBuffers).IndexBuffer.get(); }
+        inline const auto UnifiedVertexBuffer() const { return std::get<FinalBufferPackage<Vertex1P1N1UV1T1BTCompressed>>(mFinalBuffers).VertexBuffer.get(); }
+        inline const auto UnifiedIndexBuffer() const { return std::get<FinalBufferPackage<Vertex1P1N1UV1T1BTCompressed>>(mFinalBuffers).IndexBuffer.get(); }
         inline const auto MeshInstanceTable() const { return mMeshInstanceTable.get(); }
         inline const auto LightTable() const { return mLightTable.get(); }
         inline const auto MaterialTable() const { return mMaterialTable.get(); }
+        inline const auto VisibleMeshInstanceDrawArguments() const { return mVisibleMeshInstanceDrawArguments.get(); }
+        inline uint32_t VisibleMeshInstanceCount() const { return (uint32_t)mVisibleMeshInstanceIndices.size(); }
         inline const auto& LightTablePartitionInfo() const { return mLightTablePartitionInfo; }
         inline const auto& TopAccelerationStructure() const { return mTopAccelerationStructure; }
+        inline bool IsTopAccelerationStructureChanged() const { return mIsTopAccelerationStructureChanged; }
         inline const auto& BottomAccelerationStructures() const { return mBottomAccelerationStructures; }
     };
 
@@ -1,8 +1,8 @@
 namespace PathFinder
 {
 
-    template <class Vertex>
-    VertexStorageLocation SceneGPUStorage::WriteToTemporaryBuffers(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount)
+    template <class Vertex, class SourceVertex>
+    VertexStorageLocation SceneGPUStorage::WriteToTemporaryBuffers(const SourceVertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount)
     {
         auto& package = std::get<UploadBufferPackage<Vertex>>(mUploadBuffers);
         auto vertexStartIndex = package.Vertices.size();
@@ -18,12 +18,33 @@ namespace PathFinder
 
     void Sky::UpdateSkyState()
     {
+        if (mSkyStateSunDirection == mSunDirection && mSkyStateTurbidity == mTurbidity)
+            return;
+
+        mSkyStateSunDirection = mSunDirection;
+        mSkyStateTurbidity = mTurbidity;
+
         // Different sky model states seem to require elevation angles 
         // in different frames of reference, which is really confusing.
         float elevationPiOver2AtHorizon = std::acos(mSunDirection.y);
         float elevationPiOver2AtZenith = M_PI_2 - elevationPiOver2AtHorizon;
-        float turbidity = 1.7f;
 
+        glm::vec3 sunLuminance = LookupSolarLuminance(elevationPiOver2AtHorizon, mTurbidity);
+        glm::vec3 sunIlluminance = sunLuminance * SunSolidAngle; // Dividing by 1 / PDF
+
+        // Found it on internet, without it the illuminance is too small.
+        // Account for luminous efficacy, coordinate system scaling (100, wtf???)
+        float multiplier = 100 * StandardLuminousEfficacy; 
+        mSolarIlluminance = sunIlluminance * multiplier;
+        mSolarLuminance = sunLuminance * multiplier;
+
+        InitRGBSkyModelState(mSkyModelStateR, mGroundAlbedo.r, elevationPiOver2AtZenith);
+        InitRGBSkyModelState(mSkyModelStateG, mGroundAlbedo.g, elevationPiOver2AtZenith);
+        InitRGBSkyModelState(mSkyModelStateB, mGroundAlbedo.b, elevationPiOver2AtZenith);
+    }
+
+    glm::vec3 Sky::ComputeSolarLuminance(float elevationPiOver2AtHorizon, float turbidity)
+    {
         uint32_t totalSampleCount = mSkySpectrum.GetSamples().size();
 
         // Vertical sample angle. For one ray it's just equal to elevation.
@@ -43,27 +64,41 @@ namespace PathFinder
             arhosekskymodelstate_free(skyState);
         }
 
-        if (mSkyModelStateR)
-            arhosekskymodelstate_free(mSkyModelStateR);
+        return mSkySpectrum.ToRGB();
+    }
 
-        if (mSkyModelStateG)
-            arhosekskymodelstate_free(mSkyModelStateG);
+    glm::vec3 Sky::LookupSolarLuminance(float elevationPiOver2AtHorizon, float turbidity)
+    {
+        uint32_t turbidityKey = uint32_t(std::round(turbidity / TurbidityQuantizationStep));
+        float quantizedTurbidity = turbidityKey * TurbidityQuantizationStep;
 
-        if (mSkyModelStateB)
-            arhosekskymodelstate_free(mSkyModelStateB);
+        SolarLuminanceTable& table = mSolarLuminanceTables[turbidityKey];
 
-        glm::vec3 sunLuminance = mSkySpectrum.ToRGB();
-        glm::vec3 sunIlluminance = sunLuminance * SunSolidAngle; // Dividing by 1 / PDF
+        if (table.empty())
+            table.resize(SolarLuminanceTableSize);
 
-        // Found it on internet, without it the illuminance is too small.
-        // Account for luminous efficacy, coordinate system scaling (100, wtf???)
-        float multiplier = 100 * StandardLuminousEfficacy; 
-        mSolarIlluminance = sunIlluminance * multiplier;
-        mSolarLuminance = sunLuminance * multiplier;
+        float elevationAboveHorizon = glm::clamp(float(M_PI_2) - elevationPiOver2AtHorizon, 0.0f, float(M_PI_2));
+        float tableCoordinate = std::cbrt(elevationAboveHorizon / float(M_PI_2)) * (SolarLuminanceTableSize - 1);
+        uint32_t lowerNode = std::min(uint32_t(tableCoordinate), SolarLuminanceTableSize - 2);
+
+        for (uint32_t node = lowerNode; node <= lowerNode + 1; ++node)
+        {
+            if (table[node])
+                continue;
 
-        mSkyModelStateR = arhosek_rgb_skymodelstate_alloc_init(turbidity, mGroundAlbedo.r, elevationPiOver2AtZenith);
-        mSkyModelStateG = arhosek_rgb_skymodelstate_alloc_init(turbidity, mGroundAlbedo.g, elevationPiOver2AtZenith);
-        mSkyModelStateB = arhosek_rgb_skymodelstate_alloc_init(turbidity, mGroundAlbedo.b, elevationPiOver2AtZenith);
+            float nodeCoordinate = float(node) / (SolarLuminanceTableSize - 1);
+            float nodeElevationAboveHorizon = nodeCoordinate * nodeCoordinate * nodeCoordinate * float(M_PI_2);
+            table[node] = ComputeSolarLuminance(float(M_PI_2) - nodeElevationAboveHorizon, quantizedTurbidity);
+        }
+
+        return glm::mix(*table[lowerNode], *table[lowerNode + 1], tableCoordinate - lowerNode);
+    }
+
+    void Sky::InitRGBSkyModelState(ArHosekSkyModelState& state, float albedo, float elevationPiOver2AtZenith) const
+    {
+        ArHosekSkyModelState* newState = arhosek_rgb_skymodelstate_alloc_init(mTurbidity, albedo, elevationPiOver2AtZenith);
+        state = *newState;
+        arhosekskymodelstate_free(newState);
     }
 
     void Sky::UpdatePreviousFrameValues()
@@ -78,4 +113,10 @@ namespace PathFinder
         mSunDirection = glm::normalize(mSunDirection);
     }
 
+    void Sky::SetTurbidity(float turbidity)
+    {
+        // Range covered by model datasets
+        mTurbidity = glm::clamp(turbidity, 1.0f, 10.0f);
+    }
+
 }
@@ -3,6 +3,10 @@
 #include <glm/vec3.hpp>
 #include <Foundation/Spectrum.hpp>
 #include <hoseksky/ArHosekSkyModel.h>
+#include <robinhood/robin_hood.h>
+
+#include <vector>
+#include <optional>
 
 namespace PathFinder 
 {
@@ -16,30 +20,54 @@ namespace PathFinder
 
         Sky();
 
+        // Re-evaluates sky model only when sun direction or turbidity changed since last update
         void UpdateSkyState();
         void UpdatePreviousFrameValues();
 
     private:
+        // Solar luminance is integrated over 25 spectral model states, which is too slow to do every time sun moves.
+        // Instead it's integrated lazily at fixed elevations and interpolated between them.
+        // Elevations are spaced uniformly in cube root of elevation above horizon, the same parametrization
+        // the model itself uses to interpolate its datasets, which keeps the error low near the horizon.
+        static constexpr uint32_t SolarLuminanceTableSize = 128;
+        static constexpr float TurbidityQuantizationStep = 0.1f;
+
+        using SolarLuminanceTable = std::vector<std::optional<glm::vec3>>;
+
+        glm::vec3 ComputeSolarLuminance(float elevationPiOver2AtHorizon, float turbidity);
+        glm::vec3 LookupSolarLuminance(float elevationPiOver2AtHorizon, float turbidity);
+        void InitRGBSkyModelState(ArHosekSkyModelState& state, float albedo, float elevationPiOver2AtZenith) const;
+
         glm::vec3 mGroundAlbedo = glm::vec3{ 0.5f };
         glm::vec3 mSolarIlluminance = glm::vec3{ 1.0f };
         glm::vec3 mSolarLuminance = glm::vec3{ 1.0f };
         glm::vec3 mSunDirection = glm::vec3{ 0.0, 1.0, 0.0 };
         glm::vec3 mPreviousSunDirection = glm::vec3{ 0.0, 1.0, 0.0 };
+        float mTurbidity = 1.7f;
         Foundation::SampledSpectrum mSkySpectrum;
         Foundation::SampledSpectrum mGroundAlbedoSpectrum;
-        ArHosekSkyModelState* mSkyModelStateR = nullptr;
-        ArHosekSkyModelState* mSkyModelStateG = nullptr;
-        ArHosekSkyModelState* mSkyModelStateB = nullptr;
+        ArHosekSkyModelState mSkyModelStateR{};
+        ArHosekSkyModelState mSkyModelStateG{};
+        ArHosekSkyModelState mSkyModelStateB{};
+
+        // Inputs of the current sky state
+        std::optional<glm::vec3> mSkyStateSunDirection;
+        float mSkyStateTurbidity = 0.0f;
+
+        // Tables for quantized turbidity values
+        robin_hood::unordered_node_map<uint32_t, SolarLuminanceTable> mSolarLuminanceTables;
 
     public:
         inline const glm::vec3& GetSolarIlluminance() const { return mSolarIlluminance; }
         inline const glm::vec3& GetSunDirection() const { return mSunDirection; }
         inline const glm::vec3& GetPreviousSunDirection() const { return mPreviousSunDirection; }
         inline const glm::vec3& GetSolarLuminance() const { return mSolarLuminance; }
-        inline const ArHosekSkyModelState* GetSkyModelStateR() const { return mSkyModelStateR; }
-        inline const ArHosekSkyModelState* GetSkyModelStateG() const { return mSkyModelStateG; }
-        inline const ArHosekSkyModelState* GetSkyModelStateB() const { return mSkyModelStateB; }
+        inline const ArHosekSkyModelState* GetSkyModelStateR() const { return &mSkyModelStateR; }
+        inline const ArHosekSkyModelState* GetSkyModelStateG() const { return &mSkyModelStateG; }
+        inline const ArHosekSkyModelState* GetSkyModelStateB() const { return &mSkyModelStateB; }
+        inline auto GetTurbidity() const { return mTurbidity; }
         void SetSunDirection(const glm::vec3& direction);
+        void SetTurbidity(float turbidity);
     };
 
 }
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "TextureStreamingPolicy.hpp"
+
+#include <robinhood/robin_hood.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace PathFinder
+{
+
+    // Deduplicates textures by normalized file path and by hash of file contents.
+    //
+    // Cache owns textures, users only reference them. CPU copies of texture data belong to the users
+    // that requested them and are only observed by the cache, so a copy is freed together with its last user.
+    // A copy requested after it was freed makes the texture load again, while the texture it replaces
+    // stays alive for users that still reference it.
+    //
+    // TexturePtr is an owning pointer, like GPUResourceProducer::TexturePtr. Not thread safe.
+    template <class TexturePtr>
+    class TextureCache
+    {
+    public:
+        using RowMajorBlob = std::shared_ptr<const std::vector<uint8_t>>;
+
+        struct Entry
+        {
+            TexturePtr Texture;
+
+            // Streamer owns streamed textures
+            std::optional<TextureStreamingPolicy::TextureId> StreamedTextureId;
+
+            std::weak_ptr<const std::vector<uint8_t>> RowMajorBlob;
+        };
+
+        struct Reference
+        {
+            const Entry* CachedTexture = nullptr;
+
+            // Only set when requested
+            RowMajorBlob Blob;
+        };
+
+        struct Statistics
+        {
+            uint64_t PathHitCount = 0;
+            uint64_t ContentHitCount = 0;
+            uint64_t MissCount = 0;
+        };
+
+        // Looks a texture up by path, then by content hash of the file returned by readFile() as an optional.
+        // On a miss load(file, entry) fills the entry in and returns a CPU copy of texture data, if it was requested.
+        // Empty reference is returned when there is no file.
+        template <class ReadFile, class Load>
+        Reference GetOrLoad(const std::string& pathKey, bool needsRowMajorBlob, ReadFile&& readFile, Load&& load);
+
+        // Textures that come from sources other than files, like scene containers.
+        // On a miss create() returns a new texture.
+        template <class Create>
+        const Entry& GetOrCreate(uint64_t contentHash, Create&& create);
+
+    private:
+        robin_hood::unordered_node_map<uint64_t, Entry> mEntriesByContent;
+        robin_hood::unordered_flat_map<std::string, const Entry*> mEntriesByPath;
+
+        // Textures replaced because their CPU data was requested after it had been freed
+        std::vector<TexturePtr> mReplacedTextures;
+
+        Statistics mStatistics;
+
+    public:
+        inline const Statistics& Stats() const { return mStatistics; }
+        inline uint64_t ReplacedTextureCount() const { return mReplacedTextures.size(); }
+    };
+
+}
+
+#include "TextureCache.inl"
@@ -0,0 +1,75 @@
+#pragma once
+
+namespace PathFinder
+{
+
+    template <class TexturePtr>
+    template <class ReadFile, class Load>
+    typename TextureCache<TexturePtr>::Reference TextureCache<TexturePtr>::GetOrLoad(const std::string& pathKey, bool needsRowMajorBlob, ReadFile&& readFile, Load&& load)
+    {
+        auto makeReference = [needsRowMajorBlob](const Entry& entry)
+        {
+            return Reference{ &entry, needsRowMajorBlob ? entry.RowMajorBlob.lock() : nullptr };
+        };
+
+        auto pathIt = mEntriesByPath.find(pathKey);
+
+        if (pathIt != mEntriesByPath.end() && (!needsRowMajorBlob || !pathIt->second->RowMajorBlob.expired()))
+        {
+            ++mStatistics.PathHitCount;
+            return makeReference(*pathIt->second);
+        }
+
+        auto file = readFile();
+
+        if (!file)
+            return {};
+
+        auto [contentIt, isNewContent] = mEntriesByContent.try_emplace(file->ContentHash);
+        Entry& entry = contentIt->second;
+
+        mEntriesByPath[pathKey] = &entry;
+
+        if (!isNewContent && (!needsRowMajorBlob || !entry.RowMajorBlob.expired()))
+        {
+            ++mStatistics.ContentHitCount;
+            return makeReference(entry);
+        }
+
+        if (entry.Texture)
+        {
+            mReplacedTextures.push_back(std::move(entry.Texture));
+        }
+
+        // Streamed texture stays with the streamer for users that already reference it
+        entry.StreamedTextureId = std::nullopt;
+
+        ++mStatistics.MissCount;
+
+        // Cache doesn't own the blob, users referencing it do
+        RowMajorBlob blob = load(*file, entry);
+        entry.RowMajorBlob = blob;
+
+        return Reference{ &entry, std::move(blob) };
+    }
+
+    template <class TexturePtr>
+    template <class Create>
+    const typename TextureCache<TexturePtr>::Entry& TextureCache<TexturePtr>::GetOrCreate(uint64_t contentHash, Create&& create)
+    {
+        auto [contentIt, isNewContent] = mEntriesByContent.try_emplace(contentHash);
+        Entry& entry = contentIt->second;
+
+        if (!isNewContent && entry.Texture)
+        {
+            ++mStatistics.ContentHitCount;
+            return entry;
+        }
+
+        ++mStatistics.MissCount;
+        entry.Texture = create();
+
+        return entry;
+    }
+
+}
@@ -0,0 +1,99 @@
+#define DDSKTX_IMPLEMENT
+
+#include "TextureFileLayout.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace PathFinder
+{
+
+    std::vector<TextureFileLayout::Subresource> TextureFileLayout::Subresources(const ddsktx_texture_info& textureInfo, const uint8_t* fileData, uint64_t fileSize)
+    {
+        const uint8_t* source = fileData + textureInfo.data_offset;
+        const uint8_t* fileEnd = fileData + fileSize;
+
+        bool isCompressedFormat = ddsktx_format_compressed(textureInfo.format);
+        bool isVolume = IsVolume(textureInfo);
+
+        // Block compressed formats supported by the loader use 4x4 blocks
+        uint64_t blockSizeInBytes = textureInfo.bpp * 16 / 8;
+
+        std::vector<Subresource> subresources;
+        subresources.reserve(ArraySize(textureInfo) * textureInfo.num_mips);
+
+        for (uint32_t arraySlice = 0; arraySlice < ArraySize(textureInfo); ++arraySlice)
+        {
+            for (uint32_t mip = 0; mip < (uint32_t)textureInfo.num_mips; ++mip)
+            {
+                uint64_t width = std::max(textureInfo.width >> mip, 1);
+                uint64_t height = std::max(textureInfo.height >> mip, 1);
+
+                Subresource& subresource = subresources.emplace_back();
+                subresource.Data = source;
+                subresource.ArraySlice = arraySlice;
+                subresource.Mip = mip;
+                subresource.DepthSliceCount = isVolume ? std::max(textureInfo.depth >> mip, 1) : 1;
+                subresource.RowSizeInBytes = isCompressedFormat ? std::max<uint64_t>((width + 3) / 4, 1) * blockSizeInBytes : (width * textureInfo.bpp + 7) / 8;
+                subresource.RowCount = isCompressedFormat ? std::max<uint64_t>((height + 3) / 4, 1) : height;
+                subresource.SizeInBytes = subresource.RowSizeInBytes * subresource.RowCount * subresource.DepthSliceCount;
+
+                assert_format(source + subresource.SizeInBytes <= fileEnd, "Texture file is truncated");
+
+                source += subresource.SizeInBytes;
+            }
+        }
+
+        return subresources;
+    }
+
+    void TextureFileLayout::CopySubresources(
+        const ddsktx_texture_info& textureInfo,
+        const uint8_t* fileData,
+        uint64_t fileSize,
+        uint16_t mostDetailedMip,
+        const std::vector<Placement>& placements,
+        uint8_t* destination)
+    {
+        uint32_t loadedMipCount = textureInfo.num_mips - mostDetailedMip;
+
+        for (const Subresource& subresource : Subresources(textureInfo, fileData, fileSize))
+        {
+            if (subresource.Mip < mostDetailedMip)
+                continue;
+
+            const Placement& placement = placements[subresource.Mip - mostDetailedMip + subresource.ArraySlice * loadedMipCount];
+
+            assert_format(placement.RowSizeInBytes == subresource.RowSizeInBytes && placement.RowCount == subresource.RowCount,
+                "Texture file pixel layout doesn't match texture format");
+
+            uint8_t* subresourceDestination = destination + placement.Offset;
+
+            // Depth slices are rows of all slices laid out one after another, same as in the file,
+            // so a subresource is one contiguous copy when row pitches match
+            if (placement.RowPitch == subresource.RowSizeInBytes)
+            {
+                memcpy(subresourceDestination, subresource.Data, subresource.SizeInBytes);
+            }
+            else
+            {
+                for (uint64_t row = 0; row < subresource.RowCount * subresource.DepthSliceCount; ++row)
+                {
+                    memcpy(subresourceDestination + row * placement.RowPitch, subresource.Data + row * subresource.RowSizeInBytes, subresource.RowSizeInBytes);
+                }
+            }
+        }
+    }
+
+    uint32_t TextureFileLayout::ArraySize(const ddsktx_texture_info& textureInfo)
+    {
+        bool isCubeMap = textureInfo.flags & DDSKTX_TEXTURE_FLAG_CUBEMAP;
+        return textureInfo.num_layers * (isCubeMap ? DDSKTX_CUBE_FACE_COUNT : 1);
+    }
+
+    bool TextureFileLayout::IsVolume(const ddsktx_texture_info& textureInfo)
+    {
+        return textureInfo.depth > 1 && ArraySize(textureInfo) == 1;
+    }
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <ThirdParty/dds/dds-ktx.h>
+
+#include <vector>
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    // Layout of pixel data inside a parsed texture file and its copy into subresources with padded row pitches.
+    // Knows nothing of GPU resources, texture loader supplies placements from resource footprints.
+    class TextureFileLayout
+    {
+    public:
+        struct Subresource
+        {
+            const uint8_t* Data = nullptr;
+            uint32_t ArraySlice = 0;
+            uint32_t Mip = 0;
+            uint64_t RowSizeInBytes = 0;
+            uint64_t RowCount = 0;
+            uint64_t DepthSliceCount = 0;
+            uint64_t SizeInBytes = 0;
+        };
+
+        // Where a subresource lands in destination memory
+        struct Placement
+        {
+            uint64_t Offset = 0;
+            uint64_t RowPitch = 0;
+
+            // Must match the file, otherwise texture format doesn't describe file contents
+            uint64_t RowSizeInBytes = 0;
+            uint64_t RowCount = 0;
+        };
+
+        // Subresources in file order: array slice by array slice (cube faces included), each slice with its whole mip chain
+        static std::vector<Subresource> Subresources(const ddsktx_texture_info& textureInfo, const uint8_t* fileData, uint64_t fileSize);
+
+        // Writes subresources of mips starting from mostDetailedMip in a single pass over the file.
+        // Placements are indexed as texture subresources: mip relative to mostDetailedMip + array slice * loaded mip count.
+        static void CopySubresources(
+            const ddsktx_texture_info& textureInfo,
+            const uint8_t* fileData,
+            uint64_t fileSize,
+            uint16_t mostDetailedMip,
+            const std::vector<Placement>& placements,
+            uint8_t* destination);
+
+        // Cube maps are arrays of faces in +X, -X, +Y, -Y, +Z, -Z order, the same order D3D expects for cube views
+        static uint32_t ArraySize(const ddsktx_texture_info& textureInfo);
+
+        static bool IsVolume(const ddsktx_texture_info& textureInfo);
+    };
+
+}
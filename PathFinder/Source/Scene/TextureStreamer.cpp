@@ -0,0 +1,148 @@
+#include "TextureStreamer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PathFinder
+{
+
+    TextureStreamer::TextureStreamer(Memory::GPUResourceProducer* resourceProducer, uint64_t memoryBudgetInBytes)
+        : mResourceLoader{ resourceProducer },
+        mPolicy{ memoryBudgetInBytes, [this](TextureId textureId, uint16_t mostDetailedMip) { RequestResidencyChange(textureId, mostDetailedMip); } } {}
+
+    bool TextureStreamer::CanStream(const ResourceLoader::TextureFile& file)
+    {
+        const ddsktx_texture_info& textureInfo = file.Info;
+        bool isPlain2DTexture = textureInfo.num_layers == 1 && textureInfo.depth == 1 && !(textureInfo.flags & DDSKTX_TEXTURE_FLAG_CUBEMAP);
+
+        return isPlain2DTexture && MipTailStart(file) > 0;
+    }
+
+    TextureStreamer::TextureId TextureStreamer::AddTexture(ResourceLoader::TextureFile&& file)
+    {
+        assert_format(CanStream(file), "Texture can't be streamed");
+
+        TextureId textureId = mTextures.size();
+        StreamedTexture& texture = mTextures.emplace_back();
+
+        TextureStreamingPolicy::TextureDescription description{ ResourceLoader::MipSizesInBytes(file), MipTailStart(file) };
+
+        texture.File = std::move(file);
+        texture.Texture = mResourceLoader.LoadTexture(texture.File, false, description.MipTailStart);
+
+        mPolicy.AddTexture(textureId, description);
+
+        return textureId;
+    }
+
+    void TextureStreamer::AddReference(TextureId textureId, Material::TextureData* textureData)
+    {
+        StreamedTexture& texture = mTextures[textureId];
+        texture.References.push_back(textureData);
+        mReferencedTextures[textureData] = textureId;
+
+        textureData->Texture = Memory::GPUResourceProducer::TexturePtr{ texture.Texture.get(), [](Memory::Texture* texture) {} };
+    }
+
+    void TextureStreamer::ReportUsage(const Material::TextureData* textureData, float screenSizeInPixels)
+    {
+        auto textureIt = mReferencedTextures.find(textureData);
+
+        if (textureIt == mReferencedTextures.end())
+            return;
+
+        const ddsktx_texture_info& textureInfo = mTextures[textureIt->second].File.Info;
+
+        // Texture is assumed to be mapped over the object once, so one texel per pixel
+        // is reached at the mip which is as large as the object on screen
+        float textureSize = std::max(textureInfo.width, textureInfo.height);
+        float texelsPerPixel = textureSize / std::max(screenSizeInPixels, 1.0f);
+        uint16_t desiredMip = texelsPerPixel > 1.0f ? uint16_t(std::floor(std::log2(texelsPerPixel))) : 0;
+
+        mPolicy.ReportUsage(textureIt->second, desiredMip, screenSizeInPixels * screenSizeInPixels);
+    }
+
+    void TextureStreamer::Update(uint64_t frameNumber)
+    {
+        ApplyResidencyChanges();
+        mPolicy.Update(frameNumber);
+    }
+
+    void TextureStreamer::SetMemoryBudget(uint64_t memoryBudgetInBytes)
+    {
+        mPolicy.SetMemoryBudget(memoryBudgetInBytes);
+    }
+
+    Memory::Texture* TextureStreamer::CurrentTexture(TextureId textureId) const
+    {
+        return mTextures[textureId].Texture.get();
+    }
+
+    uint16_t TextureStreamer::MipTailStart(const ResourceLoader::TextureFile& file)
+    {
+        const ddsktx_texture_info& textureInfo = file.Info;
+        bool isCompressedFormat = ddsktx_format_compressed(textureInfo.format);
+
+        for (uint16_t mip = 0; mip < textureInfo.num_mips; ++mip)
+        {
+            uint64_t width = std::max(textureInfo.width >> mip, 1);
+            uint64_t height = std::max(textureInfo.height >> mip, 1);
+
+            if (std::max(width, height) > MipTailDimension)
+                continue;
+
+            // Most detailed mip of a block compressed texture has to be block aligned,
+            // textures that don't satisfy that at their tail are not streamed
+            bool isBlockAligned = !isCompressedFormat || (width % 4 == 0 && height % 4 == 0);
+
+            return isBlockAligned ? mip : 0;
+        }
+
+        return 0;
+    }
+
+    void TextureStreamer::RequestResidencyChange(TextureId textureId, uint16_t mostDetailedMip)
+    {
+        ResidencyChange* change = &mResidencyChanges.emplace_back();
+        change->Texture = textureId;
+        change->MostDetailedMip = mostDetailedMip;
+
+        const ResourceLoader::TextureFile* file = &mTextures[textureId].File;
+
+        mThreadPool.Execute([change, file]
+        {
+            ResourceLoader::PrefetchMips(*file, change->MostDetailedMip);
+            change->IsPrefetched.store(true, std::memory_order_release);
+        });
+    }
+
+    void TextureStreamer::ApplyResidencyChanges()
+    {
+        uint64_t uploadedBytes = 0;
+
+        // Changes are applied in request order, prefetching completes in the same order
+        while (!mResidencyChanges.empty() && uploadedBytes < MaxUploadBytesPerFrame)
+        {
+            ResidencyChange& change = mResidencyChanges.front();
+
+            if (!change.IsPrefetched.load(std::memory_order_acquire))
+                break;
+
+            StreamedTexture& texture = mTextures[change.Texture];
+
+            // Old texture is released once frames that use it are completed
+            texture.Texture = mResourceLoader.LoadTexture(texture.File, false, change.MostDetailedMip);
+            uploadedBytes += texture.Texture->Footprint().TotalSizeInBytes();
+
+            for (Material::TextureData* textureData : texture.References)
+            {
+                textureData->Texture = Memory::GPUResourceProducer::TexturePtr{ texture.Texture.get(), [](Memory::Texture* texture) {} };
+            }
+
+            mPolicy.CompleteResidencyChange(change.Texture, change.MostDetailedMip);
+            mResidencyChanges.pop_front();
+            ++mResidencyChangeCount;
+        }
+    }
+
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "TextureStreamingPolicy.hpp"
+#include "ResourceLoader.hpp"
+#include "Material.hpp"
+
+#include <Memory/GPUResourceProducer.hpp>
+#include <Foundation/ThreadPool.hpp>
+#include <robinhood/robin_hood.h>
+
+#include <list>
+#include <deque>
+#include <atomic>
+#include <optional>
+
+namespace PathFinder
+{
+
+    // Keeps streamed material textures at the resolution they are seen at, within a memory budget.
+    //
+    // Residency changes recreate a texture with another most detailed mip from its memory mapped file.
+    // File pages of the new mips are read on a worker thread, texture creation and upload happen
+    // in Update, after which materials referencing the texture are repointed to the new one.
+    class TextureStreamer
+    {
+    public:
+        using TextureId = TextureStreamingPolicy::TextureId;
+
+        static constexpr uint64_t DefaultMemoryBudgetInBytes = 1024ull * 1024 * 1024;
+
+        TextureStreamer(Memory::GPUResourceProducer* resourceProducer, uint64_t memoryBudgetInBytes = DefaultMemoryBudgetInBytes);
+
+        // Only plain 2D textures larger than the mip tail can be streamed
+        static bool CanStream(const ResourceLoader::TextureFile& file);
+
+        // Takes over a texture file and creates a texture with only its mip tail
+        TextureId AddTexture(ResourceLoader::TextureFile&& file);
+
+        // Material texture slot is repointed every time texture is recreated, so it must not move
+        void AddReference(TextureId textureId, Material::TextureData* textureData);
+
+        // Estimates needed mip from the size in pixels a texture slot occupies on screen
+        void ReportUsage(const Material::TextureData* textureData, float screenSizeInPixels);
+
+        // Applies loaded residency changes, then issues new ones for usage reported since last update
+        void Update(uint64_t frameNumber);
+
+        void SetMemoryBudget(uint64_t memoryBudgetInBytes);
+
+        Memory::Texture* CurrentTexture(TextureId textureId) const;
+
+    private:
+        struct StreamedTexture
+        {
+            ResourceLoader::TextureFile File;
+            Memory::GPUResourceProducer::TexturePtr Texture;
+            std::vector<Material::TextureData*> References;
+        };
+
+        struct ResidencyChange
+        {
+            TextureId Texture = 0;
+            uint16_t MostDetailedMip = 0;
+            std::atomic_bool IsPrefetched = false;
+        };
+
+        // Mips up to this size along the larger dimension are loaded with the scene and never evicted
+        static constexpr uint64_t MipTailDimension = 128;
+
+        // Bounds the upload work a single frame performs, at least one change is applied per frame
+        static constexpr uint64_t MaxUploadBytesPerFrame = 32 * 1024 * 1024;
+
+        static uint16_t MipTailStart(const ResourceLoader::TextureFile& file);
+
+        void RequestResidencyChange(TextureId textureId, uint16_t mostDetailedMip);
+        void ApplyResidencyChanges();
+
+        ResourceLoader mResourceLoader;
+        TextureStreamingPolicy mPolicy;
+
+        // Elements never move, so workers can read files while textures are added
+        std::deque<StreamedTexture> mTextures;
+        robin_hood::unordered_flat_map<const Material::TextureData*, TextureId> mReferencedTextures;
+
+        // Nodes are only added and removed on the calling thread, workers just flag them
+        std::list<ResidencyChange> mResidencyChanges;
+
+        uint64_t mResidencyChangeCount = 0;
+
+        // Declared last for workers to finish before the data they access is destroyed
+        Foundation::ThreadPool mThreadPool{ 1 };
+
+    public:
+        // Changes whenever material textures are repointed, so material data referencing them has to be rewritten
+        inline uint64_t ResidencyChangeCount() const { return mResidencyChangeCount; }
+        inline const TextureStreamingPolicy& Policy() const { return mPolicy; }
+    };
+
+}
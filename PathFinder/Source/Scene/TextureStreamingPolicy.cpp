@@ -0,0 +1,205 @@
+#include "TextureStreamingPolicy.hpp"
+
+#include <algorithm>
+
+namespace PathFinder
+{
+
+    TextureStreamingPolicy::TextureStreamingPolicy(uint64_t memoryBudgetInBytes, ResidencyChangeCallback&& callback)
+        : mMemoryBudget{ memoryBudgetInBytes }, mCallback{ std::move(callback) } {}
+
+    void TextureStreamingPolicy::AddTexture(TextureId textureId, const TextureDescription& description)
+    {
+        assert_format(description.MipTailStart < description.MipSizes.size(), "Mip tail must contain at least one mip");
+
+        auto [textureIt, isNewTexture] = mTextures.try_emplace(textureId);
+
+        assert_format(isNewTexture, "Texture is already streamed");
+
+        StreamedTexture& texture = textureIt->second;
+        texture.Description = description;
+        texture.MipChainSizes.resize(description.MipSizes.size() + 1, 0);
+
+        for (auto mip = (int64_t)description.MipSizes.size() - 1; mip >= 0; --mip)
+        {
+            texture.MipChainSizes[mip] = texture.MipChainSizes[mip + 1] + description.MipSizes[mip];
+        }
+
+        texture.ResidentMip = description.MipTailStart;
+        texture.TargetMip = description.MipTailStart;
+        texture.DesiredMip = description.MipTailStart;
+
+        mCommittedMemory += texture.MipChainSizes[texture.ResidentMip];
+    }
+
+    void TextureStreamingPolicy::ReportUsage(TextureId textureId, uint16_t desiredMip, float priority)
+    {
+        auto textureIt = mTextures.find(textureId);
+
+        assert_format(textureIt != mTextures.end(), "Texture is not streamed");
+
+        StreamedTexture& texture = textureIt->second;
+        desiredMip = std::min(desiredMip, texture.Description.MipTailStart);
+
+        if (!texture.IsUsedInCurrentFrame)
+        {
+            texture.IsUsedInCurrentFrame = true;
+            texture.DesiredMip = desiredMip;
+            texture.Priority = priority;
+        }
+        else
+        {
+            texture.DesiredMip = std::min(texture.DesiredMip, desiredMip);
+            texture.Priority += priority;
+        }
+    }
+
+    void TextureStreamingPolicy::CompleteResidencyChange(TextureId textureId, uint16_t mostDetailedMip)
+    {
+        auto textureIt = mTextures.find(textureId);
+
+        assert_format(textureIt != mTextures.end(), "Texture is not streamed");
+        assert_format(textureIt->second.TargetMip == mostDetailedMip, "Completed residency change was not requested");
+
+        textureIt->second.ResidentMip = mostDetailedMip;
+    }
+
+    void TextureStreamingPolicy::Update(uint64_t frameNumber)
+    {
+        mRequestCandidates.clear();
+
+        for (auto& [textureId, texture] : mTextures)
+        {
+            if (!texture.IsUsedInCurrentFrame)
+                continue;
+
+            texture.LastUsedFrame = frameNumber;
+
+            if (!IsChangeInFlight(texture) && texture.DesiredMip < texture.ResidentMip)
+            {
+                mRequestCandidates.push_back(textureId);
+            }
+        }
+
+        // Budget might have been lowered since last update
+        EvictUntilFits(0);
+
+        std::sort(mRequestCandidates.begin(), mRequestCandidates.end(), [this](TextureId first, TextureId second)
+        {
+            float firstPriority = mTextures[first].Priority;
+            float secondPriority = mTextures[second].Priority;
+            return firstPriority != secondPriority ? firstPriority > secondPriority : first < second;
+        });
+
+        uint64_t requestCount = 0;
+
+        for (TextureId textureId : mRequestCandidates)
+        {
+            if (requestCount >= MaxRequestsPerUpdate)
+                break;
+
+            StreamedTexture& texture = mTextures[textureId];
+
+            // Load as much detail as fits when desired mip doesn't
+            for (uint16_t mip = texture.DesiredMip; mip < texture.ResidentMip; ++mip)
+            {
+                uint64_t requiredBytes = texture.MipChainSizes[mip] - texture.MipChainSizes[texture.ResidentMip];
+
+                if (EvictUntilFits(requiredBytes))
+                {
+                    RequestResidencyChange(textureId, texture, mip);
+                    ++mStatistics.RequestCount;
+                    ++requestCount;
+                    break;
+                }
+            }
+
+            if (!IsChangeInFlight(texture))
+            {
+                ++mStatistics.DeniedRequestCount;
+            }
+        }
+
+        for (auto& [textureId, texture] : mTextures)
+        {
+            texture.IsUsedInCurrentFrame = false;
+            texture.Priority = 0.0f;
+        }
+    }
+
+    void TextureStreamingPolicy::SetMemoryBudget(uint64_t memoryBudgetInBytes)
+    {
+        mMemoryBudget = memoryBudgetInBytes;
+    }
+
+    uint16_t TextureStreamingPolicy::ResidentMip(TextureId textureId) const
+    {
+        auto textureIt = mTextures.find(textureId);
+        assert_format(textureIt != mTextures.end(), "Texture is not streamed");
+        return textureIt->second.ResidentMip;
+    }
+
+    bool TextureStreamingPolicy::IsChangeInFlight(const StreamedTexture& texture) const
+    {
+        return texture.TargetMip != texture.ResidentMip;
+    }
+
+    void TextureStreamingPolicy::RequestResidencyChange(TextureId textureId, StreamedTexture& texture, uint16_t mostDetailedMip)
+    {
+        mCommittedMemory -= texture.MipChainSizes[texture.TargetMip];
+        mCommittedMemory += texture.MipChainSizes[mostDetailedMip];
+        texture.TargetMip = mostDetailedMip;
+
+        mCallback(textureId, mostDetailedMip);
+    }
+
+    bool TextureStreamingPolicy::EvictUntilFits(uint64_t requiredBytes)
+    {
+        if (mCommittedMemory + requiredBytes <= mMemoryBudget)
+            return true;
+
+        // Textures used in current frame only give up detail they don't need
+        auto evictionTargetMip = [this](const StreamedTexture& texture) -> uint16_t
+        {
+            return texture.IsUsedInCurrentFrame ? texture.DesiredMip : texture.Description.MipTailStart;
+        };
+
+        mEvictionCandidates.clear();
+        uint64_t reclaimableBytes = 0;
+
+        for (auto& [textureId, texture] : mTextures)
+        {
+            uint16_t targetMip = evictionTargetMip(texture);
+
+            if (!IsChangeInFlight(texture) && targetMip > texture.ResidentMip)
+            {
+                mEvictionCandidates.push_back(textureId);
+                reclaimableBytes += texture.MipChainSizes[texture.ResidentMip] - texture.MipChainSizes[targetMip];
+            }
+        }
+
+        // Nothing is evicted for a request that can't be satisfied anyway
+        if (mCommittedMemory + requiredBytes > mMemoryBudget + reclaimableBytes)
+            return false;
+
+        std::sort(mEvictionCandidates.begin(), mEvictionCandidates.end(), [this](TextureId first, TextureId second)
+        {
+            uint64_t firstFrame = mTextures[first].LastUsedFrame;
+            uint64_t secondFrame = mTextures[second].LastUsedFrame;
+            return firstFrame != secondFrame ? firstFrame < secondFrame : first < second;
+        });
+
+        for (TextureId textureId : mEvictionCandidates)
+        {
+            if (mCommittedMemory + requiredBytes <= mMemoryBudget)
+                break;
+
+            StreamedTexture& texture = mTextures[textureId];
+            RequestResidencyChange(textureId, texture, evictionTargetMip(texture));
+            ++mStatistics.EvictionCount;
+        }
+
+        return true;
+    }
+
+}
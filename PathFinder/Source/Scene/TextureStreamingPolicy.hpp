@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Foundation/Delegate.hpp>
+
+#include <robinhood/robin_hood.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace PathFinder
+{
+
+    // Decides which mips of streamed textures should be resident under a memory budget.
+    //
+    // Mips starting from a texture's mip tail are always resident. More detailed mips are requested
+    // for textures used in a frame, in order of their priority, and memory for them is taken from
+    // the least recently used textures, which are dropped back to their mip tails.
+    // Residency changes are applied elsewhere and may take several frames to complete,
+    // textures with a change in flight are neither upgraded nor evicted.
+    class TextureStreamingPolicy
+    {
+    public:
+        using TextureId = uint64_t;
+        using ResidencyChangeCallback = Foundation::Delegate<void(TextureId textureId, uint16_t mostDetailedMip)>;
+
+        struct TextureDescription
+        {
+            // Size of each mip level in bytes, most detailed mip first
+            std::vector<uint64_t> MipSizes;
+
+            // Most detailed mip of the always resident part
+            uint16_t MipTailStart = 0;
+        };
+
+        struct Statistics
+        {
+            uint64_t RequestCount = 0;
+            uint64_t EvictionCount = 0;
+
+            // Upgrades that didn't fit into the budget even after evictions
+            uint64_t DeniedRequestCount = 0;
+        };
+
+        TextureStreamingPolicy(uint64_t memoryBudgetInBytes, ResidencyChangeCallback&& callback);
+
+        // Texture is expected to have its mip tail resident
+        void AddTexture(TextureId textureId, const TextureDescription& description);
+
+        // Reports that texture is used in current frame and how detailed its mips need to be.
+        // Priorities of several reports in a frame are summed, most detailed desired mip is taken.
+        void ReportUsage(TextureId textureId, uint16_t desiredMip, float priority);
+
+        // Called when a residency change requested through the callback is applied
+        void CompleteResidencyChange(TextureId textureId, uint16_t mostDetailedMip);
+
+        // Issues requests and evictions for the frame usage was reported in
+        void Update(uint64_t frameNumber);
+
+        void SetMemoryBudget(uint64_t memoryBudgetInBytes);
+
+        uint16_t ResidentMip(TextureId textureId) const;
+
+    private:
+        struct StreamedTexture
+        {
+            TextureDescription Description;
+
+            // Size of mip chain starting from a mip, one element longer than mip count
+            std::vector<uint64_t> MipChainSizes;
+
+            uint16_t ResidentMip = 0;
+            uint16_t TargetMip = 0;
+            uint16_t DesiredMip = 0;
+            float Priority = 0.0f;
+            uint64_t LastUsedFrame = 0;
+            bool IsUsedInCurrentFrame = false;
+        };
+
+        // Limits amount of data loaded in response to a single frame's usage
+        static constexpr uint64_t MaxRequestsPerUpdate = 8;
+
+        bool IsChangeInFlight(const StreamedTexture& texture) const;
+        void RequestResidencyChange(TextureId textureId, StreamedTexture& texture, uint16_t mostDetailedMip);
+
+        // Frees memory from least recently used textures until requiredBytes fit into the budget.
+        // Returns false without evicting anything if that's not possible.
+        bool EvictUntilFits(uint64_t requiredBytes);
+
+        uint64_t mMemoryBudget = 0;
+
+        // Memory of resident mips, with in-flight changes accounted at their target size
+        uint64_t mCommittedMemory = 0;
+
+        ResidencyChangeCallback mCallback;
+        robin_hood::unordered_node_map<TextureId, StreamedTexture> mTextures;
+        Statistics mStatistics;
+
+        // Scratch memory reused between updates
+        std::vector<TextureId> mRequestCandidates;
+        std::vector<TextureId> mEvictionCandidates;
+
+    public:
+        inline uint64_t CommittedMemory() const { return mCommittedMemory; }
+        inline uint64_t MemoryBudget() const { return mMemoryBudget; }
+        inline const Statistics& Stats() const { return mStatistics; }
+    };
+
+}
@@ -1,19 +1,29 @@
 #include "ThirdPartySceneLoader.hpp"
 
+#include <glm/gtx/norm.hpp>
+
+#include <limits>
+#include <cmath>
+
 namespace PathFinder
 {
 
     std::vector<ThirdPartySceneLoader::LoadedMesh>& ThirdPartySceneLoader::Load(const std::filesystem::path& path, const Settings& settings)
+    {
+        ReadSceneFile(path, settings);
+        return ProcessMeshes(nullptr);
+    }
+
+    void ThirdPartySceneLoader::ReadSceneFile(const std::filesystem::path& path, const Settings& settings)
     {
         mLoadSettings = settings;
         mPath = path;
         mDirectory = path.parent_path();
 
-        Assimp::Importer importer;
-
+        // Tangent space is generated per mesh in parallel after import 
+        // instead of Assimp's single threaded aiProcess_CalcTangentSpace
         auto postProcessSteps = (aiPostProcessSteps)(
             aiProcess_Triangulate |
-            aiProcess_CalcTangentSpace | 
             aiProcess_FlipUVs |
             aiProcess_GenUVCoords | 
             aiProcess_GenNormals | 
@@ -21,15 +31,39 @@ namespace PathFinder
             aiProcess_JoinIdenticalVertices |
             aiProcess_ConvertToLeftHanded);
 
-        const aiScene* pScene = importer.ReadFile(path.string(), postProcessSteps);
+        const aiScene* pScene = mImporter.ReadFile(path.string(), postProcessSteps);
 
         assert_format(pScene, "Unable to read mesh file (", path.string(), ")");
 
         mLoadedMeshes.clear();
         mLoadedMaterials.clear();
+        mAssimpMeshes.clear();
 
         ProcessMaterials(pScene);
         ProcessNode(pScene->mRootNode, pScene);
+    }
+
+    std::vector<ThirdPartySceneLoader::LoadedMesh>& ThirdPartySceneLoader::ProcessMeshes(Foundation::ThreadPool* threadPool)
+    {
+        auto processMesh = [this](uint64_t meshIdx)
+        {
+            ProcessMesh(mLoadedMeshes[meshIdx], mAssimpMeshes[meshIdx]);
+        };
+
+        if (threadPool)
+        {
+            threadPool->ParallelFor(mLoadedMeshes.size(), processMesh);
+        }
+        else
+        {
+            for (auto meshIdx = 0u; meshIdx < mLoadedMeshes.size(); ++meshIdx)
+            {
+                processMesh(meshIdx);
+            }
+        }
+
+        mAssimpMeshes.clear();
+        mImporter.FreeScene();
 
         return mLoadedMeshes;
     }
@@ -126,12 +160,16 @@ namespace PathFinder
         }
     }
 
-    void ThirdPartySceneLoader::ProcessMesh(Mesh& mesh, aiMesh* assimpMesh, const aiScene* scene)
+    void ThirdPartySceneLoader::ProcessMesh(LoadedMesh& loadedMesh, const aiMesh* assimpMesh) const
     {
-        // Walk through each of the mesh's vertices
+        Mesh& mesh = loadedMesh.MeshObject;
+        std::vector<Vertex1P1N1UV1T1BT> vertices(assimpMesh->mNumVertices);
+        std::vector<uint32_t> indices;
+        indices.reserve(assimpMesh->mNumFaces * 3);
+
         for (auto i = 0u; i < assimpMesh->mNumVertices; i++)
         {
-            Vertex1P1N1UV1T1BT vertex{};
+            Vertex1P1N1UV1T1BT& vertex = vertices[i];
 
             vertex.Position.x = assimpMesh->mVertices[i].x * mLoadSettings.InitialScale;
             vertex.Position.y = assimpMesh->mVertices[i].y * mLoadSettings.InitialScale;
@@ -144,38 +182,91 @@ namespace PathFinder
                 vertex.UV.y = (float)assimpMesh->mTextureCoords[0][i].y;
             }
 
-            if (assimpMesh->HasTangentsAndBitangents())
-            {
-                vertex.Tangent.x = assimpMesh->mTangents[i].x;
-                vertex.Tangent.y = assimpMesh->mTangents[i].y;
-                vertex.Tangent.z = assimpMesh->mTangents[i].z;
-
-                vertex.Bitangent.x = assimpMesh->mBitangents[i].x;
-                vertex.Bitangent.y = assimpMesh->mBitangents[i].y;
-                vertex.Bitangent.z = assimpMesh->mBitangents[i].z;
-            }
-
             if (assimpMesh->HasNormals())
             {
                 vertex.Normal.x = assimpMesh->mNormals[i].x;
                 vertex.Normal.y = assimpMesh->mNormals[i].y;
                 vertex.Normal.z = assimpMesh->mNormals[i].z;
             }
-
-            mesh.AddVertex(vertex);
         }
 
         for (auto i = 0u; i < assimpMesh->mNumFaces; i++)
         {
-            aiFace face = assimpMesh->mFaces[i];
+            const aiFace& face = assimpMesh->mFaces[i];
+            indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+        }
+
+        // Tangent space requires texture coordinates, same as in Assimp 
+        if (assimpMesh->HasTextureCoords(0) && assimpMesh->HasNormals())
+        {
+            GenerateTangentSpace(vertices, indices);
+        }
+
+        if (mLoadSettings.OptimizeMeshes)
+        {
+            mesh.SetOptimizationReport(MeshOptimizer::Optimize(vertices, indices));
+        }
+
+        mesh.AddVertices(vertices.data(), vertices.size());
+        mesh.AddIndices(indices.data(), indices.size());
+        mesh.SetName(assimpMesh->mName.data);
+    }
+
+    void ThirdPartySceneLoader::GenerateTangentSpace(std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices) const
+    {
+        // Accumulate per triangle tangent frames in vertices, then orthonormalize them against vertex normals
+        for (auto i = 0u; i + 2 < indices.size(); i += 3)
+        {
+            Vertex1P1N1UV1T1BT& v0 = vertices[indices[i]];
+            Vertex1P1N1UV1T1BT& v1 = vertices[indices[i + 1]];
+            Vertex1P1N1UV1T1BT& v2 = vertices[indices[i + 2]];
+
+            glm::vec3 edge1 = glm::vec3{ v1.Position - v0.Position };
+            glm::vec3 edge2 = glm::vec3{ v2.Position - v0.Position };
+            glm::vec2 deltaUV1 = v1.UV - v0.UV;
+            glm::vec2 deltaUV2 = v2.UV - v0.UV;
+
+            float determinant = deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y;
 
-            for (auto j = 0u; j < face.mNumIndices; j++) 
+            // Degenerate texture mapping
+            if (std::abs(determinant) <= std::numeric_limits<float>::epsilon())
+                continue;
+
+            float inverseDeterminant = 1.0f / determinant;
+            glm::vec3 tangent = (edge1 * deltaUV2.y - edge2 * deltaUV1.y) * inverseDeterminant;
+            glm::vec3 bitangent = (edge2 * deltaUV1.x - edge1 * deltaUV2.x) * inverseDeterminant;
+
+            for (Vertex1P1N1UV1T1BT* vertex : { &v0, &v1, &v2 })
             {
-                mesh.AddIndex(face.mIndices[j]);
+                vertex->Tangent += tangent;
+                vertex->Bitangent += bitangent;
             }
         }
 
-        mesh.SetName(assimpMesh->mName.data);
+        for (Vertex1P1N1UV1T1BT& vertex : vertices)
+        {
+            glm::vec3 normal = glm::normalize(vertex.Normal);
+            glm::vec3 tangent = vertex.Tangent - normal * glm::dot(normal, vertex.Tangent);
+            glm::vec3 bitangent = vertex.Bitangent - normal * glm::dot(normal, vertex.Bitangent);
+
+            // Vertices of degenerate triangles only get an arbitrary frame around the normal
+            if (glm::length2(tangent) <= std::numeric_limits<float>::epsilon())
+            {
+                glm::vec3 axis = std::abs(normal.x) < 0.9f ? glm::vec3{ 1, 0, 0 } : glm::vec3{ 0, 1, 0 };
+                tangent = glm::cross(axis, normal);
+            }
+
+            tangent = glm::normalize(tangent);
+            bitangent -= tangent * glm::dot(tangent, bitangent);
+
+            if (glm::length2(bitangent) <= std::numeric_limits<float>::epsilon())
+            {
+                bitangent = glm::cross(normal, tangent);
+            }
+
+            vertex.Tangent = tangent;
+            vertex.Bitangent = glm::normalize(bitangent);
+        }
     }
 
     void ThirdPartySceneLoader::ProcessNode(aiNode* node, const aiScene* scene)
@@ -184,8 +275,8 @@ namespace PathFinder
         {
             aiMesh* assimpMesh = scene->mMeshes[node->mMeshes[i]];
             LoadedMesh& loadedMesh = mLoadedMeshes.emplace_back();
-            ProcessMesh(loadedMesh.MeshObject, assimpMesh, scene);
             loadedMesh.MaterialIndex = assimpMesh->mMaterialIndex;
+            mAssimpMeshes.push_back(assimpMesh);
         }
 
         for (auto i = 0u; i < node->mNumChildren; i++)
@@ -3,6 +3,9 @@
 #include "Vertices/Vertex1P1N1UV1T1BT.hpp"
 #include "Mesh.hpp"
 #include "Material.hpp"
+#include "MeshOptimizer.hpp"
+
+#include <Foundation/ThreadPool.hpp>
 
 // Assimp is in conflict with windows.h definitions of min and max
 #ifndef NOMINMAX 
@@ -32,6 +35,16 @@ namespace PathFinder
         struct Settings
         {
             float InitialScale = 1.0;
+
+            // Scene can only be serialized if CPU copies of its textures are kept after upload
+            bool KeepTextureDataForSerialization = false;
+
+            // Material textures are loaded with their mip tails only and streamed in as they are seen.
+            // Ignored when texture data is kept for serialization.
+            bool StreamTextures = false;
+
+            // Reorders triangles and vertices of every mesh for vertex cache reuse, lower overdraw and fetch locality
+            bool OptimizeMeshes = true;
         };
 
         struct LoadedMesh
@@ -42,19 +55,33 @@ namespace PathFinder
 
         std::vector<LoadedMesh>& Load(const std::filesystem::path& path, const Settings& settings = {});
 
+        // Two step import that lets callers schedule their own work (texture reads, for example)
+        // on the same thread pool in between. Materials are available after the first step.
+        void ReadSceneFile(const std::filesystem::path& path, const Settings& settings = {});
+
+        // Converts meshes in parallel, serially if thread pool is null. 
+        // Waits for every task in the pool, not only the ones scheduled here.
+        std::vector<LoadedMesh>& ProcessMeshes(Foundation::ThreadPool* threadPool);
+
     private:
         void ProcessMaterials(const aiScene* scene);
-        void ProcessMesh(Mesh& mesh, aiMesh* assimpMesh, const aiScene* scene);
+        void ProcessMesh(LoadedMesh& loadedMesh, const aiMesh* assimpMesh) const;
         void ProcessNode(aiNode* node, const aiScene* scene);
+        void GenerateTangentSpace(std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<uint32_t>& indices) const;
 
+        Assimp::Importer mImporter;
         std::vector<Material> mLoadedMaterials;
         std::vector<LoadedMesh> mLoadedMeshes;
+
+        // Source of each loaded mesh, valid until meshes are processed
+        std::vector<const aiMesh*> mAssimpMeshes;
         std::filesystem::path mPath;
         std::filesystem::path mDirectory;
         Settings mLoadSettings;
 
     public:
         inline auto& LoadedMaterials() { return mLoadedMaterials; }
+        inline auto& LoadedMeshes() { return mLoadedMeshes; }
     };
 
 }
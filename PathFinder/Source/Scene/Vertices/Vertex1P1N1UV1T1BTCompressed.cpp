@@ -0,0 +1,86 @@
+#include "Vertex1P1N1UV1T1BTCompressed.hpp"
+
+#include <glm/geometric.hpp>
+#include <glm/gtc/packing.hpp>
+
+#include <cmath>
+
+namespace PathFinder
+{
+
+    namespace
+    {
+        // Same bit layout as PackSnorm2x16 in Packing.hlsl, first value in upper half, but rounded to nearest
+        uint32_t PackSnorm2x16(const glm::vec2& value)
+        {
+            glm::vec2 quantized = glm::round(glm::clamp(value, -1.0f, 1.0f) * 32767.0f);
+            return (uint32_t(int32_t(quantized.x)) << 16) | (uint32_t(int32_t(quantized.y)) & 0x0000FFFFu);
+        }
+
+        glm::vec2 UnpackSnorm2x16(uint32_t packed)
+        {
+            return glm::vec2{ int16_t(packed >> 16), int16_t(packed & 0x0000FFFFu) } / 32767.0f;
+        }
+
+        glm::vec2 SignNotZero(const glm::vec2& v)
+        {
+            return { v.x < 0.0f ? -1.0f : 1.0f, v.y < 0.0f ? -1.0f : 1.0f };
+        }
+
+        // Mirrors OctEncode in Packing.hlsl, zero vectors map to the center of the square
+        glm::vec2 OctEncode(const glm::vec3& v)
+        {
+            float l1Norm = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+
+            if (l1Norm <= 0.0f)
+                return glm::vec2{ 0.0f };
+
+            glm::vec2 result = glm::vec2{ v } / l1Norm;
+
+            if (v.z < 0.0f)
+            {
+                result = (1.0f - glm::abs(glm::vec2{ result.y, result.x })) * SignNotZero(result);
+            }
+
+            return result;
+        }
+
+        glm::vec3 OctDecode(const glm::vec2& o)
+        {
+            glm::vec3 v{ o.x, o.y, 1.0f - std::abs(o.x) - std::abs(o.y) };
+
+            if (v.z < 0.0f)
+            {
+                glm::vec2 xy = (1.0f - glm::abs(glm::vec2{ v.y, v.x })) * SignNotZero(glm::vec2{ v });
+                v.x = xy.x;
+                v.y = xy.y;
+            }
+
+            return glm::normalize(v);
+        }
+
+        constexpr uint32_t BitangentSignMask = 1u;
+    }
+
+    Vertex1P1N1UV1T1BTCompressed::Vertex1P1N1UV1T1BTCompressed(const Vertex1P1N1UV1T1BT& vertex)
+        : Position{ vertex.Position }
+    {
+        bool isBitangentFlipped = glm::dot(glm::cross(vertex.Normal, vertex.Tangent), vertex.Bitangent) < 0.0f;
+
+        Normal = PackSnorm2x16(OctEncode(vertex.Normal));
+        Tangent = (PackSnorm2x16(OctEncode(vertex.Tangent)) & ~BitangentSignMask) | (isBitangentFlipped ? BitangentSignMask : 0u);
+        UV = glm::packHalf2x16(vertex.UV);
+    }
+
+    Vertex1P1N1UV1T1BT Vertex1P1N1UV1T1BTCompressed::Decompressed() const
+    {
+        Vertex1P1N1UV1T1BT vertex;
+        vertex.Position = glm::vec4{ Position, 1.0f };
+        vertex.Normal = OctDecode(UnpackSnorm2x16(Normal));
+        vertex.Tangent = OctDecode(UnpackSnorm2x16(Tangent & ~BitangentSignMask));
+        vertex.Bitangent = glm::cross(vertex.Normal, vertex.Tangent) * ((Tangent & BitangentSignMask) ? -1.0f : 1.0f);
+        vertex.UV = glm::unpackHalf2x16(UV);
+        return vertex;
+    }
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Vertex1P1N1UV1T1BT.hpp"
+
+#include <cstdint>
+
+namespace PathFinder
+{
+
+    /**
+     1 position, full precision
+     1 octahedral normal, 2 x 16 bit snorm
+     1 octahedral tangent, 2 x 16 bit snorm, lowest bit is a bitangent sign
+     1 texture coordinate, 2 x half
+     */
+    struct Vertex1P1N1UV1T1BTCompressed
+    {
+        // First and in full precision, ray tracing acceleration structures are built from it
+        glm::vec3 Position;
+        uint32_t Normal;
+        uint32_t Tangent;
+        uint32_t UV;
+
+        Vertex1P1N1UV1T1BTCompressed() = default;
+
+        // Bitangent is reconstructed as cross(normal, tangent) with its original orientation
+        Vertex1P1N1UV1T1BTCompressed(const Vertex1P1N1UV1T1BT& vertex);
+
+        // CPU counterpart of DecompressVertex in Vertices.hlsl
+        Vertex1P1N1UV1T1BT Decompressed() const;
+    };
+
+    static_assert(sizeof(Vertex1P1N1UV1T1BTCompressed) == 24, "Compressed vertex layout must match Vertices.hlsl");
+
+}
@@ -106,6 +106,11 @@ namespace PathFinder
 
     void PickedEntityViewModel::Export()
     {
+        // Avoid touching entities when gizmo didn't change anything
+        // to not invalidate their GPU data every frame
+        if (mModifiedModelMatrix == mModelMatrix)
+            return;
+
         if (mMeshInstance)
         {
             mMeshInstance->SetTransformation(Geometry::Transformation{ mModifiedModelMatrix });
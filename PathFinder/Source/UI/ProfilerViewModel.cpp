@@ -14,7 +14,7 @@ namespace PathFinder
         {
             std::stringstream ss;
             ss << std::setprecision(3) << std::fixed << measurement.DurationSeconds * 1000;
-            return ss.str() + " ms " + measurement.Name;
+            return ss.str() + " ms " + measurement.Name.ToString();
         };
 
         mFrameMeasurementString = constructMeasurementString(Dependencies->Device->FrameMeasurement());
@@ -18,6 +18,7 @@ namespace PathFinder
         ImGui::Checkbox("Enable Memory Aliasing", &VM->RenderPipelineSettings()->IsMemoryAliasingEnabled);
         ImGui::Checkbox("Enable Async Compute", &VM->RenderPipelineSettings()->IsAsyncComputeEnabled);
         ImGui::Checkbox("Enable Split Barriers", &VM->RenderPipelineSettings()->IsSplitBarriersEnabled);
+        ImGui::Checkbox("Enable Multi-Threaded Recording", &VM->RenderPipelineSettings()->IsMultiThreadedRecordingEnabled);
 
         bool isStatePowerStateEnabled = VM->IsStablePowerStateEnabled();
         if (ImGui::Checkbox("Enable Stable Power State (Windows Dev. mode required)", &isStatePowerStateEnabled))
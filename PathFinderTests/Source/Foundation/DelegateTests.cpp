@@ -0,0 +1,272 @@
+#include "../Testing.hpp"
+
+#include <Foundation/Delegate.hpp>
+#include <Foundation/Event.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <array>
+
+namespace
+{
+
+    using SmallDelegate = Foundation::Delegate<uint64_t(uint64_t)>;
+
+    // Counts live copies of a callable, so that leaks and double destruction show up
+    struct LifetimeCounter
+    {
+        static inline int64_t AliveCount = 0;
+
+        LifetimeCounter() { ++AliveCount; }
+        LifetimeCounter(const LifetimeCounter&) { ++AliveCount; }
+        LifetimeCounter(LifetimeCounter&&) noexcept { ++AliveCount; }
+        ~LifetimeCounter() { --AliveCount; }
+    };
+
+    // Returns address of its own captures, which tells where the callable is stored
+    template <size_t CaptureSize>
+    auto MakeAddressReporter()
+    {
+        return [counter = LifetimeCounter{}, capture = std::array<uint8_t, CaptureSize>{}](uint64_t) mutable
+        {
+            return (uint64_t)(uintptr_t)capture.data();
+        };
+    }
+
+    template <class DelegateT>
+    bool IsInsideDelegate(const DelegateT& delegate, uint64_t address)
+    {
+        uint64_t delegateAddress = (uint64_t)(uintptr_t)&delegate;
+        return address >= delegateAddress && address < delegateAddress + sizeof(DelegateT);
+    }
+
+    class Publisher
+    {
+    public:
+        using ValueEvent = Foundation::Event<Publisher, std::string, void(uint64_t)>;
+
+        void Publish(uint64_t value) { mEvent(value); }
+
+    private:
+        ValueEvent mEvent;
+
+    public:
+        inline ValueEvent& Event() { return mEvent; }
+    };
+
+    // Subscriber with a member function handler
+    struct Recorder
+    {
+        std::vector<std::string>* Log = nullptr;
+        std::string Name;
+
+        void Receive(uint64_t value) { Log->push_back(Name + std::to_string(value)); }
+    };
+
+}
+
+PF_TEST(DelegateStoresSmallCallablesInline)
+{
+    {
+        SmallDelegate delegate = MakeAddressReporter<16>();
+
+        PF_CHECK(SmallDelegate::IsStoredInline<decltype(MakeAddressReporter<16>())>);
+        PF_CHECK(IsInsideDelegate(delegate, delegate(0)), "Small callable was not stored inline");
+        PF_CHECK(LifetimeCounter::AliveCount == 1, "Alive: ", LifetimeCounter::AliveCount);
+
+        // Inline callables are relocated with the delegate
+        SmallDelegate moved = std::move(delegate);
+
+        PF_CHECK(!delegate && moved);
+        PF_CHECK(IsInsideDelegate(moved, moved(0)));
+        PF_CHECK(LifetimeCounter::AliveCount == 1, "Alive after move: ", LifetimeCounter::AliveCount);
+
+        moved = nullptr;
+
+        PF_CHECK(!moved && LifetimeCounter::AliveCount == 0, "Alive after reset: ", LifetimeCounter::AliveCount);
+    }
+
+    // Callables with a throwing move constructor stay on the heap to keep moves noexcept
+    struct ThrowingMove
+    {
+        ThrowingMove() = default;
+        ThrowingMove(ThrowingMove&&) noexcept(false) {}
+        uint64_t operator()(uint64_t value) const { return value; }
+    };
+
+    PF_CHECK(!SmallDelegate::IsStoredInline<ThrowingMove>);
+    PF_CHECK(LifetimeCounter::AliveCount == 0);
+}
+
+PF_TEST(DelegateFallsBackToHeapForLargeCallables)
+{
+    {
+        SmallDelegate delegate = MakeAddressReporter<256>();
+        uint64_t captureAddress = delegate(0);
+
+        PF_CHECK(!SmallDelegate::IsStoredInline<decltype(MakeAddressReporter<256>())>);
+        PF_CHECK(!IsInsideDelegate(delegate, captureAddress), "Large callable was stored inline");
+
+        // Heap callables are not moved, only the pointer to them is
+        SmallDelegate moved = std::move(delegate);
+
+        PF_CHECK(moved(0) == captureAddress);
+        PF_CHECK(LifetimeCounter::AliveCount == 1, "Alive after move: ", LifetimeCounter::AliveCount);
+
+        // Assignment destroys the callable held before
+        moved = MakeAddressReporter<8>();
+
+        PF_CHECK(LifetimeCounter::AliveCount == 1, "Alive after reassignment: ", LifetimeCounter::AliveCount);
+        PF_CHECK(IsInsideDelegate(moved, moved(0)));
+    }
+
+    PF_CHECK(LifetimeCounter::AliveCount == 0, "Leaked: ", LifetimeCounter::AliveCount);
+
+    // Inline size is a template parameter
+    using TinyDelegate = Foundation::Delegate<uint64_t(uint64_t), 8>;
+    TinyDelegate tiny = MakeAddressReporter<16>();
+
+    PF_CHECK(!IsInsideDelegate(tiny, tiny(0)));
+}
+
+PF_TEST(DelegateAcceptsMoveOnlyCaptures)
+{
+    auto value = std::make_unique<uint64_t>(42);
+
+    Foundation::Delegate<uint64_t(uint64_t)> delegate = [value = std::move(value)](uint64_t add) { return *value + add; };
+    PF_CHECK(delegate(1) == 43);
+
+    std::vector<Foundation::Delegate<uint64_t(uint64_t)>> delegates;
+
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        delegates.emplace_back([owned = std::make_unique<uint64_t>(i)](uint64_t add) { return *owned + add; });
+    }
+
+    // Vector growth relocates delegates holding unique pointers
+    delegates.push_back(std::move(delegate));
+
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        PF_CHECK(delegates[i](1000) == 1000 + i, "Delegate ", i, " returned ", delegates[i](1000));
+    }
+
+    PF_CHECK(delegates.back()(0) == 42);
+
+    // Move-only arguments and results are forwarded
+    Foundation::Delegate<std::unique_ptr<uint64_t>(std::unique_ptr<uint64_t>)> passThrough = [](std::unique_ptr<uint64_t> pointer)
+    {
+        ++*pointer;
+        return pointer;
+    };
+
+    std::unique_ptr<uint64_t> result = passThrough(std::make_unique<uint64_t>(7));
+    PF_CHECK(result && *result == 8);
+
+    // Mutable callables keep their state between invocations
+    Foundation::Delegate<uint64_t()> counter = [count = uint64_t(0)]() mutable { return ++count; };
+    counter();
+    counter();
+    PF_CHECK(counter() == 3);
+}
+
+PF_TEST(EventRaisesInSubscriptionOrder)
+{
+    Publisher publisher;
+    std::vector<std::string> log;
+    Recorder first{ &log, "A" };
+    Recorder second{ &log, "B" };
+
+    publisher.Event() += { "A", &first, &Recorder::Receive };
+    publisher.Event() += { "B", &second, &Recorder::Receive };
+    publisher.Event() += { "C", [&log](uint64_t value) { log.push_back("C" + std::to_string(value)); } };
+
+    publisher.Publish(1);
+    PF_CHECK((log == std::vector<std::string>{ "A1", "B1", "C1" }));
+
+    // Resubscribing a key replaces its handler in place
+    log.clear();
+    publisher.Event() += { "A", [&log](uint64_t value) { log.push_back("A'" + std::to_string(value)); } };
+    publisher.Publish(2);
+
+    PF_CHECK((log == std::vector<std::string>{ "A'2", "B2", "C2" }));
+    PF_CHECK(publisher.Event().Size() == 3);
+
+    // Unsubscribing keeps the order of the rest, new subscribers go last
+    log.clear();
+    publisher.Event() -= std::string{ "B" };
+    publisher.Event() += { "D", [&log](uint64_t value) { log.push_back("D" + std::to_string(value)); } };
+    publisher.Event() += { "B", &second, &Recorder::Receive };
+    publisher.Publish(3);
+
+    PF_CHECK((log == std::vector<std::string>{ "A'3", "C3", "D3", "B3" }));
+
+    // Many subscribers with move-only state
+    log.clear();
+    publisher.Event().Clear();
+
+    for (uint64_t i = 0; i < 50; ++i)
+    {
+        publisher.Event() += { std::to_string(i), [&log, id = std::make_unique<uint64_t>(i)](uint64_t value) { log.push_back(std::to_string(*id + value)); } };
+    }
+
+    publisher.Publish(1000);
+
+    bool isOrdered = log.size() == 50;
+
+    for (uint64_t i = 0; isOrdered && i < 50; ++i)
+    {
+        isOrdered = log[i] == std::to_string(1000 + i);
+    }
+
+    PF_CHECK(isOrdered, "Subscribers raised out of order");
+}
+
+PF_BENCHMARK(DelegateConstructionAndInvocation)
+{
+    constexpr uint64_t CallableCount = 1'000'000;
+
+    auto measure = [](const std::string& name, auto makeCallable)
+    {
+        std::vector<Foundation::Delegate<uint64_t(uint64_t)>> delegates;
+        std::vector<std::function<uint64_t(uint64_t)>> functions;
+        delegates.reserve(CallableCount);
+        functions.reserve(CallableCount);
+
+        Testing::Stopwatch delegateConstruction;
+        for (uint64_t i = 0; i < CallableCount; ++i) delegates.emplace_back(makeCallable(i));
+        double delegateConstructionMs = delegateConstruction.ElapsedMilliseconds();
+
+        Testing::Stopwatch functionConstruction;
+        for (uint64_t i = 0; i < CallableCount; ++i) functions.emplace_back(makeCallable(i));
+        double functionConstructionMs = functionConstruction.ElapsedMilliseconds();
+
+        uint64_t delegateSum = 0;
+        Testing::Stopwatch delegateInvocation;
+        for (const auto& delegate : delegates) delegateSum += delegate(delegateSum);
+        double delegateInvocationMs = delegateInvocation.ElapsedMilliseconds();
+
+        uint64_t functionSum = 0;
+        Testing::Stopwatch functionInvocation;
+        for (const auto& function : functions) functionSum += function(functionSum);
+        double functionInvocationMs = functionInvocation.ElapsedMilliseconds();
+
+        PF_CHECK(delegateSum == functionSum);
+
+        Testing::Report(name + ", Delegate construction", delegateConstructionMs * 1e6 / CallableCount, "ns");
+        Testing::Report(name + ", std::function construction", functionConstructionMs * 1e6 / CallableCount, "ns");
+        Testing::Report(name + ", Delegate invocation", delegateInvocationMs * 1e6 / CallableCount, "ns");
+        Testing::Report(name + ", std::function invocation", functionInvocationMs * 1e6 / CallableCount, "ns");
+    };
+
+    measure("8 byte capture", [](uint64_t i) { return [i](uint64_t x) { return x ^ i; }; });
+    measure("32 byte capture", [](uint64_t i) { return [a = i, b = i + 1, c = i + 2, d = i + 3](uint64_t x) { return x ^ (a + b + c + d); }; });
+    measure("128 byte capture", [](uint64_t i)
+    {
+        std::array<uint64_t, 16> values{};
+        values[i % 16] = i;
+        return [values](uint64_t x) { return x ^ values[x % 16]; };
+    });
+}
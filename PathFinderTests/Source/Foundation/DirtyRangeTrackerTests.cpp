@@ -0,0 +1,250 @@
+#include "../Testing.hpp"
+
+#include <Foundation/DirtyRangeTracker.hpp>
+#include <Scene/MeshInstance.hpp>
+
+#include <random>
+#include <vector>
+#include <optional>
+#include <algorithm>
+
+namespace
+{
+
+    using Foundation::DirtyRangeTracker;
+    using PathFinder::MeshInstance;
+
+    bool AreSameRanges(const std::vector<DirtyRangeTracker::Range>& ranges, const std::vector<DirtyRangeTracker::Range>& expectedRanges)
+    {
+        return std::equal(ranges.begin(), ranges.end(), expectedRanges.begin(), expectedRanges.end(), [](const auto& first, const auto& second)
+        {
+            return first.Start == second.Start && first.Count == second.Count;
+        });
+    }
+
+    // Table entry that stores previous transform, as GPUMeshInstanceTableEntry does
+    struct InstanceEntry
+    {
+        glm::mat4 Transform{ 1.0f };
+        glm::mat4 PreviousTransform{ 1.0f };
+
+        bool operator==(const InstanceEntry& that) const { return Transform == that.Transform && PreviousTransform == that.PreviousTransform; }
+    };
+
+    // Upload buffer that gets brought up to date from the CPU table once every few frames,
+    // as upload buffers of frames in flight do
+    struct UploadBufferCopy
+    {
+        std::vector<InstanceEntry> Entries;
+        std::optional<uint64_t> ContentFrameNumber;
+        uint64_t WrittenEntryCount = 0;
+
+        void Update(const std::vector<InstanceEntry>& table, const DirtyRangeTracker& tracker, uint64_t frameNumber)
+        {
+            Entries.resize(table.size());
+
+            for (const DirtyRangeTracker::Range& range : tracker.DirtyRangesSince(ContentFrameNumber))
+            {
+                std::copy_n(table.begin() + range.Start, range.Count, Entries.begin() + range.Start);
+                WrittenEntryCount += range.Count;
+            }
+
+            ContentFrameNumber = frameNumber;
+        }
+    };
+
+    // Mirrors frame order of the application: previous frame values are updated first,
+    // then the scene changes, then changed instances are written to the table
+    class InstanceScene
+    {
+    public:
+        InstanceScene(uint64_t instanceCount, uint64_t frameNumber)
+        {
+            mInstances.resize(instanceCount, MeshInstance{ nullptr, nullptr });
+            mTable.resize(instanceCount);
+            mTracker.Reset(instanceCount, frameNumber);
+            Upload(frameNumber);
+        }
+
+        void BeginFrame()
+        {
+            for (MeshInstance& instance : mInstances)
+            {
+                instance.UpdatePreviousFrameValues();
+            }
+        }
+
+        void Move(uint64_t instanceIdx, const glm::vec3& translation)
+        {
+            Geometry::Transformation transformation = mInstances[instanceIdx].GetTransformation();
+            transformation.SetTranslation(translation);
+            mInstances[instanceIdx].SetTransformation(transformation);
+        }
+
+        void Upload(uint64_t frameNumber)
+        {
+            for (uint64_t instanceIdx = 0; instanceIdx < mInstances.size(); ++instanceIdx)
+            {
+                MeshInstance& instance = mInstances[instanceIdx];
+
+                if (instance.IsGPUDataDirty())
+                {
+                    mTable[instanceIdx] = { instance.GetTransformation().GetMatrix(), instance.GetPreviousTransformation().GetMatrix() };
+                    mTracker.MarkDirty(instanceIdx, frameNumber);
+                    instance.SetIsGPUDataDirty(false);
+                }
+            }
+        }
+
+        const std::vector<InstanceEntry>& Table() const { return mTable; }
+        const DirtyRangeTracker& Tracker() const { return mTracker; }
+
+    private:
+        std::vector<MeshInstance> mInstances;
+        std::vector<InstanceEntry> mTable;
+        DirtyRangeTracker mTracker{ 8 };
+    };
+
+}
+
+PF_TEST(DirtyRangeTrackerMergesRanges)
+{
+    DirtyRangeTracker tracker;
+    tracker.Reset(32, 0);
+
+    // Unsorted, repeated and adjacent indices spread over several frames
+    for (uint64_t index : { 7, 5, 6, 7, 20 })
+    {
+        tracker.MarkDirty(index, 1);
+    }
+
+    for (uint64_t index : { 3, 8, 21, 31 })
+    {
+        tracker.MarkDirty(index, 2);
+    }
+
+    std::vector<DirtyRangeTracker::Range> expectedSinceReset{ { 3, 1 }, { 5, 4 }, { 20, 2 }, { 31, 1 } };
+    std::vector<DirtyRangeTracker::Range> expectedSinceFirstFrame{ { 3, 1 }, { 8, 1 }, { 21, 1 }, { 31, 1 } };
+
+    PF_CHECK(AreSameRanges(tracker.DirtyRangesSince(0), expectedSinceReset));
+    PF_CHECK(AreSameRanges(tracker.DirtyRangesSince(1), expectedSinceFirstFrame));
+    PF_CHECK(tracker.DirtyRangesSince(2).empty());
+    PF_CHECK(tracker.DirtyRangesSince(5).empty());
+
+    // Every element modified merges into a single range
+    for (uint64_t index = 0; index < 32; ++index)
+    {
+        tracker.MarkDirty(31 - index, 3);
+    }
+
+    std::vector<DirtyRangeTracker::Range> expectedWholeArray{ { 0, 32 } };
+
+    PF_CHECK(AreSameRanges(tracker.DirtyRangesSince(2), expectedWholeArray));
+}
+
+PF_TEST(DirtyRangeTrackerClearsHistory)
+{
+    DirtyRangeTracker tracker{ 4 };
+    std::vector<DirtyRangeTracker::Range> expectedWholeArray{ { 0, 100 } };
+
+    PF_CHECK(tracker.DirtyRangesSince(std::nullopt).empty(), "Empty array has nothing to rewrite");
+
+    tracker.Reset(100, 10);
+
+    // Copies of unknown state or made before reset are rewritten entirely
+    PF_CHECK(AreSameRanges(tracker.DirtyRangesSince(std::nullopt), expectedWholeArray));
+    PF_CHECK(AreSameRanges(tracker.DirtyRangesSince(9), expectedWholeArray));
+    PF_CHECK(tracker.DirtyRangesSince(10).empty());
+
+    for (uint64_t frameNumber = 11; frameNumber <= 16; ++frameNumber)
+    {
+        tracker.MarkDirty(frameNumber, frameNumber);
+    }
+
+    // Only last 4 frames are remembered, older copies are rewritten entirely
+    std::vector<DirtyRangeTracker::Range> expectedSinceTrackedFrame{ { 13, 4 } };
+
+    PF_CHECK(AreSameRanges(tracker.DirtyRangesSince(11), expectedWholeArray));
+    PF_CHECK(AreSameRanges(tracker.DirtyRangesSince(12), expectedSinceTrackedFrame));
+    PF_CHECK(tracker.DirtyRangesSince(16).empty());
+
+    // Reset forgets modifications
+    tracker.Reset(50, 17);
+
+    std::vector<DirtyRangeTracker::Range> expectedResizedArray{ { 0, 50 } };
+
+    PF_CHECK(tracker.ElementCount() == 50);
+    PF_CHECK(AreSameRanges(tracker.DirtyRangesSince(16), expectedResizedArray));
+    PF_CHECK(tracker.DirtyRangesSince(17).empty());
+}
+
+PF_TEST(DirtyRangeTrackerUploadsPreviousTransformOneMoreFrame)
+{
+    constexpr uint64_t InstanceIdx = 3;
+
+    InstanceScene scene{ 8, 0 };
+    std::vector<DirtyRangeTracker::Range> expectedRanges{ { InstanceIdx, 1 } };
+
+    // Instance moves in frame 1 only
+    scene.BeginFrame();
+    scene.Move(InstanceIdx, glm::vec3{ 1.0f, 2.0f, 3.0f });
+    scene.Upload(1);
+
+    PF_CHECK(AreSameRanges(scene.Tracker().DirtyRangesSince(0), expectedRanges));
+    PF_CHECK(scene.Table()[InstanceIdx].Transform != scene.Table()[InstanceIdx].PreviousTransform);
+
+    // Next frame previous transform catches up with the current one and is written again
+    scene.BeginFrame();
+    scene.Upload(2);
+
+    PF_CHECK(AreSameRanges(scene.Tracker().DirtyRangesSince(1), expectedRanges), "Previous transform must be rewritten in the frame after a move");
+    PF_CHECK(scene.Table()[InstanceIdx].Transform == scene.Table()[InstanceIdx].PreviousTransform);
+
+    // After that the instance is clean
+    scene.BeginFrame();
+    scene.Upload(3);
+
+    PF_CHECK(scene.Tracker().DirtyRangesSince(2).empty());
+}
+
+PF_TEST(DirtyRangeTrackerKeepsLaggingCopiesUpToDate)
+{
+    // Instances move at random while three upload buffers are refreshed in turns.
+    // Every buffer must match the table right after its refresh, while writing far less than the whole table.
+    constexpr uint64_t InstanceCount = 1000;
+    constexpr uint64_t FrameCount = 300;
+
+    std::mt19937 rng{ 17 };
+    InstanceScene scene{ InstanceCount, 0 };
+    std::vector<UploadBufferCopy> uploadBuffers(3);
+    uint64_t mismatchCount = 0;
+
+    for (uint64_t frameNumber = 1; frameNumber <= FrameCount; ++frameNumber)
+    {
+        scene.BeginFrame();
+
+        uint64_t moveCount = rng() % 20;
+
+        for (uint64_t moveIdx = 0; moveIdx < moveCount; ++moveIdx)
+        {
+            scene.Move(rng() % InstanceCount, glm::vec3{ float(rng() % 100), float(frameNumber), 0.0f });
+        }
+
+        scene.Upload(frameNumber);
+
+        UploadBufferCopy& uploadBuffer = uploadBuffers[frameNumber % uploadBuffers.size()];
+        uploadBuffer.Update(scene.Table(), scene.Tracker(), frameNumber);
+
+        mismatchCount += uploadBuffer.Entries != scene.Table();
+    }
+
+    uint64_t writtenEntryCount = 0;
+
+    for (const UploadBufferCopy& uploadBuffer : uploadBuffers)
+    {
+        writtenEntryCount += uploadBuffer.WrittenEntryCount;
+    }
+
+    PF_CHECK(mismatchCount == 0, "Outdated upload buffers: ", mismatchCount);
+    PF_CHECK(writtenEntryCount < InstanceCount * FrameCount / 10, "Written entries: ", writtenEntryCount);
+}
@@ -0,0 +1,251 @@
+#include "../Testing.hpp"
+
+#include <Foundation/LZ4.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+
+    namespace LZ4 = Foundation::LZ4;
+
+    constexpr uint8_t GuardByte = 0xCD;
+    constexpr uint64_t GuardSize = 64;
+
+    // Inputs that exercise literal-only blocks, length tails, overlapping matches and the end of block rules
+    std::vector<std::vector<uint8_t>> RoundTripInputs()
+    {
+        std::mt19937 rng{ 21 };
+        std::vector<std::vector<uint8_t>> inputs;
+
+        for (uint64_t size : { 0, 1, 5, 12, 13, 14, 15, 16, 300 })
+        {
+            std::vector<uint8_t>& input = inputs.emplace_back(size);
+            std::generate(input.begin(), input.end(), [&rng] { return uint8_t(rng()); });
+        }
+
+        // Runs of a single byte become matches with an offset of 1
+        inputs.emplace_back(100000, uint8_t(7));
+
+        // Short periods produce matches that overlap their own output
+        for (uint64_t period : { 2, 3, 7, 19 })
+        {
+            std::vector<uint8_t>& input = inputs.emplace_back();
+
+            for (uint64_t i = 0; i < 5000; ++i)
+            {
+                input.push_back(uint8_t(i % period));
+            }
+        }
+
+        // Incompressible data stays literal, with long literal length tails
+        std::vector<uint8_t>& noise = inputs.emplace_back(70000);
+        std::generate(noise.begin(), noise.end(), [&rng] { return uint8_t(rng()); });
+
+        // Text-like data with repeats both within and beyond the 64 KiB window
+        std::vector<uint8_t>& text = inputs.emplace_back();
+        const char* words[] = { "vertex ", "index ", "mip ", "texture ", "block ", "container ", "\n" };
+
+        while (text.size() < 300000)
+        {
+            std::string word = words[rng() % 7];
+            text.insert(text.end(), word.begin(), word.end());
+            text.push_back(uint8_t('0' + rng() % 10));
+        }
+
+        // Float vertex data, as scene container blocks mostly hold
+        std::vector<uint8_t>& vertices = inputs.emplace_back();
+
+        for (uint32_t i = 0; i < 20000; ++i)
+        {
+            float components[] = { float(i % 100), float(i / 100), 0.0f, 1.0f, 0.0f, 0.0f, 1.0f };
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(components);
+            vertices.insert(vertices.end(), bytes, bytes + sizeof(components));
+        }
+
+        return inputs;
+    }
+
+    // Decompresses into a buffer followed by guard bytes, which must stay untouched whatever the input is
+    bool GuardedDecompress(const std::vector<uint8_t>& compressed, uint64_t destinationSize, std::vector<uint8_t>& destination, bool& isOverrun)
+    {
+        destination.assign(destinationSize + GuardSize, GuardByte);
+
+        // Exactly sized copy, so that reads past the end are caught by the address sanitizer and debug heaps
+        std::vector<uint8_t> source{ compressed };
+        bool isDecoded = LZ4::Decompress(source.data(), source.size(), destination.data(), destinationSize);
+
+        isOverrun = std::any_of(destination.begin() + destinationSize, destination.end(), [](uint8_t byte) { return byte != GuardByte; });
+        destination.resize(destinationSize);
+
+        return isDecoded;
+    }
+
+}
+
+PF_TEST(LZ4RoundTrip)
+{
+    std::vector<uint8_t> decompressed;
+    bool isOverrun = false;
+
+    for (const std::vector<uint8_t>& input : RoundTripInputs())
+    {
+        std::vector<uint8_t> compressed = LZ4::Compress(input.data(), input.size());
+
+        PF_CHECK(compressed.size() <= LZ4::CompressBound(input.size()), "Size: ", input.size(), " Compressed: ", compressed.size());
+        PF_CHECK(GuardedDecompress(compressed, input.size(), decompressed, isOverrun), "Size: ", input.size());
+        PF_CHECK(decompressed == input, "Size: ", input.size());
+        PF_CHECK(!isOverrun, "Size: ", input.size());
+
+        // Destination of a wrong size is an error rather than a partial or overflowing decode
+        if (!input.empty())
+        {
+            PF_CHECK(!GuardedDecompress(compressed, input.size() - 1, decompressed, isOverrun), "Size: ", input.size());
+            PF_CHECK(!isOverrun, "Size: ", input.size());
+        }
+
+        PF_CHECK(!GuardedDecompress(compressed, input.size() + 1, decompressed, isOverrun), "Size: ", input.size());
+        PF_CHECK(!isOverrun, "Size: ", input.size());
+    }
+
+    // Repetitive data must actually shrink
+    std::vector<uint8_t> run(100000, uint8_t(7));
+    PF_CHECK(LZ4::Compress(run.data(), run.size()).size() < run.size() / 100);
+}
+
+PF_TEST(LZ4RejectsTruncatedInput)
+{
+    std::vector<uint8_t> decompressed;
+    bool isOverrun = false;
+
+    for (const std::vector<uint8_t>& input : RoundTripInputs())
+    {
+        if (input.empty() || input.size() > 20000)
+            continue;
+
+        std::vector<uint8_t> compressed = LZ4::Compress(input.data(), input.size());
+
+        for (uint64_t truncatedSize = 0; truncatedSize < compressed.size(); ++truncatedSize)
+        {
+            std::vector<uint8_t> truncated{ compressed.begin(), compressed.begin() + truncatedSize };
+
+            PF_CHECK(!GuardedDecompress(truncated, input.size(), decompressed, isOverrun), "Size: ", input.size(), " Truncated to: ", truncatedSize);
+            PF_CHECK(!isOverrun, "Size: ", input.size(), " Truncated to: ", truncatedSize);
+        }
+    }
+}
+
+PF_TEST(LZ4RejectsMalformedInput)
+{
+    std::vector<uint8_t> decompressed;
+    bool isOverrun = false;
+
+    // Token with 4 literals and a match, followed by an offset
+    auto sequence = [](uint16_t offset, uint8_t matchNibble) -> std::vector<uint8_t>
+    {
+        return { uint8_t(0x40 | matchNibble), 'a', 'b', 'c', 'd', uint8_t(offset & 0xFF), uint8_t(offset >> 8) };
+    };
+
+    // Offset of zero
+    PF_CHECK(!GuardedDecompress(sequence(0, 0), 8, decompressed, isOverrun));
+    PF_CHECK(!isOverrun);
+
+    // Offset reaching before the start of output
+    PF_CHECK(!GuardedDecompress(sequence(5, 0), 8, decompressed, isOverrun));
+    PF_CHECK(!isOverrun);
+
+    // Match longer than the remaining output
+    PF_CHECK(!GuardedDecompress(sequence(4, 10), 10, decompressed, isOverrun));
+    PF_CHECK(!isOverrun);
+
+    // Literal count past the end of input
+    PF_CHECK(!GuardedDecompress({ 0x50, 'a', 'b' }, 5, decompressed, isOverrun));
+    PF_CHECK(!isOverrun);
+
+    // Literal length tail that never terminates
+    PF_CHECK(!GuardedDecompress({ 0xF0, 255, 255, 255 }, 1000, decompressed, isOverrun));
+    PF_CHECK(!isOverrun);
+
+    // Match length tail that never terminates
+    std::vector<uint8_t> unterminatedMatch = sequence(4, 15);
+    unterminatedMatch.insert(unterminatedMatch.end(), { 255, 255 });
+    PF_CHECK(!GuardedDecompress(unterminatedMatch, 1000, decompressed, isOverrun));
+    PF_CHECK(!isOverrun);
+
+    // Literals larger than destination
+    PF_CHECK(!GuardedDecompress({ 0x40, 'a', 'b', 'c', 'd' }, 3, decompressed, isOverrun));
+    PF_CHECK(!isOverrun);
+
+    // Random garbage and corrupted valid blocks must never write past destination
+    std::mt19937 rng{ 33 };
+    std::vector<uint8_t> original(4096);
+    std::generate(original.begin(), original.end(), [&rng] { return uint8_t('a' + rng() % 4); });
+    std::vector<uint8_t> compressed = LZ4::Compress(original.data(), original.size());
+    uint64_t overrunCount = 0;
+
+    for (uint64_t iteration = 0; iteration < 20000; ++iteration)
+    {
+        std::vector<uint8_t> input;
+
+        if (iteration % 2 == 0)
+        {
+            input.resize(1 + rng() % 64);
+            std::generate(input.begin(), input.end(), [&rng] { return uint8_t(rng()); });
+        }
+        else
+        {
+            input = compressed;
+            uint64_t flipCount = 1 + rng() % 4;
+
+            for (uint64_t flip = 0; flip < flipCount; ++flip)
+            {
+                input[rng() % input.size()] = uint8_t(rng());
+            }
+        }
+
+        GuardedDecompress(input, original.size(), decompressed, isOverrun);
+        overrunCount += isOverrun;
+    }
+
+    PF_CHECK(overrunCount == 0, "Overruns: ", overrunCount);
+}
+
+PF_BENCHMARK(LZ4Throughput)
+{
+    for (const std::vector<uint8_t>& input : RoundTripInputs())
+    {
+        if (input.size() < 100000)
+            continue;
+
+        constexpr uint64_t RepeatCount = 20;
+
+        std::vector<uint8_t> compressed;
+        std::vector<uint8_t> decompressed(input.size());
+
+        Testing::Stopwatch compressionStopwatch;
+
+        for (uint64_t repeat = 0; repeat < RepeatCount; ++repeat)
+        {
+            compressed = LZ4::Compress(input.data(), input.size());
+        }
+
+        double compressionMilliseconds = compressionStopwatch.ElapsedMilliseconds() / RepeatCount;
+        Testing::Stopwatch decompressionStopwatch;
+
+        for (uint64_t repeat = 0; repeat < RepeatCount; ++repeat)
+        {
+            LZ4::Decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size());
+        }
+
+        double decompressionMilliseconds = decompressionStopwatch.ElapsedMilliseconds() / RepeatCount;
+        double megabytes = input.size() / 1e6;
+        std::string name = std::to_string(input.size()) + " bytes";
+
+        Testing::Report(name + " ratio", double(input.size()) / compressed.size(), "x");
+        Testing::Report(name + " compression", megabytes / compressionMilliseconds * 1000.0, "MB/s");
+        Testing::Report(name + " decompression", megabytes / decompressionMilliseconds * 1000.0, "MB/s");
+    }
+}
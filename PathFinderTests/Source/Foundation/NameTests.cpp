@@ -0,0 +1,197 @@
+#include "../Testing.hpp"
+
+#include <Foundation/Name.hpp>
+
+#include <random>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+
+    using Foundation::Name;
+
+    // Resource and pass names as render graph declares them
+    std::vector<std::string> MakeNameStrings(const std::string& prefix, uint64_t count)
+    {
+        std::vector<std::string> strings;
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            strings.push_back(prefix + "Resource_" + std::to_string(i));
+        }
+
+        return strings;
+    }
+
+    constexpr Name::ID CompileTimeId = Name::Hash("GBufferAlbedoMetalness");
+    static_assert(CompileTimeId != Name::INVALID_ID, "Invalid identifier must stay reserved");
+
+}
+
+PF_TEST(NameMatchesCompileTimeHash)
+{
+    Name literalName{ "GBufferAlbedoMetalness" };
+    std::string string = "GBufferAlbedoMetalness";
+
+    PF_CHECK(literalName.ToId() == CompileTimeId);
+    PF_CHECK(Name{ string } == literalName && Name{ std::string_view{ string } } == literalName);
+    PF_CHECK(literalName.ToString() == string);
+    PF_CHECK(!Name{}.IsValid() && literalName.IsValid());
+    PF_CHECK(!(Name{ "GBufferNormalRoughness" } == literalName));
+}
+
+PF_TEST(NameRegistryIsThreadSafe)
+{
+    constexpr uint64_t ThreadCount = 8;
+
+    // Every thread registers shared names in its own order and names nobody else uses
+    std::vector<std::string> sharedStrings = MakeNameStrings("Shared", 5000);
+    std::vector<std::vector<std::string>> privateStrings;
+    std::atomic<uint64_t> mismatchCount = 0;
+    std::vector<std::thread> threads;
+
+    for (uint64_t threadIdx = 0; threadIdx < ThreadCount; ++threadIdx)
+    {
+        privateStrings.push_back(MakeNameStrings("Thread" + std::to_string(threadIdx), 2000));
+    }
+
+    for (uint64_t threadIdx = 0; threadIdx < ThreadCount; ++threadIdx)
+    {
+        threads.emplace_back([&, threadIdx]
+        {
+            std::vector<const std::string*> strings;
+
+            for (const std::string& string : sharedStrings) strings.push_back(&string);
+            for (const std::string& string : privateStrings[threadIdx]) strings.push_back(&string);
+
+            std::mt19937 rng{ (uint32_t)threadIdx };
+            std::shuffle(strings.begin(), strings.end(), rng);
+
+            // Strings are read back while other threads keep inserting
+            for (uint64_t round = 0; round < 3; ++round)
+            {
+                for (const std::string* string : strings)
+                {
+                    Name name{ *string };
+                    mismatchCount += name.ToId() != Name::Hash(*string) || name.ToString() != *string;
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    PF_CHECK(mismatchCount == 0, mismatchCount.load(), " names didn't round trip");
+
+    // Names registered on other threads are visible here
+    for (const std::vector<std::string>& strings : privateStrings)
+    {
+        for (const std::string& string : strings)
+        {
+            PF_CHECK(Name{ Name::Hash(string) }.ToString() == string, "Lost name ", string);
+        }
+    }
+}
+
+PF_BENCHMARK(NameLookup)
+{
+    constexpr uint64_t LookupCount = 2'000'000;
+
+    std::vector<std::string> strings = MakeNameStrings("Lookup", 1000);
+    std::vector<Name> names(strings.begin(), strings.end());
+
+    // Construction of names that were registered before, as passes do every frame
+    uint64_t idSum = 0;
+    Testing::Stopwatch constructionStopwatch;
+
+    for (uint64_t i = 0; i < LookupCount; ++i)
+    {
+        idSum += Name{ strings[i % strings.size()] }.ToId();
+    }
+
+    double constructionMs = constructionStopwatch.ElapsedMilliseconds();
+
+    uint64_t lengthSum = 0;
+    Testing::Stopwatch toStringStopwatch;
+
+    for (uint64_t i = 0; i < LookupCount; ++i)
+    {
+        lengthSum += names[i % names.size()].ToString().size();
+    }
+
+    double toStringMs = toStringStopwatch.ElapsedMilliseconds();
+
+    // Name keys against string keys in a map
+    std::unordered_map<Name, uint64_t> nameMap;
+    std::unordered_map<std::string, uint64_t> stringMap;
+
+    for (uint64_t i = 0; i < strings.size(); ++i)
+    {
+        nameMap[names[i]] = i;
+        stringMap[strings[i]] = i;
+    }
+
+    uint64_t nameMapSum = 0;
+    Testing::Stopwatch nameMapStopwatch;
+
+    for (uint64_t i = 0; i < LookupCount; ++i)
+    {
+        nameMapSum += nameMap.find(names[i % names.size()])->second;
+    }
+
+    double nameMapMs = nameMapStopwatch.ElapsedMilliseconds();
+
+    uint64_t stringMapSum = 0;
+    Testing::Stopwatch stringMapStopwatch;
+
+    for (uint64_t i = 0; i < LookupCount; ++i)
+    {
+        stringMapSum += stringMap.find(strings[i % strings.size()])->second;
+    }
+
+    double stringMapMs = stringMapStopwatch.ElapsedMilliseconds();
+
+    PF_CHECK(nameMapSum == stringMapSum && idSum != 0 && lengthSum != 0);
+
+    // Construction from several threads at once
+    constexpr uint64_t ThreadCount = 4;
+    std::vector<std::thread> threads;
+    std::atomic<uint64_t> threadIdSum = 0;
+    Testing::Stopwatch concurrentStopwatch;
+
+    for (uint64_t threadIdx = 0; threadIdx < ThreadCount; ++threadIdx)
+    {
+        threads.emplace_back([&]
+        {
+            uint64_t sum = 0;
+
+            for (uint64_t i = 0; i < LookupCount / ThreadCount; ++i)
+            {
+                sum += Name{ strings[i % strings.size()] }.ToId();
+            }
+
+            threadIdSum += sum;
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    double concurrentMs = concurrentStopwatch.ElapsedMilliseconds();
+
+    Testing::Report("Construction of a registered name", constructionMs * 1e6 / LookupCount, "ns");
+    Testing::Report("Name to string", toStringMs * 1e6 / LookupCount, "ns");
+    Testing::Report("Map lookup by name", nameMapMs * 1e6 / LookupCount, "ns");
+    Testing::Report("Map lookup by string", stringMapMs * 1e6 / LookupCount, "ns");
+    Testing::Report("Construction, " + std::to_string(ThreadCount) + " threads, wall time per name", concurrentMs * 1e6 / LookupCount, "ns");
+}
@@ -0,0 +1,165 @@
+#include "../Testing.hpp"
+
+#include <Geometry/FrustumCuller.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+#include <array>
+#include <vector>
+
+namespace
+{
+
+    using Geometry::AABB;
+    using Geometry::Frustum;
+    using Geometry::FrustumCuller;
+
+    // World space corners in the order of Camera::GetFrustumCorners
+    std::array<glm::vec3, 8> FrustumCorners(const glm::vec3& position, const glm::vec3& target)
+    {
+        constexpr std::array<glm::vec3, 8> NDCCorners = {
+            glm::vec3(-1,-1,0), glm::vec3(-1,1,0), glm::vec3(1,1,0), glm::vec3(1,-1,0),
+            glm::vec3(-1,-1,1), glm::vec3(-1,1,1), glm::vec3(1,1,1), glm::vec3(1,-1,1)
+        };
+
+        glm::mat4 view = glm::lookAt(position, target, glm::vec3{ 0.0f, 1.0f, 0.0f });
+        glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+        glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+
+        std::array<glm::vec3, 8> corners;
+
+        for (auto corner = 0; corner < 8; ++corner)
+        {
+            glm::vec4 vertex = inverseViewProjection * glm::vec4{ NDCCorners[corner], 1.0f };
+            corners[corner] = glm::vec3{ vertex } / vertex.w;
+        }
+
+        return corners;
+    }
+
+    // Instances of varying size scattered around the camera
+    std::vector<AABB> RandomBoxes(uint64_t count, uint32_t seed)
+    {
+        std::mt19937 rng{ seed };
+        std::uniform_real_distribution<float> positionDistribution{ -600.0f, 600.0f };
+        std::uniform_real_distribution<float> sizeDistribution{ 0.1f, 20.0f };
+        std::vector<AABB> boxes;
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            glm::vec3 center{ positionDistribution(rng), positionDistribution(rng) * 0.1f, positionDistribution(rng) };
+            glm::vec3 extent{ sizeDistribution(rng), sizeDistribution(rng), sizeDistribution(rng) };
+            boxes.emplace_back(center - extent, center + extent);
+        }
+
+        return boxes;
+    }
+
+    FrustumCuller MakeCuller(const std::vector<AABB>& boxes)
+    {
+        FrustumCuller culler;
+        culler.Resize(boxes.size());
+
+        for (uint64_t i = 0; i < boxes.size(); ++i)
+        {
+            culler.SetBox(i, boxes[i]);
+        }
+
+        return culler;
+    }
+
+}
+
+PF_TEST(FrustumPlanesFaceInside)
+{
+    std::array<glm::vec3, 8> corners = FrustumCorners(glm::vec3{ 10.0f, 5.0f, -3.0f }, glm::vec3{ 0.0f });
+    Frustum frustum{ corners };
+    glm::vec3 center{ 0.0f };
+
+    for (const glm::vec3& corner : corners)
+    {
+        center += corner / 8.0f;
+    }
+
+    for (const Geometry::Plane& plane : frustum.Planes())
+    {
+        PF_CHECK_NEAR(glm::length(plane.normal), 1.0f, 1e-4f);
+        PF_CHECK(glm::dot(plane.normal, center) - plane.distance > 0.0f, "Plane normal points outside");
+    }
+
+    PF_CHECK(frustum.Intersects(AABB{ center - 1.0f, center + 1.0f }));
+    PF_CHECK(!frustum.Intersects(AABB{ glm::vec3{ 10000.0f }, glm::vec3{ 10001.0f } }));
+}
+
+PF_TEST(FrustumCullerMatchesPerBoxTest)
+{
+    // Odd count leaves padding lanes in the last batch
+    std::vector<AABB> boxes = RandomBoxes(10007, 5);
+    FrustumCuller culler = MakeCuller(boxes);
+    std::vector<uint32_t> visibleIndices;
+
+    for (const glm::vec3& target : { glm::vec3{ 0.0f }, glm::vec3{ 100.0f, 0.0f, 0.0f }, glm::vec3{ -50.0f, 30.0f, -200.0f } })
+    {
+        Frustum frustum{ FrustumCorners(glm::vec3{ 0.0f, 10.0f, 50.0f }, target) };
+        std::vector<uint32_t> expectedIndices;
+
+        for (uint64_t i = 0; i < boxes.size(); ++i)
+        {
+            if (frustum.Intersects(boxes[i]))
+            {
+                expectedIndices.push_back(uint32_t(i));
+            }
+        }
+
+        culler.Cull(frustum, visibleIndices);
+
+        PF_CHECK(!expectedIndices.empty() && expectedIndices.size() < boxes.size(), "Visible: ", expectedIndices.size());
+        PF_CHECK(visibleIndices == expectedIndices, "Culler: ", visibleIndices.size(), " Per box: ", expectedIndices.size());
+    }
+}
+
+PF_BENCHMARK(FrustumCullerInstances)
+{
+    constexpr uint64_t RepeatCount = 20;
+
+    Frustum frustum{ FrustumCorners(glm::vec3{ 0.0f, 10.0f, 50.0f }, glm::vec3{ 0.0f }) };
+    std::vector<uint32_t> visibleIndices;
+
+    for (uint64_t boxCount : { 100000, 250000, 1000000 })
+    {
+        std::vector<AABB> boxes = RandomBoxes(boxCount, 9);
+        FrustumCuller culler = MakeCuller(boxes);
+        uint64_t visibleCount = 0;
+
+        Testing::Stopwatch perBoxStopwatch;
+
+        for (uint64_t repeat = 0; repeat < RepeatCount; ++repeat)
+        {
+            visibleCount = 0;
+
+            for (const AABB& box : boxes)
+            {
+                visibleCount += frustum.Intersects(box);
+            }
+        }
+
+        double perBoxMilliseconds = perBoxStopwatch.ElapsedMilliseconds() / RepeatCount;
+        Testing::Stopwatch cullerStopwatch;
+
+        for (uint64_t repeat = 0; repeat < RepeatCount; ++repeat)
+        {
+            culler.Cull(frustum, visibleIndices);
+        }
+
+        double cullerMilliseconds = cullerStopwatch.ElapsedMilliseconds() / RepeatCount;
+        std::string suffix = " (" + std::to_string(boxCount) + " instances)";
+
+        Testing::Report("Frustum::Intersects per box" + suffix, perBoxMilliseconds, "ms");
+        Testing::Report("FrustumCuller" + suffix, cullerMilliseconds, "ms");
+        Testing::Report("Speedup" + suffix, perBoxMilliseconds / cullerMilliseconds, "x");
+        Testing::Report("Visible" + suffix, double(visibleIndices.size()), "instances");
+
+        PF_CHECK(visibleIndices.size() == visibleCount);
+    }
+}
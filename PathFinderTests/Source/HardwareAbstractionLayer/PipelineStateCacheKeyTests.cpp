@@ -0,0 +1,209 @@
+#include "../Testing.hpp"
+
+#include <HardwareAbstractionLayer/PipelineStateCacheKey.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <set>
+
+namespace
+{
+
+    // Description storage that owns everything descriptions point to, so that
+    // identical states can be rebuilt at different addresses as they are on every run
+    struct GraphicsStateStorage
+    {
+        std::vector<uint8_t> VertexShader;
+        std::vector<uint8_t> PixelShader;
+        std::vector<std::string> SemanticNames{ "POSITION", "TEXCOORD" };
+        std::vector<D3D12_INPUT_ELEMENT_DESC> InputElements;
+        uint64_t RootSignatureHash = 0x5eed5eed5eed5eedull;
+        D3D12_GRAPHICS_PIPELINE_STATE_DESC Desc{};
+
+        GraphicsStateStorage()
+        {
+            for (uint64_t i = 0; i < 256; ++i)
+            {
+                VertexShader.push_back(uint8_t(i * 7));
+                PixelShader.push_back(uint8_t(i * 13 + 1));
+            }
+
+            InputElements.push_back({ nullptr, 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 });
+            InputElements.push_back({ nullptr, 0, DXGI_FORMAT_R32G32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 });
+
+            Desc.BlendState.RenderTarget[0] = { FALSE, FALSE, D3D12_BLEND_ONE, D3D12_BLEND_ZERO, D3D12_BLEND_OP_ADD,
+                D3D12_BLEND_ONE, D3D12_BLEND_ZERO, D3D12_BLEND_OP_ADD, D3D12_LOGIC_OP_NOOP, 0xF };
+            Desc.SampleMask = 0xFFFFFFFF;
+            Desc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
+            Desc.RasterizerState.CullMode = D3D12_CULL_MODE_BACK;
+            Desc.RasterizerState.DepthClipEnable = TRUE;
+            Desc.DepthStencilState.DepthEnable = TRUE;
+            Desc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
+            Desc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS;
+            Desc.DepthStencilState.StencilReadMask = 0xFF;
+            Desc.DepthStencilState.StencilWriteMask = 0xFF;
+            Desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+            Desc.NumRenderTargets = 1;
+            Desc.RTVFormats[0] = DXGI_FORMAT_R16G16B16A16_FLOAT;
+            Desc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+            Desc.SampleDesc.Count = 1;
+            Desc.NodeMask = 1;
+        }
+
+        // Pointers are refreshed on every call, since storage may have been copied or modified
+        uint64_t Key()
+        {
+            for (uint64_t i = 0; i < InputElements.size(); ++i)
+            {
+                InputElements[i].SemanticName = SemanticNames[i].c_str();
+            }
+
+            Desc.VS = { VertexShader.data(), VertexShader.size() };
+            Desc.PS = { PixelShader.data(), PixelShader.size() };
+            Desc.InputLayout = { InputElements.data(), UINT(InputElements.size()) };
+
+            return HAL::PipelineStateCacheKey(Desc, RootSignatureHash);
+        }
+    };
+
+    struct ComputeStateStorage
+    {
+        std::vector<uint8_t> ComputeShader;
+        uint64_t RootSignatureHash = 0x5eed5eed5eed5eedull;
+        D3D12_COMPUTE_PIPELINE_STATE_DESC Desc{};
+
+        ComputeStateStorage()
+        {
+            for (uint64_t i = 0; i < 256; ++i)
+            {
+                ComputeShader.push_back(uint8_t(i * 7));
+            }
+
+            Desc.NodeMask = 1;
+        }
+
+        uint64_t Key()
+        {
+            Desc.CS = { ComputeShader.data(), ComputeShader.size() };
+            return HAL::PipelineStateCacheKey(Desc, RootSignatureHash);
+        }
+    };
+
+    // Checks that every modification changes the key, and that no two modifications produce the same key
+    template <class Storage>
+    void CheckSensitivity(const std::vector<std::pair<std::string, std::function<void(Storage&)>>>& modifications)
+    {
+        Storage base;
+        std::set<uint64_t> keys{ base.Key() };
+
+        for (const auto& [name, modify] : modifications)
+        {
+            Storage modified;
+            modify(modified);
+            PF_CHECK(keys.insert(modified.Key()).second, "Key didn't change or collided: ", name);
+        }
+    }
+
+}
+
+PF_TEST(PipelineStateCacheKeyIsStable)
+{
+    GraphicsStateStorage graphicsState;
+    uint64_t graphicsKey = graphicsState.Key();
+
+    PF_CHECK(graphicsState.Key() == graphicsKey);
+
+    // Same state rebuilt in different memory, with a different root signature object, as on the next run
+    std::vector<GraphicsStateStorage> rebuiltStates(3);
+
+    for (uint64_t i = 0; i < rebuiltStates.size(); ++i)
+    {
+        rebuiltStates[i].Desc.pRootSignature = reinterpret_cast<ID3D12RootSignature*>(uintptr_t(0x1000 * (i + 1)));
+        PF_CHECK(rebuiltStates[i].Key() == graphicsKey, "Rebuilt state ", i);
+    }
+
+    // Fields that are not part of the state's identity
+    GraphicsStateStorage stateWithCachedBlob;
+    uint8_t cachedBlob[16]{};
+    stateWithCachedBlob.Desc.CachedPSO = { cachedBlob, sizeof(cachedBlob) };
+    PF_CHECK(stateWithCachedBlob.Key() == graphicsKey);
+
+    ComputeStateStorage computeState;
+    ComputeStateStorage rebuiltComputeState;
+    rebuiltComputeState.Desc.pRootSignature = reinterpret_cast<ID3D12RootSignature*>(uintptr_t(0x2000));
+
+    PF_CHECK(computeState.Key() == rebuiltComputeState.Key());
+
+    // Same bytecode as a vertex shader and as a compute shader are different states
+    PF_CHECK(computeState.Key() != graphicsKey);
+}
+
+PF_TEST(PipelineStateCacheKeyTracksRootSignatureAndBytecode)
+{
+    using Modification = std::pair<std::string, std::function<void(GraphicsStateStorage&)>>;
+
+    CheckSensitivity<GraphicsStateStorage>({
+        Modification{ "Root signature", [](GraphicsStateStorage& s) { s.RootSignatureHash ^= 1; } },
+        Modification{ "Vertex shader first byte", [](GraphicsStateStorage& s) { s.VertexShader.front() ^= 1; } },
+        Modification{ "Vertex shader last byte", [](GraphicsStateStorage& s) { s.VertexShader.back() ^= 1; } },
+        Modification{ "Vertex shader length", [](GraphicsStateStorage& s) { s.VertexShader.push_back(0); } },
+        Modification{ "Pixel shader byte", [](GraphicsStateStorage& s) { s.PixelShader[100] ^= 0x80; } },
+        Modification{ "Pixel shader length", [](GraphicsStateStorage& s) { s.PixelShader.pop_back(); } },
+        Modification{ "Shaders swapped", [](GraphicsStateStorage& s) { std::swap(s.VertexShader, s.PixelShader); } },
+        Modification{ "Bytes moved between shaders", [](GraphicsStateStorage& s) { s.PixelShader.insert(s.PixelShader.begin(), s.VertexShader.back()); s.VertexShader.pop_back(); } },
+    });
+
+    // Optional stages take part as well
+    std::vector<uint8_t> geometryShader(64, uint8_t(3));
+    GraphicsStateStorage base;
+    GraphicsStateStorage withGeometryShader;
+    withGeometryShader.Key();
+    withGeometryShader.Desc.GS = { geometryShader.data(), geometryShader.size() };
+
+    PF_CHECK(HAL::PipelineStateCacheKey(withGeometryShader.Desc, withGeometryShader.RootSignatureHash) != base.Key());
+
+    using ComputeModification = std::pair<std::string, std::function<void(ComputeStateStorage&)>>;
+
+    CheckSensitivity<ComputeStateStorage>({
+        ComputeModification{ "Root signature", [](ComputeStateStorage& s) { s.RootSignatureHash += 1; } },
+        ComputeModification{ "Compute shader byte", [](ComputeStateStorage& s) { s.ComputeShader[17] ^= 4; } },
+        ComputeModification{ "Compute shader length", [](ComputeStateStorage& s) { s.ComputeShader.resize(128); } },
+        ComputeModification{ "Node mask", [](ComputeStateStorage& s) { s.Desc.NodeMask = 2; } },
+        ComputeModification{ "Flags", [](ComputeStateStorage& s) { s.Desc.Flags = D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG; } },
+    });
+}
+
+PF_TEST(PipelineStateCacheKeyTracksFixedFunctionState)
+{
+    using Modification = std::pair<std::string, std::function<void(GraphicsStateStorage&)>>;
+
+    CheckSensitivity<GraphicsStateStorage>({
+        Modification{ "Alpha to coverage", [](GraphicsStateStorage& s) { s.Desc.BlendState.AlphaToCoverageEnable = TRUE; } },
+        Modification{ "Blend enable", [](GraphicsStateStorage& s) { s.Desc.BlendState.RenderTarget[0].BlendEnable = TRUE; } },
+        Modification{ "Blend of last render target", [](GraphicsStateStorage& s) { s.Desc.BlendState.RenderTarget[7].SrcBlend = D3D12_BLEND_SRC_ALPHA; } },
+        Modification{ "Write mask", [](GraphicsStateStorage& s) { s.Desc.BlendState.RenderTarget[0].RenderTargetWriteMask = 0x7; } },
+        Modification{ "Sample mask", [](GraphicsStateStorage& s) { s.Desc.SampleMask = 0x1; } },
+        Modification{ "Cull mode", [](GraphicsStateStorage& s) { s.Desc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE; } },
+        Modification{ "Fill mode", [](GraphicsStateStorage& s) { s.Desc.RasterizerState.FillMode = D3D12_FILL_MODE_WIREFRAME; } },
+        Modification{ "Depth bias", [](GraphicsStateStorage& s) { s.Desc.RasterizerState.DepthBias = 4; } },
+        Modification{ "Depth function", [](GraphicsStateStorage& s) { s.Desc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_GREATER; } },
+        Modification{ "Depth write", [](GraphicsStateStorage& s) { s.Desc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO; } },
+        Modification{ "Stencil read mask", [](GraphicsStateStorage& s) { s.Desc.DepthStencilState.StencilReadMask = 0x0F; } },
+        Modification{ "Back face stencil", [](GraphicsStateStorage& s) { s.Desc.DepthStencilState.BackFace.StencilPassOp = D3D12_STENCIL_OP_REPLACE; } },
+        Modification{ "Input element format", [](GraphicsStateStorage& s) { s.InputElements[1].Format = DXGI_FORMAT_R32G32B32A32_FLOAT; } },
+        Modification{ "Input element offset", [](GraphicsStateStorage& s) { s.InputElements[1].AlignedByteOffset = 16; } },
+        Modification{ "Semantic name", [](GraphicsStateStorage& s) { s.SemanticNames[1] = "NORMAL"; } },
+        Modification{ "Semantic index", [](GraphicsStateStorage& s) { s.InputElements[1].SemanticIndex = 1; } },
+        Modification{ "Input element removed", [](GraphicsStateStorage& s) { s.InputElements.pop_back(); } },
+        Modification{ "Per instance data", [](GraphicsStateStorage& s) { s.InputElements[0].InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA; } },
+        Modification{ "Strip cut value", [](GraphicsStateStorage& s) { s.Desc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_0xFFFFFFFF; } },
+        Modification{ "Topology type", [](GraphicsStateStorage& s) { s.Desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE; } },
+        Modification{ "Render target count", [](GraphicsStateStorage& s) { s.Desc.NumRenderTargets = 2; s.Desc.RTVFormats[1] = DXGI_FORMAT_R16G16B16A16_FLOAT; } },
+        Modification{ "Render target format", [](GraphicsStateStorage& s) { s.Desc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM; } },
+        Modification{ "Depth stencil format", [](GraphicsStateStorage& s) { s.Desc.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT; } },
+        Modification{ "Sample count", [](GraphicsStateStorage& s) { s.Desc.SampleDesc.Count = 4; } },
+        Modification{ "Node mask", [](GraphicsStateStorage& s) { s.Desc.NodeMask = 2; } },
+        Modification{ "Flags", [](GraphicsStateStorage& s) { s.Desc.Flags = D3D12_PIPELINE_STATE_FLAG_TOOL_DEBUG; } },
+    });
+}
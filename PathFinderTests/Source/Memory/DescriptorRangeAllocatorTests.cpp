@@ -0,0 +1,350 @@
+#include "../Testing.hpp"
+
+#include <Memory/DescriptorRangeAllocator.hpp>
+
+#include <random>
+#include <vector>
+#include <map>
+
+namespace
+{
+
+    constexpr int64_t NoOwner = -1;
+
+    // Descriptor heap stand-in that records which allocation owns each index and the frame it was freed in,
+    // relocations copy descriptors the way PoolDescriptorAllocator recreates them at new indices
+    class MockDescriptorHeap
+    {
+    public:
+        MockDescriptorHeap(uint64_t capacity) : mOwners(capacity, NoOwner), mFreeFrames(capacity, 0) {}
+
+        bool IsReusable(uint64_t index, uint64_t completedFrameNumber) const
+        {
+            return mFreeFrames[index] <= completedFrameNumber && (mOwners[index] == NoOwner || mFreeFrames[index] != 0);
+        }
+
+        void Emplace(uint64_t index, uint64_t count, int64_t owner)
+        {
+            for (uint64_t i = index; i < index + count; ++i)
+            {
+                mOwners[i] = owner;
+                mFreeFrames[i] = 0;
+            }
+        }
+
+        void Free(uint64_t index, uint64_t count, uint64_t frameNumber)
+        {
+            for (uint64_t i = index; i < index + count; ++i)
+            {
+                mFreeFrames[i] = frameNumber;
+            }
+        }
+
+        void Relocate(uint64_t oldIndex, uint64_t newIndex, uint64_t count, uint64_t frameNumber)
+        {
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                mOwners[newIndex + i] = mOwners[oldIndex + i];
+                mFreeFrames[newIndex + i] = 0;
+            }
+
+            Free(oldIndex, count, frameNumber);
+        }
+
+        void RetireFrames(uint64_t completedFrameNumber)
+        {
+            for (uint64_t i = 0; i < mOwners.size(); ++i)
+            {
+                if (mFreeFrames[i] != 0 && mFreeFrames[i] <= completedFrameNumber)
+                {
+                    mOwners[i] = NoOwner;
+                    mFreeFrames[i] = 0;
+                }
+            }
+        }
+
+        int64_t Owner(uint64_t index) const { return mOwners[index]; }
+
+    private:
+        std::vector<int64_t> mOwners;
+        std::vector<uint64_t> mFreeFrames;
+    };
+
+    // Fills a range with single descriptors and frees every other one
+    uint64_t FitBlocksIntoCheckerboard(bool defragment)
+    {
+        Memory::DescriptorRangeAllocator allocator{ 12000, 2 };
+        std::vector<uint64_t> indices;
+        uint64_t frameNumber = 1;
+
+        allocator.BeginFrame(frameNumber);
+
+        for (uint64_t i = 0; i < 10000; ++i)
+        {
+            indices.push_back(*allocator.Allocate());
+        }
+
+        for (uint64_t i = 1; i < indices.size(); i += 2)
+        {
+            allocator.Deallocate(indices[i]);
+        }
+
+        for (uint64_t i = 0; i < 40; ++i)
+        {
+            allocator.EndFrame(frameNumber);
+            allocator.BeginFrame(++frameNumber);
+
+            if (defragment)
+            {
+                allocator.Defragment(256, [](uint64_t oldIndex, uint64_t newIndex, uint64_t count) {});
+            }
+        }
+
+        // Let the last relocated indices retire
+        for (uint64_t i = 0; i < 3; ++i)
+        {
+            allocator.EndFrame(frameNumber);
+            allocator.BeginFrame(++frameNumber);
+        }
+
+        uint64_t blockCount = 0;
+
+        while (allocator.Allocate(64))
+        {
+            ++blockCount;
+        }
+
+        return blockCount;
+    }
+
+}
+
+PF_TEST(DescriptorRangeAllocatorReusesIndicesAfterFrameCompletes)
+{
+    Memory::DescriptorRangeAllocator allocator{ 4, 2 };
+
+    allocator.BeginFrame(1);
+
+    std::vector<uint64_t> indices;
+
+    for (uint64_t i = 0; i < 4; ++i)
+    {
+        std::optional<uint64_t> index = allocator.Allocate();
+        PF_CHECK(index && *index == i);
+        indices.push_back(index.value_or(0));
+    }
+
+    PF_CHECK(!allocator.Allocate().has_value());
+
+    allocator.Deallocate(indices[2]);
+
+    // Still referenced by the frame in flight
+    PF_CHECK(!allocator.Allocate().has_value());
+    PF_CHECK(allocator.AllocatedCount() == 4);
+
+    allocator.BeginFrame(2);
+    allocator.EndFrame(1);
+
+    std::optional<uint64_t> index = allocator.Allocate();
+    PF_CHECK(index && *index == indices[2]);
+}
+
+PF_TEST(DescriptorRangeAllocatorCoalescesFreedBlocks)
+{
+    Memory::DescriptorRangeAllocator allocator{ 64, 2 };
+
+    allocator.BeginFrame(1);
+
+    std::optional<uint64_t> first = allocator.Allocate(16);
+    std::optional<uint64_t> second = allocator.Allocate(16);
+    std::optional<uint64_t> third = allocator.Allocate(32);
+
+    PF_CHECK(first && second && third);
+    PF_CHECK(allocator.LargestFreeBlockSize() == 0);
+
+    allocator.Deallocate(*first);
+    allocator.Deallocate(*second);
+    allocator.BeginFrame(2);
+    allocator.EndFrame(1);
+
+    PF_CHECK(allocator.LargestFreeBlockSize() == 32);
+
+    std::optional<uint64_t> block = allocator.Allocate(32);
+    PF_CHECK(block && *block == 0);
+}
+
+PF_TEST(DescriptorRangeAllocatorMergesFreeSingleIndices)
+{
+    Memory::DescriptorRangeAllocator allocator{ 8, 1 };
+
+    allocator.BeginFrame(1);
+
+    std::vector<uint64_t> indices;
+
+    for (uint64_t i = 0; i < 8; ++i)
+    {
+        indices.push_back(*allocator.Allocate());
+    }
+
+    for (uint64_t index : indices)
+    {
+        allocator.Deallocate(index);
+    }
+
+    allocator.EndFrame(1);
+    allocator.BeginFrame(2);
+
+    // Singles are kept in a list until a block request needs them coalesced
+    std::optional<uint64_t> block = allocator.Allocate(8);
+    PF_CHECK(block && *block == 0);
+}
+
+PF_TEST(DescriptorRangeAllocatorRelocatesIntoCompletedHolesOnly)
+{
+    // Random single and block allocations against a mock heap. After every relocation and allocation
+    // each live allocation must still own its descriptors, relocations must move towards the range start
+    // and no index may be reused before the frame it was freed in completes.
+    constexpr uint64_t Capacity = 20000;
+    constexpr uint8_t FramesInFlight = 2;
+
+    Memory::DescriptorRangeAllocator allocator{ Capacity, FramesInFlight };
+    MockDescriptorHeap heap{ Capacity };
+
+    struct LiveAllocation
+    {
+        uint64_t Index;
+        uint64_t Count;
+    };
+
+    std::map<int64_t, LiveAllocation> liveAllocations;
+    std::mt19937 rng{ 7 };
+    int64_t nextOwner = 0;
+    uint64_t completedFrameNumber = 0;
+    uint64_t relocationCount = 0;
+
+    auto checkOwnership = [&]
+    {
+        for (auto& [owner, allocation] : liveAllocations)
+        {
+            for (uint64_t i = allocation.Index; i < allocation.Index + allocation.Count; ++i)
+            {
+                PF_CHECK(heap.Owner(i) == owner, "Index: ", i, " Owner: ", heap.Owner(i), " Expected: ", owner);
+            }
+        }
+    };
+
+    for (uint64_t frameNumber = 1; frameNumber <= 3000; ++frameNumber)
+    {
+        allocator.BeginFrame(frameNumber);
+
+        relocationCount += allocator.Defragment(256, [&](uint64_t oldIndex, uint64_t newIndex, uint64_t count)
+        {
+            PF_CHECK(newIndex < oldIndex, "Old: ", oldIndex, " New: ", newIndex);
+
+            for (uint64_t i = newIndex; i < newIndex + count; ++i)
+            {
+                PF_CHECK(heap.IsReusable(i, completedFrameNumber), "Index: ", i);
+            }
+
+            liveAllocations[heap.Owner(oldIndex)].Index = newIndex;
+            heap.Relocate(oldIndex, newIndex, count, frameNumber);
+        });
+
+        checkOwnership();
+
+        uint64_t operationCount = rng() % 200;
+
+        for (uint64_t i = 0; i < operationCount; ++i)
+        {
+            uint64_t allocationChance = liveAllocations.size() < 3000 ? 55 : 45;
+
+            if (liveAllocations.empty() || rng() % 100 < allocationChance)
+            {
+                uint64_t count = rng() % 10 == 0 ? 1 + rng() % 64 : 1;
+                std::optional<uint64_t> index = allocator.Allocate(count);
+
+                if (!index)
+                {
+                    continue;
+                }
+
+                for (uint64_t j = *index; j < *index + count; ++j)
+                {
+                    PF_CHECK(heap.IsReusable(j, completedFrameNumber), "Index: ", j);
+                }
+
+                heap.Emplace(*index, count, nextOwner);
+                liveAllocations[nextOwner++] = { *index, count };
+            }
+            else
+            {
+                auto it = std::next(liveAllocations.begin(), rng() % liveAllocations.size());
+                allocator.Deallocate(it->second.Index);
+                heap.Free(it->second.Index, it->second.Count, frameNumber);
+                liveAllocations.erase(it);
+            }
+        }
+
+        checkOwnership();
+
+        if (frameNumber >= FramesInFlight)
+        {
+            completedFrameNumber = frameNumber - FramesInFlight + 1;
+            allocator.EndFrame(completedFrameNumber);
+            heap.RetireFrames(completedFrameNumber);
+        }
+    }
+
+    PF_CHECK(relocationCount > 0);
+}
+
+PF_TEST(DescriptorRangeAllocatorDefragmentationRestoresLargeBlocks)
+{
+    uint64_t fragmentedBlockCount = FitBlocksIntoCheckerboard(false);
+    uint64_t defragmentedBlockCount = FitBlocksIntoCheckerboard(true);
+
+    PF_CHECK(defragmentedBlockCount > fragmentedBlockCount, "Fragmented: ", fragmentedBlockCount, " Defragmented: ", defragmentedBlockCount);
+}
+
+PF_BENCHMARK(DescriptorRangeAllocatorSingleIndices)
+{
+    constexpr uint64_t FrameCount = 20;
+    constexpr uint64_t AllocationsPerFrame = 50000;
+
+    Memory::DescriptorRangeAllocator allocator{ 1 << 20, 2 };
+    std::vector<uint64_t> indices;
+    indices.reserve(AllocationsPerFrame);
+
+    Testing::Stopwatch stopwatch;
+
+    for (uint64_t frameNumber = 1; frameNumber <= FrameCount; ++frameNumber)
+    {
+        allocator.BeginFrame(frameNumber);
+
+        for (uint64_t i = 0; i < AllocationsPerFrame; ++i)
+        {
+            indices.push_back(*allocator.Allocate());
+        }
+
+        for (uint64_t index : indices)
+        {
+            allocator.Deallocate(index);
+        }
+
+        indices.clear();
+        allocator.EndFrame(frameNumber);
+    }
+
+    Testing::Report("Single index allocate and free", stopwatch.ElapsedMilliseconds() * 1e6 / (FrameCount * AllocationsPerFrame), "ns/op");
+}
+
+PF_BENCHMARK(DescriptorRangeAllocatorCheckerboardDefragmentation)
+{
+    Testing::Stopwatch stopwatch;
+    uint64_t fragmentedBlockCount = FitBlocksIntoCheckerboard(false);
+    uint64_t defragmentedBlockCount = FitBlocksIntoCheckerboard(true);
+
+    Testing::Report("64 descriptor blocks fitting without defragmentation", double(fragmentedBlockCount), "blocks");
+    Testing::Report("64 descriptor blocks fitting with defragmentation", double(defragmentedBlockCount), "blocks");
+    Testing::Report("Total time", stopwatch.ElapsedMilliseconds(), "ms");
+}
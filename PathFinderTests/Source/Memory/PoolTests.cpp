@@ -0,0 +1,155 @@
+#include "../Testing.hpp"
+
+#include <Memory/Pool.hpp>
+
+#include <random>
+#include <vector>
+#include <list>
+#include <algorithm>
+
+namespace
+{
+
+    // Free list layout Pool used before slots were linked in place: a heap allocated node per free slot
+    class ListPoolModel
+    {
+    public:
+        ListPoolModel(uint64_t slotSize) : mSlotSize{ slotSize } {}
+
+        uint64_t Allocate()
+        {
+            if (mFreeSlots.empty())
+            {
+                mFreeSlots.push_back(mSlotCount * mSlotSize);
+                ++mSlotCount;
+            }
+
+            uint64_t offset = mFreeSlots.front();
+            mFreeSlots.pop_front();
+            return offset;
+        }
+
+        void Deallocate(uint64_t offset)
+        {
+            mFreeSlots.push_back(offset);
+        }
+
+    private:
+        std::list<uint64_t> mFreeSlots;
+        uint64_t mSlotSize = 0;
+        uint64_t mSlotCount = 0;
+    };
+
+}
+
+PF_TEST(PoolHandsOutDenseSlots)
+{
+    Memory::Pool<> pool{ 64, 4 };
+    std::vector<Memory::Pool<>::SlotType> slots;
+
+    for (uint64_t i = 0; i < 100; ++i)
+    {
+        slots.push_back(pool.Allocate());
+        PF_CHECK(slots.back().MemoryOffset == i * 64, "Slot: ", i, " Offset: ", slots.back().MemoryOffset);
+    }
+
+    pool.Deallocate(slots[10]);
+    pool.Deallocate(slots[20]);
+
+    PF_CHECK(pool.AllocatedSlotCount() == 98);
+
+    // Freed slots are reused before new ones are taken from the end
+    uint64_t firstReused = pool.Allocate().MemoryOffset;
+    uint64_t secondReused = pool.Allocate().MemoryOffset;
+
+    PF_CHECK(std::min(firstReused, secondReused) == 10 * 64 && std::max(firstReused, secondReused) == 20 * 64);
+    PF_CHECK(pool.Allocate().MemoryOffset == 100 * 64);
+}
+
+PF_TEST(PoolKeepsSlotUserDataAcrossDeallocation)
+{
+    Memory::Pool<int> pool{ 1, 1 };
+
+    Memory::Pool<int>::SlotType slot = pool.Allocate();
+    slot.UserData = 42;
+    pool.Deallocate(slot);
+
+    Memory::Pool<int>::SlotType reused = pool.Allocate();
+
+    PF_CHECK(reused.MemoryOffset == slot.MemoryOffset);
+    PF_CHECK(reused.UserData == 42, "User data: ", reused.UserData);
+}
+
+PF_TEST(PoolNeverHandsOutSlotTwice)
+{
+    Memory::Pool<> pool{ 16, 8 };
+    std::vector<Memory::Pool<>::SlotType> liveSlots;
+    std::vector<bool> isSlotLive;
+    uint64_t peakLiveSlotCount = 0;
+    std::mt19937_64 rng{ 4 };
+
+    for (uint64_t step = 0; step < 200000; ++step)
+    {
+        if (liveSlots.empty() || rng() % 100 < 55)
+        {
+            Memory::Pool<>::SlotType slot = pool.Allocate();
+            uint64_t slotIndex = slot.MemoryOffset / 16;
+
+            if (slotIndex >= isSlotLive.size())
+                isSlotLive.resize(slotIndex + 1, false);
+
+            PF_CHECK(!isSlotLive[slotIndex], "Slot handed out twice: ", slotIndex);
+            isSlotLive[slotIndex] = true;
+            liveSlots.push_back(slot);
+            peakLiveSlotCount = std::max<uint64_t>(peakLiveSlotCount, liveSlots.size());
+        }
+        else
+        {
+            uint64_t liveIdx = rng() % liveSlots.size();
+            isSlotLive[liveSlots[liveIdx].MemoryOffset / 16] = false;
+            pool.Deallocate(liveSlots[liveIdx]);
+            liveSlots[liveIdx] = liveSlots.back();
+            liveSlots.pop_back();
+        }
+    }
+
+    PF_CHECK(pool.AllocatedSlotCount() == liveSlots.size());
+
+    // Slots are only taken from the end when nothing is free, so the pool is as large as its peak usage
+    PF_CHECK(isSlotLive.size() == peakLiveSlotCount, "Slot count: ", isSlotLive.size(), " Peak usage: ", peakLiveSlotCount);
+}
+
+PF_BENCHMARK(PoolAllocationBursts)
+{
+    constexpr uint64_t BurstSize = 1000;
+    constexpr uint64_t BurstCount = 2000;
+
+    std::vector<Memory::Pool<>::SlotType> slots(BurstSize);
+    std::vector<uint64_t> offsets(BurstSize);
+
+    {
+        Memory::Pool<> pool{ 64, 1 };
+        Testing::Stopwatch stopwatch;
+
+        for (uint64_t burst = 0; burst < BurstCount; ++burst)
+        {
+            for (uint64_t i = 0; i < BurstSize; ++i) slots[i] = pool.Allocate();
+            for (uint64_t i = 0; i < BurstSize; ++i) pool.Deallocate(slots[i]);
+        }
+
+        Testing::Report("Intrusive pool: time per operation", stopwatch.ElapsedMilliseconds() * 1e6 / (2 * BurstSize * BurstCount), "ns");
+    }
+
+    {
+        ListPoolModel pool{ 64 };
+        Testing::Stopwatch stopwatch;
+
+        for (uint64_t burst = 0; burst < BurstCount; ++burst)
+        {
+            for (uint64_t i = 0; i < BurstSize; ++i) offsets[i] = pool.Allocate();
+            for (uint64_t i = 0; i < BurstSize; ++i) pool.Deallocate(offsets[i]);
+        }
+
+        Testing::Report("List free list model: time per operation", stopwatch.ElapsedMilliseconds() * 1e6 / (2 * BurstSize * BurstCount), "ns");
+    }
+}
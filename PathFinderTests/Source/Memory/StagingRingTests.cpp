@@ -0,0 +1,202 @@
+#include "../Testing.hpp"
+
+#include <Memory/StagingRing.hpp>
+
+#include <random>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+
+    constexpr uint64_t Alignment = Memory::StagingRing::AllocationAlignment;
+
+    // Ring only hands the buffer out with allocations, so tests back it with plain memory
+    struct StagingRingFixture
+    {
+        StagingRingFixture(uint64_t capacity) : Memory(capacity), Ring{ nullptr, Memory.data(), capacity } {}
+
+        std::vector<uint8_t> Memory;
+        Memory::StagingRing Ring;
+    };
+
+}
+
+PF_TEST(StagingRingAlignsAllocations)
+{
+    StagingRingFixture fixture{ 16 * Alignment };
+
+    for (uint64_t size : { 1, 3, 511, 512, 513, 100 })
+    {
+        std::optional<Memory::StagingRing::Allocation> allocation = fixture.Ring.Allocate(size);
+
+        PF_CHECK(allocation.has_value(), "Size: ", size);
+
+        if (allocation)
+        {
+            PF_CHECK(allocation->Offset % Alignment == 0, "Offset: ", allocation->Offset);
+            PF_CHECK(allocation->CPUAddress == fixture.Memory.data() + allocation->Offset);
+        }
+    }
+}
+
+PF_TEST(StagingRingReportsOverflowUntilFramesComplete)
+{
+    StagingRingFixture fixture{ 4 * Alignment };
+
+    PF_CHECK(fixture.Ring.Allocate(2 * Alignment).has_value());
+    PF_CHECK(fixture.Ring.Allocate(Alignment + 1).has_value());
+    fixture.Ring.FinishCurrentFrame(1);
+
+    // Padded second allocation took the rest of the ring
+    PF_CHECK(!fixture.Ring.Allocate(1).has_value());
+
+    fixture.Ring.EndFrame(0);
+    PF_CHECK(!fixture.Ring.Allocate(1).has_value());
+
+    fixture.Ring.EndFrame(1);
+    std::optional<Memory::StagingRing::Allocation> allocation = fixture.Ring.Allocate(4 * Alignment);
+    PF_CHECK(allocation.has_value());
+}
+
+PF_TEST(StagingRingResetsWhenIdle)
+{
+    StagingRingFixture fixture{ 8 * Alignment };
+
+    PF_CHECK(fixture.Ring.Allocate(3 * Alignment).has_value());
+    fixture.Ring.FinishCurrentFrame(1);
+    fixture.Ring.EndFrame(1);
+
+    // Nothing is in flight, so the next allocation starts from the beginning instead of after the old frame
+    std::optional<Memory::StagingRing::Allocation> allocation = fixture.Ring.Allocate(Alignment);
+    PF_CHECK(allocation && allocation->Offset == 0);
+}
+
+PF_TEST(StagingRingWrapsAround)
+{
+    StagingRingFixture fixture{ 4 * Alignment };
+
+    PF_CHECK(fixture.Ring.Allocate(2 * Alignment).has_value());
+    fixture.Ring.FinishCurrentFrame(1);
+
+    std::optional<Memory::StagingRing::Allocation> second = fixture.Ring.Allocate(Alignment);
+    PF_CHECK(second && second->Offset == 2 * Alignment);
+    fixture.Ring.FinishCurrentFrame(2);
+
+    fixture.Ring.EndFrame(1);
+
+    // Doesn't fit in the tail, goes to the freed beginning
+    std::optional<Memory::StagingRing::Allocation> third = fixture.Ring.Allocate(2 * Alignment);
+    PF_CHECK(third && third->Offset == 0);
+
+    // Frame 2 is still in flight
+    PF_CHECK(!fixture.Ring.Allocate(2 * Alignment).has_value());
+}
+
+PF_TEST(StagingRingKeepsInFlightDataIntact)
+{
+    // Frames are retired with a random lag of a simulated GPU.
+    // Every allocation is filled with its frame number and must keep it until the frame is retired.
+    StagingRingFixture fixture{ 1024 * 1024 };
+    std::mt19937 rng{ 1 };
+
+    struct LiveAllocation
+    {
+        uint8_t* CPUAddress;
+        uint64_t Size;
+        uint64_t FrameNumber;
+    };
+
+    std::vector<LiveAllocation> liveAllocations;
+    uint64_t allocationCount = 0;
+    uint64_t overflowCount = 0;
+    uint64_t completedFrameNumber = 0;
+
+    for (uint64_t frameNumber = 1; frameNumber < 5000; ++frameNumber)
+    {
+        uint64_t allocationsInFrame = rng() % 8;
+
+        for (uint64_t i = 0; i < allocationsInFrame; ++i)
+        {
+            uint64_t size = 1 + rng() % 100000;
+            std::optional<Memory::StagingRing::Allocation> allocation = fixture.Ring.Allocate(size);
+
+            if (!allocation)
+            {
+                ++overflowCount;
+                continue;
+            }
+
+            ++allocationCount;
+
+            PF_CHECK(allocation->Offset % Alignment == 0);
+            PF_CHECK(allocation->Offset + size <= fixture.Ring.Capacity());
+
+            std::fill(allocation->CPUAddress, allocation->CPUAddress + size, uint8_t(frameNumber));
+            liveAllocations.push_back({ allocation->CPUAddress, size, frameNumber });
+        }
+
+        fixture.Ring.FinishCurrentFrame(frameNumber);
+
+        // GPU lags one or two frames behind
+        if (frameNumber > 2)
+        {
+            completedFrameNumber = std::max(completedFrameNumber, frameNumber - 1 - rng() % 2);
+
+            std::vector<LiveAllocation> remainingAllocations;
+
+            for (const LiveAllocation& allocation : liveAllocations)
+            {
+                bool intact = std::all_of(allocation.CPUAddress, allocation.CPUAddress + allocation.Size,
+                    [&allocation](uint8_t value) { return value == uint8_t(allocation.FrameNumber); });
+
+                PF_CHECK(intact, "Frame: ", allocation.FrameNumber, " Size: ", allocation.Size);
+
+                if (allocation.FrameNumber > completedFrameNumber)
+                {
+                    remainingAllocations.push_back(allocation);
+                }
+            }
+
+            liveAllocations.swap(remainingAllocations);
+            fixture.Ring.EndFrame(completedFrameNumber);
+        }
+    }
+
+    PF_CHECK(allocationCount > 0 && overflowCount > 0, "Allocations: ", allocationCount, " Overflows: ", overflowCount);
+}
+
+PF_BENCHMARK(StagingRingAllocation)
+{
+    constexpr uint64_t FrameCount = 100000;
+    constexpr uint64_t AllocationsPerFrame = 32;
+
+    StagingRingFixture fixture{ 64 * 1024 * 1024 };
+    std::mt19937 rng{ 1 };
+    std::vector<uint64_t> sizes(1024);
+
+    for (uint64_t& size : sizes)
+    {
+        size = 256 + rng() % 16384;
+    }
+
+    uint64_t sizeIndex = 0;
+    Testing::Stopwatch stopwatch;
+
+    for (uint64_t frameNumber = 1; frameNumber <= FrameCount; ++frameNumber)
+    {
+        for (uint64_t i = 0; i < AllocationsPerFrame; ++i)
+        {
+            fixture.Ring.Allocate(sizes[sizeIndex++ % sizes.size()]);
+        }
+
+        fixture.Ring.FinishCurrentFrame(frameNumber);
+
+        if (frameNumber > 2)
+        {
+            fixture.Ring.EndFrame(frameNumber - 2);
+        }
+    }
+
+    Testing::Report("StagingRing allocation", stopwatch.ElapsedMilliseconds() * 1e6 / (FrameCount * AllocationsPerFrame), "ns/op");
+}
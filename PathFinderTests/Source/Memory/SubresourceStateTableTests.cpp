@@ -0,0 +1,545 @@
+#include "../Testing.hpp"
+
+#include <Memory/SubresourceStateTable.hpp>
+
+#include <random>
+#include <vector>
+#include <limits>
+#include <unordered_map>
+
+namespace
+{
+
+    // Stands in for a HAL resource: buffers promote and decay freely, textures follow the non simultaneous access rules
+    class FakeResource
+    {
+    public:
+        static constexpr uint32_t InvalidStateTrackingIndex = std::numeric_limits<uint32_t>::max();
+
+        FakeResource(uint32_t subresourceCount, HAL::ResourceState initialStates, bool isBuffer = false)
+            : mSubresourceCount{ subresourceCount }, mInitialStates{ initialStates }, mIsBuffer{ isBuffer } {}
+
+        bool CanImplicitlyPromoteFromCommonStateToState(HAL::ResourceState state) const
+        {
+            using HAL::ResourceState;
+            return mIsBuffer || EnumMaskEquals(ResourceState::AnyShaderAccess | ResourceState::CopyDestination | ResourceState::CopySource, state);
+        }
+
+        bool CanImplicitlyDecayToCommonStateFromState(HAL::ResourceState state) const
+        {
+            using HAL::ResourceState;
+            return mIsBuffer || EnumMaskEquals(ResourceState::AnyShaderAccess | ResourceState::CopySource, state);
+        }
+
+    private:
+        uint32_t mSubresourceCount = 1;
+        HAL::ResourceState mInitialStates = HAL::ResourceState::Common;
+        bool mIsBuffer = false;
+        uint32_t mStateTrackingIndex = InvalidStateTrackingIndex;
+
+    public:
+        inline auto SubresourceCount() const { return mSubresourceCount; }
+        inline auto InitialStates() const { return mInitialStates; }
+        inline auto StateTrackingIndex() const { return mStateTrackingIndex; }
+
+        inline void SetStateTrackingIndex(uint32_t index) { mStateTrackingIndex = index; }
+    };
+
+    using StateTable = Memory::SubresourceStateTable<FakeResource>;
+    using HAL::ResourceState;
+
+    const ResourceState FrameStates[] = {
+        ResourceState::RenderTarget, ResourceState::PixelShaderAccess, ResourceState::NonPixelShaderAccess, ResourceState::AnyShaderAccess,
+        ResourceState::UnorderedAccess, ResourceState::CopySource, ResourceState::CopyDestination, ResourceState::Common
+    };
+
+    // Mip chains and array slices of textures mixed with single subresource buffers.
+    // Resources are tracked by address, so the vector must not grow once tracking starts.
+    std::vector<FakeResource> MakeResources(uint64_t count, uint32_t seed)
+    {
+        std::mt19937 rng{ seed };
+        std::vector<FakeResource> resources;
+
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            bool isBuffer = rng() % 3 == 0;
+            uint32_t subresourceCount = isBuffer ? 1 : 1 + rng() % 12;
+            resources.emplace_back(subresourceCount, FrameStates[rng() % std::size(FrameStates)], isBuffer);
+        }
+
+        return resources;
+    }
+
+    struct Request
+    {
+        FakeResource* Resource = nullptr;
+        StateTable::SubresourceStateList States;
+
+        // Whole resource request when states are empty
+        ResourceState State = ResourceState::Common;
+    };
+
+    // A frame worth of requests: most resources are transitioned as a whole, some per subresource, some several times
+    std::vector<Request> MakeFrameRequests(std::vector<FakeResource>& resources, uint64_t requestCount, std::mt19937& rng)
+    {
+        std::vector<Request> requests(requestCount);
+
+        for (Request& request : requests)
+        {
+            request.Resource = &resources[rng() % resources.size()];
+            request.State = FrameStates[rng() % std::size(FrameStates)];
+
+            if (rng() % 4 == 0)
+            {
+                for (auto subresourceIdx = 0u; subresourceIdx < request.Resource->SubresourceCount(); ++subresourceIdx)
+                {
+                    if (rng() % 2 == 0)
+                    {
+                        request.States.push_back({ subresourceIdx, FrameStates[rng() % std::size(FrameStates)] });
+                    }
+                }
+            }
+        }
+
+        return requests;
+    }
+
+    using ShadowStates = std::unordered_map<const FakeResource*, std::vector<ResourceState>>;
+
+    ShadowStates MakeShadowStates(const std::vector<FakeResource>& resources)
+    {
+        ShadowStates shadowStates;
+
+        for (const FakeResource& resource : resources)
+        {
+            shadowStates[&resource].assign(resource.SubresourceCount(), resource.InitialStates());
+        }
+
+        return shadowStates;
+    }
+
+    // Replays transitions on per-subresource states, returns number of transitions whose old state didn't match
+    uint64_t ReplayTransitions(const StateTable::TransitionList& transitions, ShadowStates& shadowStates)
+    {
+        uint64_t mismatchCount = 0;
+
+        for (const StateTable::Transition& transition : transitions)
+        {
+            std::vector<ResourceState>& states = shadowStates[transition.TransitionedResource];
+            uint64_t first = transition.SubresourceIndex.value_or(0);
+            uint64_t last = transition.SubresourceIndex ? first + 1 : states.size();
+
+            for (uint64_t subresourceIdx = first; subresourceIdx < last; ++subresourceIdx)
+            {
+                mismatchCount += states[subresourceIdx] != transition.OldState;
+                states[subresourceIdx] = transition.NewState;
+            }
+        }
+
+        return mismatchCount;
+    }
+
+    bool StatesMatch(const StateTable& table, const FakeResource& resource, const std::vector<ResourceState>& expectedStates)
+    {
+        StateTable::SubresourceStateList states = table.CurrentStates(&resource);
+
+        for (const StateTable::SubresourceState& state : states)
+        {
+            if (state.State != expectedStates[state.SubresourceIndex])
+            {
+                return false;
+            }
+        }
+
+        return states.size() == expectedStates.size();
+    }
+
+    // Layout the table replaced: states of each resource in its own vector, looked up by resource pointer
+    class HashedStateModel
+    {
+    public:
+        void StartTracking(const FakeResource* resource)
+        {
+            mStates[resource].assign(resource->SubresourceCount(), resource->InitialStates());
+        }
+
+        // Same redundancy and collapsing rules as the table
+        void TransitionToState(const FakeResource* resource, ResourceState newState, StateTable::TransitionList& transitions)
+        {
+            std::vector<ResourceState>& states = mStates.at(resource);
+            size_t firstTransitionIndex = transitions.size();
+            bool statesMatch = true;
+
+            for (auto subresourceIdx = 0u; subresourceIdx < states.size(); ++subresourceIdx)
+            {
+                ResourceState oldState = states[subresourceIdx];
+
+                if (oldState == newState || (HAL::IsResourceStateReadOnly(oldState) && EnumMaskEquals(oldState, newState)))
+                {
+                    continue;
+                }
+
+                statesMatch = statesMatch && (transitions.size() == firstTransitionIndex || transitions[firstTransitionIndex].OldState == oldState);
+                transitions.push_back({ resource, oldState, newState, subresourceIdx });
+                states[subresourceIdx] = newState;
+            }
+
+            if (statesMatch && transitions.size() - firstTransitionIndex == states.size() && states.size() > 1)
+            {
+                ResourceState oldState = transitions[firstTransitionIndex].OldState;
+                transitions.resize(firstTransitionIndex);
+                transitions.push_back({ resource, oldState, newState, std::nullopt });
+            }
+        }
+
+    private:
+        std::unordered_map<const FakeResource*, std::vector<ResourceState>> mStates;
+    };
+
+}
+
+PF_TEST(SubresourceStateTableBatchedMatchesImmediate)
+{
+    std::vector<FakeResource> batchedResources = MakeResources(3000, 1);
+    std::vector<FakeResource> immediateResources = batchedResources;
+
+    StateTable batchedTable;
+    StateTable immediateTable;
+
+    for (FakeResource& resource : batchedResources) batchedTable.StartTracking(&resource);
+    for (FakeResource& resource : immediateResources) immediateTable.StartTracking(&resource);
+
+    ShadowStates batchedShadow = MakeShadowStates(batchedResources);
+    ShadowStates immediateShadow = MakeShadowStates(immediateResources);
+
+    std::mt19937 rng{ 7 };
+
+    for (uint64_t frame = 0; frame < 20; ++frame)
+    {
+        std::vector<Request> requests = MakeFrameRequests(batchedResources, 2000, rng);
+        StateTable::TransitionList batchedTransitions;
+        StateTable::TransitionList immediateTransitions;
+
+        for (const Request& request : requests)
+        {
+            FakeResource* immediateResource = &immediateResources[request.Resource - &batchedResources[0]];
+
+            if (request.States.empty())
+            {
+                batchedTable.RequestTransition(request.Resource, request.State);
+                immediateTable.TransitionToState(immediateResource, request.State, false, immediateTransitions);
+            }
+            else
+            {
+                batchedTable.RequestTransitions(request.Resource, request.States);
+                immediateTable.TransitionToStates(immediateResource, request.States, false, immediateTransitions);
+            }
+        }
+
+        batchedTable.ApplyRequestedTransitions(false, batchedTransitions);
+
+        PF_CHECK(ReplayTransitions(batchedTransitions, batchedShadow) == 0, "Frame ", frame, ": batched old states don't match");
+        PF_CHECK(ReplayTransitions(immediateTransitions, immediateShadow) == 0, "Frame ", frame, ": immediate old states don't match");
+        PF_CHECK(batchedTable.PendingTransitionCount() == 0);
+    }
+
+    for (uint64_t resourceIdx = 0; resourceIdx < batchedResources.size(); ++resourceIdx)
+    {
+        const FakeResource& batchedResource = batchedResources[resourceIdx];
+        const FakeResource& immediateResource = immediateResources[resourceIdx];
+
+        PF_CHECK(StatesMatch(batchedTable, batchedResource, batchedShadow[&batchedResource]), "Resource ", resourceIdx, ": batched states diverged from barriers");
+        PF_CHECK(StatesMatch(immediateTable, immediateResource, immediateShadow[&immediateResource]), "Resource ", resourceIdx, ": immediate states diverged from barriers");
+        PF_CHECK(StatesMatch(batchedTable, batchedResource, immediateShadow[&immediateResource]), "Resource ", resourceIdx, ": batched and immediate final states differ");
+    }
+}
+
+PF_TEST(SubresourceStateTableCollapsesWholeResourceTransitions)
+{
+    StateTable table;
+    FakeResource texture{ 6, ResourceState::RenderTarget };
+    FakeResource buffer{ 1, ResourceState::CopyDestination, true };
+
+    table.StartTracking(&texture);
+    table.StartTracking(&buffer);
+
+    StateTable::TransitionList transitions;
+    table.TransitionToState(&texture, ResourceState::PixelShaderAccess, false, transitions);
+
+    PF_CHECK(transitions.size() == 1 && !transitions[0].SubresourceIndex, "Identical subresource transitions weren't collapsed");
+
+    // One mip left behind: collapsing would transition it from a wrong state
+    transitions.clear();
+    table.TransitionToStates(&texture, { { 2, ResourceState::UnorderedAccess } }, false, transitions);
+    table.TransitionToState(&texture, ResourceState::RenderTarget, false, transitions);
+
+    PF_CHECK(transitions.size() == 7, "Transitions: ", transitions.size());
+    PF_CHECK(transitions[1].SubresourceIndex && transitions[3].SubresourceIndex == 2 && transitions[3].OldState == ResourceState::UnorderedAccess);
+
+    // Read state already containing the requested one needs no barrier
+    transitions.clear();
+    table.TransitionToState(&texture, ResourceState::AnyShaderAccess, false, transitions);
+    table.TransitionToState(&texture, ResourceState::PixelShaderAccess, false, transitions);
+
+    PF_CHECK(transitions.size() == 1);
+
+    // Batched whole resource requests are collapsed individually
+    transitions.clear();
+    table.RequestTransition(&texture, ResourceState::UnorderedAccess);
+    table.RequestTransition(&texture, ResourceState::CopySource);
+    table.ApplyRequestedTransitions(false, transitions);
+
+    PF_CHECK(transitions.size() == 2 && !transitions[0].SubresourceIndex && !transitions[1].SubresourceIndex, "Transitions: ", transitions.size());
+
+    // Buffers promote and decay implicitly when allowed
+    transitions.clear();
+    table.TransitionToState(&buffer, ResourceState::UnorderedAccess, true, transitions);
+
+    PF_CHECK(transitions.empty());
+    PF_CHECK(table.CurrentStates(&buffer)[0].State == ResourceState::UnorderedAccess);
+}
+
+PF_TEST(SubresourceStateTableReusesStoppedIndices)
+{
+    std::vector<FakeResource> resources = MakeResources(2000, 2);
+    StateTable table;
+
+    for (FakeResource& resource : resources)
+    {
+        table.StartTracking(&resource);
+    }
+
+    std::mt19937 rng{ 3 };
+
+    for (uint64_t round = 0; round < 10; ++round)
+    {
+        // Requests are pending when a resource goes away
+        std::vector<FakeResource*> stopped;
+
+        for (uint64_t i = 0; i < 300; ++i)
+        {
+            FakeResource& resource = resources[rng() % resources.size()];
+
+            if (resource.StateTrackingIndex() == FakeResource::InvalidStateTrackingIndex)
+            {
+                continue;
+            }
+
+            table.RequestTransition(&resource, ResourceState::UnorderedAccess);
+            table.StopTracking(&resource);
+            stopped.push_back(&resource);
+
+            PF_CHECK(resource.StateTrackingIndex() == FakeResource::InvalidStateTrackingIndex);
+        }
+
+        // New resources take freed indices and start from their own initial states
+        std::vector<FakeResource> newResources = MakeResources(stopped.size(), 100 + round);
+
+        for (uint64_t i = 0; i < stopped.size(); ++i)
+        {
+            table.StartTracking(&newResources[i]);
+            PF_CHECK(StatesMatch(table, newResources[i], std::vector<ResourceState>(newResources[i].SubresourceCount(), newResources[i].InitialStates())),
+                "Round ", round, ": new resource inherited stale states");
+        }
+
+        PF_CHECK(table.TrackingIndexCount() == resources.size(), "Round ", round, ": tracking indices grew to ", table.TrackingIndexCount());
+
+        StateTable::TransitionList transitions;
+        table.ApplyRequestedTransitions(false, transitions);
+
+        for (const StateTable::Transition& transition : transitions)
+        {
+            PF_CHECK(transition.TransitionedResource->StateTrackingIndex() != FakeResource::InvalidStateTrackingIndex, "Round ", round, ": request of a stopped resource was applied");
+        }
+
+        PF_CHECK(transitions.empty(), "Round ", round, ": ", transitions.size(), " transitions of stopped resources");
+
+        // Replace stopped resources with the new ones so that the next round stops both kinds
+        for (uint64_t i = 0; i < stopped.size(); ++i)
+        {
+            table.StopTracking(&newResources[i]);
+            *stopped[i] = newResources[i];
+            stopped[i]->SetStateTrackingIndex(FakeResource::InvalidStateTrackingIndex);
+            table.StartTracking(stopped[i]);
+        }
+    }
+}
+
+PF_TEST(SubresourceStateTableCompactsArena)
+{
+    std::vector<FakeResource> resources;
+
+    for (uint64_t i = 0; i < 2000; ++i)
+    {
+        resources.emplace_back(1 + i % 8, FrameStates[i % std::size(FrameStates)]);
+    }
+
+    StateTable table;
+    uint64_t stateCount = 0;
+
+    for (FakeResource& resource : resources)
+    {
+        table.StartTracking(&resource);
+        stateCount += resource.SubresourceCount();
+    }
+
+    PF_CHECK(table.ArenaSize() == stateCount);
+
+    // Give every resource distinct per-subresource states that must survive compaction
+    ShadowStates shadowStates = MakeShadowStates(resources);
+
+    for (FakeResource& resource : resources)
+    {
+        StateTable::SubresourceStateList states;
+
+        for (auto subresourceIdx = 0u; subresourceIdx < resource.SubresourceCount(); ++subresourceIdx)
+        {
+            ResourceState state = FrameStates[(subresourceIdx + resource.SubresourceCount()) % std::size(FrameStates)];
+            states.push_back({ subresourceIdx, state });
+            shadowStates[&resource][subresourceIdx] = state;
+        }
+
+        table.RequestTransitions(&resource, states);
+    }
+
+    StateTable::TransitionList transitions;
+    table.ApplyRequestedTransitions(false, transitions);
+
+    // A freed range is reused by a resource with the same subresource count without growing the arena
+    FakeResource replacement{ resources[5].SubresourceCount(), ResourceState::Common };
+    table.StopTracking(&resources[5]);
+    table.StartTracking(&replacement);
+
+    PF_CHECK(table.ArenaSize() == stateCount && table.FreeStateCount() == 0);
+
+    table.StopTracking(&replacement);
+    table.StartTracking(&resources[5]);
+    shadowStates[&resources[5]].assign(resources[5].SubresourceCount(), resources[5].InitialStates());
+
+    // Stop three quarters of resources: arena is compacted once more than a half of it is free
+    uint64_t liveStateCount = stateCount;
+
+    for (uint64_t i = 0; i < resources.size(); ++i)
+    {
+        if (i % 4 != 0)
+        {
+            table.StopTracking(&resources[i]);
+            liveStateCount -= resources[i].SubresourceCount();
+        }
+    }
+
+    PF_CHECK(table.ArenaSize() < stateCount / 2, "Arena wasn't compacted: ", table.ArenaSize(), " of ", stateCount);
+    PF_CHECK(table.ArenaSize() - table.FreeStateCount() == liveStateCount, "Live states: ", table.ArenaSize() - table.FreeStateCount(), " expected ", liveStateCount);
+
+    for (uint64_t i = 0; i < resources.size(); i += 4)
+    {
+        PF_CHECK(StatesMatch(table, resources[i], shadowStates[&resources[i]]), "Resource ", i, " lost its states during compaction");
+    }
+}
+
+PF_BENCHMARK(SubresourceStateTableBarrierGeneration)
+{
+    constexpr uint64_t FrameCount = 100;
+    constexpr uint64_t RequestsPerFrame = 4000;
+
+    std::vector<FakeResource> resources = MakeResources(5000, 4);
+    StateTable batchedTable;
+    StateTable immediateTable;
+    HashedStateModel hashedModel;
+
+    std::vector<FakeResource> immediateResources = resources;
+
+    for (FakeResource& resource : resources)
+    {
+        batchedTable.StartTracking(&resource);
+        hashedModel.StartTracking(&resource);
+    }
+
+    for (FakeResource& resource : immediateResources)
+    {
+        immediateTable.StartTracking(&resource);
+    }
+
+    std::mt19937 rng{ 5 };
+    std::vector<std::vector<Request>> frames;
+
+    for (uint64_t frame = 0; frame < FrameCount; ++frame)
+    {
+        frames.push_back(MakeFrameRequests(resources, RequestsPerFrame, rng));
+    }
+
+    StateTable::TransitionList transitions;
+    uint64_t batchedTransitionCount = 0;
+    Testing::Stopwatch batchedStopwatch;
+
+    for (const std::vector<Request>& requests : frames)
+    {
+        for (const Request& request : requests)
+        {
+            if (request.States.empty()) batchedTable.RequestTransition(request.Resource, request.State);
+            else batchedTable.RequestTransitions(request.Resource, request.States);
+        }
+
+        transitions.clear();
+        batchedTable.ApplyRequestedTransitions(false, transitions);
+        batchedTransitionCount += transitions.size();
+    }
+
+    double batchedMilliseconds = batchedStopwatch.ElapsedMilliseconds();
+
+    uint64_t immediateTransitionCount = 0;
+    Testing::Stopwatch immediateStopwatch;
+
+    for (const std::vector<Request>& requests : frames)
+    {
+        transitions.clear();
+
+        for (const Request& request : requests)
+        {
+            FakeResource* resource = &immediateResources[request.Resource - &resources[0]];
+
+            if (request.States.empty()) immediateTable.TransitionToState(resource, request.State, false, transitions);
+            else immediateTable.TransitionToStates(resource, request.States, false, transitions);
+        }
+
+        immediateTransitionCount += transitions.size();
+    }
+
+    double immediateMilliseconds = immediateStopwatch.ElapsedMilliseconds();
+
+    // Whole resource requests only, as the hashed layout is modelled for those
+    Testing::Stopwatch tableWholeStopwatch;
+
+    for (const std::vector<Request>& requests : frames)
+    {
+        transitions.clear();
+
+        for (const Request& request : requests)
+        {
+            immediateTable.TransitionToState(&immediateResources[request.Resource - &resources[0]], request.State, false, transitions);
+        }
+    }
+
+    double tableWholeMilliseconds = tableWholeStopwatch.ElapsedMilliseconds();
+
+    Testing::Stopwatch hashedStopwatch;
+
+    for (const std::vector<Request>& requests : frames)
+    {
+        transitions.clear();
+
+        for (const Request& request : requests)
+        {
+            hashedModel.TransitionToState(request.Resource, request.State, transitions);
+        }
+    }
+
+    double hashedMilliseconds = hashedStopwatch.ElapsedMilliseconds();
+
+    Testing::Report("Batched frame", batchedMilliseconds / FrameCount, "ms");
+    Testing::Report("Batched barriers per frame", double(batchedTransitionCount) / FrameCount, "");
+    Testing::Report("Immediate frame", immediateMilliseconds / FrameCount, "ms");
+    Testing::Report("Immediate barriers per frame", double(immediateTransitionCount) / FrameCount, "");
+    Testing::Report("Whole resource transitions, flat arena", tableWholeMilliseconds / FrameCount, "ms");
+    Testing::Report("Whole resource transitions, hashed per-resource states", hashedMilliseconds / FrameCount, "ms");
+}
@@ -0,0 +1,303 @@
+#include "../Testing.hpp"
+
+#include <Memory/TLSFAllocator.hpp>
+
+#include <random>
+#include <map>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+
+    using Memory::TLSFAllocator;
+
+    bool HasOverlaps(const std::vector<TLSFAllocator::Allocation>& allocations)
+    {
+        std::map<uint64_t, uint64_t> sizesByOffset;
+
+        for (const TLSFAllocator::Allocation& allocation : allocations)
+        {
+            sizesByOffset[allocation.Offset] = allocation.Size;
+        }
+
+        uint64_t previousEnd = 0;
+
+        for (auto [offset, size] : sizesByOffset)
+        {
+            if (offset < previousEnd)
+                return true;
+
+            previousEnd = offset + size;
+        }
+
+        return sizesByOffset.size() != allocations.size();
+    }
+
+    // Allocation event of a replayed trace
+    struct TraceEvent
+    {
+        uint64_t Size = 0;
+        uint64_t Alignment = 0;
+
+        // Index of allocation event to free instead of allocating, if any
+        int64_t FreedEventIndex = -1;
+    };
+
+    // Resource-like allocation trace: mip chained textures of power of two dimensions
+    // and buffers of arbitrary size, allocated and freed in bursts as when streaming scene content
+    std::vector<TraceEvent> GenerateResourceTrace(uint64_t eventCount, uint32_t seed)
+    {
+        std::mt19937_64 rng{ seed };
+        std::vector<TraceEvent> events;
+        std::vector<uint64_t> liveEventIndices;
+
+        while (events.size() < eventCount)
+        {
+            bool shouldFree = liveEventIndices.size() > 64 && rng() % 100 < 48;
+
+            if (shouldFree)
+            {
+                uint64_t liveIdx = rng() % liveEventIndices.size();
+                events.push_back({ 0, 0, int64_t(liveEventIndices[liveIdx]) });
+                liveEventIndices[liveIdx] = liveEventIndices.back();
+                liveEventIndices.pop_back();
+                continue;
+            }
+
+            TraceEvent event;
+
+            if (rng() % 3 == 0)
+            {
+                uint64_t width = 1ull << (4 + rng() % 8);
+                uint64_t height = rng() % 2 ? width : width / 2;
+                uint64_t bytesPerPixel = rng() % 2 ? 4 : 1;
+                event.Size = width * height * bytesPerPixel * 4 / 3;
+                event.Alignment = 64 * 1024;
+            }
+            else
+            {
+                event.Size = 256 + rng() % (rng() % 4 == 0 ? 4 * 1024 * 1024 : 64 * 1024);
+                event.Alignment = 256;
+            }
+
+            liveEventIndices.push_back(events.size());
+            events.push_back(event);
+        }
+
+        return events;
+    }
+
+    // Model of the power-of-two segregated pools the TLSF allocator replaced:
+    // sizes round up to a power of two of at least 64 KB, pools grow by one slot and never shrink
+    class PowerOfTwoPoolsModel
+    {
+    public:
+        struct Allocation
+        {
+            uint32_t BucketIndex = 0;
+            uint64_t SlotIndex = 0;
+        };
+
+        Allocation Allocate(uint64_t size)
+        {
+            uint32_t bucketIndex = std::max(16u, uint32_t(std::ceil(std::log2((double)size))));
+
+            if (bucketIndex >= mBuckets.size())
+                mBuckets.resize(bucketIndex + 1);
+
+            Bucket& bucket = mBuckets[bucketIndex];
+
+            if (bucket.FreeSlots.empty())
+            {
+                mReservedSize += 1ull << bucketIndex;
+                return { bucketIndex, bucket.SlotCount++ };
+            }
+
+            uint64_t slotIndex = bucket.FreeSlots.back();
+            bucket.FreeSlots.pop_back();
+            return { bucketIndex, slotIndex };
+        }
+
+        void Deallocate(const Allocation& allocation)
+        {
+            mBuckets[allocation.BucketIndex].FreeSlots.push_back(allocation.SlotIndex);
+        }
+
+        uint64_t ReservedSize() const { return mReservedSize; }
+
+    private:
+        struct Bucket
+        {
+            std::vector<uint64_t> FreeSlots;
+            uint64_t SlotCount = 0;
+        };
+
+        std::vector<Bucket> mBuckets;
+        uint64_t mReservedSize = 0;
+    };
+
+}
+
+PF_TEST(TLSFAllocatorRespectsAlignmentAndBounds)
+{
+    TLSFAllocator allocator{ 64ull * 1024 * 1024, 256 };
+    std::vector<TLSFAllocator::Allocation> liveAllocations;
+    std::mt19937_64 rng{ 1 };
+
+    for (uint64_t step = 0; step < 200000; ++step)
+    {
+        if (liveAllocations.empty() || rng() % 2)
+        {
+            uint64_t size = 1 + rng() % (1 << 20);
+            uint64_t alignment = 1ull << (rng() % 17);
+
+            if (std::optional<TLSFAllocator::Allocation> allocation = allocator.Allocate(size, alignment))
+            {
+                PF_CHECK(allocation->Offset % std::max<uint64_t>(alignment, 256) == 0, "Offset: ", allocation->Offset, " Alignment: ", alignment);
+                PF_CHECK(allocation->Size >= size && allocation->Size % 256 == 0, "Size: ", allocation->Size, " Requested: ", size);
+                PF_CHECK(allocation->Offset + allocation->Size <= allocator.Capacity());
+                liveAllocations.push_back(*allocation);
+            }
+        }
+        else
+        {
+            uint64_t liveIdx = rng() % liveAllocations.size();
+            allocator.Deallocate(liveAllocations[liveIdx]);
+            liveAllocations[liveIdx] = liveAllocations.back();
+            liveAllocations.pop_back();
+        }
+
+        if (step % 10000 == 0)
+        {
+            PF_CHECK(!HasOverlaps(liveAllocations), "Step: ", step);
+        }
+    }
+
+    PF_CHECK(allocator.AllocationCount() == liveAllocations.size());
+}
+
+PF_TEST(TLSFAllocatorCoalescesFreedBlocks)
+{
+    constexpr uint64_t Capacity = 16 * 1024 * 1024;
+    TLSFAllocator allocator{ Capacity, 256 };
+    std::vector<TLSFAllocator::Allocation> allocations;
+
+    // Fill the whole range with blocks of varying size
+    std::mt19937_64 rng{ 2 };
+
+    while (std::optional<TLSFAllocator::Allocation> allocation = allocator.Allocate(256 * (1 + rng() % 64)))
+    {
+        allocations.push_back(*allocation);
+    }
+
+    // Good fit search may skip a remainder smaller than the request, fill it with granules
+    while (std::optional<TLSFAllocator::Allocation> allocation = allocator.Allocate(256))
+    {
+        allocations.push_back(*allocation);
+    }
+
+    PF_CHECK(allocator.AllocatedSize() == Capacity, "Allocated: ", allocator.AllocatedSize());
+    PF_CHECK(!HasOverlaps(allocations));
+
+    std::shuffle(allocations.begin(), allocations.end(), rng);
+
+    for (const TLSFAllocator::Allocation& allocation : allocations)
+    {
+        allocator.Deallocate(allocation);
+    }
+
+    PF_CHECK(allocator.IsEmpty() && allocator.AllocatedSize() == 0);
+
+    // Only possible if every freed neighbour was merged back
+    std::optional<TLSFAllocator::Allocation> wholeRange = allocator.Allocate(Capacity);
+    PF_CHECK(wholeRange && wholeRange->Offset == 0 && wholeRange->Size == Capacity);
+}
+
+PF_TEST(TLSFAllocatorFailsOnlyWhenOutOfSpace)
+{
+    TLSFAllocator allocator{ 1024 * 1024, 256 };
+
+    PF_CHECK(allocator.Allocate(2 * 1024 * 1024) == std::nullopt);
+
+    std::optional<TLSFAllocator::Allocation> first = allocator.Allocate(512 * 1024);
+    std::optional<TLSFAllocator::Allocation> second = allocator.Allocate(512 * 1024);
+
+    PF_CHECK(first && second);
+    PF_CHECK(allocator.Allocate(256) == std::nullopt);
+
+    allocator.Deallocate(*first);
+
+    std::optional<TLSFAllocator::Allocation> third = allocator.Allocate(256 * 1024, 256 * 1024);
+    PF_CHECK(third && third->Offset == first->Offset, "Freed space is expected to be reused");
+}
+
+PF_BENCHMARK(TLSFAllocatorTraceReplay)
+{
+    constexpr uint64_t EventCount = 400000;
+    std::vector<TraceEvent> trace = GenerateResourceTrace(EventCount, 3);
+
+    uint64_t liveSize = 0;
+    uint64_t peakLiveSize = 0;
+
+    for (const TraceEvent& event : trace)
+    {
+        liveSize = event.FreedEventIndex >= 0 ? liveSize - trace[event.FreedEventIndex].Size : liveSize + event.Size;
+        peakLiveSize = std::max(peakLiveSize, liveSize);
+    }
+
+    // TLSF in a range large enough for the whole trace, reserved memory is the highest used offset
+    {
+        TLSFAllocator allocator{ 1ull << 40, 256 };
+        std::vector<TLSFAllocator::Allocation> allocations(trace.size());
+        uint64_t peakEnd = 0;
+
+        Testing::Stopwatch stopwatch;
+
+        for (uint64_t eventIdx = 0; eventIdx < trace.size(); ++eventIdx)
+        {
+            const TraceEvent& event = trace[eventIdx];
+
+            if (event.FreedEventIndex >= 0)
+            {
+                allocator.Deallocate(allocations[event.FreedEventIndex]);
+            }
+            else
+            {
+                allocations[eventIdx] = *allocator.Allocate(event.Size, event.Alignment);
+                peakEnd = std::max(peakEnd, allocations[eventIdx].Offset + allocations[eventIdx].Size);
+            }
+        }
+
+        double elapsed = stopwatch.ElapsedMilliseconds();
+
+        Testing::Report("TLSF: time per operation", elapsed * 1e6 / trace.size(), "ns");
+        Testing::Report("TLSF: reserved / peak live memory", double(peakEnd) / peakLiveSize, "");
+    }
+
+    {
+        PowerOfTwoPoolsModel pools;
+        std::vector<PowerOfTwoPoolsModel::Allocation> allocations(trace.size());
+
+        Testing::Stopwatch stopwatch;
+
+        for (uint64_t eventIdx = 0; eventIdx < trace.size(); ++eventIdx)
+        {
+            const TraceEvent& event = trace[eventIdx];
+
+            if (event.FreedEventIndex >= 0)
+            {
+                pools.Deallocate(allocations[event.FreedEventIndex]);
+            }
+            else
+            {
+                allocations[eventIdx] = pools.Allocate(event.Size);
+            }
+        }
+
+        double elapsed = stopwatch.ElapsedMilliseconds();
+
+        Testing::Report("Power-of-two pools: time per operation", elapsed * 1e6 / trace.size(), "ns");
+        Testing::Report("Power-of-two pools: reserved / peak live memory", double(pools.ReservedSize()) / peakLiveSize, "");
+    }
+}
@@ -0,0 +1,214 @@
+#include "../Testing.hpp"
+
+#include <Memory/TransientLinearAllocator.hpp>
+
+#include <random>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+namespace
+{
+
+    constexpr HAL::GPUAddress BaseGPUAddress = 0x100000000;
+
+    // Allocator never touches the GPU, so tests back it with plain memory and a made up GPU address
+    struct TransientAllocatorFixture
+    {
+        TransientAllocatorFixture(uint64_t capacity, uint64_t pageSize)
+            : Memory(capacity), Allocator{ Memory.data(), BaseGPUAddress, capacity, pageSize } {}
+
+        std::vector<uint8_t> Memory;
+        Memory::TransientLinearAllocator Allocator;
+    };
+
+}
+
+PF_TEST(TransientLinearAllocatorAlignsAllocations)
+{
+    TransientAllocatorFixture fixture{ 1024 * 1024, 16 * 1024 };
+    Memory::TransientLinearAllocator::Context context;
+
+    for (uint64_t i = 0; i < 600; ++i)
+    {
+        uint64_t alignments[] = { 1, 4, 16, 256, 512, 4096 };
+        uint64_t alignment = alignments[i % std::size(alignments)];
+        uint64_t size = 1 + i % 300;
+
+        std::optional<Memory::TransientLinearAllocator::Allocation> allocation = fixture.Allocator.Allocate(context, size, alignment);
+
+        PF_CHECK(allocation.has_value(), "Allocation: ", i);
+
+        if (allocation)
+        {
+            uint64_t offset = allocation->GPUAddress - BaseGPUAddress;
+
+            PF_CHECK(allocation->GPUAddress % alignment == 0, "Address: ", allocation->GPUAddress, " Alignment: ", alignment);
+            PF_CHECK(allocation->CPUAddress == fixture.Memory.data() + offset);
+            PF_CHECK(offset + size <= fixture.Allocator.Capacity());
+        }
+    }
+
+    // Default alignment satisfies constant buffer placement
+    std::optional<Memory::TransientLinearAllocator::Allocation> allocation = fixture.Allocator.Allocate(context, 3);
+    PF_CHECK(allocation && allocation->GPUAddress % Memory::TransientLinearAllocator::ConstantBufferAlignment == 0);
+}
+
+PF_TEST(TransientLinearAllocatorSharesPagesWithinFrame)
+{
+    TransientAllocatorFixture fixture{ 64 * 1024, 16 * 1024 };
+    Memory::TransientLinearAllocator::Context context;
+
+    std::optional<Memory::TransientLinearAllocator::Allocation> first = fixture.Allocator.Allocate(context, 256);
+    std::optional<Memory::TransientLinearAllocator::Allocation> second = fixture.Allocator.Allocate(context, 256);
+
+    PF_CHECK(first && second && second->GPUAddress == first->GPUAddress + 256);
+
+    // A finished frame's page is never appended to
+    fixture.Allocator.FinishCurrentFrame(1);
+    std::optional<Memory::TransientLinearAllocator::Allocation> third = fixture.Allocator.Allocate(context, 256);
+
+    PF_CHECK(third && third->GPUAddress == BaseGPUAddress + fixture.Allocator.PageSize());
+}
+
+PF_TEST(TransientLinearAllocatorReclaimsMemoryOnFence)
+{
+    TransientAllocatorFixture fixture{ 64 * 1024, 16 * 1024 };
+    Memory::TransientLinearAllocator::Context context;
+
+    // Oversized allocations take their own page
+    PF_CHECK(fixture.Allocator.Allocate(context, 40 * 1024).has_value());
+    fixture.Allocator.FinishCurrentFrame(1);
+
+    PF_CHECK(!fixture.Allocator.Allocate(context, 40 * 1024).has_value());
+
+    fixture.Allocator.EndFrame(0);
+    PF_CHECK(!fixture.Allocator.Allocate(context, 40 * 1024).has_value());
+
+    fixture.Allocator.EndFrame(1);
+    std::optional<Memory::TransientLinearAllocator::Allocation> allocation = fixture.Allocator.Allocate(context, 40 * 1024);
+    PF_CHECK(allocation && allocation->GPUAddress == BaseGPUAddress);
+}
+
+PF_TEST(TransientLinearAllocatorKeepsInFlightDataIntactAcrossThreads)
+{
+    // Several threads allocate with their own contexts each frame and fill allocations with a frame and thread tag.
+    // Frames are retired by a simulated GPU two frames behind, data of frames in flight must stay intact.
+    constexpr uint64_t ThreadCount = 8;
+    constexpr uint64_t FramesInFlight = 2;
+
+    TransientAllocatorFixture fixture{ 4 * 1024 * 1024, 16 * 1024 };
+
+    struct Record
+    {
+        uint8_t* CPUAddress;
+        uint64_t Size;
+        uint8_t Tag;
+    };
+
+    std::vector<Memory::TransientLinearAllocator::Context> contexts(ThreadCount);
+    std::vector<std::vector<Record>> threadRecords(ThreadCount);
+    std::vector<std::vector<Record>> framesInFlight;
+    std::atomic<uint64_t> misalignedCount = 0;
+    uint64_t allocationCount = 0;
+
+    for (uint64_t frameNumber = 1; frameNumber <= 1000; ++frameNumber)
+    {
+        std::vector<std::thread> threads;
+
+        for (uint64_t threadIdx = 0; threadIdx < ThreadCount; ++threadIdx)
+        {
+            threads.emplace_back([&, threadIdx]
+            {
+                std::mt19937_64 rng{ frameNumber * 131 + threadIdx };
+                std::vector<Record>& records = threadRecords[threadIdx];
+                uint8_t tag = uint8_t(frameNumber * ThreadCount + threadIdx);
+                uint64_t allocationsInFrame = rng() % 200;
+
+                records.clear();
+
+                for (uint64_t i = 0; i < allocationsInFrame; ++i)
+                {
+                    uint64_t size = 16 + rng() % 600;
+                    uint64_t alignment = rng() % 4 ? 256 : 16;
+
+                    std::optional<Memory::TransientLinearAllocator::Allocation> allocation = fixture.Allocator.Allocate(contexts[threadIdx], size, alignment);
+
+                    if (!allocation)
+                    {
+                        continue;
+                    }
+
+                    if (allocation->GPUAddress % alignment != 0)
+                    {
+                        ++misalignedCount;
+                    }
+
+                    std::fill(allocation->CPUAddress, allocation->CPUAddress + size, tag);
+                    records.push_back({ allocation->CPUAddress, size, tag });
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        std::vector<Record> frameRecords;
+
+        for (const std::vector<Record>& records : threadRecords)
+        {
+            frameRecords.insert(frameRecords.end(), records.begin(), records.end());
+        }
+
+        allocationCount += frameRecords.size();
+        framesInFlight.push_back(std::move(frameRecords));
+        fixture.Allocator.FinishCurrentFrame(frameNumber);
+
+        for (const std::vector<Record>& records : framesInFlight)
+        {
+            for (const Record& record : records)
+            {
+                bool intact = std::all_of(record.CPUAddress, record.CPUAddress + record.Size,
+                    [&record](uint8_t value) { return value == record.Tag; });
+
+                PF_CHECK(intact, "Frame: ", frameNumber, " Size: ", record.Size);
+            }
+        }
+
+        if (frameNumber >= FramesInFlight)
+        {
+            fixture.Allocator.EndFrame(frameNumber - FramesInFlight + 1);
+            framesInFlight.erase(framesInFlight.begin());
+        }
+    }
+
+    PF_CHECK(misalignedCount == 0, "Misaligned: ", misalignedCount.load());
+    PF_CHECK(allocationCount > 0);
+}
+
+PF_BENCHMARK(TransientLinearAllocatorAllocation)
+{
+    constexpr uint64_t FrameCount = 100;
+    constexpr uint64_t AllocationsPerFrame = 5000;
+
+    TransientAllocatorFixture fixture{ 16 * 1024 * 1024, 16 * 1024 };
+    Memory::TransientLinearAllocator::Context context;
+    uint64_t allocationCount = 0;
+
+    Testing::Stopwatch stopwatch;
+
+    for (uint64_t frameNumber = 1; frameNumber <= FrameCount; ++frameNumber)
+    {
+        for (uint64_t i = 0; i < AllocationsPerFrame; ++i)
+        {
+            allocationCount += fixture.Allocator.Allocate(context, 64).has_value();
+        }
+
+        fixture.Allocator.FinishCurrentFrame(frameNumber);
+        fixture.Allocator.EndFrame(frameNumber);
+    }
+
+    Testing::Report("Constant buffer allocation", stopwatch.ElapsedMilliseconds() * 1e6 / allocationCount, "ns/op");
+}
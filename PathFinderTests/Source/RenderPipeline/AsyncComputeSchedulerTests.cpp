@@ -0,0 +1,266 @@
+#include "../Testing.hpp"
+
+#include <RenderPipeline/AsyncComputeScheduler.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+
+    using PathFinder::RenderPassGraph;
+    using PathFinder::AsyncComputeScheduler;
+
+    constexpr uint64_t GraphicsQueue = 0;
+    constexpr uint64_t AsyncComputeQueue = 1;
+
+    struct SyntheticPass
+    {
+        std::string Name;
+        std::vector<std::string> Reads;
+        std::vector<std::string> Writes;
+        float DurationSeconds = 0.0f;
+        bool IsAsyncComputeEligible = false;
+        uint64_t ScheduledQueue = GraphicsQueue;
+    };
+
+    // Frame described by a table of passes with their resources and GPU timings
+    class SyntheticFrame
+    {
+    public:
+        SyntheticFrame(std::vector<SyntheticPass> passes)
+            : mPasses{ std::move(passes) }
+        {
+            for (const SyntheticPass& pass : mPasses)
+            {
+                mGraph.AddPass({ pass.Name });
+            }
+        }
+
+        // Schedules and compiles a frame the way RenderEngine does: decisions override queues of eligible passes
+        void Build(const AsyncComputeScheduler& scheduler)
+        {
+            mGraph.Clear();
+
+            for (uint64_t passIdx = 0; passIdx < mPasses.size(); ++passIdx)
+            {
+                const SyntheticPass& pass = mPasses[passIdx];
+                RenderPassGraph::Node& node = mGraph.Nodes()[passIdx];
+
+                for (const std::string& resource : pass.Writes) node.AddWriteDependency(resource, std::nullopt, 1);
+                for (const std::string& resource : pass.Reads) node.AddReadDependency(resource, 1);
+
+                node.ExecutionQueueIndex = pass.ScheduledQueue;
+                node.IsAsyncComputeEligible = pass.IsAsyncComputeEligible;
+            }
+
+            scheduler.AssignQueues(mGraph);
+            mGraph.Build();
+        }
+
+        // Timings of a number of frames, optionally with measurement noise
+        void ReportTimings(AsyncComputeScheduler& scheduler, uint64_t frameCount, float relativeNoise = 0.0f, uint32_t seed = 0)
+        {
+            std::mt19937 rng{ seed };
+            std::uniform_real_distribution<float> noise{ -relativeNoise, relativeNoise };
+
+            for (uint64_t frame = 0; frame < frameCount; ++frame)
+            {
+                for (const SyntheticPass& pass : mPasses)
+                {
+                    scheduler.AddPassTiming(pass.Name, pass.DurationSeconds * (1.0f + noise(rng)));
+                }
+            }
+        }
+
+        uint64_t Queue(const std::string& passName) const
+        {
+            return mGraph.Nodes()[PassIndex(passName)].ExecutionQueueIndex;
+        }
+
+        // Estimated cost of the compiled frame with some passes moved to other queues
+        float EstimateFrameCost(const AsyncComputeScheduler& scheduler, const std::vector<std::pair<std::string, uint64_t>>& movedPasses = {}) const
+        {
+            AsyncComputeScheduler::QueueAssignment assignment;
+
+            for (const RenderPassGraph::Node& node : mGraph.Nodes())
+            {
+                assignment.push_back(node.ExecutionQueueIndex);
+            }
+
+            for (const auto& [passName, queue] : movedPasses)
+            {
+                assignment[PassIndex(passName)] = queue;
+            }
+
+            return scheduler.EstimateFrameCost(mGraph, assignment);
+        }
+
+        const RenderPassGraph& Graph() const { return mGraph; }
+
+    private:
+        uint64_t PassIndex(const std::string& passName) const
+        {
+            auto passIt = std::find_if(mPasses.begin(), mPasses.end(), [&passName](const SyntheticPass& pass) { return pass.Name == passName; });
+            return std::distance(mPasses.begin(), passIt);
+        }
+
+        std::vector<SyntheticPass> mPasses;
+        RenderPassGraph mGraph;
+    };
+
+    bool HasDecision(const AsyncComputeScheduler& scheduler, const std::string& passName, uint64_t queue)
+    {
+        auto decisionIt = scheduler.QueueDecisions().find(Foundation::Name{ passName });
+        return decisionIt != scheduler.QueueDecisions().end() && decisionIt->second == queue;
+    }
+
+    // G-buffer, then a tiny compute pass running alongside shadows, then lighting that consumes both
+    std::vector<SyntheticPass> TinyPassFrame()
+    {
+        return {
+            { "TinyGBuffer", {}, { "TinyDepth" }, 1e-3f },
+            { "TinyShadows", { "TinyDepth" }, { "TinyShadowMap" }, 1e-3f },
+            { "TinyDownsample", { "TinyDepth" }, { "TinyHalfDepth" }, 5e-6f, true, AsyncComputeQueue },
+            { "TinyLighting", { "TinyShadowMap", "TinyHalfDepth" }, { "TinyHDR" }, 1e-3f }
+        };
+    }
+
+    // Ambient occlusion overlapping with shadows, both long enough to hide fence costs
+    std::vector<SyntheticPass> OverlapFrame(uint64_t aoScheduledQueue)
+    {
+        return {
+            { "OverlapGBuffer", {}, { "OverlapDepth" }, 1e-3f },
+            { "OverlapShadows", { "OverlapDepth" }, { "OverlapShadowMap" }, 3e-3f },
+            { "OverlapAO", { "OverlapDepth" }, { "OverlapAOMap" }, 2e-3f, true, aoScheduledQueue },
+            { "OverlapLighting", { "OverlapShadowMap", "OverlapAOMap" }, { "OverlapHDR" }, 1e-3f }
+        };
+    }
+
+    // Two dependent compute passes alongside two dependent graphics passes.
+    // Either compute pass on async alone adds more fence time than it hides, together they pay off.
+    std::vector<SyntheticPass> ChainFrame()
+    {
+        return {
+            { "ChainGBuffer", {}, { "ChainDepth" }, 0.5e-3f },
+            { "ChainCullLights", { "ChainDepth" }, { "ChainLightGrid" }, 0.2e-3f, true },
+            { "ChainShadows", { "ChainDepth" }, { "ChainShadowMap" }, 1e-3f },
+            { "ChainBinLights", { "ChainLightGrid" }, { "ChainLightBins" }, 0.2e-3f, true },
+            { "ChainShadowFilter", { "ChainShadowMap" }, { "ChainFilteredShadowMap" }, 1e-3f },
+            { "ChainLighting", { "ChainLightBins", "ChainFilteredShadowMap" }, { "ChainHDR" }, 0.5e-3f }
+        };
+    }
+
+    constexpr float ChainFenceCostSeconds = 150e-6f;
+
+}
+
+PF_TEST(AsyncComputeSchedulerMovesTinyPassToGraphics)
+{
+    AsyncComputeScheduler scheduler;
+    SyntheticFrame frame{ TinyPassFrame() };
+
+    frame.Build(scheduler);
+
+    // Not enough samples yet
+    frame.ReportTimings(scheduler, 10);
+    PF_CHECK(!scheduler.Evaluate(frame.Graph()));
+
+    frame.ReportTimings(scheduler, 30);
+
+    // Two fences cost far more than the overlap hides
+    PF_CHECK(frame.EstimateFrameCost(scheduler, { { "TinyDownsample", GraphicsQueue } }) < frame.EstimateFrameCost(scheduler));
+    PF_CHECK(scheduler.Evaluate(frame.Graph()));
+    PF_CHECK(HasDecision(scheduler, "TinyDownsample", GraphicsQueue));
+
+    frame.Build(scheduler);
+    PF_CHECK(frame.Queue("TinyDownsample") == GraphicsQueue);
+    PF_CHECK(frame.Queue("TinyShadows") == GraphicsQueue);
+}
+
+PF_TEST(AsyncComputeSchedulerKeepsOverlappingPassOnAsyncCompute)
+{
+    // Already on async compute: nothing to change
+    {
+        AsyncComputeScheduler scheduler;
+        SyntheticFrame frame{ OverlapFrame(AsyncComputeQueue) };
+
+        frame.Build(scheduler);
+        frame.ReportTimings(scheduler, 30);
+
+        PF_CHECK(!scheduler.Evaluate(frame.Graph()));
+        PF_CHECK(scheduler.QueueDecisions().empty());
+
+        frame.Build(scheduler);
+        PF_CHECK(frame.Queue("OverlapAO") == AsyncComputeQueue);
+    }
+
+    // Scheduled on graphics: moved to async compute where it hides behind shadows
+    {
+        AsyncComputeScheduler scheduler;
+        SyntheticFrame frame{ OverlapFrame(GraphicsQueue) };
+
+        frame.Build(scheduler);
+        frame.ReportTimings(scheduler, 30);
+
+        PF_CHECK(scheduler.Evaluate(frame.Graph()));
+        PF_CHECK(HasDecision(scheduler, "OverlapAO", AsyncComputeQueue));
+
+        frame.Build(scheduler);
+        PF_CHECK(frame.Queue("OverlapAO") == AsyncComputeQueue);
+    }
+}
+
+PF_TEST(AsyncComputeSchedulerMovesChainAsWhole)
+{
+    AsyncComputeScheduler scheduler{ ChainFenceCostSeconds };
+    SyntheticFrame frame{ ChainFrame() };
+
+    frame.Build(scheduler);
+    frame.ReportTimings(scheduler, 30);
+
+    float graphicsOnlyCost = frame.EstimateFrameCost(scheduler);
+
+    // No single move is an improvement, so a search over single passes would stop right away
+    PF_CHECK(frame.EstimateFrameCost(scheduler, { { "ChainCullLights", AsyncComputeQueue } }) > graphicsOnlyCost);
+    PF_CHECK(frame.EstimateFrameCost(scheduler, { { "ChainBinLights", AsyncComputeQueue } }) > graphicsOnlyCost);
+    PF_CHECK(frame.EstimateFrameCost(scheduler, { { "ChainCullLights", AsyncComputeQueue }, { "ChainBinLights", AsyncComputeQueue } }) < graphicsOnlyCost * 0.99f);
+
+    PF_CHECK(scheduler.Evaluate(frame.Graph()));
+    PF_CHECK(HasDecision(scheduler, "ChainCullLights", AsyncComputeQueue) && HasDecision(scheduler, "ChainBinLights", AsyncComputeQueue));
+
+    frame.Build(scheduler);
+    PF_CHECK(frame.Queue("ChainCullLights") == AsyncComputeQueue && frame.Queue("ChainBinLights") == AsyncComputeQueue);
+    PF_CHECK(frame.Queue("ChainShadows") == GraphicsQueue && frame.Queue("ChainShadowFilter") == GraphicsQueue);
+}
+
+PF_TEST(AsyncComputeSchedulerSecondEvaluationIsStable)
+{
+    for (auto [passes, fenceCost] : { std::pair{ TinyPassFrame(), 50e-6f }, { OverlapFrame(GraphicsQueue), 50e-6f }, { ChainFrame(), ChainFenceCostSeconds } })
+    {
+        AsyncComputeScheduler scheduler{ fenceCost };
+        SyntheticFrame frame{ passes };
+        const std::string& firstPassName = passes.front().Name;
+
+        frame.Build(scheduler);
+        frame.ReportTimings(scheduler, 30);
+
+        PF_CHECK(scheduler.Evaluate(frame.Graph()), firstPassName, ": first evaluation changed nothing");
+
+        auto decisions = scheduler.QueueDecisions();
+        frame.Build(scheduler);
+
+        // Same timings and timings with measurement noise lead to the same assignment
+        for (uint32_t round = 0; round < 5; ++round)
+        {
+            frame.ReportTimings(scheduler, 60, 0.05f, round);
+
+            PF_CHECK(!scheduler.Evaluate(frame.Graph()), firstPassName, ": round ", round, " changed assignment");
+            PF_CHECK(scheduler.QueueDecisions() == decisions, firstPassName, ": round ", round, " changed decisions");
+
+            frame.Build(scheduler);
+        }
+    }
+}
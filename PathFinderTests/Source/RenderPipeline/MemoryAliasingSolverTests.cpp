@@ -0,0 +1,326 @@
+#include "../Testing.hpp"
+
+#include <RenderPipeline/MemoryAliasingSolver.hpp>
+
+#include <random>
+#include <vector>
+#include <string>
+#include <numeric>
+#include <algorithm>
+
+namespace
+{
+
+    using PathFinder::MemoryAliasingSolver;
+    using Allocation = MemoryAliasingSolver::Allocation;
+
+    constexpr uint64_t PlacementAlignment = 64 * 1024;
+
+    uint64_t Align(uint64_t size)
+    {
+        return (size + PlacementAlignment - 1) / PlacementAlignment * PlacementAlignment;
+    }
+
+    // Render targets and buffers of a 1080p frame: many short lived temporaries, a few history and G-buffer resources living long
+    std::vector<Allocation> FrameSchedule(uint64_t resourceCount, uint64_t passCount, uint32_t seed)
+    {
+        const uint64_t sizes[] = {
+            Align(1920 * 1080 * 4), Align(1920 * 1080 * 8), Align(1920 * 1080 * 16), Align(960 * 540 * 8),
+            Align(480 * 270 * 8), Align(4 * 1024 * 1024), Align(512 * 1024), PlacementAlignment
+        };
+
+        std::mt19937 rng{ seed };
+        std::vector<Allocation> allocations(resourceCount);
+
+        for (Allocation& allocation : allocations)
+        {
+            uint64_t kind = rng() % 20;
+            uint64_t length = kind < 14 ? 1 + rng() % 3 : (kind < 19 ? 1 + rng() % (passCount / 4) : passCount);
+
+            allocation.Size = sizes[rng() % std::size(sizes)];
+            allocation.LifetimeStart = length == passCount ? 0 : rng() % passCount;
+            allocation.LifetimeEnd = std::min(allocation.LifetimeStart + length - 1, passCount - 1);
+        }
+
+        return allocations;
+    }
+
+    // Random sizes and lifetimes without any structure
+    std::vector<Allocation> RandomSchedule(uint64_t resourceCount, uint64_t passCount, uint32_t seed)
+    {
+        std::mt19937 rng{ seed };
+        std::vector<Allocation> allocations(resourceCount);
+
+        for (Allocation& allocation : allocations)
+        {
+            uint64_t first = rng() % passCount;
+            uint64_t second = rng() % passCount;
+
+            allocation.Size = PlacementAlignment * (1 + rng() % 256);
+            allocation.LifetimeStart = std::min(first, second);
+            allocation.LifetimeEnd = std::max(first, second);
+        }
+
+        return allocations;
+    }
+
+    bool LifetimesIntersect(const Allocation& first, const Allocation& second)
+    {
+        return first.LifetimeStart <= second.LifetimeEnd && second.LifetimeStart <= first.LifetimeEnd;
+    }
+
+    bool MemoryIntersects(const Allocation& first, const Allocation& second)
+    {
+        return first.Offset < second.Offset + second.Size && second.Offset < first.Offset + first.Size;
+    }
+
+    // Pairs of allocations that are alive at the same time and share memory
+    uint64_t CountOverlaps(const std::vector<Allocation>& allocations)
+    {
+        uint64_t overlapCount = 0;
+
+        for (uint64_t i = 0; i < allocations.size(); ++i)
+        {
+            for (uint64_t j = i + 1; j < allocations.size(); ++j)
+            {
+                overlapCount += LifetimesIntersect(allocations[i], allocations[j]) && MemoryIntersects(allocations[i], allocations[j]);
+            }
+        }
+
+        return overlapCount;
+    }
+
+    // Memory alive during the busiest pass, computed pass by pass
+    uint64_t PeakLiveMemory(const std::vector<Allocation>& allocations)
+    {
+        uint64_t lastPass = 0;
+
+        for (const Allocation& allocation : allocations)
+        {
+            lastPass = std::max(lastPass, allocation.LifetimeEnd);
+        }
+
+        uint64_t peakMemory = 0;
+
+        for (uint64_t pass = 0; pass <= lastPass; ++pass)
+        {
+            uint64_t liveMemory = 0;
+
+            for (const Allocation& allocation : allocations)
+            {
+                liveMemory += allocation.LifetimeStart <= pass && pass <= allocation.LifetimeEnd ? allocation.Size : 0;
+            }
+
+            peakMemory = std::max(peakMemory, liveMemory);
+        }
+
+        return allocations.empty() ? 0 : peakMemory;
+    }
+
+    uint64_t HeapSize(const std::vector<Allocation>& allocations)
+    {
+        uint64_t heapSize = 0;
+
+        for (const Allocation& allocation : allocations)
+        {
+            heapSize = std::max(heapSize, allocation.Offset + allocation.Size);
+        }
+
+        return heapSize;
+    }
+
+    // Port of the bucket based aliaser the solver replaced: the largest remaining resource opens a bucket of its size,
+    // smaller resources are best-fit into gaps left by bucket members they overlap in time, the rest go to following buckets
+    uint64_t PlaceInBuckets(std::vector<Allocation>& allocations)
+    {
+        std::vector<uint32_t> remaining(allocations.size());
+        std::iota(remaining.begin(), remaining.end(), 0);
+        std::stable_sort(remaining.begin(), remaining.end(), [&allocations](uint32_t a, uint32_t b)
+        {
+            return allocations[a].Size > allocations[b].Size;
+        });
+
+        uint64_t bucketOffset = 0;
+        std::vector<std::pair<uint64_t, uint64_t>> occupiedRanges;
+
+        while (!remaining.empty())
+        {
+            uint64_t bucketSize = allocations[remaining.front()].Size;
+            std::vector<uint32_t> bucket;
+            std::vector<uint32_t> skipped;
+
+            for (uint32_t index : remaining)
+            {
+                Allocation& allocation = allocations[index];
+                occupiedRanges.clear();
+
+                for (uint32_t bucketIndex : bucket)
+                {
+                    const Allocation& member = allocations[bucketIndex];
+
+                    if (LifetimesIntersect(member, allocation))
+                    {
+                        occupiedRanges.emplace_back(member.Offset - bucketOffset, member.Offset - bucketOffset + member.Size);
+                    }
+                }
+
+                occupiedRanges.emplace_back(bucketSize, bucketSize);
+                std::sort(occupiedRanges.begin(), occupiedRanges.end());
+
+                uint64_t bestGap = std::numeric_limits<uint64_t>::max();
+                uint64_t bestOffset = 0;
+                uint64_t freeStart = 0;
+
+                for (const auto& [rangeStart, rangeEnd] : occupiedRanges)
+                {
+                    if (rangeStart >= freeStart && rangeStart - freeStart >= allocation.Size && rangeStart - freeStart < bestGap)
+                    {
+                        bestGap = rangeStart - freeStart;
+                        bestOffset = freeStart;
+                    }
+
+                    freeStart = std::max(freeStart, rangeEnd);
+                }
+
+                if (bestGap != std::numeric_limits<uint64_t>::max())
+                {
+                    allocation.Offset = bucketOffset + bestOffset;
+                    bucket.push_back(index);
+                }
+                else
+                {
+                    skipped.push_back(index);
+                }
+            }
+
+            remaining = std::move(skipped);
+            bucketOffset += bucketSize;
+        }
+
+        return bucketOffset;
+    }
+
+    void CheckPlacement(std::vector<Allocation> allocations, const std::string& name)
+    {
+        MemoryAliasingSolver::Statistics statistics;
+        uint64_t heapSize = MemoryAliasingSolver::PlaceAllocations(allocations, &statistics);
+        uint64_t lowerBound = PeakLiveMemory(allocations);
+
+        PF_CHECK(CountOverlaps(allocations) == 0, name, ": ", CountOverlaps(allocations), " overlapping pairs");
+        PF_CHECK(heapSize == HeapSize(allocations), name, ": returned ", heapSize, " actual ", HeapSize(allocations));
+        PF_CHECK(heapSize >= lowerBound, name, ": heap ", heapSize, " is below lower bound ", lowerBound);
+        PF_CHECK(statistics.LowerBound == lowerBound, name, ": ", statistics.LowerBound, " expected ", lowerBound);
+        PF_CHECK(statistics.HeapSize == heapSize && statistics.WastedBytes == heapSize - lowerBound, name);
+    }
+
+}
+
+PF_TEST(MemoryAliasingSolverEdgeCases)
+{
+    std::vector<Allocation> allocations;
+    PF_CHECK(MemoryAliasingSolver::PlaceAllocations(allocations) == 0);
+
+    allocations = { Allocation{ 1000, 3, 7 } };
+    PF_CHECK(MemoryAliasingSolver::PlaceAllocations(allocations) == 1000 && allocations[0].Offset == 0);
+
+    // Resources used one after another share all memory
+    allocations.clear();
+
+    for (uint64_t pass = 0; pass < 10; ++pass)
+    {
+        allocations.push_back({ 100 * (pass % 3 + 1), pass, pass });
+    }
+
+    PF_CHECK(MemoryAliasingSolver::PlaceAllocations(allocations) == 300);
+
+    // Resources alive at the same time share nothing
+    for (Allocation& allocation : allocations)
+    {
+        allocation.LifetimeStart = 0;
+        allocation.LifetimeEnd = 5;
+    }
+
+    PF_CHECK(MemoryAliasingSolver::PlaceAllocations(allocations) == 1900);
+    PF_CHECK(CountOverlaps(allocations) == 0);
+
+    // Lifetimes touching at a single pass intersect
+    allocations = { Allocation{ 100, 0, 2 }, Allocation{ 100, 2, 4 }, Allocation{ 100, 4, 6 } };
+    PF_CHECK(MemoryAliasingSolver::PlaceAllocations(allocations) == 200);
+    PF_CHECK(CountOverlaps(allocations) == 0);
+}
+
+PF_TEST(MemoryAliasingSolverNeverOverlapsLiveResources)
+{
+    for (uint32_t seed = 0; seed < 20; ++seed)
+    {
+        CheckPlacement(FrameSchedule(150, 60, seed), "Frame schedule " + std::to_string(seed));
+        CheckPlacement(RandomSchedule(150, 40, seed), "Random schedule " + std::to_string(seed));
+    }
+
+    // Every resource alive everywhere: heap equals the lower bound, which equals the sum of sizes
+    std::vector<Allocation> allocations = RandomSchedule(50, 10, 3);
+
+    for (Allocation& allocation : allocations)
+    {
+        allocation.LifetimeStart = 0;
+        allocation.LifetimeEnd = 9;
+    }
+
+    std::vector<Allocation> placed = allocations;
+    uint64_t sizeSum = std::accumulate(allocations.begin(), allocations.end(), uint64_t(0), [](uint64_t sum, const Allocation& allocation) { return sum + allocation.Size; });
+
+    PF_CHECK(MemoryAliasingSolver::PlaceAllocations(placed) == sizeSum);
+    CheckPlacement(allocations, "Fully overlapping");
+}
+
+PF_TEST(MemoryAliasingSolverBucketReferenceIsValid)
+{
+    // Reference used by the benchmark must be a valid placement itself for the comparison to mean anything
+    for (uint32_t seed = 0; seed < 10; ++seed)
+    {
+        std::vector<Allocation> allocations = FrameSchedule(150, 60, seed);
+        uint64_t heapSize = PlaceInBuckets(allocations);
+
+        PF_CHECK(CountOverlaps(allocations) == 0, "Seed ", seed);
+        PF_CHECK(heapSize >= HeapSize(allocations) && heapSize >= PeakLiveMemory(allocations), "Seed ", seed);
+    }
+}
+
+PF_BENCHMARK(MemoryAliasingSolverReplay)
+{
+    constexpr uint64_t ScheduleCount = 10;
+
+    for (auto [resourceCount, passCount] : { std::pair<uint64_t, uint64_t>{ 40, 30 }, { 150, 60 }, { 600, 200 }, { 2000, 400 } })
+    {
+        double bucketHeapMegabytes = 0.0;
+        double solverHeapMegabytes = 0.0;
+        double lowerBoundMegabytes = 0.0;
+        double bucketMilliseconds = 0.0;
+        double solverMilliseconds = 0.0;
+
+        for (uint32_t seed = 0; seed < ScheduleCount; ++seed)
+        {
+            std::vector<Allocation> bucketAllocations = FrameSchedule(resourceCount, passCount, seed);
+            std::vector<Allocation> solverAllocations = bucketAllocations;
+            MemoryAliasingSolver::Statistics statistics;
+
+            Testing::Stopwatch bucketStopwatch;
+            bucketHeapMegabytes += PlaceInBuckets(bucketAllocations) / 1e6;
+            bucketMilliseconds += bucketStopwatch.ElapsedMilliseconds();
+
+            Testing::Stopwatch solverStopwatch;
+            solverHeapMegabytes += MemoryAliasingSolver::PlaceAllocations(solverAllocations, &statistics) / 1e6;
+            solverMilliseconds += solverStopwatch.ElapsedMilliseconds();
+
+            lowerBoundMegabytes += statistics.LowerBound / 1e6;
+        }
+
+        std::string suffix = " (" + std::to_string(resourceCount) + " resources, " + std::to_string(passCount) + " passes)";
+
+        Testing::Report("Lower bound" + suffix, lowerBoundMegabytes / ScheduleCount, "MB");
+        Testing::Report("Bucket aliaser heap" + suffix, bucketHeapMegabytes / ScheduleCount, "MB");
+        Testing::Report("Solver heap" + suffix, solverHeapMegabytes / ScheduleCount, "MB");
+        Testing::Report("Bucket aliaser time" + suffix, bucketMilliseconds / ScheduleCount, "ms");
+        Testing::Report("Solver time" + suffix, solverMilliseconds / ScheduleCount, "ms");
+    }
+}
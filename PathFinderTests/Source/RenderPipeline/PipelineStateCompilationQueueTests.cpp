@@ -0,0 +1,205 @@
+#include "../Testing.hpp"
+
+#include <RenderPipeline/PipelineStateCompilationQueue.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+    // Stands in for a HAL pipeline state: compiled version is what command lists would bind
+    struct NullState
+    {
+        uint64_t Version = 0;
+        std::shared_ptr<uint64_t> CompiledVersion;
+    };
+
+    using CompilationQueue = PathFinder::PipelineStateCompilationQueue<NullState, std::shared_ptr<uint64_t>>;
+
+    // Holds a compilation on a worker thread until opened
+    class Gate
+    {
+    public:
+        void Open()
+        {
+            std::lock_guard lock{ mMutex };
+            mIsOpen = true;
+            mCondition.notify_all();
+        }
+
+        void Wait()
+        {
+            std::unique_lock lock{ mMutex };
+            mCondition.wait(lock, [this] { return mIsOpen; });
+        }
+
+    private:
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        bool mIsOpen = false;
+    };
+
+    // Compiles the version the state had at request time, as the manager compiles a copy of the state
+    CompilationQueue::Compiler NullCompiler(const NullState& state, std::shared_ptr<Gate> gate = nullptr)
+    {
+        return [version = state.Version, gate]
+        {
+            if (gate)
+            {
+                gate->Wait();
+            }
+
+            return std::make_shared<uint64_t>(version);
+        };
+    }
+
+    void ApplyFinished(CompilationQueue& queue)
+    {
+        queue.ApplyFinished([](NullState* state, const std::shared_ptr<uint64_t>& compiledVersion)
+        {
+            state->CompiledVersion = compiledVersion;
+        });
+    }
+
+    uint64_t CompiledVersion(const NullState& state)
+    {
+        return state.CompiledVersion ? *state.CompiledVersion : 0;
+    }
+
+}
+
+PF_TEST(PipelineStateCompilationQueueKeepsOldStateUntilReady)
+{
+    Foundation::ThreadPool threadPool;
+    CompilationQueue queue{ &threadPool };
+    NullState state;
+
+    // Initial compilation, waited for as new states are
+    state.Version = 1;
+    queue.Enqueue(&state, NullCompiler(state));
+    threadPool.WaitForAllTasks();
+    ApplyFinished(queue);
+
+    PF_CHECK(CompiledVersion(state) == 1);
+    PF_CHECK(queue.IsEmpty());
+
+    // Recompilation after a shader edit is not waited for
+    auto gate = std::make_shared<Gate>();
+    state.Version = 2;
+    queue.Enqueue(&state, NullCompiler(state, gate));
+
+    for (uint64_t frame = 0; frame < 10; ++frame)
+    {
+        ApplyFinished(queue);
+        PF_CHECK(CompiledVersion(state) == 1, "Frame ", frame, " lost its compiled state");
+    }
+
+    PF_CHECK(!queue.IsEmpty());
+
+    gate->Open();
+    threadPool.WaitForAllTasks();
+    ApplyFinished(queue);
+
+    PF_CHECK(CompiledVersion(state) == 2);
+    PF_CHECK(queue.IsEmpty());
+}
+
+PF_TEST(PipelineStateCompilationQueueDropsSupersededResults)
+{
+    // A blocked compilation occupies a worker, another one is needed to finish the rest
+    Foundation::ThreadPool threadPool{ 2 };
+    CompilationQueue queue{ &threadPool };
+
+    // Older compilation finishes last: its result must not overwrite the newer one
+    {
+        NullState state;
+        auto olderGate = std::make_shared<Gate>();
+
+        state.Version = 1;
+        queue.Enqueue(&state, NullCompiler(state, olderGate));
+        state.Version = 2;
+        queue.Enqueue(&state, NullCompiler(state));
+
+        // Wait for the newer result without waiting for the whole pool, which is blocked by the older compilation
+        while (CompiledVersion(state) != 2)
+        {
+            ApplyFinished(queue);
+            std::this_thread::yield();
+        }
+
+        PF_CHECK(!queue.IsEmpty());
+
+        olderGate->Open();
+        threadPool.WaitForAllTasks();
+        ApplyFinished(queue);
+
+        PF_CHECK(CompiledVersion(state) == 2, "Superseded result was applied: ", CompiledVersion(state));
+        PF_CHECK(queue.IsEmpty());
+    }
+
+    // Older compilation finishes first: it's dropped rather than applied while the newer one is in flight
+    {
+        NullState state;
+        auto newerGate = std::make_shared<Gate>();
+
+        state.Version = 1;
+        queue.Enqueue(&state, NullCompiler(state));
+        threadPool.WaitForAllTasks();
+        ApplyFinished(queue);
+
+        state.Version = 2;
+        queue.Enqueue(&state, NullCompiler(state));
+        state.Version = 3;
+        queue.Enqueue(&state, NullCompiler(state, newerGate));
+
+        // Version 2 is finished before version 3 is unblocked
+        for (uint64_t frame = 0; frame < 10; ++frame)
+        {
+            ApplyFinished(queue);
+            PF_CHECK(CompiledVersion(state) == 1, "Frame ", frame, " Compiled: ", CompiledVersion(state));
+        }
+
+        newerGate->Open();
+        threadPool.WaitForAllTasks();
+        ApplyFinished(queue);
+
+        PF_CHECK(CompiledVersion(state) == 3);
+        PF_CHECK(queue.IsEmpty());
+    }
+}
+
+PF_TEST(PipelineStateCompilationQueueIsolatesStates)
+{
+    Foundation::ThreadPool threadPool;
+    CompilationQueue queue{ &threadPool };
+    std::vector<NullState> states(64);
+
+    // Many states recompiled repeatedly: each ends up with its own latest version
+    for (uint64_t round = 1; round <= 5; ++round)
+    {
+        for (NullState& state : states)
+        {
+            state.Version = round * 1000 + (&state - states.data());
+            queue.Enqueue(&state, NullCompiler(state));
+        }
+
+        if (round % 2 == 0)
+        {
+            ApplyFinished(queue);
+        }
+    }
+
+    threadPool.WaitForAllTasks();
+    ApplyFinished(queue);
+
+    for (uint64_t stateIdx = 0; stateIdx < states.size(); ++stateIdx)
+    {
+        PF_CHECK(CompiledVersion(states[stateIdx]) == 5000 + stateIdx, "State ", stateIdx, " Compiled: ", CompiledVersion(states[stateIdx]));
+    }
+
+    PF_CHECK(queue.IsEmpty());
+}
@@ -0,0 +1,207 @@
+#include "../Testing.hpp"
+
+#include <RenderPipeline/RecordingBatchPlan.hpp>
+
+#include <random>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+    using PathFinder::RenderPassGraph;
+    using PathFinder::RecordingBatchPlan;
+
+    // Stands in for a HAL command list: remembers recorded commands and the thread that recorded them
+    class RecordingCommandList
+    {
+    public:
+        void Record(uint64_t command)
+        {
+            mUsedFromMultipleThreads = mUsedFromMultipleThreads || (!mCommands.empty() && mRecordingThread != std::this_thread::get_id());
+            mRecordingThread = std::this_thread::get_id();
+            mCommands.push_back(command);
+        }
+
+    private:
+        std::vector<uint64_t> mCommands;
+        std::thread::id mRecordingThread;
+        bool mUsedFromMultipleThreads = false;
+
+    public:
+        inline const auto& Commands() const { return mCommands; }
+        inline auto RecordingThread() const { return mRecordingThread; }
+        inline bool IsUsedFromMultipleThreads() const { return mUsedFromMultipleThreads; }
+    };
+
+    // Dependency levels of varying width, every pass reads outputs of a couple of passes from the previous level
+    void ScheduleLayeredGraph(RenderPassGraph& graph, uint64_t levelCount, uint64_t maxLevelWidth, uint32_t seed)
+    {
+        std::mt19937 rng{ seed };
+        std::vector<std::vector<uint64_t>> levels(levelCount);
+        uint64_t nodeCount = 0;
+
+        for (std::vector<uint64_t>& level : levels)
+        {
+            uint64_t width = 1 + rng() % maxLevelWidth;
+
+            for (uint64_t i = 0; i < width; ++i)
+            {
+                level.push_back(graph.AddPass({ "LayeredPass" + std::to_string(nodeCount) }));
+                ++nodeCount;
+            }
+        }
+
+        for (uint64_t levelIdx = 0; levelIdx < levelCount; ++levelIdx)
+        {
+            for (uint64_t nodeIdx : levels[levelIdx])
+            {
+                RenderPassGraph::Node& node = graph.Nodes()[nodeIdx];
+                node.AddWriteDependency("LayeredResource" + std::to_string(nodeIdx), std::nullopt, 1);
+                node.ExecutionQueueIndex = rng() % 3 == 0;
+
+                if (levelIdx > 0)
+                {
+                    const std::vector<uint64_t>& previousLevel = levels[levelIdx - 1];
+
+                    for (uint64_t readIdx = 0; readIdx < 2; ++readIdx)
+                    {
+                        node.AddReadDependency("LayeredResource" + std::to_string(previousLevel[rng() % previousLevel.size()]), 1);
+                    }
+                }
+            }
+        }
+
+        graph.Build();
+    }
+
+    // Records every pass into its own command list the way RenderEngine does, with passes taking random time,
+    // and returns commands in submission order, which is graph execution order
+    std::vector<uint64_t> RecordFrame(const RenderPassGraph& graph, const RecordingBatchPlan& plan, Foundation::ThreadPool& threadPool, uint32_t seed, bool& isSharedAcrossThreads)
+    {
+        std::vector<RecordingCommandList> commandLists(graph.NodesInGlobalExecutionOrder().size());
+        std::vector<uint32_t> delays;
+        std::mt19937 rng{ seed };
+
+        for (uint64_t i = 0; i < commandLists.size(); ++i)
+        {
+            delays.push_back(rng() % 200);
+        }
+
+        plan.Record(threadPool, [&](const RenderPassGraph::Node* node)
+        {
+            RecordingCommandList& commandList = commandLists[node->GlobalExecutionIndex()];
+            uint64_t passId = node->PassMetadata().Name.ToId();
+
+            commandList.Record(passId);
+            std::this_thread::sleep_for(std::chrono::microseconds{ delays[node->GlobalExecutionIndex()] });
+            commandList.Record(passId + 1);
+        });
+
+        std::vector<uint64_t> submittedCommands;
+        isSharedAcrossThreads = false;
+
+        for (const RenderPassGraph::Node* node : graph.NodesInGlobalExecutionOrder())
+        {
+            const RecordingCommandList& commandList = commandLists[node->GlobalExecutionIndex()];
+            submittedCommands.insert(submittedCommands.end(), commandList.Commands().begin(), commandList.Commands().end());
+            isSharedAcrossThreads = isSharedAcrossThreads || commandList.IsUsedFromMultipleThreads();
+        }
+
+        // Command lists of a batch share command allocators, so the whole batch must be recorded on one thread
+        for (const RenderPassGraph::DependencyLevel& dependencyLevel : graph.DependencyLevels())
+        {
+            for (const RecordingBatchPlan::Batch& batch : plan.BatchesForLevel(dependencyLevel.LevelIndex()))
+            {
+                for (const RenderPassGraph::Node* node : batch)
+                {
+                    isSharedAcrossThreads = isSharedAcrossThreads ||
+                        commandLists[node->GlobalExecutionIndex()].RecordingThread() != commandLists[batch.front()->GlobalExecutionIndex()].RecordingThread();
+                }
+            }
+        }
+
+        return submittedCommands;
+    }
+
+}
+
+PF_TEST(RecordingBatchPlanSplitsLevelsIntoContiguousBatches)
+{
+    RenderPassGraph graph;
+    ScheduleLayeredGraph(graph, 20, 12, 1);
+
+    RecordingBatchPlan plan;
+
+    for (uint64_t threadCount : { 1, 3, 8, 64 })
+    {
+        plan.Build(graph, threadCount, true);
+
+        for (const RenderPassGraph::DependencyLevel& dependencyLevel : graph.DependencyLevels())
+        {
+            const std::vector<RecordingBatchPlan::Batch>& batches = plan.BatchesForLevel(dependencyLevel.LevelIndex());
+            uint64_t expectedBatchCount = std::min<uint64_t>(threadCount, dependencyLevel.Nodes().size());
+            uint64_t previousBatchIndex = 0;
+            uint64_t nodeCount = 0;
+
+            PF_CHECK(batches.size() == expectedBatchCount, "Threads: ", threadCount, " Batches: ", batches.size());
+
+            // Batches follow execution order and none is left empty
+            for (const RenderPassGraph::Node* node : dependencyLevel.Nodes())
+            {
+                uint64_t batchIndex = plan.BatchIndex(*node);
+                PF_CHECK(batchIndex >= previousBatchIndex && batchIndex < batches.size());
+                previousBatchIndex = batchIndex;
+            }
+
+            for (uint64_t batchIndex = 0; batchIndex < batches.size(); ++batchIndex)
+            {
+                PF_CHECK(!batches[batchIndex].empty(), "Level ", dependencyLevel.LevelIndex(), " batch ", batchIndex, " is empty");
+
+                for (const RenderPassGraph::Node* node : batches[batchIndex])
+                {
+                    PF_CHECK(plan.BatchIndex(*node) == batchIndex);
+                    PF_CHECK(node->LocalToDependencyLevelExecutionIndex() == nodeCount++);
+                }
+            }
+        }
+    }
+
+    // Disabled multi-threading keeps a single batch no matter how many threads are available
+    plan.Build(graph, 8, false);
+
+    for (const RenderPassGraph::DependencyLevel& dependencyLevel : graph.DependencyLevels())
+    {
+        PF_CHECK(plan.BatchesForLevel(dependencyLevel.LevelIndex()).size() == 1);
+    }
+}
+
+PF_TEST(RecordingBatchPlanSubmitsInDeterministicOrder)
+{
+    RenderPassGraph graph;
+    ScheduleLayeredGraph(graph, 12, 10, 2);
+
+    Foundation::ThreadPool threadPool{ 4 };
+    RecordingBatchPlan singleThreadedPlan;
+    RecordingBatchPlan multiThreadedPlan;
+    bool isSharedAcrossThreads = false;
+
+    singleThreadedPlan.Build(graph, threadPool.ThreadCount(), false);
+    multiThreadedPlan.Build(graph, threadPool.ThreadCount(), true);
+
+    std::vector<uint64_t> referenceCommands = RecordFrame(graph, singleThreadedPlan, threadPool, 0, isSharedAcrossThreads);
+
+    PF_CHECK(referenceCommands.size() == graph.NodesInGlobalExecutionOrder().size() * 2);
+    PF_CHECK(!isSharedAcrossThreads);
+
+    for (uint32_t frame = 1; frame <= 10; ++frame)
+    {
+        std::vector<uint64_t> commands = RecordFrame(graph, multiThreadedPlan, threadPool, frame, isSharedAcrossThreads);
+
+        PF_CHECK(commands == referenceCommands, "Frame ", frame, " submitted commands in a different order");
+        PF_CHECK(!isSharedAcrossThreads, "Frame ", frame, " recorded a batch on more than one thread");
+    }
+}
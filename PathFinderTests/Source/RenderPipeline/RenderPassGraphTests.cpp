@@ -0,0 +1,335 @@
+#include "../Testing.hpp"
+
+#include <RenderPipeline/RenderPassGraph.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <tuple>
+#include <algorithm>
+
+namespace
+{
+
+    using PathFinder::RenderPassGraph;
+
+    // Deferred-like frame: G-buffer, shadows, async compute AO, lighting, post processing
+    class FrameGraph
+    {
+    public:
+        FrameGraph()
+        {
+            for (const char* passName : { "GBuffer", "Shadows", "AmbientOcclusion", "Lighting", "PostProcessing" })
+            {
+                mGraph.AddPass({ passName });
+            }
+        }
+
+        // Reschedules dependencies the way RenderEngine does every frame
+        void Schedule(uint64_t aoQueueIndex = 1, uint32_t shadowMapCascadeCount = 4)
+        {
+            mGraph.Clear();
+
+            RenderPassGraph::Node& gBuffer = mGraph.Nodes()[0];
+            RenderPassGraph::Node& shadows = mGraph.Nodes()[1];
+            RenderPassGraph::Node& ao = mGraph.Nodes()[2];
+            RenderPassGraph::Node& lighting = mGraph.Nodes()[3];
+            RenderPassGraph::Node& postProcessing = mGraph.Nodes()[4];
+
+            gBuffer.AddWriteDependency("Albedo", std::nullopt, 1);
+            gBuffer.AddWriteDependency("Normals", std::nullopt, 1);
+            gBuffer.AddWriteDependency("Depth", std::nullopt, 1);
+
+            shadows.AddWriteDependency("ShadowMap", std::nullopt, shadowMapCascadeCount);
+
+            ao.AddReadDependency("Depth", 1);
+            ao.AddReadDependency("Normals", 1);
+            ao.AddWriteDependency("AO", std::nullopt, 1);
+            ao.ExecutionQueueIndex = aoQueueIndex;
+
+            lighting.AddReadDependency("Albedo", 1);
+            lighting.AddReadDependency("Normals", 1);
+            lighting.AddReadDependency("ShadowMap", shadowMapCascadeCount);
+            lighting.AddReadDependency("AO", 1);
+            lighting.AddWriteDependency("HDR", std::nullopt, 1);
+
+            postProcessing.AddReadDependency("HDR", 1);
+            postProcessing.AddWriteDependency("LDR", std::nullopt, 1);
+        }
+
+        // Pass names in execution order along with queue, dependency level and sync information
+        std::vector<std::string> CompiledState() const
+        {
+            std::vector<std::string> state;
+
+            for (const RenderPassGraph::Node* node : mGraph.NodesInGlobalExecutionOrder())
+            {
+                std::string description = node->PassMetadata().Name.ToString() +
+                    " queue " + std::to_string(node->ExecutionQueueIndex) +
+                    " level " + std::to_string(node->DependencyLevelIndex()) +
+                    " signal " + std::to_string(node->IsSyncSignalRequired());
+
+                for (const RenderPassGraph::Node* nodeToSyncWith : node->NodesToSyncWith())
+                {
+                    description += " waits " + nodeToSyncWith->PassMetadata().Name.ToString();
+                }
+
+                state.push_back(description);
+            }
+
+            return state;
+        }
+
+        RenderPassGraph& Graph() { return mGraph; }
+
+    private:
+        RenderPassGraph mGraph;
+    };
+
+    // Random acyclic graph: every pass writes a few subresources of its own resource and reads
+    // subresources written by passes shortly before it, a quarter of passes run on async compute
+    void ScheduleSyntheticGraph(RenderPassGraph& graph, uint64_t nodeCount, uint32_t seed)
+    {
+        constexpr uint32_t SubresourceCount = 4;
+        constexpr uint64_t ReadCount = 4;
+        constexpr uint64_t ReadWindow = 32;
+
+        std::mt19937 rng{ seed };
+        std::vector<Foundation::Name> resourceNames;
+
+        for (uint64_t nodeIdx = 0; nodeIdx < nodeCount; ++nodeIdx)
+        {
+            graph.AddPass({ "SyntheticPass" + std::to_string(nodeIdx) });
+            resourceNames.emplace_back("SyntheticResource" + std::to_string(nodeIdx));
+        }
+
+        for (uint64_t nodeIdx = 0; nodeIdx < nodeCount; ++nodeIdx)
+        {
+            RenderPassGraph::Node& node = graph.Nodes()[nodeIdx];
+            node.AddWriteDependency(resourceNames[nodeIdx], std::nullopt, SubresourceCount);
+            node.ExecutionQueueIndex = rng() % 4 == 0;
+
+            for (uint64_t readIdx = 0; readIdx < std::min(nodeIdx, ReadCount); ++readIdx)
+            {
+                uint64_t writerIdx = nodeIdx - 1 - rng() % std::min(nodeIdx, ReadWindow);
+                uint32_t firstSubresource = rng() % SubresourceCount;
+                uint32_t lastSubresource = firstSubresource + rng() % (SubresourceCount - firstSubresource);
+                node.AddReadDependency(resourceNames[writerIdx], firstSubresource, lastSubresource);
+            }
+        }
+    }
+
+    // Adjacency the way it was derived before writer indexing: every node tested against every other node
+    std::vector<std::vector<uint64_t>> ReferenceAdjacencyLists(const RenderPassGraph& graph)
+    {
+        const RenderPassGraph::NodeList& nodes = graph.Nodes();
+        std::vector<std::vector<uint64_t>> adjacencyLists(nodes.size());
+
+        for (uint64_t writerIdx = 0; writerIdx < nodes.size(); ++writerIdx)
+        {
+            for (uint64_t readerIdx = 0; readerIdx < nodes.size(); ++readerIdx)
+            {
+                if (writerIdx == readerIdx)
+                    continue;
+
+                for (RenderPassGraph::SubresourceName readSubresource : nodes[readerIdx].ReadSubresources())
+                {
+                    if (nodes[writerIdx].WrittenSubresources().count(readSubresource) > 0)
+                    {
+                        adjacencyLists[writerIdx].push_back(readerIdx);
+                        break;
+                    }
+                }
+            }
+        }
+
+        return adjacencyLists;
+    }
+
+}
+
+PF_TEST(RenderPassGraphReusesCompilationOfUnchangedFrame)
+{
+    FrameGraph frameGraph;
+
+    frameGraph.Schedule();
+    frameGraph.Graph().Build();
+
+    PF_CHECK(!frameGraph.Graph().IsLastBuildCached(), "First build can't be cached");
+
+    std::vector<std::string> compiledState = frameGraph.CompiledState();
+
+    PF_CHECK(compiledState.size() == 5, "Compiled nodes: ", compiledState.size());
+    PF_CHECK(frameGraph.Graph().DetectedQueueCount() == 2);
+
+    for (uint64_t frame = 0; frame < 3; ++frame)
+    {
+        frameGraph.Schedule();
+        frameGraph.Graph().Build();
+
+        PF_CHECK(frameGraph.Graph().IsLastBuildCached(), "Frame ", frame, " was recompiled");
+        PF_CHECK(frameGraph.CompiledState() == compiledState, "Frame ", frame, " compilation results changed");
+    }
+}
+
+PF_TEST(RenderPassGraphRecompilesChangedFrame)
+{
+    FrameGraph frameGraph;
+    FrameGraph referenceGraph;
+
+    frameGraph.Schedule();
+    frameGraph.Graph().Build();
+
+    // Pass moved to another queue
+    frameGraph.Schedule(0);
+    frameGraph.Graph().Build();
+    referenceGraph.Schedule(0);
+    referenceGraph.Graph().Build();
+
+    PF_CHECK(!frameGraph.Graph().IsLastBuildCached(), "Queue change must invalidate compilation");
+    PF_CHECK(frameGraph.Graph().DetectedQueueCount() == 1);
+    PF_CHECK(frameGraph.CompiledState() == referenceGraph.CompiledState(), "Recompiled graph differs from a fresh one");
+
+    // Subresource set changed
+    frameGraph.Schedule(0, 2);
+    frameGraph.Graph().Build();
+
+    PF_CHECK(!frameGraph.Graph().IsLastBuildCached(), "Dependency change must invalidate compilation");
+
+    frameGraph.Schedule(0, 2);
+    frameGraph.Graph().Build();
+
+    PF_CHECK(frameGraph.Graph().IsLastBuildCached(), "Repeated frame must be cached again");
+
+    // Passes added after compilation invalidate it even if nothing else changed
+    frameGraph.Graph().AddPass({ "Debug" });
+    frameGraph.Schedule(0, 2);
+    frameGraph.Graph().Build();
+
+    PF_CHECK(!frameGraph.Graph().IsLastBuildCached(), "New pass must invalidate compilation");
+}
+
+PF_TEST(RenderPassGraphAdjacencyMatchesExhaustiveSearch)
+{
+    for (uint64_t nodeCount : { 2, 50, 300 })
+    {
+        RenderPassGraph graph;
+        ScheduleSyntheticGraph(graph, nodeCount, uint32_t(nodeCount));
+        graph.Build();
+
+        PF_CHECK(graph.NodeAdjacencyLists() == ReferenceAdjacencyLists(graph), "Node count: ", nodeCount);
+        PF_CHECK(graph.NodesInGlobalExecutionOrder().size() == nodeCount);
+
+        // Writers execute before their readers
+        for (const RenderPassGraph::Node& node : graph.Nodes())
+        {
+            for (RenderPassGraph::SubresourceName readSubresource : node.ReadSubresources())
+            {
+                const RenderPassGraph::Node* writer = graph.GetNodeThatWritesToSubresource(readSubresource);
+                PF_CHECK(writer->DependencyLevelIndex() < node.DependencyLevelIndex(), writer->PassMetadata().Name.ToString(), " -> ", node.PassMetadata().Name.ToString());
+            }
+        }
+    }
+}
+
+PF_TEST(RenderPassGraphFindsCrossQueueReads)
+{
+    RenderPassGraph graph;
+    ScheduleSyntheticGraph(graph, 300, 5);
+    graph.Build();
+
+    uint64_t crossQueueReadCount = 0;
+
+    for (const RenderPassGraph::DependencyLevel& dependencyLevel : graph.DependencyLevels())
+    {
+        // Queues reading each subresource in this level, collected directly from nodes
+        std::map<RenderPassGraph::SubresourceName, std::set<uint64_t>> readingQueues;
+        std::set<RenderPassGraph::SubresourceName> expectedSubresources;
+        std::set<uint64_t> expectedQueues;
+
+        for (const RenderPassGraph::Node* node : dependencyLevel.Nodes())
+        {
+            for (RenderPassGraph::SubresourceName readSubresource : node->ReadSubresources())
+            {
+                readingQueues[readSubresource].insert(node->ExecutionQueueIndex);
+            }
+        }
+
+        for (auto& [subresourceName, queues] : readingQueues)
+        {
+            if (queues.size() > 1)
+            {
+                expectedSubresources.insert(subresourceName);
+                expectedQueues.insert(queues.begin(), queues.end());
+            }
+        }
+
+        std::set<RenderPassGraph::SubresourceName> subresources{ dependencyLevel.SubresourcesReadByMultipleQueues().begin(), dependencyLevel.SubresourcesReadByMultipleQueues().end() };
+        std::set<uint64_t> queues{ dependencyLevel.QueuesInvoledInCrossQueueResourceReads().begin(), dependencyLevel.QueuesInvoledInCrossQueueResourceReads().end() };
+
+        PF_CHECK(subresources == expectedSubresources, "Level ", dependencyLevel.LevelIndex(), " cross queue subresources: ", subresources.size(), " expected: ", expectedSubresources.size());
+        PF_CHECK(queues == expectedQueues, "Level ", dependencyLevel.LevelIndex());
+
+        crossQueueReadCount += subresources.size();
+    }
+
+    PF_CHECK(crossQueueReadCount > 0, "Synthetic graph must contain cross queue reads");
+
+    // Reader lists hold every reader ordered by dependency level, queue and execution order
+    for (const RenderPassGraph::Node& node : graph.Nodes())
+    {
+        for (RenderPassGraph::SubresourceName readSubresource : node.ReadSubresources())
+        {
+            const RenderPassGraph::SubresourceReaderList& readers = graph.GetNodesThatReadSubresource(readSubresource);
+
+            auto readerKey = [](const RenderPassGraph::Node* reader)
+            {
+                return std::make_tuple(reader->DependencyLevelIndex(), reader->ExecutionQueueIndex, reader->GlobalExecutionIndex());
+            };
+
+            bool isOrdered = std::is_sorted(readers.begin(), readers.end(), [&](auto first, auto second) { return readerKey(first) < readerKey(second); });
+
+            PF_CHECK(std::find(readers.begin(), readers.end(), &node) != readers.end(), node.PassMetadata().Name.ToString(), " is missing from reader list");
+            PF_CHECK(isOrdered, "Readers of ", RenderPassGraph::DecodeSubresourceName(readSubresource).first.ToString(), " are not ordered");
+        }
+    }
+}
+
+PF_BENCHMARK(RenderPassGraphBuild)
+{
+    constexpr uint64_t NodesPerSize = 20000;
+
+    for (uint64_t nodeCount : { 50, 200, 500, 1000, 2000 })
+    {
+        uint64_t graphCount = NodesPerSize / nodeCount;
+        std::vector<RenderPassGraph> graphs(graphCount);
+
+        for (uint64_t graphIdx = 0; graphIdx < graphCount; ++graphIdx)
+        {
+            ScheduleSyntheticGraph(graphs[graphIdx], nodeCount, uint32_t(graphIdx));
+        }
+
+        Testing::Stopwatch buildStopwatch;
+
+        for (RenderPassGraph& graph : graphs)
+        {
+            graph.Build();
+        }
+
+        double buildMilliseconds = buildStopwatch.ElapsedMilliseconds() / graphCount;
+        Testing::Stopwatch referenceStopwatch;
+
+        for (RenderPassGraph& graph : graphs)
+        {
+            ReferenceAdjacencyLists(graph);
+        }
+
+        double referenceMilliseconds = referenceStopwatch.ElapsedMilliseconds() / graphCount;
+        std::string size = std::to_string(nodeCount) + " nodes";
+
+        Testing::Report(size + ", full build", buildMilliseconds, "ms");
+        Testing::Report(size + ", exhaustive adjacency search alone", referenceMilliseconds, "ms");
+    }
+}
@@ -0,0 +1,310 @@
+#include "../Testing.hpp"
+
+#include <RenderPipeline/ShaderCache.hpp>
+#include <Foundation/ThreadPool.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <set>
+
+namespace
+{
+
+    using PathFinder::ShaderCache;
+
+    std::filesystem::path TemporaryPath(const std::string& name)
+    {
+        std::filesystem::path directory = std::filesystem::temp_directory_path() / "PathFinderTests";
+        std::filesystem::create_directories(directory);
+        return directory / name;
+    }
+
+    std::string ReadFile(const std::filesystem::path& path)
+    {
+        std::ifstream stream{ path, std::ios::binary | std::ios::in };
+        return { std::istreambuf_iterator<char>{ stream }, std::istreambuf_iterator<char>{} };
+    }
+
+    // Rewrites a file and moves its write time forward, since file system timestamps can be too coarse to tell quick edits apart
+    void WriteFile(const std::filesystem::path& path, const std::string& contents)
+    {
+        std::filesystem::file_time_type previousWriteTime{};
+        bool existed = std::filesystem::exists(path);
+
+        if (existed)
+        {
+            previousWriteTime = std::filesystem::last_write_time(path);
+        }
+
+        {
+            std::ofstream stream{ path, std::ios::binary | std::ios::trunc | std::ios::out };
+            stream << contents;
+        }
+
+        if (existed)
+        {
+            std::filesystem::last_write_time(path, previousWriteTime + std::chrono::seconds{ 2 });
+        }
+    }
+
+    // Stands in for DXC: resolves #include "x" directives recursively and produces a binary derived from every file it read
+    class CountingCompilerBackend : public ShaderCache::CompilerBackend
+    {
+    public:
+        std::optional<ShaderCache::Entry> Compile(const ShaderCache::Key& key, const std::filesystem::path& sourcePath) override
+        {
+            ++mCompileCount;
+
+            if (!std::filesystem::exists(sourcePath))
+            {
+                return std::nullopt;
+            }
+
+            ShaderCache::Entry entry{};
+            entry.DebugName = key.EntryPoint + ".pdb";
+
+            std::set<std::string> visitedFiles;
+            Preprocess(sourcePath.parent_path(), sourcePath.filename().string(), visitedFiles, entry);
+
+            std::string suffix = key.EntryPoint + key.Profile;
+            entry.Binary.insert(entry.Binary.end(), suffix.begin(), suffix.end());
+
+            return entry;
+        }
+
+        uint64_t CompileCount() const { return mCompileCount; }
+
+    private:
+        void Preprocess(const std::filesystem::path& folder, const std::string& relativePath, std::set<std::string>& visitedFiles, ShaderCache::Entry& entry)
+        {
+            if (!visitedFiles.insert(relativePath).second)
+            {
+                return;
+            }
+
+            entry.CompiledFileRelativePaths.push_back(relativePath);
+
+            std::string contents = ReadFile(folder / relativePath);
+            entry.Binary.insert(entry.Binary.end(), contents.begin(), contents.end());
+
+            const std::string directive = "#include \"";
+
+            for (size_t position = contents.find(directive); position != std::string::npos; position = contents.find(directive, position + 1))
+            {
+                size_t nameStart = position + directive.size();
+                size_t nameEnd = contents.find('"', nameStart);
+                Preprocess(folder, contents.substr(nameStart, nameEnd - nameStart), visitedFiles, entry);
+            }
+        }
+
+        std::atomic<uint64_t> mCompileCount = 0;
+    };
+
+    // Two entry point files sharing a header, one of them also including a nested header
+    struct ShaderTree
+    {
+        std::filesystem::path Root = TemporaryPath("ShaderCacheSources");
+        std::filesystem::path CacheFolder = TemporaryPath("ShaderCache");
+
+        ShaderTree()
+        {
+            std::filesystem::remove_all(Root);
+            std::filesystem::remove_all(CacheFolder);
+            std::filesystem::create_directories(Root);
+
+            WriteFile(Root / "Nested.hlsl", "static const float Nested = 1.0;\n");
+            WriteFile(Root / "Common.hlsl", "static const float Common = 2.0;\n");
+            WriteFile(Root / "Lighting.hlsl", "#include \"Common.hlsl\"\n#include \"Nested.hlsl\"\nvoid PSMain() {}\nvoid CSMain() {}\n");
+            WriteFile(Root / "Blur.hlsl", "#include \"Common.hlsl\"\nvoid CSMain() {}\n");
+        }
+
+        ~ShaderTree()
+        {
+            std::filesystem::remove_all(Root);
+            std::filesystem::remove_all(CacheFolder);
+        }
+    };
+
+    ShaderCache::Key MakeKey(const std::string& relativePath, const std::string& entryPoint, const std::string& profile)
+    {
+        return { relativePath, entryPoint, profile, "-O3 -all_resources_bound", "1.6.2106" };
+    }
+
+    std::vector<ShaderCache::Key> TreeKeys()
+    {
+        return {
+            MakeKey("Lighting.hlsl", "PSMain", "ps_6_6"),
+            MakeKey("Lighting.hlsl", "CSMain", "cs_6_6"),
+            MakeKey("Blur.hlsl", "CSMain", "cs_6_6"),
+            MakeKey("Blur.hlsl", "", "lib_6_6")
+        };
+    }
+
+    bool AreSameEntries(const ShaderCache::Entry& entry, const ShaderCache::Entry& expectedEntry)
+    {
+        return entry.Binary == expectedEntry.Binary &&
+            entry.PDBBinary == expectedEntry.PDBBinary &&
+            entry.DebugName == expectedEntry.DebugName &&
+            entry.CompiledFileRelativePaths == expectedEntry.CompiledFileRelativePaths;
+    }
+
+}
+
+PF_TEST(ShaderCacheWarmStartDoesNotCompile)
+{
+    ShaderTree tree;
+    std::vector<ShaderCache::Key> keys = TreeKeys();
+    std::vector<ShaderCache::Entry> coldEntries;
+
+    {
+        CountingCompilerBackend backend;
+        ShaderCache cache{ tree.CacheFolder, tree.Root, &backend };
+
+        for (const ShaderCache::Key& key : keys)
+        {
+            std::optional<ShaderCache::Entry> entry = cache.FindOrCompile(key);
+            PF_CHECK(entry.has_value(), key.SourceRelativePath, " ", key.EntryPoint);
+            coldEntries.push_back(entry.value_or(ShaderCache::Entry{}));
+        }
+
+        PF_CHECK(backend.CompileCount() == keys.size(), "Compiles: ", backend.CompileCount());
+        PF_CHECK(cache.MissCount() == keys.size() && cache.HitCount() == 0);
+    }
+
+    // New instance over the same folders, as on the next application start
+    CountingCompilerBackend backend;
+    ShaderCache cache{ tree.CacheFolder, tree.Root, &backend };
+
+    for (uint64_t keyIdx = 0; keyIdx < keys.size(); ++keyIdx)
+    {
+        std::optional<ShaderCache::Entry> entry = cache.FindOrCompile(keys[keyIdx]);
+        PF_CHECK(entry && AreSameEntries(*entry, coldEntries[keyIdx]), keys[keyIdx].SourceRelativePath, " ", keys[keyIdx].EntryPoint);
+    }
+
+    PF_CHECK(backend.CompileCount() == 0, "Compiles: ", backend.CompileCount());
+    PF_CHECK(cache.HitCount() == keys.size() && cache.MissCount() == 0, "Hits: ", cache.HitCount(), " Misses: ", cache.MissCount());
+
+    // Failed compilations are not stored
+    PF_CHECK(!cache.FindOrCompile(MakeKey("Missing.hlsl", "CSMain", "cs_6_6")));
+    PF_CHECK(!cache.FindOrCompile(MakeKey("Missing.hlsl", "CSMain", "cs_6_6")));
+    PF_CHECK(backend.CompileCount() == 2);
+}
+
+PF_TEST(ShaderCacheIncludeEditInvalidatesDependentEntries)
+{
+    ShaderTree tree;
+    std::vector<ShaderCache::Key> keys = TreeKeys();
+    CountingCompilerBackend backend;
+    ShaderCache cache{ tree.CacheFolder, tree.Root, &backend };
+
+    for (const ShaderCache::Key& key : keys)
+    {
+        cache.FindOrCompile(key);
+    }
+
+    // Returns keys that had to be compiled again
+    auto recompiledKeys = [&]() -> std::vector<std::string>
+    {
+        std::vector<std::string> recompiled;
+
+        for (const ShaderCache::Key& key : keys)
+        {
+            uint64_t compileCount = backend.CompileCount();
+            std::optional<ShaderCache::Entry> entry = cache.FindOrCompile(key);
+
+            PF_CHECK(entry.has_value(), key.SourceRelativePath, " ", key.EntryPoint);
+
+            if (backend.CompileCount() != compileCount)
+            {
+                recompiled.push_back(key.SourceRelativePath + ":" + key.EntryPoint);
+            }
+        }
+
+        return recompiled;
+    };
+
+    PF_CHECK(recompiledKeys().empty());
+
+    // Nested header is included by Lighting.hlsl only
+    WriteFile(tree.Root / "Nested.hlsl", "static const float Nested = 3.0;\n");
+    std::vector<std::string> recompiled = recompiledKeys();
+    PF_CHECK((recompiled == std::vector<std::string>{ "Lighting.hlsl:PSMain", "Lighting.hlsl:CSMain" }), "Recompiled: ", recompiled.size());
+
+    // Edited header ends up in the new binary
+    std::optional<ShaderCache::Entry> lightingEntry = cache.Find(keys[0]);
+    PF_CHECK(lightingEntry && std::string(lightingEntry->Binary.begin(), lightingEntry->Binary.end()).find("Nested = 3.0") != std::string::npos);
+
+    // Shared header invalidates everything
+    WriteFile(tree.Root / "Common.hlsl", "static const float Common = 4.0;\n");
+    PF_CHECK(recompiledKeys().size() == keys.size());
+
+    // Rewrite with identical contents only changes the write time, which is not enough to invalidate
+    WriteFile(tree.Root / "Common.hlsl", "static const float Common = 4.0;\n");
+    PF_CHECK(recompiledKeys().empty());
+
+    // Entry point file edit invalidates only its own entry points
+    WriteFile(tree.Root / "Blur.hlsl", "#include \"Common.hlsl\"\nvoid CSMain() { }\n");
+    recompiled = recompiledKeys();
+    PF_CHECK((recompiled == std::vector<std::string>{ "Blur.hlsl:CSMain", "Blur.hlsl:" }), "Recompiled: ", recompiled.size());
+
+    // New include is picked up as a dependency of the recompiled entry
+    WriteFile(tree.Root / "Blur.hlsl", "#include \"Common.hlsl\"\n#include \"Nested.hlsl\"\nvoid CSMain() { }\n");
+    recompiledKeys();
+    WriteFile(tree.Root / "Nested.hlsl", "static const float Nested = 5.0;\n");
+    PF_CHECK(recompiledKeys().size() == keys.size());
+
+    // Compiler arguments and version are part of the key
+    uint64_t compileCount = backend.CompileCount();
+    ShaderCache::Key key = keys[2];
+    key.CompilerArguments += " -Zi";
+    cache.FindOrCompile(key);
+    key.CompilerVersion = "1.7.2212";
+    cache.FindOrCompile(key);
+    cache.FindOrCompile(keys[2]);
+    PF_CHECK(backend.CompileCount() == compileCount + 2, "Compiles: ", backend.CompileCount() - compileCount);
+
+    // Removed include fails validation rather than serving a stale binary
+    std::filesystem::remove(tree.Root / "Nested.hlsl");
+    PF_CHECK(!cache.Find(keys[0]).has_value());
+    PF_CHECK(!cache.Find(keys[2]).has_value());
+}
+
+PF_TEST(ShaderCacheConcurrentLookups)
+{
+    ShaderTree tree;
+    Foundation::ThreadPool threadPool;
+    std::vector<ShaderCache::Key> keys;
+
+    // Many entry points sharing headers, as ShaderManager compiles them on its thread pool
+    for (uint64_t shaderIdx = 0; shaderIdx < 64; ++shaderIdx)
+    {
+        std::string entryPoint = "CSMain" + std::to_string(shaderIdx);
+        keys.push_back(MakeKey(shaderIdx % 2 ? "Lighting.hlsl" : "Blur.hlsl", entryPoint, "cs_6_6"));
+    }
+
+    for (bool isWarm : { false, true })
+    {
+        CountingCompilerBackend backend;
+        ShaderCache cache{ tree.CacheFolder, tree.Root, &backend };
+        std::vector<std::optional<ShaderCache::Entry>> entries(keys.size());
+
+        for (uint64_t keyIdx = 0; keyIdx < keys.size(); ++keyIdx)
+        {
+            threadPool.Execute([&, keyIdx] { entries[keyIdx] = cache.FindOrCompile(keys[keyIdx]); });
+        }
+
+        threadPool.WaitForAllTasks();
+
+        for (uint64_t keyIdx = 0; keyIdx < keys.size(); ++keyIdx)
+        {
+            PF_CHECK(entries[keyIdx].has_value(), "Key ", keyIdx);
+        }
+
+        PF_CHECK(backend.CompileCount() == (isWarm ? 0 : keys.size()), "Compiles: ", backend.CompileCount());
+    }
+}
@@ -0,0 +1,319 @@
+#include "../Testing.hpp"
+
+#include <Scene/MeshOptimizer.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <map>
+#include <set>
+#include <array>
+#include <string>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+namespace
+{
+
+    using PathFinder::MeshOptimizer;
+    using PathFinder::Vertex1P1N1UV1T1BT;
+
+    struct TestMesh
+    {
+        std::string Name;
+        std::vector<Vertex1P1N1UV1T1BT> Vertices;
+        std::vector<uint32_t> Indices;
+    };
+
+    using VertexKey = std::array<float, 9>;
+    using TriangleKey = std::array<VertexKey, 3>;
+
+    // Splits an .obj file into meshes per material and joins identical vertices, as the assimp import does
+    std::vector<TestMesh> LoadObj(const std::filesystem::path& path)
+    {
+        std::ifstream file{ path };
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec3> normals;
+        std::vector<glm::vec2> uvs;
+        std::map<std::string, TestMesh> meshesByMaterial;
+        std::map<std::string, std::map<std::array<int, 3>, uint32_t>> vertexIndicesByMaterial;
+        std::string material = "Default";
+        std::string line;
+
+        while (std::getline(file, line))
+        {
+            std::istringstream stream{ line };
+            std::string keyword;
+            stream >> keyword;
+
+            if (keyword == "v")
+            {
+                glm::vec3& position = positions.emplace_back();
+                stream >> position.x >> position.y >> position.z;
+            }
+            else if (keyword == "vn")
+            {
+                glm::vec3& normal = normals.emplace_back();
+                stream >> normal.x >> normal.y >> normal.z;
+            }
+            else if (keyword == "vt")
+            {
+                glm::vec2& uv = uvs.emplace_back();
+                stream >> uv.x >> uv.y;
+            }
+            else if (keyword == "usemtl")
+            {
+                stream >> material;
+            }
+            else if (keyword == "f")
+            {
+                TestMesh& mesh = meshesByMaterial[material];
+                std::map<std::array<int, 3>, uint32_t>& vertexIndices = vertexIndicesByMaterial[material];
+                std::vector<uint32_t> face;
+                std::string corner;
+
+                mesh.Name = path.filename().string() + ":" + material;
+
+                while (stream >> corner)
+                {
+                    std::array<int, 3> key{ 0, 0, 0 };
+                    std::istringstream cornerStream{ corner };
+                    std::string component;
+
+                    for (uint64_t i = 0; i < 3 && std::getline(cornerStream, component, '/'); ++i)
+                    {
+                        key[i] = component.empty() ? 0 : std::stoi(component);
+                    }
+
+                    auto [indexIt, isNewVertex] = vertexIndices.try_emplace(key, uint32_t(mesh.Vertices.size()));
+
+                    if (isNewVertex)
+                    {
+                        Vertex1P1N1UV1T1BT& vertex = mesh.Vertices.emplace_back();
+                        vertex.Position = glm::vec4{ positions[key[0] - 1], 1.0f };
+                        vertex.UV = key[1] ? uvs[key[1] - 1] : glm::vec2{ 0.0f };
+                        vertex.Normal = key[2] ? normals[key[2] - 1] : glm::vec3{ 0.0f };
+                    }
+
+                    face.push_back(indexIt->second);
+                }
+
+                for (uint64_t i = 1; i + 1 < face.size(); ++i)
+                {
+                    mesh.Indices.insert(mesh.Indices.end(), { face[0], face[i], face[i + 1] });
+                }
+            }
+        }
+
+        std::vector<TestMesh> meshes;
+
+        for (auto& [material, mesh] : meshesByMaterial)
+        {
+            meshes.push_back(std::move(mesh));
+        }
+
+        return meshes;
+    }
+
+    std::vector<TestMesh> LoadBundledMeshes()
+    {
+        std::filesystem::path root{ PATHFINDER_DIR };
+        std::vector<TestMesh> meshes;
+
+        for (const char* file : { "MediaResources/Models/cube.obj", "MediaResources/Models/plane.obj", "MediaResources/Models/sphere3.obj",
+            "Source/Scene/Precompiled/UnitCube.obj", "Source/Scene/Precompiled/UnitSphere.obj" })
+        {
+            for (TestMesh& mesh : LoadObj(root / file))
+            {
+                meshes.push_back(std::move(mesh));
+            }
+        }
+
+        return meshes;
+    }
+
+    // Gently curved grid with triangles and vertices in random order, as some exporters emit them
+    TestMesh ShuffledGrid(uint32_t size, uint32_t seed)
+    {
+        TestMesh mesh;
+        mesh.Name = "Shuffled grid " + std::to_string(size);
+
+        for (uint32_t y = 0; y <= size; ++y)
+        {
+            for (uint32_t x = 0; x <= size; ++x)
+            {
+                Vertex1P1N1UV1T1BT& vertex = mesh.Vertices.emplace_back();
+                vertex.Position = glm::vec4{ x, y, 0.1f * std::sin(x * 0.3f) * std::cos(y * 0.2f), 1.0f };
+                vertex.Normal = glm::vec3{ 0.0f, 0.0f, 1.0f };
+                vertex.UV = glm::vec2{ x, y } / float(size);
+            }
+        }
+
+        std::vector<std::array<uint32_t, 3>> triangles;
+
+        for (uint32_t y = 0; y < size; ++y)
+        {
+            for (uint32_t x = 0; x < size; ++x)
+            {
+                uint32_t topLeft = y * (size + 1) + x;
+                uint32_t bottomLeft = topLeft + size + 1;
+                triangles.push_back({ topLeft, bottomLeft, topLeft + 1 });
+                triangles.push_back({ topLeft + 1, bottomLeft, bottomLeft + 1 });
+            }
+        }
+
+        std::mt19937 rng{ seed };
+        std::vector<uint32_t> permutation(mesh.Vertices.size());
+        std::vector<Vertex1P1N1UV1T1BT> permutedVertices(mesh.Vertices.size());
+
+        std::iota(permutation.begin(), permutation.end(), 0);
+        std::shuffle(permutation.begin(), permutation.end(), rng);
+        std::shuffle(triangles.begin(), triangles.end(), rng);
+
+        for (uint32_t i = 0; i < permutation.size(); ++i)
+        {
+            permutedVertices[permutation[i]] = mesh.Vertices[i];
+        }
+
+        mesh.Vertices = std::move(permutedVertices);
+
+        for (const std::array<uint32_t, 3>& triangle : triangles)
+        {
+            for (uint32_t index : triangle)
+            {
+                mesh.Indices.push_back(permutation[index]);
+            }
+        }
+
+        return mesh;
+    }
+
+    VertexKey MakeVertexKey(const Vertex1P1N1UV1T1BT& vertex)
+    {
+        return { vertex.Position.x, vertex.Position.y, vertex.Position.z, vertex.Normal.x, vertex.Normal.y, vertex.Normal.z, vertex.UV.x, vertex.UV.y, vertex.Position.w };
+    }
+
+    // Triangles by their vertex contents, rotated to a canonical first vertex so that winding is kept
+    std::multiset<TriangleKey> Triangles(const TestMesh& mesh)
+    {
+        std::multiset<TriangleKey> triangles;
+
+        for (uint64_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+        {
+            TriangleKey triangle{ MakeVertexKey(mesh.Vertices[mesh.Indices[i]]), MakeVertexKey(mesh.Vertices[mesh.Indices[i + 1]]), MakeVertexKey(mesh.Vertices[mesh.Indices[i + 2]]) };
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            triangles.insert(triangle);
+        }
+
+        return triangles;
+    }
+
+    std::multiset<VertexKey> ReferencedVertices(const TestMesh& mesh)
+    {
+        std::set<uint32_t> referencedIndices{ mesh.Indices.begin(), mesh.Indices.end() };
+        std::multiset<VertexKey> vertices;
+
+        for (uint32_t index : referencedIndices)
+        {
+            vertices.insert(MakeVertexKey(mesh.Vertices[index]));
+        }
+
+        return vertices;
+    }
+
+    // Optimizes a mesh and checks that it describes the same geometry and got no worse for vertex cache
+    void CheckOptimization(TestMesh mesh)
+    {
+        constexpr float Tolerance = 1e-4f;
+
+        std::multiset<TriangleKey> originalTriangles = Triangles(mesh);
+        std::multiset<VertexKey> originalVertices = ReferencedVertices(mesh);
+
+        MeshOptimizer::Report report = MeshOptimizer::Optimize(mesh.Vertices, mesh.Indices);
+
+        PF_CHECK(report.Optimized.ACMR <= report.Original.ACMR + Tolerance, mesh.Name, " ACMR: ", report.Original.ACMR, " -> ", report.Optimized.ACMR);
+        PF_CHECK(report.Optimized.ATVR <= report.Original.ATVR + Tolerance, mesh.Name, " ATVR: ", report.Original.ATVR, " -> ", report.Optimized.ATVR);
+
+        PF_CHECK(Triangles(mesh) == originalTriangles, mesh.Name, " Triangles changed");
+
+        // Unreferenced vertices are dropped, nothing else
+        PF_CHECK(mesh.Vertices.size() == originalVertices.size(), mesh.Name, " Vertices: ", mesh.Vertices.size(), " Referenced: ", originalVertices.size());
+        PF_CHECK(ReferencedVertices(mesh) == originalVertices, mesh.Name, " Vertices changed");
+
+        // Vertices are laid out in order of first use
+        uint32_t nextNewIndex = 0;
+        bool isFirstUseOrder = true;
+
+        for (uint32_t index : mesh.Indices)
+        {
+            isFirstUseOrder = isFirstUseOrder && index <= nextNewIndex;
+            nextNewIndex += index == nextNewIndex;
+        }
+
+        PF_CHECK(isFirstUseOrder, mesh.Name, " Vertices are not in first use order");
+    }
+
+}
+
+PF_TEST(MeshOptimizerPreservesBundledMeshes)
+{
+    std::vector<TestMesh> meshes = LoadBundledMeshes();
+
+    PF_CHECK(!meshes.empty(), "No meshes found in ", PATHFINDER_DIR);
+
+    for (TestMesh& mesh : meshes)
+    {
+        PF_CHECK(!mesh.Indices.empty(), mesh.Name);
+        CheckOptimization(std::move(mesh));
+    }
+}
+
+PF_TEST(MeshOptimizerReordersShuffledGrid)
+{
+    TestMesh mesh = ShuffledGrid(64, 2);
+    TestMesh optimizedMesh = mesh;
+
+    CheckOptimization(mesh);
+
+    MeshOptimizer::Report report = MeshOptimizer::Optimize(optimizedMesh.Vertices, optimizedMesh.Indices);
+
+    // Random order misses the cache on almost every vertex, a regular grid can get close to 0.5
+    PF_CHECK(report.Original.ACMR > 2.5f && report.Optimized.ACMR < 0.8f, "ACMR: ", report.Original.ACMR, " -> ", report.Optimized.ACMR);
+    PF_CHECK(report.Optimized.Overfetch < report.Original.Overfetch, "Overfetch: ", report.Original.Overfetch, " -> ", report.Optimized.Overfetch);
+}
+
+PF_TEST(MeshOptimizerDropsUnreferencedVertices)
+{
+    TestMesh mesh = ShuffledGrid(8, 3);
+    Vertex1P1N1UV1T1BT unreferencedVertex{};
+    unreferencedVertex.Position = glm::vec4{ -1.0f, -1.0f, -1.0f, 1.0f };
+    mesh.Vertices.insert(mesh.Vertices.begin(), 5, unreferencedVertex);
+
+    for (uint32_t& index : mesh.Indices)
+    {
+        index += 5;
+    }
+
+    CheckOptimization(mesh);
+}
+
+PF_BENCHMARK(MeshOptimizerShuffledGrid)
+{
+    TestMesh mesh = ShuffledGrid(256, 2);
+    uint64_t triangleCount = mesh.Indices.size() / 3;
+
+    Testing::Stopwatch stopwatch;
+    MeshOptimizer::Report report = MeshOptimizer::Optimize(mesh.Vertices, mesh.Indices);
+    double milliseconds = stopwatch.ElapsedMilliseconds();
+
+    Testing::Report("Optimization of 131k triangles", milliseconds, "ms");
+    Testing::Report("ACMR before", report.Original.ACMR, "");
+    Testing::Report("ACMR after", report.Optimized.ACMR, "");
+    Testing::Report("ATVR before", report.Original.ATVR, "");
+    Testing::Report("ATVR after", report.Optimized.ATVR, "");
+    Testing::Report("Overfetch before", report.Original.Overfetch, "");
+    Testing::Report("Overfetch after", report.Optimized.Overfetch, "");
+    Testing::Report("Throughput", triangleCount / milliseconds / 1000.0, "Mtri/s");
+}
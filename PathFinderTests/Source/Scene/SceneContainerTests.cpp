@@ -0,0 +1,291 @@
+#include "../Testing.hpp"
+
+#include <Scene/SceneContainer.hpp>
+#include <Scene/Mesh.hpp>
+
+#include <bitsery/bitsery.h>
+#include <bitsery/adapter/buffer.h>
+#include <bitsery/traits/vector.h>
+
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+namespace
+{
+
+    using PathFinder::SceneContainerWriter;
+    using PathFinder::SceneContainerReader;
+    using PathFinder::Mesh;
+    using PathFinder::Vertex1P1N1UV1T1BT;
+
+    std::filesystem::path TemporaryPath(const std::string& name)
+    {
+        std::filesystem::path directory = std::filesystem::temp_directory_path() / "PathFinderTests";
+        std::filesystem::create_directories(directory);
+        return directory / name;
+    }
+
+    std::vector<uint8_t> RandomBytes(uint64_t size, std::mt19937& rng)
+    {
+        std::vector<uint8_t> bytes(size);
+        std::generate(bytes.begin(), bytes.end(), [&rng] { return uint8_t(rng()); });
+        return bytes;
+    }
+
+    // Grid of vertices, compressible the way real vertex buffers are
+    std::vector<Vertex1P1N1UV1T1BT> GridVertices(uint64_t vertexCount)
+    {
+        std::vector<Vertex1P1N1UV1T1BT> vertices(vertexCount);
+
+        for (uint64_t i = 0; i < vertexCount; ++i)
+        {
+            vertices[i].Position = glm::vec4{ float(i % 128), float(i / 128), 0.0f, 1.0f };
+            vertices[i].Normal = glm::vec3{ 0.0f, 0.0f, 1.0f };
+            vertices[i].UV = glm::vec2{ float(i % 128) / 128.0f, float(i / 128) / 128.0f };
+        }
+
+        return vertices;
+    }
+
+    template <class T>
+    std::vector<uint8_t> AsBytes(const std::vector<T>& values)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values.data());
+        return { bytes, bytes + values.size() * sizeof(T) };
+    }
+
+    // Texture with a mip chain laid out the way texture footprints place subresources: each mip at a 512 byte aligned offset
+    struct TestTexture
+    {
+        std::vector<uint8_t> Blob;
+        std::vector<uint64_t> MipOffsets;
+        std::vector<uint64_t> MipSizes;
+
+        TestTexture(uint64_t width, uint64_t mipCount, std::mt19937& rng)
+        {
+            for (uint64_t mip = 0; mip < mipCount; ++mip)
+            {
+                uint64_t mipWidth = std::max<uint64_t>(width >> mip, 1);
+                uint64_t mipSize = mipWidth * mipWidth * 4;
+
+                MipOffsets.push_back((Blob.size() + 511) / 512 * 512);
+                MipSizes.push_back(mipSize);
+                Blob.resize(MipOffsets.back());
+
+                // Smooth gradient with a little noise, each mip distinct
+                for (uint64_t texel = 0; texel < mipWidth * mipWidth; ++texel)
+                {
+                    Blob.insert(Blob.end(), { uint8_t(texel + mip), uint8_t(texel / mipWidth), uint8_t(mip * 40), uint8_t(rng() % 4) });
+                }
+            }
+        }
+    };
+
+    // Mirrors the texture records that scenes store in their description block
+    struct TextureRecord
+    {
+        uint64_t Block = 0;
+        std::vector<uint64_t> MipOffsets;
+
+        template <typename S>
+        void serialize(S& s)
+        {
+            s.value8b(Block);
+            s.container8b(MipOffsets, 64);
+        }
+    };
+
+    void CheckContainerRoundTrip(bool compressBlocks)
+    {
+        std::mt19937 rng{ 8 };
+        std::filesystem::path path = TemporaryPath(compressBlocks ? "RoundTripCompressed.pfscene" : "RoundTrip.pfscene");
+
+        std::vector<std::vector<uint8_t>> blocks;
+        blocks.push_back(AsBytes(GridVertices(10000)));
+        blocks.push_back(RandomBytes(50000, rng)); // Doesn't shrink and is stored raw even when compression is requested
+        blocks.push_back({}); // Empty block
+        blocks.push_back(RandomBytes(3, rng));
+        blocks.push_back(AsBytes(std::vector<uint32_t>(30000, 42)));
+
+        std::vector<TestTexture> textures{ TestTexture{ 256, 9, rng }, TestTexture{ 60, 6, rng } };
+        std::vector<TextureRecord> textureRecords;
+
+        {
+            SceneContainerWriter writer{ path };
+
+            for (uint64_t blockIdx = 0; blockIdx < blocks.size(); ++blockIdx)
+            {
+                PF_CHECK(writer.AddBlock(blocks[blockIdx].data(), blocks[blockIdx].size(), compressBlocks) == blockIdx);
+            }
+
+            for (const TestTexture& texture : textures)
+            {
+                textureRecords.push_back({ writer.AddBlock(texture.Blob.data(), texture.Blob.size(), compressBlocks), texture.MipOffsets });
+            }
+
+            std::vector<uint8_t> description;
+            bitsery::Serializer<bitsery::OutputBufferAdapter<std::vector<uint8_t>>> serializer{ description };
+            serializer.container(textureRecords, 16);
+            serializer.adapter().flush();
+
+            writer.AddBlock(description.data(), serializer.adapter().writtenBytesCount(), false);
+            writer.Finalize();
+        }
+
+        {
+            SceneContainerReader reader{ path };
+            std::vector<uint8_t> scratch;
+
+            PF_CHECK(reader.BlockCount() == blocks.size() + textures.size() + 1, "Blocks: ", reader.BlockCount());
+
+            for (uint64_t blockIdx = 0; blockIdx < blocks.size(); ++blockIdx)
+            {
+                const std::vector<uint8_t>& expected = blocks[blockIdx];
+                std::vector<uint8_t> read(reader.BlockSize(blockIdx));
+
+                PF_CHECK(reader.BlockSize(blockIdx) == expected.size(), "Block ", blockIdx);
+
+                reader.ReadBlock(blockIdx, read.data());
+                PF_CHECK(read == expected, "Block ", blockIdx, " Compressed: ", reader.IsBlockCompressed(blockIdx));
+
+                const uint8_t* accessed = reader.AccessBlock(blockIdx, scratch);
+                PF_CHECK(expected.empty() || std::memcmp(accessed, expected.data(), expected.size()) == 0, "Block ", blockIdx);
+
+                // Raw blocks are consumed straight from the page aligned mapping
+                if (!reader.IsBlockCompressed(blockIdx))
+                {
+                    PF_CHECK(accessed == reader.MappedBlock(blockIdx));
+                    PF_CHECK(reinterpret_cast<uintptr_t>(accessed) % PathFinder::SceneContainer::BlockAlignment == 0, "Block ", blockIdx, " is not page aligned");
+                }
+            }
+
+            PF_CHECK(reader.IsBlockCompressed(0) == compressBlocks);
+            PF_CHECK(!reader.IsBlockCompressed(1), "Incompressible block must be stored raw");
+            PF_CHECK(!reader.IsBlockCompressed(2) && !reader.IsBlockCompressed(3));
+            PF_CHECK(reader.IsBlockCompressed(4) == compressBlocks);
+
+            uint64_t descriptionBlock = reader.BlockCount() - 1;
+            std::vector<uint8_t> description(reader.BlockSize(descriptionBlock));
+            std::vector<TextureRecord> readTextureRecords;
+
+            reader.ReadBlock(descriptionBlock, description.data());
+
+            bitsery::Deserializer<bitsery::InputBufferAdapter<std::vector<uint8_t>>> deserializer{ description.begin(), description.size() };
+            deserializer.container(readTextureRecords, 16);
+
+            PF_CHECK(deserializer.adapter().isCompletedSuccessfully());
+            PF_CHECK(readTextureRecords.size() == textures.size());
+
+            // Every mip is addressable through its recorded offset
+            for (uint64_t textureIdx = 0; textureIdx < std::min(readTextureRecords.size(), textures.size()); ++textureIdx)
+            {
+                const TestTexture& texture = textures[textureIdx];
+                const TextureRecord& record = readTextureRecords[textureIdx];
+                const uint8_t* payload = reader.AccessBlock(record.Block, scratch);
+
+                PF_CHECK(record.MipOffsets == texture.MipOffsets, "Texture ", textureIdx);
+                PF_CHECK(reader.BlockSize(record.Block) == texture.Blob.size(), "Texture ", textureIdx);
+
+                for (uint64_t mip = 0; mip < std::min(record.MipOffsets.size(), texture.MipSizes.size()); ++mip)
+                {
+                    PF_CHECK(std::memcmp(payload + record.MipOffsets[mip], texture.Blob.data() + texture.MipOffsets[mip], texture.MipSizes[mip]) == 0,
+                        "Texture ", textureIdx, " mip ", mip);
+                }
+            }
+        }
+
+        std::filesystem::remove(path);
+    }
+
+}
+
+PF_TEST(SceneContainerRoundTrip)
+{
+    CheckContainerRoundTrip(false);
+}
+
+PF_TEST(SceneContainerCompressedRoundTrip)
+{
+    CheckContainerRoundTrip(true);
+}
+
+PF_BENCHMARK(SceneContainerMeshLoad)
+{
+    // Per-file bitsery streams, as Scene::Deserialize reads meshes, against a single mapped container
+    constexpr uint64_t MeshCount = 200;
+    constexpr uint64_t VertexCount = 5000;
+
+    std::vector<Vertex1P1N1UV1T1BT> vertices = GridVertices(VertexCount);
+    std::vector<uint32_t> indices(VertexCount * 3);
+
+    for (uint64_t i = 0; i < indices.size(); ++i)
+    {
+        indices[i] = uint32_t((i / 3 + i % 3) % VertexCount);
+    }
+
+    std::filesystem::path meshDirectory = TemporaryPath("MeshFiles");
+    std::filesystem::create_directories(meshDirectory);
+
+    Mesh sourceMesh;
+    sourceMesh.SetVertexData(std::vector<Vertex1P1N1UV1T1BT>{ vertices }, std::vector<uint32_t>{ indices });
+
+    for (uint64_t meshIdx = 0; meshIdx < MeshCount; ++meshIdx)
+    {
+        sourceMesh.SerializeVertexData(meshDirectory / (std::to_string(meshIdx) + ".pfmeshdat"));
+    }
+
+    for (bool compressBlocks : { false, true })
+    {
+        SceneContainerWriter writer{ TemporaryPath(compressBlocks ? "MeshesCompressed.pfscene" : "Meshes.pfscene") };
+
+        for (uint64_t meshIdx = 0; meshIdx < MeshCount; ++meshIdx)
+        {
+            writer.AddBlock(vertices.data(), vertices.size() * sizeof(Vertex1P1N1UV1T1BT), compressBlocks);
+            writer.AddBlock(indices.data(), indices.size() * sizeof(uint32_t), compressBlocks);
+        }
+
+        writer.Finalize();
+    }
+
+    std::vector<Mesh> meshes(MeshCount);
+
+    Testing::Stopwatch perFileStopwatch;
+
+    for (uint64_t meshIdx = 0; meshIdx < MeshCount; ++meshIdx)
+    {
+        meshes[meshIdx].DeserializeVertexData(meshDirectory / (std::to_string(meshIdx) + ".pfmeshdat"));
+    }
+
+    Testing::Report("Per-file bitsery", perFileStopwatch.ElapsedMilliseconds(), "ms");
+
+    for (bool compressBlocks : { false, true })
+    {
+        std::filesystem::path path = TemporaryPath(compressBlocks ? "MeshesCompressed.pfscene" : "Meshes.pfscene");
+        Testing::Stopwatch containerStopwatch;
+        SceneContainerReader reader{ path };
+
+        for (uint64_t meshIdx = 0; meshIdx < MeshCount; ++meshIdx)
+        {
+            std::vector<Vertex1P1N1UV1T1BT> readVertices(reader.BlockSize(meshIdx * 2) / sizeof(Vertex1P1N1UV1T1BT));
+            std::vector<uint32_t> readIndices(reader.BlockSize(meshIdx * 2 + 1) / sizeof(uint32_t));
+
+            reader.ReadBlock(meshIdx * 2, readVertices.data());
+            reader.ReadBlock(meshIdx * 2 + 1, readIndices.data());
+
+            meshes[meshIdx].SetVertexData(std::move(readVertices), std::move(readIndices));
+        }
+
+        double milliseconds = containerStopwatch.ElapsedMilliseconds();
+
+        Testing::Report(compressBlocks ? "Container, LZ4" : "Container, raw", milliseconds, "ms");
+        Testing::Report(compressBlocks ? "Container size, LZ4" : "Container size, raw", std::filesystem::file_size(path) / 1e6, "MB");
+
+        PF_CHECK(meshes.back().GetIndices() == indices);
+    }
+
+    std::filesystem::remove_all(std::filesystem::temp_directory_path() / "PathFinderTests");
+}
@@ -0,0 +1,193 @@
+#include "../Testing.hpp"
+
+#include <Scene/Sky.hpp>
+#include <Scene/Light.hpp>
+#include <Foundation/Pi.hpp>
+
+#include <cmath>
+
+namespace
+{
+
+    using PathFinder::Sky;
+
+    constexpr float MinSunHeight = 0.06f;
+    constexpr float MaxSunHeight = 0.99f;
+    constexpr float GroundAlbedo = 0.5f;
+
+    // Integration Sky used to perform on every update before results were cached
+    class ReferenceSky
+    {
+    public:
+        ReferenceSky()
+        {
+            mSkySpectrum.Init();
+            mGroundAlbedoSpectrum.Init();
+            mGroundAlbedoSpectrum.FromRGB(glm::vec3{ GroundAlbedo });
+        }
+
+        glm::vec3 SolarLuminance(float elevationPiOver2AtHorizon, float turbidity)
+        {
+            uint64_t sampleCount = mSkySpectrum.GetSamples().size();
+
+            for (uint64_t i = 0; i < sampleCount; ++i)
+            {
+                ArHosekSkyModelState* skyState = arhosekskymodelstate_alloc_init(elevationPiOver2AtHorizon, turbidity, mGroundAlbedoSpectrum[i]);
+                float wavelength = glm::mix(mSkySpectrum.LowestWavelength(), mSkySpectrum.HighestWavelength(), i / float(sampleCount));
+                mSkySpectrum[i] = float(arhosekskymodel_solar_radiance(skyState, elevationPiOver2AtHorizon, 0.0, wavelength));
+                arhosekskymodelstate_free(skyState);
+            }
+
+            return mSkySpectrum.ToRGB() * 100.0f * PathFinder::StandardLuminousEfficacy;
+        }
+
+    private:
+        Foundation::SampledSpectrum mSkySpectrum{ 25, 400, 700 };
+        Foundation::SampledSpectrum mGroundAlbedoSpectrum{ 25, 400, 700 };
+    };
+
+    glm::vec3 SunDirection(uint64_t step, uint64_t stepCount)
+    {
+        // Offset keeps samples away from table nodes, where interpolation is exact
+        float height = glm::mix(MinSunHeight, MaxSunHeight, (step + 0.37f) / stepCount);
+        return glm::vec3{ 0.3f, height, 0.1f };
+    }
+
+    float MaxRelativeError(const glm::vec3& value, const glm::vec3& reference)
+    {
+        glm::vec3 error = glm::abs(value - reference) / glm::abs(reference);
+        return glm::max(error.x, glm::max(error.y, error.z));
+    }
+
+}
+
+PF_TEST(SkySolarLuminanceMatchesReference)
+{
+    Sky sky;
+    ReferenceSky reference;
+    float maxError = 0.0f;
+
+    for (uint64_t step = 0; step < 500; ++step)
+    {
+        sky.SetSunDirection(SunDirection(step, 500));
+        sky.UpdateSkyState();
+
+        glm::vec3 expected = reference.SolarLuminance(std::acos(sky.GetSunDirection().y), sky.GetTurbidity());
+        maxError = std::max(maxError, MaxRelativeError(sky.GetSolarLuminance(), expected));
+    }
+
+    PF_CHECK(maxError < 1e-3f, "Max relative error: ", maxError);
+}
+
+PF_TEST(SkySolarLuminanceMatchesReferenceAcrossTurbidity)
+{
+    Sky sky;
+    ReferenceSky reference;
+    float maxError = 0.0f;
+
+    // Values on the turbidity quantization grid. Hazy skies attenuate the sun faster
+    // towards the horizon, so interpolation error grows slightly with turbidity.
+    for (float turbidity : { 1.0f, 2.5f, 4.0f, 7.3f, 10.0f })
+    {
+        sky.SetTurbidity(turbidity);
+
+        for (uint64_t step = 0; step < 50; ++step)
+        {
+            sky.SetSunDirection(SunDirection(step, 50));
+            sky.UpdateSkyState();
+
+            glm::vec3 expected = reference.SolarLuminance(std::acos(sky.GetSunDirection().y), turbidity);
+            maxError = std::max(maxError, MaxRelativeError(sky.GetSolarLuminance(), expected));
+        }
+    }
+
+    PF_CHECK(maxError < 2e-3f, "Max relative error: ", maxError);
+}
+
+PF_TEST(SkyRGBModelStatesAreExact)
+{
+    Sky sky;
+    sky.SetTurbidity(3.0f);
+
+    for (uint64_t step = 0; step < 20; ++step)
+    {
+        sky.SetSunDirection(SunDirection(step, 20));
+        sky.UpdateSkyState();
+
+        float elevationPiOver2AtZenith = M_PI_2 - std::acos(sky.GetSunDirection().y);
+        ArHosekSkyModelState* expected = arhosek_rgb_skymodelstate_alloc_init(3.0f, GroundAlbedo, elevationPiOver2AtZenith);
+        const ArHosekSkyModelState* actual = sky.GetSkyModelStateR();
+
+        for (uint64_t i = 0; i < 3; ++i)
+        {
+            PF_CHECK(actual->radiances[i] == expected->radiances[i], "Step: ", step);
+
+            for (uint64_t j = 0; j < 9; ++j)
+            {
+                PF_CHECK(actual->configs[i][j] == expected->configs[i][j], "Step: ", step);
+            }
+        }
+
+        arhosekskymodelstate_free(expected);
+    }
+}
+
+PF_BENCHMARK(SkyUpdateCost)
+{
+    {
+        Sky sky;
+        sky.UpdateSkyState();
+
+        constexpr uint64_t UpdateCount = 1000000;
+        Testing::Stopwatch stopwatch;
+
+        for (uint64_t i = 0; i < UpdateCount; ++i)
+        {
+            sky.UpdateSkyState();
+        }
+
+        Testing::Report("Update with unchanged inputs", stopwatch.ElapsedMilliseconds() * 1e6 / UpdateCount, "ns");
+    }
+
+    {
+        Sky sky;
+        constexpr uint64_t UpdateCount = 2000;
+        Testing::Stopwatch stopwatch;
+
+        for (uint64_t step = 0; step < UpdateCount; ++step)
+        {
+            sky.SetSunDirection(SunDirection(step, UpdateCount));
+            sky.UpdateSkyState();
+        }
+
+        Testing::Report("Update while sun moves, table filled on the way", stopwatch.ElapsedMilliseconds() * 1e3 / UpdateCount, "us");
+
+        Testing::Stopwatch warmStopwatch;
+
+        for (uint64_t step = 0; step < UpdateCount; ++step)
+        {
+            sky.SetSunDirection(SunDirection(UpdateCount - step - 1, UpdateCount));
+            sky.UpdateSkyState();
+        }
+
+        Testing::Report("Update while sun moves, table filled", warmStopwatch.ElapsedMilliseconds() * 1e3 / UpdateCount, "us");
+    }
+
+    {
+        ReferenceSky reference;
+        constexpr uint64_t UpdateCount = 200;
+        Testing::Stopwatch stopwatch;
+
+        for (uint64_t step = 0; step < UpdateCount; ++step)
+        {
+            reference.SolarLuminance(std::acos(SunDirection(step, UpdateCount).y), 1.7f);
+
+            for (uint64_t channel = 0; channel < 3; ++channel)
+            {
+                arhosekskymodelstate_free(arhosek_rgb_skymodelstate_alloc_init(1.7f, GroundAlbedo, 0.5f));
+            }
+        }
+
+        Testing::Report("Reference update as done every frame before", stopwatch.ElapsedMilliseconds() * 1e3 / UpdateCount, "us");
+    }
+}
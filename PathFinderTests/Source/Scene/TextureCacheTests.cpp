@@ -0,0 +1,279 @@
+#include "../Testing.hpp"
+
+#include <Scene/TextureCache.hpp>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+namespace
+{
+
+    struct FakeTexture
+    {
+        uint64_t ContentHash = 0;
+    };
+
+    using FakeTexturePtr = std::unique_ptr<FakeTexture, std::function<void(FakeTexture*)>>;
+    using FakeTextureCache = PathFinder::TextureCache<FakeTexturePtr>;
+
+    struct FakeFile
+    {
+        std::string Path;
+        uint64_t ContentHash = 0;
+        uint64_t Size = 0;
+    };
+
+    // Stands in for GPUResourceProducer and ResourceLoader: counts textures and CPU copies of texture data alive
+    class MockResourceProducer
+    {
+    public:
+        FakeTexturePtr NewTexture(uint64_t contentHash)
+        {
+            ++mCreatedTextureCount;
+            ++mAliveTextureCount;
+
+            return FakeTexturePtr{ new FakeTexture{ contentHash }, [this](FakeTexture* texture)
+            {
+                --mAliveTextureCount;
+                delete texture;
+            }};
+        }
+
+        FakeTextureCache::RowMajorBlob NewRowMajorBlob(uint64_t size)
+        {
+            mAliveBlobBytes += size;
+            mPeakBlobBytes = std::max(mPeakBlobBytes, mAliveBlobBytes);
+
+            return FakeTextureCache::RowMajorBlob{ new std::vector<uint8_t>(size), [this, size](const std::vector<uint8_t>* blob)
+            {
+                mAliveBlobBytes -= size;
+                delete blob;
+            }};
+        }
+
+    private:
+        uint64_t mCreatedTextureCount = 0;
+        uint64_t mAliveTextureCount = 0;
+        uint64_t mAliveBlobBytes = 0;
+        uint64_t mPeakBlobBytes = 0;
+
+    public:
+        inline uint64_t CreatedTextureCount() const { return mCreatedTextureCount; }
+        inline uint64_t AliveTextureCount() const { return mAliveTextureCount; }
+        inline uint64_t AliveBlobBytes() const { return mAliveBlobBytes; }
+        inline uint64_t PeakBlobBytes() const { return mPeakBlobBytes; }
+    };
+
+    // Loads textures from a table of files the way MaterialLoader loads them from disk
+    class FakeMaterialLoader
+    {
+    public:
+        FakeMaterialLoader(std::vector<FakeFile> files)
+        {
+            for (FakeFile& file : files)
+            {
+                std::string path = file.Path;
+                mFiles.emplace(path, std::move(file));
+            }
+        }
+
+        FakeTextureCache::Reference Load(const std::string& path, bool keepRowMajorBlob = false, bool streamTexture = false)
+        {
+            return mCache.GetOrLoad(path, keepRowMajorBlob,
+                [this, &path]() -> std::optional<FakeFile>
+                {
+                    auto fileIt = mFiles.find(path);
+
+                    if (fileIt == mFiles.end())
+                        return std::nullopt;
+
+                    ++mFileReadCount;
+                    return fileIt->second;
+                },
+                [this, keepRowMajorBlob, streamTexture](FakeFile& file, FakeTextureCache::Entry& entry) -> FakeTextureCache::RowMajorBlob
+                {
+                    if (streamTexture && !keepRowMajorBlob)
+                    {
+                        entry.StreamedTextureId = mNextStreamedTextureId++;
+                        return nullptr;
+                    }
+
+                    entry.Texture = mProducer.NewTexture(file.ContentHash);
+                    return keepRowMajorBlob ? mProducer.NewRowMajorBlob(file.Size) : nullptr;
+                });
+        }
+
+        const FakeTexture* LoadTexture(const std::string& path, bool keepRowMajorBlob = false)
+        {
+            FakeTextureCache::Reference reference = Load(path, keepRowMajorBlob);
+            return reference.CachedTexture ? reference.CachedTexture->Texture.get() : nullptr;
+        }
+
+    private:
+        std::unordered_map<std::string, FakeFile> mFiles;
+        MockResourceProducer mProducer;
+        FakeTextureCache mCache;
+        uint64_t mFileReadCount = 0;
+        uint64_t mNextStreamedTextureId = 0;
+
+    public:
+        inline MockResourceProducer& Producer() { return mProducer; }
+        inline FakeTextureCache& Cache() { return mCache; }
+        inline uint64_t FileReadCount() const { return mFileReadCount; }
+    };
+
+    constexpr uint64_t MB = 1024 * 1024;
+
+    // Albedo and normal maps shared between materials, and a copy of the albedo map under another name
+    std::vector<FakeFile> SharedTextureFiles()
+    {
+        return {
+            { "Textures/Brick_Albedo.dds", 1, 4 * MB },
+            { "Textures/Brick_Normal.dds", 2, 4 * MB },
+            { "Textures/Wall_Albedo.dds", 1, 4 * MB },
+            { "Textures/Wood_Albedo.dds", 3, 1 * MB }
+        };
+    }
+
+}
+
+PF_TEST(TextureCacheSharesTexturesByPathAndContent)
+{
+    FakeMaterialLoader loader{ SharedTextureFiles() };
+
+    const FakeTexture* brickAlbedo = loader.LoadTexture("Textures/Brick_Albedo.dds");
+    const FakeTexture* brickNormal = loader.LoadTexture("Textures/Brick_Normal.dds");
+
+    // Same path from other materials
+    for (uint64_t material = 0; material < 10; ++material)
+    {
+        PF_CHECK(loader.LoadTexture("Textures/Brick_Albedo.dds") == brickAlbedo);
+        PF_CHECK(loader.LoadTexture("Textures/Brick_Normal.dds") == brickNormal);
+    }
+
+    PF_CHECK(loader.FileReadCount() == 2, "Files read: ", loader.FileReadCount());
+    PF_CHECK(loader.Cache().Stats().PathHitCount == 20 && loader.Cache().Stats().MissCount == 2);
+
+    // Identical contents under another path are read once to be hashed, then found by path
+    PF_CHECK(loader.LoadTexture("Textures/Wall_Albedo.dds") == brickAlbedo);
+    PF_CHECK(loader.LoadTexture("Textures/Wall_Albedo.dds") == brickAlbedo);
+    PF_CHECK(loader.Cache().Stats().ContentHitCount == 1 && loader.Cache().Stats().PathHitCount == 21);
+    PF_CHECK(loader.FileReadCount() == 3);
+
+    PF_CHECK(loader.LoadTexture("Textures/Wood_Albedo.dds") != brickAlbedo);
+    PF_CHECK(loader.Producer().CreatedTextureCount() == 3, "Textures created: ", loader.Producer().CreatedTextureCount());
+
+    // Missing files are neither cached nor counted
+    PF_CHECK(!loader.Load("Textures/Missing.dds").CachedTexture);
+    PF_CHECK(loader.Cache().Stats().MissCount == 3);
+
+    // Textures that don't come from files share the same content keys
+    uint64_t createCount = 0;
+    auto create = [&loader, &createCount] { ++createCount; return loader.Producer().NewTexture(4); };
+
+    const FakeTexture* containerTexture = loader.Cache().GetOrCreate(4, create).Texture.get();
+
+    PF_CHECK(loader.Cache().GetOrCreate(4, create).Texture.get() == containerTexture);
+    PF_CHECK(loader.Cache().GetOrCreate(1, create).Texture.get() == brickAlbedo);
+    PF_CHECK(createCount == 1 && loader.Cache().Stats().ContentHitCount == 3 && loader.Cache().Stats().MissCount == 4);
+}
+
+PF_TEST(TextureCacheReleasesBlobsAfterSerialization)
+{
+    FakeMaterialLoader loader{ SharedTextureFiles() };
+
+    // Without serialization no CPU copies are made
+    for (const FakeFile& file : SharedTextureFiles())
+    {
+        PF_CHECK(!loader.Load(file.Path).Blob);
+    }
+
+    PF_CHECK(loader.Producer().PeakBlobBytes() == 0);
+
+    FakeMaterialLoader serializingLoader{ SharedTextureFiles() };
+
+    {
+        // Materials of a scene that is going to be serialized
+        std::vector<FakeTextureCache::RowMajorBlob> materialBlobs;
+
+        for (uint64_t material = 0; material < 20; ++material)
+        {
+            for (const FakeFile& file : SharedTextureFiles())
+            {
+                FakeTextureCache::Reference reference = serializingLoader.Load(file.Path, true);
+                PF_CHECK(reference.Blob && reference.Blob->size() == file.Size);
+                materialBlobs.push_back(std::move(reference.Blob));
+            }
+        }
+
+        // One copy per unique content, not per reference
+        PF_CHECK(serializingLoader.Producer().AliveBlobBytes() == 9 * MB, "Alive: ", serializingLoader.Producer().AliveBlobBytes() / MB, " MB");
+        PF_CHECK(serializingLoader.Producer().CreatedTextureCount() == 3);
+        PF_CHECK(materialBlobs[0] == materialBlobs[2], "Same contents under different paths don't share a blob");
+
+        // Materials are serialized one by one and drop their blobs
+        while (!materialBlobs.empty())
+        {
+            materialBlobs.pop_back();
+        }
+
+        PF_CHECK(serializingLoader.Producer().AliveBlobBytes() == 0, "Blobs left after serialization: ", serializingLoader.Producer().AliveBlobBytes() / MB, " MB");
+    }
+
+    PF_CHECK(serializingLoader.Producer().PeakBlobBytes() == 9 * MB, "Peak: ", serializingLoader.Producer().PeakBlobBytes() / MB, " MB");
+
+    // Textures stay with the cache
+    PF_CHECK(serializingLoader.Producer().AliveTextureCount() == 3);
+    PF_CHECK(serializingLoader.Load("Textures/Brick_Albedo.dds").CachedTexture->Texture);
+    PF_CHECK(serializingLoader.Producer().AliveBlobBytes() == 0);
+}
+
+PF_TEST(TextureCacheReloadsFreedBlobs)
+{
+    FakeMaterialLoader loader{ SharedTextureFiles() };
+
+    FakeTextureCache::Reference first = loader.Load("Textures/Brick_Albedo.dds", true);
+    const FakeTexture* firstTexture = first.CachedTexture->Texture.get();
+
+    // Blob that is still alive is shared
+    PF_CHECK(loader.Load("Textures/Brick_Albedo.dds", true).Blob == first.Blob);
+    PF_CHECK(loader.Load("Textures/Wall_Albedo.dds", true).Blob == first.Blob);
+    PF_CHECK(loader.Producer().CreatedTextureCount() == 1);
+
+    first.Blob = nullptr;
+    PF_CHECK(loader.Producer().AliveBlobBytes() == 0);
+
+    // Users that don't need the blob keep hitting the cache
+    PF_CHECK(loader.LoadTexture("Textures/Brick_Albedo.dds") == firstTexture);
+    PF_CHECK(loader.Cache().Stats().MissCount == 1);
+
+    // Freed blob has to be loaded again together with its texture
+    FakeTextureCache::Reference reloaded = loader.Load("Textures/Brick_Albedo.dds", true);
+
+    PF_CHECK(reloaded.Blob && reloaded.Blob->size() == 4 * MB);
+    PF_CHECK(loader.Cache().Stats().MissCount == 2 && loader.FileReadCount() == 3);
+    PF_CHECK(loader.Cache().ReplacedTextureCount() == 1);
+
+    // Previous texture is kept for materials that still reference it
+    PF_CHECK(loader.Producer().AliveTextureCount() == 2);
+    PF_CHECK(firstTexture->ContentHash == 1);
+
+    // Both paths of the content now resolve to the reloaded texture and blob
+    PF_CHECK(loader.Load("Textures/Wall_Albedo.dds", true).Blob == reloaded.Blob);
+    PF_CHECK(loader.LoadTexture("Textures/Brick_Albedo.dds") == reloaded.CachedTexture->Texture.get());
+
+    // Streamed textures can't be serialized, a blob request reloads them without streaming
+    FakeTextureCache::Reference streamed = loader.Load("Textures/Wood_Albedo.dds", false, true);
+
+    PF_CHECK(streamed.CachedTexture->StreamedTextureId && !streamed.CachedTexture->Texture);
+
+    FakeTextureCache::Reference wood = loader.Load("Textures/Wood_Albedo.dds", true);
+
+    PF_CHECK(!wood.CachedTexture->StreamedTextureId && wood.CachedTexture->Texture && wood.Blob);
+    PF_CHECK(loader.Cache().ReplacedTextureCount() == 1);
+}
@@ -0,0 +1,290 @@
+#include "../Testing.hpp"
+
+#include <Scene/TextureFileLayout.hpp>
+#include <Foundation/MemoryMappedFile.hpp>
+
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+    using PathFinder::TextureFileLayout;
+
+    constexpr uint64_t RowPitchAlignment = 256;
+    constexpr uint64_t PlacementAlignment = 512;
+
+    uint64_t AlignUp(uint64_t value, uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // Places subresources the way D3D12 footprints do: aligned offsets and padded row pitches
+    std::vector<TextureFileLayout::Placement> PlaceSubresources(const ddsktx_texture_info& info, const uint8_t* data, uint64_t size, uint16_t mostDetailedMip, uint64_t& totalSize)
+    {
+        std::vector<TextureFileLayout::Placement> placements;
+        totalSize = 0;
+
+        for (const TextureFileLayout::Subresource& subresource : TextureFileLayout::Subresources(info, data, size))
+        {
+            if (subresource.Mip < mostDetailedMip)
+            {
+                continue;
+            }
+
+            TextureFileLayout::Placement& placement = placements.emplace_back();
+            placement.Offset = AlignUp(totalSize, PlacementAlignment);
+            placement.RowPitch = AlignUp(subresource.RowSizeInBytes, RowPitchAlignment);
+            placement.RowSizeInBytes = subresource.RowSizeInBytes;
+            placement.RowCount = subresource.RowCount;
+            totalSize = placement.Offset + placement.RowPitch * placement.RowCount * subresource.DepthSliceCount;
+        }
+
+        return placements;
+    }
+
+    // Uncompressed RGBA8 cube map array, every texel holds its array slice, mip and index within the mip
+    std::vector<uint8_t> MakeCubeArrayFile(uint32_t width, uint32_t height, uint32_t mipCount, uint32_t cubeCount)
+    {
+        std::vector<uint32_t> header(32 + 5, 0);
+        header[0] = 0x20534444; // "DDS "
+        header[1] = 124;
+        header[2] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000; // Caps, height, width, pixel format, mip count
+        header[3] = height;
+        header[4] = width;
+        header[7] = mipCount;
+        header[19] = 32;
+        header[20] = 0x4; // Four CC
+        header[21] = 0x30315844; // "DX10"
+        header[27] = 0x1000 | 0x8 | 0x400000; // Texture, complex, mip map
+        header[28] = 0x200 | 0xFC00; // Cube map with all faces
+        header[32] = 28; // DXGI_FORMAT_R8G8B8A8_UNORM
+        header[33] = 3; // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+        header[34] = 0x4; // Cube map
+        header[35] = cubeCount;
+
+        std::vector<uint8_t> bytes{ (uint8_t*)header.data(), (uint8_t*)(header.data() + header.size()) };
+
+        for (uint32_t slice = 0; slice < cubeCount * 6; ++slice)
+        {
+            for (uint32_t mip = 0; mip < mipCount; ++mip)
+            {
+                uint32_t texelCount = std::max(width >> mip, 1u) * std::max(height >> mip, 1u);
+
+                for (uint32_t i = 0; i < texelCount; ++i)
+                {
+                    bytes.insert(bytes.end(), { uint8_t(slice), uint8_t(mip), uint8_t(i), uint8_t(i >> 8) });
+                }
+            }
+        }
+
+        return bytes;
+    }
+
+    std::vector<std::filesystem::path> BundledTextureFiles()
+    {
+        std::vector<std::filesystem::path> paths;
+        std::filesystem::path root{ PATHFINDER_DIR };
+
+        for (const char* directory : { "MediaResources", "Source/Scene/Precompiled" })
+        {
+            for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator{ root / directory })
+            {
+                std::string extension = entry.path().extension().string();
+                std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+                if (entry.is_regular_file() && extension == ".dds")
+                {
+                    paths.push_back(entry.path());
+                }
+            }
+        }
+
+        return paths;
+    }
+
+}
+
+PF_TEST(TextureFileLayoutCopiesCubeArrayTexels)
+{
+    constexpr uint32_t Width = 64;
+    constexpr uint32_t Height = 64;
+    constexpr uint32_t MipCount = 7;
+    constexpr uint32_t CubeCount = 2;
+
+    std::vector<uint8_t> file = MakeCubeArrayFile(Width, Height, MipCount, CubeCount);
+    ddsktx_texture_info info{};
+
+    PF_CHECK(ddsktx_parse(&info, file.data(), (int)file.size(), nullptr), "Synthetic file must parse");
+    PF_CHECK(TextureFileLayout::ArraySize(info) == CubeCount * 6);
+    PF_CHECK(!TextureFileLayout::IsVolume(info));
+
+    for (uint16_t mostDetailedMip : { 0, 2 })
+    {
+        uint64_t totalSize = 0;
+        std::vector<TextureFileLayout::Placement> placements = PlaceSubresources(info, file.data(), file.size(), mostDetailedMip, totalSize);
+        std::vector<uint8_t> destination(totalSize, 0xCD);
+
+        TextureFileLayout::CopySubresources(info, file.data(), file.size(), mostDetailedMip, placements, destination.data());
+
+        uint32_t loadedMipCount = MipCount - mostDetailedMip;
+        uint64_t mismatchCount = 0;
+
+        PF_CHECK(placements.size() == CubeCount * 6 * loadedMipCount);
+
+        for (uint32_t subresourceIdx = 0; subresourceIdx < placements.size(); ++subresourceIdx)
+        {
+            const TextureFileLayout::Placement& placement = placements[subresourceIdx];
+            uint32_t slice = subresourceIdx / loadedMipCount;
+            uint32_t mip = subresourceIdx % loadedMipCount + mostDetailedMip;
+            uint32_t width = std::max(Width >> mip, 1u);
+
+            for (uint32_t row = 0; row < placement.RowCount; ++row)
+            {
+                for (uint32_t x = 0; x < width; ++x)
+                {
+                    const uint8_t* texel = destination.data() + placement.Offset + row * placement.RowPitch + x * 4;
+                    uint32_t i = row * width + x;
+
+                    if (texel[0] != slice || texel[1] != mip || texel[2] != uint8_t(i) || texel[3] != uint8_t(i >> 8))
+                    {
+                        ++mismatchCount;
+                    }
+                }
+            }
+        }
+
+        PF_CHECK(mismatchCount == 0, "Most detailed mip: ", mostDetailedMip, " Mismatching texels: ", mismatchCount);
+    }
+}
+
+PF_TEST(TextureFileLayoutMatchesBundledTextures)
+{
+    // Every subresource row copied into padded placements must match what dds-ktx reports for that subresource,
+    // and subresources must cover the whole pixel data of the file
+    std::vector<std::filesystem::path> paths = BundledTextureFiles();
+    uint64_t checkedSubresourceCount = 0;
+
+    PF_CHECK(!paths.empty(), "No textures found in ", PATHFINDER_DIR);
+
+    for (const std::filesystem::path& path : paths)
+    {
+        Foundation::MemoryMappedFile file{ path };
+        ddsktx_texture_info info{};
+
+        PF_CHECK(file.IsMapped(), path.string());
+
+        if (!file.IsMapped() || !ddsktx_parse(&info, file.Data(), (int)file.Size(), nullptr))
+        {
+            PF_CHECK(false, "Unparsable: ", path.string());
+            continue;
+        }
+
+        std::vector<TextureFileLayout::Subresource> subresources = TextureFileLayout::Subresources(info, file.Data(), file.Size());
+        uint64_t pixelDataSize = 0;
+
+        for (const TextureFileLayout::Subresource& subresource : subresources)
+        {
+            pixelDataSize += subresource.SizeInBytes;
+        }
+
+        PF_CHECK(pixelDataSize == file.Size() - info.data_offset, path.string(), " Subresources: ", pixelDataSize, " File: ", file.Size() - info.data_offset);
+
+        uint64_t totalSize = 0;
+        std::vector<TextureFileLayout::Placement> placements = PlaceSubresources(info, file.Data(), file.Size(), 0, totalSize);
+        std::vector<uint8_t> destination(totalSize, 0xCD);
+
+        TextureFileLayout::CopySubresources(info, file.Data(), file.Size(), 0, placements, destination.data());
+
+        bool isCubeMap = info.flags & DDSKTX_TEXTURE_FLAG_CUBEMAP;
+
+        for (uint64_t subresourceIdx = 0; subresourceIdx < subresources.size(); ++subresourceIdx)
+        {
+            const TextureFileLayout::Subresource& subresource = subresources[subresourceIdx];
+            const TextureFileLayout::Placement& placement = placements[subresourceIdx];
+
+            for (uint64_t depthSlice = 0; depthSlice < subresource.DepthSliceCount; ++depthSlice)
+            {
+                int layer = isCubeMap ? subresource.ArraySlice / DDSKTX_CUBE_FACE_COUNT : subresource.ArraySlice;
+                int sliceOrFace = isCubeMap ? subresource.ArraySlice % DDSKTX_CUBE_FACE_COUNT : (int)depthSlice;
+
+                ddsktx_sub_data reference{};
+                ddsktx_get_sub(&info, &reference, file.Data(), (int)file.Size(), layer, sliceOrFace, subresource.Mip);
+
+                PF_CHECK(uint64_t(reference.size_bytes) == subresource.RowSizeInBytes * subresource.RowCount,
+                    path.string(), " Mip: ", subresource.Mip, " Reference size: ", reference.size_bytes);
+
+                const uint8_t* referenceData = (const uint8_t*)reference.buff;
+                bool identical = true;
+
+                for (uint64_t row = 0; row < subresource.RowCount && identical; ++row)
+                {
+                    const uint8_t* copiedRow = destination.data() + placement.Offset + (depthSlice * subresource.RowCount + row) * placement.RowPitch;
+                    identical = memcmp(copiedRow, referenceData + row * subresource.RowSizeInBytes, subresource.RowSizeInBytes) == 0;
+                }
+
+                PF_CHECK(identical, path.string(), " Array slice: ", subresource.ArraySlice, " Mip: ", subresource.Mip, " Depth slice: ", depthSlice);
+            }
+
+            ++checkedSubresourceCount;
+        }
+    }
+
+    PF_CHECK(checkedSubresourceCount > 0);
+}
+
+PF_BENCHMARK(TextureFileLayoutBundledTextureCopy)
+{
+    struct MappedTexture
+    {
+        Foundation::MemoryMappedFile File;
+        ddsktx_texture_info Info{};
+        std::vector<TextureFileLayout::Placement> Placements;
+        std::vector<uint8_t> Destination;
+    };
+
+    std::vector<MappedTexture> textures;
+    uint64_t totalBytes = 0;
+
+    for (const std::filesystem::path& path : BundledTextureFiles())
+    {
+        MappedTexture& texture = textures.emplace_back();
+        texture.File = Foundation::MemoryMappedFile{ path };
+
+        if (!texture.File.IsMapped() || !ddsktx_parse(&texture.Info, texture.File.Data(), (int)texture.File.Size(), nullptr))
+        {
+            textures.pop_back();
+            continue;
+        }
+
+        uint64_t totalSize = 0;
+        texture.Placements = PlaceSubresources(texture.Info, texture.File.Data(), texture.File.Size(), 0, totalSize);
+        texture.Destination.resize(totalSize);
+        totalBytes += texture.File.Size();
+    }
+
+    constexpr uint64_t PassCount = 10;
+
+    // Warm up page cache and destination memory
+    for (MappedTexture& texture : textures)
+    {
+        TextureFileLayout::CopySubresources(texture.Info, texture.File.Data(), texture.File.Size(), 0, texture.Placements, texture.Destination.data());
+    }
+
+    Testing::Stopwatch stopwatch;
+
+    for (uint64_t pass = 0; pass < PassCount; ++pass)
+    {
+        for (MappedTexture& texture : textures)
+        {
+            TextureFileLayout::CopySubresources(texture.Info, texture.File.Data(), texture.File.Size(), 0, texture.Placements, texture.Destination.data());
+        }
+    }
+
+    double milliseconds = stopwatch.ElapsedMilliseconds() / PassCount;
+
+    Testing::Report("Bundled textures copy into padded subresources", milliseconds, "ms");
+    Testing::Report("Copy throughput", totalBytes / 1048576.0 / (milliseconds / 1000.0), "MB/s");
+}
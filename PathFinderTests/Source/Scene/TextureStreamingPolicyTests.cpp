@@ -0,0 +1,308 @@
+#include "../Testing.hpp"
+
+#include <Scene/TextureStreamingPolicy.hpp>
+
+#include <random>
+#include <deque>
+#include <map>
+#include <vector>
+#include <algorithm>
+
+namespace
+{
+
+    using PathFinder::TextureStreamingPolicy;
+    using TextureId = TextureStreamingPolicy::TextureId;
+
+    constexpr uint64_t MB = 1024 * 1024;
+
+    // Stands in for TextureStreamer: applies requested residency changes after a fixed number of frames
+    class SimulatedBackend
+    {
+    public:
+        struct Request
+        {
+            TextureId Id;
+            uint16_t MostDetailedMip;
+            uint64_t ReadyFrame;
+        };
+
+        SimulatedBackend(uint64_t latencyInFrames) : mLatency{ latencyInFrames } {}
+
+        TextureStreamingPolicy::ResidencyChangeCallback Callback()
+        {
+            return [this](TextureId textureId, uint16_t mostDetailedMip) { RequestResidencyChange(textureId, mostDetailedMip); };
+        }
+
+        void AddTexture(TextureStreamingPolicy& policy, TextureId textureId, const TextureStreamingPolicy::TextureDescription& description)
+        {
+            policy.AddTexture(textureId, description);
+            mResidentMips[textureId] = description.MipTailStart;
+        }
+
+        // Completes changes whose latency has passed
+        void Tick(TextureStreamingPolicy& policy)
+        {
+            ++mFrame;
+
+            while (!mRequests.empty() && mRequests.front().ReadyFrame <= mFrame)
+            {
+                Request request = mRequests.front();
+                mRequests.pop_front();
+                mResidentMips[request.Id] = request.MostDetailedMip;
+                policy.CompleteResidencyChange(request.Id, request.MostDetailedMip);
+            }
+        }
+
+        // Mip a texture will have once its changes in flight complete
+        uint16_t TargetMip(TextureId textureId) const
+        {
+            uint16_t mip = mResidentMips.at(textureId);
+
+            for (const Request& request : mRequests)
+            {
+                if (request.Id == textureId)
+                {
+                    mip = request.MostDetailedMip;
+                }
+            }
+
+            return mip;
+        }
+
+    private:
+        void RequestResidencyChange(TextureId textureId, uint16_t mostDetailedMip)
+        {
+            ++(mostDetailedMip < TargetMip(textureId) ? mLoadCount : mEvictionCount);
+            mRequests.push_back({ textureId, mostDetailedMip, mFrame + mLatency });
+        }
+
+        uint64_t mLatency = 0;
+        uint64_t mFrame = 0;
+        uint64_t mLoadCount = 0;
+        uint64_t mEvictionCount = 0;
+        std::deque<Request> mRequests;
+        std::map<TextureId, uint16_t> mResidentMips;
+
+    public:
+        inline auto InFlightRequestCount() const { return mRequests.size(); }
+        inline auto LoadCount() const { return mLoadCount; }
+        inline auto EvictionCount() const { return mEvictionCount; }
+    };
+
+    // Square single byte per texel texture with a full mip chain
+    TextureStreamingPolicy::TextureDescription SquareTexture(uint64_t size, uint16_t mipTailStart)
+    {
+        TextureStreamingPolicy::TextureDescription description;
+
+        for (uint64_t mipSize = size; mipSize >= 1; mipSize /= 2)
+        {
+            description.MipSizes.push_back(mipSize * mipSize);
+        }
+
+        description.MipTailStart = mipTailStart;
+        return description;
+    }
+
+    uint64_t MipChainSize(const TextureStreamingPolicy::TextureDescription& description, uint16_t mostDetailedMip)
+    {
+        uint64_t size = 0;
+
+        for (uint64_t mip = mostDetailedMip; mip < description.MipSizes.size(); ++mip)
+        {
+            size += description.MipSizes[mip];
+        }
+
+        return size;
+    }
+
+}
+
+PF_TEST(TextureStreamingPolicyGivesBudgetToHigherPriority)
+{
+    TextureStreamingPolicy::TextureDescription description = SquareTexture(1024, 3);
+    SimulatedBackend backend{ 0 };
+
+    // Budget fits only one full texture
+    TextureStreamingPolicy policy{ MipChainSize(description, 0) + MipChainSize(description, 3), backend.Callback() };
+
+    backend.AddTexture(policy, 1, description);
+    backend.AddTexture(policy, 2, description);
+
+    policy.ReportUsage(1, 0, 10.0f);
+    policy.ReportUsage(2, 0, 50.0f);
+    policy.Update(1);
+    backend.Tick(policy);
+
+    PF_CHECK(policy.ResidentMip(2) == 0);
+    PF_CHECK(policy.ResidentMip(1) == 3);
+    PF_CHECK(policy.CommittedMemory() <= policy.MemoryBudget());
+}
+
+PF_TEST(TextureStreamingPolicyLoadsMostDetailThatFits)
+{
+    TextureStreamingPolicy::TextureDescription description = SquareTexture(1024, 4);
+    SimulatedBackend backend{ 0 };
+    TextureStreamingPolicy policy{ MipChainSize(description, 1), backend.Callback() };
+
+    backend.AddTexture(policy, 7, description);
+
+    policy.ReportUsage(7, 0, 1.0f);
+    policy.Update(1);
+    backend.Tick(policy);
+
+    PF_CHECK(policy.ResidentMip(7) == 1);
+    PF_CHECK(policy.Stats().RequestCount == 1);
+}
+
+PF_TEST(TextureStreamingPolicyEvictsLeastRecentlyUsed)
+{
+    TextureStreamingPolicy::TextureDescription description = SquareTexture(512, 2);
+    SimulatedBackend backend{ 0 };
+    TextureStreamingPolicy policy{ MipChainSize(description, 0) * 3 + MipChainSize(description, 2), backend.Callback() };
+    uint64_t frameNumber = 0;
+
+    for (TextureId textureId = 1; textureId <= 4; ++textureId)
+    {
+        backend.AddTexture(policy, textureId, description);
+    }
+
+    auto useTexture = [&](TextureId textureId)
+    {
+        policy.ReportUsage(textureId, 0, 1.0f);
+        policy.Update(++frameNumber);
+        backend.Tick(policy);
+    };
+
+    useTexture(1);
+    useTexture(2);
+    useTexture(3);
+
+    // Texture 2 becomes the least recently used one
+    useTexture(1);
+    useTexture(4);
+
+    PF_CHECK(policy.ResidentMip(4) == 0);
+    PF_CHECK(policy.ResidentMip(2) == 2);
+    PF_CHECK(policy.ResidentMip(1) == 0 && policy.ResidentMip(3) == 0);
+    PF_CHECK(policy.Stats().EvictionCount == 1);
+}
+
+PF_TEST(TextureStreamingPolicyTrimsUsedTexturesInsteadOfEvicting)
+{
+    TextureStreamingPolicy::TextureDescription description = SquareTexture(512, 2);
+    SimulatedBackend backend{ 0 };
+    TextureStreamingPolicy policy{ MipChainSize(description, 0) + MipChainSize(description, 2), backend.Callback() };
+
+    backend.AddTexture(policy, 1, description);
+    backend.AddTexture(policy, 2, description);
+
+    policy.ReportUsage(1, 0, 1.0f);
+    policy.Update(1);
+    backend.Tick(policy);
+
+    // Texture still in use keeps what it needs even against a more important one
+    policy.ReportUsage(1, 0, 1.0f);
+    policy.ReportUsage(2, 0, 100.0f);
+    policy.Update(2);
+    backend.Tick(policy);
+
+    PF_CHECK(policy.ResidentMip(1) == 0 && policy.ResidentMip(2) > 0);
+
+    // Once less detail is needed, freed memory goes to the other texture
+    policy.ReportUsage(1, 1, 1.0f);
+    policy.ReportUsage(2, 0, 100.0f);
+    policy.Update(3);
+    backend.Tick(policy);
+
+    PF_CHECK(policy.ResidentMip(1) == 1 && policy.ResidentMip(2) < 2);
+}
+
+PF_TEST(TextureStreamingPolicyKeepsBudgetWithLatentBackend)
+{
+    // Camera sweeps over a scene of random sized textures while changes take several frames to apply,
+    // budget is halved midway. Committed memory must stay within budget and match what backend will end up with.
+    constexpr uint64_t TextureCount = 300;
+    constexpr uint64_t VisibleTextureCount = 40;
+    constexpr uint16_t MipTailStart = 4;
+
+    SimulatedBackend backend{ 3 };
+    TextureStreamingPolicy policy{ 96 * MB, backend.Callback() };
+    std::vector<TextureStreamingPolicy::TextureDescription> descriptions;
+    std::mt19937 rng{ 42 };
+    uint64_t maxChangesPerFrame = 0;
+
+    for (TextureId textureId = 0; textureId < TextureCount; ++textureId)
+    {
+        descriptions.push_back(SquareTexture(256ull << (rng() % 4), MipTailStart));
+        backend.AddTexture(policy, textureId, descriptions.back());
+    }
+
+    for (uint64_t frameNumber = 1; frameNumber <= 2000; ++frameNumber)
+    {
+        if (frameNumber == 1000)
+        {
+            policy.SetMemoryBudget(48 * MB);
+        }
+
+        uint64_t firstVisible = (frameNumber / 4) % TextureCount;
+
+        for (uint64_t i = 0; i < VisibleTextureCount; ++i)
+        {
+            policy.ReportUsage((firstVisible + i) % TextureCount, uint16_t(rng() % 3), float(VisibleTextureCount - i));
+        }
+
+        uint64_t requestCountBefore = backend.InFlightRequestCount();
+        policy.Update(frameNumber);
+        maxChangesPerFrame = std::max<uint64_t>(maxChangesPerFrame, backend.InFlightRequestCount() - requestCountBefore);
+        backend.Tick(policy);
+
+        uint64_t targetMemory = 0;
+
+        for (TextureId textureId = 0; textureId < TextureCount; ++textureId)
+        {
+            targetMemory += MipChainSize(descriptions[textureId], backend.TargetMip(textureId));
+        }
+
+        PF_CHECK(targetMemory == policy.CommittedMemory(), "Frame: ", frameNumber, " Backend: ", targetMemory, " Policy: ", policy.CommittedMemory());
+        PF_CHECK(policy.CommittedMemory() <= policy.MemoryBudget(), "Frame: ", frameNumber, " Committed: ", policy.CommittedMemory());
+    }
+
+    PF_CHECK(backend.LoadCount() > 0 && backend.EvictionCount() > 0, "Loads: ", backend.LoadCount(), " Evictions: ", backend.EvictionCount());
+    PF_CHECK(policy.Stats().RequestCount == backend.LoadCount());
+}
+
+PF_BENCHMARK(TextureStreamingPolicyUpdate)
+{
+    constexpr uint64_t TextureCount = 5000;
+    constexpr uint64_t VisibleTextureCount = 1000;
+    constexpr uint64_t FrameCount = 1000;
+
+    SimulatedBackend backend{ 2 };
+    TextureStreamingPolicy policy{ 256 * MB, backend.Callback() };
+    std::mt19937 rng{ 1 };
+
+    for (TextureId textureId = 0; textureId < TextureCount; ++textureId)
+    {
+        backend.AddTexture(policy, textureId, SquareTexture(256ull << (rng() % 4), 4));
+    }
+
+    Testing::Stopwatch stopwatch;
+
+    for (uint64_t frameNumber = 1; frameNumber <= FrameCount; ++frameNumber)
+    {
+        uint64_t firstVisible = (frameNumber * 5) % TextureCount;
+
+        for (uint64_t i = 0; i < VisibleTextureCount; ++i)
+        {
+            policy.ReportUsage((firstVisible + i) % TextureCount, uint16_t(rng() % 3), float(VisibleTextureCount - i));
+        }
+
+        policy.Update(frameNumber);
+        backend.Tick(policy);
+    }
+
+    Testing::Report("Usage reports and update per frame", stopwatch.ElapsedMilliseconds() * 1000.0 / FrameCount, "us");
+    Testing::Report("Loads", double(backend.LoadCount()), "requests");
+    Testing::Report("Evictions", double(backend.EvictionCount()), "requests");
+}
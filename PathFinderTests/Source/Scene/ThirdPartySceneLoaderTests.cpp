@@ -0,0 +1,129 @@
+#include "../Testing.hpp"
+
+#include <Scene/ThirdPartySceneLoader.hpp>
+
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+    using PathFinder::ThirdPartySceneLoader;
+    using PathFinder::Vertex1P1N1UV1T1BT;
+
+    std::vector<std::filesystem::path> BundledObjFiles()
+    {
+        std::filesystem::path root{ PATHFINDER_DIR };
+        std::vector<std::filesystem::path> files;
+
+        for (const char* file : { "MediaResources/Models/cube.obj", "MediaResources/Models/plane.obj", "MediaResources/Models/sphere3.obj",
+            "Source/Scene/Precompiled/UnitCube.obj", "Source/Scene/Precompiled/UnitSphere.obj" })
+        {
+            files.push_back(root / file);
+        }
+
+        return files;
+    }
+
+    bool AreSameVertices(const std::vector<Vertex1P1N1UV1T1BT>& vertices, const std::vector<Vertex1P1N1UV1T1BT>& expectedVertices)
+    {
+        return vertices.size() == expectedVertices.size() &&
+            std::memcmp(vertices.data(), expectedVertices.data(), vertices.size() * sizeof(Vertex1P1N1UV1T1BT)) == 0;
+    }
+
+    // Wall time of each import stage, accumulated over repeated imports
+    struct StageTimes
+    {
+        double Parsing = 0.0;
+        double Conversion = 0.0;
+        uint64_t VertexCount = 0;
+
+        void Import(ThirdPartySceneLoader& loader, const std::filesystem::path& path, Foundation::ThreadPool* threadPool)
+        {
+            Testing::Stopwatch parsingStopwatch;
+            loader.ReadSceneFile(path);
+            Parsing += parsingStopwatch.ElapsedMilliseconds();
+
+            Testing::Stopwatch conversionStopwatch;
+            loader.ProcessMeshes(threadPool);
+            Conversion += conversionStopwatch.ElapsedMilliseconds();
+
+            VertexCount = 0;
+
+            for (const ThirdPartySceneLoader::LoadedMesh& mesh : loader.LoadedMeshes())
+            {
+                VertexCount += mesh.MeshObject.GetVertices().size();
+            }
+        }
+    };
+
+}
+
+PF_TEST(ThirdPartySceneLoaderConvertsSameMeshesOnThreadPool)
+{
+    Foundation::ThreadPool threadPool;
+    ThirdPartySceneLoader serialLoader;
+    ThirdPartySceneLoader parallelLoader;
+
+    for (const std::filesystem::path& path : BundledObjFiles())
+    {
+        std::vector<ThirdPartySceneLoader::LoadedMesh>& serialMeshes = serialLoader.Load(path);
+
+        parallelLoader.ReadSceneFile(path);
+        std::vector<ThirdPartySceneLoader::LoadedMesh>& parallelMeshes = parallelLoader.ProcessMeshes(&threadPool);
+
+        PF_CHECK(!serialMeshes.empty(), path.string());
+        PF_CHECK(serialMeshes.size() == parallelMeshes.size(), path.string());
+
+        for (uint64_t meshIdx = 0; meshIdx < std::min(serialMeshes.size(), parallelMeshes.size()); ++meshIdx)
+        {
+            const PathFinder::Mesh& serialMesh = serialMeshes[meshIdx].MeshObject;
+            const PathFinder::Mesh& parallelMesh = parallelMeshes[meshIdx].MeshObject;
+
+            PF_CHECK(serialMesh.GetIndices() == parallelMesh.GetIndices(), path.string(), " ", serialMesh.GetName());
+            PF_CHECK(AreSameVertices(serialMesh.GetVertices(), parallelMesh.GetVertices()), path.string(), " ", serialMesh.GetName());
+            PF_CHECK(serialMeshes[meshIdx].MaterialIndex == parallelMeshes[meshIdx].MaterialIndex);
+        }
+    }
+}
+
+PF_BENCHMARK(ThirdPartySceneLoaderBundledObjImport)
+{
+    // Files are small, so each is imported many times to get stable numbers
+    constexpr uint64_t RepeatCount = 50;
+
+    Foundation::ThreadPool threadPool;
+    ThirdPartySceneLoader loader;
+    StageTimes totalSerialTimes;
+    StageTimes totalParallelTimes;
+
+    for (const std::filesystem::path& path : BundledObjFiles())
+    {
+        StageTimes serialTimes;
+        StageTimes parallelTimes;
+
+        for (uint64_t repeat = 0; repeat < RepeatCount; ++repeat)
+        {
+            serialTimes.Import(loader, path, nullptr);
+            parallelTimes.Import(loader, path, &threadPool);
+        }
+
+        std::string name = path.filename().string() + " (" + std::to_string(serialTimes.VertexCount) + " vertices)";
+
+        Testing::Report(name + " parsing", serialTimes.Parsing / RepeatCount, "ms");
+        Testing::Report(name + " conversion, 1 thread", serialTimes.Conversion / RepeatCount, "ms");
+        Testing::Report(name + " conversion, thread pool", parallelTimes.Conversion / RepeatCount, "ms");
+
+        totalSerialTimes.Parsing += serialTimes.Parsing;
+        totalSerialTimes.Conversion += serialTimes.Conversion;
+        totalParallelTimes.Parsing += parallelTimes.Parsing;
+        totalParallelTimes.Conversion += parallelTimes.Conversion;
+    }
+
+    Testing::Report("Total, 1 thread", (totalSerialTimes.Parsing + totalSerialTimes.Conversion) / RepeatCount, "ms");
+    Testing::Report("Total, thread pool", (totalParallelTimes.Parsing + totalParallelTimes.Conversion) / RepeatCount, "ms");
+    Testing::Report("Thread pool size", double(threadPool.ThreadCount()), "threads");
+}
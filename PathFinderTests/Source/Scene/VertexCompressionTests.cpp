@@ -0,0 +1,245 @@
+#include "../Testing.hpp"
+
+#include <Scene/Vertices/Vertex1P1N1UV1T1BTCompressed.hpp>
+
+#include <glm/geometric.hpp>
+
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+    using PathFinder::Vertex1P1N1UV1T1BT;
+    using PathFinder::Vertex1P1N1UV1T1BTCompressed;
+
+    // 16 bit octahedral encoding keeps directions within hundredths of a degree
+    constexpr double MaxNormalErrorDegrees = 0.01;
+    constexpr double MaxTangentErrorDegrees = 0.02;
+    constexpr double MaxBitangentErrorDegrees = 0.03;
+
+    // Half floats have 11 significant bits
+    constexpr double MaxUnitUVError = 1.0 / 4096.0;
+    constexpr double MaxRelativeUVError = 1.0 / 2048.0;
+
+    // Measured in double precision through the chord length, acos loses precision near zero
+    double AngleInDegrees(const glm::vec3& first, const glm::vec3& second)
+    {
+        glm::dvec3 a = glm::normalize(glm::dvec3{ first });
+        glm::dvec3 b = glm::normalize(glm::dvec3{ second });
+        return 2.0 * std::asin(std::min(1.0, glm::length(a - b) * 0.5)) * 180.0 / 3.14159265358979323846;
+    }
+
+    // Random orthonormal tangent frames with bitangents of either orientation
+    class TangentFrameGenerator
+    {
+    public:
+        TangentFrameGenerator(uint32_t seed) : mRNG{ seed } {}
+
+        Vertex1P1N1UV1T1BT Generate(const glm::vec3& normal, const glm::vec2& uv)
+        {
+            glm::vec3 tangent = glm::normalize(glm::cross(normal, RandomDirection()));
+            float bitangentSign = mUnitDistribution(mRNG) < 0.5f ? -1.0f : 1.0f;
+            glm::vec3 bitangent = glm::cross(normal, tangent) * bitangentSign;
+            glm::vec4 position{ mWideDistribution(mRNG), mWideDistribution(mRNG), mWideDistribution(mRNG), 1.0f };
+
+            return { position, uv, normal, tangent, bitangent };
+        }
+
+        glm::vec3 RandomDirection()
+        {
+            return glm::normalize(glm::vec3{ mNormalDistribution(mRNG), mNormalDistribution(mRNG), mNormalDistribution(mRNG) });
+        }
+
+        glm::vec2 RandomUnitUV() { return { mUnitDistribution(mRNG), mUnitDistribution(mRNG) }; }
+        glm::vec2 RandomWideUV() { return { mWideDistribution(mRNG), mWideDistribution(mRNG) }; }
+
+    private:
+        std::mt19937 mRNG;
+        std::normal_distribution<float> mNormalDistribution{ 0.0f, 1.0f };
+        std::uniform_real_distribution<float> mUnitDistribution{ 0.0f, 1.0f };
+        std::uniform_real_distribution<float> mWideDistribution{ -64.0f, 64.0f };
+    };
+
+    // Axis aligned directions, octahedron face centers and octahedron edges, where encoding folds and wraps
+    std::vector<glm::vec3> SpecialDirections()
+    {
+        std::vector<glm::vec3> directions;
+
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+            for (float sign : { -1.0f, 1.0f })
+            {
+                glm::vec3 direction{ 0.0f };
+                direction[axis] = sign;
+                directions.push_back(direction);
+            }
+        }
+
+        for (float x : { -1.0f, 1.0f })
+        {
+            for (float y : { -1.0f, 1.0f })
+            {
+                directions.push_back(glm::normalize(glm::vec3{ x, y, 0.0f }));
+                directions.push_back(glm::normalize(glm::vec3{ x, 0.0f, y }));
+                directions.push_back(glm::normalize(glm::vec3{ 0.0f, x, y }));
+
+                for (float z : { -1.0f, 1.0f })
+                {
+                    directions.push_back(glm::normalize(glm::vec3{ x, y, z }));
+                }
+            }
+        }
+
+        return directions;
+    }
+
+    struct RoundTripErrors
+    {
+        double Normal = 0.0;
+        double Tangent = 0.0;
+        double Bitangent = 0.0;
+        uint64_t BitangentSignErrors = 0;
+        uint64_t PositionMismatches = 0;
+        uint64_t NaNs = 0;
+
+        void Accumulate(const Vertex1P1N1UV1T1BT& original, const Vertex1P1N1UV1T1BT& decompressed)
+        {
+            Normal = std::max(Normal, AngleInDegrees(original.Normal, decompressed.Normal));
+            Tangent = std::max(Tangent, AngleInDegrees(original.Tangent, decompressed.Tangent));
+            Bitangent = std::max(Bitangent, AngleInDegrees(original.Bitangent, decompressed.Bitangent));
+            BitangentSignErrors += glm::dot(original.Bitangent, decompressed.Bitangent) <= 0.0f;
+            PositionMismatches += original.Position != decompressed.Position;
+
+            for (const glm::vec3& vector : { decompressed.Normal, decompressed.Tangent, decompressed.Bitangent })
+            {
+                NaNs += std::isnan(vector.x) || std::isnan(vector.y) || std::isnan(vector.z);
+            }
+        }
+    };
+
+}
+
+PF_TEST(VertexCompressionTangentFrameRoundTrip)
+{
+    TangentFrameGenerator generator{ 7 };
+    RoundTripErrors errors;
+
+    for (uint64_t i = 0; i < 200000; ++i)
+    {
+        Vertex1P1N1UV1T1BT vertex = generator.Generate(generator.RandomDirection(), generator.RandomUnitUV());
+        errors.Accumulate(vertex, Vertex1P1N1UV1T1BTCompressed{ vertex }.Decompressed());
+    }
+
+    // Several random tangents for every special normal
+    for (const glm::vec3& normal : SpecialDirections())
+    {
+        for (uint64_t i = 0; i < 64; ++i)
+        {
+            Vertex1P1N1UV1T1BT vertex = generator.Generate(normal, generator.RandomUnitUV());
+            errors.Accumulate(vertex, Vertex1P1N1UV1T1BTCompressed{ vertex }.Decompressed());
+        }
+    }
+
+    PF_CHECK(errors.Normal < MaxNormalErrorDegrees, "Normal error: ", errors.Normal, " deg");
+    PF_CHECK(errors.Tangent < MaxTangentErrorDegrees, "Tangent error: ", errors.Tangent, " deg");
+    PF_CHECK(errors.Bitangent < MaxBitangentErrorDegrees, "Bitangent error: ", errors.Bitangent, " deg");
+    PF_CHECK(errors.BitangentSignErrors == 0, "Bitangent sign errors: ", errors.BitangentSignErrors);
+    PF_CHECK(errors.PositionMismatches == 0, "Position mismatches: ", errors.PositionMismatches);
+    PF_CHECK(errors.NaNs == 0, "NaNs: ", errors.NaNs);
+}
+
+PF_TEST(VertexCompressionUVRoundTrip)
+{
+    TangentFrameGenerator generator{ 11 };
+    double maxUnitError = 0.0;
+    double maxRelativeError = 0.0;
+
+    for (uint64_t i = 0; i < 100000; ++i)
+    {
+        glm::vec2 unitUV = generator.RandomUnitUV();
+        glm::vec2 wideUV = generator.RandomWideUV();
+        glm::vec3 normal = generator.RandomDirection();
+
+        glm::vec2 decompressedUnitUV = Vertex1P1N1UV1T1BTCompressed{ generator.Generate(normal, unitUV) }.Decompressed().UV;
+        glm::vec2 decompressedWideUV = Vertex1P1N1UV1T1BTCompressed{ generator.Generate(normal, wideUV) }.Decompressed().UV;
+
+        for (uint32_t component = 0; component < 2; ++component)
+        {
+            maxUnitError = std::max(maxUnitError, (double)std::abs(decompressedUnitUV[component] - unitUV[component]));
+
+            // Tiling coordinates keep relative precision of half floats
+            if (std::abs(wideUV[component]) > 1e-3f)
+            {
+                double relativeError = std::abs(decompressedWideUV[component] - wideUV[component]) / std::abs(wideUV[component]);
+                maxRelativeError = std::max(maxRelativeError, relativeError);
+            }
+        }
+    }
+
+    PF_CHECK(maxUnitError <= MaxUnitUVError, "UV error: ", maxUnitError);
+    PF_CHECK(maxRelativeError <= MaxRelativeUVError, "Relative UV error: ", maxRelativeError);
+}
+
+PF_TEST(VertexCompressionHandlesZeroVectors)
+{
+    // Meshes without normals or tangent space have zero vectors there, decoding must not produce NaNs
+    Vertex1P1N1UV1T1BT vertex{};
+    vertex.Position = glm::vec4{ 1.0f, 2.0f, 3.0f, 1.0f };
+    vertex.Normal = glm::vec3{ 0.0f };
+    vertex.Tangent = glm::vec3{ 0.0f };
+    vertex.Bitangent = glm::vec3{ 0.0f };
+    vertex.UV = glm::vec2{ 0.0f };
+
+    Vertex1P1N1UV1T1BT decompressed = Vertex1P1N1UV1T1BTCompressed{ vertex }.Decompressed();
+
+    PF_CHECK(decompressed.Position == vertex.Position);
+    PF_CHECK(decompressed.Normal == glm::vec3(0.0f, 0.0f, 1.0f), "Normal: ", decompressed.Normal.x, " ", decompressed.Normal.y, " ", decompressed.Normal.z);
+    PF_CHECK(decompressed.UV == glm::vec2(0.0f));
+
+    for (const glm::vec3& vector : { decompressed.Normal, decompressed.Tangent, decompressed.Bitangent })
+    {
+        PF_CHECK(!std::isnan(vector.x) && !std::isnan(vector.y) && !std::isnan(vector.z));
+    }
+}
+
+PF_BENCHMARK(VertexCompressionThroughput)
+{
+    constexpr uint64_t VertexCount = 1000000;
+
+    TangentFrameGenerator generator{ 3 };
+    std::vector<Vertex1P1N1UV1T1BT> vertices;
+    std::vector<Vertex1P1N1UV1T1BTCompressed> compressedVertices(VertexCount);
+    std::vector<Vertex1P1N1UV1T1BT> decompressedVertices(VertexCount);
+
+    vertices.reserve(VertexCount);
+
+    for (uint64_t i = 0; i < VertexCount; ++i)
+    {
+        vertices.push_back(generator.Generate(generator.RandomDirection(), generator.RandomUnitUV()));
+    }
+
+    Testing::Stopwatch compressionStopwatch;
+
+    for (uint64_t i = 0; i < VertexCount; ++i)
+    {
+        compressedVertices[i] = Vertex1P1N1UV1T1BTCompressed{ vertices[i] };
+    }
+
+    double compressionMilliseconds = compressionStopwatch.ElapsedMilliseconds();
+    Testing::Stopwatch decompressionStopwatch;
+
+    for (uint64_t i = 0; i < VertexCount; ++i)
+    {
+        decompressedVertices[i] = compressedVertices[i].Decompressed();
+    }
+
+    double decompressionMilliseconds = decompressionStopwatch.ElapsedMilliseconds();
+
+    Testing::Report("Compression", compressionMilliseconds * 1e6 / VertexCount, "ns/vertex");
+    Testing::Report("Decompression", decompressionMilliseconds * 1e6 / VertexCount, "ns/vertex");
+    Testing::Report("Vertex size", double(sizeof(Vertex1P1N1UV1T1BTCompressed)), "bytes");
+    Testing::Report("Uncompressed vertex size", double(sizeof(Vertex1P1N1UV1T1BT)), "bytes");
+}
@@ -0,0 +1,68 @@
+#include "Testing.hpp"
+
+#include <iostream>
+#include <iomanip>
+
+namespace Testing
+{
+
+    Registry& Registry::Shared()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    void Registry::Add(const std::string& name, Function function, bool isBenchmark)
+    {
+        mEntries.push_back({ name, function, isBenchmark });
+    }
+
+    uint64_t Registry::Run(bool runBenchmarks, const std::string& filter)
+    {
+        uint64_t failedTestCount = 0;
+        uint64_t executedTestCount = 0;
+
+        for (const Entry& entry : mEntries)
+        {
+            if (entry.IsBenchmark != runBenchmarks || entry.Name.find(filter) == std::string::npos)
+                continue;
+
+            std::cout << "[ RUN  ] " << entry.Name << std::endl;
+
+            mCurrentFailureCount = 0;
+            Stopwatch stopwatch;
+            entry.Function();
+
+            std::cout << (mCurrentFailureCount == 0 ? "[  OK  ] " : "[ FAIL ] ") << entry.Name
+                << " (" << std::fixed << std::setprecision(1) << stopwatch.ElapsedMilliseconds() << " ms)" << std::endl;
+
+            failedTestCount += mCurrentFailureCount > 0 ? 1 : 0;
+            ++executedTestCount;
+        }
+
+        std::cout << executedTestCount - failedTestCount << " of " << executedTestCount << " passed" << std::endl;
+
+        return failedTestCount;
+    }
+
+    void Registry::ReportFailure(const char* expression, const char* file, int line, const std::string& message)
+    {
+        // Don't flood the output when a check fails inside a loop
+        if (++mCurrentFailureCount > 10)
+            return;
+
+        std::cout << file << "(" << line << "): check failed: " << expression;
+
+        if (!message.empty())
+            std::cout << " " << message;
+
+        std::cout << std::endl;
+    }
+
+    void Report(const std::string& name, double value, const std::string& unit)
+    {
+        std::cout << "    " << std::left << std::setw(56) << name << std::right << std::setw(12) 
+            << std::fixed << std::setprecision(3) << value << " " << unit << std::endl;
+    }
+
+}
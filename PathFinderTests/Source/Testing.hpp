@@ -0,0 +1,92 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+
+namespace Testing
+{
+
+    // Minimal registry of CPU-only tests and benchmarks of engine components that don't need a GPU.
+    // Tests run by default, benchmarks only when requested on the command line.
+    class Registry
+    {
+    public:
+        using Function = void(*)();
+
+        struct Entry
+        {
+            std::string Name;
+            Function Function = nullptr;
+            bool IsBenchmark = false;
+        };
+
+        static Registry& Shared();
+
+        void Add(const std::string& name, Function function, bool isBenchmark);
+
+        // Runs entries whose name contains the filter, returns number of failed tests
+        uint64_t Run(bool runBenchmarks, const std::string& filter);
+
+        void ReportFailure(const char* expression, const char* file, int line, const std::string& message);
+
+    private:
+        std::vector<Entry> mEntries;
+        uint64_t mCurrentFailureCount = 0;
+    };
+
+    struct Registrar
+    {
+        Registrar(const char* name, Registry::Function function, bool isBenchmark)
+        {
+            Registry::Shared().Add(name, function, isBenchmark);
+        }
+    };
+
+    template <class... Args>
+    std::string ComposeMessage(Args&&... args)
+    {
+        std::stringstream ss;
+        ss.precision(10);
+        (ss << ... << args);
+        return ss.str();
+    }
+
+    // Prints a named benchmark result
+    void Report(const std::string& name, double value, const std::string& unit);
+
+    class Stopwatch
+    {
+    public:
+        Stopwatch() : mStartTimestamp{ std::chrono::steady_clock::now() } {}
+
+        inline double ElapsedMilliseconds() const
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - mStartTimestamp).count();
+        }
+
+    private:
+        std::chrono::time_point<std::chrono::steady_clock> mStartTimestamp;
+    };
+
+}
+
+#define PF_TEST_CONCAT_IMPL(a, b) a##b
+#define PF_TEST_CONCAT(a, b) PF_TEST_CONCAT_IMPL(a, b)
+
+#define PF_REGISTER_ENTRY(NAME, IS_BENCHMARK) \
+    static void NAME(); \
+    static Testing::Registrar PF_TEST_CONCAT(NAME, Registrar){ #NAME, &NAME, IS_BENCHMARK }; \
+    static void NAME()
+
+#define PF_TEST(NAME) PF_REGISTER_ENTRY(NAME, false)
+#define PF_BENCHMARK(NAME) PF_REGISTER_ENTRY(NAME, true)
+
+// Failed checks are reported and the test continues
+#define PF_CHECK(EXPRESSION, ...) ((EXPRESSION) ? (void)0 : \
+    Testing::Registry::Shared().ReportFailure(#EXPRESSION, __FILE__, __LINE__, Testing::ComposeMessage("", ##__VA_ARGS__)))
+
+#define PF_CHECK_NEAR(VALUE, EXPECTED, TOLERANCE) PF_CHECK(std::abs((VALUE) - (EXPECTED)) <= (TOLERANCE), \
+    "Value: ", (VALUE), " Expected: ", (EXPECTED), " Tolerance: ", (TOLERANCE))
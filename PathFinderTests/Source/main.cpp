@@ -0,0 +1,26 @@
+#include "Testing.hpp"
+
+#include <string>
+
+// Usage: PathFinderTests [--benchmark] [name filter]
+int main(int argc, char** argv)
+{
+    bool runBenchmarks = false;
+    std::string filter;
+
+    for (int argIdx = 1; argIdx < argc; ++argIdx)
+    {
+        std::string arg = argv[argIdx];
+
+        if (arg == "--benchmark")
+        {
+            runBenchmarks = true;
+        }
+        else
+        {
+            filter = arg;
+        }
+    }
+
+    return Testing::Registry::Shared().Run(runBenchmarks, filter) > 0 ? 1 : 0;
+}